@@ -34,6 +34,7 @@ see https://www.gnu.org/licenses/. */
 #include <typeinfo>
 #include <utility>
 
+#include "detail/separate_compilation.hpp"
 #include "exceptions.hpp"
 #include "population.hpp"
 #include "serialization.hpp"
@@ -61,6 +62,14 @@ see https://www.gnu.org/licenses/. */
  */
 #define PAGMO_REGISTER_ALGORITHM(algo) CEREAL_REGISTER_TYPE_WITH_NAME(pagmo::detail::algo_inner<algo>, "uda " #algo)
 
+// Registration of the UDAs shipped with pagmo. With separate compilation, they are registered only once, in the
+// pagmo library (see detail/separate_compilation.hpp).
+#if defined(PAGMO_HEADER_REGISTRATIONS)
+#define PAGMO_REGISTER_BUILTIN_ALGORITHM(algo) PAGMO_REGISTER_ALGORITHM(algo)
+#else
+#define PAGMO_REGISTER_BUILTIN_ALGORITHM(algo)
+#endif
+
 namespace pagmo
 {
 
@@ -178,6 +187,7 @@ struct algo_inner_base {
     }
     virtual algo_inner_base *clone() const = 0;
     virtual population evolve(const population &pop) const = 0;
+    virtual population evolve(population &&pop) const = 0;
     virtual void set_seed(unsigned) = 0;
     virtual bool has_set_seed() const = 0;
     virtual void set_verbosity(unsigned) = 0;
@@ -223,6 +233,11 @@ struct algo_inner final : algo_inner_base {
     {
         return m_value.evolve(pop);
     }
+    // UDAs taking the population by value will move-construct it from pop.
+    virtual population evolve(population &&pop) const override final
+    {
+        return m_value.evolve(std::move(pop));
+    }
     // Optional methods
     virtual void set_seed(unsigned seed) override final
     {
@@ -372,6 +387,9 @@ struct algo_inner final : algo_inner_base {
  *
  * The <tt>%evolve()</tt> method takes as input a pagmo::population, and it is expected to return
  * a new population generated by the *evolution* (or *optimisation*) of the original population.
+ * The population can also be taken by value (<tt>population evolve(population) const</tt>): in that case
+ * algorithm::evolve(population &&) will move the population into the UDA, and evolving a population in a
+ * loop will not copy it (nor its problem).
  *
  * Additional optional methods can be implemented in a UDA:
  * @code{.unparsed}
@@ -559,6 +577,30 @@ public:
         return ptr()->evolve(pop);
     }
 
+    /// Evolve method (move overload).
+    /**
+     * Equivalent to evolve(const population &), but the input population is moved into the
+     * <tt>%evolve()</tt> method of the UDA. If the UDA takes the population by value, as all the algorithms
+     * provided by pagmo do, neither the decision vectors nor the problem (and thus the UDP) are copied. This is
+     * the overload to use when evolving a population in a loop:
+     * @code{.unparsed}
+     * for (auto i = 0; i < 100; ++i) {
+     *     pop = algo.evolve(std::move(pop));
+     * }
+     * @endcode
+     * After the call, \p pop is left in a valid but unspecified state.
+     *
+     * @param pop starting population
+     *
+     * @return evolved population
+     *
+     * @throws unspecified any exception thrown by the <tt>%evolve()</tt> method of the UDA.
+     */
+    population evolve(population &&pop) const
+    {
+        return ptr()->evolve(std::move(pop));
+    }
+
     /// Set the seed for the stochastic evolution.
     /**
      * Sets the seed to be used in the <tt>%evolve()</tt> method of the UDA for all stochastic variables. If the UDA
@@ -763,6 +805,6 @@ private:
 };
 }
 
-PAGMO_REGISTER_ALGORITHM(pagmo::null_algorithm)
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::null_algorithm)
 
 #endif
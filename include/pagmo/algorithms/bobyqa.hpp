@@ -0,0 +1,747 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_ALGORITHMS_BOBYQA_HPP
+#define PAGMO_ALGORITHMS_BOBYQA_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream> //std::osstringstream
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../algorithm.hpp"
+#include "../exceptions.hpp"
+#include "../io.hpp"
+#include "../population.hpp"
+#include "../serialization.hpp"
+#include "../types.hpp"
+
+namespace pagmo
+{
+
+/// Bound Optimization BY Quadratic Approximation (BOBYQA)
+/**
+ * A derivative-free, deterministic local solver for bound constrained single-objective problems. At each iteration
+ * a quadratic model of the objective, interpolating \f$ 2n+1 \f$ points, is minimized within a trust region
+ * intersected with the box bounds. When a new point is evaluated it replaces one of the interpolation points, and the
+ * model is updated so that it interpolates the new set while the change of its Hessian has the least Frobenius norm.
+ * The initial model uses the current best individual and two points along each coordinate direction, so that its
+ * Hessian is diagonal to start with, and curvature information accumulates as the search proceeds.
+ *
+ * Two radii control the search. The trust region radius \f$ \Delta \f$ is adapted at each step from the agreement
+ * between the model and the objective, and is never allowed below the resolution \f$ \rho \f$. The resolution starts
+ * at \p start_range and is decreased whenever no further progress is possible at the current resolution, until it
+ * reaches \p stop_range. Both radii are relative to the box bounds, as in pagmo::compass_search. For smooth problems
+ * this solver typically needs far fewer objective evaluations than pattern search methods.
+ *
+ * The implementation follows the main structure of Powell's BOBYQA, with two simplifications: the interpolation
+ * system is solved anew at each update (which costs \f$ O(n^3) \f$ operations, negligible for expensive objectives)
+ * and the point moved by a geometry improving step is the one farthest from the best point, moved towards it.
+ *
+ * **NOTE** This algorithm does not work for multi-objective problems, nor for constrained or stochastic problems.
+ *
+ * **NOTE** The search range is defined relative to the box-bounds. Hence, unbounded problems
+ * will produce an error.
+ *
+ * **NOTE** This is a fully deterministic algorithm and will produce identical results if its evolve method
+ * is called from two identical populations.
+ *
+ * See: M. J. D. Powell, "The BOBYQA algorithm for bound constrained optimization without derivatives",
+ * Technical Report DAMTP 2009/NA06, University of Cambridge (2009).
+ */
+class bobyqa
+{
+public:
+    /// Single entry of the log (feval, best fitness, rho, delta)
+    typedef std::tuple<unsigned long long, double, double, double> log_line_type;
+    /// The log
+    typedef std::vector<log_line_type> log_type;
+
+    /// Constructor.
+    /**
+     * Constructs bobyqa
+     *
+     * @param max_fevals maximum number of function evaluations
+     * @param start_range initial resolution, relative to the box bounds
+     * @param stop_range final resolution, relative to the box bounds
+     * @throws std::invalid_argument if \p start_range is not in (0,0.5]
+     * @throws std::invalid_argument if \p stop_range is not in (0,start_range)
+     */
+    bobyqa(unsigned int max_fevals = 1000u, double start_range = .1, double stop_range = 1e-6)
+        : m_max_fevals(max_fevals), m_start_range(start_range), m_stop_range(stop_range), m_verbosity(0u), m_log()
+    {
+        if (start_range > .5 || start_range <= 0. || std::isnan(start_range)) {
+            pagmo_throw(std::invalid_argument, "The start range must be in (0, 0.5], while a value of "
+                                                   + std::to_string(start_range) + " was detected.");
+        }
+        if (stop_range <= 0. || stop_range >= start_range || std::isnan(stop_range)) {
+            pagmo_throw(std::invalid_argument, "The stop range must be in (0, start_range), while a value of "
+                                                   + std::to_string(stop_range) + " was detected.");
+        }
+    }
+
+    /// Algorithm evolve method (juice implementation of the algorithm)
+    /**
+     * Runs the solver from the best individual of the population, up to when the resolution becomes smaller
+     * than the defined stop_range or the maximum number of function evaluations is reached. The result
+     * replaces the best individual of the population.
+     *
+     * @param pop population to be evolved
+     * @return evolved population
+     * @throws std::invalid_argument if the problem is multi-objective, constrained or stochastic
+     * @throws std::invalid_argument if the problem is unbounded
+     * @throws std::invalid_argument if the population is empty
+     */
+    population evolve(population pop) const
+    {
+        // We store some useful variables
+        const auto &prob = pop.get_problem(); // This is a const reference, so using set_seed for example will not be
+                                              // allowed
+        auto dim = prob.get_nx();             // This getter does not return a const reference but a copy
+        const auto &lb = prob.get_lb();
+        const auto &ub = prob.get_ub();
+
+        auto fevals0 = prob.get_fevals(); // discount for the already made fevals
+        unsigned int count = 1u;          // regulates the screen output
+
+        // PREAMBLE-------------------------------------------------------------------------------------------------
+        // We start by checking that the problem is suitable for this
+        // particular algorithm.
+        if (prob.get_nobj() != 1u) {
+            pagmo_throw(std::invalid_argument, "Multiple objectives detected in " + prob.get_name() + " instance. "
+                                                   + get_name() + " cannot deal with them");
+        }
+        if (prob.get_nc() != 0u) {
+            pagmo_throw(std::invalid_argument, "Non linear constraints detected in " + prob.get_name() + " instance. "
+                                                   + get_name() + " cannot deal with them");
+        }
+        if (prob.is_stochastic()) {
+            pagmo_throw(std::invalid_argument,
+                        "The problem appears to be stochastic " + get_name() + " cannot deal with it");
+        }
+        if (pop.size() == 0u) {
+            pagmo_throw(std::invalid_argument, get_name() + " does not work on an empty population");
+        }
+        for (decltype(dim) i = 0u; i < dim; ++i) {
+            if (!std::isfinite(lb[i]) || !std::isfinite(ub[i])) {
+                pagmo_throw(std::invalid_argument, "Infinite bounds detected in " + prob.get_name() + " instance. "
+                                                       + get_name() + " cannot deal with them");
+            }
+        }
+        // Get out if there is nothing to do.
+        if (m_max_fevals == 0u) {
+            return pop;
+        }
+        // ---------------------------------------------------------------------------------------------------------
+
+        // No throws, all valid: we clear the logs
+        m_log.clear();
+
+        // The search is carried out in the unit hypercube, starting from the best individual of the population.
+        auto best_idx = pop.best_idx();
+        const auto npt = 2u * dim + 1u;
+        vector_double xopt(dim);
+        for (decltype(dim) i = 0u; i < dim; ++i) {
+            xopt[i] = (ub[i] > lb[i]) ? (pop.get_x()[best_idx][i] - lb[i]) / (ub[i] - lb[i]) : 0.;
+        }
+        double fopt = pop.get_f()[best_idx][0];
+        unsigned int fevals = 0u;
+        workspace ws(dim);
+        auto evaluate = [&](const vector_double &u) {
+            for (decltype(dim) i = 0u; i < dim; ++i) {
+                ws.x[i] = std::min(std::max(lb[i] + u[i] * (ub[i] - lb[i]), lb[i]), ub[i]);
+            }
+            ++fevals;
+            return prob.fitness(ws.x)[0];
+        };
+
+        // Interpolation set and quadratic model c + g.(y - xbase) + 1/2 (y - xbase)^T H (y - xbase).
+        std::vector<vector_double> Y(npt, xopt);
+        vector_double F(npt, fopt);
+        vector_double xbase, g, H;
+        double c = 0.;
+        double rho = m_start_range, delta = m_start_range;
+        bool exhausted = false;
+
+        // Builds the interpolation set around xopt from scratch: two points along each coordinate direction.
+        auto initialise = [&]() {
+            Y.assign(npt, xopt);
+            F.assign(npt, fopt);
+            for (decltype(dim) i = 0u; i < dim; ++i) {
+                const auto a = (xopt[i] + rho <= 1.) ? rho : -rho;
+                const auto b = (xopt[i] - a >= 0. && xopt[i] - a <= 1.) ? -a : a / 2.;
+                Y[2u * i + 1u][i] += a;
+                Y[2u * i + 2u][i] += b;
+            }
+            for (decltype(Y.size()) k = 1u; k < npt; ++k) {
+                if (fevals >= m_max_fevals) {
+                    return false;
+                }
+                F[k] = evaluate(Y[k]);
+            }
+            xbase = xopt;
+            g.assign(dim, 0.);
+            H.assign(dim * dim, 0.);
+            c = 0.;
+            update_model(Y, F, xbase, c, g, H, ws);
+            for (decltype(Y.size()) k = 1u; k < npt; ++k) {
+                if (F[k] < fopt) {
+                    fopt = F[k];
+                    xopt = Y[k];
+                }
+            }
+            return true;
+        };
+        // Replaces the interpolation point k and updates the model, starting again if the
+        // interpolation system has become degenerate.
+        auto replace = [&](decltype(Y.size()) k, const vector_double &y, double f) {
+            Y[k] = y;
+            F[k] = f;
+            if (f < fopt) {
+                fopt = f;
+                xopt = y;
+            }
+            if (!update_model(Y, F, xbase, c, g, H, ws)) {
+                exhausted = !initialise();
+            }
+        };
+        // Index and distance of the interpolation point farthest from xopt.
+        auto farthest = [&]() {
+            decltype(Y.size()) k = 0u;
+            double dmax = -1.;
+            for (decltype(Y.size()) j = 0u; j < npt; ++j) {
+                const auto dj = distance(Y[j], xopt);
+                if (dj > dmax) {
+                    dmax = dj;
+                    k = j;
+                }
+            }
+            return std::make_pair(k, dmax);
+        };
+        auto log_line = [&]() {
+            if (m_verbosity > 0u) {
+                // 1 - Every 50 lines print the column names
+                if (count % 50u == 1u) {
+                    print("\n", std::setw(7), "Fevals:", std::setw(15), "Best:", std::setw(15), "Rho:", std::setw(15),
+                          "Delta:", '\n');
+                }
+                // 2 - Print
+                print(std::setw(7), prob.get_fevals() - fevals0, std::setw(15), fopt, std::setw(15), rho,
+                      std::setw(15), delta, '\n');
+                ++count;
+                // Logs
+                m_log.push_back(log_line_type(prob.get_fevals() - fevals0, fopt, rho, delta));
+            }
+        };
+
+        exhausted = !initialise();
+        log_line();
+        while (!exhausted && fevals < m_max_fevals) {
+            // 1 - Minimise the model in the trust region intersected with the bounds.
+            shift_base(xopt, xbase, c, g, H, ws);
+            trust_region_step(g, H, xopt, delta, ws);
+            const auto &s = ws.s;
+            const auto snorm = norm(s);
+            bool improve_geometry = false, reduce_rho = false;
+            if (snorm < .5 * rho) {
+                // The model is stationary at the current resolution: either the interpolation set
+                // is not reliable, or the resolution has to be decreased.
+                improve_geometry = farthest().second > 2. * rho;
+                reduce_rho = !improve_geometry;
+                delta = std::max(.1 * delta, rho);
+            } else {
+                // 2 - Evaluate the trial point and compare the actual and predicted reductions.
+                auto &xnew = ws.xnew;
+                for (decltype(dim) i = 0u; i < dim; ++i) {
+                    xnew[i] = std::min(std::max(xopt[i] + s[i], 0.), 1.);
+                }
+                const auto fnew = evaluate(xnew);
+                const auto pred = -model_change(g, H, s, ws.Hd);
+                const auto ratio = (pred > 0.) ? (fopt - fnew) / pred : -1.;
+                if (ratio <= .1) {
+                    delta = std::min(.5 * delta, snorm);
+                } else if (ratio <= .7) {
+                    delta = std::max(.5 * delta, snorm);
+                } else {
+                    delta = std::max(.5 * delta, 2. * snorm);
+                }
+                if (delta <= 1.5 * rho) {
+                    delta = rho;
+                }
+                const auto improved = fnew < fopt;
+                // 3 - The new point replaces the interpolation point farthest from the best one.
+                decltype(Y.size()) k = 0u;
+                double dmax = -1.;
+                const auto &centre = improved ? xnew : xopt;
+                for (decltype(Y.size()) j = 0u; j < npt; ++j) {
+                    const auto dj = distance(Y[j], centre);
+                    if (Y[j] != xopt && dj > dmax) {
+                        dmax = dj;
+                        k = j;
+                    }
+                }
+                replace(k, xnew, fnew);
+                if (improved) {
+                    log_line();
+                }
+                if (ratio < .1) {
+                    improve_geometry = farthest().second > 2. * delta;
+                    reduce_rho = !improve_geometry && delta <= rho;
+                }
+            }
+            // 4 - Geometry step: the farthest point is moved towards the best one.
+            if (improve_geometry && !exhausted && fevals < m_max_fevals) {
+                const auto far = farthest();
+                const auto step = std::max(delta, rho) / far.second;
+                auto &y = ws.xnew;
+                for (decltype(dim) i = 0u; i < dim; ++i) {
+                    y[i] = std::min(std::max(xopt[i] + step * (Y[far.first][i] - xopt[i]), 0.), 1.);
+                }
+                replace(far.first, y, evaluate(y));
+            }
+            // 5 - Decrease the resolution.
+            if (reduce_rho) {
+                if (rho <= m_stop_range) {
+                    break;
+                }
+                const auto ratio = rho / m_stop_range;
+                const auto new_rho = (ratio <= 16.) ? m_stop_range : (ratio <= 250.) ? std::sqrt(ratio) * m_stop_range
+                                                                                       : .1 * rho;
+                delta = std::max(.5 * rho, new_rho);
+                rho = new_rho;
+                log_line();
+            }
+        } // end while
+
+        if (m_verbosity) {
+            if (fevals < m_max_fevals) {
+                std::cout << "Exit condition -- range: " << rho << " <= " << m_stop_range << "\n";
+            } else {
+                std::cout << "Exit condition -- fevals: " << fevals << " >= " << m_max_fevals << "\n";
+            }
+        }
+
+        // Force the current best into the original population
+        vector_double x(dim);
+        for (decltype(dim) i = 0u; i < dim; ++i) {
+            x[i] = std::min(std::max(lb[i] + xopt[i] * (ub[i] - lb[i]), lb[i]), ub[i]);
+        }
+        if (fopt < pop.get_f()[best_idx][0]) {
+            pop.set_xf(best_idx, x, {fopt});
+        }
+        return pop;
+    };
+
+    /// Sets the algorithm verbosity
+    /**
+     * Sets the verbosity level of the screen output and of the
+     * log returned by get_log(). \p level can be:
+     * - 0: no verbosity
+     * - >0: will print and log one line each objective function improvement, or resolution reduction
+     *
+     * Example (verbosity > 0u):
+     * @code{.unparsed}
+     * Fevals:          Best:           Rho:         Delta:
+     *       5        1091.45            0.1            0.1
+     *       6        3.66307            0.1            0.2
+     *      13       0.582126            0.1      0.0577812
+     *      ..        .......            ...            ...
+     *      69    4.75184e-09    1.58114e-05    5.65931e-05
+     *      70    1.60549e-11    1.58114e-05    0.000113186
+     *      76    1.60549e-11          1e-06    7.90569e-06
+     * Exit condition -- range: 1e-06 <= 1e-06
+     * @endcode
+     * Fevals is the number of function evaluations made, Best is the best fitness, Rho is the
+     * current resolution and Delta the trust region radius, both relative to the box bounds.
+     *
+     * @param level verbosity level
+     */
+    void set_verbosity(unsigned int level)
+    {
+        m_verbosity = level;
+    };
+    /// Gets the verbosity level
+    /**
+     * @return the verbosity level
+     */
+    unsigned int get_verbosity() const
+    {
+        return m_verbosity;
+    }
+    /// Gets the maximum number of function evaluations allowed
+    /**
+     * @return the maximum number of function evaluations allowed
+     */
+    unsigned int get_max_fevals() const
+    {
+        return m_max_fevals;
+    }
+    /// Gets the stop_range
+    /**
+     * @return the stop range
+     */
+    double get_stop_range() const
+    {
+        return m_stop_range;
+    }
+    /// Get the start range
+    /**
+     * @return the start range
+     */
+    double get_start_range() const
+    {
+        return m_start_range;
+    }
+    /// Algorithm name
+    /**
+     * One of the optional methods of any user-defined algorithm (UDA).
+     *
+     * @return a string containing the algorithm name
+     */
+    std::string get_name() const
+    {
+        return "BOBYQA: Bound Optimization BY Quadratic Approximation";
+    }
+    /// Extra informations
+    /**
+     * One of the optional methods of any user-defined algorithm (UDA).
+     *
+     * @return a string containing extra informations on the algorithm
+     */
+    std::string get_extra_info() const
+    {
+        std::ostringstream ss;
+        stream(ss, "\tMaximum number of objective function evaluations: ", m_max_fevals);
+        stream(ss, "\n\tStart range: ", m_start_range);
+        stream(ss, "\n\tStop range: ", m_stop_range);
+        stream(ss, "\n\tVerbosity: ", m_verbosity);
+        return ss.str();
+    }
+
+    /// Get log
+    /**
+     * A log containing relevant quantities monitoring the last call to evolve. Each element of the returned
+     * <tt> std::vector </tt> is a bobyqa::log_line_type containing: Fevals, Best, Rho, Delta
+     * as described in bobyqa::set_verbosity
+     * @return an <tt> std::vector </tt> of bobyqa::log_line_type containing the logged values Fevals, Best,
+     * Rho, Delta
+     */
+    const log_type &get_log() const
+    {
+        return m_log;
+    }
+
+    /// Object serialization
+    /**
+     * This method will save/load \p this into the archive \p ar.
+     *
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of the UDP and of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_max_fevals, m_start_range, m_stop_range, m_verbosity, m_log);
+    }
+
+private:
+    static double dot(const vector_double &a, const vector_double &b)
+    {
+        double retval = 0.;
+        for (decltype(a.size()) i = 0u; i < a.size(); ++i) {
+            retval += a[i] * b[i];
+        }
+        return retval;
+    }
+    static double norm(const vector_double &a)
+    {
+        return std::sqrt(dot(a, a));
+    }
+    static double distance(const vector_double &a, const vector_double &b)
+    {
+        double retval = 0.;
+        for (decltype(a.size()) i = 0u; i < a.size(); ++i) {
+            retval += (a[i] - b[i]) * (a[i] - b[i]);
+        }
+        return std::sqrt(retval);
+    }
+    // Scratch buffers of the model updates and of the trust region steps, allocated once per evolve().
+    struct workspace {
+        explicit workspace(vector_double::size_type n)
+            : x(n), xnew(n), d(n), Hd(n), Z((2u * n + 1u) * n), A((3u * n + 2u) * (3u * n + 2u)), b(3u * n + 2u),
+              s(n), r(n), dir(n), fixed(n)
+        {
+        }
+        // Decision vector to evaluate and trial point.
+        vector_double x, xnew;
+        // Displacement and its product by the Hessian.
+        vector_double d, Hd;
+        // Scaled displacements of the interpolation points (row-major) and interpolation system.
+        vector_double Z, A, b;
+        // Trust region step, residual and search direction.
+        vector_double s, r, dir;
+        std::vector<char> fixed;
+    };
+    // out = H d, with H stored row-major.
+    static void hess_prod(const vector_double &H, const vector_double &d, vector_double &out)
+    {
+        const auto n = d.size();
+        for (decltype(d.size()) i = 0u; i < n; ++i) {
+            out[i] = 0.;
+            for (decltype(d.size()) j = 0u; j < n; ++j) {
+                out[i] += H[i * n + j] * d[j];
+            }
+        }
+    }
+    // g.s + 1/2 s^T H s (Hs is used as scratch).
+    static double model_change(const vector_double &g, const vector_double &H, const vector_double &s,
+                               vector_double &Hs)
+    {
+        hess_prod(H, s, Hs);
+        return dot(g, s) + .5 * dot(s, Hs);
+    }
+    // Expresses the model with respect to a new base point.
+    static void shift_base(const vector_double &new_base, vector_double &xbase, double &c, vector_double &g,
+                           const vector_double &H, workspace &ws)
+    {
+        auto &s = ws.d;
+        for (decltype(s.size()) i = 0u; i < s.size(); ++i) {
+            s[i] = new_base[i] - xbase[i];
+        }
+        c += model_change(g, H, s, ws.Hd);
+        for (decltype(s.size()) i = 0u; i < s.size(); ++i) {
+            g[i] += ws.Hd[i];
+        }
+        xbase = new_base;
+    }
+    // Solves A x = b (A is N x N, row-major) by Gaussian elimination with partial pivoting.
+    // Returns false if A is numerically singular. A and b are overwritten, b with the solution.
+    static bool solve_linear(vector_double &A, vector_double &b)
+    {
+        const auto N = b.size();
+        double scale = 0.;
+        for (auto a : A) {
+            scale = std::max(scale, std::abs(a));
+        }
+        for (decltype(b.size()) col = 0u; col < N; ++col) {
+            auto piv = col;
+            for (auto r = col + 1u; r < N; ++r) {
+                if (std::abs(A[r * N + col]) > std::abs(A[piv * N + col])) {
+                    piv = r;
+                }
+            }
+            if (!(std::abs(A[piv * N + col]) > 1e-13 * scale)) {
+                return false;
+            }
+            if (piv != col) {
+                for (decltype(b.size()) j = 0u; j < N; ++j) {
+                    std::swap(A[piv * N + j], A[col * N + j]);
+                }
+                std::swap(b[piv], b[col]);
+            }
+            for (auto r = col + 1u; r < N; ++r) {
+                const auto m = A[r * N + col] / A[col * N + col];
+                if (m != 0.) {
+                    for (auto j = col; j < N; ++j) {
+                        A[r * N + j] -= m * A[col * N + j];
+                    }
+                    b[r] -= m * b[col];
+                }
+            }
+        }
+        for (auto i = N; i-- > 0u;) {
+            for (auto j = i + 1u; j < N; ++j) {
+                b[i] -= A[i * N + j] * b[j];
+            }
+            b[i] /= A[i * N + i];
+        }
+        return true;
+    }
+    // Least Frobenius norm update: the model is corrected by the quadratic D, with the smallest
+    // Hessian in Frobenius norm, such that the updated model interpolates all the points in Y.
+    // The displacements from xbase are scaled to unit size to keep the system well conditioned.
+    static bool update_model(const std::vector<vector_double> &Y, const vector_double &F, const vector_double &xbase,
+                             double &c, vector_double &g, vector_double &H, workspace &ws)
+    {
+        const auto npt = Y.size(), n = xbase.size(), N = npt + n + 1u;
+        // Z[k] is the row k of the npt x n matrix ws.Z.
+        auto Z = [&ws, n](decltype(Y.size()) k) { return ws.Z.data() + k * n; };
+        auto zdot = [n](const double *a, const double *b) {
+            double retval = 0.;
+            for (vector_double::size_type i = 0u; i < n; ++i) {
+                retval += a[i] * b[i];
+            }
+            return retval;
+        };
+        double sigma = 0.;
+        for (decltype(Y.size()) k = 0u; k < npt; ++k) {
+            for (decltype(xbase.size()) i = 0u; i < n; ++i) {
+                Z(k)[i] = Y[k][i] - xbase[i];
+            }
+            sigma = std::max(sigma, std::sqrt(zdot(Z(k), Z(k))));
+        }
+        if (!(sigma > 0.)) {
+            return false;
+        }
+        auto &A = ws.A, &b = ws.b;
+        std::fill(A.begin(), A.end(), 0.);
+        std::fill(b.begin(), b.end(), 0.);
+        for (auto &z : ws.Z) {
+            z /= sigma;
+        }
+        for (decltype(Y.size()) k = 0u; k < npt; ++k) {
+            for (decltype(Y.size()) j = 0u; j < npt; ++j) {
+                const auto zz = zdot(Z(k), Z(j));
+                A[k * N + j] = .5 * zz * zz;
+            }
+            A[k * N + npt] = A[npt * N + k] = 1.;
+            for (decltype(xbase.size()) i = 0u; i < n; ++i) {
+                A[k * N + npt + 1u + i] = A[(npt + 1u + i) * N + k] = Z(k)[i];
+            }
+            for (decltype(xbase.size()) i = 0u; i < n; ++i) {
+                ws.d[i] = Y[k][i] - xbase[i];
+            }
+            b[k] = F[k] - (c + model_change(g, H, ws.d, ws.Hd));
+        }
+        if (!solve_linear(A, b)) {
+            return false;
+        }
+        // Back to the original scaling: D(y) = c_d + (g_d / sigma).d + 1/2 d^T (sum_k lambda_k z_k z_k^T / sigma^2) d.
+        c += b[npt];
+        for (decltype(xbase.size()) i = 0u; i < n; ++i) {
+            g[i] += b[npt + 1u + i] / sigma;
+        }
+        for (decltype(Y.size()) k = 0u; k < npt; ++k) {
+            const auto l = b[k] / (sigma * sigma);
+            for (decltype(xbase.size()) i = 0u; i < n; ++i) {
+                for (decltype(xbase.size()) j = 0u; j < n; ++j) {
+                    H[i * n + j] += l * Z(k)[i] * Z(k)[j];
+                }
+            }
+        }
+        return true;
+    }
+    // Approximate minimiser of g.s + 1/2 s^T H s subject to |s| <= delta and 0 <= x + s <= 1: truncated
+    // conjugate gradient, restarted with one more variable fixed each time a bound is reached. The step
+    // is written into ws.s.
+    static void trust_region_step(const vector_double &g, const vector_double &H, const vector_double &x,
+                                  double delta, workspace &ws)
+    {
+        const auto n = g.size();
+        auto &s = ws.s, &r = ws.r, &d = ws.dir, &Hs = ws.Hd, &Hd = ws.Hd;
+        auto &fixed = ws.fixed;
+        std::fill(s.begin(), s.end(), 0.);
+        for (decltype(g.size()) i = 0u; i < n; ++i) {
+            fixed[i] = (x[i] <= 0. && g[i] > 0.) || (x[i] >= 1. && g[i] < 0.);
+        }
+        const auto gnorm = norm(g);
+        for (decltype(g.size()) outer = 0u; outer <= n; ++outer) {
+            hess_prod(H, s, Hs);
+            for (decltype(g.size()) i = 0u; i < n; ++i) {
+                r[i] = fixed[i] ? 0. : -(g[i] + Hs[i]);
+            }
+            auto rr = dot(r, r);
+            if (!(std::sqrt(rr) > 1e-10 * gnorm)) {
+                break;
+            }
+            d = r;
+            bool restart = false;
+            for (decltype(g.size()) it = 0u; it < n; ++it) {
+                hess_prod(H, d, Hd);
+                const auto dHd = dot(d, Hd), sd = dot(s, d), dd = dot(d, d), ss = dot(s, s);
+                // Step to the trust region boundary.
+                const auto a_tr = (-sd + std::sqrt(std::max(sd * sd + dd * (delta * delta - ss), 0.))) / dd;
+                // Step to the nearest bound.
+                auto a_bd = std::numeric_limits<double>::infinity();
+                auto i_bd = n;
+                for (decltype(g.size()) i = 0u; i < n; ++i) {
+                    if (!fixed[i] && d[i] != 0.) {
+                        const auto a = ((d[i] > 0. ? 1. : 0.) - x[i] - s[i]) / d[i];
+                        if (a < a_bd) {
+                            a_bd = std::max(a, 0.);
+                            i_bd = i;
+                        }
+                    }
+                }
+                auto a = a_tr;
+                auto boundary = true;
+                if (dHd > 0. && rr / dHd < a) {
+                    a = rr / dHd;
+                    boundary = false;
+                }
+                if (a_bd < a) {
+                    for (decltype(g.size()) i = 0u; i < n; ++i) {
+                        s[i] += a_bd * d[i];
+                    }
+                    s[i_bd] = (d[i_bd] > 0. ? 1. : 0.) - x[i_bd];
+                    fixed[i_bd] = 1;
+                    restart = true;
+                    break;
+                }
+                for (decltype(g.size()) i = 0u; i < n; ++i) {
+                    s[i] += a * d[i];
+                }
+                if (boundary) {
+                    return;
+                }
+                for (decltype(g.size()) i = 0u; i < n; ++i) {
+                    r[i] = fixed[i] ? 0. : r[i] - a * Hd[i];
+                }
+                const auto rr_new = dot(r, r);
+                if (!(std::sqrt(rr_new) > 1e-10 * gnorm)) {
+                    return;
+                }
+                for (decltype(g.size()) i = 0u; i < n; ++i) {
+                    d[i] = r[i] + (rr_new / rr) * d[i];
+                }
+                rr = rr_new;
+            }
+            if (!restart) {
+                break;
+            }
+        }
+    }
+
+    unsigned int m_max_fevals;
+    double m_start_range;
+    double m_stop_range;
+    unsigned int m_verbosity;
+    mutable log_type m_log;
+};
+
+} // namespaces
+
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::bobyqa)
+
+#endif
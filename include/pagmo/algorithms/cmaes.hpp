@@ -30,18 +30,25 @@ see https://www.gnu.org/licenses/. */
 #define PAGMO_ALGORITHMS_CMAES_HPP
 
 #include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <future>
 #include <iomanip>
 #include <random>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "../algorithm.hpp"
 #include "../detail/custom_comparisons.hpp"
 #include "../exceptions.hpp"
 #include "../io.hpp"
 #include "../population.hpp"
+#include "../problem.hpp"
 #include "../rng.hpp"
 #include "../serialization.hpp"
+#include "../threading.hpp"
+#include "../types.hpp"
 #include "../utils/generic.hpp"
 
 namespace pagmo
@@ -98,7 +105,8 @@ public:
     cmaes(unsigned int gen = 1, double cc = -1, double cs = -1, double c1 = -1, double cmu = -1, double sigma0 = 0.5,
           double ftol = 1e-6, double xtol = 1e-6, bool memory = false, unsigned int seed = pagmo::random_device::next())
         : m_gen(gen), m_cc(cc), m_cs(cs), m_c1(c1), m_cmu(cmu), m_sigma0(sigma0), m_ftol(ftol), m_xtol(xtol),
-          m_memory(memory), m_e(seed), m_seed(seed), m_verbosity(0u), m_log()
+          m_memory(memory), m_restart(0u), m_max_restarts(0u), m_n_restarts(0u), m_e(seed), m_seed(seed),
+          m_verbosity(0u), m_log()
     {
         if (((cc < 0.) || (cc > 1.)) && !(cc == -1)) {
             pagmo_throw(std::invalid_argument,
@@ -140,23 +148,36 @@ public:
     /**
      *
      * Evolves the population for a maximum number of generations, until one of
-     * tolerances set on the population flatness (x_tol, f_tol) are met.
+     * tolerances set on the population flatness (x_tol, f_tol) are met. If a restart strategy
+     * has been selected with set_restart(), the run is then restarted, as long as the budget of
+     * \p gen times the population size function evaluations is not exhausted.
      *
      * @param pop population to be evolved
      * @return evolved population
      * @throws std::invalid_argument if the problem is multi-objective or constrained
      * @throws std::invalid_argument if the problem is unbounded
      * @throws std::invalid_argument if the population size is not at least 5
+     * @throws unspecified any exception thrown by the evaluation of the fitness in the restarts
      */
     population evolve(population pop) const
+    {
+        m_n_restarts = 0u;
+        if (m_restart == 0u) {
+            return evolve_run(std::move(pop));
+        }
+        return evolve_restarts(std::move(pop));
+    }
+
+private:
+    // A single CMA-ES run (no restarts).
+    population evolve_run(population pop) const
     {
         // We store some useful variables
         const auto &prob = pop.get_problem(); // This is a const reference, so using set_seed for example will not be
                                               // allowed.
         auto dim = prob.get_nx();             // This getter does not return a const reference but a copy
-        const auto bounds = prob.get_bounds();
-        const auto &lb = bounds.first;
-        const auto &ub = bounds.second;
+        const auto &lb = prob.get_lb();
+        const auto &ub = prob.get_ub();
         auto lam = pop.size();
         auto mu = lam / 2u;
         auto prob_f_dimension = prob.get_nf();
@@ -425,6 +446,8 @@ public:
         }
         return pop;
     }
+
+public:
     /// Sets the seed
     /**
      * @param seed the seed controlling the algorithm stochastic behaviour
@@ -488,6 +511,57 @@ public:
     {
         return m_gen;
     }
+    /// Sets the restart strategy
+    /**
+     * When a run stops because of the \p ftol or \p xtol criteria before the budget of \p gen times the
+     * population size function evaluations is used, CMA-ES can be restarted from a random population. \p strategy
+     * can be:
+     * - "none": no restarts (the default),
+     * - "ipop": the population size is doubled at each restart (IPOP-CMA-ES),
+     * - "bipop": restarts with a doubling population size alternate with restarts with a small population and
+     *   a small step size (BIPOP-CMA-ES), so that the two regimes use about the same number of evaluations. If
+     *   the problem provides at least pagmo::thread_safety::basic, the small population runs are executed in a
+     *   separate thread while the large population run proceeds.
+     *
+     * The first run starts from the input population (and from the memory, if active), exactly as with no restarts.
+     * The restarts work on copies of the problem and the best individual they find replaces the worst individual of
+     * the population. The population size of the restarts is derived from the size of the input population.
+     *
+     * @param strategy the restart strategy
+     * @param max_restarts maximum number of restarts (for "bipop", of large population restarts)
+     *
+     * @throws std::invalid_argument if \p strategy is not one of "none", "ipop" or "bipop"
+     */
+    void set_restart(const std::string &strategy, unsigned int max_restarts = 9u)
+    {
+        if (strategy == "none") {
+            m_restart = 0u;
+        } else if (strategy == "ipop") {
+            m_restart = 1u;
+        } else if (strategy == "bipop") {
+            m_restart = 2u;
+        } else {
+            pagmo_throw(std::invalid_argument, "The restart strategy must be one of 'none', 'ipop' or 'bipop', while '"
+                                                   + strategy + "' was detected");
+        }
+        m_max_restarts = max_restarts;
+    }
+    /// Gets the restart strategy
+    /**
+     * @return the restart strategy ("none", "ipop" or "bipop")
+     */
+    std::string get_restart() const
+    {
+        return m_restart == 0u ? "none" : (m_restart == 1u ? "ipop" : "bipop");
+    }
+    /// Gets the number of restarts
+    /**
+     * @return the number of restarts performed in the last call to evolve()
+     */
+    unsigned int get_n_restarts() const
+    {
+        return m_n_restarts;
+    }
     /// Algorithm name
     /**
      * One of the optional methods of any user-defined algorithm (UDA).
@@ -532,6 +606,10 @@ public:
         stream(ss, "\n\tStopping xtol: ", m_xtol);
         stream(ss, "\n\tStopping ftol: ", m_ftol);
         stream(ss, "\n\tMemory: ", m_memory);
+        stream(ss, "\n\tRestart: ", get_restart());
+        if (m_restart != 0u) {
+            stream(ss, " (max ", m_max_restarts, " restarts)");
+        }
         stream(ss, "\n\tVerbosity: ", m_verbosity);
         stream(ss, "\n\tSeed: ", m_seed);
         return ss.str();
@@ -560,10 +638,146 @@ public:
     void serialize(Archive &ar)
     {
         ar(m_gen, m_cc, m_cs, m_c1, m_cmu, m_sigma0, m_ftol, m_xtol, m_memory, sigma, mean, variation, newpop, B, D, C,
-           invsqrtC, pc, ps, counteval, eigeneval, m_e, m_seed, m_verbosity, m_log);
+           invsqrtC, pc, ps, counteval, eigeneval, m_e, m_seed, m_verbosity, m_log, m_restart, m_max_restarts,
+           m_n_restarts);
     }
 
 private:
+    // A single run of a copy of this algorithm on a new random population: the copy has its own memory,
+    // so that several runs can proceed concurrently. Returns the champion of the run and the fevals used, which
+    // never exceed budget (the evaluation of the initial population included). If budget cannot pay for the
+    // initial population, nothing is done and the champion is empty.
+    std::tuple<vector_double, vector_double, unsigned long long>
+    restart_run(const problem &prob, population::size_type lam, double sigma0, unsigned long long budget,
+                unsigned int seed) const
+    {
+        if (budget < lam) {
+            return std::make_tuple(vector_double{}, vector_double{}, 0ull);
+        }
+        cmaes algo(*this);
+        algo.m_gen = static_cast<unsigned int>((budget - lam) / lam);
+        algo.m_sigma0 = sigma0;
+        algo.m_memory = false;
+        algo.m_restart = 0u;
+        algo.m_verbosity = 0u;
+        algo.m_e.seed(seed);
+        algo.m_seed = seed;
+        const auto fevals0 = prob.get_fevals();
+        auto rpop = algo.evolve_run(population{prob, lam, seed});
+        auto best = rpop.best_idx();
+        return std::make_tuple(rpop.get_x()[best], rpop.get_f()[best], rpop.get_problem().get_fevals() - fevals0);
+    }
+    // The IPOP and BIPOP restart strategies.
+    population evolve_restarts(population pop) const
+    {
+        const auto lam0 = pop.size();
+        const auto fevals_start = pop.get_problem().get_fevals();
+        // The first run starts from pop and uses the memory, exactly as with no restarts.
+        pop = evolve_run(std::move(pop));
+        if (m_gen == 0u) {
+            return pop;
+        }
+        auto &prob = pop.get_problem();
+        const auto budget = static_cast<unsigned long long>(m_gen) * lam0;
+        // Fevals used by the large (or only, in IPOP) and by the small population regimes.
+        unsigned long long used_large = prob.get_fevals() - fevals_start, used_small = 0u;
+        auto best_x = pop.get_x()[pop.best_idx()];
+        auto best_f = pop.get_f()[pop.best_idx()];
+        auto update_best = [&best_x, &best_f](const std::tuple<vector_double, vector_double, unsigned long long> &r) {
+            if (!std::get<1>(r).empty() && std::get<1>(r)[0] < best_f[0]) {
+                best_x = std::get<0>(r);
+                best_f = std::get<1>(r);
+            }
+        };
+        std::uniform_real_distribution<double> drng(0., 1.);
+        const bool concurrent = prob.get_thread_safety() >= thread_safety::basic;
+        auto lam_large = lam0;
+        unsigned int n_restarts = 0u;
+        while (n_restarts < m_max_restarts) {
+            auto remaining = budget - std::min(budget, used_large + used_small);
+            lam_large *= 2u;
+            if (m_restart == 2u) {
+                // BIPOP: before each large population restart, the small population regime catches up with the
+                // budget used by the large one. Its runs have population sizes between lam0 and lam_large / 2 and
+                // smaller step sizes, and are executed on a separate thread (if the problem allows it) while the large
+                // population run proceeds. The split of the budget is fixed before launching both, so the outcome does
+                // not depend on the scheduling.
+                const auto target = std::min(used_large - std::min(used_large, used_small), remaining / 2u);
+                const auto small_seed = static_cast<unsigned int>(m_e());
+                const auto large_seed = static_cast<unsigned int>(m_e());
+                const problem small_prob(prob);
+                auto small_regime = [this, &small_prob, lam0, lam_large, target, small_seed]() {
+                    detail::random_engine_type e(small_seed);
+                    std::uniform_real_distribution<double> u01(0., 1.);
+                    std::vector<std::tuple<vector_double, vector_double, unsigned long long>> retval;
+                    unsigned long long used = 0u;
+                    while (true) {
+                        const auto u = u01(e);
+                        const auto lam = std::max(
+                            lam0, static_cast<population::size_type>(static_cast<double>(lam0)
+                                                                     * std::pow(.5 * static_cast<double>(lam_large)
+                                                                                    / static_cast<double>(lam0),
+                                                                                u * u)));
+                        if (target - std::min(target, used) < 10u * lam) {
+                            break;
+                        }
+                        retval.push_back(restart_run(small_prob, lam, m_sigma0 * std::pow(10., -2. * u), target - used,
+                                                     static_cast<unsigned int>(e())));
+                        used += std::get<2>(retval.back());
+                    }
+                    return retval;
+                };
+                std::future<std::vector<std::tuple<vector_double, vector_double, unsigned long long>>> small_fut;
+                std::vector<std::tuple<vector_double, vector_double, unsigned long long>> small_runs;
+                if (concurrent) {
+                    small_fut = std::async(std::launch::async, small_regime);
+                } else {
+                    small_runs = small_regime();
+                }
+                std::tuple<vector_double, vector_double, unsigned long long> large_run;
+                if (remaining - target >= 10u * lam_large) {
+                    large_run = restart_run(prob, lam_large, m_sigma0, remaining - target, large_seed);
+                }
+                if (concurrent) {
+                    small_runs = small_fut.get();
+                }
+                for (const auto &r : small_runs) {
+                    update_best(r);
+                    used_small += std::get<2>(r);
+                }
+                if (std::get<1>(large_run).empty()) {
+                    // No budget left for a larger population.
+                    break;
+                }
+                update_best(large_run);
+                used_large += std::get<2>(large_run);
+                if (m_verbosity > 0u) {
+                    print("Restart ", n_restarts + 1u, " -- lambda: ", lam_large, ", small runs: ", small_runs.size(),
+                          ", best: ", best_f[0], '\n');
+                }
+            } else {
+                // IPOP: the population size is doubled at each restart.
+                if (remaining < 10u * lam_large) {
+                    break;
+                }
+                auto r = restart_run(prob, lam_large, m_sigma0, remaining, static_cast<unsigned int>(m_e()));
+                update_best(r);
+                used_large += std::get<2>(r);
+                if (m_verbosity > 0u) {
+                    print("Restart ", n_restarts + 1u, " -- lambda: ", lam_large, ", best: ", best_f[0], '\n');
+                }
+            }
+            ++n_restarts;
+        }
+        // The restarts ran on copies of the problem.
+        detail::problem_counters::increment_fevals(prob, used_large + used_small - (prob.get_fevals() - fevals_start));
+        m_n_restarts = n_restarts;
+        // The best individual found replaces the worst one in the population.
+        if (best_f[0] < pop.get_f()[pop.best_idx()][0]) {
+            pop.set_xf(pop.worst_idx(), best_x, best_f);
+        }
+        return pop;
+    }
     // Eigen stores indexes and sizes as signed types, while PaGMO
     // uses STL containers thus sizes and indexes are unsigned. To
     // make the conversion as painless as possible this template is provided
@@ -584,6 +798,10 @@ private:
     double m_ftol;
     double m_xtol;
     bool m_memory;
+    // Restart strategy: 0 none, 1 IPOP, 2 BIPOP.
+    unsigned int m_restart;
+    unsigned int m_max_restarts;
+    mutable unsigned int m_n_restarts;
 
     // "Memory" data members (these are adapted during each evolve call and may be remembered if m_memory is true)
     mutable double sigma;
@@ -608,6 +826,6 @@ private:
 
 } // namespace pagmo
 
-PAGMO_REGISTER_ALGORITHM(pagmo::cmaes)
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::cmaes)
 
 #endif
@@ -139,9 +139,8 @@ public:
         const auto &prob = pop.get_problem(); // This is a const reference, so using set_seed for example will not be
                                               // allowed
         auto dim = prob.get_nx();             // This getter does not return a const reference but a copy
-        const auto bounds = prob.get_bounds();
-        const auto &lb = bounds.first;
-        const auto &ub = bounds.second;
+        const auto &lb = prob.get_lb();
+        const auto &ub = prob.get_ub();
         auto neq = prob.get_nec();
 
         auto fevals0 = prob.get_fevals(); // discount for the already made fevals
@@ -180,11 +179,13 @@ public:
         unsigned int fevals = 0u;
 
         double newrange = m_start_range;
+        // The trial point, allocated once.
+        vector_double x_trial(dim);
 
         while (newrange > m_stop_range && fevals <= m_max_fevals) {
             flag = false;
             for (decltype(dim) i = 0u; i < dim; i++) {
-                auto x_trial = cur_best_x;
+                x_trial = cur_best_x;
                 // move up
                 x_trial[i] = cur_best_x[i] + newrange * (ub[i] - lb[i]);
                 // feasibility correction
@@ -398,6 +399,6 @@ private:
 
 } // namespaces
 
-PAGMO_REGISTER_ALGORITHM(pagmo::compass_search)
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::compass_search)
 
 #endif
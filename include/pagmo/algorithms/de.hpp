@@ -30,18 +30,20 @@ see https://www.gnu.org/licenses/. */
 #define PAGMO_ALGORITHMS_DE_HPP
 
 #include <iomanip>
-#include <numeric> //std::iota
 #include <random>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <utility> //std::swap
+#include <vector>
 
 #include "../algorithm.hpp"
+#include "../detail/de_kernels.hpp"
 #include "../exceptions.hpp"
 #include "../io.hpp"
 #include "../population.hpp"
 #include "../rng.hpp"
+#include "../static_problem.hpp"
 #include "../utils/generic.hpp"
 
 namespace pagmo
@@ -125,14 +127,173 @@ public:
      * @throws std::invalid_argument if the population size is not at least 5
      */
     population evolve(population pop) const
+    {
+        evolve_impl(pop, pop.get_problem());
+        return pop;
+    }
+
+    /// Algorithm evolve method, statically typed on the problem
+    /**
+     * Same as de::evolve(population) const, but the fitness evaluations are performed through a
+     * pagmo::static_problem of type \p UDP, so that they can be inlined in the generation loop.
+     * The UDP inside \p pop must be of type \p UDP, and it is not copied: the pagmo::static_problem is a view on it.
+     * The fitness evaluations performed are added to the counter of the problem in \p pop.
+     *
+     * Example:
+     * @code{.unparsed}
+     * population pop{rosenbrock{10u}, 20u};
+     * pop = de{100u}.evolve<rosenbrock>(pop);
+     * @endcode
+     *
+     * @param pop population to be evolved
+     * @return evolved population
+     * @throws std::invalid_argument if the problem in \p pop is not of type \p UDP
+     * @throws unspecified any exception thrown by de::evolve(population) const or by the constructor
+     * of pagmo::static_problem
+     */
+    template <typename UDP>
+    population evolve(population pop) const
+    {
+        // NOTE: the const overload of extract() does not unshare the UDP of the problem.
+        const auto ptr = static_cast<const population &>(pop).get_problem().template extract<UDP>();
+        if (!ptr) {
+            pagmo_throw(std::invalid_argument, "The problem in the population (" + pop.get_problem().get_name()
+                                                   + ") is not of the requested static type");
+        }
+        const static_problem<const UDP &> prob(*ptr);
+        {
+            // Credits the evaluations to the problem in pop also if an evaluation throws, as the type-erased
+            // evolve() does.
+            struct fevals_guard {
+                ~fevals_guard()
+                {
+                    detail::problem_counters::increment_fevals(m_pop_prob, m_prob.get_fevals());
+                }
+                const problem &m_pop_prob;
+                const static_problem<const UDP &> &m_prob;
+            };
+            const fevals_guard guard{pop.get_problem(), prob};
+            evolve_impl(pop, prob);
+        }
+        return pop;
+    }
+    /// Sets the seed
+    /**
+     * @param seed the seed controlling the algorithm stochastic behaviour
+     */
+    void set_seed(unsigned int seed)
+    {
+        m_seed = seed;
+    };
+    /// Gets the seed
+    /**
+     * @return the seed controlling the algorithm stochastic behaviour
+     */
+    unsigned int get_seed() const
+    {
+        return m_seed;
+    }
+    /// Sets the algorithm verbosity
+    /**
+     * Sets the verbosity level of the screen output and of the
+     * log returned by get_log(). \p level can be:
+     * - 0: no verbosity
+     * - >0: will print and log one line each \p level generations.
+     *
+     * Example (verbosity 100):
+     * @code{.unparsed}
+     * Gen:        Fevals:          Best:            dx:            df:
+     * 5001         100020    3.62028e-05      0.0396687      0.0002866
+     * 5101         102020    1.16784e-05      0.0473027    0.000249057
+     * 5201         104020    1.07883e-05      0.0455471    0.000243651
+     * 5301         106020    6.05099e-06      0.0268876    0.000103512
+     * 5401         108020    3.60664e-06      0.0230468    5.78161e-05
+     * 5501         110020     1.7188e-06      0.0141655    2.25688e-05
+     * @endcode
+     * Gen, is the generation number, Fevals the number of function evaluation used, Best is the best fitness
+     * function currently in the population, dx is the population flatness evaluated as the distance between
+     * the decisions vector of the best and of the worst individual, df is the population flatness evaluated
+     * as the distance between the fitness of the best and of the worst individual.
+     *
+     * @param level verbosity level
+     */
+    void set_verbosity(unsigned int level)
+    {
+        m_verbosity = level;
+    };
+    /// Gets the verbosity level
+    /**
+     * @return the verbosity level
+     */
+    unsigned int get_verbosity() const
+    {
+        return m_verbosity;
+    }
+    /// Gets the generations
+    /**
+     * @return the number of generations to evolve for
+     */
+    unsigned int get_gen() const
+    {
+        return m_gen;
+    }
+    /// Algorithm name
+    /**
+     * One of the optional methods of any user-defined algorithm (UDA).
+     *
+     * @return a string containing the algorithm name
+     */
+    std::string get_name() const
+    {
+        return "Differential Evolution";
+    }
+    /// Extra informations
+    /**
+     * One of the optional methods of any user-defined algorithm (UDA).
+     *
+     * @return a string containing extra informations on the algorithm
+     */
+    std::string get_extra_info() const
+    {
+        return "\tGenerations: " + std::to_string(m_gen) + "\n\tParameter F: " + std::to_string(m_F)
+               + "\n\tParameter CR: " + std::to_string(m_CR) + "\n\tVariant: " + std::to_string(m_variant)
+               + "\n\tStopping xtol: " + std::to_string(m_xtol) + "\n\tStopping ftol: " + std::to_string(m_Ftol)
+               + "\n\tVerbosity: " + std::to_string(m_verbosity) + "\n\tSeed: " + std::to_string(m_seed);
+    }
+    /// Get log
+    /**
+     * A log containing relevant quantities monitoring the last call to evolve. Each element of the returned
+     * <tt> std::vector </tt> is a de::log_line_type containing: Gen, Fevals, Best, dx, df as described
+     * in de::set_verbosity
+     * @return an <tt> std::vector </tt> of de::log_line_type containing the logged values Gen, Fevals, Best, dx, df
+     */
+    const log_type &get_log() const
+    {
+        return m_log;
+    }
+    /// Object serialization
+    /**
+     * This method will save/load \p this into the archive \p ar.
+     *
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of the UDP and of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_gen, m_F, m_CR, m_variant, m_Ftol, m_xtol, m_e, m_seed, m_verbosity, m_log);
+    }
+
+private:
+    // Implementation of evolve(), templated over the problem type (pagmo::problem or pagmo::static_problem).
+    template <typename Prob>
+    void evolve_impl(population &pop, const Prob &prob) const
     {
         // We store some useful variables
-        const auto &prob = pop.get_problem(); // This is a const reference, so using set_seed for example will not be
-                                              // allowed
-        auto dim = prob.get_nx();             // This getter does not return a const reference but a copy
-        const auto bounds = prob.get_bounds();
-        const auto &lb = bounds.first;
-        const auto &ub = bounds.second;
+        auto dim = prob.get_nx(); // This getter does not return a const reference but a copy
+        const auto &lb = prob.get_lb();
+        const auto &ub = prob.get_ub();
         auto NP = pop.size();
         auto prob_f_dimension = prob.get_nf();
         auto fevals0 = prob.get_fevals(); // disount for the already made fevals
@@ -155,7 +316,7 @@ public:
         }
         // Get out if there is nothing to do.
         if (m_gen == 0u) {
-            return pop;
+            return;
         }
         if (pop.size() < 5u) {
             pagmo_throw(std::invalid_argument, get_name() + " needs at least 5 individuals in the population, "
@@ -167,10 +328,12 @@ public:
         m_log.clear();
 
         // Some vectors used during evolution are declared.
-        vector_double tmp(dim);                              // contains the mutated candidate
-        std::uniform_real_distribution<double> drng(0., 1.); // to generate a number in [0, 1)
-        std::uniform_int_distribution<vector_double::size_type> c_idx(
-            0u, dim - 1u); // to generate a random index for the chromosome
+        detail::de_workspace ws;                 // buffers of the DE kernels
+        std::vector<vector_double> trials;       // contains the mutated candidates
+        std::vector<vector_double::size_type> r; // indexes of 5 selected population members for each individual
+        // The variant, F and CR of each individual.
+        const std::vector<unsigned> variants(NP, m_variant);
+        const vector_double Fs(NP, m_F), CRs(NP, m_CR);
 
         // We extract from pop the chromosomes and fitness associated
         auto popold = pop.get_x();
@@ -184,152 +347,17 @@ public:
         auto gbfit = fit[best_idx];
         // the best decision vector of a generation
         auto gbIter = gbX;
-        std::vector<vector_double::size_type> r(5); // indexes of 5 selected population members
 
         // Main DE iterations
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // The trial vectors of the whole generation are produced at once: they only
+            // depend on the previous generation.
+            detail::de_select_donors(r, NP, 5u, m_e, ws);
+            detail::de_generate_trials(trials, popold, gbIter, r, 5u, variants, Fs, CRs, lb, ub, m_e, ws);
             // Start of the loop through the population
             for (decltype(NP) i = 0u; i < NP; ++i) {
-                /*-----We select at random 5 indexes from the population---------------------------------*/
-                std::vector<vector_double::size_type> idxs(NP);
-                std::iota(idxs.begin(), idxs.end(), vector_double::size_type(0u));
-                for (auto j = 0u; j < 5u; ++j) { // Durstenfeld's algorithm to select 5 indexes at random
-                    auto idx = std::uniform_int_distribution<vector_double::size_type>(0u, NP - 1u - j)(m_e);
-                    r[j] = idxs[idx];
-                    std::swap(idxs[idx], idxs[NP - 1u - j]);
-                }
-
-                /*-------DE/best/1/exp--------------------------------------------------------------------*/
-                /*-------The oldest DE variant but still not bad. However, we have found several---------*/
-                /*-------optimization problems where misconvergence occurs.-------------------------------*/
-                if (m_variant == 1u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = gbIter[n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < m_CR) && (L < dim));
-                }
-
-                /*-------DE/rand/1/exp-------------------------------------------------------------------*/
-                /*-------This is one of my favourite strategies. It works especially well when the-------*/
-                /*-------"gbIter[]"-schemes experience misconvergence. Try e.g. m_F=0.7 and m_CR=0.5---------*/
-                /*-------as a first guess.---------------------------------------------------------------*/
-                else if (m_variant == 2u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    decltype(dim) L = 0u;
-                    do {
-                        tmp[n] = popold[r[0]][n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < m_CR) && (L < dim));
-                }
-                /*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
-                /*-------This variant seems to be one of the best strategies. Try m_F=0.85 and m_CR=1.------*/
-                /*-------If you get misconvergence try to increase NP. If this doesn't help you----------*/
-                /*-------should play around with all three control variables.----------------------------*/
-                else if (m_variant == 3u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = tmp[n] + m_F * (gbIter[n] - tmp[n]) + m_F * (popold[r[0]][n] - popold[r[1]][n]);
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < m_CR) && (L < dim));
-                }
-                /*-------DE/best/2/exp is another powerful variant worth trying--------------------------*/
-                else if (m_variant == 4u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n]
-                            = gbIter[n] + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < m_CR) && (L < dim));
-                }
-                /*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
-                else if (m_variant == 5u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = popold[r[4]][n]
-                                 + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < m_CR) && (L < dim));
-                }
-
-                /*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
-                /*-------DE/best/1/bin--------------------------------------------------------------------*/
-                else if (m_variant == 6u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                        if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = gbIter[n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/rand/1/bin-------------------------------------------------------------------*/
-                else if (m_variant == 7u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                        if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = popold[r[0]][n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/rand-to-best/1/bin-----------------------------------------------------------*/
-                else if (m_variant == 8u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                        if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = tmp[n] + m_F * (gbIter[n] - tmp[n]) + m_F * (popold[r[0]][n] - popold[r[1]][n]);
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/best/2/bin--------------------------------------------------------------------*/
-                else if (m_variant == 9u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                        if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = gbIter[n]
-                                     + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/rand/2/bin--------------------------------------------------------------------*/
-                else if (m_variant == 10u) {
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                        if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = popold[r[4]][n]
-                                     + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-
-                // Trial mutation now in tmp. force feasibility and see how good this choice really was.
-                // a) feasibility
-                // detail::force_bounds_reflection(tmp, lb, ub); // TODO: check if this choice is better
-                detail::force_bounds_random(tmp, lb, ub, m_e);
-                // b) how good?
+                auto &tmp = trials[i];
+                // How good was this trial?
                 auto newfitness = prob.fitness(tmp); /* Evaluates tmp[] */
                 if (newfitness[0] <= fit[i][0]) {    /* improved objective function value ? */
                     fit[i] = newfitness;
@@ -363,7 +391,7 @@ public:
                     if (m_verbosity > 0u) {
                         std::cout << "Exit condition -- xtol < " << m_xtol << std::endl;
                     }
-                    return pop;
+                    return;
                 }
 
                 df = std::abs(pop.get_f()[worst_idx][0] - pop.get_f()[best_idx][0]);
@@ -371,7 +399,7 @@ public:
                     if (m_verbosity > 0u) {
                         std::cout << "Exit condition -- ftol < " << m_Ftol << std::endl;
                     }
-                    return pop;
+                    return;
                 }
             }
 
@@ -404,117 +432,8 @@ public:
         if (m_verbosity) {
             std::cout << "Exit condition -- generations = " << m_gen << std::endl;
         }
-        return pop;
-    }
-    /// Sets the seed
-    /**
-     * @param seed the seed controlling the algorithm stochastic behaviour
-     */
-    void set_seed(unsigned int seed)
-    {
-        m_seed = seed;
-    };
-    /// Gets the seed
-    /**
-     * @return the seed controlling the algorithm stochastic behaviour
-     */
-    unsigned int get_seed() const
-    {
-        return m_seed;
-    }
-    /// Sets the algorithm verbosity
-    /**
-     * Sets the verbosity level of the screen output and of the
-     * log returned by get_log(). \p level can be:
-     * - 0: no verbosity
-     * - >0: will print and log one line each \p level generations.
-     *
-     * Example (verbosity 100):
-     * @code{.unparsed}
-     * Gen:        Fevals:          Best:            dx:            df:
-     * 5001         100020    3.62028e-05      0.0396687      0.0002866
-     * 5101         102020    1.16784e-05      0.0473027    0.000249057
-     * 5201         104020    1.07883e-05      0.0455471    0.000243651
-     * 5301         106020    6.05099e-06      0.0268876    0.000103512
-     * 5401         108020    3.60664e-06      0.0230468    5.78161e-05
-     * 5501         110020     1.7188e-06      0.0141655    2.25688e-05
-     * @endcode
-     * Gen, is the generation number, Fevals the number of function evaluation used, Best is the best fitness
-     * function currently in the population, dx is the population flatness evaluated as the distance between
-     * the decisions vector of the best and of the worst individual, df is the population flatness evaluated
-     * as the distance between the fitness of the best and of the worst individual.
-     *
-     * @param level verbosity level
-     */
-    void set_verbosity(unsigned int level)
-    {
-        m_verbosity = level;
-    };
-    /// Gets the verbosity level
-    /**
-     * @return the verbosity level
-     */
-    unsigned int get_verbosity() const
-    {
-        return m_verbosity;
-    }
-    /// Gets the generations
-    /**
-     * @return the number of generations to evolve for
-     */
-    unsigned int get_gen() const
-    {
-        return m_gen;
-    }
-    /// Algorithm name
-    /**
-     * One of the optional methods of any user-defined algorithm (UDA).
-     *
-     * @return a string containing the algorithm name
-     */
-    std::string get_name() const
-    {
-        return "Differential Evolution";
-    }
-    /// Extra informations
-    /**
-     * One of the optional methods of any user-defined algorithm (UDA).
-     *
-     * @return a string containing extra informations on the algorithm
-     */
-    std::string get_extra_info() const
-    {
-        return "\tGenerations: " + std::to_string(m_gen) + "\n\tParameter F: " + std::to_string(m_F)
-               + "\n\tParameter CR: " + std::to_string(m_CR) + "\n\tVariant: " + std::to_string(m_variant)
-               + "\n\tStopping xtol: " + std::to_string(m_xtol) + "\n\tStopping ftol: " + std::to_string(m_Ftol)
-               + "\n\tVerbosity: " + std::to_string(m_verbosity) + "\n\tSeed: " + std::to_string(m_seed);
-    }
-    /// Get log
-    /**
-     * A log containing relevant quantities monitoring the last call to evolve. Each element of the returned
-     * <tt> std::vector </tt> is a de::log_line_type containing: Gen, Fevals, Best, dx, df as described
-     * in de::set_verbosity
-     * @return an <tt> std::vector </tt> of de::log_line_type containing the logged values Gen, Fevals, Best, dx, df
-     */
-    const log_type &get_log() const
-    {
-        return m_log;
-    }
-    /// Object serialization
-    /**
-     * This method will save/load \p this into the archive \p ar.
-     *
-     * @param ar target archive.
-     *
-     * @throws unspecified any exception thrown by the serialization of the UDP and of primitive types.
-     */
-    template <typename Archive>
-    void serialize(Archive &ar)
-    {
-        ar(m_gen, m_F, m_CR, m_variant, m_Ftol, m_xtol, m_e, m_seed, m_verbosity, m_log);
     }
 
-private:
     unsigned int m_gen;
     double m_F;
     double m_CR;
@@ -529,6 +448,6 @@ private:
 
 } // namespace pagmo
 
-PAGMO_REGISTER_ALGORITHM(pagmo::de)
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::de)
 
 #endif
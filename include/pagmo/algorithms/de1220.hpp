@@ -30,14 +30,15 @@ see https://www.gnu.org/licenses/. */
 #define PAGMO_ALGORITHMS_DE1220_HPP
 
 #include <iomanip>
-#include <numeric> //std::iota
 #include <random>
 #include <sstream> //std::osstringstream
 #include <string>
 #include <tuple>
 #include <utility> //std::swap
+#include <vector>
 
 #include "../algorithm.hpp"
+#include "../detail/de_kernels.hpp"
 #include "../exceptions.hpp"
 #include "../io.hpp"
 #include "../population.hpp"
@@ -179,9 +180,8 @@ public:
         const auto &prob = pop.get_problem(); // This is a const reference, so using set_seed for example will not be
                                               // allowed
         auto dim = prob.get_nx();             // This getter does not return a const reference but a copy
-        const auto bounds = prob.get_bounds();
-        const auto &lb = bounds.first;
-        const auto &ub = bounds.second;
+        const auto &lb = prob.get_lb();
+        const auto &ub = prob.get_ub();
         auto NP = pop.size();
         auto prob_f_dimension = prob.get_nf();
         auto fevals0 = prob.get_fevals(); // disount for the already made fevals
@@ -216,14 +216,16 @@ public:
         m_log.clear();
 
         // Some vectors used during evolution are declared.
-        vector_double tmp(dim);                              // contains the mutated candidate
+        detail::de_workspace ws;                             // buffers of the DE kernels
+        std::vector<vector_double> trials;                   // contains the mutated candidates
+        std::vector<vector_double::size_type> r;             // indexes of 7 selected population members each
         std::uniform_real_distribution<double> drng(0., 1.); // to generate a number in [0, 1)
         std::normal_distribution<double> n_dist(0., 1.);     // to generate a normally distributed number
-        std::uniform_int_distribution<vector_double::size_type> c_idx(
-            0u, dim - 1u); // to generate a random index in the chromosome
-        std::uniform_int_distribution<vector_double::size_type> p_idx(0u, NP - 1u); // to generate a random index in pop
         std::uniform_int_distribution<vector_double::size_type> v_idx(0u, m_allowed_variants.size()
                                                                               - 1u); // to generate a random variant
+        // The variant, F and CR of each individual in the current generation.
+        std::vector<unsigned> variants(NP);
+        vector_double Fs(NP), CRs(NP);
 
         // We extract from pop the chromosomes and fitness associated
         auto popold = pop.get_x();
@@ -237,7 +239,6 @@ public:
         auto gbfit = fit[best_idx];
         // the best decision vector of a generation
         auto gbIter = gbX;
-        std::vector<vector_double::size_type> r(7); // indexes of 7 selected population members
 
         // Initialize the F and CR vectors
         if ((m_CR.size() != NP) || (m_F.size() != NP) || (m_variant.size() != NP) || (!m_memory)) {
@@ -271,348 +272,28 @@ public:
 
         // Main DE iterations
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
-            // Start of the loop through the population
+            // The trial vectors of the whole generation are produced at once: they only
+            // depend on the previous generation, and so do the adapted F, CR and variant.
+            detail::de_select_donors(r, NP, detail::de_max_donors, m_e, ws);
             for (decltype(NP) i = 0u; i < NP; ++i) {
-                /*-----We select at random 5 indexes from the population---------------------------------*/
-                std::vector<vector_double::size_type> idxs(NP);
-                std::iota(idxs.begin(), idxs.end(), vector_double::size_type(0u));
-                for (auto j = 0u; j < 7u; ++j) { // Durstenfeld's algorithm to select 7 indexes at random
-                    auto idx = std::uniform_int_distribution<vector_double::size_type>(0u, NP - 1u - j)(m_e);
-                    r[j] = idxs[idx];
-                    std::swap(idxs[idx], idxs[NP - 1u - j]);
-                }
-
                 // Adapt amplification factor, crossover probability and mutation variant for DE 1220
-                double F = 0., CR = 0.;
-                unsigned int VARIANT = 0u;
-                VARIANT = (drng(m_e) < 0.9) ? m_variant[i] : m_allowed_variants[v_idx(m_e)];
+                variants[i] = (drng(m_e) < 0.9) ? m_variant[i] : m_allowed_variants[v_idx(m_e)];
                 if (m_variant_adptv == 1u) {
-                    F = (drng(m_e) < 0.9) ? m_F[i] : drng(m_e) * 0.9 + 0.1;
-                    CR = (drng(m_e) < 0.9) ? m_CR[i] : drng(m_e);
-                }
-
-                /*-------DE/best/1/exp--------------------------------------------------------------------*/
-                if (VARIANT == 1u) {
-                    if (m_variant_adptv == 2u) {
-                        F = gbIterF + n_dist(m_e) * 0.5 * (m_F[r[1]] - m_F[r[2]]);
-                        CR = gbIterCR + n_dist(m_e) * 0.5 * (m_CR[r[1]] - m_CR[r[2]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = gbIter[n] + F * (popold[r[1]][n] - popold[r[2]][n]);
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < CR) && (L < dim));
-                }
-
-                /*-------DE/rand/1/exp-------------------------------------------------------------------*/
-                else if (VARIANT == 2u) {
-                    if (m_variant_adptv == 2u) {
-                        F = m_F[r[0]] + n_dist(m_e) * 0.5 * (m_F[r[1]] - m_F[r[2]]);
-                        CR = m_CR[r[0]] + n_dist(m_e) * 0.5 * (m_CR[r[1]] - m_CR[r[2]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    decltype(dim) L = 0u;
-                    do {
-                        tmp[n] = popold[r[0]][n] + F * (popold[r[1]][n] - popold[r[2]][n]);
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < CR) && (L < dim));
-                }
-                /*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
-                else if (VARIANT == 3u) {
-                    if (m_variant_adptv == 2u) {
-                        F = m_F[i] + n_dist(m_e) * 0.5 * (gbIterF - m_F[i])
-                            + n_dist(m_e) * 0.5 * (m_F[r[0]] - m_F[r[1]]);
-                        CR = m_CR[i] + n_dist(m_e) * 0.5 * (gbIterCR - m_CR[i])
-                             + n_dist(m_e) * 0.5 * (m_CR[r[0]] - m_CR[r[1]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = tmp[n] + F * (gbIter[n] - tmp[n]) + F * (popold[r[0]][n] - popold[r[1]][n]);
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < CR) && (L < dim));
-                }
-                /*-------DE/best/2/exp is another powerful variant worth trying--------------------------*/
-                else if (VARIANT == 4u) {
-                    if (m_variant_adptv == 2u) {
-                        F = gbIterF + n_dist(m_e) * 0.5 * (m_F[r[0]] - m_F[r[1]])
-                            + n_dist(m_e) * 0.5 * (m_F[r[2]] - m_F[r[3]]);
-                        CR = gbIterCR + n_dist(m_e) * 0.5 * (m_CR[r[0]] - m_CR[r[1]])
-                             + n_dist(m_e) * 0.5 * (m_CR[r[2]] - m_CR[r[3]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = gbIter[n] + (popold[r[0]][n] - popold[r[1]][n]) * F
-                                 + (popold[r[2]][n] - popold[r[3]][n]) * F;
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < CR) && (L < dim));
-                }
-                /*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
-                else if (VARIANT == 5u) {
-                    if (m_variant_adptv == 2u) {
-                        F = m_F[r[4]] + n_dist(m_e) * 0.5 * (m_F[r[0]] - m_F[r[1]])
-                            + n_dist(m_e) * 0.5 * (m_F[r[2]] - m_F[r[3]]);
-                        CR = m_CR[r[4]] + n_dist(m_e) * 0.5 * (m_CR[r[0]] - m_CR[r[1]])
-                             + n_dist(m_e) * 0.5 * (m_CR[r[2]] - m_CR[r[3]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = popold[r[4]][n] + (popold[r[0]][n] - popold[r[1]][n]) * F
-                                 + (popold[r[2]][n] - popold[r[3]][n]) * F;
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < CR) && (L < dim));
-                }
-
-                /*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
-                /*-------DE/best/1/bin--------------------------------------------------------------------*/
-                else if (VARIANT == 6u) {
-                    if (m_variant_adptv == 2u) {
-                        F = gbIterF + n_dist(m_e) * 0.5 * (m_F[r[1]] - m_F[r[2]]);
-                        CR = gbIterCR + n_dist(m_e) * 0.5 * (m_CR[r[1]] - m_CR[r[2]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {   /* perform Dc binomial trials */
-                        if ((drng(m_e) < CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = gbIter[n] + F * (popold[r[1]][n] - popold[r[2]][n]);
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/rand/1/bin-------------------------------------------------------------------*/
-                else if (VARIANT == 7u) {
-                    if (m_variant_adptv == 2u) {
-                        F = m_F[r[0]] + n_dist(m_e) * 0.5 * (m_F[r[1]] - m_F[r[2]]);
-                        CR = m_CR[r[0]] + n_dist(m_e) * 0.5 * (m_CR[r[1]] - m_CR[r[2]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {   /* perform Dc binomial trials */
-                        if ((drng(m_e) < CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = popold[r[0]][n] + F * (popold[r[1]][n] - popold[r[2]][n]);
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/rand-to-best/1/bin-----------------------------------------------------------*/
-                else if (VARIANT == 8u) {
-                    if (m_variant_adptv == 2u) {
-                        F = m_F[i] + n_dist(m_e) * 0.5 * (gbIterF - m_F[i])
-                            + n_dist(m_e) * 0.5 * (m_F[r[0]] - m_F[r[1]]);
-                        CR = m_CR[i] + n_dist(m_e) * 0.5 * (gbIterCR - m_CR[i])
-                             + n_dist(m_e) * 0.5 * (m_CR[r[0]] - m_CR[r[1]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {   /* perform Dc binomial trials */
-                        if ((drng(m_e) < CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = tmp[n] + F * (gbIter[n] - tmp[n]) + F * (popold[r[0]][n] - popold[r[1]][n]);
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/best/2/bin--------------------------------------------------------------------*/
-                else if (VARIANT == 9u) {
-                    if (m_variant_adptv == 2u) {
-                        F = gbIterF + n_dist(m_e) * 0.5 * (m_F[r[0]] - m_F[r[1]])
-                            + n_dist(m_e) * 0.5 * (m_F[r[2]] - m_F[r[3]]);
-                        CR = gbIterCR + n_dist(m_e) * 0.5 * (m_CR[r[0]] - m_CR[r[1]])
-                             + n_dist(m_e) * 0.5 * (m_CR[r[2]] - m_CR[r[3]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {   /* perform Dc binomial trials */
-                        if ((drng(m_e) < CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = gbIter[n] + (popold[r[0]][n] - popold[r[1]][n]) * F
-                                     + (popold[r[2]][n] - popold[r[3]][n]) * F;
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/rand/2/bin--------------------------------------------------------------------*/
-                else if (VARIANT == 10u) {
-                    if (m_variant_adptv == 2u) {
-                        F = m_F[r[4]] + n_dist(m_e) * 0.5 * (m_F[r[0]] - m_F[r[1]])
-                            + n_dist(m_e) * 0.5 * (m_F[r[2]] - m_F[r[3]]);
-                        CR = m_CR[r[4]] + n_dist(m_e) * 0.5 * (m_CR[r[0]] - m_CR[r[1]])
-                             + n_dist(m_e) * 0.5 * (m_CR[r[2]] - m_CR[r[3]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {   /* perform Dc binomial trials */
-                        if ((drng(m_e) < CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = popold[r[4]][n] + (popold[r[0]][n] - popold[r[1]][n]) * F
-                                     + (popold[r[2]][n] - popold[r[3]][n]) * F;
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/rand/3/exp --------------------------------------------------------------------*/
-                else if (VARIANT == 11u) {
-                    if (m_variant_adptv == 2u) {
-                        F = m_F[r[0]] + n_dist(m_e) * 0.5 * (m_F[r[1]] - m_F[r[2]])
-                            + n_dist(m_e) * 0.5 * (m_F[r[3]] - m_F[r[4]]) + n_dist(m_e) * 0.5 * (m_F[r[5]] - m_F[r[6]]);
-                        CR = m_CR[r[4]] + n_dist(m_e) * 0.5 * (m_CR[r[0]] + m_CR[r[1]] - m_CR[r[2]] - m_CR[r[3]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = popold[r[0]][n] + (popold[r[1]][n] - popold[r[2]][n]) * F
-                                 + (popold[r[3]][n] - popold[r[4]][n]) * F + (popold[r[5]][n] - popold[r[6]][n]) * F;
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < CR) && (L < dim));
-                }
-                /*-------DE/rand/3/bin --------------------------------------------------------------------*/
-                else if (VARIANT == 12u) {
-                    if (m_variant_adptv == 2u) {
-                        F = m_F[r[0]] + n_dist(m_e) * 0.5 * (m_F[r[1]] - m_F[r[2]])
-                            + n_dist(m_e) * 0.5 * (m_F[r[3]] - m_F[r[4]]) + n_dist(m_e) * 0.5 * (m_F[r[5]] - m_F[r[6]]);
-                        CR = m_CR[r[4]] + n_dist(m_e) * 0.5 * (m_CR[r[0]] + m_CR[r[1]] - m_CR[r[2]] - m_CR[r[3]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {   /* perform Dc binomial trials */
-                        if ((drng(m_e) < CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = popold[r[0]][n] + (popold[r[1]][n] - popold[r[2]][n]) * F
-                                     + (popold[r[3]][n] - popold[r[4]][n]) * F
-                                     + (popold[r[5]][n] - popold[r[6]][n]) * F;
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/best/3/exp --------------------------------------------------------------------*/
-                else if (VARIANT == 13u) {
-                    if (m_variant_adptv == 2u) {
-                        F = gbIterF + n_dist(m_e) * 0.5 * (m_F[r[1]] - m_F[r[2]])
-                            + n_dist(m_e) * 0.5 * (m_F[r[3]] - m_F[r[4]]) + n_dist(m_e) * 0.5 * (m_F[r[5]] - m_F[r[6]]);
-                        CR = gbIterCR + n_dist(m_e) * 0.5 * (m_CR[r[0]] + m_CR[r[1]] - m_CR[r[2]] - m_CR[r[3]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = gbIter[n] + (popold[r[1]][n] - popold[r[2]][n]) * F
-                                 + (popold[r[3]][n] - popold[r[4]][n]) * F + (popold[r[5]][n] - popold[r[6]][n]) * F;
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < CR) && (L < dim));
-                }
-                /*-------DE/best/3/bin --------------------------------------------------------------------*/
-                else if (VARIANT == 14u) {
-                    if (m_variant_adptv == 2u) {
-                        F = gbIterF + n_dist(m_e) * 0.5 * (m_F[r[1]] - m_F[r[2]])
-                            + n_dist(m_e) * 0.5 * (m_F[r[3]] - m_F[r[4]]) + n_dist(m_e) * 0.5 * (m_F[r[5]] - m_F[r[6]]);
-                        CR = gbIterCR + n_dist(m_e) * 0.5 * (m_CR[r[0]] + m_CR[r[1]] - m_CR[r[2]] - m_CR[r[3]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {   /* perform Dc binomial trials */
-                        if ((drng(m_e) < CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = gbIter[n] + (popold[r[1]][n] - popold[r[2]][n]) * F
-                                     + (popold[r[3]][n] - popold[r[4]][n]) * F
-                                     + (popold[r[5]][n] - popold[r[6]][n]) * F;
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/rand-to-current/2/exp --------------------------------------------------------------------*/
-                else if (VARIANT == 15u) {
-                    if (m_variant_adptv == 2u) {
-                        F = m_F[r[0]] + n_dist(m_e) * 0.5 * (m_F[r[1]] - m_F[i])
-                            + n_dist(m_e) * 0.5 * (m_F[r[3]] - m_F[r[4]]);
-                        CR = m_CR[r[0]] + n_dist(m_e) * 0.5 * (m_CR[r[1]] - m_CR[i])
-                             + n_dist(m_e) * 0.5 * (m_CR[r[3]] - m_CR[r[4]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = popold[r[0]][n] + (popold[r[1]][n] - popold[i][n]) * F
-                                 + (popold[r[2]][n] - popold[r[3]][n]) * F;
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < CR) && (L < dim));
-                }
-                /*-------DE/rand-to-current/2/bin --------------------------------------------------------------------*/
-                else if (VARIANT == 16u) {
-                    if (m_variant_adptv == 2u) {
-                        F = m_F[r[0]] + n_dist(m_e) * 0.5 * (m_F[r[1]] - m_F[i])
-                            + n_dist(m_e) * 0.5 * (m_F[r[3]] - m_F[r[4]]);
-                        CR = m_CR[r[0]] + n_dist(m_e) * 0.5 * (m_CR[r[1]] - m_CR[i])
-                             + n_dist(m_e) * 0.5 * (m_CR[r[3]] - m_CR[r[4]]);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {   /* perform Dc binomial trials */
-                        if ((drng(m_e) < CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = popold[r[0]][n] + (popold[r[1]][n] - popold[i][n]) * F
-                                     + (popold[r[2]][n] - popold[r[3]][n]) * F;
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-                /*-------DE/rand-to-best-and-current/2/exp
-                   --------------------------------------------------------------------*/
-                else if (VARIANT == 17u) {
-                    if (m_variant_adptv == 2u) {
-                        F = m_F[r[0]] + n_dist(m_e) * 0.5 * (m_F[r[1]] - m_F[i])
-                            - n_dist(m_e) * 0.5 * (m_F[r[2]] - gbIterF);
-                        CR = m_CR[r[0]] + n_dist(m_e) * 0.5 * (m_CR[r[1]] - m_CR[i])
-                             - n_dist(m_e) * 0.5 * (m_CR[r[3]] - gbIterCR);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    auto L = 0u;
-                    do {
-                        tmp[n] = popold[r[0]][n] + (popold[r[1]][n] - popold[i][n]) * F
-                                 - (popold[r[2]][n] - gbIter[n]) * F;
-                        n = (n + 1u) % dim;
-                        ++L;
-                    } while ((drng(m_e) < CR) && (L < dim));
-                }
-                /*-------DE/rand-to-best-and-current/2/bin
-                   --------------------------------------------------------------------*/
-                else if (VARIANT == 18u) {
-                    if (m_variant_adptv == 2u) {
-                        F = m_F[r[0]] + n_dist(m_e) * 0.5 * (m_F[r[1]] - m_F[i])
-                            - n_dist(m_e) * 0.5 * (m_F[r[2]] - gbIterF);
-                        CR = m_CR[r[0]] + n_dist(m_e) * 0.5 * (m_CR[r[1]] - m_CR[i])
-                             - n_dist(m_e) * 0.5 * (m_CR[r[3]] - gbIterCR);
-                    }
-                    tmp = popold[i];
-                    auto n = c_idx(m_e);
-                    for (decltype(dim) L = 0u; L < dim; ++L) {   /* perform Dc binomial trials */
-                        if ((drng(m_e) < CR) || L + 1u == dim) { /* change at least one parameter */
-                            tmp[n] = popold[r[0]][n] + (popold[r[1]][n] - popold[i][n]) * F
-                                     - (popold[r[2]][n] - gbIter[n]) * F;
-                        }
-                        n = (n + 1u) % dim;
-                    }
-                }
-
-                /*==Trial mutation now in tmp. force feasibility and see how good this choice really was.==*/
-                // a) feasibility
-                for (decltype(dim) j = 0u; j < dim; ++j) {
-                    if ((tmp[j] < lb[j]) || (tmp[j] > ub[j])) {
-                        tmp[j] = uniform_real_from_range(lb[j], ub[j], m_e);
-                    }
+                    Fs[i] = (drng(m_e) < 0.9) ? m_F[i] : drng(m_e) * 0.9 + 0.1;
+                    CRs[i] = (drng(m_e) < 0.9) ? m_CR[i] : drng(m_e);
+                } else {
+                    std::tie(Fs[i], CRs[i]) = detail::de_adapt_F_CR(
+                        variants[i], i, r.data() + i * detail::de_max_donors, m_F, m_CR, gbIterF, gbIterCR, m_e);
                 }
-                // b) how good?
+            }
+            detail::de_generate_trials(trials, popold, gbIter, r, detail::de_max_donors, variants, Fs, CRs, lb, ub,
+                                       m_e, ws);
+            // Start of the loop through the population
+            for (decltype(NP) i = 0u; i < NP; ++i) {
+                auto &tmp = trials[i];
+                const auto F = Fs[i], CR = CRs[i];
+                const auto VARIANT = variants[i];
+                // How good was this trial?
                 auto newfitness = prob.fitness(tmp); /* Evaluates tmp[] */
                 if (newfitness[0] <= fit[i][0]) {    /* improved objective function value ? */
                     fit[i] = newfitness;
@@ -846,6 +527,6 @@ private:
 
 } // namespace pagmo
 
-PAGMO_REGISTER_ALGORITHM(pagmo::de1220)
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::de1220)
 
 #endif
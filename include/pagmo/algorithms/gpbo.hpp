@@ -0,0 +1,819 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_ALGORITHMS_GPBO_HPP
+#define PAGMO_ALGORITHMS_GPBO_HPP
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../algorithm.hpp"
+#include "../exceptions.hpp"
+#include "../io.hpp"
+#include "../population.hpp"
+#include "../problem.hpp"
+#include "../rng.hpp"
+#include "../serialization.hpp"
+#include "../threading.hpp"
+#include "../types.hpp"
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// Gaussian process surrogate used by gpbo. It is a zero-mean process with an ARD
+// squared-exponential kernel, defined over inputs scaled to the unit hypercube and
+// over standardised outputs. The hyperparameters are stored in log space as
+// (log l_1, ..., log l_d, log sf2, log sn2).
+struct gpbo_gp {
+    // Box constraints on the log-hyperparameters, keeping the likelihood well posed.
+    static double min_log_l()
+    {
+        return std::log(1e-2);
+    }
+    static double max_log_l()
+    {
+        return std::log(1e1);
+    }
+    static double min_log_sf2()
+    {
+        return std::log(5e-2);
+    }
+    static double max_log_sf2()
+    {
+        return std::log(2e1);
+    }
+    static double min_log_sn2()
+    {
+        return std::log(1e-8);
+    }
+    static double max_log_sn2()
+    {
+        return std::log(1.);
+    }
+    static Eigen::VectorXd default_theta(Eigen::DenseIndex dim)
+    {
+        Eigen::VectorXd retval(dim + 2);
+        retval.head(dim).setConstant(std::log(0.3));
+        retval(dim) = 0.;
+        retval(dim + 1) = std::log(1e-6);
+        return retval;
+    }
+    void project(Eigen::VectorXd &t) const
+    {
+        const auto dim = X.cols();
+        for (Eigen::DenseIndex k = 0; k < dim; ++k) {
+            t(k) = std::min(std::max(t(k), min_log_l()), max_log_l());
+        }
+        t(dim) = std::min(std::max(t(dim), min_log_sf2()), max_log_sf2());
+        t(dim + 1) = std::min(std::max(t(dim + 1), min_log_sn2()), max_log_sn2());
+    }
+    void set_theta(const Eigen::VectorXd &t)
+    {
+        const auto dim = X.cols();
+        theta = t;
+        il2 = (-2. * theta.head(dim)).array().exp().matrix();
+        sf2 = std::exp(theta(dim));
+        sn2 = std::exp(theta(dim + 1));
+    }
+    template <typename A, typename B>
+    double kernel(const A &a, const B &b) const
+    {
+        return sf2 * std::exp(-.5 * ((a - b).array().square() * il2.transpose().array()).sum());
+    }
+    // Noise-free kernel matrix between the rows of X1 and those of X2.
+    Eigen::MatrixXd kernel_matrix(const Eigen::MatrixXd &X1, const Eigen::MatrixXd &X2) const
+    {
+        Eigen::MatrixXd retval(X1.rows(), X2.rows());
+        for (Eigen::DenseIndex i = 0; i < X1.rows(); ++i) {
+            for (Eigen::DenseIndex j = 0; j < X2.rows(); ++j) {
+                retval(i, j) = kernel(X1.row(i), X2.row(j));
+            }
+        }
+        return retval;
+    }
+    // Cholesky factorisation of a covariance matrix, adding increasing jitter to
+    // the diagonal if needed. Returns false if the matrix could not be factorised.
+    bool cholesky(Eigen::MatrixXd K, Eigen::MatrixXd &chol) const
+    {
+        double jitter = 0.;
+        for (auto i = 0; i < 6; ++i) {
+            Eigen::LLT<Eigen::MatrixXd> llt(K);
+            if (llt.info() == Eigen::Success) {
+                chol = llt.matrixL();
+                return true;
+            }
+            const auto new_jitter = (jitter == 0.) ? 1e-10 * sf2 : jitter * 10.;
+            K.diagonal().array() += new_jitter - jitter;
+            jitter = new_jitter;
+        }
+        return false;
+    }
+    void solve_alpha()
+    {
+        alpha = L.triangularView<Eigen::Lower>().solve(y);
+        L.triangularView<Eigen::Lower>().transpose().solveInPlace(alpha);
+    }
+    // Full O(n^3) factorisation of K + sn2 I with the current hyperparameters.
+    void factorize()
+    {
+        Eigen::MatrixXd K = kernel_matrix(X, X);
+        K.diagonal().array() += sn2;
+        if (!cholesky(K, L)) {
+            pagmo_throw(std::runtime_error, "the covariance matrix of the Gaussian process could not be factorised");
+        }
+        solve_alpha();
+    }
+    // Log marginal likelihood of the standardised data for the hyperparameters t and
+    // its gradient with respect to t.
+    double log_likelihood(const Eigen::VectorXd &t, Eigen::VectorXd &grad)
+    {
+        set_theta(t);
+        const auto n = X.rows(), dim = X.cols();
+        Eigen::MatrixXd Kf = kernel_matrix(X, X);
+        Eigen::MatrixXd K = Kf;
+        K.diagonal().array() += sn2;
+        Eigen::LLT<Eigen::MatrixXd> llt(K);
+        if (llt.info() != Eigen::Success) {
+            return -std::numeric_limits<double>::infinity();
+        }
+        const Eigen::VectorXd a = llt.solve(y);
+        double retval = -.5 * y.dot(a) - .5 * static_cast<double>(n) * std::log(2. * 3.14159265358979323846);
+        for (Eigen::DenseIndex i = 0; i < n; ++i) {
+            retval -= std::log(llt.matrixLLT()(i, i));
+        }
+        // dL/dt_k = 1/2 tr((a a^T - K^-1) dK/dt_k).
+        const Eigen::MatrixXd W = a * a.transpose() - llt.solve(Eigen::MatrixXd::Identity(n, n));
+        grad = Eigen::VectorXd::Zero(dim + 2);
+        for (Eigen::DenseIndex i = 0; i < n; ++i) {
+            for (Eigen::DenseIndex j = 0; j < n; ++j) {
+                const auto wk = W(i, j) * Kf(i, j);
+                grad(dim) += wk;
+                for (Eigen::DenseIndex k = 0; k < dim; ++k) {
+                    const auto d = X(i, k) - X(j, k);
+                    grad(k) += wk * d * d * il2(k);
+                }
+            }
+        }
+        grad(dim + 1) = sn2 * W.trace();
+        grad *= .5;
+        return retval;
+    }
+    // Projected gradient ascent on the log marginal likelihood, with an adaptive step
+    // size, starting from the current hyperparameters.
+    void fit_hyperparameters(unsigned iters)
+    {
+        Eigen::VectorXd t = theta, g, cand, gc;
+        project(t);
+        double f = log_likelihood(t, g);
+        if (!std::isfinite(f)) {
+            t = default_theta(X.cols());
+            f = log_likelihood(t, g);
+        }
+        double step = .5;
+        for (decltype(iters) it = 0u; it < iters && std::isfinite(f); ++it) {
+            const auto gnorm = g.norm();
+            if (!(gnorm > 1e-8)) {
+                break;
+            }
+            cand = t + (step / gnorm) * g;
+            project(cand);
+            const auto fc = log_likelihood(cand, gc);
+            if (fc > f) {
+                t = cand;
+                f = fc;
+                g = gc;
+                step = std::min(step * 1.5, 2.);
+            } else {
+                step *= .5;
+                if (step < 1e-4) {
+                    break;
+                }
+            }
+        }
+        set_theta(std::isfinite(f) ? t : default_theta(X.cols()));
+    }
+    // Sets the data, optionally refits the hyperparameters and factorises from scratch.
+    void fit(const Eigen::MatrixXd &Xn, const Eigen::VectorXd &yn, bool refit, unsigned iters)
+    {
+        X = Xn;
+        y_mean = yn.mean();
+        y_std = std::sqrt((yn.array() - y_mean).square().mean());
+        if (!(y_std > 0.) || !std::isfinite(y_std)) {
+            y_std = 1.;
+        }
+        y = (yn.array() - y_mean).matrix() / y_std;
+        if (theta.size() != X.cols() + 2) {
+            theta = default_theta(X.cols());
+        }
+        set_theta(theta);
+        if (refit) {
+            fit_hyperparameters(iters);
+        }
+        factorize();
+    }
+    // Appends new observations keeping the hyperparameters and the output scaling fixed.
+    // The Cholesky factor is extended by a block, at O(n^2 m) cost for m new points:
+    // L21 = K21 L11^-T and L22 = chol(K22 - L21 L21^T).
+    void append(const Eigen::MatrixXd &Xn, const Eigen::VectorXd &yn)
+    {
+        const auto n = X.rows(), m = Xn.rows();
+        const Eigen::MatrixXd L21t = L.triangularView<Eigen::Lower>().solve(kernel_matrix(X, Xn));
+        Eigen::MatrixXd S = kernel_matrix(Xn, Xn) - L21t.transpose() * L21t;
+        S.diagonal().array() += sn2;
+        X.conservativeResize(n + m, Eigen::NoChange);
+        X.bottomRows(m) = Xn;
+        y.conservativeResize(n + m);
+        y.tail(m) = (yn.array() - y_mean).matrix() / y_std;
+        Eigen::MatrixXd L22;
+        if (!cholesky(S, L22)) {
+            // Numerically degenerate update: fall back to a full factorisation.
+            factorize();
+            return;
+        }
+        Eigen::MatrixXd newL = Eigen::MatrixXd::Zero(n + m, n + m);
+        newL.topLeftCorner(n, n) = L;
+        newL.bottomLeftCorner(m, n) = L21t.transpose();
+        newL.bottomRightCorner(m, m) = L22;
+        L.swap(newL);
+        solve_alpha();
+    }
+    // Posterior mean and standard deviation of the latent function (standardised units).
+    void predict(const Eigen::VectorXd &x, double &mu, double &s) const
+    {
+        Eigen::VectorXd k(X.rows());
+        for (Eigen::DenseIndex i = 0; i < X.rows(); ++i) {
+            k(i) = kernel(x.transpose(), X.row(i));
+        }
+        mu = k.dot(alpha);
+        L.triangularView<Eigen::Lower>().solveInPlace(k);
+        s = std::sqrt(std::max(sf2 - k.squaredNorm(), 1e-12));
+    }
+    // Norm of the gradient of the posterior mean.
+    double mean_gradient_norm(const Eigen::VectorXd &x) const
+    {
+        Eigen::VectorXd g = Eigen::VectorXd::Zero(X.cols());
+        for (Eigen::DenseIndex i = 0; i < X.rows(); ++i) {
+            const Eigen::VectorXd d = X.row(i).transpose() - x;
+            g += (alpha(i) * kernel(x.transpose(), X.row(i))) * d.cwiseProduct(il2);
+        }
+        return g.norm();
+    }
+
+    Eigen::MatrixXd X;
+    Eigen::VectorXd y;
+    Eigen::VectorXd theta;
+    Eigen::VectorXd il2;
+    double sf2 = 1.;
+    double sn2 = 1e-6;
+    Eigen::MatrixXd L;
+    Eigen::VectorXd alpha;
+    double y_mean = 0.;
+    double y_std = 1.;
+};
+
+} // namespace detail
+
+/// Gaussian Process Bayesian Optimization
+/**
+ * Bayesian optimization builds a Gaussian process (GP) surrogate of the objective function from all the
+ * evaluations performed so far and uses it to decide where to sample next, by maximizing an acquisition function.
+ * It is meant for expensive, low dimensional black-box problems where each fitness evaluation can take minutes or
+ * hours, so that the cost of the surrogate model is negligible.
+ *
+ * The version implemented in PaGMO uses an ARD squared-exponential kernel whose hyperparameters (one length-scale
+ * per dimension, the signal and the noise variances) are fitted by gradient ascent on the log marginal likelihood.
+ * The hyperparameters are refitted every \p hyper_every rounds; in between, the newly evaluated points are added to
+ * the model with an incremental Cholesky update, which costs \f$ O(n^2) \f$ per point rather than \f$ O(n^3) \f$.
+ *
+ * At each round (generation) a batch of \p batch_size points is selected by maximizing the expected improvement
+ * under the local penalization scheme: after a point is chosen, the acquisition function is multiplied by a
+ * penalizer that removes the region the point is expected to explore, using an estimate of the Lipschitz constant
+ * of the objective. The batch is then evaluated at once: if the problem provides at least
+ * pagmo::thread_safety::basic, each point is evaluated in its own thread on a copy of the problem, so that several
+ * expensive evaluations run concurrently.
+ *
+ * The initial design is the input population, whose size is left unchanged: each newly evaluated point replaces the
+ * worst individual when it improves on it.
+ *
+ * **NOTE** The gpbo::evolve method cannot be called concurrently by different threads even if it is marked as const.
+ * The mutable members make such an operation result in an undefined behaviour in terms of algorithmic convergence.
+ *
+ * See: González, Javier, et al. "Batch Bayesian optimization via local penalization." Artificial Intelligence and
+ * Statistics. 2016.
+ */
+class gpbo
+{
+public:
+    /// Single entry of the log (gen, fevals, best, max EI, Lipschitz)
+    typedef std::tuple<unsigned int, unsigned long long, double, double, double> log_line_type;
+    /// The log
+    typedef std::vector<log_line_type> log_type;
+
+    /// Constructor.
+    /**
+     * Constructs gpbo
+     *
+     * @param gen number of rounds (generations). Each round evaluates \p batch_size new points.
+     * @param batch_size number of points selected and evaluated at each round.
+     * @param n_candidates number of random candidates used to maximize the acquisition function.
+     * @param hyper_every the GP hyperparameters are refitted every \p hyper_every rounds (0 means only at the
+     * beginning of each call to evolve).
+     * @param seed seed used by the internal random number generator (default is random)
+     *
+     * @throws std::invalid_argument if \p batch_size or \p n_candidates are zero
+     */
+    gpbo(unsigned int gen = 1u, unsigned int batch_size = 4u, unsigned int n_candidates = 1000u,
+         unsigned int hyper_every = 5u, unsigned int seed = pagmo::random_device::next())
+        : m_gen(gen), m_batch_size(batch_size), m_n_candidates(n_candidates), m_hyper_every(hyper_every),
+          m_theta(), m_e(seed), m_seed(seed), m_verbosity(0u), m_log()
+    {
+        if (batch_size == 0u) {
+            pagmo_throw(std::invalid_argument, "The batch size must be at least 1");
+        }
+        if (n_candidates == 0u) {
+            pagmo_throw(std::invalid_argument, "The number of candidates must be at least 1");
+        }
+    }
+
+    /// Algorithm evolve method (juice implementation of the algorithm)
+    /**
+     *
+     * Runs \p gen rounds of batch Bayesian optimization, using the input population as initial design.
+     *
+     * @param pop population to be evolved
+     * @return evolved population
+     * @throws std::invalid_argument if the problem is multi-objective or constrained
+     * @throws std::invalid_argument if the problem is unbounded
+     * @throws std::invalid_argument if the population size is not at least 2
+     * @throws unspecified any exception thrown by the evaluation of the fitness
+     */
+    population evolve(population pop) const
+    {
+        // We store some useful variables
+        const auto &prob = pop.get_problem();
+        auto dim = prob.get_nx();
+        const auto &lb = prob.get_lb();
+        const auto &ub = prob.get_ub();
+        auto NP = pop.size();
+        auto fevals0 = prob.get_fevals(); // discount for the already made fevals
+        auto count = 1u;                  // regulates the screen output
+
+        // PREAMBLE--------------------------------------------------
+        // Checks on the problem type
+        if (prob.get_nc() != 0u) {
+            pagmo_throw(std::invalid_argument, "Non linear constraints detected in " + prob.get_name() + " instance. "
+                                                   + get_name() + " cannot deal with them");
+        }
+        if (prob.get_nf() != 1u) {
+            pagmo_throw(std::invalid_argument, "Multiple objectives detected in " + prob.get_name() + " instance. "
+                                                   + get_name() + " cannot deal with them");
+        }
+        if (NP < 2u) {
+            pagmo_throw(std::invalid_argument, get_name() + " needs at least 2 individuals in the population, "
+                                                   + std::to_string(NP) + " detected");
+        }
+        for (auto num : lb) {
+            if (!std::isfinite(num)) {
+                pagmo_throw(std::invalid_argument, "A " + std::to_string(num) + " is detected in the lower bounds, "
+                                                       + this->get_name() + " cannot deal with it.");
+            }
+        }
+        for (auto num : ub) {
+            if (!std::isfinite(num)) {
+                pagmo_throw(std::invalid_argument, "A " + std::to_string(num) + " is detected in the upper bounds, "
+                                                       + this->get_name() + " cannot deal with it.");
+            }
+        }
+        // Get out if there is nothing to do.
+        if (m_gen == 0u) {
+            return pop;
+        }
+        // -----------------------------------------------------------
+
+        // No throws, all valid: we clear the logs
+        m_log.clear();
+
+        // The initial design is the population, scaled to the unit hypercube.
+        Eigen::MatrixXd X(_(NP), _(dim));
+        Eigen::VectorXd y(_(NP));
+        for (decltype(NP) i = 0u; i < NP; ++i) {
+            for (decltype(dim) j = 0u; j < dim; ++j) {
+                X(_(i), _(j)) = to_unit(pop.get_x()[i][j], lb[j], ub[j]);
+            }
+            y(_(i)) = pop.get_f()[i][0];
+        }
+        detail::gpbo_gp gp;
+        gp.theta = m_theta;
+        gp.fit(X, y, true, 100u);
+
+        vector_double dumb(dim);
+        std::vector<vector_double> batch_x(m_batch_size, dumb);
+        vector_double batch_f(m_batch_size);
+        Eigen::MatrixXd Xb(_(m_batch_size), _(dim));
+        Eigen::VectorXd yb(_(m_batch_size));
+        // The batches are evaluated concurrently if the problem allows it: on the problem of the population itself
+        // if it can be shared among threads, otherwise on copies made once for all the rounds.
+        const auto ts = prob.get_thread_safety();
+        const bool concurrent = m_batch_size > 1u && ts >= thread_safety::basic;
+        const bool shared = ts == thread_safety::constant;
+        std::vector<problem> probs;
+        if (concurrent && !shared) {
+            probs.assign(m_batch_size, prob);
+        }
+        for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // 1 - Refit the hyperparameters from scratch every m_hyper_every rounds. Otherwise the model
+            // already contains the last batch, added incrementally at the end of the previous round.
+            if (gen > 1u && m_hyper_every > 0u && (gen - 1u) % m_hyper_every == 0u) {
+                gp.fit(X, y, true, 50u);
+            }
+            // 2 - Select the batch maximizing the locally penalized expected improvement.
+            double max_ei = 0., lipschitz = 0.;
+            select_batch(gp, Xb, max_ei, lipschitz);
+            for (decltype(m_batch_size) i = 0u; i < m_batch_size; ++i) {
+                for (decltype(dim) j = 0u; j < dim; ++j) {
+                    batch_x[i][j] = from_unit(Xb(_(i), _(j)), lb[j], ub[j]);
+                }
+            }
+            // 3 - Evaluate the batch, concurrently if the problem allows it.
+            if (concurrent) {
+                std::vector<std::future<vector_double>> futures;
+                for (decltype(m_batch_size) i = 0u; i < m_batch_size; ++i) {
+                    futures.push_back(std::async(std::launch::async, [&prob, &probs, &batch_x, shared, i]() {
+                        return (shared ? prob : probs[i]).fitness(batch_x[i]);
+                    }));
+                }
+                // All the futures are waited for before an exception can escape.
+                for (auto &fut : futures) {
+                    fut.wait();
+                }
+                for (decltype(m_batch_size) i = 0u; i < m_batch_size; ++i) {
+                    batch_f[i] = futures[i].get()[0];
+                }
+                // The evaluations on the shared problem are already counted.
+                if (!shared) {
+                    detail::problem_counters::increment_fevals(prob, m_batch_size);
+                }
+            } else {
+                for (decltype(m_batch_size) i = 0u; i < m_batch_size; ++i) {
+                    batch_f[i] = pop.get_problem().fitness(batch_x[i])[0];
+                }
+            }
+            // 4 - Reinsertion: each new point replaces the worst individual if it improves on it.
+            for (decltype(m_batch_size) i = 0u; i < m_batch_size; ++i) {
+                auto worst = pop.worst_idx();
+                if (batch_f[i] < pop.get_f()[worst][0]) {
+                    pop.set_xf(worst, batch_x[i], vector_double{batch_f[i]});
+                }
+                yb(_(i)) = batch_f[i];
+            }
+            // 5 - Update the model with the new observations.
+            gp.append(Xb, yb);
+            X = gp.X;
+            y.conservativeResize(y.size() + yb.size());
+            y.tail(yb.size()) = yb;
+            // 6 - Logs and prints (verbosity modes > 1: a line is added every m_verbosity generations)
+            if (m_verbosity > 0u) {
+                if (gen % m_verbosity == 1u || m_verbosity == 1u) {
+                    auto best = pop.get_f()[pop.best_idx()][0];
+                    // Every 50 lines print the column names
+                    if (count % 50u == 1u) {
+                        print("\n", std::setw(7), "Gen:", std::setw(15), "Fevals:", std::setw(15), "Best:",
+                              std::setw(15), "Max EI:", std::setw(15), "Lipschitz:", '\n');
+                    }
+                    print(std::setw(7), gen, std::setw(15), prob.get_fevals() - fevals0, std::setw(15), best,
+                          std::setw(15), max_ei, std::setw(15), lipschitz, '\n');
+                    ++count;
+                    // Logs
+                    m_log.push_back(log_line_type(gen, prob.get_fevals() - fevals0, best, max_ei, lipschitz));
+                }
+            }
+        } // end of generation loop
+        // The fitted hyperparameters are used as a warm start by the next call.
+        m_theta = gp.theta;
+        if (m_verbosity) {
+            std::cout << "Exit condition -- generations = " << m_gen << std::endl;
+        }
+        return pop;
+    }
+    /// Sets the seed
+    /**
+     * @param seed the seed controlling the algorithm stochastic behaviour
+     */
+    void set_seed(unsigned int seed)
+    {
+        m_e.seed(seed);
+        m_seed = seed;
+    };
+    /// Gets the seed
+    /**
+     * @return the seed controlling the algorithm stochastic behaviour
+     */
+    unsigned int get_seed() const
+    {
+        return m_seed;
+    }
+    /// Sets the algorithm verbosity
+    /**
+     * Sets the verbosity level of the screen output and of the
+     * log returned by get_log(). \p level can be:
+     * - 0: no verbosity
+     * - >0: will print and log one line each \p level rounds.
+     *
+     * Example (verbosity 1):
+     * @code{.unparsed}
+     *     Gen:        Fevals:          Best:        Max EI:     Lipschitz:
+     *       1              4        12.0373       0.394751        3.49281
+     *       2              8        1.40916       0.227006        3.69158
+     *       3             12       0.631787      0.0836342        3.57402
+     *       4             16       0.631787      0.0465719        3.90021
+     *       5             20      0.0763131      0.0366287        3.88873
+     * @endcode
+     * Gen is the round number, Fevals the number of function evaluations used, Best is the best fitness
+     * in the population, Max EI is the largest expected improvement found by the acquisition (in units of the
+     * standardised fitness) and Lipschitz is the estimate of the Lipschitz constant used by the local penalization.
+     *
+     * @param level verbosity level
+     */
+    void set_verbosity(unsigned int level)
+    {
+        m_verbosity = level;
+    };
+    /// Gets the verbosity level
+    /**
+     * @return the verbosity level
+     */
+    unsigned int get_verbosity() const
+    {
+        return m_verbosity;
+    }
+    /// Gets the generations
+    /**
+     * @return the number of rounds to evolve for
+     */
+    unsigned int get_gen() const
+    {
+        return m_gen;
+    }
+    /// Gets the batch size
+    /**
+     * @return the number of points evaluated at each round
+     */
+    unsigned int get_batch_size() const
+    {
+        return m_batch_size;
+    }
+    /// Gets the fitted hyperparameters
+    /**
+     * The GP hyperparameters fitted by the last call to evolve(), in log space:
+     * \f$ (\log l_1, \ldots, \log l_n, \log \sigma_f^2, \log \sigma_n^2) \f$, with the length-scales
+     * referring to the decision vector scaled to the unit hypercube. Empty if evolve() was never called.
+     *
+     * @return the log-hyperparameters
+     */
+    vector_double get_hyperparameters() const
+    {
+        return vector_double(m_theta.data(), m_theta.data() + m_theta.size());
+    }
+    /// Algorithm name
+    /**
+     * One of the optional methods of any user-defined algorithm (UDA).
+     *
+     * @return a string containing the algorithm name
+     */
+    std::string get_name() const
+    {
+        return "GPBO: Gaussian Process Bayesian Optimization";
+    }
+    /// Extra informations
+    /**
+     * One of the optional methods of any user-defined algorithm (UDA).
+     *
+     * @return a string containing extra informations on the algorithm
+     */
+    std::string get_extra_info() const
+    {
+        std::ostringstream ss;
+        stream(ss, "\tGenerations: ", m_gen);
+        stream(ss, "\n\tBatch size: ", m_batch_size);
+        stream(ss, "\n\tCandidates: ", m_n_candidates);
+        stream(ss, "\n\tHyperparameters refit every: ", m_hyper_every);
+        stream(ss, "\n\tVerbosity: ", m_verbosity);
+        stream(ss, "\n\tSeed: ", m_seed);
+        return ss.str();
+    }
+    /// Get log
+    /**
+     * A log containing relevant quantities monitoring the last call to evolve. Each element of the returned
+     * <tt> std::vector </tt> is a gpbo::log_line_type containing: Gen, Fevals, Best, Max EI, Lipschitz
+     * as described in gpbo::set_verbosity
+     * @return an <tt> std::vector </tt> of gpbo::log_line_type containing the logged values Gen, Fevals, Best,
+     * Max EI, Lipschitz
+     */
+    const log_type &get_log() const
+    {
+        return m_log;
+    }
+    /// Object serialization
+    /**
+     * This method will save/load \p this into the archive \p ar.
+     *
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of the UDP and of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_gen, m_batch_size, m_n_candidates, m_hyper_every, m_theta, m_e, m_seed, m_verbosity, m_log);
+    }
+
+private:
+    // Eigen stores indexes and sizes as signed types, while PaGMO
+    // uses STL containers thus sizes and indexes are unsigned. To
+    // make the conversion as painless as possible this template is provided
+    // allowing, for example, syntax of the type D(_(i),_(j)) to adress an Eigen matrix
+    // when i and j are unsigned
+    template <typename I>
+    static Eigen::DenseIndex _(I n)
+    {
+        return static_cast<Eigen::DenseIndex>(n);
+    }
+    static double to_unit(double x, double lb, double ub)
+    {
+        return (ub > lb) ? (x - lb) / (ub - lb) : 0.;
+    }
+    static double from_unit(double u, double lb, double ub)
+    {
+        return std::min(std::max(lb + u * (ub - lb), lb), ub);
+    }
+    // Expected improvement (minimization) over the standardised incumbent ymin.
+    static double expected_improvement(double mu, double s, double ymin)
+    {
+        const auto z = (ymin - mu) / s;
+        const auto cdf = .5 * std::erfc(-z / std::sqrt(2.));
+        const auto pdf = std::exp(-.5 * z * z) / std::sqrt(2. * 3.14159265358979323846);
+        return std::max(s * (z * cdf + pdf), 0.);
+    }
+    // The centre of a local penalizer: the point, the posterior there and the Lipschitz constant.
+    struct penalizer {
+        Eigen::VectorXd x;
+        double mu;
+        double s;
+    };
+    // Probability that x lies outside the ball around p.x that, given the Lipschitz constant lip,
+    // cannot contain a point better than ymin.
+    static double penalty(const Eigen::VectorXd &x, const penalizer &p, double lip, double ymin)
+    {
+        const auto z = (lip * (x - p.x).norm() - (p.mu - ymin)) / (std::sqrt(2.) * p.s);
+        return .5 * std::erfc(-z);
+    }
+    static double penalized(double ei, const Eigen::VectorXd &x, const std::vector<penalizer> &pens, double lip,
+                            double ymin)
+    {
+        for (const auto &p : pens) {
+            ei *= penalty(x, p, lip, ymin);
+        }
+        return ei;
+    }
+    // Fills the rows of Xb with a batch of points in the unit hypercube.
+    void select_batch(const detail::gpbo_gp &gp, Eigen::MatrixXd &Xb, double &max_ei, double &lipschitz) const
+    {
+        std::uniform_real_distribution<double> drng(0., 1.);
+        std::normal_distribution<double> nrng(0., 1.);
+        const auto dim = gp.X.cols(), n = gp.X.rows();
+        const auto ymin = gp.y.minCoeff();
+
+        // Candidates: uniformly distributed points, plus perturbations of the best observations
+        // scaled by the fitted length-scales.
+        std::vector<Eigen::DenseIndex> order(static_cast<std::vector<Eigen::DenseIndex>::size_type>(n));
+        for (Eigen::DenseIndex i = 0; i < n; ++i) {
+            order[static_cast<std::vector<Eigen::DenseIndex>::size_type>(i)] = i;
+        }
+        std::sort(order.begin(), order.end(),
+                  [&gp](Eigen::DenseIndex a, Eigen::DenseIndex b) { return gp.y(a) < gp.y(b); });
+        const auto n_local = m_n_candidates / 2u;
+        const auto n_cand = m_n_candidates + n_local;
+        std::vector<Eigen::VectorXd> cands(n_cand, Eigen::VectorXd(dim));
+        for (decltype(m_n_candidates) c = 0u; c < m_n_candidates; ++c) {
+            for (Eigen::DenseIndex j = 0; j < dim; ++j) {
+                cands[c](j) = drng(m_e);
+            }
+        }
+        const auto n_best = std::min(n, Eigen::DenseIndex(5));
+        for (decltype(m_n_candidates) c = 0u; c < n_local; ++c) {
+            const auto &centre = gp.X.row(order[static_cast<std::vector<Eigen::DenseIndex>::size_type>(_(c) % n_best)]);
+            for (Eigen::DenseIndex j = 0; j < dim; ++j) {
+                const auto v = centre(j) + .2 * std::exp(gp.theta(j)) * nrng(m_e);
+                cands[m_n_candidates + c](j) = std::min(std::max(v, 0.), 1.);
+            }
+        }
+
+        // Posterior, expected improvement and Lipschitz constant estimate over the candidates.
+        std::vector<double> mu(n_cand), s(n_cand), ei(n_cand);
+        lipschitz = 0.;
+        for (decltype(m_n_candidates) c = 0u; c < n_cand; ++c) {
+            gp.predict(cands[c], mu[c], s[c]);
+            ei[c] = expected_improvement(mu[c], s[c], ymin);
+            lipschitz = std::max(lipschitz, gp.mean_gradient_norm(cands[c]));
+        }
+        for (Eigen::DenseIndex i = 0; i < n; ++i) {
+            lipschitz = std::max(lipschitz, gp.mean_gradient_norm(gp.X.row(i).transpose()));
+        }
+        if (lipschitz < 1e-7) {
+            // Flat model: the value suggested in the original paper.
+            lipschitz = 10.;
+        }
+
+        std::vector<penalizer> pens;
+        std::vector<double> score(ei);
+        for (decltype(m_batch_size) b = 0u; b < m_batch_size; ++b) {
+            auto best = static_cast<decltype(m_n_candidates)>(std::max_element(score.begin(), score.end())
+                                                                - score.begin());
+            Eigen::VectorXd x = cands[best];
+            double best_score = score[best], bmu = mu[best], bs = s[best];
+            // Local refinement around the best candidate with a shrinking radius.
+            double radius = .05;
+            Eigen::VectorXd trial(dim);
+            for (auto it = 0; it < 30; ++it) {
+                for (Eigen::DenseIndex j = 0; j < dim; ++j) {
+                    trial(j) = std::min(std::max(x(j) + radius * nrng(m_e), 0.), 1.);
+                }
+                double tmu, ts;
+                gp.predict(trial, tmu, ts);
+                const auto tscore = penalized(expected_improvement(tmu, ts, ymin), trial, pens, lipschitz, ymin);
+                if (tscore > best_score) {
+                    x = trial;
+                    best_score = tscore;
+                    bmu = tmu;
+                    bs = ts;
+                } else {
+                    radius *= .8;
+                }
+            }
+            if (b == 0u) {
+                max_ei = best_score;
+            }
+            Xb.row(_(b)) = x.transpose();
+            pens.push_back(penalizer{x, bmu, bs});
+            for (decltype(m_n_candidates) c = 0u; c < n_cand; ++c) {
+                score[c] *= penalty(cands[c], pens.back(), lipschitz, ymin);
+            }
+        }
+    }
+
+    unsigned int m_gen;
+    unsigned int m_batch_size;
+    unsigned int m_n_candidates;
+    unsigned int m_hyper_every;
+
+    // "Memory" data members: the hyperparameters fitted by the last call to evolve, used as warm start.
+    mutable Eigen::VectorXd m_theta;
+
+    // "Common" data members
+    mutable detail::random_engine_type m_e;
+    unsigned int m_seed;
+    unsigned int m_verbosity;
+    mutable log_type m_log;
+};
+
+} // namespace pagmo
+
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::gpbo)
+
+#endif
@@ -34,6 +34,7 @@ see https://www.gnu.org/licenses/. */
 #include <random>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "../algorithm.hpp"
@@ -44,6 +45,7 @@ see https://www.gnu.org/licenses/. */
 #include "../type_traits.hpp"
 #include "../utils/constrained.hpp"
 #include "../utils/generic.hpp" // pagmo::uniform_real_from_range
+#include "compass_search.hpp"
 
 namespace pagmo
 {
@@ -224,12 +226,17 @@ public:
         m_log.clear();
         // mbh main loop
         unsigned i = 0u;
+        // Storage for the decision vectors and fitnesses of the current population (the population itself is not
+        // copied, as that would also copy the problem).
+        std::vector<vector_double> x_old, f_old;
+        vector_double tmp_x(dim);
         while (i < m_stop) {
-            // 1 - We make a copy of the current population
-            population pop_old(pop);
+            // 1 - We make a copy of the current decision vectors and fitnesses
+            x_old = pop.get_x();
+            f_old = pop.get_f();
+            const auto best_idx_old = pop.best_idx();
             // 2 - We perturb the current population (NP funevals are made here)
             for (decltype(NP) j = 0u; j < NP; ++j) {
-                vector_double tmp_x(dim);
                 for (decltype(dim) k = 0u; k < dim; ++k) {
                     tmp_x[k] = uniform_real_from_range(
                         std::max(pop.get_x()[j][k] - m_perturb[k] * (ub[k] - lb[k]), lb[k]),
@@ -237,15 +244,16 @@ public:
                 }
                 pop.set_x(j, tmp_x); // fitness is evaluated here
             }
-            // 3 - We evolve the current population with the selected algorithm
-            pop = static_cast<const algorithm *>(this)->evolve(pop);
+            // 3 - We evolve the current population with the selected algorithm (moving it in and out, so that
+            // neither the population nor the problem are copied)
+            pop = static_cast<const algorithm *>(this)->evolve(std::move(pop));
             i++;
             // 4 - We reset the counter if we have improved, otherwise we reset the population
-            if (compare_fc(pop.get_f()[pop.best_idx()], pop_old.get_f()[pop_old.best_idx()], nec, prob.get_c_tol())) {
+            if (compare_fc(pop.get_f()[pop.best_idx()], f_old[best_idx_old], nec, prob.get_c_tol())) {
                 i = 0u;
             } else {
                 for (decltype(NP) j = 0u; j < NP; ++j) {
-                    pop.set_xf(j, pop_old.get_x()[j], pop_old.get_f()[j]);
+                    pop.set_xf(j, x_old[j], f_old[j]);
                 }
             }
             // 5 - We log to screen
@@ -444,6 +452,6 @@ private:
 };
 }
 
-PAGMO_REGISTER_ALGORITHM(pagmo::mbh)
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::mbh)
 
 #endif
@@ -82,7 +82,8 @@ public:
     * Constructs MOEA/D-DE
     *
     * @param gen number of generations
-    * @param weight_generation method used to generate the weights, one of "grid", "low discrepancy" or "random"
+    * @param weight_generation method used to generate the weights, one of "grid", "low discrepancy", "random",
+    * "two layers" or "uniform design"
     * @param decomposition decomposition method: one of "weighted", "tchebycheff" or "bi"
     * @param neighbours size of the weight's neighborhood
     * @param CR crossover parameter in the Differential Evolution operator
@@ -107,10 +108,11 @@ public:
     {
         // Sanity checks
         if (m_weight_generation != "random" && m_weight_generation != "grid"
-            && m_weight_generation != "low discrepancy") {
-            pagmo_throw(std::invalid_argument,
-                        "Weight generation method requested is '" + m_weight_generation
-                            + "', but only one of 'random', 'low discrepancy', 'grid' is allowed");
+            && m_weight_generation != "low discrepancy" && m_weight_generation != "two layers"
+            && m_weight_generation != "uniform design") {
+            pagmo_throw(std::invalid_argument, "Weight generation method requested is '" + m_weight_generation
+                                                   + "', but only one of 'random', 'low discrepancy', 'grid', "
+                                                     "'two layers', 'uniform design' is allowed");
         }
         if (m_decomposition != "tchebycheff" && m_decomposition != "weighted" && m_decomposition != "bi") {
             pagmo_throw(std::invalid_argument, "Weight generation method requested is '" + m_decomposition
@@ -155,9 +157,8 @@ public:
         const auto &prob = pop.get_problem(); // This is a const reference, so using set_seed for example will not be
                                               // allowed
         auto dim = prob.get_nx();             // This getter does not return a const reference but a copy
-        const auto bounds = prob.get_bounds();
-        const auto &lb = bounds.first;
-        const auto &ub = bounds.second;
+        const auto &lb = prob.get_lb();
+        const auto &ub = prob.get_ub();
         auto NP = pop.size();
 
         auto fevals0 = prob.get_fevals(); // discount for the fevals already made
@@ -212,6 +213,10 @@ public:
         vector_double ideal_point = ideal(pop.get_f());
         // We create the container that will represent a pseudo-random permutation of the population indexes 1..NP
         std::vector<population::size_type> shuffle(NP);
+        // Buffers for the parents and for the shuffled neighbourhood, allocated once.
+        std::vector<population::size_type> parents_idx, shuffle2;
+        parents_idx.reserve(2u);
+        shuffle2.reserve(NP);
         std::iota(shuffle.begin(), shuffle.end(), std::vector<population::size_type>::size_type(0u));
 
         // Main MOEA/D loop --------------------------------------------------------------------------------------------
@@ -264,8 +269,7 @@ public:
                     whole_population = true; // whole population
                 }
                 // 4 - We select two parents in the neighbourhood
-                std::vector<population::size_type> parents_idx(2);
-                parents_idx = select_parents(n, neigh_idxs, whole_population);
+                select_parents(parents_idx, n, neigh_idxs, whole_population);
                 // 5 - Crossover using the Differential Evolution operator (binomial crossover)
                 for (decltype(dim) kk = 0u; kk < dim; ++kk) {
                     if (drng(m_e) < m_CR) {
@@ -296,9 +300,11 @@ public:
                 // 9 - We insert the newly found solution into the population
                 decltype(NP) size, time = 0;
                 // First try on problem n
-                auto f1 = decompose_objectives(pop.get_f()[n], weights[n], ideal_point, m_decomposition);
-                auto f2 = decompose_objectives(new_f, weights[n], ideal_point, m_decomposition);
-                if (f2[0] < f1[0]) {
+                // NOTE: the sizes of the fitness, weight and ideal point vectors are all equal to the number of
+                // objectives, so we can use the unchecked scalar version of decompose_objectives().
+                auto f1 = detail::decompose_objectives_scalar(pop.get_f()[n], weights[n], ideal_point, m_decomposition);
+                auto f2 = detail::decompose_objectives_scalar(new_f, weights[n], ideal_point, m_decomposition);
+                if (f2 < f1) {
                     pop.set_xf(n, candidate, new_f);
                     time++;
                 }
@@ -308,7 +314,7 @@ public:
                 } else {
                     size = neigh_idxs[n].size();
                 }
-                std::vector<population::size_type> shuffle2(size);
+                shuffle2.resize(size);
                 std::iota(shuffle2.begin(), shuffle2.end(), std::vector<population::size_type>::size_type(0u));
                 std::shuffle(shuffle2.begin(), shuffle2.end(), m_e);
                 for (decltype(size) k = 0u; k < size; ++k) {
@@ -318,9 +324,10 @@ public:
                     } else {
                         pick = neigh_idxs[n][shuffle2[k]];
                     }
-                    f1 = decompose_objectives(pop.get_f()[pick], weights[pick], ideal_point, m_decomposition);
-                    f2 = decompose_objectives(new_f, weights[pick], ideal_point, m_decomposition);
-                    if (f2[0] < f1[0]) {
+                    f1 = detail::decompose_objectives_scalar(pop.get_f()[pick], weights[pick], ideal_point,
+                                                             m_decomposition);
+                    f2 = detail::decompose_objectives_scalar(new_f, weights[pick], ideal_point, m_decomposition);
+                    if (f2 < f1) {
                         pop.set_xf(pick, candidate, new_f);
                         time++;
                     }
@@ -462,9 +469,8 @@ private:
     {
         const auto &prob = pop.get_problem();
         auto D = prob.get_nx(); // This getter does not return a const reference but a copy
-        const auto bounds = prob.get_bounds();
-        const auto &lb = bounds.first;
-        const auto &ub = bounds.second;
+        const auto &lb = prob.get_lb();
+        const auto &ub = prob.get_ub();
         double rnd, delta1, delta2, mut_pow, deltaq;
         double y, yl, yu, val, xy;
         std::uniform_real_distribution<double> drng(0., 1.); // to generate a number in [0, 1)
@@ -496,11 +502,11 @@ private:
         }
     }
 
-    std::vector<population::size_type> select_parents(population::size_type n,
-                                                      const std::vector<std::vector<population::size_type>> &neigh_idx,
-                                                      bool whole_population) const
+    // Selects two distinct parents and writes their indices into retval.
+    void select_parents(std::vector<population::size_type> &retval, population::size_type n,
+                        const std::vector<std::vector<population::size_type>> &neigh_idx, bool whole_population) const
     {
-        std::vector<population::size_type> retval;
+        retval.clear();
         auto ss = neigh_idx[n].size();
         decltype(ss) p;
 
@@ -523,7 +529,6 @@ private:
             }
             if (flag) retval.push_back(p);
         }
-        return retval;
     }
 
     unsigned int m_gen;
@@ -544,6 +549,6 @@ private:
 
 } // namespace pagmo
 
-PAGMO_REGISTER_ALGORITHM(pagmo::moead)
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::moead)
 
 #endif
@@ -0,0 +1,367 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_ALGORITHMS_NELDER_MEAD_HPP
+#define PAGMO_ALGORITHMS_NELDER_MEAD_HPP
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream> //std::osstringstream
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../algorithm.hpp"
+#include "../detail/nm_kernels.hpp"
+#include "../exceptions.hpp"
+#include "../io.hpp"
+#include "../population.hpp"
+#include "../serialization.hpp"
+#include "../types.hpp"
+
+namespace pagmo
+{
+
+/// Nelder-Mead simplex
+/**
+ * The downhill simplex method of Nelder and Mead is a derivative-free local solver which keeps a simplex of
+ * \f$ n+1 \f$ points and, at each iteration, replaces its worst vertex by reflecting, expanding or contracting it
+ * through the centroid of the others, or shrinks the whole simplex towards its best vertex. An iteration usually costs
+ * one or two objective evaluations, which makes this solver the cheapest choice per iteration for the local
+ * refinement of low-dimensional problems. The dimension dependent coefficients of Gao and Han are used, which behave
+ * better than the classical ones as the dimension grows.
+ *
+ * The initial simplex is built around the best individual of the population, with edges of length \p start_range
+ * along each coordinate. The search stops when all the vertices are within \p stop_range of the best one, or when the
+ * maximum number of function evaluations is reached. Both ranges are relative to the box bounds, as in
+ * pagmo::compass_search, and the trial points are projected onto the bounds.
+ *
+ * When \p speculative is \p true, the problem provides at least the pagmo::thread_safety::basic guarantee and more
+ * than one hardware thread is available, the reflection, expansion and contraction points of an iteration are
+ * evaluated concurrently on copies of the problem (as are the vertices of a shrunk simplex), before deciding which one
+ * to use. The sequence of simplices is the same as in the sequential algorithm: the wall-clock time of an iteration
+ * becomes that of a single evaluation, at the price of more evaluations in total.
+ *
+ * **NOTE** This algorithm does not work for multi-objective problems, nor for constrained or stochastic problems.
+ *
+ * **NOTE** The search range is defined relative to the box-bounds. Hence, unbounded problems
+ * will produce an error.
+ *
+ * **NOTE** This is a fully deterministic algorithm and will produce identical results if its evolve method
+ * is called from two identical populations.
+ *
+ * See: J. A. Nelder and R. Mead, "A simplex method for function minimization", The Computer Journal 7 (1965).
+ *
+ * See: F. Gao and L. Han, "Implementing the Nelder-Mead simplex algorithm with adaptive parameters",
+ * Computational Optimization and Applications 51 (2012).
+ */
+class nelder_mead
+{
+public:
+    /// Single entry of the log (feval, best fitness, simplex size)
+    typedef std::tuple<unsigned long long, double, double> log_line_type;
+    /// The log
+    typedef std::vector<log_line_type> log_type;
+
+    /// Constructor.
+    /**
+     * Constructs nelder_mead
+     *
+     * @param max_fevals maximum number of function evaluations
+     * @param start_range initial size of the simplex, relative to the box bounds
+     * @param stop_range final size of the simplex, relative to the box bounds
+     * @param speculative evaluate the candidate points of each iteration concurrently
+     * @throws std::invalid_argument if \p start_range is not in (0,1]
+     * @throws std::invalid_argument if \p stop_range is not in (0,start_range)
+     */
+    nelder_mead(unsigned int max_fevals = 1000u, double start_range = .1, double stop_range = 1e-6,
+                bool speculative = false)
+        : m_max_fevals(max_fevals), m_start_range(start_range), m_stop_range(stop_range), m_speculative(speculative),
+          m_verbosity(0u), m_log()
+    {
+        if (start_range > 1. || start_range <= 0. || std::isnan(start_range)) {
+            pagmo_throw(std::invalid_argument, "The start range must be in (0, 1], while a value of "
+                                                   + std::to_string(start_range) + " was detected.");
+        }
+        if (stop_range <= 0. || stop_range >= start_range || std::isnan(stop_range)) {
+            pagmo_throw(std::invalid_argument, "The stop range must be in (0, start_range), while a value of "
+                                                   + std::to_string(stop_range) + " was detected.");
+        }
+    }
+
+    /// Algorithm evolve method (juice implementation of the algorithm)
+    /**
+     * Runs the solver from the best individual of the population, up to when the simplex becomes smaller
+     * than the defined stop_range or the maximum number of function evaluations is reached. The result
+     * replaces the best individual of the population.
+     *
+     * @param pop population to be evolved
+     * @return evolved population
+     * @throws std::invalid_argument if the problem is multi-objective, constrained or stochastic
+     * @throws std::invalid_argument if the problem is unbounded
+     * @throws std::invalid_argument if the population is empty
+     */
+    population evolve(population pop) const
+    {
+        // We store some useful variables
+        const auto &prob = pop.get_problem(); // This is a const reference, so using set_seed for example will not be
+                                              // allowed
+        auto dim = prob.get_nx();             // This getter does not return a const reference but a copy
+        const auto &lb = prob.get_lb();
+        const auto &ub = prob.get_ub();
+
+        auto fevals0 = prob.get_fevals(); // discount for the already made fevals
+        unsigned int count = 1u;          // regulates the screen output
+
+        // PREAMBLE-------------------------------------------------------------------------------------------------
+        // We start by checking that the problem is suitable for this
+        // particular algorithm.
+        if (prob.get_nobj() != 1u) {
+            pagmo_throw(std::invalid_argument, "Multiple objectives detected in " + prob.get_name() + " instance. "
+                                                   + get_name() + " cannot deal with them");
+        }
+        if (prob.get_nc() != 0u) {
+            pagmo_throw(std::invalid_argument, "Non linear constraints detected in " + prob.get_name() + " instance. "
+                                                   + get_name() + " cannot deal with them");
+        }
+        if (prob.is_stochastic()) {
+            pagmo_throw(std::invalid_argument,
+                        "The problem appears to be stochastic " + get_name() + " cannot deal with it");
+        }
+        if (pop.size() == 0u) {
+            pagmo_throw(std::invalid_argument, get_name() + " does not work on an empty population");
+        }
+        for (decltype(dim) i = 0u; i < dim; ++i) {
+            if (!std::isfinite(lb[i]) || !std::isfinite(ub[i])) {
+                pagmo_throw(std::invalid_argument, "Infinite bounds detected in " + prob.get_name() + " instance. "
+                                                       + get_name() + " cannot deal with them");
+            }
+        }
+        // Get out if there is nothing to do.
+        if (m_max_fevals == 0u) {
+            return pop;
+        }
+        // ---------------------------------------------------------------------------------------------------------
+
+        // No throws, all valid: we clear the logs
+        m_log.clear();
+
+        // The search is carried out in the unit hypercube, starting from the best individual of the population.
+        auto best_idx = pop.best_idx();
+        vector_double u(dim);
+        for (decltype(dim) i = 0u; i < dim; ++i) {
+            u[i] = (ub[i] > lb[i]) ? (pop.get_x()[best_idx][i] - lb[i]) / (ub[i] - lb[i]) : 0.;
+        }
+        double fu = pop.get_f()[best_idx][0];
+        // The speculative evaluations pay off only if they can run concurrently.
+        const auto n_workers = detail::nm_evaluator::n_workers(prob, m_speculative);
+        const bool speculative = m_speculative && n_workers > 1u;
+        detail::nm_evaluator eval(prob, lb, ub, n_workers);
+        const detail::nm_fevals_guard fevals_guard{eval};
+        eval.idx().resize(dim);
+        std::iota(eval.idx().begin(), eval.idx().end(), vector_double::size_type(0u));
+        detail::nm_workspace ws(dim);
+        const vector_double step(dim, m_start_range);
+        unsigned long long budget = m_max_fevals;
+        unsigned long long iter = 0u;
+        double size = m_start_range;
+        auto on_iter = [&](double fbest, double cur_size) {
+            size = cur_size;
+            // Logs and prints (verbosity modes > 1: a line is added every m_verbosity iterations)
+            if (m_verbosity > 0u && iter++ % m_verbosity == 0u) {
+                // 1 - Every 50 lines print the column names
+                if (count % 50u == 1u) {
+                    print("\n", std::setw(7), "Fevals:", std::setw(15), "Best:", std::setw(15), "Size:", '\n');
+                }
+                // 2 - Print
+                print(std::setw(7), eval.get_fevals(), std::setw(15), fbest, std::setw(15), cur_size, '\n');
+                ++count;
+                // Logs
+                m_log.push_back(log_line_type(eval.get_fevals(), fbest, cur_size));
+            }
+        };
+        detail::nm_minimize(ws, dim, u.data(), fu, step.data(), m_stop_range, budget, speculative, eval, on_iter);
+        eval.sync_fevals();
+
+        if (m_verbosity) {
+            if (size < m_stop_range) {
+                std::cout << "Exit condition -- range: " << size << " < " << m_stop_range << "\n";
+            } else {
+                std::cout << "Exit condition -- fevals: " << prob.get_fevals() - fevals0 << " >= " << m_max_fevals
+                          << "\n";
+            }
+        }
+
+        // Force the current best into the original population
+        if (fu < pop.get_f()[best_idx][0]) {
+            pop.set_xf(best_idx, eval.to_x(u), {fu});
+        }
+        return pop;
+    }
+
+    /// Sets the algorithm verbosity
+    /**
+     * Sets the verbosity level of the screen output and of the
+     * log returned by get_log(). \p level can be:
+     * - 0: no verbosity
+     * - >0: will print and log one line every \p level iterations
+     *
+     * Example (verbosity 10, on a 2 dimensional Rosenbrock problem):
+     * @code{.unparsed}
+     * Fevals:          Best:          Size:
+     *       2        68090.7            0.1
+     *      21         1.4702           0.05
+     *      39       0.167832         0.0125
+     *      59      0.0966545     0.00226784
+     *      78      0.0107625     0.00693557
+     *      98    0.000436976    0.000441083
+     *     118    2.19218e-05     0.00106883
+     *     137    1.05745e-07    0.000125229
+     *     156    4.09678e-10     5.6311e-06
+     * Exit condition -- range: 6.75332e-07 < 1e-06
+     * @endcode
+     * Fevals is the number of function evaluations made, Best is the best fitness and Size is the
+     * largest distance of a vertex of the simplex from the best one, relative to the box bounds.
+     *
+     * @param level verbosity level
+     */
+    void set_verbosity(unsigned int level)
+    {
+        m_verbosity = level;
+    }
+    /// Gets the verbosity level
+    /**
+     * @return the verbosity level
+     */
+    unsigned int get_verbosity() const
+    {
+        return m_verbosity;
+    }
+    /// Gets the maximum number of function evaluations allowed
+    /**
+     * @return the maximum number of function evaluations allowed
+     */
+    unsigned int get_max_fevals() const
+    {
+        return m_max_fevals;
+    }
+    /// Gets the stop_range
+    /**
+     * @return the stop range
+     */
+    double get_stop_range() const
+    {
+        return m_stop_range;
+    }
+    /// Get the start range
+    /**
+     * @return the start range
+     */
+    double get_start_range() const
+    {
+        return m_start_range;
+    }
+    /// Get the speculative flag
+    /**
+     * @return \p true if the candidate points of each iteration are evaluated concurrently
+     */
+    bool get_speculative() const
+    {
+        return m_speculative;
+    }
+    /// Algorithm name
+    /**
+     * One of the optional methods of any user-defined algorithm (UDA).
+     *
+     * @return a string containing the algorithm name
+     */
+    std::string get_name() const
+    {
+        return "Nelder-Mead simplex";
+    }
+    /// Extra informations
+    /**
+     * One of the optional methods of any user-defined algorithm (UDA).
+     *
+     * @return a string containing extra informations on the algorithm
+     */
+    std::string get_extra_info() const
+    {
+        std::ostringstream ss;
+        stream(ss, "\tMaximum number of objective function evaluations: ", m_max_fevals);
+        stream(ss, "\n\tStart range: ", m_start_range);
+        stream(ss, "\n\tStop range: ", m_stop_range);
+        stream(ss, "\n\tSpeculative evaluations: ", m_speculative);
+        stream(ss, "\n\tVerbosity: ", m_verbosity);
+        return ss.str();
+    }
+
+    /// Get log
+    /**
+     * A log containing relevant quantities monitoring the last call to evolve. Each element of the returned
+     * <tt> std::vector </tt> is a nelder_mead::log_line_type containing: Fevals, Best, Size
+     * as described in nelder_mead::set_verbosity
+     * @return an <tt> std::vector </tt> of nelder_mead::log_line_type containing the logged values Fevals, Best,
+     * Size
+     */
+    const log_type &get_log() const
+    {
+        return m_log;
+    }
+
+    /// Object serialization
+    /**
+     * This method will save/load \p this into the archive \p ar.
+     *
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of the UDP and of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_max_fevals, m_start_range, m_stop_range, m_speculative, m_verbosity, m_log);
+    }
+
+private:
+    unsigned int m_max_fevals;
+    double m_start_range;
+    double m_stop_range;
+    bool m_speculative;
+    unsigned int m_verbosity;
+    mutable log_type m_log;
+};
+
+} // namespaces
+
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::nelder_mead)
+
+#endif
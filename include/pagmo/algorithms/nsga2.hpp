@@ -169,6 +169,9 @@ public:
 
         // Declarations
         std::vector<vector_double::size_type> best_idx(NP), shuffle1(NP), shuffle2(NP);
+        // Decision vectors and fitnesses of the parents and of the offspring. They are allocated once and
+        // overwritten at each generation.
+        std::vector<vector_double> popnew_x(2u * NP), popnew_f(2u * NP);
         vector_double::size_type parent1_idx, parent2_idx;
         vector_double child1(dim), child2(dim);
 
@@ -209,8 +212,11 @@ public:
                 }
             }
 
-            // At each generation we make a copy of the population into popnew
-            population popnew(pop);
+            // At each generation we copy the decision vectors and fitnesses of the population into the first
+            // half of popnew_x and popnew_f (copying the whole population would also copy the problem)
+            std::copy(pop.get_x().begin(), pop.get_x().end(), popnew_x.begin());
+            std::copy(pop.get_f().begin(), pop.get_f().end(), popnew_f.begin());
+            auto n_new = NP;
 
             // We create some pseudo-random permutation of the poulation indexes
             std::shuffle(shuffle1.begin(), shuffle1.end(), m_e);
@@ -252,10 +258,10 @@ public:
                 mutate(child2, pop);
                 // we use prob to evaluate the fitness so
                 // that its feval counter is correctly updated
-                auto f1 = prob.fitness(child1);
-                auto f2 = prob.fitness(child2);
-                popnew.push_back(child1, f1);
-                popnew.push_back(child2, f2);
+                popnew_x[n_new] = child1;
+                popnew_f[n_new++] = prob.fitness(child1);
+                popnew_x[n_new] = child2;
+                popnew_f[n_new++] = prob.fitness(child2);
 
                 // We repeat with the shuffled list 2
                 parent1_idx = tournament_selection(shuffle2[i], shuffle2[i + 1], ndr, pop_cd);
@@ -265,18 +271,18 @@ public:
                 mutate(child2, pop);
                 // we use prob to evaluate the fitness so
                 // that its feval counter is correctly updated
-                f1 = prob.fitness(child1);
-                f2 = prob.fitness(child2);
-                popnew.push_back(child1, f1);
-                popnew.push_back(child2, f2);
-            } // popnew now contains 2NP individuals
+                popnew_x[n_new] = child1;
+                popnew_f[n_new++] = prob.fitness(child1);
+                popnew_x[n_new] = child2;
+                popnew_f[n_new++] = prob.fitness(child2);
+            } // popnew_x and popnew_f now contain 2NP individuals
 
             // This method returns the sorted N best individuals in the population according to the crowded comparison
             // operator
-            best_idx = select_best_N_mo(popnew.get_f(), NP);
+            best_idx = select_best_N_mo(popnew_f, NP);
             // We insert into the population
             for (population::size_type i = 0; i < NP; ++i) {
-                pop.set_xf(i, popnew.get_x()[best_idx[i]], popnew.get_f()[best_idx[i]]);
+                pop.set_xf(i, popnew_x[best_idx[i]], popnew_f[best_idx[i]]);
             }
         } // end of main NSGAII loop
         return pop;
@@ -410,12 +416,11 @@ private:
         auto Di = m_int_dim;
         auto Dc = D - Di;
         // Problem bounds
-        const auto bounds = pop.get_problem().get_bounds();
-        const auto &lb = bounds.first;
-        const auto &ub = bounds.second;
+        const auto &lb = pop.get_problem().get_lb();
+        const auto &ub = pop.get_problem().get_ub();
         // Parents decision vectors
-        vector_double parent1 = pop.get_x()[parent1_idx];
-        vector_double parent2 = pop.get_x()[parent2_idx];
+        const auto &parent1 = pop.get_x()[parent1_idx];
+        const auto &parent2 = pop.get_x()[parent2_idx];
         // declarations
         double y1, y2, yl, yu, rand01, beta, alpha, betaq, c1, c2;
         vector_double::size_type site1, site2;
@@ -507,9 +512,8 @@ private:
         auto Di = m_int_dim;
         auto Dc = D - Di;
         // Problem bounds
-        const auto bounds = pop.get_problem().get_bounds();
-        const auto &lb = bounds.first;
-        const auto &ub = bounds.second;
+        const auto &lb = pop.get_problem().get_lb();
+        const auto &ub = pop.get_problem().get_ub();
         // declarations
         double rnd, delta1, delta2, mut_pow, deltaq;
         double y, yl, yu, val, xy;
@@ -566,6 +570,6 @@ private:
 
 } // namespace pagmo
 
-PAGMO_REGISTER_ALGORITHM(pagmo::nsga2)
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::nsga2)
 
 #endif
@@ -181,9 +181,8 @@ public:
         const auto &prob = pop.get_problem(); // This is a const reference, so using set_seed for example will not be
                                               // allowed
         auto dim = prob.get_nx();             // not const as used type for counters
-        const auto bounds = prob.get_bounds();
-        const auto &lb = bounds.first;
-        const auto &ub = bounds.second;
+        const auto &lb = prob.get_lb();
+        const auto &ub = prob.get_ub();
         auto fevals0 = prob.get_fevals(); // discount for the already made fevals
         unsigned int count = 1u;          // regulates the screen output
 
@@ -868,6 +867,6 @@ private:
 
 } // namespace pagmo
 
-PAGMO_REGISTER_ALGORITHM(pagmo::pso)
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::pso)
 
 #endif
@@ -143,9 +143,8 @@ public:
         const auto &prob = pop.get_problem(); // This is a const reference, so using set_seed for example will not be
                                               // allowed
         auto dim = prob.get_nx();             // not const as used type for counters
-        const auto bounds = prob.get_bounds();
-        const auto &lb = bounds.first;
-        const auto &ub = bounds.second;
+        const auto &lb = prob.get_lb();
+        const auto &ub = prob.get_ub();
         auto fevals0 = prob.get_fevals(); // disount for the already made fevals
         unsigned int count = 1u;          // regulates the screen output
 
@@ -416,6 +415,6 @@ private:
 
 } // namespace pagmo
 
-PAGMO_REGISTER_ALGORITHM(pagmo::simulated_annealing)
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::simulated_annealing)
 
 #endif
@@ -0,0 +1,472 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_ALGORITHMS_SUBPLEX_HPP
+#define PAGMO_ALGORITHMS_SUBPLEX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <sstream> //std::osstringstream
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../algorithm.hpp"
+#include "../detail/nm_kernels.hpp"
+#include "../exceptions.hpp"
+#include "../io.hpp"
+#include "../population.hpp"
+#include "../serialization.hpp"
+#include "../types.hpp"
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// Partitions the coordinates into the subspaces of a subplex cycle. The coordinates are sorted into order by
+// decreasing progress |dx| of the previous cycle; each subspace then takes, among the leading coordinates not yet
+// assigned, the number k in [ns_min, ns_max] which maximises the difference between their mean progress and that
+// of the remaining coordinates, provided that the latter can still be partitioned. The dimensions of the subspaces
+// are written into sizes.
+inline void subplex_partition(const vector_double &dx, vector_double::size_type ns_min,
+                              vector_double::size_type ns_max, std::vector<vector_double::size_type> &order,
+                              std::vector<vector_double::size_type> &sizes)
+{
+    const auto dim = dx.size();
+    order.resize(dim);
+    std::iota(order.begin(), order.end(), vector_double::size_type(0u));
+    std::stable_sort(order.begin(), order.end(), [&dx](vector_double::size_type a, vector_double::size_type b) {
+        return std::abs(dx[a]) > std::abs(dx[b]);
+    });
+    sizes.clear();
+    for (decltype(dx.size()) start = 0u; start < dim;) {
+        const auto n_rem = dim - start;
+        vector_double::size_type best_k = n_rem;
+        double best_val = -std::numeric_limits<double>::infinity();
+        for (auto k = ns_min; k <= std::min(ns_max, n_rem); ++k) {
+            // The remaining coordinates must still be partitionable.
+            if (n_rem - k != 0u && n_rem - k < ns_min) {
+                continue;
+            }
+            double head = 0., tail = 0.;
+            for (decltype(dx.size()) j = 0u; j < n_rem; ++j) {
+                (j < k ? head : tail) += std::abs(dx[order[start + j]]);
+            }
+            const double val = head / static_cast<double>(k) - (n_rem > k ? tail / static_cast<double>(n_rem - k) : 0.);
+            if (val > best_val) {
+                best_val = val;
+                best_k = k;
+            }
+        }
+        sizes.push_back(best_k);
+        start += best_k;
+    }
+}
+
+// Rescales and reorients the steps at the end of a subplex cycle which made the progress dx over n_sub subspaces.
+// With a single subspace the steps are reduced by psi, otherwise they are scaled by the ratio between the progress
+// and the steps (bounded to [omega, 1 / omega]). Each step then points in the direction of the progress along its
+// coordinate, or is turned back if there was none, and never exceeds the hypercube. Returns the largest step.
+inline double subplex_rescale_steps(const vector_double &dx, vector_double &step, vector_double::size_type n_sub,
+                                    double psi, double omega)
+{
+    double dx_norm = 0., step_norm = 0.;
+    for (decltype(dx.size()) i = 0u; i < dx.size(); ++i) {
+        dx_norm += std::abs(dx[i]);
+        step_norm += std::abs(step[i]);
+    }
+    const double scale = n_sub > 1u ? std::min(std::max(dx_norm / step_norm, omega), 1. / omega) : psi;
+    double max_step = 0.;
+    for (decltype(dx.size()) i = 0u; i < dx.size(); ++i) {
+        const double dir = dx[i] != 0. ? (dx[i] > 0. ? 1. : -1.) : (step[i] > 0. ? -1. : 1.);
+        step[i] = dir * std::min(std::abs(step[i]) * scale, 1.);
+        max_step = std::max(max_step, std::abs(step[i]));
+    }
+    return max_step;
+}
+
+} // namespace detail
+
+/// Subplex
+/**
+ * Subplex is a generalisation of the Nelder-Mead simplex method (see pagmo::nelder_mead) which scales better with
+ * the dimension: at each cycle the variables are partitioned into low-dimensional subspaces (of dimension 2 to 5),
+ * grouping together the coordinates along which the previous cycle made the most progress, and a Nelder-Mead search
+ * is run in each subspace in turn. The step sizes used to build the simplices are then rescaled and reoriented
+ * according to the progress of the cycle.
+ *
+ * The search starts from the best individual of the population, with steps of length \p start_range, and stops when
+ * both the last cycle's progress and the step sizes are smaller than \p stop_range, or when the maximum number of
+ * function evaluations is reached. Both ranges are relative to the box bounds, as in pagmo::compass_search, and the
+ * trial points are projected onto the bounds. The simplices of all the subspaces share a single preallocated storage.
+ *
+ * When \p speculative is \p true, the problem provides at least the pagmo::thread_safety::basic guarantee and more
+ * than one hardware thread is available, the candidate points of each Nelder-Mead iteration are evaluated
+ * concurrently, as in pagmo::nelder_mead.
+ *
+ * **NOTE** This algorithm does not work for multi-objective problems, nor for constrained or stochastic problems.
+ *
+ * **NOTE** The search range is defined relative to the box-bounds. Hence, unbounded problems
+ * will produce an error.
+ *
+ * **NOTE** This is a fully deterministic algorithm and will produce identical results if its evolve method
+ * is called from two identical populations.
+ *
+ * See: T. Rowan, "Functional stability analysis of numerical algorithms", Ph.D. thesis, University of Texas at Austin
+ * (1990).
+ */
+class subplex
+{
+public:
+    /// Single entry of the log (feval, best fitness, number of subspaces, step size)
+    typedef std::tuple<unsigned long long, double, vector_double::size_type, double> log_line_type;
+    /// The log
+    typedef std::vector<log_line_type> log_type;
+
+    /// Constructor.
+    /**
+     * Constructs subplex
+     *
+     * @param max_fevals maximum number of function evaluations
+     * @param start_range initial step size, relative to the box bounds
+     * @param stop_range final step size, relative to the box bounds
+     * @param speculative evaluate the candidate points of each Nelder-Mead iteration concurrently
+     * @throws std::invalid_argument if \p start_range is not in (0,1]
+     * @throws std::invalid_argument if \p stop_range is not in (0,start_range)
+     */
+    subplex(unsigned int max_fevals = 1000u, double start_range = .1, double stop_range = 1e-6,
+            bool speculative = false)
+        : m_max_fevals(max_fevals), m_start_range(start_range), m_stop_range(stop_range), m_speculative(speculative),
+          m_verbosity(0u), m_log()
+    {
+        if (start_range > 1. || start_range <= 0. || std::isnan(start_range)) {
+            pagmo_throw(std::invalid_argument, "The start range must be in (0, 1], while a value of "
+                                                   + std::to_string(start_range) + " was detected.");
+        }
+        if (stop_range <= 0. || stop_range >= start_range || std::isnan(stop_range)) {
+            pagmo_throw(std::invalid_argument, "The stop range must be in (0, start_range), while a value of "
+                                                   + std::to_string(stop_range) + " was detected.");
+        }
+    }
+
+    /// Algorithm evolve method (juice implementation of the algorithm)
+    /**
+     * Runs the solver from the best individual of the population, up to when the steps become smaller
+     * than the defined stop_range or the maximum number of function evaluations is reached. The result
+     * replaces the best individual of the population.
+     *
+     * @param pop population to be evolved
+     * @return evolved population
+     * @throws std::invalid_argument if the problem is multi-objective, constrained or stochastic
+     * @throws std::invalid_argument if the problem is unbounded
+     * @throws std::invalid_argument if the population is empty
+     */
+    population evolve(population pop) const
+    {
+        // We store some useful variables
+        const auto &prob = pop.get_problem(); // This is a const reference, so using set_seed for example will not be
+                                              // allowed
+        auto dim = prob.get_nx();             // This getter does not return a const reference but a copy
+        const auto &lb = prob.get_lb();
+        const auto &ub = prob.get_ub();
+
+        auto fevals0 = prob.get_fevals(); // discount for the already made fevals
+        unsigned int count = 1u;          // regulates the screen output
+
+        // PREAMBLE-------------------------------------------------------------------------------------------------
+        // We start by checking that the problem is suitable for this
+        // particular algorithm.
+        if (prob.get_nobj() != 1u) {
+            pagmo_throw(std::invalid_argument, "Multiple objectives detected in " + prob.get_name() + " instance. "
+                                                   + get_name() + " cannot deal with them");
+        }
+        if (prob.get_nc() != 0u) {
+            pagmo_throw(std::invalid_argument, "Non linear constraints detected in " + prob.get_name() + " instance. "
+                                                   + get_name() + " cannot deal with them");
+        }
+        if (prob.is_stochastic()) {
+            pagmo_throw(std::invalid_argument,
+                        "The problem appears to be stochastic " + get_name() + " cannot deal with it");
+        }
+        if (pop.size() == 0u) {
+            pagmo_throw(std::invalid_argument, get_name() + " does not work on an empty population");
+        }
+        for (decltype(dim) i = 0u; i < dim; ++i) {
+            if (!std::isfinite(lb[i]) || !std::isfinite(ub[i])) {
+                pagmo_throw(std::invalid_argument, "Infinite bounds detected in " + prob.get_name() + " instance. "
+                                                       + get_name() + " cannot deal with them");
+            }
+        }
+        // Get out if there is nothing to do.
+        if (m_max_fevals == 0u) {
+            return pop;
+        }
+        // ---------------------------------------------------------------------------------------------------------
+
+        // No throws, all valid: we clear the logs
+        m_log.clear();
+
+        // Rowan's constants: the step reduction factor, the bounds on the step rescaling and the subspace dimensions.
+        const double psi = .25, omega = .1;
+        const vector_double::size_type ns_min = std::min(dim, vector_double::size_type(2u)),
+                                       ns_max = std::min(dim, vector_double::size_type(5u));
+
+        // The search is carried out in the unit hypercube, starting from the best individual of the population.
+        auto best_idx = pop.best_idx();
+        vector_double u(dim);
+        for (decltype(dim) i = 0u; i < dim; ++i) {
+            u[i] = (ub[i] > lb[i]) ? (pop.get_x()[best_idx][i] - lb[i]) / (ub[i] - lb[i]) : 0.;
+        }
+        double fu = pop.get_f()[best_idx][0];
+        // The speculative evaluations pay off only if they can run concurrently.
+        const auto n_workers = detail::nm_evaluator::n_workers(prob, m_speculative);
+        const bool speculative = m_speculative && n_workers > 1u;
+        detail::nm_evaluator eval(prob, lb, ub, n_workers);
+        const detail::nm_fevals_guard fevals_guard{eval};
+        detail::nm_workspace ws(ns_max);
+        // Buffers for the current subspace and for the progress of the cycle.
+        vector_double y(ns_max), y_step(ns_max), u_old(dim), step(dim, m_start_range), dx(step);
+        std::vector<vector_double::size_type> order(dim), sizes;
+        unsigned long long budget = m_max_fevals;
+        auto no_log = [](double, double) {};
+        bool converged = false;
+
+        while (budget && !converged) {
+            // 1 - Partition the coordinates into subspaces, sorted by decreasing progress.
+            detail::subplex_partition(dx, ns_min, ns_max, order, sizes);
+            // 2 - A Nelder-Mead search in each subspace.
+            u_old = u;
+            for (decltype(dim) start = 0u, s = 0u; s < sizes.size() && budget; start += sizes[s++]) {
+                const auto m = sizes[s];
+                eval.base() = u;
+                eval.idx().assign(order.begin() + static_cast<std::ptrdiff_t>(start),
+                                  order.begin() + static_cast<std::ptrdiff_t>(start + m));
+                double max_step = 0.;
+                for (decltype(dim) j = 0u; j < m; ++j) {
+                    y[j] = u[eval.idx()[j]];
+                    y_step[j] = step[eval.idx()[j]];
+                    max_step = std::max(max_step, std::abs(y_step[j]));
+                }
+                detail::nm_minimize(ws, m, y.data(), fu, y_step.data(), psi * max_step, budget, speculative, eval,
+                                    no_log);
+                for (decltype(dim) j = 0u; j < m; ++j) {
+                    u[eval.idx()[j]] = y[j];
+                }
+            }
+            // 3 - Rescale and reorient the steps according to the progress of the cycle.
+            for (decltype(dim) i = 0u; i < dim; ++i) {
+                dx[i] = u[i] - u_old[i];
+            }
+            const double max_step = detail::subplex_rescale_steps(dx, step, sizes.size(), psi, omega);
+            // A cycle cut short by the budget says nothing about convergence.
+            converged = budget > 0u;
+            for (decltype(dim) i = 0u; i < dim; ++i) {
+                if (std::max(std::abs(dx[i]), psi * std::abs(step[i])) >= m_stop_range) {
+                    converged = false;
+                }
+            }
+
+            // Logs and prints (verbosity modes > 1: a line is added every m_verbosity cycles)
+            if (m_verbosity > 0u && count++ % m_verbosity == 0u) {
+                // 1 - Every 50 lines print the column names
+                if (m_log.size() % 50u == 0u) {
+                    print("\n", std::setw(7), "Fevals:", std::setw(15), "Best:", std::setw(15), "Subspaces:",
+                          std::setw(15), "Step:", '\n');
+                }
+                // 2 - Print
+                print(std::setw(7), eval.get_fevals(), std::setw(15), fu, std::setw(15), sizes.size(), std::setw(15),
+                      max_step, '\n');
+                // Logs
+                m_log.push_back(log_line_type(eval.get_fevals(), fu, sizes.size(), max_step));
+            }
+        }
+        eval.sync_fevals();
+
+        if (m_verbosity) {
+            if (converged) {
+                std::cout << "Exit condition -- range: < " << m_stop_range << "\n";
+            } else {
+                std::cout << "Exit condition -- fevals: " << prob.get_fevals() - fevals0 << " >= " << m_max_fevals
+                          << "\n";
+            }
+        }
+
+        // Force the current best into the original population
+        if (fu < pop.get_f()[best_idx][0]) {
+            pop.set_xf(best_idx, eval.to_x(u), {fu});
+        }
+        return pop;
+    }
+
+    /// Sets the algorithm verbosity
+    /**
+     * Sets the verbosity level of the screen output and of the
+     * log returned by get_log(). \p level can be:
+     * - 0: no verbosity
+     * - >0: will print and log one line every \p level cycles
+     *
+     * Example (verbosity 1, on a 10 dimensional Rosenbrock problem):
+     * @code{.unparsed}
+     * Fevals:          Best:     Subspaces:          Step:
+     *     162        734.076              3       0.229613
+     *     251        200.905              4      0.0229613
+     *     332        50.3136              5      0.0123507
+     *     414        19.4797              4     0.00482943
+     *     495        5.99442              4     0.00349325
+     *     586        4.41608              4     0.00141824
+     *     674        4.23372              3    0.000352435
+     *     778        4.16182              4    0.000276411
+     * ...
+     *    2994         4.1336              5     2.1199e-05
+     *    3000         4.1336              5     2.1199e-06
+     * Exit condition -- fevals: 3000 >= 3000
+     * @endcode
+     * Fevals is the number of function evaluations made, Best is the best fitness, Subspaces is the number of
+     * subspaces searched in the cycle and Step is the largest step size for the next cycle, relative to the box bounds.
+     *
+     * @param level verbosity level
+     */
+    void set_verbosity(unsigned int level)
+    {
+        m_verbosity = level;
+    }
+    /// Gets the verbosity level
+    /**
+     * @return the verbosity level
+     */
+    unsigned int get_verbosity() const
+    {
+        return m_verbosity;
+    }
+    /// Gets the maximum number of function evaluations allowed
+    /**
+     * @return the maximum number of function evaluations allowed
+     */
+    unsigned int get_max_fevals() const
+    {
+        return m_max_fevals;
+    }
+    /// Gets the stop_range
+    /**
+     * @return the stop range
+     */
+    double get_stop_range() const
+    {
+        return m_stop_range;
+    }
+    /// Get the start range
+    /**
+     * @return the start range
+     */
+    double get_start_range() const
+    {
+        return m_start_range;
+    }
+    /// Get the speculative flag
+    /**
+     * @return \p true if the candidate points of each Nelder-Mead iteration are evaluated concurrently
+     */
+    bool get_speculative() const
+    {
+        return m_speculative;
+    }
+    /// Algorithm name
+    /**
+     * One of the optional methods of any user-defined algorithm (UDA).
+     *
+     * @return a string containing the algorithm name
+     */
+    std::string get_name() const
+    {
+        return "Subplex";
+    }
+    /// Extra informations
+    /**
+     * One of the optional methods of any user-defined algorithm (UDA).
+     *
+     * @return a string containing extra informations on the algorithm
+     */
+    std::string get_extra_info() const
+    {
+        std::ostringstream ss;
+        stream(ss, "\tMaximum number of objective function evaluations: ", m_max_fevals);
+        stream(ss, "\n\tStart range: ", m_start_range);
+        stream(ss, "\n\tStop range: ", m_stop_range);
+        stream(ss, "\n\tSpeculative evaluations: ", m_speculative);
+        stream(ss, "\n\tVerbosity: ", m_verbosity);
+        return ss.str();
+    }
+
+    /// Get log
+    /**
+     * A log containing relevant quantities monitoring the last call to evolve. Each element of the returned
+     * <tt> std::vector </tt> is a subplex::log_line_type containing: Fevals, Best, Subspaces, Step
+     * as described in subplex::set_verbosity
+     * @return an <tt> std::vector </tt> of subplex::log_line_type containing the logged values Fevals, Best,
+     * Subspaces, Step
+     */
+    const log_type &get_log() const
+    {
+        return m_log;
+    }
+
+    /// Object serialization
+    /**
+     * This method will save/load \p this into the archive \p ar.
+     *
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of the UDP and of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_max_fevals, m_start_range, m_stop_range, m_speculative, m_verbosity, m_log);
+    }
+
+private:
+    unsigned int m_max_fevals;
+    double m_start_range;
+    double m_stop_range;
+    bool m_speculative;
+    unsigned int m_verbosity;
+    mutable log_type m_log;
+};
+
+} // namespaces
+
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::subplex)
+
+#endif
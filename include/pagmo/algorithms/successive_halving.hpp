@@ -0,0 +1,419 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_ALGORITHMS_SUCCESSIVE_HALVING_HPP
+#define PAGMO_ALGORITHMS_SUCCESSIVE_HALVING_HPP
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../algorithm.hpp"
+#include "../exceptions.hpp"
+#include "../io.hpp"
+#include "../population.hpp"
+#include "../problem.hpp"
+#include "../threading.hpp"
+#include "../type_traits.hpp"
+#include "../types.hpp"
+#include "../utils/constrained.hpp"
+#include "de.hpp"
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// A UDP exposing a single fidelity level of a pagmo::problem as its fitness.
+struct fidelity_view {
+    fidelity_view() : m_prob(), m_level(0u)
+    {
+    }
+    fidelity_view(const problem &prob, unsigned level) : m_prob(prob), m_level(level)
+    {
+    }
+    vector_double fitness(const vector_double &x) const
+    {
+        return m_prob.fitness(x, m_level);
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return m_prob.get_bounds();
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return m_prob.get_nobj();
+    }
+    vector_double::size_type get_nec() const
+    {
+        return m_prob.get_nec();
+    }
+    vector_double::size_type get_nic() const
+    {
+        return m_prob.get_nic();
+    }
+    thread_safety get_thread_safety() const
+    {
+        return m_prob.get_thread_safety();
+    }
+    std::string get_name() const
+    {
+        return m_prob.get_name() + " [fidelity level " + std::to_string(m_level) + "]";
+    }
+    problem m_prob;
+    unsigned m_level;
+};
+}
+
+/// Successive halving over fidelity levels.
+/**
+ * Some problems can evaluate their fitness at several levels of fidelity, e.g. by running a simulation on a coarser
+ * grid or for fewer steps (see pagmo::has_fidelity_fitness and problem::fitness(const vector_double &, unsigned)).
+ * This meta-algorithm lets any population-based user-defined algorithm (UDA) explore at the cheapest level and
+ * spends the more expensive levels only on the candidates that look promising there.
+ *
+ * The UDA evolves a shadow population whose fitness is the coarsest fidelity level. At each generation,
+ * the individuals changed by the UDA are the candidates for promotion. They are ranked at the current level, only
+ * the best \f$\lceil k / \eta \rceil\f$ of the \f$k\f$ candidates are re-evaluated at the next level, and so on up
+ * to the finest level, which is the fitness of the problem. Each candidate surviving all the rungs replaces the
+ * worst individual of the population being evolved if it is better. The pseudo code is:
+ * @code{.unparsed}
+ * > Evaluate the population at level 0 into a shadow population
+ * > for each generation
+ * > > Evolve the shadow population using the UDA
+ * > > Collect as candidates the individuals that changed
+ * > > for each level l = 1 .. n_levels - 1
+ * > > > Keep the best ceil(k / eta) candidates (ranked at level l - 1)
+ * > > > Evaluate them at level l
+ * > > Replace the worst individuals of the population with the better survivors
+ * @endcode
+ *
+ * Lower fidelity evaluations, including those made by the UDA on the shadow population, are credited to
+ * problem::get_lfevals() of the population's problem, while problem::get_fevals() only counts the evaluations
+ * at the finest level.
+ *
+ * pagmo::successive_halving is a user-defined algorithm (UDA) that can be used to construct pagmo::algorithm objects.
+ *
+ * See: K. Jamieson and A. Talwalkar, "Non-stochastic best arm identification and hyperparameter optimization",
+ * AISTATS 2016, for the successive halving scheme.
+ */
+class successive_halving : public algorithm
+{
+    // Enabler for the ctor from UDA.
+    template <typename T>
+    using ctor_enabler
+        = enable_if_t<std::is_constructible<algorithm, T &&>::value && !std::is_same<uncvref_t<T>, algorithm>::value,
+                      int>;
+
+public:
+    /// Single entry of the log (gen, fevals, lower fidelity fevals, best fitness, promoted).
+    typedef std::tuple<unsigned, unsigned long long, unsigned long long, double, vector_double::size_type>
+        log_line_type;
+    /// The log.
+    typedef std::vector<log_line_type> log_type;
+    /// Default constructor.
+    /**
+     * The default constructor will initialize the algorithm with the following parameters:
+     * - inner algorithm: pagmo::de with one generation;
+     * - number of generations: 10;
+     * - reduction factor: 3.
+     *
+     * @throws unspecified any exception thrown by the constructor of pagmo::algorithm.
+     */
+    successive_halving() : algorithm(de{1u}), m_gen(10u), m_eta(3u), m_verbosity(0u)
+    {
+    }
+    /// Constructor.
+    /**
+     * **NOTE** This constructor is enabled only if \p T, after the removal of cv/reference qualifiers,
+     * is not pagmo::algorithm.
+     *
+     * @param a a user-defined algorithm (UDA) that will be used to construct the inner algorithm.
+     * @param gen number of generations, i.e., of calls to the inner algorithm.
+     * @param eta reduction factor between consecutive fidelity levels.
+     *
+     * @throws unspecified any exception thrown by the constructor of pagmo::algorithm.
+     * @throws std::invalid_argument if \p eta is smaller than 2.
+     */
+    template <typename T, ctor_enabler<T> = 0>
+    explicit successive_halving(T &&a, unsigned gen = 10u, unsigned eta = 3u)
+        : algorithm(std::forward<T>(a)), m_gen(gen), m_eta(eta), m_verbosity(0u)
+    {
+        if (eta < 2u) {
+            pagmo_throw(std::invalid_argument, "The reduction factor must be at least 2, while a value of "
+                                                   + std::to_string(eta) + " was detected.");
+        }
+    }
+    /// Evolve method.
+    /**
+     * This method will evolve the input population for \p gen generations, as described above.
+     *
+     * @param pop population to be evolved.
+     *
+     * @return evolved population.
+     *
+     * @throws std::invalid_argument if the problem is multi-objective or stochastic, if it has a single
+     * fidelity level or if the population is empty.
+     * @throws unspecified any exception thrown by the inner algorithm or by the problem.
+     */
+    population evolve(population pop) const
+    {
+        // We store some useful variables
+        const auto &prob = pop.get_problem();
+        const auto nec = prob.get_nec();
+        const auto c_tol = prob.get_c_tol();
+        const auto n_levels = static_cast<unsigned>(prob.get_fidelity_costs().size());
+        auto fevals0 = prob.get_fevals();
+        auto lfevals0 = prob.get_lfevals();
+        unsigned count = 1u; // regulates the screen output
+
+        // PREAMBLE-------------------------------------------------------------------------------------------------
+        if (prob.get_nobj() != 1u) {
+            pagmo_throw(std::invalid_argument, "Multiple objectives detected in " + prob.get_name() + " instance. "
+                                                   + get_name() + " cannot deal with them");
+        }
+        if (prob.is_stochastic()) {
+            pagmo_throw(std::invalid_argument, "The input problem " + prob.get_name() + " appears to be stochastic, "
+                                                   + get_name() + " cannot deal with it");
+        }
+        if (n_levels < 2u) {
+            pagmo_throw(std::invalid_argument, "The input problem " + prob.get_name()
+                                                   + " has a single fidelity level, " + get_name()
+                                                   + " needs at least two");
+        }
+        // Get out if there is nothing to do.
+        if (m_gen == 0u) {
+            return pop;
+        }
+        if (!pop.size()) {
+            pagmo_throw(std::invalid_argument, get_name() + " does not work on an empty population");
+        }
+        // ---------------------------------------------------------------------------------------------------------
+
+        // No throws, all valid: we clear the logs
+        m_log.clear();
+
+        // The shadow population, evaluated at the coarsest level on a view of the problem. The view must use the
+        // same constraint tolerances, as the inner algorithm ranks the individuals with those of its problem.
+        problem lf_prob{detail::fidelity_view{prob, 0u}};
+        lf_prob.set_c_tol(c_tol);
+        population lf_pop{std::move(lf_prob)};
+        for (const auto &x : pop.get_x()) {
+            lf_pop.push_back(x);
+        }
+        // Ranks two fitness vectors in the usual way.
+        auto better = [nec, &c_tol](const vector_double &a, const vector_double &b) {
+            return compare_fc(a, b, nec, c_tol);
+        };
+        auto lf_fevals = lf_pop.get_problem().get_fevals();
+        detail::problem_counters::increment_lfevals(prob, lf_fevals);
+
+        for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // 1 - The inner algorithm explores at the coarsest level.
+            const auto old_x = lf_pop.get_x();
+            lf_pop = static_cast<const algorithm *>(this)->evolve(std::move(lf_pop));
+            const auto new_lf_fevals = lf_pop.get_problem().get_fevals();
+            detail::problem_counters::increment_lfevals(prob, new_lf_fevals - lf_fevals);
+            lf_fevals = new_lf_fevals;
+            // 2 - The candidates are the individuals it changed, with their current fitness.
+            std::vector<std::pair<vector_double, vector_double>> cand;
+            for (decltype(lf_pop.size()) i = 0u; i < lf_pop.size(); ++i) {
+                if (i >= old_x.size() || lf_pop.get_x()[i] != old_x[i]) {
+                    cand.emplace_back(lf_pop.get_x()[i], lf_pop.get_f()[i]);
+                }
+            }
+            // 3 - Successive halving over the finer levels.
+            for (unsigned level = 1u; level < n_levels && cand.size(); ++level) {
+                std::sort(cand.begin(), cand.end(),
+                          [&better](const std::pair<vector_double, vector_double> &a,
+                                    const std::pair<vector_double, vector_double> &b) {
+                              return better(a.second, b.second);
+                          });
+                cand.resize((cand.size() + m_eta - 1u) / m_eta);
+                for (auto &c : cand) {
+                    c.second = prob.fitness(c.first, level);
+                }
+            }
+            // 4 - The survivors, evaluated at the finest level, compete with the worst individuals.
+            for (const auto &c : cand) {
+                const auto worst = pop.worst_idx();
+                if (better(c.second, pop.get_f()[worst])) {
+                    pop.set_xf(worst, c.first, c.second);
+                }
+            }
+            // 5 - We log to screen
+            if (m_verbosity > 0u) {
+                if (count % 50u == 1u) {
+                    print("\n", std::setw(7), "Gen:", std::setw(15), "Fevals:", std::setw(15), "LF fevals:",
+                          std::setw(15), "Best:", std::setw(15), "Promoted:", '\n');
+                }
+                const auto best = pop.get_f()[pop.best_idx()][0];
+                print(std::setw(7), gen, std::setw(15), prob.get_fevals() - fevals0, std::setw(15),
+                      prob.get_lfevals() - lfevals0, std::setw(15), best, std::setw(15), cand.size(), '\n');
+                ++count;
+                m_log.emplace_back(gen, prob.get_fevals() - fevals0, prob.get_lfevals() - lfevals0, best,
+                                   cand.size());
+            }
+        }
+        return pop;
+    }
+    /// Set the algorithm verbosity.
+    /**
+     * This method will set the verbosity level of the screen output and of the
+     * log returned by get_log(). \p level can be:
+     * - 0: no verbosity,
+     * - >0: will print and log one line at the end of each generation.
+     *
+     * Example (verbosity 1):
+     * @code
+     *    Gen:        Fevals:     LF fevals:          Best:      Promoted:
+     *       1              2             44       0.221919              2
+     *       2              3             67       0.221919              1
+     *       3              4             90       0.221919              1
+     *       4              6            114       0.221919              2
+     *       5              7            135       0.193612              1
+     * @endcode
+     * \p Gen is the generation number, \p Fevals the number of fitness evaluations at the finest level,
+     * <tt>LF fevals</tt> the number of evaluations at the lower fidelity levels, \p Best the best fitness in the
+     * population and \p Promoted the number of candidates that reached the finest level.
+     *
+     * @param level verbosity level.
+     */
+    void set_verbosity(unsigned level)
+    {
+        m_verbosity = level;
+    }
+    /// Get the verbosity level.
+    /**
+     * @return the verbosity level.
+     */
+    unsigned get_verbosity() const
+    {
+        return m_verbosity;
+    }
+    /// Get the number of generations.
+    /**
+     * @return the number of generations.
+     */
+    unsigned get_gen() const
+    {
+        return m_gen;
+    }
+    /// Get the reduction factor.
+    /**
+     * @return the reduction factor between consecutive fidelity levels.
+     */
+    unsigned get_eta() const
+    {
+        return m_eta;
+    }
+    /// Get log.
+    /**
+     * A log containing relevant quantities monitoring the last call to successive_halving::evolve(). Each element of
+     * the returned <tt>std::vector</tt> is a successive_halving::log_line_type containing: \p Gen, \p Fevals,
+     * <tt>LF fevals</tt>, \p Best and \p Promoted as described in successive_halving::set_verbosity().
+     *
+     * @return an <tt>std::vector</tt> of successive_halving::log_line_type containing the logged values.
+     */
+    const log_type &get_log() const
+    {
+        return m_log;
+    }
+    /// Algorithm name
+    /**
+     * @return a string containing the algorithm name.
+     */
+    std::string get_name() const
+    {
+        return "Successive halving over fidelity levels";
+    }
+    /// Extra informations
+    /**
+     * @return a string containing extra informations on the algorithm.
+     */
+    std::string get_extra_info() const
+    {
+        std::ostringstream ss;
+        stream(ss, "\tGenerations: ", m_gen);
+        stream(ss, "\n\tReduction factor: ", m_eta);
+        stream(ss, "\n\tVerbosity: ", m_verbosity);
+        stream(ss, "\n\n\tInner algorithm: ", static_cast<const algorithm *>(this)->get_name());
+        stream(ss, "\n\tInner algorithm extra info: ");
+        stream(ss, "\n", static_cast<const algorithm *>(this)->get_extra_info());
+        return ss.str();
+    }
+    /// Object serialization
+    /**
+     * This method will save/load \p this into the archive \p ar.
+     *
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of the UDA and of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(cereal::base_class<algorithm>(this), m_gen, m_eta, m_verbosity, m_log);
+    }
+
+private:
+    // Delete all that we do not want to inherit from algorithm.
+    // A - Common to all meta
+    bool has_set_seed() const = delete;
+    bool is_stochastic() const = delete;
+    bool has_set_verbosity() const = delete;
+    template <typename Archive>
+    void save(Archive &) const = delete;
+    template <typename Archive>
+    void load(Archive &) = delete;
+
+// The CI using gcc 4.8 fails to compile this delete, excluding it in that case does not harm
+// it would just result in a "weird" behaviour in case the user would try to stream this object
+#if __GNUC__ > 4
+    // NOTE: We delete the streaming operator overload called with successive_halving, otherwise the inner algo would
+    // stream
+    friend std::ostream &operator<<(std::ostream &, const successive_halving &) = delete;
+#endif
+
+    unsigned m_gen;
+    unsigned m_eta;
+    unsigned m_verbosity;
+    mutable log_type m_log;
+};
+}
+
+PAGMO_REGISTER_BUILTIN_ALGORITHM(pagmo::successive_halving)
+
+#endif
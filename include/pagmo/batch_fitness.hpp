@@ -0,0 +1,201 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#ifndef PAGMO_BATCH_FITNESS_HPP
+#define PAGMO_BATCH_FITNESS_HPP
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "exceptions.hpp"
+#include "problem.hpp"
+#include "threading.hpp"
+#include "types.hpp"
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+inline void batch_fitness_check_size(const problem &p, vector_double::size_type size)
+{
+    if (size % p.get_nx()) {
+        pagmo_throw(std::invalid_argument, "The size of the batch of decision vectors (" + std::to_string(size)
+                                               + ") is not a multiple of the problem dimension ("
+                                               + std::to_string(p.get_nx()) + ")");
+    }
+}
+} // namespace detail
+
+/// Batch fitness evaluation of a buffer.
+/**
+ * This function computes, with the problem \p p, the fitness of the decision vectors in \p xs. It is equivalent to
+ * a loop calling problem::fitness() on each decision vector, but it evaluates the batch in parallel if the problem
+ * allows it:
+ * - if the UDP implements a <tt>%batch_fitness()</tt> method (see problem::has_batch_fitness()), the whole batch is
+ *   handed over to it via problem::batch_fitness(), and the UDP is responsible for any parallelism;
+ * - otherwise, if the problem provides the pagmo::thread_safety::constant guarantee, the batch is split into
+ *   contiguous chunks which are evaluated concurrently on \p p itself;
+ * - if it provides the pagmo::thread_safety::basic guarantee, each chunk is evaluated on its own copy of \p p, and the
+ *   fitness evaluations performed on the copies are added to the evaluation counter of \p p;
+ * - otherwise, the decision vectors are evaluated one after the other in the calling thread.
+ *
+ * When the batch is split into chunks, the first one is always evaluated in the calling thread.
+ *
+ * The decision vectors are read in place from the buffer starting at \p xs, which is not copied unless the UDP
+ * implements <tt>%batch_fitness()</tt> (problem::batch_fitness() accepts only a pagmo::vector_double).
+ *
+ * @param p the problem.
+ * @param xs pointer to the decision vectors, stored one after the other (it can be null if \p size is zero).
+ * @param size the number of values in the buffer pointed to by \p xs.
+ * @param n_threads the maximum number of threads used for the evaluation, including the calling thread (if zero,
+ * the value returned by <tt>std::thread::hardware_concurrency()</tt>, or 1 if that is unknown). It is ignored if the
+ * UDP implements <tt>%batch_fitness()</tt>.
+ *
+ * @return the fitness vectors, concatenated one after the other in the order of \p xs.
+ *
+ * @throws std::invalid_argument if \p size is not a multiple of the problem dimension.
+ * @throws std::system_error if a thread cannot be started.
+ * @throws unspecified any exception thrown by problem::fitness(), problem::batch_fitness() or by the copy
+ * constructor of pagmo::problem. If several evaluations fail, the exception of the first failing chunk is rethrown
+ * after all the chunks have completed.
+ */
+inline vector_double batch_fitness(const problem &p, const double *xs, vector_double::size_type size,
+                                   unsigned n_threads = 0u)
+{
+    using size_type = vector_double::size_type;
+    const auto nx = p.get_nx(), nf = p.get_nf();
+    detail::batch_fitness_check_size(p, size);
+    if (p.has_batch_fitness()) {
+        return p.batch_fitness(vector_double(xs, xs + size));
+    }
+    const auto n = size / nx;
+    vector_double retval(n * nf);
+    // Evaluates the decision vectors with indices in [begin, end) on q, counting the successful evaluations.
+    auto eval_range = [xs, &retval, nx, nf](const problem &q, size_type begin, size_type end,
+                                            unsigned long long &count) {
+        vector_double x(nx);
+        for (auto i = begin; i < end; ++i) {
+            std::copy(xs + i * nx, xs + (i + 1u) * nx, x.begin());
+            const auto f = q.fitness(x);
+            std::copy(f.begin(), f.end(), retval.begin() + static_cast<vector_double::difference_type>(i * nf));
+            ++count;
+        }
+    };
+
+    const auto ts = p.get_thread_safety();
+    const auto max_threads = n_threads ? n_threads : std::max(1u, std::thread::hardware_concurrency());
+    const auto n_chunks = std::min(static_cast<size_type>(max_threads), n);
+    if (ts < thread_safety::basic || n_chunks < 2u) {
+        unsigned long long count = 0u;
+        eval_range(p, 0u, n, count);
+        return retval;
+    }
+
+    const bool shared = ts == thread_safety::constant;
+    // The outcome of each chunk.
+    std::vector<std::exception_ptr> errors(n_chunks);
+    std::vector<unsigned long long> counts(n_chunks, 0u);
+    auto run_chunk = [&](size_type k) {
+        try {
+            const auto begin = k * n / n_chunks, end = (k + 1u) * n / n_chunks;
+            if (shared) {
+                eval_range(p, begin, end, counts[k]);
+            } else {
+                const problem q(p);
+                eval_range(q, begin, end, counts[k]);
+            }
+        } catch (...) {
+            errors[k] = std::current_exception();
+        }
+    };
+    {
+        // Joins the started threads, also if starting one of them fails.
+        struct joiner {
+            ~joiner()
+            {
+                for (auto &th : m_threads) {
+                    th.join();
+                }
+            }
+            std::vector<std::thread> m_threads;
+        };
+        joiner j;
+        j.m_threads.reserve(n_chunks - 1u);
+        for (size_type k = 1u; k < n_chunks; ++k) {
+            j.m_threads.emplace_back(run_chunk, k);
+        }
+        run_chunk(0u);
+    }
+    if (!shared) {
+        // NOTE: the evaluations performed on the copies are counted also if some of the chunks failed.
+        unsigned long long n_evals = 0u;
+        for (auto c : counts) {
+            n_evals += c;
+        }
+        detail::problem_counters::increment_fevals(p, n_evals);
+    }
+    for (const auto &e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+    return retval;
+}
+
+/// Batch fitness evaluation.
+/**
+ * Equivalent to pagmo::batch_fitness(const problem &, const double *, vector_double::size_type, unsigned) on the
+ * content of \p xs, which is handed over without copies to problem::batch_fitness() if the UDP implements
+ * <tt>%batch_fitness()</tt>.
+ *
+ * @param p the problem.
+ * @param xs the decision vectors, concatenated one after the other.
+ * @param n_threads the maximum number of threads used for the evaluation (see the other overload).
+ *
+ * @return the fitness vectors, concatenated one after the other in the order of \p xs.
+ *
+ * @throws unspecified any exception thrown by the other overload.
+ */
+inline vector_double batch_fitness(const problem &p, const vector_double &xs, unsigned n_threads = 0u)
+{
+    if (p.has_batch_fitness()) {
+        detail::batch_fitness_check_size(p, xs.size());
+        return p.batch_fitness(xs);
+    }
+    return batch_fitness(p, xs.data(), xs.size(), n_threads);
+}
+}
+
+#endif
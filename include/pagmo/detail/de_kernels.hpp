@@ -0,0 +1,323 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_DETAIL_DE_KERNELS_HPP
+#define PAGMO_DETAIL_DE_KERNELS_HPP
+
+#include <cassert>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../rng.hpp"
+#include "../types.hpp"
+#include "../utils/generic.hpp"
+
+namespace pagmo
+{
+namespace detail
+{
+// Kernels shared by the differential evolution algorithms (de, sade and de1220). They produce
+// the trial vectors of a whole generation at once: the donor indices are selected for all the
+// individuals, the binomial crossover masks are drawn in bulk as raw outputs of the random engine
+// and the mutation, crossover and bounds repair are performed in tight loops over contiguous memory.
+//
+// The mutation variants are numbered as in sade and de1220 (1 to 18). The variants 1 to 10 of
+// de are the same as the variants 1 to 10 in sade. The variants 1 to 5, 11, 13, 15 and 17 use the
+// exponential crossover, the others the binomial one (see de_variant_is_exp()).
+
+// Number of donors (i.e., random population members) needed by the variants up to 18.
+constexpr unsigned de_max_donors = 7u;
+
+// Buffers reused across the generations.
+struct de_workspace {
+    // The permutation used to select the donors.
+    std::vector<vector_double::size_type> m_idxs;
+    // Raw outputs of the random engine for the binomial crossover mask.
+    std::vector<unsigned long long> m_u;
+    // The donor vector of the current individual.
+    vector_double m_donor;
+};
+
+// The donor of a DE mutation is written as base + F * sum_k (plus[k] - minus[k]).
+struct de_mutation {
+    const double *base;
+    const double *plus[3];
+    const double *minus[3];
+    unsigned n_diffs;
+};
+
+// Does the variant use the exponential crossover?
+inline bool de_variant_is_exp(unsigned variant)
+{
+    if (variant <= 5u) {
+        return true;
+    }
+    if (variant <= 10u) {
+        return false;
+    }
+    // From 11 on, exponential and binomial crossovers alternate.
+    return variant % 2u == 1u;
+}
+
+// Builds the mutation for the individual i, with donors r and best individual best.
+inline de_mutation de_make_mutation(unsigned variant, const std::vector<vector_double> &pop,
+                                    vector_double::size_type i, const vector_double::size_type *r,
+                                    const vector_double &best)
+{
+    const double *x = pop[i].data(), *b = best.data();
+    auto p = [&pop, r](unsigned k) { return pop[r[k]].data(); };
+    switch (variant) {
+        case 1u: // DE/best/1/exp
+        case 6u: // DE/best/1/bin
+            return {b, {p(1u), nullptr, nullptr}, {p(2u), nullptr, nullptr}, 1u};
+        case 2u: // DE/rand/1/exp
+        case 7u: // DE/rand/1/bin
+            return {p(0u), {p(1u), nullptr, nullptr}, {p(2u), nullptr, nullptr}, 1u};
+        case 3u: // DE/rand-to-best/1/exp
+        case 8u: // DE/rand-to-best/1/bin
+            return {x, {b, p(0u), nullptr}, {x, p(1u), nullptr}, 2u};
+        case 4u: // DE/best/2/exp
+        case 9u: // DE/best/2/bin
+            return {b, {p(0u), p(2u), nullptr}, {p(1u), p(3u), nullptr}, 2u};
+        case 5u:  // DE/rand/2/exp
+        case 10u: // DE/rand/2/bin
+            return {p(4u), {p(0u), p(2u), nullptr}, {p(1u), p(3u), nullptr}, 2u};
+        case 11u: // DE/rand/3/exp
+        case 12u: // DE/rand/3/bin
+            return {p(0u), {p(1u), p(3u), p(5u)}, {p(2u), p(4u), p(6u)}, 3u};
+        case 13u: // DE/best/3/exp
+        case 14u: // DE/best/3/bin
+            return {b, {p(1u), p(3u), p(5u)}, {p(2u), p(4u), p(6u)}, 3u};
+        case 15u: // DE/rand-to-current/2/exp
+        case 16u: // DE/rand-to-current/2/bin
+            return {p(0u), {p(1u), p(2u), nullptr}, {x, p(3u), nullptr}, 2u};
+        default: // 17, 18: DE/rand-to-best-and-current/2/exp and bin
+            assert(variant == 17u || variant == 18u);
+            return {p(0u), {p(1u), b, nullptr}, {x, p(2u), nullptr}, 2u};
+    }
+}
+
+// Computes the full donor vector of a mutation into out. The loops have no branches
+// and no aliasing with the output, so that they can be vectorized.
+inline void de_compute_donor(double *out, const de_mutation &m, double F, vector_double::size_type dim)
+{
+    const double *base = m.base, *p0 = m.plus[0], *m0 = m.minus[0];
+    switch (m.n_diffs) {
+        case 1u:
+            for (decltype(dim) j = 0u; j < dim; ++j) {
+                out[j] = base[j] + F * (p0[j] - m0[j]);
+            }
+            break;
+        case 2u: {
+            const double *p1 = m.plus[1], *m1 = m.minus[1];
+            for (decltype(dim) j = 0u; j < dim; ++j) {
+                out[j] = base[j] + F * (p0[j] - m0[j]) + F * (p1[j] - m1[j]);
+            }
+            break;
+        }
+        default: {
+            const double *p1 = m.plus[1], *m1 = m.minus[1], *p2 = m.plus[2], *m2 = m.minus[2];
+            for (decltype(dim) j = 0u; j < dim; ++j) {
+                out[j] = base[j] + F * (p0[j] - m0[j]) + F * (p1[j] - m1[j]) + F * (p2[j] - m2[j]);
+            }
+        }
+    }
+}
+
+// Selects, for each of the NP individuals, n_donors distinct random indices in [0, NP) using
+// Durstenfeld's algorithm. The indices of the individual i are stored in r[i * n_donors + k].
+inline void de_select_donors(std::vector<vector_double::size_type> &r, vector_double::size_type NP, unsigned n_donors,
+                             detail::random_engine_type &r_engine, de_workspace &ws)
+{
+    assert(n_donors <= NP);
+    r.resize(NP * n_donors);
+    // The permutation does not need to be reset between individuals: any permutation
+    // of [0, NP) gives a uniform selection.
+    ws.m_idxs.resize(NP);
+    std::iota(ws.m_idxs.begin(), ws.m_idxs.end(), vector_double::size_type(0u));
+    auto out = r.data();
+    for (decltype(NP) i = 0u; i < NP; ++i) {
+        for (decltype(n_donors) j = 0u; j < n_donors; ++j) {
+            auto idx = std::uniform_int_distribution<vector_double::size_type>(0u, NP - 1u - j)(r_engine);
+            *out++ = ws.m_idxs[idx];
+            std::swap(ws.m_idxs[idx], ws.m_idxs[NP - 1u - j]);
+        }
+    }
+}
+
+// Self-adaptation of F and CR with the DE operators (variant_adptv == 2 in sade and de1220): the
+// new parameters of the individual i are obtained by applying to the parameters of the population
+// (F and CR, with gbF and gbCR those of the best individual) the same mutation used for the
+// decision vectors.
+inline std::pair<double, double> de_adapt_F_CR(unsigned variant, vector_double::size_type i,
+                                               const vector_double::size_type *r, const vector_double &F,
+                                               const vector_double &CR, double gbF, double gbCR,
+                                               detail::random_engine_type &r_engine)
+{
+    std::normal_distribution<double> n_dist(0., 1.);
+    auto N = [&n_dist, &r_engine]() { return n_dist(r_engine) * 0.5; };
+    double newF, newCR;
+    switch (variant) {
+        case 1u:
+        case 6u:
+            newF = gbF + N() * (F[r[1]] - F[r[2]]);
+            newCR = gbCR + N() * (CR[r[1]] - CR[r[2]]);
+            break;
+        case 2u:
+        case 7u:
+            newF = F[r[0]] + N() * (F[r[1]] - F[r[2]]);
+            newCR = CR[r[0]] + N() * (CR[r[1]] - CR[r[2]]);
+            break;
+        case 3u:
+        case 8u:
+            newF = F[i] + N() * (gbF - F[i]);
+            newF += N() * (F[r[0]] - F[r[1]]);
+            newCR = CR[i] + N() * (gbCR - CR[i]);
+            newCR += N() * (CR[r[0]] - CR[r[1]]);
+            break;
+        case 4u:
+        case 9u:
+            newF = gbF + N() * (F[r[0]] - F[r[1]]);
+            newF += N() * (F[r[2]] - F[r[3]]);
+            newCR = gbCR + N() * (CR[r[0]] - CR[r[1]]);
+            newCR += N() * (CR[r[2]] - CR[r[3]]);
+            break;
+        case 5u:
+        case 10u:
+            newF = F[r[4]] + N() * (F[r[0]] - F[r[1]]);
+            newF += N() * (F[r[2]] - F[r[3]]);
+            newCR = CR[r[4]] + N() * (CR[r[0]] - CR[r[1]]);
+            newCR += N() * (CR[r[2]] - CR[r[3]]);
+            break;
+        case 11u:
+        case 12u:
+            newF = F[r[0]] + N() * (F[r[1]] - F[r[2]]);
+            newF += N() * (F[r[3]] - F[r[4]]);
+            newF += N() * (F[r[5]] - F[r[6]]);
+            newCR = CR[r[4]] + N() * (CR[r[0]] + CR[r[1]] - CR[r[2]] - CR[r[3]]);
+            break;
+        case 13u:
+        case 14u:
+            newF = gbF + N() * (F[r[1]] - F[r[2]]);
+            newF += N() * (F[r[3]] - F[r[4]]);
+            newF += N() * (F[r[5]] - F[r[6]]);
+            newCR = gbCR + N() * (CR[r[0]] + CR[r[1]] - CR[r[2]] - CR[r[3]]);
+            break;
+        case 15u:
+        case 16u:
+            newF = F[r[0]] + N() * (F[r[1]] - F[i]);
+            newF += N() * (F[r[3]] - F[r[4]]);
+            newCR = CR[r[0]] + N() * (CR[r[1]] - CR[i]);
+            newCR += N() * (CR[r[3]] - CR[r[4]]);
+            break;
+        default:
+            assert(variant == 17u || variant == 18u);
+            newF = F[r[0]] + N() * (F[r[1]] - F[i]);
+            newF -= N() * (F[r[2]] - gbF);
+            newCR = CR[r[0]] + N() * (CR[r[1]] - CR[i]);
+            newCR -= N() * (CR[r[3]] - gbCR);
+    }
+    return std::make_pair(newF, newCR);
+}
+
+// Threshold t such that a raw output u of the random engine satisfies u < t with probability p:
+// comparing the raw outputs with t replaces the generation of a uniform double in [0, 1) (which
+// takes two outputs of the engine) and its comparison with p in the Bernoulli trials.
+inline unsigned long long de_bernoulli_threshold(double p)
+{
+    using res_t = detail::random_engine_type::result_type;
+    static_assert(detail::random_engine_type::min() == 0u, "Invalid random engine.");
+    // The number of possible outputs of the engine, as a floating-point value.
+    const double range = static_cast<double>(detail::random_engine_type::max()) + 1.;
+    if (!(p > 0.)) {
+        return 0u;
+    }
+    if (p >= 1.) {
+        return static_cast<unsigned long long>(detail::random_engine_type::max()) + 1u;
+    }
+    return static_cast<unsigned long long>(static_cast<res_t>(p * range));
+}
+
+// Produces the trial vectors of a whole generation. For the individual i, the variant, F and CR are
+// variants[i], F[i] and CR[i], and its donors are r[i * n_donors], ..., r[i * n_donors + n_donors - 1]
+// (see de_select_donors()). The components of the trials outside the bounds are resampled uniformly
+// within the bounds.
+inline void de_generate_trials(std::vector<vector_double> &trials, const std::vector<vector_double> &pop,
+                               const vector_double &best, const std::vector<vector_double::size_type> &r,
+                               unsigned n_donors, const std::vector<unsigned> &variants, const vector_double &F,
+                               const vector_double &CR, const vector_double &lb, const vector_double &ub,
+                               detail::random_engine_type &r_engine, de_workspace &ws)
+{
+    const auto NP = pop.size();
+    const auto dim = lb.size();
+    assert(NP && dim);
+    assert(variants.size() == NP && F.size() == NP && CR.size() == NP && r.size() == NP * n_donors);
+    trials.resize(NP);
+    std::uniform_int_distribution<vector_double::size_type> c_idx(0u, dim - 1u);
+    ws.m_u.resize(dim);
+    ws.m_donor.resize(dim);
+    double *donor = ws.m_donor.data();
+    for (decltype(pop.size()) i = 0u; i < NP; ++i) {
+        // 1 - Mutation.
+        de_compute_donor(donor, de_make_mutation(variants[i], pop, i, r.data() + i * n_donors, best), F[i], dim);
+        // 2 - Crossover.
+        auto &tmp = trials[i];
+        tmp = pop[i];
+        auto n = c_idx(r_engine);
+        const auto thr = de_bernoulli_threshold(CR[i]);
+        if (de_variant_is_exp(variants[i])) {
+            // A run of L consecutive components (cyclically) starting at n, where L - 1 is
+            // the number of consecutive successes of the Bernoulli trials.
+            decltype(pop.size()) L = 0u;
+            do {
+                tmp[n] = donor[n];
+                n = (n + 1u) % dim;
+                ++L;
+            } while (L < dim && r_engine() < thr);
+        } else {
+            // Binomial trials, with the component n always changed. The mask is drawn in bulk.
+            auto u = ws.m_u.data();
+            for (decltype(pop.size()) j = 0u; j < dim; ++j) {
+                u[j] = r_engine();
+            }
+            double *t = tmp.data();
+            for (decltype(pop.size()) j = 0u; j < dim; ++j) {
+                t[j] = (u[j] < thr) ? donor[j] : t[j];
+            }
+            t[n] = donor[n];
+        }
+        // 3 - Bounds repair.
+        force_bounds_random(tmp, lb, ub, r_engine);
+    }
+}
+}
+}
+
+#endif
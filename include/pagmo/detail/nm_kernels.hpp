@@ -0,0 +1,385 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_DETAIL_NM_KERNELS_HPP
+#define PAGMO_DETAIL_NM_KERNELS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "../problem.hpp"
+#include "../threading.hpp"
+#include "../types.hpp"
+
+namespace pagmo
+{
+namespace detail
+{
+// Kernels shared by the simplex algorithms (nelder_mead and subplex). The simplex lives in the unit
+// hypercube of a subspace of dimension m: its m + 1 vertices, their objective values and the trial
+// points are stored in a workspace allocated once for the largest subspace and reused across the runs.
+// The objective is computed by an evaluator which receives a batch of points stored contiguously, which
+// allows to evaluate the shrink steps and (if requested) the speculative trial points concurrently. No
+// more evaluations than the budget allows are ever requested.
+
+// Buffers reused across the iterations and across the runs.
+struct nm_workspace {
+    explicit nm_workspace(vector_double::size_type n)
+        : m_vertices((n + 1u) * n), m_f(n + 1u), m_sum(n), m_centroid(n), m_trials(4u * n), m_ftrials(4u)
+    {
+    }
+    // The vertices, one after the other.
+    vector_double m_vertices;
+    vector_double m_f;
+    // The sum of the vertices, and the centroid of all the vertices but the worst.
+    vector_double m_sum;
+    vector_double m_centroid;
+    // Reflection, expansion, outside contraction and inside contraction points.
+    vector_double m_trials;
+    vector_double m_ftrials;
+};
+
+// Writes c + t * (d - c) into out, projected onto the unit hypercube.
+inline void nm_move(const double *c, const double *d, double t, vector_double::size_type m, double *out)
+{
+    for (decltype(m) j = 0u; j < m; ++j) {
+        out[j] = std::min(std::max(c[j] + t * (d[j] - c[j]), 0.), 1.);
+    }
+}
+
+// Nelder-Mead, with the dimension adaptive coefficients of Gao and Han (2012). On entry x holds the
+// starting point, fx its objective value and step the signed initial edge lengths of the simplex; on
+// exit they hold the best vertex found. The run stops when the largest distance (infinity norm) of a
+// vertex from the best one falls below tol, or when the budget of evaluations is exhausted.
+//
+// eval(pts, k, out) must evaluate the k points of dimension m stored from pts, writing the values into
+// out. on_iter(fbest, size) is called at the end of each iteration. If speculative is true, the four
+// candidate points of an iteration are evaluated in a single batch before deciding which one to use,
+// which yields the same sequence of simplices at the price of more evaluations.
+template <typename Eval, typename OnIter>
+inline void nm_minimize(nm_workspace &ws, vector_double::size_type m, double *x, double &fx, const double *step,
+                        double tol, unsigned long long &budget, bool speculative, Eval &eval, OnIter &on_iter)
+{
+    double *v = ws.m_vertices.data(), *f = ws.m_f.data(), *sum = ws.m_sum.data(), *c = ws.m_centroid.data();
+    double *xr = ws.m_trials.data(), *xe = xr + m, *xoc = xe + m, *xic = xoc + m;
+    double *ft = ws.m_ftrials.data();
+    const double dm = static_cast<double>(m);
+    // The adaptive coefficients reduce to the standard ones in two dimensions, which are used in one dimension too.
+    const double da = std::max(dm, 2.);
+    const double alpha = 1., gamma = 1. + 2. / da, rho = .75 - 1. / (2. * da), sigma = 1. - 1. / da;
+    const auto n_vert = m + 1u;
+    auto charge = [&budget](unsigned long long k) { budget -= std::min(budget, k); };
+    auto accept = [&](vector_double::size_type h, const double *p, double fp) {
+        for (decltype(m) j = 0u; j < m; ++j) {
+            sum[j] += p[j] - v[h * m + j];
+            v[h * m + j] = p[j];
+        }
+        f[h] = fp;
+    };
+    // 1 - The initial simplex: the starting point and one step along each coordinate, turned back if it
+    // would leave the hypercube.
+    std::copy(x, x + m, v);
+    f[0] = fx;
+    for (decltype(m) i = 0u; i < m; ++i) {
+        double *vi = v + (i + 1u) * m;
+        std::copy(x, x + m, vi);
+        vi[i] = x[i] + step[i];
+        if (vi[i] > 1. || vi[i] < 0.) {
+            vi[i] = x[i] - step[i];
+        }
+        vi[i] = std::min(std::max(vi[i], 0.), 1.);
+    }
+    if (!budget) {
+        return;
+    }
+    const auto n_init = static_cast<vector_double::size_type>(std::min<unsigned long long>(budget, m));
+    eval(v + m, n_init, f + 1);
+    charge(n_init);
+    if (n_init < m) {
+        // The budget does not allow to complete the simplex: the best evaluated vertex is kept.
+        const auto best = static_cast<vector_double::size_type>(std::min_element(f, f + n_init + 1u) - f);
+        if (f[best] < fx) {
+            std::copy(v + best * m, v + (best + 1u) * m, x);
+            fx = f[best];
+        }
+        return;
+    }
+    std::fill(sum, sum + m, 0.);
+    for (decltype(m) i = 0u; i < n_vert; ++i) {
+        for (decltype(m) j = 0u; j < m; ++j) {
+            sum[j] += v[i * m + j];
+        }
+    }
+    vector_double::size_type l = 0u;
+    while (true) {
+        // 2 - Best, worst and second worst vertices, and size of the simplex.
+        vector_double::size_type h = 0u, s = 0u;
+        l = 0u;
+        for (decltype(m) i = 1u; i < n_vert; ++i) {
+            if (f[i] < f[l]) {
+                l = i;
+            }
+            if (f[i] > f[h]) {
+                h = i;
+            }
+        }
+        s = (h == 0u) ? 1u : 0u;
+        for (decltype(m) i = 0u; i < n_vert; ++i) {
+            if (i != h && f[i] > f[s]) {
+                s = i;
+            }
+        }
+        double size = 0.;
+        for (decltype(m) i = 0u; i < n_vert; ++i) {
+            for (decltype(m) j = 0u; j < m; ++j) {
+                size = std::max(size, std::abs(v[i * m + j] - v[l * m + j]));
+            }
+        }
+        on_iter(f[l], size);
+        if (size < tol || !budget) {
+            break;
+        }
+        for (decltype(m) j = 0u; j < m; ++j) {
+            c[j] = (sum[j] - v[h * m + j]) / dm;
+        }
+        const double *xh = v + h * m;
+        // 3 - Candidate points. The speculative batch is used only if the budget can pay for it; when the
+        // budget runs out after the reflection, the reflected point is accepted if it improves on the worst vertex.
+        const bool spec = speculative && budget >= 4u;
+        nm_move(c, xh, -alpha, m, xr);
+        if (spec) {
+            nm_move(c, xr, gamma, m, xe);
+            nm_move(c, xr, rho, m, xoc);
+            nm_move(c, xh, rho, m, xic);
+            eval(xr, 4u, ft);
+            charge(4u);
+        } else {
+            eval(xr, 1u, ft);
+            charge(1u);
+        }
+        const double fr = ft[0];
+        bool shrink = false;
+        if (!spec && !budget) {
+            if (fr < f[h]) {
+                accept(h, xr, fr);
+            }
+        } else if (fr < f[l]) {
+            // Expansion.
+            if (!spec) {
+                nm_move(c, xr, gamma, m, xe);
+                eval(xe, 1u, ft + 1);
+                charge(1u);
+            }
+            if (ft[1] < fr) {
+                accept(h, xe, ft[1]);
+            } else {
+                accept(h, xr, fr);
+            }
+        } else if (fr < f[s]) {
+            accept(h, xr, fr);
+        } else if (fr < f[h]) {
+            // Outside contraction.
+            if (!spec) {
+                nm_move(c, xr, rho, m, xoc);
+                eval(xoc, 1u, ft + 2);
+                charge(1u);
+            }
+            if (ft[2] <= fr) {
+                accept(h, xoc, ft[2]);
+            } else {
+                shrink = true;
+            }
+        } else {
+            // Inside contraction.
+            if (!spec) {
+                nm_move(c, xh, rho, m, xic);
+                eval(xic, 1u, ft + 3);
+                charge(1u);
+            }
+            if (ft[3] < f[h]) {
+                accept(h, xic, ft[3]);
+            } else {
+                shrink = true;
+            }
+        }
+        if (shrink && budget) {
+            // 4 - Shrink towards the best vertex. The best vertex is moved first in the storage, so that
+            // the others can be evaluated in a single contiguous batch. Only the vertices the budget can
+            // pay for are moved, so that every vertex keeps the value of its position.
+            if (l != 0u) {
+                std::swap_ranges(v, v + m, v + l * m);
+                std::swap(f[0], f[l]);
+            }
+            const auto n_shrink = static_cast<vector_double::size_type>(std::min<unsigned long long>(budget, m));
+            for (decltype(m) i = 1u; i <= n_shrink; ++i) {
+                nm_move(v, v + i * m, sigma, m, v + i * m);
+            }
+            eval(v + m, n_shrink, f + 1);
+            charge(n_shrink);
+            std::fill(sum, sum + m, 0.);
+            for (decltype(m) i = 0u; i < n_vert; ++i) {
+                for (decltype(m) j = 0u; j < m; ++j) {
+                    sum[j] += v[i * m + j];
+                }
+            }
+        }
+    }
+    if (f[l] < fx) {
+        std::copy(v + l * m, v + (l + 1u) * m, x);
+        fx = f[l];
+    }
+}
+
+// Evaluates batches of points of a subspace of the unit hypercube on a problem. Each point is completed
+// with the coordinates of a base point, mapped to the box bounds and evaluated. With more than one worker,
+// the points of a batch are spread among copies of the problem evaluated concurrently.
+class nm_evaluator
+{
+public:
+    nm_evaluator(const problem &prob, const vector_double &lb, const vector_double &ub, unsigned n_workers)
+        : m_prob(prob), m_lb(lb), m_ub(ub), m_base(lb.size()), m_idx(), m_copies(n_workers - 1u, prob),
+          m_x(n_workers, vector_double(lb.size())), m_fevals(0u), m_fevals0(prob.get_fevals())
+    {
+    }
+    // The number of concurrent evaluations to use for a problem: one, unless speculative evaluations are
+    // requested and the problem can be copied and evaluated in parallel. A batch holds at most 4 speculative
+    // points or the dim shrunk vertices, so that more workers would only cost problem copies.
+    static unsigned n_workers(const problem &prob, bool speculative)
+    {
+        if (!speculative || prob.get_thread_safety() < thread_safety::basic) {
+            return 1u;
+        }
+        const auto max_batch = std::max(vector_double::size_type(4u), prob.get_nx());
+        return static_cast<unsigned>(std::min(
+            static_cast<vector_double::size_type>(std::max(1u, std::thread::hardware_concurrency())), max_batch));
+    }
+    // The point of the unit hypercube whose coordinates outside the subspace are used.
+    vector_double &base()
+    {
+        return m_base;
+    }
+    // The coordinates spanned by the subspace.
+    std::vector<vector_double::size_type> &idx()
+    {
+        return m_idx;
+    }
+    void operator()(const double *pts, vector_double::size_type k, double *out)
+    {
+        const auto n_workers = std::min(static_cast<vector_double::size_type>(m_x.size()), k);
+        if (n_workers <= 1u) {
+            for (decltype(k) i = 0u; i < k; ++i) {
+                out[i] = eval_one(m_prob, m_x[0], pts + i * m_idx.size());
+            }
+            m_fevals += k;
+            return;
+        }
+        // The worker w evaluates the points w, w + n_workers, ...
+        auto work = [this, pts, k, out, n_workers](vector_double::size_type w) {
+            const problem &p = w ? m_copies[w - 1u] : m_prob;
+            for (auto i = w; i < k; i += n_workers) {
+                out[i] = eval_one(p, m_x[w], pts + i * m_idx.size());
+            }
+        };
+        std::vector<std::future<void>> futures;
+        for (decltype(k) w = 1u; w < n_workers; ++w) {
+            futures.push_back(std::async(std::launch::async, work, w));
+        }
+        work(0u);
+        // All the futures are waited for before an exception can escape.
+        for (auto &fut : futures) {
+            fut.wait();
+        }
+        for (auto &fut : futures) {
+            fut.get();
+        }
+        m_fevals += k;
+    }
+    // The number of evaluations made so far.
+    unsigned long long get_fevals() const
+    {
+        return m_fevals;
+    }
+    // Credits to the problem the evaluations made on its copies. It can be called several times.
+    void sync_fevals()
+    {
+        for (const auto &p : m_copies) {
+            detail::problem_counters::increment_fevals(m_prob, p.get_fevals() - m_fevals0);
+            detail::problem_counters::set_fevals(p, m_fevals0);
+        }
+    }
+    // The point of the search space corresponding to a point of the unit hypercube.
+    vector_double to_x(const vector_double &u) const
+    {
+        vector_double x(u.size());
+        for (decltype(u.size()) i = 0u; i < u.size(); ++i) {
+            x[i] = std::min(std::max(m_lb[i] + u[i] * (m_ub[i] - m_lb[i]), m_lb[i]), m_ub[i]);
+        }
+        return x;
+    }
+
+private:
+    double eval_one(const problem &p, vector_double &x, const double *y) const
+    {
+        for (decltype(x.size()) i = 0u; i < x.size(); ++i) {
+            x[i] = m_base[i];
+        }
+        for (decltype(m_idx.size()) j = 0u; j < m_idx.size(); ++j) {
+            x[m_idx[j]] = y[j];
+        }
+        for (decltype(x.size()) i = 0u; i < x.size(); ++i) {
+            x[i] = std::min(std::max(m_lb[i] + x[i] * (m_ub[i] - m_lb[i]), m_lb[i]), m_ub[i]);
+        }
+        return p.fitness(x)[0];
+    }
+    const problem &m_prob;
+    const vector_double &m_lb;
+    const vector_double &m_ub;
+    vector_double m_base;
+    std::vector<vector_double::size_type> m_idx;
+    std::vector<problem> m_copies;
+    std::vector<vector_double> m_x;
+    unsigned long long m_fevals;
+    unsigned long long m_fevals0;
+};
+
+// Credits to the problem the evaluations made on the copies of an nm_evaluator when leaving the scope,
+// also if an evaluation throws.
+struct nm_fevals_guard {
+    ~nm_fevals_guard()
+    {
+        m_eval.sync_fevals();
+    }
+    nm_evaluator &m_eval;
+};
+}
+}
+
+#endif
@@ -0,0 +1,160 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_DETAIL_RADIX_SORT_HPP
+#define PAGMO_DETAIL_RADIX_SORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "../types.hpp"
+#include "custom_comparisons.hpp"
+
+namespace pagmo
+{
+namespace detail
+{
+
+// Size from which sort_by_key() switches from std::sort to the radix sort.
+constexpr std::size_t radix_sort_threshold = 1024u;
+
+// The radix sort works on the bit patterns of IEEE 754 doubles.
+constexpr bool radix_sort_enabled
+    = std::numeric_limits<double>::is_iec559 && sizeof(double) == sizeof(std::uint64_t);
+
+// Maps a double to an unsigned integer so that the order of the integers is the order of less_than_f(): -0. and
+// 0. have the same key, and all the NaNs have the same key, greater than the one of +inf.
+inline std::uint64_t radix_key(double x)
+{
+    if (std::isnan(x)) {
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    if (x == 0.) {
+        x = 0.;
+    }
+    std::uint64_t u;
+    std::memcpy(&u, &x, sizeof(u));
+    const auto sign = std::uint64_t(1u) << 63;
+    // Negative numbers are ordered backwards by their bit patterns.
+    return (u & sign) ? ~u : (u | sign);
+}
+
+// The permutation that sorts keys in ascending order, according to less_than_f(): the element at position i in
+// the sorted sequence is keys[perm[i]]. The sort is stable and takes linear time: it is an LSD radix sort on the
+// bytes of the radix_key() of the keys, skipping the bytes which are the same for all the keys (e.g., the
+// exponent bytes when the keys have similar magnitudes).
+inline std::vector<std::size_t> radix_sort_permutation(const vector_double &keys)
+{
+    const auto n = keys.size();
+    std::vector<std::pair<std::uint64_t, std::size_t>> a(n), b(n);
+    // The histograms of all the bytes are computed in a single pass.
+    std::array<std::array<std::size_t, 256>, 8> counts{};
+    for (decltype(keys.size()) i = 0u; i < n; ++i) {
+        a[i] = std::make_pair(radix_key(keys[i]), i);
+        for (unsigned d = 0u; d < 8u; ++d) {
+            ++counts[d][(a[i].first >> (8u * d)) & 255u];
+        }
+    }
+    for (unsigned d = 0u; d < 8u && n; ++d) {
+        auto &count = counts[d];
+        if (count[(a[0].first >> (8u * d)) & 255u] == n) {
+            continue;
+        }
+        std::size_t offset = 0u;
+        for (auto &c : count) {
+            const auto tmp = c;
+            c = offset;
+            offset += tmp;
+        }
+        for (const auto &p : a) {
+            b[count[(p.first >> (8u * d)) & 255u]++] = p;
+        }
+        a.swap(b);
+    }
+    std::vector<std::size_t> retval(n);
+    for (decltype(keys.size()) i = 0u; i < n; ++i) {
+        retval[i] = a[i].second;
+    }
+    return retval;
+}
+
+// Stable sort of the range [first, last) in ascending order of key(element), with the ordering of less_than_f(),
+// via radix_sort_permutation(). The elements are moved, not copied.
+template <typename It, typename F>
+inline void radix_sort_by_key(It first, It last, const F &key)
+{
+    using value_type = typename std::iterator_traits<It>::value_type;
+    if (!radix_sort_enabled) {
+        std::stable_sort(first, last, [&key](const value_type &a, const value_type &b) {
+            return less_than_f(static_cast<double>(key(a)), static_cast<double>(key(b)));
+        });
+        return;
+    }
+    const auto n = static_cast<std::size_t>(std::distance(first, last));
+    vector_double keys(n);
+    auto it = first;
+    for (std::size_t i = 0u; i < n; ++i, ++it) {
+        keys[i] = key(*it);
+    }
+    const auto perm = radix_sort_permutation(keys);
+    std::vector<value_type> tmp;
+    tmp.reserve(n);
+    for (auto i : perm) {
+        tmp.push_back(std::move(*std::next(first, static_cast<std::ptrdiff_t>(i))));
+    }
+    std::move(tmp.begin(), tmp.end(), first);
+}
+
+// Sort of the range [first, last) in ascending order of key(element), with the ordering of less_than_f(). Small
+// ranges are sorted by std::sort, large ones by radix_sort_by_key(). As with std::sort, the relative order of
+// elements with equivalent keys is unspecified.
+template <typename It, typename F>
+inline void sort_by_key(It first, It last, const F &key)
+{
+    using value_type = typename std::iterator_traits<It>::value_type;
+    if (static_cast<std::size_t>(std::distance(first, last)) >= radix_sort_threshold) {
+        radix_sort_by_key(first, last, key);
+    } else {
+        std::sort(first, last, [&key](const value_type &a, const value_type &b) {
+            return less_than_f(static_cast<double>(key(a)), static_cast<double>(key(b)));
+        });
+    }
+}
+
+} // namespace detail
+} // namespace pagmo
+
+#endif
@@ -0,0 +1,58 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_DETAIL_SEPARATE_COMPILATION_HPP
+#define PAGMO_DETAIL_SEPARATE_COMPILATION_HPP
+
+// pagmo is header-only by default. Optionally (PAGMO_BUILD_LIBRARY in CMake), the heavy non-template parts
+// are compiled once into the pagmo_compiled library, whose consumers are built with PAGMO_SEPARATE_COMPILATION
+// defined: they see only the declarations of those parts, and link to their definitions in the library.
+//
+// - PAGMO_DECL marks the functions provided by the library: they are inline in header-only mode, and ordinary
+//   functions with external linkage otherwise.
+// - PAGMO_HEADER_DEFINITIONS is defined if the definitions of those functions (and data) must be visible in the
+//   current translation unit.
+// - PAGMO_HEADER_REGISTRATIONS is defined if the UDPs and UDAs shipped with pagmo must be registered for
+//   serialization in the current translation unit.
+//
+// Both are defined in header-only mode. With separate compilation, each source of the library defines the one it
+// is responsible for before including any pagmo header, so that everything is compiled exactly once.
+
+#if defined(PAGMO_SEPARATE_COMPILATION)
+
+#define PAGMO_DECL
+
+#else
+
+#define PAGMO_DECL inline
+#define PAGMO_HEADER_DEFINITIONS
+#define PAGMO_HEADER_REGISTRATIONS
+
+#endif
+
+#endif
@@ -0,0 +1,166 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_EVAL_CONTEXT_HPP
+#define PAGMO_EVAL_CONTEXT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <utility>
+
+#include "exceptions.hpp"
+
+namespace pagmo
+{
+
+/// Cancellation token.
+/**
+ * A cancellation token is a flag shared among all its copies: once any of the copies is cancelled via
+ * cancellation_token::cancel(), all of them report to be cancelled. Tokens are used to ask a running evaluation
+ * to stop early (see pagmo::eval_context). All the methods of this class are thread-safe.
+ */
+class cancellation_token
+{
+public:
+    /// Default constructor.
+    /**
+     * Constructs a new, not cancelled, token.
+     *
+     * @throws std::bad_alloc in case of memory allocation errors.
+     */
+    cancellation_token() : m_flag(std::make_shared<std::atomic<bool>>(false))
+    {
+    }
+    /// Cancel.
+    /**
+     * Marks \p this and all its copies as cancelled.
+     */
+    void cancel() const
+    {
+        m_flag->store(true);
+    }
+    /// Check for cancellation.
+    /**
+     * @return \p true if \p this or any of its copies has been cancelled, \p false otherwise.
+     */
+    bool is_cancelled() const
+    {
+        return m_flag->load();
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_flag;
+};
+
+/// Evaluation context.
+/**
+ * An evaluation context carries a deadline and a pagmo::cancellation_token. It is passed to the fitness function
+ * of user-defined problems that accept it (see pagmo::has_context_fitness), which can poll it during long
+ * evaluations and give up early by calling eval_context::check() (or by throwing pagmo::eval_cancelled_error
+ * themselves) when the evaluation is no longer wanted.
+ *
+ * All the methods of this class are thread-safe.
+ */
+class eval_context
+{
+public:
+    /// The clock used for the deadlines.
+    using clock = std::chrono::steady_clock;
+    /// Default constructor.
+    /**
+     * Constructs a context without deadline and with a new cancellation token.
+     *
+     * @throws std::bad_alloc in case of memory allocation errors.
+     */
+    eval_context() : m_deadline(clock::time_point::max())
+    {
+    }
+    /// Constructor from deadline.
+    /**
+     * @param deadline the point in time after which the evaluation is no longer wanted.
+     * @param token the cancellation token.
+     */
+    explicit eval_context(clock::time_point deadline, cancellation_token token = cancellation_token{})
+        : m_deadline(deadline), m_token(std::move(token))
+    {
+    }
+    /// Constructor from timeout.
+    /**
+     * @param timeout the time, from now, after which the evaluation is no longer wanted.
+     * @param token the cancellation token.
+     */
+    explicit eval_context(clock::duration timeout, cancellation_token token = cancellation_token{})
+        : eval_context(clock::now() + timeout, std::move(token))
+    {
+    }
+    /// Get the deadline.
+    /**
+     * @return the deadline of \p this (<tt>clock::time_point::max()</tt> if there is no deadline).
+     */
+    clock::time_point get_deadline() const
+    {
+        return m_deadline;
+    }
+    /// Get the cancellation token.
+    /**
+     * @return a const reference to the cancellation token of \p this.
+     */
+    const cancellation_token &get_token() const
+    {
+        return m_token;
+    }
+    /// Check whether the evaluation is still wanted.
+    /**
+     * @return \p true if the cancellation token has been cancelled or the deadline has passed, \p false otherwise.
+     */
+    bool is_cancelled() const
+    {
+        return m_token.is_cancelled() || clock::now() >= m_deadline;
+    }
+    /// Throw if the evaluation is no longer wanted.
+    /**
+     * This is a convenience method for cooperative user-defined problems, to be called at the points of the
+     * evaluation where it is safe to stop.
+     *
+     * @throws pagmo::eval_cancelled_error if eval_context::is_cancelled() returns \p true.
+     */
+    void check() const
+    {
+        if (is_cancelled()) {
+            pagmo_throw(eval_cancelled_error, "The evaluation was cancelled or its deadline has passed");
+        }
+    }
+
+private:
+    clock::time_point m_deadline;
+    cancellation_token m_token;
+};
+}
+
+#endif
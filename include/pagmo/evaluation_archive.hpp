@@ -0,0 +1,402 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_EVALUATION_ARCHIVE_HPP
+#define PAGMO_EVALUATION_ARCHIVE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "exceptions.hpp"
+#include "population.hpp"
+#include "problem.hpp"
+#include "rng.hpp"
+#include "serialization.hpp"
+#include "types.hpp"
+#include "utils/constrained.hpp"
+#include "utils/multi_objective.hpp"
+
+namespace pagmo
+{
+
+/// Evaluation archive.
+/**
+ * An evaluation archive is a collection of decision vectors together with their fitness vectors, typically gathered
+ * from previous optimisation runs (e.g., by appending the final populations via evaluation_archive::push_back()).
+ * All the decision vectors in the archive have the same size, and so do all the fitness vectors.
+ *
+ * Archives are serializable, so that they can be stored on disk and reloaded in later sessions, and they can be used
+ * to warm-start new populations via pagmo::warm_start_population(), without paying again for the evaluations
+ * they contain.
+ */
+class evaluation_archive
+{
+public:
+    /// The size type of the archive.
+    using size_type = std::vector<vector_double>::size_type;
+    /// Add a decision vector and its fitness.
+    /**
+     * In case of exceptions, the archive will not be altered.
+     *
+     * @param x the decision vector.
+     * @param f the fitness of \p x.
+     *
+     * @throws std::invalid_argument if \p x or \p f are empty, or if their sizes differ from those of the vectors
+     * already in the archive.
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    void push_back(const vector_double &x, const vector_double &f)
+    {
+        check_entry(x, f);
+        auto x_copy(x);
+        auto f_copy(f);
+        m_x.push_back(std::move(x_copy));
+        try {
+            m_f.push_back(std::move(f_copy));
+        } catch (...) {
+            m_x.pop_back();
+            throw;
+        }
+    }
+    /// Add a population.
+    /**
+     * Appends to the archive all the decision vectors of \p pop, together with their fitness vectors.
+     * In case of exceptions, the archive will not be altered.
+     *
+     * @param pop the population to be appended.
+     *
+     * @throws std::invalid_argument if the sizes of the decision and fitness vectors of \p pop differ from those of
+     * the vectors already in the archive.
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    void push_back(const population &pop)
+    {
+        if (!pop.size()) {
+            return;
+        }
+        const auto &xs = pop.get_x();
+        const auto &fs = pop.get_f();
+        check_entry(xs[0], fs[0]);
+        // NOTE: archives can be large, so roll back on failure rather than working on a copy.
+        const auto old_size = m_x.size();
+        try {
+            m_x.insert(m_x.end(), xs.begin(), xs.end());
+            m_f.insert(m_f.end(), fs.begin(), fs.end());
+        } catch (...) {
+            m_x.resize(old_size);
+            m_f.resize(old_size);
+            throw;
+        }
+    }
+    /// Size.
+    /**
+     * @return the number of entries in the archive.
+     */
+    size_type size() const
+    {
+        return m_x.size();
+    }
+    /// Decision vectors.
+    /**
+     * @return a const reference to the decision vectors in the archive.
+     */
+    const std::vector<vector_double> &get_x() const
+    {
+        return m_x;
+    }
+    /// Fitness vectors.
+    /**
+     * @return a const reference to the fitness vectors in the archive, in the same order as the decision vectors.
+     */
+    const std::vector<vector_double> &get_f() const
+    {
+        return m_f;
+    }
+    /// Clear the archive.
+    void clear()
+    {
+        m_x.clear();
+        m_f.clear();
+    }
+    /// Save to archive.
+    /**
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of standard containers.
+     */
+    template <typename Archive>
+    void save(Archive &ar) const
+    {
+        ar(m_x, m_f);
+    }
+    /// Load from archive.
+    /**
+     * In case of exceptions, \p this will not be altered.
+     *
+     * @param ar source archive.
+     *
+     * @throws std::invalid_argument if the loaded vectors are inconsistent.
+     * @throws unspecified any exception thrown by the deserialization of standard containers.
+     */
+    template <typename Archive>
+    void load(Archive &ar)
+    {
+        std::vector<vector_double> xs, fs;
+        ar(xs, fs);
+        if (xs.size() != fs.size()) {
+            pagmo_throw(std::invalid_argument, "An evaluation archive containing " + std::to_string(xs.size())
+                                                   + " decision vectors and " + std::to_string(fs.size())
+                                                   + " fitness vectors was loaded");
+        }
+        for (decltype(xs.size()) i = 0u; i < xs.size(); ++i) {
+            check_entry(xs[i], fs[i], xs, fs);
+        }
+        m_x = std::move(xs);
+        m_f = std::move(fs);
+    }
+
+private:
+    void check_entry(const vector_double &x, const vector_double &f) const
+    {
+        check_entry(x, f, m_x, m_f);
+    }
+    // Checks an entry against the first one of xs and fs, if any.
+    static void check_entry(const vector_double &x, const vector_double &f, const std::vector<vector_double> &xs,
+                            const std::vector<vector_double> &fs)
+    {
+        if (x.empty() || f.empty()) {
+            pagmo_throw(std::invalid_argument,
+                        "The decision and fitness vectors of an evaluation archive entry cannot be empty");
+        }
+        if (xs.size() && (x.size() != xs[0].size() || f.size() != fs[0].size())) {
+            pagmo_throw(std::invalid_argument,
+                        "An entry with a decision vector of size " + std::to_string(x.size())
+                            + " and a fitness vector of size " + std::to_string(f.size())
+                            + " cannot be added to an evaluation archive whose entries have sizes "
+                            + std::to_string(xs[0].size()) + " and " + std::to_string(fs[0].size()));
+        }
+    }
+
+    std::vector<vector_double> m_x;
+    std::vector<vector_double> m_f;
+};
+
+namespace detail
+{
+
+// Extracts from the candidates (indices into fs) the subset that is not dominated by any other candidate,
+// removing it from candidates. Returns the extracted front.
+inline std::vector<vector_double::size_type> warm_start_peel_front(const std::vector<vector_double> &fs,
+                                                                   std::vector<vector_double::size_type> &candidates)
+{
+    std::vector<vector_double::size_type> front;
+    for (auto idx : candidates) {
+        // If idx is dominated by a member of the front, it cannot dominate any other member (they
+        // would be dominated by the same member by transitivity), so the two loops are exclusive.
+        if (std::any_of(front.begin(), front.end(),
+                        [&fs, idx](vector_double::size_type j) { return pareto_dominance(fs[j], fs[idx]); })) {
+            continue;
+        }
+        front.erase(std::remove_if(front.begin(), front.end(),
+                                   [&fs, idx](vector_double::size_type j) { return pareto_dominance(fs[idx], fs[j]); }),
+                    front.end());
+        front.push_back(idx);
+    }
+    // Remove the front from the candidates, preserving their order.
+    std::vector<char> in_front(fs.size(), 0);
+    for (auto idx : front) {
+        in_front[idx] = 1;
+    }
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                    [&in_front](vector_double::size_type idx) { return in_front[idx] != 0; }),
+                     candidates.end());
+    // Within the front, prefer the least crowded points.
+    if (front.size() > 2u) {
+        std::vector<vector_double> front_f;
+        front_f.reserve(front.size());
+        for (auto idx : front) {
+            front_f.push_back(fs[idx]);
+        }
+        const auto crowding = crowding_distance(front_f);
+        std::vector<vector_double::size_type> order(front.size());
+        for (decltype(order.size()) i = 0u; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&crowding](vector_double::size_type a,
+                                                                 vector_double::size_type b) {
+            return crowding[a] > crowding[b];
+        });
+        std::vector<vector_double::size_type> sorted_front(front.size());
+        for (decltype(order.size()) i = 0u; i < order.size(); ++i) {
+            sorted_front[i] = front[order[i]];
+        }
+        front = std::move(sorted_front);
+    }
+    return front;
+}
+
+} // namespace detail
+
+/// Warm-start a population from an evaluation archive.
+/**
+ * Constructs a population of \p pop_size individuals for the problem \p prob (either a pagmo::problem or a
+ * user-defined problem), seeding it with a diverse elite subset of the entries of \p archive:
+ *
+ * 1. the entries whose decision and fitness vectors do not match the dimensions of the problem, whose decision
+ *    vector lies outside the problem bounds, or whose fitness contains NaNs, are discarded;
+ * 2. the remaining entries are ranked by their stored fitness: single-objective problems use the ordering of
+ *    pagmo::sort_population_con() (with the constraint tolerances of the problem), multi-objective problems use the
+ *    non-domination rank and, within the same front, the crowding distance (only the fronts actually needed are
+ *    computed, so that large archives can be processed);
+ * 3. the ranked entries are visited in order, and an entry is accepted only if its Euclidean distance from all the
+ *    entries already accepted is at least \p min_distance, where each component of the decision vector is scaled by
+ *    the width of the corresponding (finite, nonzero) problem bounds. The default value of zero accepts all entries,
+ *    including duplicates;
+ * 4. if fewer than \p pop_size entries are accepted, the population is completed with random decision vectors,
+ *    which are evaluated.
+ *
+ * If \p reuse_fitness is \p true, the accepted entries are inserted with their stored fitness and do not increase
+ * the fitness evaluation counter of the problem. Otherwise they are evaluated again, which is appropriate when the
+ * archive comes from a similar, but not identical, problem.
+ *
+ * The cost of the ranking is \f$ O(N \log N) \f$ for single-objective problems and, in the worst case,
+ * \f$ O(MN^2) \f$ for multi-objective problems, where \f$N\f$ is the size of the archive and \f$M\f$ the number of
+ * objectives.
+ *
+ * @param prob the problem the population refers to.
+ * @param archive the archive of previous evaluations.
+ * @param pop_size the population size.
+ * @param min_distance the minimum normalised distance between two seeded individuals.
+ * @param reuse_fitness whether to reuse the fitness vectors stored in \p archive.
+ * @param seed the seed of the population.
+ *
+ * @return the warm-started population.
+ *
+ * @throws std::invalid_argument if \p min_distance is negative or not finite, or if the problem is multi-objective
+ * and constrained.
+ * @throws unspecified any exception thrown by the constructor of pagmo::population, by population::push_back(), by
+ * pagmo::sort_population_con() or by pagmo::crowding_distance().
+ */
+template <typename T>
+population warm_start_population(T &&prob, const evaluation_archive &archive, population::size_type pop_size,
+                                 double min_distance = 0., bool reuse_fitness = true,
+                                 unsigned seed = pagmo::random_device::next())
+{
+    if (!std::isfinite(min_distance) || min_distance < 0.) {
+        pagmo_throw(std::invalid_argument, "The minimum distance for warm-starting a population must be finite and "
+                                           "non-negative, but a value of "
+                                               + std::to_string(min_distance) + " was provided");
+    }
+    population pop{std::forward<T>(prob), 0u, seed};
+    const auto &p = pop.get_problem();
+    if (p.get_nobj() > 1u && p.get_nc() > 0u) {
+        pagmo_throw(std::invalid_argument, "Warm-starting a population is not supported for constrained "
+                                           "multi-objective problems, such as "
+                                               + p.get_name());
+    }
+    const auto &xs = archive.get_x();
+    const auto &fs = archive.get_f();
+    const auto &lb = p.get_lb();
+    const auto &ub = p.get_ub();
+    const auto nx = p.get_nx();
+    // 1 - Discard the entries that do not fit the problem.
+    std::vector<vector_double::size_type> candidates;
+    if (archive.size() && xs[0].size() == nx && fs[0].size() == p.get_nf()) {
+        for (decltype(xs.size()) i = 0u; i < xs.size(); ++i) {
+            bool fits = std::none_of(fs[i].begin(), fs[i].end(), [](double v) { return std::isnan(v); });
+            for (decltype(xs[i].size()) j = 0u; j < nx && fits; ++j) {
+                fits = xs[i][j] >= lb[j] && xs[i][j] <= ub[j];
+            }
+            if (fits) {
+                candidates.push_back(i);
+            }
+        }
+    }
+    // 2 and 3 - Visit the candidates in rank order and thin them out.
+    vector_double scale(nx);
+    for (decltype(scale.size()) j = 0u; j < nx; ++j) {
+        const auto w = ub[j] - lb[j];
+        scale[j] = (std::isfinite(w) && w > 0.) ? 1. / w : 1.;
+    }
+    const auto min_d2 = min_distance * min_distance;
+    std::vector<vector_double::size_type> accepted;
+    auto visit = [&](vector_double::size_type idx) {
+        const auto &x = xs[idx];
+        for (auto a : accepted) {
+            double d2 = 0.;
+            for (decltype(x.size()) j = 0u; j < nx; ++j) {
+                const auto d = (x[j] - xs[a][j]) * scale[j];
+                d2 += d * d;
+            }
+            if (d2 < min_d2) {
+                return;
+            }
+        }
+        accepted.push_back(idx);
+    };
+    if (pop_size) {
+        if (p.get_nobj() == 1u) {
+            std::vector<vector_double> cand_f;
+            cand_f.reserve(candidates.size());
+            for (auto idx : candidates) {
+                cand_f.push_back(fs[idx]);
+            }
+            const auto order = sort_population_con(cand_f, p.get_nec(), p.get_c_tol());
+            for (decltype(order.size()) i = 0u; i < order.size() && accepted.size() < pop_size; ++i) {
+                visit(candidates[order[i]]);
+            }
+        } else {
+            while (!candidates.empty() && accepted.size() < pop_size) {
+                const auto front = detail::warm_start_peel_front(fs, candidates);
+                for (decltype(front.size()) i = 0u; i < front.size() && accepted.size() < pop_size; ++i) {
+                    visit(front[i]);
+                }
+            }
+        }
+    }
+    // 4 - Fill the population.
+    for (auto idx : accepted) {
+        if (reuse_fitness) {
+            pop.push_back(xs[idx], fs[idx]);
+        } else {
+            pop.push_back(xs[idx]);
+        }
+    }
+    while (pop.size() < pop_size) {
+        pop.push_back(pop.random_decision_vector());
+    }
+    return pop;
+}
+
+} // namespace pagmo
+
+#endif
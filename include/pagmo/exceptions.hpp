@@ -129,6 +129,16 @@ namespace pagmo
 struct not_implemented_error final : std::runtime_error {
     using std::runtime_error::runtime_error;
 };
+
+/// Exception for evaluations which have been cancelled.
+/**
+ * This exception is used by pagmo::problem and by cooperative user-defined problems to signal that an
+ * evaluation was abandoned because its pagmo::eval_context expired (see problem::fitness(const vector_double &,
+ * const eval_context &)). This class inherits the constructors from \p std::runtime_error.
+ */
+struct eval_cancelled_error final : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
 }
 
 #endif
@@ -70,8 +70,10 @@ inline void stream_impl(std::ostream &os, thread_safety ts)
 {
     if (ts == thread_safety::none) {
         os << "none";
-    } else {
+    } else if (ts == thread_safety::basic) {
         os << "basic";
+    } else {
+        os << "constant";
     }
 }
 
@@ -0,0 +1,486 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_MPI_HPP
+#define PAGMO_MPI_HPP
+
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "algorithm.hpp"
+#include "exceptions.hpp"
+#include "population.hpp"
+#include "problem.hpp"
+#include "serialization.hpp"
+#include "types.hpp"
+#include "utils/constrained.hpp"
+#include "utils/multi_objective.hpp"
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// Throws if an MPI call failed.
+inline void mpi_check(int ret, const char *name)
+{
+    if (ret != MPI_SUCCESS) {
+        pagmo_throw(std::runtime_error, "The MPI call " + std::string(name) + " failed with error code "
+                                            + std::to_string(ret));
+    }
+}
+
+// Converts a count to int, the type used for the counts in the MPI API.
+template <typename T>
+inline int mpi_int(T n)
+{
+    if (n > static_cast<T>(std::numeric_limits<int>::max())) {
+        pagmo_throw(std::overflow_error, "The count " + std::to_string(n) + " is too large for MPI");
+    }
+    return static_cast<int>(n);
+}
+
+// Objects are moved between ranks as cereal binary archives.
+template <typename T>
+inline std::string mpi_to_bytes(const T &x)
+{
+    std::ostringstream oss;
+    {
+        cereal::BinaryOutputArchive oarchive(oss);
+        oarchive(x);
+    }
+    return oss.str();
+}
+
+template <typename T>
+inline void mpi_from_bytes(const char *data, std::size_t size, T &x)
+{
+    std::istringstream iss(std::string(data, size));
+    cereal::BinaryInputArchive iarchive(iss);
+    iarchive(x);
+}
+
+// Runs f on all the ranks of comm and, if it throws on any of them, throws on all of them: this prevents
+// the ranks which did not fail from waiting forever in the following collective operations.
+template <typename F>
+inline void mpi_collective_guard(MPI_Comm comm, F &&f)
+{
+    std::exception_ptr eptr;
+    try {
+        f();
+    } catch (...) {
+        eptr = std::current_exception();
+    }
+    int local_failed = eptr ? 1 : 0, failed = 0;
+    mpi_check(MPI_Allreduce(&local_failed, &failed, 1, MPI_INT, MPI_MAX, comm), "MPI_Allreduce");
+    if (eptr) {
+        std::rethrow_exception(eptr);
+    }
+    if (failed) {
+        pagmo_throw(std::runtime_error, "An error occurred on another MPI rank");
+    }
+}
+
+// Indices of the individuals with fitness vectors f, from the best to the worst.
+inline std::vector<vector_double::size_type> mpi_rank_individuals(const std::vector<vector_double> &f,
+                                                                  const problem &prob)
+{
+    if (prob.get_nobj() == 1u) {
+        return sort_population_con(f, prob.get_nec(), prob.get_c_tol());
+    }
+    return sort_population_mo(f);
+}
+}
+
+/// Distributed batch fitness evaluation.
+/**
+ * This function computes, with the problem \p p, the fitness of the decision vectors in \p xs, distributing the
+ * evaluations across the ranks of the communicator \p comm. It is the distributed counterpart of a loop calling
+ * problem::fitness() on each decision vector.
+ *
+ * This is a collective operation, which must be called by all the ranks of \p comm, each holding its own copy of
+ * the same problem. Only the decision vectors of the rank \p root are considered: they are split evenly among the
+ * ranks and scattered, each rank evaluates its share, and the fitness vectors are gathered back on \p root. All the
+ * fitness evaluations are counted only on \p root, the rank which returns the result: the evaluations performed on
+ * the other ranks are added to the evaluation counter of \p p on \p root, and the evaluation counter of \p p on the
+ * other ranks is left unchanged.
+ *
+ * @param p the problem.
+ * @param xs the decision vectors, concatenated one after the other (on \p root, ignored on the other ranks).
+ * @param comm the communicator.
+ * @param root the rank holding the decision vectors and receiving the fitness vectors.
+ *
+ * @return the fitness vectors, concatenated one after the other, on \p root, and an empty vector on the other ranks.
+ *
+ * @throws std::invalid_argument if, on \p root, the size of \p xs is not a multiple of the problem dimension.
+ * @throws std::runtime_error if an MPI call fails, or (on all the ranks) if an error occurred on any rank.
+ * @throws std::overflow_error if the counts exceed the range of the MPI API.
+ * @throws unspecified any exception thrown by problem::fitness(), on the rank where it was raised.
+ */
+inline vector_double mpi_batch_fitness(const problem &p, const vector_double &xs, MPI_Comm comm = MPI_COMM_WORLD,
+                                       int root = 0)
+{
+    int rank, size;
+    detail::mpi_check(MPI_Comm_rank(comm, &rank), "MPI_Comm_rank");
+    detail::mpi_check(MPI_Comm_size(comm, &size), "MPI_Comm_size");
+    const auto nx = p.get_nx(), nf = p.get_nf();
+    // 1 - The number of decision vectors is broadcast from root.
+    unsigned long long n = 0u;
+    detail::mpi_collective_guard(comm, [&]() {
+        if (rank == root) {
+            if (xs.size() % nx) {
+                pagmo_throw(std::invalid_argument, "The size of the batch of decision vectors ("
+                                                       + std::to_string(xs.size())
+                                                       + ") is not a multiple of the problem dimension ("
+                                                       + std::to_string(nx) + ")");
+            }
+            n = xs.size() / nx;
+        }
+    });
+    detail::mpi_check(MPI_Bcast(&n, 1, MPI_UNSIGNED_LONG_LONG, root, comm), "MPI_Bcast");
+    // 2 - The decision vectors are split evenly among the ranks.
+    std::vector<int> x_counts(static_cast<std::vector<int>::size_type>(size)), x_displs(x_counts.size()),
+        f_counts(x_counts.size()), f_displs(x_counts.size());
+    detail::mpi_collective_guard(comm, [&]() {
+        unsigned long long begin = 0u;
+        for (int r = 0; r < size; ++r) {
+            const auto ur = static_cast<unsigned long long>(r), usize = static_cast<unsigned long long>(size);
+            const auto chunk = n / usize + (ur < n % usize ? 1u : 0u);
+            const auto i = static_cast<std::vector<int>::size_type>(r);
+            x_counts[i] = detail::mpi_int(chunk * nx);
+            x_displs[i] = detail::mpi_int(begin * nx);
+            f_counts[i] = detail::mpi_int(chunk * nf);
+            f_displs[i] = detail::mpi_int(begin * nf);
+            begin += chunk;
+        }
+    });
+    const auto me = static_cast<std::vector<int>::size_type>(rank);
+    vector_double local_xs(static_cast<vector_double::size_type>(x_counts[me]));
+    detail::mpi_check(MPI_Scatterv(rank == root ? xs.data() : nullptr, x_counts.data(), x_displs.data(), MPI_DOUBLE,
+                                   local_xs.data(), x_counts[me], MPI_DOUBLE, root, comm),
+                      "MPI_Scatterv");
+    // 3 - Local evaluations. They are counted only on root (see below): on the other ranks, the evaluation counter
+    // of p is restored afterwards, also if an evaluation fails.
+    vector_double local_fs;
+    const auto fevals0 = p.get_fevals();
+    auto restore_fevals = [&]() {
+        if (rank != root) {
+            detail::problem_counters::set_fevals(p, fevals0);
+        }
+    };
+    try {
+        detail::mpi_collective_guard(comm, [&]() {
+            local_fs.reserve(static_cast<vector_double::size_type>(f_counts[me]));
+            vector_double x(nx);
+            for (decltype(local_xs.size()) i = 0u; i < local_xs.size(); i += nx) {
+                std::copy(local_xs.begin() + static_cast<vector_double::difference_type>(i),
+                          local_xs.begin() + static_cast<vector_double::difference_type>(i + nx), x.begin());
+                const auto f = p.fitness(x);
+                local_fs.insert(local_fs.end(), f.begin(), f.end());
+            }
+        });
+    } catch (...) {
+        restore_fevals();
+        throw;
+    }
+    restore_fevals();
+    // 4 - The fitness vectors are gathered on root.
+    vector_double retval(rank == root ? static_cast<vector_double::size_type>(n * nf) : 0u);
+    detail::mpi_check(MPI_Gatherv(local_fs.data(), f_counts[me], MPI_DOUBLE, retval.data(), f_counts.data(),
+                                  f_displs.data(), MPI_DOUBLE, root, comm),
+                      "MPI_Gatherv");
+    if (rank == root) {
+        detail::problem_counters::increment_fevals(p, n - static_cast<unsigned long long>(x_counts[me]) / nx);
+    }
+    return retval;
+}
+
+/// MPI archipelago.
+/**
+ * This class implements the island model of parallel optimisation on top of MPI: each rank of a communicator
+ * owns one island, i.e., an algorithm and a population, and the islands evolve in parallel, exchanging their
+ * best individuals (the migrants) at the end of each evolution along a ring topology (the rank \f$ r \f$ sends
+ * its migrants to the rank \f$ r + 1 \f$).
+ *
+ * Migrants replace the worst individuals of the receiving population when they are better (single-objective
+ * problems are ranked with pagmo::sort_population_con(), multi-objective ones with pagmo::sort_population_mo()).
+ * Migrants and populations are moved between ranks as cereal binary archives, and thus any user-defined problem
+ * or algorithm involved must be registered for serialization (see, e.g., PAGMO_REGISTER_PROBLEM()). All the ranks
+ * must run the same executable.
+ *
+ * All the methods of this class which involve communication are collective operations, which must be called by all
+ * the ranks of the communicator in the same order. If an exception is raised on one rank during a collective
+ * operation, an exception is raised on all the ranks.
+ */
+class mpi_archipelago
+{
+public:
+    /// Constructor.
+    /**
+     * This is a collective operation.
+     *
+     * @param algo the algorithm of the island of this rank.
+     * @param pop the population of the island of this rank.
+     * @param n_migrants the number of individuals sent to the next island at each migration, which must be the same
+     * on all the ranks.
+     * @param comm the communicator.
+     *
+     * @throws std::invalid_argument if \p n_migrants is larger than the size of \p pop, or (on all the ranks) if
+     * \p n_migrants is not the same on all the ranks.
+     * @throws std::runtime_error if an MPI call fails, or if an error occurred on another rank.
+     */
+    mpi_archipelago(const algorithm &algo, const population &pop, population::size_type n_migrants = 1u,
+                    MPI_Comm comm = MPI_COMM_WORLD)
+        : m_algo(algo), m_pop(pop), m_n_migrants(n_migrants), m_comm(comm), m_n_migrations(0u)
+    {
+        detail::mpi_check(MPI_Comm_rank(m_comm, &m_rank), "MPI_Comm_rank");
+        detail::mpi_check(MPI_Comm_size(m_comm, &m_size), "MPI_Comm_size");
+        detail::mpi_collective_guard(m_comm, [this]() {
+            if (m_n_migrants > m_pop.size()) {
+                pagmo_throw(std::invalid_argument, "The number of migrants (" + std::to_string(m_n_migrants)
+                                                       + ") cannot be larger than the population size ("
+                                                       + std::to_string(m_pop.size()) + ")");
+            }
+        });
+        // The sizes of the migrant archives are exchanged at each migration, but the ranks must also agree on the
+        // number of migrants: otherwise the migrations would be silently asymmetric.
+        unsigned long long n_local = m_n_migrants, n_min = 0u, n_max = 0u;
+        detail::mpi_check(MPI_Allreduce(&n_local, &n_min, 1, MPI_UNSIGNED_LONG_LONG, MPI_MIN, m_comm),
+                          "MPI_Allreduce");
+        detail::mpi_check(MPI_Allreduce(&n_local, &n_max, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, m_comm),
+                          "MPI_Allreduce");
+        if (n_min != n_max) {
+            pagmo_throw(std::invalid_argument,
+                        "The number of migrants must be the same on all the ranks, but it ranges from "
+                            + std::to_string(n_min) + " to " + std::to_string(n_max));
+        }
+    }
+
+    /// Evolve.
+    /**
+     * This is a collective operation: each island is evolved \p n times with its algorithm and, after each
+     * evolution, the migrants are exchanged along the ring.
+     *
+     * @param n the number of evolutions.
+     *
+     * @throws std::runtime_error if an MPI call fails, or if an error occurred on another rank.
+     * @throws unspecified any exception thrown by algorithm::evolve() or by the serialization of the migrants,
+     * on the rank where it was raised.
+     */
+    void evolve(unsigned n = 1u)
+    {
+        for (unsigned i = 0u; i < n; ++i) {
+            detail::mpi_collective_guard(m_comm, [this]() { m_pop = m_algo.evolve(m_pop); });
+            migrate();
+        }
+    }
+
+    /// Get the population of this rank.
+    /**
+     * @return a const reference to the population of the island of this rank.
+     */
+    const population &get_population() const
+    {
+        return m_pop;
+    }
+    /// Get the algorithm of this rank.
+    /**
+     * @return a const reference to the algorithm of the island of this rank.
+     */
+    const algorithm &get_algorithm() const
+    {
+        return m_algo;
+    }
+    /// Gather the populations.
+    /**
+     * This is a collective operation.
+     *
+     * @param root the rank receiving the populations.
+     *
+     * @return on \p root, the populations of all the islands, ordered by rank; on the other ranks, an empty vector.
+     *
+     * @throws std::runtime_error if an MPI call fails, or if an error occurred on another rank.
+     * @throws std::overflow_error if the size of the serialized populations exceeds the range of the MPI API.
+     * @throws unspecified any exception thrown by the serialization of the populations.
+     */
+    std::vector<population> get_populations(int root = 0) const
+    {
+        std::string bytes;
+        int count = 0;
+        detail::mpi_collective_guard(m_comm, [&]() {
+            bytes = detail::mpi_to_bytes(m_pop);
+            count = detail::mpi_int(bytes.size());
+        });
+        const auto usize = static_cast<std::vector<int>::size_type>(m_size);
+        std::vector<int> counts(m_rank == root ? usize : 0u), displs(counts.size());
+        detail::mpi_check(MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, root, m_comm), "MPI_Gather");
+        std::vector<char> buffer;
+        detail::mpi_collective_guard(m_comm, [&]() {
+            long long total = 0;
+            for (decltype(counts.size()) r = 0u; r < counts.size(); ++r) {
+                displs[r] = detail::mpi_int(total);
+                total += counts[r];
+            }
+            buffer.resize(static_cast<std::vector<char>::size_type>(detail::mpi_int(total)));
+        });
+        detail::mpi_check(MPI_Gatherv(const_cast<char *>(bytes.data()), count, MPI_CHAR, buffer.data(),
+                                      counts.data(), displs.data(), MPI_CHAR, root, m_comm),
+                          "MPI_Gatherv");
+        std::vector<population> retval;
+        detail::mpi_collective_guard(m_comm, [&]() {
+            for (decltype(counts.size()) r = 0u; r < counts.size(); ++r) {
+                retval.emplace_back();
+                detail::mpi_from_bytes(buffer.data() + displs[r], static_cast<std::size_t>(counts[r]), retval.back());
+            }
+        });
+        return retval;
+    }
+
+    /// Number of migrants.
+    /**
+     * @return the number of individuals sent to the next island at each migration.
+     */
+    population::size_type get_n_migrants() const
+    {
+        return m_n_migrants;
+    }
+    /// Number of accepted migrants.
+    /**
+     * @return the number of migrants which replaced individuals in the population of this rank.
+     */
+    unsigned long long get_n_migrations() const
+    {
+        return m_n_migrations;
+    }
+    /// Rank.
+    /**
+     * @return the rank of this process in the communicator.
+     */
+    int get_rank() const
+    {
+        return m_rank;
+    }
+    /// Size.
+    /**
+     * @return the number of ranks (i.e., of islands) in the communicator.
+     */
+    int get_size() const
+    {
+        return m_size;
+    }
+    /// Communicator.
+    /**
+     * @return the communicator.
+     */
+    MPI_Comm get_comm() const
+    {
+        return m_comm;
+    }
+
+private:
+    using migrants_type = std::pair<std::vector<vector_double>, std::vector<vector_double>>;
+
+    void migrate()
+    {
+        if (m_size == 1 || !m_n_migrants) {
+            return;
+        }
+        const int next = (m_rank + 1) % m_size, prev = (m_rank + m_size - 1) % m_size;
+        // 1 - The best individuals are serialized.
+        std::string out_bytes;
+        detail::mpi_collective_guard(m_comm, [this, &out_bytes]() {
+            const auto &f = m_pop.get_f();
+            const auto order = detail::mpi_rank_individuals(f, m_pop.get_problem());
+            migrants_type emigrants;
+            for (population::size_type i = 0u; i < m_n_migrants; ++i) {
+                emigrants.first.push_back(m_pop.get_x()[order[i]]);
+                emigrants.second.push_back(f[order[i]]);
+            }
+            out_bytes = detail::mpi_to_bytes(emigrants);
+            detail::mpi_int(out_bytes.size());
+        });
+        // 2 - The migrants are exchanged along the ring: the sizes first, then the archives.
+        unsigned long long out_size = out_bytes.size(), in_size = 0u;
+        detail::mpi_check(MPI_Sendrecv(&out_size, 1, MPI_UNSIGNED_LONG_LONG, next, 0, &in_size, 1,
+                                       MPI_UNSIGNED_LONG_LONG, prev, 0, m_comm, MPI_STATUS_IGNORE),
+                          "MPI_Sendrecv");
+        std::vector<char> in_bytes(static_cast<std::vector<char>::size_type>(in_size));
+        detail::mpi_check(MPI_Sendrecv(const_cast<char *>(out_bytes.data()), static_cast<int>(out_size), MPI_CHAR,
+                                       next, 1, in_bytes.data(), static_cast<int>(in_size), MPI_CHAR, prev, 1, m_comm,
+                                       MPI_STATUS_IGNORE),
+                          "MPI_Sendrecv");
+        // 3 - The migrants replace the worst individuals, if they are better.
+        detail::mpi_collective_guard(m_comm, [this, &in_bytes]() {
+            migrants_type immigrants;
+            detail::mpi_from_bytes(in_bytes.data(), in_bytes.size(), immigrants);
+            const auto np = m_pop.size();
+            auto all_f = m_pop.get_f();
+            all_f.insert(all_f.end(), immigrants.second.begin(), immigrants.second.end());
+            const auto order = detail::mpi_rank_individuals(all_f, m_pop.get_problem());
+            // Among the best np individuals, the immigrants take the places of the local individuals
+            // which are not.
+            std::vector<char> kept(np, 0);
+            std::vector<population::size_type> accepted;
+            for (population::size_type i = 0u; i < np; ++i) {
+                if (order[i] < np) {
+                    kept[order[i]] = 1;
+                } else {
+                    accepted.push_back(order[i] - np);
+                }
+            }
+            auto it = accepted.begin();
+            for (population::size_type i = 0u; i < np && it != accepted.end(); ++i) {
+                if (!kept[i]) {
+                    m_pop.set_xf(i, immigrants.first[*it], immigrants.second[*it]);
+                    ++it;
+                    ++m_n_migrations;
+                }
+            }
+        });
+    }
+
+    algorithm m_algo;
+    population m_pop;
+    population::size_type m_n_migrants;
+    MPI_Comm m_comm;
+    int m_rank;
+    int m_size;
+    unsigned long long m_n_migrations;
+};
+}
+
+#endif
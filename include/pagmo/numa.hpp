@@ -0,0 +1,274 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_NUMA_HPP
+#define PAGMO_NUMA_HPP
+
+/** \file numa.hpp
+ * \brief NUMA topology and thread placement.
+ *
+ * This header contains utilities to query the NUMA nodes of the machine, to pin threads to the CPUs of a node and
+ * to run code on a given node, so that the memory it allocates is placed on that node by the first-touch policy
+ * of the operating system. The topology is read from sysfs on Linux, without any dependency on libnuma. On other
+ * platforms, the machine is reported as a single node and threads are never pinned.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#endif
+
+#include "exceptions.hpp"
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// Parses a Linux cpulist string (e.g., "0-3,8,10-11") into a sorted list of CPU indices.
+// Returns an empty list if the string is malformed.
+inline std::vector<unsigned> numa_parse_cpulist(const std::string &s)
+{
+    std::vector<unsigned> retval;
+    std::string::size_type pos = 0u;
+    auto read_uint = [&s, &pos](unsigned &out) {
+        if (pos == s.size() || !std::isdigit(static_cast<unsigned char>(s[pos]))) {
+            return false;
+        }
+        out = 0u;
+        while (pos < s.size() && std::isdigit(static_cast<unsigned char>(s[pos]))) {
+            out = out * 10u + static_cast<unsigned>(s[pos] - '0');
+            ++pos;
+        }
+        return true;
+    };
+    while (pos < s.size() && !std::isspace(static_cast<unsigned char>(s[pos]))) {
+        unsigned first, last;
+        if (!read_uint(first)) {
+            return {};
+        }
+        last = first;
+        if (pos < s.size() && s[pos] == '-') {
+            ++pos;
+            if (!read_uint(last) || last < first) {
+                return {};
+            }
+        }
+        for (auto c = first; c <= last; ++c) {
+            retval.push_back(c);
+        }
+        if (pos < s.size() && s[pos] == ',') {
+            ++pos;
+        }
+    }
+    std::sort(retval.begin(), retval.end());
+    retval.erase(std::unique(retval.begin(), retval.end()), retval.end());
+    return retval;
+}
+
+// The NUMA nodes with CPUs, and the CPUs of each of them.
+struct numa_topology_t {
+    std::vector<unsigned> m_nodes;
+    std::vector<std::vector<unsigned>> m_cpus;
+};
+
+inline numa_topology_t numa_read_topology()
+{
+    numa_topology_t retval;
+#if defined(__linux__)
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string line;
+    if (online && std::getline(online, line)) {
+        for (auto node : numa_parse_cpulist(line)) {
+            std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string cpus;
+            if (cpulist && std::getline(cpulist, cpus)) {
+                auto list = numa_parse_cpulist(cpus);
+                // Memory-only nodes have no CPUs to run threads on.
+                if (list.size()) {
+                    retval.m_nodes.push_back(node);
+                    retval.m_cpus.push_back(std::move(list));
+                }
+            }
+        }
+    }
+#endif
+    if (retval.m_nodes.empty()) {
+        // Fall back to a single node containing all the CPUs.
+        retval.m_nodes.push_back(0u);
+        retval.m_cpus.emplace_back();
+        for (unsigned c = 0u; c < std::max(1u, std::thread::hardware_concurrency()); ++c) {
+            retval.m_cpus.back().push_back(c);
+        }
+    }
+    return retval;
+}
+
+// The topology is read once, on first use.
+inline const numa_topology_t &numa_topology()
+{
+    static const numa_topology_t topo = numa_read_topology();
+    return topo;
+}
+
+inline std::vector<unsigned>::size_type numa_node_index(unsigned node)
+{
+    const auto &nodes = numa_topology().m_nodes;
+    const auto it = std::find(nodes.begin(), nodes.end(), node);
+    if (it == nodes.end()) {
+        pagmo_throw(std::invalid_argument, "The NUMA node " + std::to_string(node) + " does not exist or has no CPUs");
+    }
+    return static_cast<std::vector<unsigned>::size_type>(it - nodes.begin());
+}
+}
+
+/// NUMA nodes.
+/**
+ * @return the identifiers of the NUMA nodes of the machine that have CPUs, in ascending order. On platforms
+ * other than Linux, or if the topology cannot be read, a single node with identifier 0 is reported.
+ */
+inline const std::vector<unsigned> &numa_nodes()
+{
+    return detail::numa_topology().m_nodes;
+}
+
+/// CPUs of a NUMA node.
+/**
+ * @param node the identifier of a NUMA node.
+ *
+ * @return the indices of the CPUs of \p node, in ascending order.
+ *
+ * @throws std::invalid_argument if \p node is not one of the nodes returned by pagmo::numa_nodes().
+ */
+inline const std::vector<unsigned> &numa_node_cpus(unsigned node)
+{
+    return detail::numa_topology().m_cpus[detail::numa_node_index(node)];
+}
+
+/// Pin the calling thread to a NUMA node.
+/**
+ * Restricts the calling thread to the CPUs of \p node. With the default memory policy of the operating system,
+ * the memory first written to by the thread from then on is allocated on \p node.
+ *
+ * @param node the identifier of a NUMA node.
+ *
+ * @return \p true if the thread was pinned, \p false if pinning is not supported on this platform or was
+ * refused by the operating system (e.g., because none of the CPUs of \p node is available to the process).
+ *
+ * @throws std::invalid_argument if \p node is not one of the nodes returned by pagmo::numa_nodes().
+ */
+inline bool numa_bind_thread(unsigned node)
+{
+    const auto &cpus = numa_node_cpus(node);
+#if defined(__linux__)
+    ::cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto c : cpus) {
+        if (c < CPU_SETSIZE) {
+            CPU_SET(c, &set);
+        }
+    }
+    return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+/// NUMA node of an address.
+/**
+ * @param ptr an address in memory that has already been written to.
+ *
+ * @return the identifier of the NUMA node on which the page containing \p ptr resides, or -1 if this cannot be
+ * determined (e.g., on platforms other than Linux).
+ */
+inline int numa_node_of(const void *ptr)
+{
+#if defined(__linux__) && defined(SYS_get_mempolicy)
+    // MPOL_F_NODE | MPOL_F_ADDR, from linux/mempolicy.h.
+    const unsigned long flags = 1ul | 2ul;
+    int node = -1;
+    if (::syscall(SYS_get_mempolicy, &node, nullptr, 0ul, ptr, flags) == 0) {
+        return node;
+    }
+#else
+    (void)ptr;
+#endif
+    return -1;
+}
+
+/// Run a function on a NUMA node.
+/**
+ * Invokes \p f in a new thread pinned to \p node (see pagmo::numa_bind_thread()), waits for it to complete and
+ * returns its result. The memory allocated and initialised by \p f, such as the buffers of a pagmo::population
+ * constructed within \p f, is thus placed on \p node, and it stays there when the result is moved out:
+ * @code{.unparsed}
+ * auto pop = pagmo::numa_run_on_node(1, [&prob]() { return pagmo::population{prob, 100u}; });
+ * @endcode
+ *
+ * @param node the identifier of a NUMA node.
+ * @param f the function to be invoked.
+ *
+ * @return the value returned by \p f.
+ *
+ * @throws std::invalid_argument if \p node is not one of the nodes returned by pagmo::numa_nodes().
+ * @throws std::system_error if the thread cannot be started.
+ * @throws unspecified any exception thrown by \p f.
+ */
+template <typename F>
+auto numa_run_on_node(unsigned node, F &&f) -> decltype(std::forward<F>(f)())
+{
+    detail::numa_node_index(node);
+    std::packaged_task<decltype(std::forward<F>(f)())()> task([&f, node]() {
+        numa_bind_thread(node);
+        return std::forward<F>(f)();
+    });
+    auto fut = task.get_future();
+    std::thread th(std::move(task));
+    th.join();
+    return fut.get();
+}
+
+} // namespace pagmo
+
+#endif
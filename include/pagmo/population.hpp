@@ -224,7 +224,7 @@ public:
      */
     vector_double random_decision_vector() const
     {
-        return pagmo::random_decision_vector(m_prob.get_bounds(), m_e);
+        return pagmo::random_decision_vector(m_prob.get_lb(), m_prob.get_ub(), m_e);
     }
 
     /// Index of the best individual (accounting for a vector tolerance)
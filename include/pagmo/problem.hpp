@@ -43,6 +43,8 @@ see https://www.gnu.org/licenses/. */
 #include <utility>
 
 #include "detail/custom_comparisons.hpp"
+#include "detail/separate_compilation.hpp"
+#include "eval_context.hpp"
 #include "exceptions.hpp"
 #include "io.hpp"
 #include "serialization.hpp"
@@ -72,6 +74,14 @@ see https://www.gnu.org/licenses/. */
  */
 #define PAGMO_REGISTER_PROBLEM(prob) CEREAL_REGISTER_TYPE_WITH_NAME(pagmo::detail::prob_inner<prob>, "udp " #prob)
 
+// Registration of the UDPs shipped with pagmo. With separate compilation, they are registered only once, in the
+// pagmo library (see detail/separate_compilation.hpp).
+#if defined(PAGMO_HEADER_REGISTRATIONS)
+#define PAGMO_REGISTER_BUILTIN_PROBLEM(prob) PAGMO_REGISTER_PROBLEM(prob)
+#else
+#define PAGMO_REGISTER_BUILTIN_PROBLEM(prob)
+#endif
+
 namespace pagmo
 {
 
@@ -310,6 +320,108 @@ public:
 template <typename T>
 const bool override_has_gradient<T>::value;
 
+/// Detect multi-fidelity \p fitness() method.
+/**
+ * This type trait will be \p true if \p T provides a method with
+ * the following signature:
+ * @code{.unparsed}
+ * vector_double fitness(const vector_double &, unsigned) const;
+ * @endcode
+ * The multi-fidelity \p fitness() method is part of the interface for the definition of a problem
+ * (see pagmo::problem).
+ */
+template <typename T>
+class has_fidelity_fitness
+{
+    template <typename U>
+    using fidelity_fitness_t = decltype(
+        std::declval<const U &>().fitness(std::declval<const vector_double &>(), std::declval<unsigned>()));
+    static const bool implementation_defined = std::is_same<vector_double, detected_t<fidelity_fitness_t, T>>::value;
+
+public:
+    /// Value of the type trait.
+    static const bool value = implementation_defined;
+};
+
+template <typename T>
+const bool has_fidelity_fitness<T>::value;
+
+/// Detect \p get_fidelity_costs() method.
+/**
+ * This type trait will be \p true if \p T provides a method with
+ * the following signature:
+ * @code{.unparsed}
+ * vector_double get_fidelity_costs() const;
+ * @endcode
+ * The \p get_fidelity_costs() method is part of the interface for the definition of a problem
+ * (see pagmo::problem).
+ */
+template <typename T>
+class has_fidelity_costs
+{
+    template <typename U>
+    using get_fidelity_costs_t = decltype(std::declval<const U &>().get_fidelity_costs());
+    static const bool implementation_defined = std::is_same<vector_double, detected_t<get_fidelity_costs_t, T>>::value;
+
+public:
+    /// Value of the type trait.
+    static const bool value = implementation_defined;
+};
+
+template <typename T>
+const bool has_fidelity_costs<T>::value;
+
+/// Detect context-aware \p fitness() method.
+/**
+ * This type trait will be \p true if \p T provides a method with
+ * the following signature:
+ * @code{.unparsed}
+ * vector_double fitness(const vector_double &, const eval_context &) const;
+ * @endcode
+ * The context-aware \p fitness() method is part of the interface for the definition of a problem
+ * (see pagmo::problem).
+ */
+template <typename T>
+class has_context_fitness
+{
+    template <typename U>
+    using context_fitness_t = decltype(
+        std::declval<const U &>().fitness(std::declval<const vector_double &>(), std::declval<const eval_context &>()));
+    static const bool implementation_defined = std::is_same<vector_double, detected_t<context_fitness_t, T>>::value;
+
+public:
+    /// Value of the type trait.
+    static const bool value = implementation_defined;
+};
+
+template <typename T>
+const bool has_context_fitness<T>::value;
+
+/// Detect \p batch_fitness() method.
+/**
+ * This type trait will be \p true if \p T provides a method with
+ * the following signature:
+ * @code{.unparsed}
+ * vector_double batch_fitness(const vector_double &) const;
+ * @endcode
+ * The \p batch_fitness() method is part of the interface for the definition of a problem
+ * (see pagmo::problem).
+ */
+template <typename T>
+class has_batch_fitness
+{
+    template <typename U>
+    using batch_fitness_t = decltype(std::declval<const U &>().batch_fitness(std::declval<const vector_double &>()));
+    static const bool implementation_defined = std::is_same<vector_double, detected_t<batch_fitness_t, T>>::value;
+
+public:
+    /// Value of the type trait.
+    static const bool value = implementation_defined;
+};
+
+template <typename T>
+const bool has_batch_fitness<T>::value;
+
 /// Detect \p gradient_sparsity() method.
 /**
  * This type trait will be \p true if \p T provides a method with
@@ -466,16 +578,21 @@ const bool override_has_hessians_sparsity<T>::value;
 namespace detail
 {
 
+// A deleter that does nothing, used to wrap shared objects into non-owning std::unique_ptr.
+struct no_delete {
+    void operator()(const void *) const
+    {
+    }
+};
+
 // Helper to check that the problem bounds are valid. This will throw if the bounds
 // are invalid because of:
 // - the bounds size is zero,
 // - inconsistent lengths of the vectors,
 // - nans in the bounds,
 // - lower bounds greater than upper bounds.
-inline void check_problem_bounds(const std::pair<vector_double, vector_double> &bounds)
+inline void check_problem_bounds(const vector_double &lb, const vector_double &ub)
 {
-    const auto &lb = bounds.first;
-    const auto &ub = bounds.second;
     // 0 - Check that the size is at least 1.
     if (lb.size() == 0u) {
         pagmo_throw(std::invalid_argument, "The bounds dimension cannot be zero");
@@ -500,6 +617,11 @@ inline void check_problem_bounds(const std::pair<vector_double, vector_double> &
     }
 }
 
+inline void check_problem_bounds(const std::pair<vector_double, vector_double> &bounds)
+{
+    check_problem_bounds(bounds.first, bounds.second);
+}
+
 // Two helper functions to compute sparsity patterns in the dense case.
 inline std::vector<sparsity_pattern> dense_hessians(vector_double::size_type f_dim, vector_double::size_type dim)
 {
@@ -531,6 +653,13 @@ struct prob_inner_base {
     }
     virtual prob_inner_base *clone() const = 0;
     virtual vector_double fitness(const vector_double &) const = 0;
+    virtual vector_double fidelity_fitness(const vector_double &, unsigned) const = 0;
+    virtual bool has_fidelity() const = 0;
+    virtual vector_double get_fidelity_costs() const = 0;
+    virtual vector_double context_fitness(const vector_double &, const eval_context &) const = 0;
+    virtual bool has_context_fitness() const = 0;
+    virtual vector_double batch_fitness(const vector_double &) const = 0;
+    virtual bool has_batch_fitness() const = 0;
     virtual vector_double gradient(const vector_double &) const = 0;
     virtual bool has_gradient() const = 0;
     virtual sparsity_pattern gradient_sparsity() const = 0;
@@ -596,6 +725,34 @@ struct prob_inner final : prob_inner_base {
     {
         return get_nobj_impl(m_value);
     }
+    virtual vector_double fidelity_fitness(const vector_double &dv, unsigned level) const override final
+    {
+        return fidelity_fitness_impl(m_value, dv, level);
+    }
+    virtual bool has_fidelity() const override final
+    {
+        return pagmo::has_fidelity_fitness<T>::value && pagmo::has_fidelity_costs<T>::value;
+    }
+    virtual vector_double get_fidelity_costs() const override final
+    {
+        return get_fidelity_costs_impl(m_value);
+    }
+    virtual vector_double context_fitness(const vector_double &dv, const eval_context &ctx) const override final
+    {
+        return context_fitness_impl(m_value, dv, ctx);
+    }
+    virtual bool has_context_fitness() const override final
+    {
+        return pagmo::has_context_fitness<T>::value;
+    }
+    virtual vector_double batch_fitness(const vector_double &dvs) const override final
+    {
+        return batch_fitness_impl(m_value, dvs);
+    }
+    virtual bool has_batch_fitness() const override final
+    {
+        return pagmo::has_batch_fitness<T>::value;
+    }
     virtual vector_double gradient(const vector_double &dv) const override final
     {
         return gradient_impl(m_value, dv);
@@ -667,6 +824,51 @@ struct prob_inner final : prob_inner_base {
     {
         return 1u;
     }
+    template <typename U,
+              enable_if_t<pagmo::has_fidelity_fitness<U>::value && pagmo::has_fidelity_costs<U>::value, int> = 0>
+    static vector_double fidelity_fitness_impl(const U &value, const vector_double &dv, unsigned level)
+    {
+        return value.fitness(dv, level);
+    }
+    template <typename U,
+              enable_if_t<!(pagmo::has_fidelity_fitness<U>::value && pagmo::has_fidelity_costs<U>::value), int> = 0>
+    static vector_double fidelity_fitness_impl(const U &value, const vector_double &dv, unsigned)
+    {
+        // Without multi-fidelity support, the only level is the fitness itself.
+        return value.fitness(dv);
+    }
+    template <typename U,
+              enable_if_t<pagmo::has_fidelity_fitness<U>::value && pagmo::has_fidelity_costs<U>::value, int> = 0>
+    static vector_double get_fidelity_costs_impl(const U &value)
+    {
+        return value.get_fidelity_costs();
+    }
+    template <typename U,
+              enable_if_t<!(pagmo::has_fidelity_fitness<U>::value && pagmo::has_fidelity_costs<U>::value), int> = 0>
+    static vector_double get_fidelity_costs_impl(const U &)
+    {
+        return {1.};
+    }
+    template <typename U, enable_if_t<pagmo::has_context_fitness<U>::value, int> = 0>
+    static vector_double context_fitness_impl(const U &value, const vector_double &dv, const eval_context &ctx)
+    {
+        return value.fitness(dv, ctx);
+    }
+    template <typename U, enable_if_t<!pagmo::has_context_fitness<U>::value, int> = 0>
+    static vector_double context_fitness_impl(const U &value, const vector_double &dv, const eval_context &)
+    {
+        return value.fitness(dv);
+    }
+    template <typename U, enable_if_t<pagmo::has_batch_fitness<U>::value, int> = 0>
+    static vector_double batch_fitness_impl(const U &value, const vector_double &dvs)
+    {
+        return value.batch_fitness(dvs);
+    }
+    template <typename U, enable_if_t<!pagmo::has_batch_fitness<U>::value, int> = 0>
+    static vector_double batch_fitness_impl(const U &, const vector_double &)
+    {
+        pagmo_throw(not_implemented_error, "The batch fitness has been requested but it is not implemented in the UDP");
+    }
     template <typename U, enable_if_t<pagmo::has_gradient<U>::value, int> = 0>
     static vector_double gradient_impl(const U &value, const vector_double &dv)
     {
@@ -872,6 +1074,21 @@ struct prob_inner final : prob_inner_base {
 
 } // namespace detail
 
+class problem;
+
+namespace detail
+{
+
+// Access to the evaluation counters of pagmo::problem, for the algorithms and evaluators which evaluate the UDP
+// outside problem::fitness() (e.g., on copies of the problem, or through a pagmo::static_problem) and need to
+// account for those evaluations in the counters of the original problem, or to reset the counter of a copy.
+struct problem_counters {
+    static void increment_fevals(const problem &, unsigned long long);
+    static void increment_lfevals(const problem &, unsigned long long);
+    static void set_fevals(const problem &, unsigned long long);
+};
+}
+
 /// Problem class.
 /**
  * \image html problem.png
@@ -924,6 +1141,10 @@ struct prob_inner final : prob_inner_base {
  * vector_double::size_type get_nic() const;
  * bool has_gradient() const;
  * vector_double gradient(const vector_double &) const;
+ * vector_double fitness(const vector_double &, unsigned) const;
+ * vector_double get_fidelity_costs() const;
+ * vector_double fitness(const vector_double &, const eval_context &) const;
+ * vector_double batch_fitness(const vector_double &) const;
  * bool has_gradient_sparsity() const;
  * sparsity_pattern gradient_sparsity() const;
  * bool has_hessians() const;
@@ -986,7 +1207,8 @@ public:
      */
     template <typename T, generic_ctor_enabler<T> = 0>
     explicit problem(T &&x)
-        : m_ptr(::new detail::prob_inner<uncvref_t<T>>(std::forward<T>(x))), m_fevals(0u), m_gevals(0u), m_hevals(0u)
+        : m_ptr(::new detail::prob_inner<uncvref_t<T>>(std::forward<T>(x))), m_fevals(0u), m_gevals(0u), m_hevals(0u),
+          m_lfevals(0u), m_udp_exposed(false)
     {
         // 1 - Bounds.
         auto bounds = ptr()->get_bounds();
@@ -1018,7 +1240,21 @@ public:
         // 5 - Presence of Hessians and their sparsity.
         m_has_hessians = ptr()->has_hessians();
         m_has_hessians_sparsity = ptr()->has_hessians_sparsity();
-        // 5bis - Is this a stochastic problem?
+        // 5bis - Fidelity levels and their costs.
+        m_has_fidelity = ptr()->has_fidelity();
+        m_fidelity_costs = ptr()->get_fidelity_costs();
+        if (m_fidelity_costs.empty() || m_fidelity_costs.size() > std::numeric_limits<unsigned>::max()) {
+            pagmo_throw(std::invalid_argument, "The number of fidelity levels must be at least 1 and fit in an "
+                                               "unsigned, while a value of "
+                                                   + std::to_string(m_fidelity_costs.size()) + " was detected");
+        }
+        for (auto c : m_fidelity_costs) {
+            if (!std::isfinite(c) || !(c > 0.)) {
+                pagmo_throw(std::invalid_argument, "The fidelity costs must be finite and positive, while a value of "
+                                                       + std::to_string(c) + " was detected");
+            }
+        }
+        // 5ter - Is this a stochastic problem?
         m_has_set_seed = ptr()->has_set_seed();
         // 6 - Name.
         m_name = ptr()->get_name();
@@ -1070,7 +1306,12 @@ public:
 
     /// Copy constructor.
     /**
-     * The copy constructor will deep copy the input problem \p other.
+     * The copy constructor will deep copy the input problem \p other, unless the UDP provides the
+     * thread_safety::constant guarantee. In that case, the UDP is shared (via reference counting) between
+     * \p this and \p other, and it will be deep copied only when one of them needs to modify it
+     * (that is, when calling set_seed() or the non-const overload of extract()). Once the non-const overload
+     * of extract() has been called on \p other, the UDP of \p other is always deep copied, as it can be modified
+     * through the returned pointer at any time.
      *
      * @param other the problem to be copied.
      *
@@ -1079,13 +1320,17 @@ public:
      * - the copying of the internal UDP.
      */
     problem(const problem &other)
-        : m_ptr(other.ptr()->clone()), m_fevals(other.m_fevals.load()), m_gevals(other.m_gevals.load()),
-          m_hevals(other.m_hevals.load()), m_lb(other.m_lb), m_ub(other.m_ub), m_nobj(other.m_nobj), m_nec(other.m_nec),
-          m_nic(other.m_nic), m_c_tol(other.m_c_tol), m_has_gradient(other.m_has_gradient),
+        : m_ptr(other.m_thread_safety == thread_safety::constant && !other.m_udp_exposed
+                    ? other.m_ptr
+                    : std::shared_ptr<detail::prob_inner_base>(other.ptr()->clone())),
+          m_fevals(other.m_fevals.load()), m_gevals(other.m_gevals.load()), m_hevals(other.m_hevals.load()),
+          m_lfevals(other.m_lfevals.load()), m_lb(other.m_lb), m_ub(other.m_ub), m_nobj(other.m_nobj),
+          m_nec(other.m_nec), m_nic(other.m_nic), m_c_tol(other.m_c_tol), m_has_fidelity(other.m_has_fidelity),
+          m_fidelity_costs(other.m_fidelity_costs), m_has_gradient(other.m_has_gradient),
           m_has_gradient_sparsity(other.m_has_gradient_sparsity), m_has_hessians(other.m_has_hessians),
           m_has_hessians_sparsity(other.m_has_hessians_sparsity), m_has_set_seed(other.m_has_set_seed),
           m_name(other.m_name), m_gs_dim(other.m_gs_dim), m_hs_dim(other.m_hs_dim),
-          m_thread_safety(other.m_thread_safety)
+          m_thread_safety(other.m_thread_safety), m_udp_exposed(false)
     {
     }
 
@@ -1095,12 +1340,14 @@ public:
      */
     problem(problem &&other) noexcept
         : m_ptr(std::move(other.m_ptr)), m_fevals(other.m_fevals.load()), m_gevals(other.m_gevals.load()),
-          m_hevals(other.m_hevals.load()), m_lb(std::move(other.m_lb)), m_ub(std::move(other.m_ub)),
-          m_nobj(other.m_nobj), m_nec(other.m_nec), m_nic(other.m_nic), m_c_tol(std::move(other.m_c_tol)),
-          m_has_gradient(other.m_has_gradient), m_has_gradient_sparsity(other.m_has_gradient_sparsity),
-          m_has_hessians(other.m_has_hessians), m_has_hessians_sparsity(other.m_has_hessians_sparsity),
-          m_has_set_seed(other.m_has_set_seed), m_name(std::move(other.m_name)), m_gs_dim(other.m_gs_dim),
-          m_hs_dim(std::move(other.m_hs_dim)), m_thread_safety(std::move(other.m_thread_safety))
+          m_hevals(other.m_hevals.load()), m_lfevals(other.m_lfevals.load()), m_lb(std::move(other.m_lb)),
+          m_ub(std::move(other.m_ub)), m_nobj(other.m_nobj), m_nec(other.m_nec), m_nic(other.m_nic),
+          m_c_tol(std::move(other.m_c_tol)), m_has_fidelity(other.m_has_fidelity),
+          m_fidelity_costs(std::move(other.m_fidelity_costs)), m_has_gradient(other.m_has_gradient),
+          m_has_gradient_sparsity(other.m_has_gradient_sparsity), m_has_hessians(other.m_has_hessians),
+          m_has_hessians_sparsity(other.m_has_hessians_sparsity), m_has_set_seed(other.m_has_set_seed),
+          m_name(std::move(other.m_name)), m_gs_dim(other.m_gs_dim), m_hs_dim(std::move(other.m_hs_dim)),
+          m_thread_safety(std::move(other.m_thread_safety)), m_udp_exposed(other.m_udp_exposed)
     {
     }
 
@@ -1117,12 +1364,15 @@ public:
             m_fevals.store(other.m_fevals.load());
             m_gevals.store(other.m_gevals.load());
             m_hevals.store(other.m_hevals.load());
+            m_lfevals.store(other.m_lfevals.load());
             m_lb = std::move(other.m_lb);
             m_ub = std::move(other.m_ub);
             m_nobj = other.m_nobj;
             m_nec = other.m_nec;
             m_nic = other.m_nic;
             m_c_tol = std::move(other.m_c_tol);
+            m_has_fidelity = other.m_has_fidelity;
+            m_fidelity_costs = std::move(other.m_fidelity_costs);
             m_has_gradient = other.m_has_gradient;
             m_has_gradient_sparsity = other.m_has_gradient_sparsity;
             m_has_hessians = other.m_has_hessians;
@@ -1132,6 +1382,7 @@ public:
             m_gs_dim = other.m_gs_dim;
             m_hs_dim = std::move(other.m_hs_dim);
             m_thread_safety = std::move(other.m_thread_safety);
+            m_udp_exposed = other.m_udp_exposed;
         }
         return *this;
     }
@@ -1181,6 +1432,10 @@ public:
      * **NOTE** The returned value is a raw non-owning pointer: the lifetime of the pointee is tied to the lifetime
      * of \p this, and \p delete must never be called on the pointer.
      *
+     * **NOTE** If the UDP is shared with other problems (see the copy constructor), it will be deep copied
+     * before returning the pointer, and it will not be shared by the later copies of \p this, so that the
+     * modifications made through the pointer affect only \p this.
+     *
      * @return a pointer to the internal UDP, or \p nullptr
      * if \p T does not correspond exactly to the original UDP type used
      * in the constructor.
@@ -1188,6 +1443,7 @@ public:
     template <typename T>
     T *extract()
     {
+        m_udp_exposed = true;
         auto p = dynamic_cast<detail::prob_inner<T> *>(ptr());
         return p == nullptr ? nullptr : &(p->m_value);
     }
@@ -1235,6 +1491,177 @@ public:
         return retval;
     }
 
+    /// Fitness at a given fidelity level.
+    /**
+     * Multi-fidelity problems can evaluate their fitness at several levels of fidelity, from the coarsest
+     * (level 0) to the finest (level <tt>get_fidelity_costs().size() - 1</tt>), each with its own cost.
+     * The finest level is the one returned by problem::fitness(dv), and it is evaluated through it.
+     *
+     * If the UDP satisfies both pagmo::has_fidelity_fitness and pagmo::has_fidelity_costs, then for
+     * the other levels this method will forward \p dv and \p level to the multi-fidelity <tt>%fitness()</tt>
+     * method of the UDP, after sanity checks. The output will also be checked before being returned, and a
+     * successful call will increase the internal lower fidelity evaluation counter (see problem::get_lfevals()).
+     * Otherwise, the problem has a single level, 0, which is the same as problem::fitness(dv).
+     *
+     * @param dv the decision vector.
+     * @param level the fidelity level.
+     *
+     * @return the fitness of \p dv at the fidelity level \p level.
+     *
+     * @throws std::invalid_argument if either
+     * - \p level is not smaller than the number of fidelity levels,
+     * - the length of \p dv differs from the value returned by get_nx(), or
+     * - the length of the returned fitness vector differs from the the value returned by get_nf().
+     * @throws unspecified any exception thrown by the <tt>%fitness()</tt> methods of the UDP.
+     */
+    vector_double fitness(const vector_double &dv, unsigned level) const
+    {
+        if (level >= m_fidelity_costs.size()) {
+            pagmo_throw(std::invalid_argument, "The fidelity level " + std::to_string(level)
+                                                   + " was requested, but the problem has only "
+                                                   + std::to_string(m_fidelity_costs.size()) + " levels");
+        }
+        if (level + 1u == m_fidelity_costs.size()) {
+            return fitness(dv);
+        }
+        // 1 - checks the decision vector
+        check_decision_vector(dv);
+        // 2 - computes the fitness
+        vector_double retval(ptr()->fidelity_fitness(dv, level));
+        // 3 - checks the fitness vector
+        check_fitness_vector(retval);
+        // 4 - increments the lower fidelity evaluation counter
+        ++m_lfevals;
+        return retval;
+    }
+
+    /// Fitness within an evaluation context.
+    /**
+     * This method computes the fitness of \p dv like problem::fitness(const vector_double &), but it lets the UDP know
+     * when the evaluation is no longer wanted. If the context is already cancelled or expired, no evaluation takes
+     * place.
+     *
+     * If the UDP satisfies pagmo::has_context_fitness, \p dv and \p ctx will be forwarded to its context-aware
+     * <tt>%fitness()</tt> method, which is expected to poll \p ctx and to throw pagmo::eval_cancelled_error
+     * (e.g., via eval_context::check()) if it gives up. Otherwise, the context is ignored during the evaluation and
+     * the usual <tt>%fitness()</tt> method of the UDP is called. As in problem::fitness(const vector_double &), the
+     * input and output are checked and the fitness evaluation counter is increased on success.
+     *
+     * @param dv the decision vector.
+     * @param ctx the evaluation context.
+     *
+     * @return the fitness of \p dv.
+     *
+     * @throws pagmo::eval_cancelled_error if \p ctx is cancelled or expired before the evaluation.
+     * @throws std::invalid_argument if either
+     * - the length of \p dv differs from the value returned by get_nx(), or
+     * - the length of the returned fitness vector differs from the the value returned by get_nf().
+     * @throws unspecified any exception thrown by the <tt>%fitness()</tt> methods of the UDP.
+     */
+    vector_double fitness(const vector_double &dv, const eval_context &ctx) const
+    {
+        // 1 - checks the decision vector
+        check_decision_vector(dv);
+        // 2 - checks the context
+        ctx.check();
+        // 3 - computes the fitness
+        vector_double retval(ptr()->context_fitness(dv, ctx));
+        // 4 - checks the fitness vector
+        check_fitness_vector(retval);
+        // 5 - increments fitness evaluation counter
+        ++m_fevals;
+        return retval;
+    }
+
+    /// Check if the UDP can be cancelled during an evaluation.
+    /**
+     * @return \p true if the UDP satisfies pagmo::has_context_fitness, \p false otherwise.
+     */
+    bool has_context_fitness() const
+    {
+        return ptr()->has_context_fitness();
+    }
+
+    /// Batch fitness.
+    /**
+     * This method will invoke the <tt>%batch_fitness()</tt> method of the UDP to compute the fitness of the
+     * decision vectors in \p dvs, concatenated one after the other. The return value of the <tt>%batch_fitness()</tt>
+     * method of the UDP is expected to contain the corresponding fitness vectors, concatenated one after the other
+     * in the same order. UDPs which can evaluate many decision vectors at once more efficiently than one by one
+     * (e.g., by dispatching them to a pool of external processes) implement this method, which is preferred by
+     * pagmo::batch_fitness() over the evaluation of the decision vectors one by one.
+     *
+     * As in problem::fitness(), sanity checks are performed on \p dvs and on the returned fitness vectors, and a
+     * successful call of this method will increase the internal fitness evaluation counter by the number of decision
+     * vectors in \p dvs (see problem::get_fevals()).
+     *
+     * @param dvs the decision vectors.
+     *
+     * @return the fitness vectors of \p dvs.
+     *
+     * @throws std::invalid_argument if either
+     * - the length of \p dvs is not a multiple of the value returned by get_nx(), or
+     * - the length of the returned vector differs from the number of decision vectors times the value returned
+     *   by get_nf().
+     * @throws not_implemented_error if the UDP does not satisfy pagmo::has_batch_fitness.
+     * @throws unspecified any exception thrown by the <tt>%batch_fitness()</tt> method of the UDP.
+     */
+    vector_double batch_fitness(const vector_double &dvs) const
+    {
+        const auto nx = get_nx(), nf = get_nf();
+        // 1 - checks the decision vectors
+        if (dvs.size() % nx) {
+            pagmo_throw(std::invalid_argument, "Length of the batch of decision vectors is "
+                                                   + std::to_string(dvs.size()) + ", should be a multiple of "
+                                                   + std::to_string(nx));
+        }
+        const auto n = dvs.size() / nx;
+        // 2 - computes the fitness
+        vector_double retval(ptr()->batch_fitness(dvs));
+        // 3 - checks the fitness vectors
+        if (retval.size() != n * nf) {
+            pagmo_throw(std::invalid_argument, "Length of the batch of fitness vectors is "
+                                                   + std::to_string(retval.size()) + ", should be "
+                                                   + std::to_string(n * nf));
+        }
+        // 4 - increments fitness evaluation counter
+        m_fevals += n;
+        return retval;
+    }
+
+    /// Check if the UDP can evaluate batches of decision vectors.
+    /**
+     * @return \p true if the UDP satisfies pagmo::has_batch_fitness, \p false otherwise.
+     */
+    bool has_batch_fitness() const
+    {
+        return ptr()->has_batch_fitness();
+    }
+
+    /// Check if multiple fidelity levels are available in the UDP.
+    /**
+     * @return \p true if the UDP satisfies both pagmo::has_fidelity_fitness and pagmo::has_fidelity_costs,
+     * \p false otherwise.
+     */
+    bool has_fidelity() const
+    {
+        return m_has_fidelity;
+    }
+
+    /// Costs of the fidelity levels.
+    /**
+     * If the problem has multiple fidelity levels (see problem::has_fidelity()), this method returns the output of the
+     * <tt>%get_fidelity_costs()</tt> method of the UDP, which has one entry per level, from the coarsest to the
+     * finest, containing a hint about the cost of an evaluation at that level (only the ratios between the entries
+     * are meaningful). Otherwise, <tt>{1.}</tt> is returned.
+     *
+     * @return the costs of the fidelity levels.
+     */
+    vector_double get_fidelity_costs() const
+    {
+        return m_fidelity_costs;
+    }
+
     /// Gradient.
     /**
      * This method will compute the gradient of the input decision vector \p dv by invoking
@@ -1502,6 +1929,28 @@ public:
         return std::make_pair(m_lb, m_ub);
     }
 
+    /// Lower bounds.
+    /**
+     * Unlike get_bounds(), this method does not copy the bounds.
+     *
+     * @return a const reference to \f$ \mathbf{lb} \f$, the lower bounds of the problem.
+     */
+    const vector_double &get_lb() const
+    {
+        return m_lb;
+    }
+
+    /// Upper bounds.
+    /**
+     * Unlike get_bounds(), this method does not copy the bounds.
+     *
+     * @return a const reference to \f$ \mathbf{ub} \f$, the upper bounds of the problem.
+     */
+    const vector_double &get_ub() const
+    {
+        return m_ub;
+    }
+
     /// Number of equality constraints.
     /**
      * This method will return \f$ n_{ec} \f$, the number of equality constraints of the problem.
@@ -1562,10 +2011,10 @@ public:
      * be used when checking constraint feasibility. The constraint tolerance is zero-filled upon problem
      * construction, and it can be set via problem::set_c_tol().
      *
-     * @return a pagmo::vector_double containing the tolerances to use when
+     * @return a const reference to a pagmo::vector_double containing the tolerances to use when
      * checking for constraint feasibility.
      */
-    vector_double get_c_tol() const
+    const vector_double &get_c_tol() const
     {
         return m_c_tol;
     }
@@ -1618,6 +2067,19 @@ public:
         return m_hevals.load();
     }
 
+    /// Number of lower fidelity fitness evaluations.
+    /**
+     * Each time a call to problem::fitness(const vector_double &, unsigned) at a level other than the finest
+     * successfully completes, an internal counter is increased by one. The counter is initialised to zero upon
+     * problem construction and it is never reset. Copy and move operations copy the counter as well.
+     *
+     * @return the number of lower fidelity fitness evaluations.
+     */
+    unsigned long long get_lfevals() const
+    {
+        return m_lfevals.load();
+    }
+
     /// Set the seed for the stochastic variables.
     /**
      * Sets the seed to be used in the fitness function to instantiate
@@ -1626,6 +2088,8 @@ public:
      *
      * @param seed seed.
      *
+     * If the UDP is shared with other problems (see the copy constructor), it will be deep copied first.
+     *
      * @throws not_implemented_error if the UDP does not satisfy pagmo::has_set_seed.
      * @throws unspecified any exception thrown by the <tt>%set_seed()</tt> method of the UDP.
      */
@@ -1739,6 +2203,7 @@ public:
      * If the UDP satisfies pagmo::has_get_thread_safety, then this method will return the output of its
      * <tt>%get_thread_safety()</tt> method. Otherwise, thread_safety::basic will be returned.
      * That is, pagmo assumes by default that is it safe to operate concurrently on distinct UDP instances.
+     * UDPs providing thread_safety::constant are shared among the copies of a problem.
      *
      * @return the thread safety level of the UDP.
      */
@@ -1777,6 +2242,9 @@ public:
         stream(os, p.get_bounds().first, '\n');
         os << "\tUpper bounds: ";
         stream(os, p.get_bounds().second, '\n');
+        if (p.has_fidelity()) {
+            stream(os, "\n\tFidelity levels costs: ", p.get_fidelity_costs(), '\n');
+        }
         stream(os, "\n\tHas gradient: ", p.has_gradient(), '\n');
         stream(os, "\tUser implemented gradient sparsity: ", p.m_has_gradient_sparsity, '\n');
         if (p.has_gradient()) {
@@ -1788,6 +2256,9 @@ public:
             stream(os, "\tExpected hessian components: ", p.m_hs_dim, '\n');
         }
         stream(os, "\n\tFunction evaluations: ", p.get_fevals(), '\n');
+        if (p.has_fidelity()) {
+            stream(os, "\tLower fidelity evaluations: ", p.get_lfevals(), '\n');
+        }
         if (p.has_gradient()) {
             stream(os, "\tGradient evaluations: ", p.get_gevals(), '\n');
         }
@@ -1814,9 +2285,13 @@ public:
     template <typename Archive>
     void save(Archive &ar) const
     {
-        ar(m_ptr, m_fevals.load(), m_gevals.load(), m_hevals.load(), m_lb, m_ub, m_nobj, m_nec, m_nic, m_c_tol,
+        // The UDP is saved through a non-owning std::unique_ptr, so that the archive does not depend on
+        // whether the UDP is shared or not.
+        const std::unique_ptr<detail::prob_inner_base, detail::no_delete> p(m_ptr.get());
+        // NOTE: the multi-fidelity members are appended at the end, so that the layout of the others is unchanged.
+        ar(p, m_fevals.load(), m_gevals.load(), m_hevals.load(), m_lb, m_ub, m_nobj, m_nec, m_nic, m_c_tol,
            m_has_gradient, m_has_gradient_sparsity, m_has_hessians, m_has_hessians_sparsity, m_has_set_seed, m_name,
-           m_gs_dim, m_hs_dim, m_thread_safety);
+           m_gs_dim, m_hs_dim, m_thread_safety, m_lfevals.load(), m_has_fidelity, m_fidelity_costs);
     }
 
     /// Load from archive.
@@ -1832,7 +2307,9 @@ public:
     {
         // Deserialize in a separate object and move it in later, for exception safety.
         problem tmp_prob;
-        ar(tmp_prob.m_ptr);
+        std::unique_ptr<detail::prob_inner_base> p;
+        ar(p);
+        tmp_prob.m_ptr = std::move(p);
         unsigned long long tmp;
         ar(tmp);
         tmp_prob.m_fevals.store(tmp);
@@ -1844,6 +2321,9 @@ public:
            tmp_prob.m_has_gradient, tmp_prob.m_has_gradient_sparsity, tmp_prob.m_has_hessians,
            tmp_prob.m_has_hessians_sparsity, tmp_prob.m_has_set_seed, tmp_prob.m_name, tmp_prob.m_gs_dim,
            tmp_prob.m_hs_dim, tmp_prob.m_thread_safety);
+        ar(tmp);
+        tmp_prob.m_lfevals.store(tmp);
+        ar(tmp_prob.m_has_fidelity, tmp_prob.m_fidelity_costs);
         *this = std::move(tmp_prob);
     }
 
@@ -1855,9 +2335,14 @@ private:
         assert(m_ptr.get() != nullptr);
         return m_ptr.get();
     }
+    // NOTE: the non-const version is used only by the methods that can modify the UDP: if the UDP is shared,
+    // we make a private copy of it first.
     detail::prob_inner_base *ptr()
     {
         assert(m_ptr.get() != nullptr);
+        if (m_ptr.use_count() > 1) {
+            m_ptr.reset(m_ptr->clone());
+        }
         return m_ptr.get();
     }
 
@@ -1981,14 +2466,17 @@ private:
     }
 
 private:
+    friend struct detail::problem_counters;
     // Pointer to the inner base problem
-    std::unique_ptr<detail::prob_inner_base> m_ptr;
+    std::shared_ptr<detail::prob_inner_base> m_ptr;
     // Atomic counter for calls to the fitness
     mutable std::atomic<unsigned long long> m_fevals;
     // Atomic counter for calls to the gradient
     mutable std::atomic<unsigned long long> m_gevals;
     // Atomic counter for calls to the hessians
     mutable std::atomic<unsigned long long> m_hevals;
+    // Atomic counter for calls to the fitness at lower fidelity levels
+    mutable std::atomic<unsigned long long> m_lfevals;
     // Various problem properties determined at construction time
     // from the concrete problem. These will be constant for the lifetime
     // of problem, but we cannot mark them as such because of serialization.
@@ -1998,6 +2486,8 @@ private:
     vector_double::size_type m_nec;
     vector_double::size_type m_nic;
     vector_double m_c_tol;
+    bool m_has_fidelity;
+    vector_double m_fidelity_costs;
     bool m_has_gradient;
     bool m_has_gradient_sparsity;
     bool m_has_hessians;
@@ -2011,10 +2501,51 @@ private:
     std::vector<vector_double::size_type> m_hs_dim;
     // Thread safety.
     thread_safety m_thread_safety;
+    // Whether a mutable pointer to the UDP was handed out by extract(): the UDP cannot be shared anymore.
+    bool m_udp_exposed;
 };
 
+namespace detail
+{
+
+inline void problem_counters::increment_fevals(const problem &p, unsigned long long n)
+{
+    p.m_fevals += n;
+}
+
+inline void problem_counters::increment_lfevals(const problem &p, unsigned long long n)
+{
+    p.m_lfevals += n;
+}
+
+inline void problem_counters::set_fevals(const problem &p, unsigned long long n)
+{
+    p.m_fevals = n;
+}
+}
+
 } // namespaces
 
-PAGMO_REGISTER_PROBLEM(pagmo::null_problem)
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::null_problem)
+
+#if defined(PAGMO_SEPARATE_COMPILATION)
+
+namespace pagmo
+{
+namespace detail
+{
+// Defined in the pagmo library, in the translation unit registering the built-in UDPs and UDAs for serialization.
+// Nothing else in that translation unit is referenced by user code, so the linker would drop it from the static
+// library: calling this function during the static initialisation of every user translation unit keeps it in.
+int builtin_registrations_anchor();
+
+namespace
+{
+const int builtin_registrations_anchor_ref = builtin_registrations_anchor();
+}
+}
+}
+
+#endif
 
 #endif
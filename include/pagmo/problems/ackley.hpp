@@ -147,6 +147,6 @@ struct ackley {
 
 } // namespace pagmo
 
-PAGMO_REGISTER_PROBLEM(pagmo::ackley)
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::ackley)
 
 #endif
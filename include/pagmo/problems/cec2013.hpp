@@ -1168,7 +1168,7 @@ private:
 
 } // namespace pagmo
 
-PAGMO_REGISTER_PROBLEM(pagmo::cec2013)
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::cec2013)
 
 #undef E
 
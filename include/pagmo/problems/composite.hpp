@@ -0,0 +1,385 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_PROBLEM_COMPOSITE_HPP
+#define PAGMO_PROBLEM_COMPOSITE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../exceptions.hpp"
+#include "../io.hpp"
+#include "../problem.hpp"
+#include "../threading.hpp"
+#include "../types.hpp"
+
+namespace pagmo
+{
+
+/// Composite problem.
+/**
+ * This user-defined problem assembles its fitness vector from a set of independent *components*. Each component
+ * is a function of the decision vector returning a block of objectives, of equality constraints or of inequality
+ * constraints, as registered via composite::add_objectives(), composite::add_equality_constraints() and
+ * composite::add_inequality_constraints(). The fitness vector is formed, as usual in pagmo, by all the objective
+ * blocks, followed by all the equality constraint blocks, followed by all the inequality constraint blocks. Within
+ * each kind, the blocks appear in registration order.
+ *
+ * This is useful when the objectives and the constraints of a problem come from different and unrelated models
+ * (e.g., a structural and an aerodynamic simulator): in the default, concurrent mode, composite::fitness() runs
+ * all the components of a single decision vector in parallel, one thread per component, so that the latency of
+ * a fitness evaluation is that of the slowest component rather than the sum of all of them. Since a new thread
+ * is started for every component but the first at each evaluation, the concurrent mode pays off only when the
+ * components are expensive; it can be switched off via composite::set_concurrent().
+ *
+ * The components of a composite must be safe to call concurrently with *each other* (but each component is never
+ * called concurrently with itself by a single composite). Copies of a composite hold copies of the component
+ * functions: the thread safety level reported to pagmo::problem, which is thread_safety::basic by default, can be
+ * adjusted via composite::set_thread_safety() to reflect the actual guarantees of the components.
+ *
+ * All the components must be registered before the composite is used to construct a pagmo::problem, which requires
+ * at least one objective. Since arbitrary function objects cannot be serialized, this problem is not serializable.
+ */
+class composite
+{
+public:
+    /// The type of the component functions.
+    using component_function = std::function<vector_double(const vector_double &)>;
+    /// Kinds of component.
+    enum class kind {
+        /// Objectives.
+        objective,
+        /// Equality constraints.
+        equality,
+        /// Inequality constraints.
+        inequality
+    };
+    /// Default constructor.
+    /**
+     * Constructs a composite with bounds <tt>([0.],[1.])</tt> and no components.
+     *
+     * @throws unspecified any exception thrown by composite::composite(const vector_double &, const vector_double &).
+     */
+    composite() : composite({0.}, {1.})
+    {
+    }
+    /// Constructor from bounds.
+    /**
+     * Constructs a composite with no components.
+     *
+     * @param lb the lower bounds of the decision vector.
+     * @param ub the upper bounds of the decision vector.
+     *
+     * @throws std::invalid_argument if the bounds are invalid (e.g., they have different sizes, they are empty,
+     * they contain NaNs or a lower bound is greater than the corresponding upper bound).
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    composite(const vector_double &lb, const vector_double &ub) : m_lb(lb), m_ub(ub)
+    {
+        detail::check_problem_bounds(m_lb, m_ub);
+    }
+    /// Register a block of objectives.
+    /**
+     * @param f the component function, which must return a vector of size \p n.
+     * @param n the number of objectives computed by \p f.
+     * @param name an optional name for the component, used in error messages and in composite::get_extra_info().
+     *
+     * @return a reference to \p this.
+     *
+     * @throws std::invalid_argument if \p f is empty or \p n is zero.
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    composite &add_objectives(component_function f, vector_double::size_type n = 1u, std::string name = "")
+    {
+        return add_component(kind::objective, std::move(f), n, std::move(name));
+    }
+    /// Register a block of equality constraints.
+    /**
+     * @param f the component function, which must return a vector of size \p n.
+     * @param n the number of equality constraints computed by \p f.
+     * @param name an optional name for the component, used in error messages and in composite::get_extra_info().
+     *
+     * @return a reference to \p this.
+     *
+     * @throws std::invalid_argument if \p f is empty or \p n is zero.
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    composite &add_equality_constraints(component_function f, vector_double::size_type n = 1u, std::string name = "")
+    {
+        return add_component(kind::equality, std::move(f), n, std::move(name));
+    }
+    /// Register a block of inequality constraints.
+    /**
+     * @param f the component function, which must return a vector of size \p n.
+     * @param n the number of inequality constraints computed by \p f.
+     * @param name an optional name for the component, used in error messages and in composite::get_extra_info().
+     *
+     * @return a reference to \p this.
+     *
+     * @throws std::invalid_argument if \p f is empty or \p n is zero.
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    composite &add_inequality_constraints(component_function f, vector_double::size_type n = 1u,
+                                          std::string name = "")
+    {
+        return add_component(kind::inequality, std::move(f), n, std::move(name));
+    }
+    /// Fitness computation.
+    /**
+     * Evaluates all the components on \p x and assembles their outputs in the fitness vector. In concurrent mode,
+     * every component but the first runs in a separate thread, and the first one runs in the calling thread. If one
+     * or more components throw, the function waits for all the components to finish and then rethrows the first
+     * exception, in the order of the fitness vector.
+     *
+     * @param x the decision vector.
+     *
+     * @return the fitness of \p x.
+     *
+     * @throws std::invalid_argument if a component returns a vector whose size differs from the one it was
+     * registered with.
+     * @throws unspecified any exception thrown by the component functions, by threading primitives or by memory
+     * errors in standard containers.
+     */
+    vector_double fitness(const vector_double &x) const
+    {
+        vector_double retval(m_nobj + m_nec + m_nic);
+        if (!m_concurrent || m_components.size() < 2u) {
+            vector_double::size_type offset = 0u;
+            for (const auto &c : m_components) {
+                eval_component(c, x, retval, offset);
+                offset += c.m_n;
+            }
+            return retval;
+        }
+        std::vector<std::exception_ptr> errors(m_components.size());
+        {
+            // NOTE: the futures are declared after retval and errors, so that, if launching
+            // a thread fails, the threads already running are joined before their outputs are destroyed.
+            std::vector<std::future<void>> futures;
+            futures.reserve(m_components.size() - 1u);
+            auto offset = m_components[0].m_n;
+            for (decltype(m_components.size()) i = 1u; i < m_components.size(); ++i) {
+                futures.push_back(std::async(std::launch::async, [this, &x, &retval, &errors, i, offset]() {
+                    try {
+                        eval_component(m_components[i], x, retval, offset);
+                    } catch (...) {
+                        errors[i] = std::current_exception();
+                    }
+                }));
+                offset += m_components[i].m_n;
+            }
+            try {
+                eval_component(m_components[0], x, retval, 0u);
+            } catch (...) {
+                errors[0] = std::current_exception();
+            }
+            for (auto &fut : futures) {
+                fut.get();
+            }
+        }
+        for (const auto &e : errors) {
+            if (e) {
+                std::rethrow_exception(e);
+            }
+        }
+        return retval;
+    }
+    /// Box-bounds.
+    /**
+     * @return the bounds of the problem, as specified upon construction.
+     */
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {m_lb, m_ub};
+    }
+    /// Number of objectives.
+    /**
+     * @return the total size of the objective blocks registered so far.
+     */
+    vector_double::size_type get_nobj() const
+    {
+        return m_nobj;
+    }
+    /// Number of equality constraints.
+    /**
+     * @return the total size of the equality constraint blocks registered so far.
+     */
+    vector_double::size_type get_nec() const
+    {
+        return m_nec;
+    }
+    /// Number of inequality constraints.
+    /**
+     * @return the total size of the inequality constraint blocks registered so far.
+     */
+    vector_double::size_type get_nic() const
+    {
+        return m_nic;
+    }
+    /// Number of components.
+    /**
+     * @return the number of components registered so far.
+     */
+    std::vector<component_function>::size_type get_n_components() const
+    {
+        return m_components.size();
+    }
+    /// Set the concurrent mode.
+    /**
+     * @param flag \p true to evaluate the components concurrently (the default), \p false to evaluate them
+     * sequentially in the calling thread.
+     */
+    void set_concurrent(bool flag)
+    {
+        m_concurrent = flag;
+    }
+    /// Get the concurrent mode.
+    /**
+     * @return \p true if the components are evaluated concurrently, \p false otherwise.
+     */
+    bool get_concurrent() const
+    {
+        return m_concurrent;
+    }
+    /// Set the thread safety level.
+    /**
+     * @param ts the thread safety level of the component functions.
+     */
+    void set_thread_safety(thread_safety ts)
+    {
+        m_ts = ts;
+    }
+    /// Thread safety level.
+    /**
+     * @return the thread safety level set via composite::set_thread_safety() (thread_safety::basic by default).
+     */
+    thread_safety get_thread_safety() const
+    {
+        return m_ts;
+    }
+    /// Problem name.
+    /**
+     * @return a string containing the problem name.
+     */
+    std::string get_name() const
+    {
+        return "Composite problem";
+    }
+    /// Extra info.
+    /**
+     * @return a string listing the components and the evaluation mode.
+     */
+    std::string get_extra_info() const
+    {
+        std::ostringstream oss;
+        oss << "\tConcurrent evaluation: " << (m_concurrent ? "true" : "false") << '\n';
+        oss << "\tComponents:\n";
+        vector_double::size_type offset = 0u;
+        for (decltype(m_components.size()) i = 0u; i < m_components.size(); ++i) {
+            const auto &c = m_components[i];
+            oss << "\t\t" << component_name(c, i) << ": "
+                << (c.m_kind == kind::objective ? "objectives"
+                                                 : (c.m_kind == kind::equality ? "equality constraints"
+                                                                               : "inequality constraints"))
+                << " [" << offset << ", " << offset + c.m_n << ")\n";
+            offset += c.m_n;
+        }
+        return oss.str();
+    }
+
+private:
+    struct component {
+        kind m_kind;
+        component_function m_f;
+        vector_double::size_type m_n;
+        std::string m_name;
+    };
+    composite &add_component(kind k, component_function f, vector_double::size_type n, std::string name)
+    {
+        if (!f) {
+            pagmo_throw(std::invalid_argument, "Cannot add an empty function as a component of a composite problem");
+        }
+        if (!n) {
+            pagmo_throw(std::invalid_argument,
+                        "The size of a component of a composite problem must be at least 1, but 0 was provided");
+        }
+        // Keep the components sorted by kind, so that the blocks can be laid out in the fitness
+        // vector in storage order. Within the same kind, the registration order is preserved.
+        const auto it = std::find_if(m_components.begin(), m_components.end(),
+                                     [k](const component &c) { return c.m_kind > k; });
+        m_components.insert(it, component{k, std::move(f), n, std::move(name)});
+        switch (k) {
+            case kind::objective:
+                m_nobj += n;
+                break;
+            case kind::equality:
+                m_nec += n;
+                break;
+            case kind::inequality:
+                m_nic += n;
+        }
+        return *this;
+    }
+    static std::string component_name(const component &c, std::size_t i)
+    {
+        return c.m_name.empty() ? "component #" + std::to_string(i) : "'" + c.m_name + "'";
+    }
+    void eval_component(const component &c, const vector_double &x, vector_double &retval,
+                        vector_double::size_type offset) const
+    {
+        const auto f = c.m_f(x);
+        if (f.size() != c.m_n) {
+            pagmo_throw(std::invalid_argument,
+                        "The " + component_name(c, static_cast<std::size_t>(&c - m_components.data()))
+                            + " of a composite problem returned a vector of size " + std::to_string(f.size())
+                            + ", but it was registered with size " + std::to_string(c.m_n));
+        }
+        std::copy(f.begin(), f.end(), retval.begin() + static_cast<vector_double::difference_type>(offset));
+    }
+
+    vector_double m_lb;
+    vector_double m_ub;
+    std::vector<component> m_components;
+    vector_double::size_type m_nobj = 0u;
+    vector_double::size_type m_nec = 0u;
+    vector_double::size_type m_nic = 0u;
+    bool m_concurrent = true;
+    thread_safety m_ts = thread_safety::basic;
+};
+
+} // namespace pagmo
+
+#endif
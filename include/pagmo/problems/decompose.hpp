@@ -42,6 +42,7 @@ see https://www.gnu.org/licenses/. */
 #include "../exceptions.hpp"
 #include "../problem.hpp"
 #include "../serialization.hpp"
+#include "../threading.hpp"
 #include "../type_traits.hpp"
 #include "../types.hpp"
 #include "../utils/multi_objective.hpp" // pagmo::decompose_objectives
@@ -223,6 +224,18 @@ public:
         // we return the decomposed fitness
         return decompose_objectives(f, m_weight, m_z, m_method);
     }
+    /// Thread safety level.
+    /**
+     * When the ideal point is adapted, the fitness computation modifies the decomposed problem: in that case
+     * the thread safety level of the original problem is capped to thread_safety::basic.
+     *
+     * @return the thread safety level of the decomposed problem.
+     */
+    thread_safety get_thread_safety() const
+    {
+        const auto ts = static_cast<const problem *>(this)->get_thread_safety();
+        return (m_adapt_ideal && ts > thread_safety::basic) ? thread_safety::basic : ts;
+    }
     /// Fitness of the original problem.
     /**
      * Returns the fitness of the original multi-objective problem used to construct the decomposed problem.
@@ -368,6 +381,6 @@ private:
 };
 }
 
-PAGMO_REGISTER_PROBLEM(pagmo::decompose)
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::decompose)
 
 #endif
@@ -504,6 +504,6 @@ private:
 };
 }
 
-PAGMO_REGISTER_PROBLEM(pagmo::dtlz)
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::dtlz)
 
 #endif
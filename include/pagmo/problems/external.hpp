@@ -0,0 +1,694 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_PROBLEM_EXTERNAL_HPP
+#define PAGMO_PROBLEM_EXTERNAL_HPP
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+
+// The external problem is available only on POSIX platforms.
+#define PAGMO_WITH_EXTERNAL_PROBLEM
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../exceptions.hpp"
+#include "../io.hpp"
+#include "../problem.hpp"
+#include "../serialization.hpp"
+#include "../types.hpp"
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// Writes n bytes to fd. If sock is true, fd is a socket and the write must not raise SIGPIPE
+// when the other end has been closed. Returns false if the other end was closed or on error.
+inline bool ext_write_all(int fd, const void *buf, std::size_t n, bool sock)
+{
+    auto ptr = static_cast<const char *>(buf);
+    while (n) {
+#if defined(MSG_NOSIGNAL)
+        const auto ret = sock ? ::send(fd, ptr, n, MSG_NOSIGNAL) : ::write(fd, ptr, n);
+#else
+        // On platforms without MSG_NOSIGNAL, SO_NOSIGPIPE is set on the socket upon creation.
+        (void)sock;
+        const auto ret = ::write(fd, ptr, n);
+#endif
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        ptr += ret;
+        n -= static_cast<std::size_t>(ret);
+    }
+    return true;
+}
+
+// Reads n bytes from fd. Returns false on end of file or on error.
+inline bool ext_read_all(int fd, void *buf, std::size_t n)
+{
+    auto ptr = static_cast<char *>(buf);
+    while (n) {
+        const auto ret = ::read(fd, ptr, n);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (ret == 0) {
+            return false;
+        }
+        ptr += ret;
+        n -= static_cast<std::size_t>(ret);
+    }
+    return true;
+}
+
+// Messages are made of a header of two unsigned 64-bit integers followed by a block of doubles,
+// in native byte order. The header of a request contains the number of decision vectors and their
+// dimension, the header of a reply the number of fitness vectors and their dimension.
+inline bool ext_write_message(int fd, std::uint64_t n, std::uint64_t m, const double *data, bool sock)
+{
+    const std::uint64_t header[2] = {n, m};
+    return ext_write_all(fd, header, sizeof(header), sock)
+           && ext_write_all(fd, data, static_cast<std::size_t>(n * m) * sizeof(double), sock);
+}
+
+// A worker process, connected to the parent through a socket used as its standard input and output.
+struct ext_worker {
+    ::pid_t m_pid = -1;
+    int m_fd = -1;
+};
+
+inline void ext_set_cloexec(int fd)
+{
+    ::fcntl(fd, F_SETFD, ::fcntl(fd, F_GETFD) | FD_CLOEXEC);
+}
+
+// Creates a pipe whose ends are closed on exec. Where pipe2() is available, the flag is set atomically, so that the
+// ends cannot leak into a process forked concurrently by another thread.
+inline bool ext_pipe_cloexec(int (&fds)[2])
+{
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+    return ::pipe2(fds, O_CLOEXEC) != -1;
+#else
+    if (::pipe(fds) == -1) {
+        return false;
+    }
+    ext_set_cloexec(fds[0]);
+    ext_set_cloexec(fds[1]);
+    return true;
+#endif
+}
+
+// The paths where execvp() would look for the executable file: the file itself if its name contains a slash,
+// otherwise the file in each directory of the PATH environment variable (or of a default search path).
+inline std::vector<std::string> ext_exec_paths(const std::string &file)
+{
+    if (file.find('/') != std::string::npos) {
+        return {file};
+    }
+    const char *env_path = std::getenv("PATH");
+    const std::string path_list = env_path ? env_path : "/bin:/usr/bin";
+    std::vector<std::string> retval;
+    std::string::size_type begin = 0u;
+    while (true) {
+        const auto end = path_list.find(':', begin);
+        auto dir = path_list.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+        // An empty entry denotes the current directory.
+        retval.push_back((dir.empty() ? std::string(".") : dir) + "/" + file);
+        if (end == std::string::npos) {
+            break;
+        }
+        begin = end + 1u;
+    }
+    return retval;
+}
+
+inline ext_worker ext_spawn(const std::vector<std::string> &command)
+{
+    if (command.empty()) {
+        pagmo_throw(std::invalid_argument,
+                    "Cannot launch the worker of an external problem: no command was provided");
+    }
+    // The argument vector and the candidate paths of the executable must be prepared before forking:
+    // the child can only call async-signal-safe functions, and execvp() is not one of them.
+    std::vector<char *> argv;
+    for (const auto &arg : command) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    const auto paths = ext_exec_paths(command[0]);
+    int fds[2];
+#if defined(SOCK_CLOEXEC)
+    const int sock_type = SOCK_STREAM | SOCK_CLOEXEC;
+#else
+    const int sock_type = SOCK_STREAM;
+#endif
+    if (::socketpair(AF_UNIX, sock_type, 0, fds) == -1) {
+        pagmo_throw(std::runtime_error,
+                    "Could not create the socket of an external worker: " + std::string(std::strerror(errno)));
+    }
+    // The ends of the socket must not leak into other workers: otherwise the end of file would not be
+    // detected by a worker when the parent closes its end.
+    ext_set_cloexec(fds[0]);
+    ext_set_cloexec(fds[1]);
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+    {
+        int one = 1;
+        ::setsockopt(fds[0], SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+    }
+#endif
+    // This pipe is used by the child to report a failure of exec. It is closed on a successful exec.
+    int status[2];
+    if (!ext_pipe_cloexec(status)) {
+        const auto err = errno;
+        ::close(fds[0]);
+        ::close(fds[1]);
+        pagmo_throw(std::runtime_error,
+                    "Could not create the status pipe of an external worker: " + std::string(std::strerror(err)));
+    }
+    const auto pid = ::fork();
+    if (pid == -1) {
+        const auto err = errno;
+        ::close(fds[0]);
+        ::close(fds[1]);
+        ::close(status[0]);
+        ::close(status[1]);
+        pagmo_throw(std::runtime_error, "Could not fork an external worker: " + std::string(std::strerror(err)));
+    }
+    if (pid == 0) {
+        // Child: only async-signal-safe functions from here on. The candidate paths are tried in order, as
+        // execvp() would do: the error reported is the first one other than ENOENT, if any.
+        int err = ENOENT;
+        if (::dup2(fds[1], 0) != -1 && ::dup2(fds[1], 1) != -1) {
+            for (const auto &path : paths) {
+                ::execv(path.c_str(), argv.data());
+                if (errno != ENOENT && errno != ENOTDIR && err == ENOENT) {
+                    err = errno;
+                }
+            }
+        } else {
+            err = errno;
+        }
+        (void)!::write(status[1], &err, sizeof(err));
+        ::_exit(127);
+    }
+    ::close(fds[1]);
+    ::close(status[1]);
+    int err = 0;
+    const bool exec_failed = ext_read_all(status[0], &err, sizeof(err));
+    ::close(status[0]);
+    if (exec_failed) {
+        ::close(fds[0]);
+        ::waitpid(pid, nullptr, 0);
+        pagmo_throw(std::runtime_error,
+                    "Could not execute '" + command[0] + "' as an external worker: " + std::string(std::strerror(err)));
+    }
+    ext_worker retval;
+    retval.m_pid = pid;
+    retval.m_fd = fds[0];
+    return retval;
+}
+
+// Stops a worker: its input is closed so that it can exit gracefully, and it is killed
+// if it is still running after a short grace period.
+inline void ext_stop(ext_worker &w)
+{
+    if (w.m_pid == -1) {
+        return;
+    }
+    ::close(w.m_fd);
+    bool exited = false;
+    for (int i = 0; i < 20 && !exited; ++i) {
+        const auto ret = ::waitpid(w.m_pid, nullptr, WNOHANG);
+        exited = (ret == w.m_pid) || (ret == -1 && errno != EINTR);
+        if (!exited) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    if (!exited) {
+        ::kill(w.m_pid, SIGKILL);
+        while (::waitpid(w.m_pid, nullptr, 0) == -1 && errno == EINTR) {
+        }
+    }
+    w.m_pid = -1;
+    w.m_fd = -1;
+}
+}
+
+/// External problem
+/**
+ * This user-defined problem (UDP) delegates the computation of the fitness to an external executable, such as
+ * a standalone simulator. A pool of worker processes, running the command passed upon construction,
+ * is launched on the first evaluation and kept alive until the problem is destroyed, so that the startup time of the
+ * executable is paid only once.
+ *
+ * The decision vectors are streamed to the workers, and the fitness vectors are streamed back, through a socket
+ * which is connected to the standard input and output of each worker. The messages use a compact binary framing:
+ * a header made of two unsigned 64-bit integers (the number of vectors and their dimension) followed by the vectors
+ * as contiguous doubles, all in native byte order. A single message can carry many vectors:
+ * external::batch_fitness() splits the decision vectors evenly among the workers and sends one message to each of
+ * them, so that they work in parallel. As this class implements <tt>%batch_fitness()</tt>, pagmo::batch_fitness()
+ * hands whole batches over to the pool, while problem::fitness() evaluates a single decision vector on one worker:
+ * algorithms gain from the pool only when they evaluate their decision vectors in batches.
+ *
+ * The workers must read requests from their standard input until the end of file is reached, and must write on their
+ * standard output only the replies. The function pagmo::serve_external() implements this protocol on top of a
+ * user-provided fitness function, and can be used to write workers in C++.
+ *
+ * If a worker crashes (i.e., it closes its end of the socket, for instance by exiting), it is restarted and its
+ * vectors are sent again to the new process, up to a maximum number of consecutive restarts after which an
+ * error is raised.
+ *
+ * The workers are not copied together with the problem: a copy launches its own workers when first used.
+ *
+ * **NOTE**: this class is available only on POSIX platforms, where the macro \p PAGMO_WITH_EXTERNAL_PROBLEM is
+ * defined by this header.
+ */
+class external
+{
+    // The pool of workers, which is not part of the state of the problem.
+    struct pool {
+        explicit pool(std::vector<detail::ext_worker>::size_type n) : m_workers(n)
+        {
+        }
+        ~pool()
+        {
+            for (auto &w : m_workers) {
+                detail::ext_stop(w);
+            }
+        }
+        std::vector<detail::ext_worker> m_workers;
+    };
+
+public:
+    /// Constructor from command, bounds and problem dimensions.
+    /**
+     * @param command the worker executable, followed by its arguments. The executable is searched in the
+     * \p PATH if it does not contain a slash.
+     * @param bounds the box-bounds of the problem.
+     * @param nobj the number of objectives.
+     * @param nec the number of equality constraints.
+     * @param nic the number of inequality constraints.
+     * @param n_workers the number of worker processes.
+     * @param max_restarts the maximum number of consecutive restarts of a worker during an evaluation.
+     *
+     * @throws std::invalid_argument if \p n_workers is zero or if the lower and upper bounds have different
+     * lengths.
+     */
+    external(std::vector<std::string> command = {},
+             std::pair<vector_double, vector_double> bounds = {vector_double{0.}, vector_double{1.}},
+             vector_double::size_type nobj = 1u, vector_double::size_type nec = 0u, vector_double::size_type nic = 0u,
+             unsigned n_workers = 1u, unsigned max_restarts = 3u)
+        : m_command(std::move(command)), m_lb(std::move(bounds.first)), m_ub(std::move(bounds.second)), m_nobj(nobj),
+          m_nec(nec), m_nic(nic), m_n_workers(n_workers), m_max_restarts(max_restarts), m_n_restarts(0u)
+    {
+        if (!n_workers) {
+            pagmo_throw(std::invalid_argument, "The number of workers of an external problem cannot be zero");
+        }
+        if (m_lb.size() != m_ub.size()) {
+            pagmo_throw(std::invalid_argument, "The lower and upper bounds of an external problem have different "
+                                               "lengths: "
+                                                   + std::to_string(m_lb.size()) + " and "
+                                                   + std::to_string(m_ub.size()));
+        }
+    }
+    /// Copy constructor.
+    /**
+     * The configuration is copied, the workers are not.
+     *
+     * @param other the problem to be copied.
+     */
+    external(const external &other)
+        : m_command(other.m_command), m_lb(other.m_lb), m_ub(other.m_ub), m_nobj(other.m_nobj), m_nec(other.m_nec),
+          m_nic(other.m_nic), m_n_workers(other.m_n_workers), m_max_restarts(other.m_max_restarts), m_n_restarts(0u)
+    {
+    }
+    /// Move constructor.
+    external(external &&) = default;
+    /// Copy assignment.
+    /**
+     * @param other the assignment argument.
+     *
+     * @return a reference to \p this.
+     */
+    external &operator=(const external &other)
+    {
+        if (this != &other) {
+            *this = external(other);
+        }
+        return *this;
+    }
+    /// Move assignment.
+    /**
+     * @return a reference to \p this.
+     */
+    external &operator=(external &&) = default;
+
+    /// Fitness computation.
+    /**
+     * @param x the decision vector.
+     *
+     * @return the fitness of \p x, as computed by one of the workers.
+     *
+     * @throws unspecified any exception thrown by external::batch_fitness().
+     */
+    vector_double fitness(const vector_double &x) const
+    {
+        return batch_fitness(x);
+    }
+    /// Batch fitness computation.
+    /**
+     * The decision vectors in \p xs are split in contiguous chunks, one per worker, and each chunk is
+     * sent to its worker in a single message. The replies are then collected in order.
+     *
+     * @param xs the decision vectors, concatenated one after the other.
+     *
+     * @return the fitness vectors of the decision vectors in \p xs, concatenated one after the other.
+     *
+     * @throws std::invalid_argument if the size of \p xs is not a multiple of the problem dimension, if no command
+     * was provided or if the reply of a worker is inconsistent with the problem dimensions.
+     * @throws std::runtime_error if a worker cannot be launched, or if it crashes more than the maximum
+     * number of consecutive restarts.
+     */
+    vector_double batch_fitness(const vector_double &xs) const
+    {
+        const auto nx = m_lb.size(), nf = m_nobj + m_nec + m_nic;
+        if (!nx || xs.size() % nx) {
+            pagmo_throw(std::invalid_argument, "The size of the batch of decision vectors (" + std::to_string(xs.size())
+                                                   + ") is not a multiple of the problem dimension ("
+                                                   + std::to_string(nx) + ")");
+        }
+        const auto n = xs.size() / nx;
+        vector_double retval(n * nf);
+        if (!n) {
+            return retval;
+        }
+        if (!m_pool) {
+            m_pool.reset(new pool(m_n_workers));
+        }
+        auto &workers = m_pool->m_workers;
+        // The chunks of vectors assigned to each worker.
+        const auto n_used = std::min<decltype(workers.size())>(workers.size(), n);
+        std::vector<std::pair<decltype(xs.size()), decltype(xs.size())>> chunks(n_used);
+        for (decltype(chunks.size()) w = 0u, begin = 0u; w < n_used; ++w) {
+            const auto size = n / n_used + (w < n % n_used ? 1u : 0u);
+            chunks[w] = std::make_pair(begin, size);
+            begin += size;
+        }
+        try {
+            // 1 - Send all the requests, launching the workers if needed.
+            std::vector<char> ok(n_used, 0);
+            for (decltype(chunks.size()) w = 0u; w < n_used; ++w) {
+                if (workers[w].m_pid == -1) {
+                    workers[w] = detail::ext_spawn(m_command);
+                }
+                ok[w] = send_chunk(workers[w], xs, chunks[w], nx);
+            }
+            // 2 - Collect the replies, in the same order.
+            for (decltype(chunks.size()) w = 0u; w < n_used; ++w) {
+                if (ok[w]) {
+                    ok[w] = recv_chunk(workers[w], retval, chunks[w], nf);
+                }
+            }
+            // 3 - Restart the workers which crashed, and evaluate their chunks again.
+            for (decltype(chunks.size()) w = 0u; w < n_used; ++w) {
+                for (unsigned attempt = 0u; !ok[w]; ++attempt) {
+                    if (attempt == m_max_restarts) {
+                        pagmo_throw(std::runtime_error, "The worker '" + m_command[0] + "' of an external problem "
+                                                            + "crashed after " + std::to_string(m_max_restarts)
+                                                            + " consecutive restarts");
+                    }
+                    detail::ext_stop(workers[w]);
+                    workers[w] = detail::ext_spawn(m_command);
+                    ++m_n_restarts;
+                    ok[w] = send_chunk(workers[w], xs, chunks[w], nx) && recv_chunk(workers[w], retval, chunks[w], nf);
+                }
+            }
+        } catch (...) {
+            // The replies still pending would corrupt the next evaluations: the workers involved are stopped,
+            // and they will be launched again when needed.
+            for (decltype(chunks.size()) w = 0u; w < n_used; ++w) {
+                detail::ext_stop(workers[w]);
+            }
+            throw;
+        }
+        return retval;
+    }
+
+    /// Box-bounds.
+    /**
+     * @return the box-bounds passed upon construction.
+     */
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return std::make_pair(m_lb, m_ub);
+    }
+    /// Number of objectives.
+    /**
+     * @return the number of objectives passed upon construction.
+     */
+    vector_double::size_type get_nobj() const
+    {
+        return m_nobj;
+    }
+    /// Number of equality constraints.
+    /**
+     * @return the number of equality constraints passed upon construction.
+     */
+    vector_double::size_type get_nec() const
+    {
+        return m_nec;
+    }
+    /// Number of inequality constraints.
+    /**
+     * @return the number of inequality constraints passed upon construction.
+     */
+    vector_double::size_type get_nic() const
+    {
+        return m_nic;
+    }
+    /// Command.
+    /**
+     * @return the command used to launch the workers.
+     */
+    const std::vector<std::string> &get_command() const
+    {
+        return m_command;
+    }
+    /// Number of workers.
+    /**
+     * @return the number of worker processes.
+     */
+    unsigned get_n_workers() const
+    {
+        return m_n_workers;
+    }
+    /// Number of restarts.
+    /**
+     * @return the number of times a crashed worker of \p this was restarted.
+     */
+    unsigned long long get_n_restarts() const
+    {
+        return m_n_restarts;
+    }
+    /// Problem name.
+    /**
+     * @return a string containing the problem name.
+     */
+    std::string get_name() const
+    {
+        return "External problem";
+    }
+    /// Extra info.
+    /**
+     * @return a string containing the command and the number of workers.
+     */
+    std::string get_extra_info() const
+    {
+        std::ostringstream oss;
+        oss << "\tCommand:";
+        for (const auto &arg : m_command) {
+            oss << ' ' << arg;
+        }
+        oss << "\n\tNumber of workers: " << m_n_workers;
+        oss << "\n\tMaximum number of consecutive restarts: " << m_max_restarts;
+        oss << "\n\tNumber of restarts: " << m_n_restarts << '\n';
+        return oss.str();
+    }
+    /// Save to archive.
+    /**
+     * This method will save \p this into the archive \p ar. The workers are not serialized.
+     *
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of primitive types and standard containers.
+     */
+    template <typename Archive>
+    void save(Archive &ar) const
+    {
+        ar(m_command, m_lb, m_ub, m_nobj, m_nec, m_nic, m_n_workers, m_max_restarts);
+    }
+    /// Load from archive.
+    /**
+     * This method will load \p this from the archive \p ar. The current workers, if any, are stopped.
+     *
+     * @param ar source archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of primitive types and standard containers.
+     */
+    template <typename Archive>
+    void load(Archive &ar)
+    {
+        external tmp;
+        ar(tmp.m_command, tmp.m_lb, tmp.m_ub, tmp.m_nobj, tmp.m_nec, tmp.m_nic, tmp.m_n_workers, tmp.m_max_restarts);
+        *this = std::move(tmp);
+    }
+
+private:
+    template <typename Chunk>
+    static bool send_chunk(const detail::ext_worker &w, const vector_double &xs, const Chunk &c,
+                           vector_double::size_type nx)
+    {
+        return detail::ext_write_message(w.m_fd, c.second, nx, xs.data() + c.first * nx, true);
+    }
+    template <typename Chunk>
+    bool recv_chunk(detail::ext_worker &w, vector_double &retval, const Chunk &c, vector_double::size_type nf) const
+    {
+        std::uint64_t header[2];
+        if (!detail::ext_read_all(w.m_fd, header, sizeof(header))) {
+            return false;
+        }
+        if (header[0] != c.second || header[1] != nf) {
+            pagmo_throw(std::invalid_argument, "The reply of the worker '" + m_command[0] + "' of an external "
+                                                   + "problem contains " + std::to_string(header[0])
+                                                   + " fitness vectors of dimension " + std::to_string(header[1])
+                                                   + ", while " + std::to_string(c.second)
+                                                   + " fitness vectors of dimension " + std::to_string(nf)
+                                                   + " were expected");
+        }
+        return detail::ext_read_all(w.m_fd, retval.data() + c.first * nf, c.second * nf * sizeof(double));
+    }
+
+    std::vector<std::string> m_command;
+    vector_double m_lb;
+    vector_double m_ub;
+    vector_double::size_type m_nobj;
+    vector_double::size_type m_nec;
+    vector_double::size_type m_nic;
+    unsigned m_n_workers;
+    unsigned m_max_restarts;
+    mutable unsigned long long m_n_restarts;
+    mutable std::unique_ptr<pool> m_pool;
+};
+
+/// Serve the requests of an external problem.
+/**
+ * This function implements the worker side of the protocol of pagmo::external: it reads the requests from the
+ * standard input until the end of file is reached, computes the fitness of each decision vector with \p f, and writes
+ * the replies on the standard output. A worker executable for pagmo::external can then be written as:
+ * @code{.unparsed}
+ * int main()
+ * {
+ *     pagmo::serve_external([](const pagmo::vector_double &x) { return my_simulator(x); });
+ * }
+ * @endcode
+ *
+ * @param f a callable computing the fitness vector of a decision vector.
+ *
+ * @return 0 if the end of the input was reached, 1 if the input or the output failed.
+ *
+ * @throws std::invalid_argument if the fitness vectors computed by \p f in a request do not all have the same size.
+ * @throws unspecified any exception thrown by \p f.
+ */
+template <typename F>
+inline int serve_external(F &&f)
+{
+    vector_double x, reply;
+    while (true) {
+        std::uint64_t header[2];
+        if (!detail::ext_read_all(0, header, sizeof(header))) {
+            return 0;
+        }
+        const auto n = static_cast<vector_double::size_type>(header[0]),
+                   nx = static_cast<vector_double::size_type>(header[1]);
+        vector_double xs(n * nx);
+        if (!detail::ext_read_all(0, xs.data(), xs.size() * sizeof(double))) {
+            return 1;
+        }
+        reply.clear();
+        vector_double::size_type nf = 0u;
+        for (decltype(xs.size()) i = 0u; i < n; ++i) {
+            x.assign(xs.data() + i * nx, xs.data() + (i + 1u) * nx);
+            const vector_double fit = f(x);
+            if (i == 0u) {
+                nf = fit.size();
+            } else if (fit.size() != nf) {
+                pagmo_throw(std::invalid_argument, "Fitness vectors of different sizes were computed in a request "
+                                                   "of an external problem");
+            }
+            reply.insert(reply.end(), fit.begin(), fit.end());
+        }
+        if (!detail::ext_write_message(1, n, nf, reply.data(), false)) {
+            return 1;
+        }
+    }
+}
+}
+
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::external)
+
+#endif
+
+#endif
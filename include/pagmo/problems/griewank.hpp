@@ -146,6 +146,6 @@ struct griewank {
 
 } // namespace pagmo
 
-PAGMO_REGISTER_PROBLEM(pagmo::griewank)
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::griewank)
 
 #endif
@@ -219,6 +219,6 @@ struct hock_schittkowsky_71 {
 };
 }
 
-PAGMO_REGISTER_PROBLEM(pagmo::hock_schittkowsky_71)
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::hock_schittkowsky_71)
 
 #endif
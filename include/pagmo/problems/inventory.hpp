@@ -194,6 +194,6 @@ private:
 
 } // namespace pagmo
 
-PAGMO_REGISTER_PROBLEM(pagmo::inventory)
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::inventory)
 
 #endif
@@ -218,6 +218,6 @@ struct rastrigin {
 
 } // namespace pagmo
 
-PAGMO_REGISTER_PROBLEM(pagmo::rastrigin)
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::rastrigin)
 
 #endif
@@ -136,6 +136,6 @@ struct rosenbrock {
 
 } // namespace pagmo
 
-PAGMO_REGISTER_PROBLEM(pagmo::rosenbrock)
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::rosenbrock)
 
 #endif
@@ -137,6 +137,6 @@ struct schwefel {
 
 } // namespace pagmo
 
-PAGMO_REGISTER_PROBLEM(pagmo::schwefel)
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::schwefel)
 
 #endif
@@ -265,6 +265,6 @@ private:
 };
 }
 
-PAGMO_REGISTER_PROBLEM(pagmo::translate)
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::translate)
 
 #endif
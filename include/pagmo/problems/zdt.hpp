@@ -526,6 +526,6 @@ private:
 };
 }
 
-PAGMO_REGISTER_PROBLEM(pagmo::zdt)
+PAGMO_REGISTER_BUILTIN_PROBLEM(pagmo::zdt)
 
 #endif
@@ -0,0 +1,387 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_STATIC_PROBLEM_HPP
+#define PAGMO_STATIC_PROBLEM_HPP
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "exceptions.hpp"
+#include "problem.hpp"
+#include "threading.hpp"
+#include "type_traits.hpp"
+#include "types.hpp"
+
+namespace pagmo
+{
+
+/// Statically-typed problem.
+/**
+ * This class is a counterpart of pagmo::problem which is not type-erased: it stores a user-defined
+ * problem (UDP) of type \p T by value and calls its methods directly, without the virtual dispatch of
+ * pagmo::problem. When an algorithm is instantiated on a concrete UDP type through this class (see, e.g.,
+ * de::evolve()), the calls to static_problem::fitness() can be inlined in the generation loop of the algorithm.
+ *
+ * The UDP requirements, the detection of the optional methods and the validation performed upon construction
+ * are the same as in pagmo::problem, and static_problem offers the same interface for the subset of
+ * the functionality which is typically used inside the generation loop of an algorithm. The decision and fitness
+ * vectors are still checked for consistency in static_problem::fitness().
+ *
+ * If \p T is a const lvalue reference to a UDP type (e.g., <tt>static_problem<const rosenbrock &></tt>), the
+ * static_problem is a view on a UDP owned elsewhere (e.g., by a pagmo::problem, see problem::extract()), which
+ * is not copied. The referenced UDP must outlive the view, and static_problem::set_seed() is not available.
+ *
+ * **NOTE**: differently from pagmo::problem, the evaluation counters of this class are not atomic. A
+ * static_problem is meant to be used by a single thread, typically as a local variable of an evolve() method.
+ */
+template <typename T>
+class static_problem
+{
+    // The type of the UDP (T itself, or the referenced type for a view).
+    using udp_type = uncvref_t<T>;
+    // The inner problem type of pagmo::problem, whose static checks and implementation
+    // helpers for the optional methods are shared with this class.
+    using inner = detail::prob_inner<udp_type>;
+    static_assert(std::is_same<T, udp_type>::value || std::is_same<T, const udp_type &>::value,
+                  "The UDP type must be either not cv or reference qualified, or a const lvalue reference.");
+    template <typename U>
+    using owning_enabler = enable_if_t<!std::is_reference<U>::value, int>;
+    template <typename U>
+    using view_enabler = enable_if_t<std::is_reference<U>::value, int>;
+
+public:
+    /// Default constructor.
+    /**
+     * The UDP is value-initialised. This constructor is not available for views.
+     *
+     * @throws std::invalid_argument in the same cases as the constructor from a UDP.
+     * @throws unspecified any exception thrown by the default constructor of the UDP or by methods of the UDP
+     * invoked during construction.
+     */
+    template <typename U = T, owning_enabler<U> = 0>
+    static_problem() : m_value()
+    {
+        init();
+    }
+    /// Constructor from a UDP.
+    /**
+     * The UDP is copied, or referenced if this is a view.
+     *
+     * @param x the UDP.
+     *
+     * @throws std::invalid_argument in the same cases as the constructor of pagmo::problem from a UDP (the sparsity
+     * patterns are not checked, as this class does not expose derivatives other than the gradient).
+     * @throws unspecified any exception thrown by methods of the UDP invoked during construction.
+     */
+    explicit static_problem(const udp_type &x) : m_value(x)
+    {
+        init();
+    }
+    /// Constructor from a UDP (move variant).
+    /**
+     * This constructor is deleted for views, which cannot refer to a temporary UDP.
+     *
+     * @param x the UDP.
+     *
+     * @throws std::invalid_argument in the same cases as the constructor from a const reference.
+     * @throws unspecified any exception thrown by methods of the UDP invoked during construction.
+     */
+    template <typename U = T, owning_enabler<U> = 0>
+    explicit static_problem(udp_type &&x) : m_value(std::move(x))
+    {
+        init();
+    }
+    template <typename U = T, view_enabler<U> = 0>
+    explicit static_problem(udp_type &&) = delete;
+
+    /// Access the UDP.
+    /**
+     * @return a const reference to the UDP.
+     */
+    const udp_type &get_udp() const
+    {
+        return m_value;
+    }
+
+    /// Fitness.
+    /**
+     * Same as problem::fitness(), with the UDP invoked directly.
+     *
+     * @param dv the decision vector.
+     *
+     * @return the fitness of \p dv.
+     *
+     * @throws std::invalid_argument if the lengths of \p dv or of the returned fitness vector are inconsistent.
+     * @throws unspecified any exception thrown by the <tt>%fitness()</tt> method of the UDP.
+     */
+    vector_double fitness(const vector_double &dv) const
+    {
+        if (dv.size() != m_lb.size()) {
+            pagmo_throw(std::invalid_argument, "Length of decision vector is " + std::to_string(dv.size())
+                                                   + ", should be " + std::to_string(m_lb.size()));
+        }
+        vector_double retval(m_value.fitness(dv));
+        if (retval.size() != get_nf()) {
+            pagmo_throw(std::invalid_argument, "Fitness length is: " + std::to_string(retval.size()) + ", should be "
+                                                   + std::to_string(get_nf()));
+        }
+        ++m_fevals;
+        return retval;
+    }
+
+    /// Gradient.
+    /**
+     * Same as problem::gradient(), with the UDP invoked directly.
+     *
+     * @param dv the decision vector.
+     *
+     * @return the gradient of \p dv.
+     *
+     * @throws std::invalid_argument if the lengths of \p dv or of the returned gradient vector are inconsistent.
+     * @throws not_implemented_error if the UDP does not satisfy pagmo::has_gradient.
+     * @throws unspecified any exception thrown by the <tt>%gradient()</tt> method of the UDP.
+     */
+    vector_double gradient(const vector_double &dv) const
+    {
+        if (dv.size() != m_lb.size()) {
+            pagmo_throw(std::invalid_argument, "Length of decision vector is " + std::to_string(dv.size())
+                                                   + ", should be " + std::to_string(m_lb.size()));
+        }
+        vector_double retval(inner::gradient_impl(m_value, dv));
+        if (retval.size() != m_gs_dim) {
+            pagmo_throw(std::invalid_argument, "Gradients returned: " + std::to_string(retval.size()) + ", should be "
+                                                   + std::to_string(m_gs_dim));
+        }
+        ++m_gevals;
+        return retval;
+    }
+
+    /// Check if the gradient is available in the UDP.
+    /**
+     * @return the same value as problem::has_gradient().
+     */
+    bool has_gradient() const
+    {
+        return inner::has_gradient_impl(m_value);
+    }
+
+    /// Box-bounds.
+    /**
+     * @return \f$ (\mathbf{lb}, \mathbf{ub}) \f$, the box-bounds, as returned by the <tt>%get_bounds()</tt> method of
+     * the UDP upon construction.
+     */
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return std::make_pair(m_lb, m_ub);
+    }
+    /// Lower bounds.
+    /**
+     * @return a const reference to the lower bounds.
+     */
+    const vector_double &get_lb() const
+    {
+        return m_lb;
+    }
+    /// Upper bounds.
+    /**
+     * @return a const reference to the upper bounds.
+     */
+    const vector_double &get_ub() const
+    {
+        return m_ub;
+    }
+
+    /// Number of objectives.
+    /**
+     * @return the number of objectives of the problem.
+     */
+    vector_double::size_type get_nobj() const
+    {
+        return m_nobj;
+    }
+    /// Dimension.
+    /**
+     * @return the dimension of the problem.
+     */
+    vector_double::size_type get_nx() const
+    {
+        return m_lb.size();
+    }
+    /// Fitness dimension.
+    /**
+     * @return the dimension of the fitness, which is the sum of the number of objectives and constraints.
+     */
+    vector_double::size_type get_nf() const
+    {
+        return m_nobj + m_nec + m_nic;
+    }
+    /// Number of equality constraints.
+    /**
+     * @return the number of equality constraints of the problem.
+     */
+    vector_double::size_type get_nec() const
+    {
+        return m_nec;
+    }
+    /// Number of inequality constraints.
+    /**
+     * @return the number of inequality constraints of the problem.
+     */
+    vector_double::size_type get_nic() const
+    {
+        return m_nic;
+    }
+    /// Total number of constraints.
+    /**
+     * @return the sum of the number of equality and inequality constraints.
+     */
+    vector_double::size_type get_nc() const
+    {
+        return m_nec + m_nic;
+    }
+
+    /// Number of fitness evaluations.
+    /**
+     * @return the number of times static_problem::fitness() was successfully called.
+     */
+    unsigned long long get_fevals() const
+    {
+        return m_fevals;
+    }
+    /// Number of gradient evaluations.
+    /**
+     * @return the number of times static_problem::gradient() was successfully called.
+     */
+    unsigned long long get_gevals() const
+    {
+        return m_gevals;
+    }
+
+    /// Set the seed for the stochastic variables.
+    /**
+     * This method is not available for views.
+     *
+     * @param seed seed.
+     *
+     * @throws not_implemented_error if the UDP does not satisfy pagmo::has_set_seed.
+     * @throws unspecified any exception thrown by the <tt>%set_seed()</tt> method of the UDP.
+     */
+    void set_seed(unsigned seed)
+    {
+        static_assert(!std::is_reference<T>::value, "The seed of the UDP cannot be set through a view.");
+        inner::set_seed_impl(m_value, seed);
+    }
+    /// Check if the UDP is stochastic.
+    /**
+     * @return the same value as problem::is_stochastic().
+     */
+    bool is_stochastic() const
+    {
+        return m_has_set_seed;
+    }
+    /// Problem's name.
+    /**
+     * @return the same value as problem::get_name().
+     */
+    std::string get_name() const
+    {
+        return m_name;
+    }
+    /// Problem's extra info.
+    /**
+     * @return the same value as problem::get_extra_info().
+     */
+    std::string get_extra_info() const
+    {
+        return inner::get_extra_info_impl(m_value);
+    }
+    /// Problem's thread safety level.
+    /**
+     * @return the same value as problem::get_thread_safety().
+     */
+    thread_safety get_thread_safety() const
+    {
+        return inner::get_thread_safety_impl(m_value);
+    }
+
+private:
+    void init()
+    {
+        auto bounds = m_value.get_bounds();
+        detail::check_problem_bounds(bounds);
+        m_lb = std::move(bounds.first);
+        m_ub = std::move(bounds.second);
+        m_nobj = inner::get_nobj_impl(m_value);
+        if (!m_nobj) {
+            pagmo_throw(std::invalid_argument, "The number of objectives cannot be zero");
+        }
+        if (m_nobj > std::numeric_limits<vector_double::size_type>::max() / 3u) {
+            pagmo_throw(std::invalid_argument, "The number of objectives is too large");
+        }
+        m_nec = inner::get_nec_impl(m_value);
+        if (m_nec > std::numeric_limits<vector_double::size_type>::max() / 3u) {
+            pagmo_throw(std::invalid_argument, "The number of equality constraints is too large");
+        }
+        m_nic = inner::get_nic_impl(m_value);
+        if (m_nic > std::numeric_limits<vector_double::size_type>::max() / 3u) {
+            pagmo_throw(std::invalid_argument, "The number of inequality constraints is too large");
+        }
+        // The expected length of the gradient, as in pagmo::problem.
+        if (inner::has_gradient_sparsity_impl(m_value)) {
+            m_gs_dim = inner::gradient_sparsity_impl(m_value).size();
+        } else {
+            if (get_nx() > std::numeric_limits<vector_double::size_type>::max() / get_nf()) {
+                pagmo_throw(std::invalid_argument, "The size of the (dense) gradient sparsity is too large");
+            }
+            m_gs_dim = get_nx() * get_nf();
+        }
+        m_has_set_seed = inner::has_set_seed_impl(m_value);
+        m_name = inner::get_name_impl(m_value);
+        m_fevals = 0u;
+        m_gevals = 0u;
+    }
+
+    T m_value;
+    vector_double m_lb;
+    vector_double m_ub;
+    vector_double::size_type m_nobj;
+    vector_double::size_type m_nec;
+    vector_double::size_type m_nic;
+    vector_double::size_type m_gs_dim;
+    bool m_has_set_seed;
+    std::string m_name;
+    mutable unsigned long long m_fevals;
+    mutable unsigned long long m_gevals;
+};
+}
+
+#endif
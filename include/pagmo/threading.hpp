@@ -38,8 +38,9 @@ namespace pagmo
  * the thread safety of problems, algorithms, etc.
  */
 enum class thread_safety {
-    none, ///< No thread safety: concurrent operations on distinct instances are unsafe
-    basic ///< Basic thread safety: concurrent operations on distinct instances are safe
+    none,    ///< No thread safety: concurrent operations on distinct instances are unsafe
+    basic,   ///< Basic thread safety: concurrent operations on distinct instances are safe
+    constant ///< Constant thread safety: concurrent const operations on the same instance are safe
 };
 }
 
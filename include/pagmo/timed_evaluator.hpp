@@ -0,0 +1,505 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_TIMED_EVALUATOR_HPP
+#define PAGMO_TIMED_EVALUATOR_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "eval_context.hpp"
+#include "exceptions.hpp"
+#include "numa.hpp"
+#include "problem.hpp"
+#include "threading.hpp"
+#include "types.hpp"
+
+namespace pagmo
+{
+
+/// What to do with an evaluation that exceeds its deadline.
+enum class timeout_policy {
+    penalty, ///< Assign the penalty fitness.
+    retry,   ///< Evaluate again with a new deadline, then assign the penalty fitness if all the retries time out.
+    drop     ///< Leave the fitness undefined (NaN), and mark the evaluation as dropped.
+};
+
+/// Outcome of an evaluation in a batch.
+enum class eval_status {
+    ok,        ///< The evaluation completed.
+    penalized, ///< The evaluation timed out and the penalty fitness was assigned.
+    dropped    ///< The evaluation timed out and was dropped.
+};
+
+namespace detail
+{
+
+// Completion signal shared by all the evaluations of an evaluator, together with the number of its evaluation
+// threads still running (including the abandoned ones).
+struct timed_signal {
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    unsigned m_running = 0u;
+};
+
+// State of a single evaluation. It is shared between the batch and the thread running the evaluation, as an
+// evaluation abandoned after its deadline may outlive the batch. The thread is counted as running until the
+// evaluation completes.
+struct timed_job {
+    timed_job(const problem &prob, vector_double x, eval_context ctx, std::shared_ptr<timed_signal> sig)
+        : m_prob(prob), m_x(std::move(x)), m_ctx(std::move(ctx)), m_sig(std::move(sig)), m_done(false)
+    {
+    }
+    void run()
+    {
+        vector_double f;
+        std::exception_ptr eptr;
+        try {
+            f = m_prob.fitness(m_x, m_ctx);
+        } catch (...) {
+            eptr = std::current_exception();
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_sig->m_mutex);
+            m_f = std::move(f);
+            m_eptr = eptr;
+            m_done = true;
+            --m_sig->m_running;
+        }
+        m_sig->m_cv.notify_all();
+    }
+    problem m_prob;
+    vector_double m_x;
+    eval_context m_ctx;
+    std::shared_ptr<timed_signal> m_sig;
+    // Protected by the mutex of m_sig.
+    bool m_done;
+    vector_double m_f;
+    std::exception_ptr m_eptr;
+};
+}
+
+/// Batch evaluator with per-evaluation timeouts.
+/**
+ * When evaluation times are heavy-tailed (e.g., a simulator that occasionally hangs on some inputs), a single
+ * straggler can hold up a whole batch of evaluations. This class evaluates a batch of decision vectors concurrently,
+ * giving each evaluation a pagmo::eval_context whose deadline is the configured timeout after the evaluation starts.
+ * An evaluation which has not completed by its deadline is handled according to a pagmo::timeout_policy, and the
+ * batch moves on without waiting for it.
+ *
+ * UDPs satisfying pagmo::has_context_fitness can poll the context and stop early when the deadline has passed.
+ * Evaluations of other UDPs cannot be interrupted: when they time out, their thread is detached and left to
+ * complete in the background on its own copy of the problem, and its result is discarded.
+ *
+ * Each evaluation runs on a copy of the problem in a separate thread, at most timed_evaluator::get_n_threads()
+ * at a time. An abandoned evaluation keeps its thread until it completes, also after the batch has been returned:
+ * new evaluations (of the same or of a later batch) are started only when the number of running threads
+ * (see timed_evaluator::get_n_running()) is below the limit, so that a UDP which keeps hanging cannot pile up threads.
+ * Copies of an evaluator share the limit. When all the threads are held by abandoned evaluations, the pending
+ * evaluations wait for a free thread at most for the timeout, after which they are handled as timed out.
+ *
+ * If the problem does not provide at least the pagmo::thread_safety::basic guarantee, the evaluations are instead
+ * run one after the other in the calling thread and on the problem itself: in that case only cooperative UDPs can
+ * time out, and late results of other UDPs are accepted.
+ *
+ * On NUMA machines, the evaluation threads can be pinned to the NUMA nodes in round-robin order (see
+ * timed_evaluator::set_numa_binding()), so that the copy of the problem used by each evaluation and the memory it
+ * allocates reside on the node running it.
+ *
+ * The fitness evaluation counter of the problem is increased by the number of completed evaluations.
+ */
+class timed_evaluator
+{
+public:
+    /// The result of the evaluation of a batch.
+    struct result_type {
+        /// The fitness vectors, concatenated one after the other (NaNs for the dropped evaluations).
+        vector_double f;
+        /// The outcome of each evaluation.
+        std::vector<eval_status> status;
+        /// The total number of evaluations that timed out, including those retried.
+        unsigned long long n_timeouts;
+    };
+    /// Constructor.
+    /**
+     * @param timeout the time (in seconds) allowed to each evaluation.
+     * @param policy what to do with the evaluations that time out.
+     * @param max_retries the maximum number of times an evaluation is retried under timeout_policy::retry.
+     * @param penalty the fitness assigned to the evaluations that time out under timeout_policy::penalty and
+     * timeout_policy::retry (if empty, every component will be <tt>std::numeric_limits<double>::max()</tt>).
+     * @param n_threads the maximum number of concurrent evaluations (if zero, the value returned by
+     * <tt>std::thread::hardware_concurrency()</tt>, or 1 if that is unknown).
+     *
+     * @throws std::invalid_argument if \p timeout is not finite and positive.
+     */
+    explicit timed_evaluator(double timeout, timeout_policy policy = timeout_policy::penalty, unsigned max_retries = 1u,
+                             vector_double penalty = {}, unsigned n_threads = 0u)
+        : m_timeout(timeout), m_policy(policy), m_max_retries(max_retries), m_penalty(std::move(penalty)),
+          m_n_threads(n_threads ? n_threads : std::max(1u, std::thread::hardware_concurrency())),
+          m_sig(std::make_shared<detail::timed_signal>())
+    {
+        if (!std::isfinite(timeout) || timeout <= 0.) {
+            pagmo_throw(std::invalid_argument, "The timeout must be finite and positive, while a value of "
+                                                   + std::to_string(timeout) + " was detected");
+        }
+    }
+    /// Evaluate a batch.
+    /**
+     * @param p the problem.
+     * @param xs the decision vectors, concatenated one after the other.
+     *
+     * @return the fitness vectors and the outcome of each evaluation.
+     *
+     * @throws std::invalid_argument if the size of \p xs is not a multiple of the problem dimension, or if the
+     * penalty is not empty and its size differs from the fitness dimension.
+     * @throws std::system_error if a thread cannot be started.
+     * @throws unspecified any exception, other than pagmo::eval_cancelled_error, thrown by problem::fitness(). In that
+     * case the evaluations still running are cancelled and abandoned, and those already completed are counted.
+     */
+    result_type evaluate(const problem &p, const vector_double &xs) const
+    {
+        const auto nx = p.get_nx(), nf = p.get_nf();
+        if (xs.size() % nx) {
+            pagmo_throw(std::invalid_argument, "The size of the batch of decision vectors (" + std::to_string(xs.size())
+                                                   + ") is not a multiple of the problem dimension ("
+                                                   + std::to_string(nx) + ")");
+        }
+        if (m_penalty.size() && m_penalty.size() != nf) {
+            pagmo_throw(std::invalid_argument, "The penalty has dimension " + std::to_string(m_penalty.size())
+                                                   + ", while the problem fitness has dimension "
+                                                   + std::to_string(nf));
+        }
+        const auto n = xs.size() / nx;
+        result_type retval{vector_double(n * nf, std::numeric_limits<double>::quiet_NaN()),
+                           std::vector<eval_status>(n, eval_status::ok), 0u};
+        const auto timeout = std::chrono::duration_cast<eval_context::clock::duration>(
+            std::chrono::duration<double>(m_timeout));
+        // Records the outcome of an evaluation, returns true if the evaluation must be retried.
+        auto on_timeout = [&retval, nf, this](vector_double::size_type i, unsigned attempt) {
+            ++retval.n_timeouts;
+            if (m_policy == timeout_policy::retry && attempt < m_max_retries) {
+                return true;
+            }
+            if (m_policy == timeout_policy::drop) {
+                retval.status[i] = eval_status::dropped;
+            } else {
+                retval.status[i] = eval_status::penalized;
+                for (decltype(retval.f.size()) j = 0u; j < nf; ++j) {
+                    retval.f[i * nf + j] = m_penalty.size() ? m_penalty[j] : std::numeric_limits<double>::max();
+                }
+            }
+            return false;
+        };
+        auto x_at = [&xs, nx](vector_double::size_type i) {
+            return vector_double(xs.begin() + static_cast<vector_double::difference_type>(i * nx),
+                                 xs.begin() + static_cast<vector_double::difference_type>((i + 1u) * nx));
+        };
+
+        if (p.get_thread_safety() < thread_safety::basic) {
+            // Sequential evaluations in the calling thread.
+            for (decltype(xs.size()) i = 0u; i < n; ++i) {
+                for (unsigned attempt = 0u;; ++attempt) {
+                    try {
+                        const auto f = p.fitness(x_at(i), eval_context{timeout});
+                        std::copy(f.begin(), f.end(),
+                                  retval.f.begin() + static_cast<vector_double::difference_type>(i * nf));
+                        break;
+                    } catch (const eval_cancelled_error &) {
+                        if (!on_timeout(i, attempt)) {
+                            break;
+                        }
+                    }
+                }
+            }
+            return retval;
+        }
+
+        // Concurrent evaluations, each in its own thread.
+        struct slot {
+            std::shared_ptr<detail::timed_job> job;
+            std::thread th;
+            vector_double::size_type idx;
+            unsigned attempt;
+        };
+        // Cancels and abandons the running evaluations if we exit early.
+        struct guard {
+            ~guard()
+            {
+                m_token.cancel();
+                for (auto &s : m_active) {
+                    if (s.th.joinable()) {
+                        s.th.detach();
+                    }
+                }
+            }
+            std::vector<slot> &m_active;
+            const cancellation_token &m_token;
+        };
+        const auto &sig = m_sig;
+        const cancellation_token token;
+        std::deque<std::pair<vector_double::size_type, unsigned>> queue;
+        for (decltype(xs.size()) i = 0u; i < n; ++i) {
+            queue.emplace_back(i, 0u);
+        }
+        std::vector<slot> active;
+        guard g{active, token};
+        unsigned long long n_done = 0u, n_started = 0u;
+        const auto &nodes = numa_nodes();
+        // Deadline of the wait for a free thread, when all the threads are held by abandoned evaluations.
+        auto stall_deadline = eval_context::clock::time_point::max();
+        while (queue.size() || active.size()) {
+            // 1 - Fill the free slots. The threads of the abandoned evaluations still hold their slots.
+            while (queue.size()) {
+                {
+                    std::lock_guard<std::mutex> lock(sig->m_mutex);
+                    if (sig->m_running >= m_n_threads) {
+                        break;
+                    }
+                    ++sig->m_running;
+                }
+                const auto next = queue.front();
+                queue.pop_front();
+                try {
+                    active.push_back(slot{nullptr, std::thread{}, next.first, next.second});
+                    if (m_numa) {
+                        const auto node
+                            = nodes[static_cast<std::vector<unsigned>::size_type>(n_started % nodes.size())];
+                        // The job is constructed in the pinned thread, so that the copies of the problem and of the
+                        // decision vector are allocated on its node. The batch waits for the job to be handed over
+                        // before moving on, as the thread refers to the arguments of evaluate() until then.
+                        using job_promise = std::promise<std::shared_ptr<detail::timed_job>>;
+                        job_promise prom;
+                        auto fut = prom.get_future();
+                        const auto idx = next.first;
+                        active.back().th = std::thread(
+                            [&p, &x_at, &sig, &token, idx, node, timeout](job_promise pr) {
+                                numa_bind_thread(node);
+                                std::shared_ptr<detail::timed_job> job;
+                                try {
+                                    job = std::make_shared<detail::timed_job>(p, x_at(idx),
+                                                                              eval_context{timeout, token}, sig);
+                                } catch (...) {
+                                    pr.set_exception(std::current_exception());
+                                    return;
+                                }
+                                pr.set_value(job);
+                                job->run();
+                            },
+                            std::move(prom));
+                        try {
+                            active.back().job = fut.get();
+                        } catch (...) {
+                            active.back().th.join();
+                            throw;
+                        }
+                    } else {
+                        auto job = std::make_shared<detail::timed_job>(p, x_at(next.first),
+                                                                       eval_context{timeout, token}, sig);
+                        active.back().job = job;
+                        active.back().th = std::thread([job]() { job->run(); });
+                    }
+                } catch (...) {
+                    // The slot is released if the thread could not be started.
+                    if (active.size() && !active.back().th.joinable()) {
+                        active.pop_back();
+                    }
+                    std::lock_guard<std::mutex> lock(sig->m_mutex);
+                    --sig->m_running;
+                    throw;
+                }
+                ++n_started;
+            }
+            // 2 - Wait for a completion, for the earliest deadline or (if evaluations are pending) for a slot.
+            auto earliest = eval_context::clock::time_point::max();
+            for (const auto &s : active) {
+                earliest = std::min(earliest, s.job->m_ctx.get_deadline());
+            }
+            // Nothing is running but abandoned evaluations, which may never complete: the wait is bounded by the
+            // timeout.
+            const bool stalled = active.empty();
+            if (!stalled) {
+                stall_deadline = eval_context::clock::time_point::max();
+            } else if (stall_deadline == eval_context::clock::time_point::max()) {
+                stall_deadline = eval_context::clock::now() + timeout;
+            }
+            earliest = std::min(earliest, stall_deadline);
+            std::vector<char> done(active.size(), 0);
+            bool slot_free;
+            {
+                std::unique_lock<std::mutex> lock(sig->m_mutex);
+                auto any_done = [&active, &queue, &sig, this]() {
+                    return std::any_of(active.begin(), active.end(), [](const slot &s) { return s.job->m_done; })
+                           || (queue.size() && sig->m_running < m_n_threads);
+                };
+                sig->m_cv.wait_until(lock, earliest, any_done);
+                for (decltype(active.size()) k = 0u; k < active.size(); ++k) {
+                    done[k] = static_cast<char>(active[k].job->m_done);
+                }
+                slot_free = sig->m_running < m_n_threads;
+            }
+            // 3 - Collect the completed evaluations and abandon the expired ones.
+            const auto now = eval_context::clock::now();
+            std::vector<slot> still_active;
+            std::exception_ptr error;
+            for (decltype(active.size()) k = 0u; k < active.size(); ++k) {
+                auto &s = active[k];
+                if (done[k]) {
+                    s.th.join();
+                    if (s.job->m_eptr) {
+                        try {
+                            std::rethrow_exception(s.job->m_eptr);
+                        } catch (const eval_cancelled_error &) {
+                            if (on_timeout(s.idx, s.attempt)) {
+                                queue.emplace_back(s.idx, s.attempt + 1u);
+                            }
+                        } catch (...) {
+                            if (!error) {
+                                error = std::current_exception();
+                            }
+                        }
+                    } else {
+                        std::copy(s.job->m_f.begin(), s.job->m_f.end(),
+                                  retval.f.begin() + static_cast<vector_double::difference_type>(s.idx * nf));
+                        ++n_done;
+                    }
+                } else if (now >= s.job->m_ctx.get_deadline()) {
+                    s.th.detach();
+                    if (on_timeout(s.idx, s.attempt)) {
+                        queue.emplace_back(s.idx, s.attempt + 1u);
+                    }
+                } else {
+                    still_active.push_back(std::move(s));
+                }
+            }
+            active = std::move(still_active);
+            if (error) {
+                // The completed evaluations are counted also if the batch fails.
+                detail::problem_counters::increment_fevals(p, n_done);
+                std::rethrow_exception(error);
+            }
+            if (stalled && !slot_free && now >= stall_deadline) {
+                // No thread was freed in time: the pending evaluations time out without being started.
+                decltype(queue) retries;
+                for (const auto &e : queue) {
+                    if (on_timeout(e.first, e.second)) {
+                        retries.emplace_back(e.first, e.second + 1u);
+                    }
+                }
+                queue = std::move(retries);
+                stall_deadline = eval_context::clock::time_point::max();
+            }
+        }
+        detail::problem_counters::increment_fevals(p, n_done);
+        return retval;
+    }
+    /// Get the timeout.
+    /**
+     * @return the time (in seconds) allowed to each evaluation.
+     */
+    double get_timeout() const
+    {
+        return m_timeout;
+    }
+    /// Get the timeout policy.
+    /**
+     * @return the timeout policy.
+     */
+    timeout_policy get_policy() const
+    {
+        return m_policy;
+    }
+    /// Get the maximum number of retries.
+    /**
+     * @return the maximum number of times an evaluation is retried under timeout_policy::retry.
+     */
+    unsigned get_max_retries() const
+    {
+        return m_max_retries;
+    }
+    /// Get the maximum number of concurrent evaluations.
+    /**
+     * @return the maximum number of concurrent evaluations.
+     */
+    unsigned get_n_threads() const
+    {
+        return m_n_threads;
+    }
+    /// Get the number of running evaluations.
+    /**
+     * @return the number of evaluation threads of \p this (and of its copies) still running, including those of the
+     * evaluations abandoned after their deadline.
+     */
+    unsigned get_n_running() const
+    {
+        std::lock_guard<std::mutex> lock(m_sig->m_mutex);
+        return m_sig->m_running;
+    }
+    /// Set the NUMA binding.
+    /**
+     * @param flag \p true to pin the evaluation threads to the NUMA nodes of the machine in round-robin order,
+     * \p false (the default) to let the operating system schedule them.
+     */
+    void set_numa_binding(bool flag)
+    {
+        m_numa = flag;
+    }
+    /// Get the NUMA binding.
+    /**
+     * @return \p true if the evaluation threads are pinned to the NUMA nodes, \p false otherwise.
+     */
+    bool get_numa_binding() const
+    {
+        return m_numa;
+    }
+
+private:
+    double m_timeout;
+    timeout_policy m_policy;
+    unsigned m_max_retries;
+    vector_double m_penalty;
+    unsigned m_n_threads;
+    bool m_numa = false;
+    // Shared with the evaluation threads, which may outlive this object.
+    std::shared_ptr<detail::timed_signal> m_sig;
+};
+}
+
+#endif
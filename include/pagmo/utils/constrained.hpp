@@ -118,7 +118,7 @@ std::pair<vector_double::size_type, double> test_ineq_constraints(It1 cineq_firs
  * @throws std::invalid_argument If the size of the \p tol is not exactly the size of \p f1 - 1
  */
 inline bool compare_fc(const vector_double &f1, const vector_double &f2, vector_double::size_type neq,
-                       const vector_double &tol)
+                              const vector_double &tol)
 {
     // 1 - The two fitness must have the same dimension
     if (f1.size() != f2.size()) {
@@ -216,8 +216,8 @@ inline bool compare_fc(const vector_double &f1, const vector_double &f2, vector_
  * @throws std::invalid_argument If the size of the \p tol is not exactly the size of \p input_f - 1
  *
  */
-std::vector<vector_double::size_type> sort_population_con(const std::vector<vector_double> &input_f,
-                                                          vector_double::size_type neq, const vector_double &tol)
+inline std::vector<vector_double::size_type> sort_population_con(const std::vector<vector_double> &input_f,
+                                                                 vector_double::size_type neq, const vector_double &tol)
 {
     auto N = input_f.size();
     /// Corner cases
@@ -253,8 +253,8 @@ std::vector<vector_double::size_type> sort_population_con(const std::vector<vect
  * @throws std::invalid_argument If the input fitness vectors do not have all the same size \f$n >=1\f$
  * @throws std::invalid_argument If \p neq is larger than \f$n - 1\f$ (too many constraints)
  */
-std::vector<vector_double::size_type> sort_population_con(const std::vector<vector_double> &input_f,
-                                                          vector_double::size_type neq, double tol = 0.)
+inline std::vector<vector_double::size_type> sort_population_con(const std::vector<vector_double> &input_f,
+                                                                 vector_double::size_type neq, double tol = 0.)
 {
     auto N = input_f.size();
     /// Corner cases
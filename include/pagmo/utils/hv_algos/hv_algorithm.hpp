@@ -26,16 +26,22 @@
 #define PAGMO_UTIL_HV_ALGORITHM_H
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <typeindex>
 #include <typeinfo>
 #include <vector>
 
+#include "../../detail/radix_sort.hpp"
+#include "../../detail/separate_compilation.hpp"
 #include "../../exceptions.hpp"
 #include "../../io.hpp"
 #include "../../population.hpp"
@@ -44,6 +50,304 @@
 namespace pagmo
 {
 
+namespace detail
+{
+
+// Returns a new generation number for a set of points. The numbers are unique within the process, so that a
+// workspace never confuses two sets of points living at the same address.
+inline unsigned long long hv_new_generation()
+{
+    static std::atomic<unsigned long long> counter(0u);
+    return ++counter;
+}
+}
+
+/// Read-only view on a set of points
+/**
+ * This class is a lightweight, non-owning and read-only view on a set of points (i.e., an
+ * <tt>std::vector<vector_double></tt>), optionally excluding one of them. It is used by the view-based methods of
+ * pagmo::hv_algorithm, which, contrary to their counterparts taking an <tt>std::vector<vector_double></tt>, never
+ * alter their input.
+ *
+ * The view does not own the points: the underlying set must outlive it.
+ */
+class hv_points_view
+{
+public:
+    /// Size type
+    using size_type = std::vector<vector_double>::size_type;
+    /// Constructor from a set of points
+    /**
+     * @param points the points to be viewed
+     */
+    explicit hv_points_view(const std::vector<vector_double> &points)
+        : m_points(&points), m_excluded(points.size()), m_size(points.size())
+    {
+    }
+    /// Constructor from a set of points, excluding one of them
+    /**
+     * @param points the points to be viewed
+     * @param excluded index (in \p points) of the point excluded from the view
+     *
+     * @throws std::invalid_argument if \p excluded is not a valid index in \p points
+     */
+    hv_points_view(const std::vector<vector_double> &points, size_type excluded)
+        : m_points(&points), m_excluded(excluded), m_size(points.size() - 1u)
+    {
+        if (excluded >= points.size()) {
+            pagmo_throw(std::invalid_argument, "The index of the excluded point (" + std::to_string(excluded)
+                                                   + ") is out of bounds (number of points is "
+                                                   + std::to_string(points.size()) + ")");
+        }
+    }
+    /// Number of points in the view
+    /**
+     * @return the number of points in the view
+     */
+    size_type size() const
+    {
+        return m_size;
+    }
+    /// Access a point of the view
+    /**
+     * @param i index of the point in the view (the excluded point, if any, is skipped)
+     *
+     * @return a const reference to the point
+     */
+    const vector_double &operator[](size_type i) const
+    {
+        return (*m_points)[i < m_excluded ? i : i + 1u];
+    }
+    /// Underlying set of points
+    /**
+     * @return a const reference to the viewed set of points, including the excluded point (if any)
+     */
+    const std::vector<vector_double> &get_points() const
+    {
+        return *m_points;
+    }
+    /// Check whether the view excludes a point
+    /**
+     * @return \p true if one of the points of the underlying set is excluded from the view
+     */
+    bool has_excluded() const
+    {
+        return m_size != m_points->size();
+    }
+    /// Check whether a point of the underlying set is excluded
+    /**
+     * @param idx index of a point in the underlying set
+     *
+     * @return \p true if the point at \p idx in the underlying set is not part of the view
+     */
+    bool excludes(size_type idx) const
+    {
+        return idx == m_excluded;
+    }
+
+private:
+    const std::vector<vector_double> *m_points;
+    // Index of the excluded point, equal to the size of the underlying set if none is excluded
+    size_type m_excluded;
+    size_type m_size;
+};
+
+/// Base class for the data cached by an algorithm in a pagmo::hv_workspace
+/**
+ * Algorithms storing their own data in a workspace (see hv_workspace::algorithm_data()) derive its type from this
+ * class.
+ */
+class hv_workspace_data
+{
+public:
+    /// Destructor
+    virtual ~hv_workspace_data()
+    {
+    }
+};
+
+/// Hypervolume workspace
+/**
+ * This class stores data that can be reused between hypervolume queries on the same set of points:
+ * - the orderings of the points along each axis, computed lazily on first request,
+ * - a buffer holding copies of the points for the algorithms that need to alter them,
+ * - the reference point and the type of algorithm for which the set of points has last been verified,
+ * - data specific to the algorithm used for the queries (see hv_workspace::algorithm_data()).
+ *
+ * A workspace is bound to one set of points, identified by its address and, optionally, by a generation number
+ * (see hv_workspace::bind()). The owner of a set of points can bump the generation number whenever the set is
+ * modified, so that the cached data is discarded on the next query (pagmo::hypervolume does so). Otherwise, the
+ * workspace must be cleared via hv_workspace::clear() whenever the set is modified. It is not thread safe:
+ * concurrent queries need distinct workspaces.
+ */
+class hv_workspace
+{
+public:
+    /// Size type
+    using size_type = std::vector<vector_double>::size_type;
+    /// Default constructor
+    hv_workspace() : m_points(nullptr), m_generation(0u), m_verified_algo(typeid(void))
+    {
+    }
+    /// Bind the workspace to a versioned set of points
+    /**
+     * Binds the workspace to \p points, discarding the cached data if the workspace was bound to another set of
+     * points or to another generation of \p points.
+     *
+     * @param points the set of points
+     * @param generation the generation number of \p points, to be changed by the owner of \p points whenever they
+     * are modified
+     */
+    void bind(const std::vector<vector_double> &points, unsigned long long generation)
+    {
+        if (m_points != &points || m_generation != generation) {
+            clear();
+            m_points = &points;
+            m_generation = generation;
+        }
+    }
+    /// Ordering of the points along an axis
+    /**
+     * Returns the indices of \p points sorted in ascending order with respect to the coordinate \p axis (ties are
+     * broken by the coordinates following \p axis). The ordering is computed on first request and cached.
+     *
+     * @param points the set of points this workspace is bound to
+     * @param axis the coordinate used for the ordering
+     *
+     * @return a const reference to the cached ordering
+     */
+    const std::vector<size_type> &sorted_order(const std::vector<vector_double> &points, vector_double::size_type axis)
+    {
+        bind(points);
+        if (m_orders.size() <= axis) {
+            m_orders.resize(axis + 1u);
+        }
+        auto &order = m_orders[axis];
+        if (order.size() != points.size()) {
+            order.resize(points.size());
+            std::iota(order.begin(), order.end(), size_type(0u));
+            if (order.size() >= detail::radix_sort_threshold) {
+                // Stable sorts, starting from the least significant coordinate.
+                for (auto i = points[0].size(); i > axis; --i) {
+                    detail::radix_sort_by_key(order.begin(), order.end(),
+                                              [&points, i](size_type idx) { return points[idx][i - 1u]; });
+                }
+            } else {
+                std::sort(order.begin(), order.end(), [&points, axis](size_type a, size_type b) {
+                    const auto &pa = points[a];
+                    const auto &pb = points[b];
+                    for (auto i = axis; i < pa.size(); ++i) {
+                        if (pa[i] != pb[i]) {
+                            return pa[i] < pb[i];
+                        }
+                    }
+                    return false;
+                });
+            }
+        }
+        return order;
+    }
+    /// Copy of a view in a reusable buffer
+    /**
+     * Copies the points of \p view into an internal buffer, which is returned and can be freely altered. The memory
+     * of the buffer is reused between calls, so that no allocation takes place once it is large enough.
+     *
+     * @param view the points to be copied
+     *
+     * @return a reference to the buffer
+     */
+    std::vector<vector_double> &points_buffer(const hv_points_view &view)
+    {
+        m_buffer.resize(view.size());
+        for (size_type i = 0u; i < view.size(); ++i) {
+            m_buffer[i].assign(view[i].begin(), view[i].end());
+        }
+        return m_buffer;
+    }
+    /// Algorithm-specific data
+    /**
+     * Returns the data of type \p T cached in the workspace for \p points. The data is default-constructed on first
+     * request, and whenever the cached data is of another type (i.e., it was stored by another algorithm). It is
+     * discarded, as all the other cached data, when the workspace is cleared or bound to another set of points.
+     *
+     * @param points the set of points this workspace is bound to
+     *
+     * @return a reference to the cached data
+     */
+    template <typename T>
+    T &algorithm_data(const std::vector<vector_double> &points)
+    {
+        static_assert(std::is_base_of<hv_workspace_data, T>::value,
+                      "The type of the algorithm data must derive from hv_workspace_data.");
+        bind(points);
+        auto ptr = dynamic_cast<T *>(m_algo_data.get());
+        if (!ptr) {
+            m_algo_data.reset(new T);
+            ptr = static_cast<T *>(m_algo_data.get());
+        }
+        return *ptr;
+    }
+    /// Check whether the points were already verified
+    /**
+     * @param points the set of points this workspace is bound to
+     * @param r_point the reference point
+     * @param algo_type the type of the algorithm
+     *
+     * @return \p true if \p points were last verified for \p r_point and an algorithm of type \p algo_type
+     */
+    bool is_verified(const std::vector<vector_double> &points, const vector_double &r_point,
+                     const std::type_info &algo_type) const
+    {
+        return m_points == &points && m_verified_algo == std::type_index(algo_type) && m_verified_r_point == r_point;
+    }
+    /// Record a verification
+    /**
+     * @param points the set of points this workspace is bound to
+     * @param r_point the reference point
+     * @param algo_type the type of the algorithm
+     */
+    void set_verified(const std::vector<vector_double> &points, const vector_double &r_point,
+                      const std::type_info &algo_type)
+    {
+        bind(points);
+        m_verified_r_point.assign(r_point.begin(), r_point.end());
+        m_verified_algo = std::type_index(algo_type);
+    }
+    /// Clear the workspace
+    /**
+     * Discards all cached data. The memory of the buffers is retained.
+     */
+    void clear()
+    {
+        for (auto &order : m_orders) {
+            order.clear();
+        }
+        m_verified_r_point.clear();
+        m_verified_algo = std::type_index(typeid(void));
+        m_algo_data.reset();
+        m_points = nullptr;
+        m_generation = 0u;
+    }
+
+private:
+    // Binds the workspace to a set of points, discarding the cached data if another set was in use.
+    void bind(const std::vector<vector_double> &points)
+    {
+        if (m_points != &points) {
+            clear();
+            m_points = &points;
+        }
+    }
+
+    const std::vector<vector_double> *m_points;
+    unsigned long long m_generation;
+    std::vector<std::vector<size_type>> m_orders;
+    std::vector<vector_double> m_buffer;
+    vector_double m_verified_r_point;
+    std::type_index m_verified_algo;
+    std::unique_ptr<hv_workspace_data> m_algo_data;
+};
+
 /// Base hypervolume algorithm class.
 /**
 * This class represents the abstract hypervolume algorithm used for computing
@@ -94,15 +398,20 @@ namespace pagmo
 * order to prevent
 * the computation in case of incompatible data.
 *
+* Each of the public methods above also has a view-based counterpart ('compute_view', 'exclusive_view',
+* 'least_contributor_view', 'greatest_contributor_view' and 'contributions_view') accepting a read-only
+* pagmo::hv_points_view and a pagmo::hv_workspace. By default, these copy the points into the buffer of the workspace
+* and call the corresponding method above. Algorithms able to work without altering their input should override them,
+* so that repeated queries on the same set of points neither copy the points nor recompute the data cached in the
+* workspace (e.g., the orderings of the points).
+*
 */
 class hv_algorithm
 {
 public:
     /// Destructor required for pure virtual methods
     hv_algorithm() = default;
-    virtual ~hv_algorithm()
-    {
-    }
+    virtual ~hv_algorithm();
     /// Default copy constructor
     hv_algorithm(const hv_algorithm &) = default;
     /// Default move constructor
@@ -120,17 +429,7 @@ public:
     * @return volume of hypercube defined by points a and b
     */
     static double volume_between(const vector_double &a, const vector_double &b,
-                                 vector_double::size_type dim_bound = 0u)
-    {
-        if (dim_bound == 0) {
-            dim_bound = a.size();
-        }
-        double volume = 1.0;
-        for (vector_double::size_type idx = 0u; idx < dim_bound; ++idx) {
-            volume *= (a[idx] - b[idx]);
-        }
-        return (volume < 0. ? -volume : volume);
-    }
+                                 vector_double::size_type dim_bound = 0u);
 
     /// Compute volume between two points
     /**
@@ -142,14 +441,7 @@ public:
     *
     * @return volume of hypercube defined by points a and b
     */
-    static double volume_between(double *a, double *b, vector_double::size_type size)
-    {
-        double volume = 1.0;
-        while (size--) {
-            volume *= (b[size] - a[size]);
-        }
-        return (volume < 0 ? -volume : volume);
-    }
+    static double volume_between(double *a, double *b, vector_double::size_type size);
 
     /// Compute method
     /**
@@ -178,18 +470,8 @@ public:
     *
     * @return exlusive hypervolume contributed by the individual at index p_idx
     */
-    virtual double exclusive(unsigned int p_idx, std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        if (points.size() == 1) {
-            return compute(points, r_point);
-        }
-        std::vector<vector_double> points_less;
-        points_less.reserve(points.size() - 1);
-        copy(points.begin(), points.begin() + p_idx, back_inserter(points_less));
-        copy(points.begin() + p_idx + 1, points.end(), back_inserter(points_less));
-
-        return compute(points, r_point) - compute(points_less, r_point);
-    }
+    virtual double exclusive(unsigned int p_idx, std::vector<vector_double> &points,
+                             const vector_double &r_point) const;
 
     /// Least contributor method
     /**
@@ -202,10 +484,8 @@ public:
     *
     * @return index of the least contributor
     */
-    virtual unsigned long long least_contributor(std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        return extreme_contributor(points, r_point, [](double a, double b) { return a < b; });
-    }
+    virtual unsigned long long least_contributor(std::vector<vector_double> &points,
+                                                 const vector_double &r_point) const;
 
     /// Greatest contributor method
     /**
@@ -219,10 +499,7 @@ public:
     * @return index of the greatest contributor
     */
     virtual unsigned long long greatest_contributor(std::vector<vector_double> &points,
-                                                    const vector_double &r_point) const
-    {
-        return extreme_contributor(points, r_point, [](double a, double b) { return a > b; });
-    }
+                                                    const vector_double &r_point) const;
 
     /// Contributions method
     /**
@@ -238,37 +515,81 @@ public:
     * @param r_point distinguished "reference point".
     * @return vector of exclusive contributions by every point
     */
-    virtual std::vector<double> contributions(std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        std::vector<double> c;
-        c.reserve(points.size());
+    virtual std::vector<double> contributions(std::vector<vector_double> &points, const vector_double &r_point) const;
 
-        // Trivial case
-        if (points.size() == 1) {
-            c.push_back(volume_between(points[0], r_point));
-            return c;
-        }
+    /// Compute method on a view
+    /**
+    * This method computes the hypervolume of the points in \p view without altering them.
+    *
+    * The default implementation copies the points into the buffer of \p ws and calls hv_algorithm::compute() on it.
+    * Algorithms able to work on read-only data should override it to avoid the copy, possibly reusing the data
+    * cached in \p ws.
+    *
+    * @param view the points for which the hypervolume is computed
+    * @param r_point reference point
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return The value of the hypervolume
+    */
+    virtual double compute_view(const hv_points_view &view, const vector_double &r_point, hv_workspace &ws) const;
 
-        // Compute the total hypervolume for the reference
-        std::vector<vector_double> points_cpy(points.begin(), points.end());
-        double hv_total = compute(points_cpy, r_point);
-
-        // Points[0] as a first candidate
-        points_cpy = std::vector<vector_double>(points.begin() + 1, points.end());
-        c.push_back(hv_total - compute(points_cpy, r_point));
-
-        // Check the remaining ones using the provided comparison function
-        for (unsigned int idx = 1u; idx < points.size(); ++idx) {
-            std::vector<vector_double> points_less;
-            points_less.reserve(points.size() - 1);
-            copy(points.begin(), points.begin() + idx, back_inserter(points_less));
-            copy(points.begin() + idx + 1, points.end(), back_inserter(points_less));
-            double delta = hv_total - compute(points_less, r_point);
-            c.push_back(delta);
-        }
+    /// Exclusive hypervolume method on a view
+    /**
+    * This method computes the exclusive hypervolume of the point at \p p_idx in \p view without altering the points.
+    *
+    * The default implementation copies the points into the buffer of \p ws and calls hv_algorithm::exclusive() on it.
+    *
+    * @param p_idx index of the individual in \p view
+    * @param view the points for which the hypervolume is computed
+    * @param r_point reference point
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return exlusive hypervolume contributed by the individual at index p_idx
+    */
+    virtual double exclusive_view(unsigned int p_idx, const hv_points_view &view, const vector_double &r_point,
+                                  hv_workspace &ws) const;
 
-        return c;
-    }
+    /// Least contributor method on a view
+    /**
+    * The default implementation copies the points into the buffer of \p ws and calls
+    * hv_algorithm::least_contributor() on it.
+    *
+    * @param view the points for which the hypervolume is computed
+    * @param r_point reference point
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return index of the least contributor
+    */
+    virtual unsigned long long least_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                      hv_workspace &ws) const;
+
+    /// Greatest contributor method on a view
+    /**
+    * The default implementation copies the points into the buffer of \p ws and calls
+    * hv_algorithm::greatest_contributor() on it.
+    *
+    * @param view the points for which the hypervolume is computed
+    * @param r_point reference point
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return index of the greatest contributor
+    */
+    virtual unsigned long long greatest_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                         hv_workspace &ws) const;
+
+    /// Contributions method on a view
+    /**
+    * The default implementation copies the points into the buffer of \p ws and calls hv_algorithm::contributions()
+    * on it.
+    *
+    * @param view the points for which the contributions are computed
+    * @param r_point reference point
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return vector of exclusive contributions by every point
+    */
+    virtual std::vector<double> contributions_view(const hv_points_view &view, const vector_double &r_point,
+                                                   hv_workspace &ws) const;
 
     /// Verification of input
     /**
@@ -293,10 +614,7 @@ public:
     *
     * @return name of the algorithm.
     */
-    virtual std::string get_name() const
-    {
-        return typeid(*this).name();
-    }
+    virtual std::string get_name() const;
 
 protected:
     /// Assert that reference point dominates every other point from the set.
@@ -308,40 +626,22 @@ protected:
     * @param points - vector of vector_doubles for which the hypervolume is computed
     * @param r_point - distinguished "reference point".
     */
-    void assert_minimisation(const std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        for (std::vector<vector_double>::size_type idx = 0; idx < points.size(); ++idx) {
-            bool outside_bounds = false;
-            bool all_equal = true;
+    void assert_minimisation(const std::vector<vector_double> &points, const vector_double &r_point) const;
 
-            for (vector_double::size_type f_idx = 0; f_idx < points[idx].size(); ++f_idx) {
-                outside_bounds |= (r_point[f_idx] < points[idx][f_idx]);
-                all_equal &= (r_point[f_idx] == points[idx][f_idx]);
-            }
-            if (all_equal || outside_bounds) {
-                // Prepare error message.
-                std::stringstream ss;
-                std::string str_p("("), str_r("(");
-                for (vector_double::size_type f_idx = 0; f_idx < points[idx].size(); ++f_idx) {
-                    str_p += std::to_string(points[idx][f_idx]);
-                    str_r += std::to_string(r_point[f_idx]);
-                    if (f_idx < points[idx].size() - 1) {
-                        str_p += ", ";
-                        str_r += ", ";
-                    } else {
-                        str_p += ")";
-                        str_r += ")";
-                    }
-                }
-                ss << "Reference point is invalid: another point seems to be outside the reference point boundary, or "
-                      "be equal to it:"
-                   << std::endl;
-                ss << " P[" << idx << "]\t= " << str_p << std::endl;
-                ss << " R\t= " << str_r << std::endl;
-                pagmo_throw(std::invalid_argument, ss.str());
-            }
-        }
-    }
+    /// Extreme contributor on a view
+    /**
+    * Helper for the algorithms overriding the view-based contributor methods: computes all contributions via
+    * hv_algorithm::contributions_view() and returns the index of the extreme one according to \p cmp_func.
+    *
+    * @param view the points for which the hypervolume is computed
+    * @param r_point reference point
+    * @param ws workspace bound to the set of points underlying \p view
+    * @param cmp_func comparison function
+    *
+    * @return index of the extreme contributor
+    */
+    unsigned long long extreme_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                hv_workspace &ws, bool (*cmp_func)(double, double)) const;
 
     /*! Possible result of a comparison between points */
     enum {
@@ -366,27 +666,7 @@ protected:
     *
     * @return the comparison result (1 - b dom a,2 - a dom b, 3 - a == b,4 - not comparable)
     */
-    static int dom_cmp(double *a, double *b, vector_double::size_type size)
-    {
-        for (vector_double::size_type i = 0; i < size; ++i) {
-            if (a[i] > b[i]) {
-                for (vector_double::size_type j = i + 1; j < size; ++j) {
-                    if (a[j] < b[j]) {
-                        return DOM_CMP_INCOMPARABLE;
-                    }
-                }
-                return DOM_CMP_B_DOMINATES_A;
-            } else if (a[i] < b[i]) {
-                for (vector_double::size_type j = i + 1; j < size; ++j) {
-                    if (a[j] > b[j]) {
-                        return DOM_CMP_INCOMPARABLE;
-                    }
-                }
-                return DOM_CMP_A_DOMINATES_B;
-            }
-        }
-        return DOM_CMP_A_B_EQUAL;
-    }
+    static int dom_cmp(double *a, double *b, vector_double::size_type size);
 
     /// Dominance comparison method
     /**
@@ -403,30 +683,7 @@ protected:
     *
     * @return the comparison result (1 - b dom a,2 - a dom b, 3 - a == b,4 - not comparable)
     */
-    static int dom_cmp(const vector_double &a, const vector_double &b, vector_double::size_type dim_bound = 0u)
-    {
-        if (dim_bound == 0u) {
-            dim_bound = a.size();
-        }
-        for (vector_double::size_type i = 0u; i < dim_bound; ++i) {
-            if (a[i] > b[i]) {
-                for (vector_double::size_type j = i + 1; j < dim_bound; ++j) {
-                    if (a[j] < b[j]) {
-                        return DOM_CMP_INCOMPARABLE;
-                    }
-                }
-                return DOM_CMP_B_DOMINATES_A;
-            } else if (a[i] < b[i]) {
-                for (vector_double::size_type j = i + 1; j < dim_bound; ++j) {
-                    if (a[j] > b[j]) {
-                        return DOM_CMP_INCOMPARABLE;
-                    }
-                }
-                return DOM_CMP_A_DOMINATES_B;
-            }
-        }
-        return DOM_CMP_A_B_EQUAL;
-    }
+    static int dom_cmp(const vector_double &a, const vector_double &b, vector_double::size_type dim_bound = 0u);
 
 private:
     /// Compute the extreme contributor
@@ -435,27 +692,257 @@ private:
     * hypervolume (depending on the  prodivded comparison function)
     */
     unsigned int extreme_contributor(std::vector<vector_double> &points, const vector_double &r_point,
-                                     bool (*cmp_func)(double, double)) const
-    {
-        // Trivial case
-        if (points.size() == 1u) {
-            return 0u;
+                                     bool (*cmp_func)(double, double)) const;
+};
+
+// Definitions of the member functions declared above (see detail/separate_compilation.hpp).
+#if defined(PAGMO_HEADER_DEFINITIONS)
+
+PAGMO_DECL hv_algorithm::~hv_algorithm()
+{
+}
+
+PAGMO_DECL double hv_algorithm::volume_between(const vector_double &a, const vector_double &b,
+                                               vector_double::size_type dim_bound)
+{
+    if (dim_bound == 0) {
+        dim_bound = a.size();
+    }
+    double volume = 1.0;
+    for (vector_double::size_type idx = 0u; idx < dim_bound; ++idx) {
+        volume *= (a[idx] - b[idx]);
+    }
+    return (volume < 0. ? -volume : volume);
+}
+
+PAGMO_DECL double hv_algorithm::volume_between(double *a, double *b, vector_double::size_type size)
+{
+    double volume = 1.0;
+    while (size--) {
+        volume *= (b[size] - a[size]);
+    }
+    return (volume < 0 ? -volume : volume);
+}
+
+PAGMO_DECL double hv_algorithm::exclusive(unsigned int p_idx, std::vector<vector_double> &points,
+                                          const vector_double &r_point) const
+{
+    if (points.size() == 1) {
+        return compute(points, r_point);
+    }
+    std::vector<vector_double> points_less;
+    points_less.reserve(points.size() - 1);
+    copy(points.begin(), points.begin() + p_idx, back_inserter(points_less));
+    copy(points.begin() + p_idx + 1, points.end(), back_inserter(points_less));
+
+    return compute(points, r_point) - compute(points_less, r_point);
+}
+
+PAGMO_DECL unsigned long long hv_algorithm::least_contributor(std::vector<vector_double> &points,
+                                                              const vector_double &r_point) const
+{
+    return extreme_contributor(points, r_point, [](double a, double b) { return a < b; });
+}
+
+PAGMO_DECL unsigned long long hv_algorithm::greatest_contributor(std::vector<vector_double> &points,
+                                                                 const vector_double &r_point) const
+{
+    return extreme_contributor(points, r_point, [](double a, double b) { return a > b; });
+}
+
+PAGMO_DECL std::vector<double> hv_algorithm::contributions(std::vector<vector_double> &points,
+                                                           const vector_double &r_point) const
+{
+    std::vector<double> c;
+    c.reserve(points.size());
+
+    // Trivial case
+    if (points.size() == 1) {
+        c.push_back(volume_between(points[0], r_point));
+        return c;
+    }
+
+    // Compute the total hypervolume for the reference
+    std::vector<vector_double> points_cpy(points.begin(), points.end());
+    double hv_total = compute(points_cpy, r_point);
+
+    // Points[0] as a first candidate
+    points_cpy = std::vector<vector_double>(points.begin() + 1, points.end());
+    c.push_back(hv_total - compute(points_cpy, r_point));
+
+    // Check the remaining ones using the provided comparison function
+    for (unsigned int idx = 1u; idx < points.size(); ++idx) {
+        std::vector<vector_double> points_less;
+        points_less.reserve(points.size() - 1);
+        copy(points.begin(), points.begin() + idx, back_inserter(points_less));
+        copy(points.begin() + idx + 1, points.end(), back_inserter(points_less));
+        double delta = hv_total - compute(points_less, r_point);
+        c.push_back(delta);
+    }
+
+    return c;
+}
+
+PAGMO_DECL double hv_algorithm::compute_view(const hv_points_view &view, const vector_double &r_point,
+                                             hv_workspace &ws) const
+{
+    return compute(ws.points_buffer(view), r_point);
+}
+
+PAGMO_DECL double hv_algorithm::exclusive_view(unsigned int p_idx, const hv_points_view &view,
+                                               const vector_double &r_point, hv_workspace &ws) const
+{
+    return exclusive(p_idx, ws.points_buffer(view), r_point);
+}
+
+PAGMO_DECL unsigned long long hv_algorithm::least_contributor_view(const hv_points_view &view,
+                                                                   const vector_double &r_point, hv_workspace &ws) const
+{
+    return least_contributor(ws.points_buffer(view), r_point);
+}
+
+PAGMO_DECL unsigned long long hv_algorithm::greatest_contributor_view(const hv_points_view &view,
+                                                                      const vector_double &r_point,
+                                                                      hv_workspace &ws) const
+{
+    return greatest_contributor(ws.points_buffer(view), r_point);
+}
+
+PAGMO_DECL std::vector<double> hv_algorithm::contributions_view(const hv_points_view &view,
+                                                                const vector_double &r_point, hv_workspace &ws) const
+{
+    return contributions(ws.points_buffer(view), r_point);
+}
+
+PAGMO_DECL std::string hv_algorithm::get_name() const
+{
+    return typeid(*this).name();
+}
+
+PAGMO_DECL void hv_algorithm::assert_minimisation(const std::vector<vector_double> &points,
+                                                  const vector_double &r_point) const
+{
+    for (std::vector<vector_double>::size_type idx = 0; idx < points.size(); ++idx) {
+        bool outside_bounds = false;
+        bool all_equal = true;
+
+        for (vector_double::size_type f_idx = 0; f_idx < points[idx].size(); ++f_idx) {
+            outside_bounds |= (r_point[f_idx] < points[idx][f_idx]);
+            all_equal &= (r_point[f_idx] == points[idx][f_idx]);
         }
+        if (all_equal || outside_bounds) {
+            // Prepare error message.
+            std::stringstream ss;
+            std::string str_p("("), str_r("(");
+            for (vector_double::size_type f_idx = 0; f_idx < points[idx].size(); ++f_idx) {
+                str_p += std::to_string(points[idx][f_idx]);
+                str_r += std::to_string(r_point[f_idx]);
+                if (f_idx < points[idx].size() - 1) {
+                    str_p += ", ";
+                    str_r += ", ";
+                } else {
+                    str_p += ")";
+                    str_r += ")";
+                }
+            }
+            ss << "Reference point is invalid: another point seems to be outside the reference point boundary, or "
+                  "be equal to it:"
+               << std::endl;
+            ss << " P[" << idx << "]\t= " << str_p << std::endl;
+            ss << " R\t= " << str_r << std::endl;
+            pagmo_throw(std::invalid_argument, ss.str());
+        }
+    }
+}
 
-        std::vector<double> c = contributions(points, r_point);
+PAGMO_DECL unsigned long long hv_algorithm::extreme_contributor_view(const hv_points_view &view,
+                                                                     const vector_double &r_point, hv_workspace &ws,
+                                                                     bool (*cmp_func)(double, double)) const
+{
+    if (view.size() == 1u) {
+        return 0u;
+    }
+    const auto c = contributions_view(view, r_point, ws);
+    unsigned long long idx_extreme = 0u;
+    for (decltype(c.size()) idx = 1u; idx < c.size(); ++idx) {
+        if (cmp_func(c[idx], c[idx_extreme])) {
+            idx_extreme = idx;
+        }
+    }
+    return idx_extreme;
+}
 
-        unsigned int idx_extreme = 0u;
+PAGMO_DECL int hv_algorithm::dom_cmp(double *a, double *b, vector_double::size_type size)
+{
+    for (vector_double::size_type i = 0; i < size; ++i) {
+        if (a[i] > b[i]) {
+            for (vector_double::size_type j = i + 1; j < size; ++j) {
+                if (a[j] < b[j]) {
+                    return DOM_CMP_INCOMPARABLE;
+                }
+            }
+            return DOM_CMP_B_DOMINATES_A;
+        } else if (a[i] < b[i]) {
+            for (vector_double::size_type j = i + 1; j < size; ++j) {
+                if (a[j] > b[j]) {
+                    return DOM_CMP_INCOMPARABLE;
+                }
+            }
+            return DOM_CMP_A_DOMINATES_B;
+        }
+    }
+    return DOM_CMP_A_B_EQUAL;
+}
 
-        // Check the remaining ones using the provided comparison function
-        for (unsigned int idx = 1u; idx < c.size(); ++idx) {
-            if (cmp_func(c[idx], c[idx_extreme])) {
-                idx_extreme = idx;
+PAGMO_DECL int hv_algorithm::dom_cmp(const vector_double &a, const vector_double &b, vector_double::size_type dim_bound)
+{
+    if (dim_bound == 0u) {
+        dim_bound = a.size();
+    }
+    for (vector_double::size_type i = 0u; i < dim_bound; ++i) {
+        if (a[i] > b[i]) {
+            for (vector_double::size_type j = i + 1; j < dim_bound; ++j) {
+                if (a[j] < b[j]) {
+                    return DOM_CMP_INCOMPARABLE;
+                }
+            }
+            return DOM_CMP_B_DOMINATES_A;
+        } else if (a[i] < b[i]) {
+            for (vector_double::size_type j = i + 1; j < dim_bound; ++j) {
+                if (a[j] > b[j]) {
+                    return DOM_CMP_INCOMPARABLE;
+                }
             }
+            return DOM_CMP_A_DOMINATES_B;
         }
+    }
+    return DOM_CMP_A_B_EQUAL;
+}
 
-        return idx_extreme;
+PAGMO_DECL unsigned int hv_algorithm::extreme_contributor(std::vector<vector_double> &points,
+                                                          const vector_double &r_point,
+                                                          bool (*cmp_func)(double, double)) const
+{
+    // Trivial case
+    if (points.size() == 1u) {
+        return 0u;
     }
-};
+
+    std::vector<double> c = contributions(points, r_point);
+
+    unsigned int idx_extreme = 0u;
+
+    // Check the remaining ones using the provided comparison function
+    for (unsigned int idx = 1u; idx < c.size(); ++idx) {
+        if (cmp_func(c[idx], c[idx_extreme])) {
+            idx_extreme = idx;
+        }
+    }
+
+    return idx_extreme;
+}
+
+#endif
 
 } // namespace pagmo
 
@@ -31,6 +31,7 @@
 #include <string>
 #include <vector>
 
+#include "../../detail/separate_compilation.hpp"
 #include "../../exceptions.hpp"
 #include "../../io.hpp"
 #include "../../population.hpp"
@@ -72,18 +73,7 @@ public:
     */
     bf_approx(bool use_exact = true, unsigned int trivial_subcase_size = 1, double eps = 1e-2, double delta = 1e-6,
               double delta_multiplier = 0.775, double alpha = 0.2, double initial_delta_coeff = 0.1,
-              double gamma = 0.25, unsigned int seed = pagmo::random_device::next())
-        : m_use_exact(use_exact), m_trivial_subcase_size(trivial_subcase_size), m_eps(eps), m_delta(delta),
-          m_delta_multiplier(delta_multiplier), m_alpha(alpha), m_initial_delta_coeff(initial_delta_coeff),
-          m_gamma(gamma), m_e(seed)
-    {
-        if (eps < 0 || eps > 1) {
-            pagmo_throw(std::invalid_argument, "Epsilon needs to be a probability.");
-        }
-        if (delta < 0 || delta > 1) {
-            pagmo_throw(std::invalid_argument, "Delta needs to be a probability.");
-        }
-    }
+              double gamma = 0.25, unsigned int seed = pagmo::random_device::next());
 
     /// Compute hypervolume
     /**
@@ -92,11 +82,7 @@ public:
     * @return Nothing as it throws before.
     * @throws std::invalid_argument whenever called
     */
-    double compute(std::vector<vector_double> &, const vector_double &) const
-    {
-        pagmo_throw(std::invalid_argument,
-                    "This algorithm can just approximate extreme contributions but not the hypervolume itself.");
-    }
+    double compute(std::vector<vector_double> &, const vector_double &) const;
 
     /// Least contributor method
     /**
@@ -108,11 +94,7 @@ public:
     *
     * @return index of the least contributing point
     */
-    unsigned long long least_contributor(std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        return approx_extreme_contributor(points, r_point, LEAST, [](double a, double b) { return a < b; },
-                                          lc_erase_condition, lc_end_condition);
-    }
+    unsigned long long least_contributor(std::vector<vector_double> &points, const vector_double &r_point) const;
 
     /// Greatest contributor method
     /**
@@ -124,11 +106,7 @@ public:
     *
     * @return index of the greatest contributing point
     */
-    unsigned long long greatest_contributor(std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        return approx_extreme_contributor(points, r_point, GREATEST, [](double a, double b) { return a > b; },
-                                          gc_erase_condition, gc_end_condition);
-    }
+    unsigned long long greatest_contributor(std::vector<vector_double> &points, const vector_double &r_point) const;
 
     /// Verify before compute method
     /**
@@ -139,28 +117,19 @@ public:
     *
     * @throws value_error when trying to compute the hypervolume for the non-maximal reference point
     */
-    void verify_before_compute(const std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        hv_algorithm::assert_minimisation(points, r_point);
-    }
+    void verify_before_compute(const std::vector<vector_double> &points, const vector_double &r_point) const;
 
     /// Clone method.
     /**
      * @return a pointer to a new object cloning this
      */
-    std::shared_ptr<hv_algorithm> clone() const
-    {
-        return std::shared_ptr<hv_algorithm>(new bf_approx(*this));
-    }
+    std::shared_ptr<hv_algorithm> clone() const;
 
     /// Algorithm name
     /**
      * @return The name of this particular algorithm
      */
-    std::string get_name() const
-    {
-        return "Bringmann-Friedrich approximation method";
-    }
+    std::string get_name() const;
 
 private:
     /// Compute delta for given point
@@ -168,11 +137,7 @@ private:
     * Uses chernoff inequality as it was proposed in the article by Bringmann and Friedrich
     * The parameters of the method are taked from the Shark implementation of the algorithm.
     */
-    double compute_point_delta(unsigned int round_no, vector_double::size_type idx, double log_factor) const
-    {
-        return std::sqrt(0.5 * ((1. + m_gamma) * std::log(static_cast<double>(round_no)) + log_factor)
-                         / (static_cast<double>(m_no_samples[idx])));
-    }
+    double compute_point_delta(unsigned int round_no, vector_double::size_type idx, double log_factor) const;
 
     /// Compute bounding box method
     /* Find the MINIMAL (in terms of volume) bounding box that contains all the exclusive hypervolume contributed by
@@ -187,40 +152,7 @@ private:
     * @return fitness_vector describing the opposite corner of the bounding box
     */
     vector_double compute_bounding_box(const std::vector<vector_double> &points, const vector_double &r_point,
-                                       vector_double::size_type p_idx) const
-    {
-        // z is the opposite corner of the bounding box (reference point as a 'safe' first candidate - this is the
-        // MAXIMAL bounding box as of yet)
-        vector_double z(r_point);
-
-        // Below we perform a reduction to the minimal bounding box.
-        // We check whether given point at 'idx' is DOMINATED (strong domination) by 'p_idx' in exactly one objective,
-        // and DOMINATING (weak domination) in the remaining ones.
-        const vector_double &p = points[p_idx];
-        vector_double::size_type worse_dim_idx = 0u;
-        auto f_dim = r_point.size();
-        for (decltype(points.size()) idx = 0u; idx < points.size(); ++idx) {
-            auto flag = false; // initiate the possible opposite point dimension by -1 (no candidate)
-
-            for (decltype(f_dim) f_idx = 0u; f_idx < f_dim; ++f_idx) {
-                if (points[idx][f_idx] >= p[f_idx]) { // if any point is worse by given dimension, it's the potential
-                                                      // dimension in which we reduce the box
-                    if (flag) {       // if given point is already worse in any previous dimension, skip to
-                                      // next point as it's a bad candidate
-                        flag = false; // set the result to "no candidate" and break
-                        break;
-                    }
-                    worse_dim_idx = f_idx;
-                    flag = true;
-                }
-            }
-            if (flag) { // if given point was worse only in one dimension it's the potential candidate
-                        // for the bouding box reductor
-                z[worse_dim_idx] = std::min(z[worse_dim_idx], points[idx][worse_dim_idx]); // reduce the bounding box
-            }
-        }
-        return z;
-    }
+                                       vector_double::size_type p_idx) const;
 
     /// Determine whether point 'p' influences the volume of box (a, b)
     /**
@@ -229,118 +161,14 @@ private:
     * return 2 - point p dominates the point a (in which case, contribution by box (a, b) is guaranteed to be 0)
     * return 3 - point p is equal to point a (box (a, b) also contributes 0 hypervolume)
     */
-    int point_in_box(const vector_double &p, const vector_double &a, const vector_double &b) const
-    {
-        int cmp_a_p = hv_algorithm::dom_cmp(a, p, 0);
-
-        // point a is equal to point p (duplicate)
-        if (cmp_a_p == 3) {
-            return 3;
-            // point a is dominated by p (a is the least contributor)
-        } else if (cmp_a_p == 1) {
-            return 2;
-        } else if (hv_algorithm::dom_cmp(b, p, 0) == 1) {
-            return 1;
-        } else {
-            return 0;
-        }
-    }
+    int point_in_box(const vector_double &p, const vector_double &a, const vector_double &b) const;
 
     /// Performs a single round of sampling for given point at index 'idx'
     void sampling_round(const std::vector<vector_double> &points, double delta, unsigned int round,
-                        vector_double::size_type idx, double log_factor) const
-    {
-        if (m_use_exact) {
-            // if the sampling for given point was already resolved using exact method
-            if (m_no_ops[idx] == 0) {
-                return;
-            }
-
-            // if the exact computation is trivial OR when the sampling takes too long in terms of elementary operations
-            if (m_box_points[idx].size() <= m_trivial_subcase_size
-                || static_cast<double>(m_no_ops[idx])
-                       >= detail::expected_hv_operations(m_box_points[idx].size(), points[0].size())) {
-                const std::vector<vector_double::size_type> &bp = m_box_points[idx];
-                if (bp.size() == 0u) {
-                    m_approx_volume[idx] = m_box_volume[idx];
-                } else {
-
-                    auto f_dim = points[0].size();
-
-                    const vector_double &p = points[idx];
-
-                    std::vector<vector_double> sub_front(bp.size(), vector_double(f_dim, 0.0));
-
-                    for (decltype(sub_front.size()) p_idx = 0u; p_idx < sub_front.size(); ++p_idx) {
-                        for (decltype(sub_front[0].size()) d_idx = 0u; d_idx < sub_front[0].size(); ++d_idx) {
-                            sub_front[p_idx][d_idx] = std::max(p[d_idx], points[bp[p_idx]][d_idx]);
-                        }
-                    }
-
-                    const vector_double &refpoint = m_boxes[idx];
-                    hypervolume hv_obj = hypervolume(sub_front, false);
-                    hv_obj.set_copy_points(false);
-                    double hv = hv_obj.compute(refpoint);
-                    m_approx_volume[idx] = m_box_volume[idx] - hv;
-                }
-
-                m_point_delta[idx] = 0.0;
-                m_no_ops[idx] = 0;
-
-                return;
-            }
-        }
-
-        double tmp = m_box_volume[idx] / delta;
-        double required_no_samples = 0.5 * ((1. + m_gamma) * std::log(round) + log_factor) * tmp * tmp;
-
-        while (static_cast<double>(m_no_samples[idx]) < required_no_samples) {
-            ++m_no_samples[idx];
-            if (sample_successful(points, idx)) {
-                ++m_no_succ_samples[idx];
-            }
-        }
-
-        m_approx_volume[idx]
-            = static_cast<double>(m_no_succ_samples[idx]) / static_cast<double>(m_no_samples[idx]) * m_box_volume[idx];
-        m_point_delta[idx] = compute_point_delta(round, idx, log_factor) * m_box_volume[idx];
-    }
+                        vector_double::size_type idx, double log_factor) const;
 
     /// samples the bounding box and returns true if it fell into the exclusive hypervolume
-    bool sample_successful(const std::vector<vector_double> &points, vector_double::size_type idx) const
-    {
-        const vector_double &lb = points[idx];
-        const vector_double &ub = m_boxes[idx];
-        vector_double rnd_p(lb.size(), 0.0);
-
-        for (decltype(lb.size()) i = 0u; i < lb.size(); ++i) {
-            auto V_dist = std::uniform_real_distribution<double>(lb[i], ub[i]);
-            rnd_p[i] = V_dist(m_e);
-        }
-
-        for (decltype(m_box_points[idx].size()) i = 0u; i < m_box_points[idx].size(); ++i) {
-
-            // box_p is a point overlapping the bounding box volume
-            const vector_double &box_p = points[m_box_points[idx][i]];
-
-            // assume that box_p DOMINATES the random point and try to prove it otherwise below
-            bool dominates = true;
-
-            // increase the number of operations by the dimension size
-            m_no_ops[idx] += box_p.size() + 1;
-            for (decltype(box_p.size()) d_idx = 0u; d_idx < box_p.size(); ++d_idx) {
-                if (rnd_p[d_idx] < box_p[d_idx]) { // box_p does not dominate rnd_p
-                    dominates = false;
-                    break;
-                }
-            }
-            // if the box_p dominated the rnd_p return the sample as false
-            if (dominates) {
-                return false;
-            }
-        }
-        return true;
-    }
+    bool sample_successful(const std::vector<vector_double> &points, vector_double::size_type idx) const;
 
     enum extreme_contrib_type { LEAST = 1, GREATEST = 2 };
 
@@ -373,155 +201,20 @@ private:
         bool (*cmp_func)(double, double),
         bool (*erase_condition)(vector_double::size_type, vector_double::size_type, vector_double &, vector_double &),
         double (*end_condition)(vector_double::size_type, vector_double::size_type, vector_double &,
-                                vector_double &)) const
-    {
-        m_no_samples = std::vector<vector_double::size_type>(points.size(), 0);
-        m_no_succ_samples = std::vector<vector_double::size_type>(points.size(), 0);
-        m_no_ops = std::vector<vector_double::size_type>(points.size(), 1);
-        m_point_set = std::vector<vector_double::size_type>(points.size(), 0);
-        m_box_volume = vector_double(points.size(), 0.0);
-        m_approx_volume = vector_double(points.size(), 0.0);
-        m_point_delta = vector_double(points.size(), 0.0);
-        m_boxes = std::vector<vector_double>(points.size());
-        m_box_points = std::vector<std::vector<vector_double::size_type>>(points.size());
-
-        // precomputed log factor for the point delta computation
-        const double log_factor
-            = std::log(2. * static_cast<double>(points.size()) * (1. + m_gamma) / (m_delta * m_gamma));
-
-        // round counter
-        unsigned int round_no = 0u;
-
-        // round delta
-        double r_delta = 0.0;
-
-        bool stop_condition = false;
-
-        // index of extreme contributor
-        vector_double::size_type EC = 0u;
-
-        // put every point into the set
-        for (decltype(m_point_set.size()) i = 0u; i < m_point_set.size(); ++i) {
-            m_point_set[i] = i;
-        }
-
-        // Initial computation
-        // - compute bounding boxes and their hypervolume
-        // - set round Delta as max of hypervolumes
-        // - determine points overlapping with each bounding box
-        for (decltype(points.size()) idx = 0u; idx < points.size(); ++idx) {
-            m_boxes[idx] = compute_bounding_box(points, r_point, idx);
-            m_box_volume[idx] = hv_algorithm::volume_between(points[idx], m_boxes[idx]);
-            r_delta = std::max(r_delta, m_box_volume[idx]);
-
-            for (decltype(points.size()) idx2 = 0u; idx2 < points.size(); ++idx2) {
-                if (idx == idx2) {
-                    continue;
-                }
-                int op = point_in_box(points[idx2], points[idx], m_boxes[idx]);
-                if (op == 1) {
-                    m_box_points[idx].push_back(idx2);
-                } else if (ec_type == LEAST) {
-                    // Execute extra checks specifically for the least contributor
-                    switch (op) {
-                        case 2:
-                            // since contribution by idx is guaranteed to be 0.0 (as the point is dominated) we might as
-                            // well return it as the least contributor right away
-                            return idx;
-                        case 3:
-                            // points at idx and idx2 are equal, each of them will contribute 0.0 hypervolume, return
-                            // idx as the least contributor
-                            return idx;
-                        default:
-                            break;
-                    }
-                }
-            }
-        }
-
-        // decrease the initial maximum volume by a constant factor
-        r_delta *= m_initial_delta_coeff;
-
-        // Main loop
-        do {
-            r_delta *= m_delta_multiplier;
-            ++round_no;
-
-            for (decltype(m_point_set.size()) _i = 0u; _i < m_point_set.size(); ++_i) {
-                auto idx = m_point_set[_i];
-                sampling_round(points, r_delta, round_no, idx, log_factor);
-            }
-
-            // sample the extreme contributor
-            sampling_round(points, m_alpha * r_delta, round_no, EC, log_factor);
-
-            // find the new extreme contributor
-            for (decltype(m_point_set.size()) _i = 0u; _i < m_point_set.size(); ++_i) {
-                auto idx = m_point_set[_i];
-                if (cmp_func(m_approx_volume[idx], m_approx_volume[EC])) {
-                    EC = idx;
-                }
-            }
-
-            // erase known non-extreme contributors
-            // std::vector<unsigned int>::iterator it = m_point_set.begin();
-            auto it = m_point_set.begin();
-            while (it != m_point_set.end()) {
-                auto idx = *it;
-                if ((idx != EC) && erase_condition(idx, EC, m_approx_volume, m_point_delta)) {
-                    it = m_point_set.erase(it);
-                } else {
-                    ++it;
-                }
-            }
-
-            // check termination condition
-            stop_condition = false;
-            if (m_point_set.size() <= 1) {
-                stop_condition = true;
-            } else {
-                stop_condition = true;
-                for (decltype(m_point_set.size()) _i = 0; _i < m_point_set.size(); ++_i) {
-                    auto idx = m_point_set[_i];
-                    if (idx == EC) {
-                        continue;
-                    }
-                    double d = end_condition(idx, EC, m_approx_volume, m_point_delta);
-                    if (d <= 0 || d > 1 + m_eps) {
-                        stop_condition = false;
-                        break;
-                    }
-                }
-            }
-        } while (!stop_condition);
-
-        return EC;
-    }
+                                vector_double &)) const;
 
     // ----------------
     static double lc_end_condition(vector_double::size_type idx, vector_double::size_type LC,
-                                   vector_double &approx_volume, vector_double &point_delta)
-    {
-        return (approx_volume[LC] + point_delta[LC]) / (approx_volume[idx] - point_delta[idx]);
-    }
+                                   vector_double &approx_volume, vector_double &point_delta);
 
     static double gc_end_condition(vector_double::size_type idx, vector_double::size_type GC,
-                                   vector_double &approx_volume, vector_double &point_delta)
-    {
-        return (approx_volume[idx] + point_delta[idx]) / (approx_volume[GC] - point_delta[GC]);
-    }
+                                   vector_double &approx_volume, vector_double &point_delta);
 
     static bool lc_erase_condition(vector_double::size_type idx, vector_double::size_type LC,
-                                   vector_double &approx_volume, vector_double &point_delta)
-    {
-        return (approx_volume[idx] - point_delta[idx]) > (approx_volume[LC] + point_delta[LC]);
-    }
+                                   vector_double &approx_volume, vector_double &point_delta);
 
     static bool gc_erase_condition(vector_double::size_type idx, vector_double::size_type GC,
-                                   vector_double &approx_volume, vector_double &point_delta)
-    {
-        return (approx_volume[idx] + point_delta[idx]) < (approx_volume[GC] - point_delta[GC]);
-    }
+                                   vector_double &approx_volume, vector_double &point_delta);
 
     // flag stating whether BF approximation should use exact computation for some exclusive hypervolumes
     const bool m_use_exact;
@@ -588,6 +281,372 @@ private:
      * End of 'least_contributor' method variables section
      */
 };
+
+// Definitions of the member functions declared above (see detail/separate_compilation.hpp).
+#if defined(PAGMO_HEADER_DEFINITIONS)
+
+PAGMO_DECL bf_approx::bf_approx(bool use_exact, unsigned int trivial_subcase_size, double eps, double delta,
+                                double delta_multiplier, double alpha, double initial_delta_coeff, double gamma,
+                                unsigned int seed)
+    : m_use_exact(use_exact), m_trivial_subcase_size(trivial_subcase_size), m_eps(eps), m_delta(delta),
+      m_delta_multiplier(delta_multiplier), m_alpha(alpha), m_initial_delta_coeff(initial_delta_coeff),
+      m_gamma(gamma), m_e(seed)
+{
+    if (eps < 0 || eps > 1) {
+        pagmo_throw(std::invalid_argument, "Epsilon needs to be a probability.");
+    }
+    if (delta < 0 || delta > 1) {
+        pagmo_throw(std::invalid_argument, "Delta needs to be a probability.");
+    }
+}
+
+PAGMO_DECL double bf_approx::compute(std::vector<vector_double> &, const vector_double &) const
+{
+    pagmo_throw(std::invalid_argument,
+                "This algorithm can just approximate extreme contributions but not the hypervolume itself.");
+}
+
+PAGMO_DECL unsigned long long bf_approx::least_contributor(std::vector<vector_double> &points,
+                                                           const vector_double &r_point) const
+{
+    return approx_extreme_contributor(points, r_point, LEAST, [](double a, double b) { return a < b; },
+                                      lc_erase_condition, lc_end_condition);
+}
+
+PAGMO_DECL unsigned long long bf_approx::greatest_contributor(std::vector<vector_double> &points,
+                                                              const vector_double &r_point) const
+{
+    return approx_extreme_contributor(points, r_point, GREATEST, [](double a, double b) { return a > b; },
+                                      gc_erase_condition, gc_end_condition);
+}
+
+PAGMO_DECL void bf_approx::verify_before_compute(const std::vector<vector_double> &points,
+                                                 const vector_double &r_point) const
+{
+    hv_algorithm::assert_minimisation(points, r_point);
+}
+
+PAGMO_DECL std::shared_ptr<hv_algorithm> bf_approx::clone() const
+{
+    return std::shared_ptr<hv_algorithm>(new bf_approx(*this));
+}
+
+PAGMO_DECL std::string bf_approx::get_name() const
+{
+    return "Bringmann-Friedrich approximation method";
+}
+
+PAGMO_DECL double bf_approx::compute_point_delta(unsigned int round_no, vector_double::size_type idx,
+                                                 double log_factor) const
+{
+    return std::sqrt(0.5 * ((1. + m_gamma) * std::log(static_cast<double>(round_no)) + log_factor)
+                     / (static_cast<double>(m_no_samples[idx])));
+}
+
+PAGMO_DECL vector_double bf_approx::compute_bounding_box(const std::vector<vector_double> &points,
+                                                         const vector_double &r_point,
+                                                         vector_double::size_type p_idx) const
+{
+    // z is the opposite corner of the bounding box (reference point as a 'safe' first candidate - this is the
+    // MAXIMAL bounding box as of yet)
+    vector_double z(r_point);
+
+    // Below we perform a reduction to the minimal bounding box.
+    // We check whether given point at 'idx' is DOMINATED (strong domination) by 'p_idx' in exactly one objective,
+    // and DOMINATING (weak domination) in the remaining ones.
+    const vector_double &p = points[p_idx];
+    vector_double::size_type worse_dim_idx = 0u;
+    auto f_dim = r_point.size();
+    for (decltype(points.size()) idx = 0u; idx < points.size(); ++idx) {
+        auto flag = false; // initiate the possible opposite point dimension by -1 (no candidate)
+
+        for (decltype(f_dim) f_idx = 0u; f_idx < f_dim; ++f_idx) {
+            if (points[idx][f_idx] >= p[f_idx]) { // if any point is worse by given dimension, it's the potential
+                                                  // dimension in which we reduce the box
+                if (flag) {       // if given point is already worse in any previous dimension, skip to
+                                  // next point as it's a bad candidate
+                    flag = false; // set the result to "no candidate" and break
+                    break;
+                }
+                worse_dim_idx = f_idx;
+                flag = true;
+            }
+        }
+        if (flag) { // if given point was worse only in one dimension it's the potential candidate
+                    // for the bouding box reductor
+            z[worse_dim_idx] = std::min(z[worse_dim_idx], points[idx][worse_dim_idx]); // reduce the bounding box
+        }
+    }
+    return z;
+}
+
+PAGMO_DECL int bf_approx::point_in_box(const vector_double &p, const vector_double &a, const vector_double &b) const
+{
+    int cmp_a_p = hv_algorithm::dom_cmp(a, p, 0);
+
+    // point a is equal to point p (duplicate)
+    if (cmp_a_p == 3) {
+        return 3;
+        // point a is dominated by p (a is the least contributor)
+    } else if (cmp_a_p == 1) {
+        return 2;
+    } else if (hv_algorithm::dom_cmp(b, p, 0) == 1) {
+        return 1;
+    } else {
+        return 0;
+    }
+}
+
+PAGMO_DECL void bf_approx::sampling_round(const std::vector<vector_double> &points, double delta, unsigned int round,
+                                          vector_double::size_type idx, double log_factor) const
+{
+    if (m_use_exact) {
+        // if the sampling for given point was already resolved using exact method
+        if (m_no_ops[idx] == 0) {
+            return;
+        }
+
+        // if the exact computation is trivial OR when the sampling takes too long in terms of elementary operations
+        if (m_box_points[idx].size() <= m_trivial_subcase_size
+            || static_cast<double>(m_no_ops[idx])
+                   >= detail::expected_hv_operations(m_box_points[idx].size(), points[0].size())) {
+            const std::vector<vector_double::size_type> &bp = m_box_points[idx];
+            if (bp.size() == 0u) {
+                m_approx_volume[idx] = m_box_volume[idx];
+            } else {
+
+                auto f_dim = points[0].size();
+
+                const vector_double &p = points[idx];
+
+                std::vector<vector_double> sub_front(bp.size(), vector_double(f_dim, 0.0));
+
+                for (decltype(sub_front.size()) p_idx = 0u; p_idx < sub_front.size(); ++p_idx) {
+                    for (decltype(sub_front[0].size()) d_idx = 0u; d_idx < sub_front[0].size(); ++d_idx) {
+                        sub_front[p_idx][d_idx] = std::max(p[d_idx], points[bp[p_idx]][d_idx]);
+                    }
+                }
+
+                const vector_double &refpoint = m_boxes[idx];
+                hypervolume hv_obj = hypervolume(sub_front, false);
+                hv_obj.set_copy_points(false);
+                double hv = hv_obj.compute(refpoint);
+                m_approx_volume[idx] = m_box_volume[idx] - hv;
+            }
+
+            m_point_delta[idx] = 0.0;
+            m_no_ops[idx] = 0;
+
+            return;
+        }
+    }
+
+    double tmp = m_box_volume[idx] / delta;
+    double required_no_samples = 0.5 * ((1. + m_gamma) * std::log(round) + log_factor) * tmp * tmp;
+
+    while (static_cast<double>(m_no_samples[idx]) < required_no_samples) {
+        ++m_no_samples[idx];
+        if (sample_successful(points, idx)) {
+            ++m_no_succ_samples[idx];
+        }
+    }
+
+    m_approx_volume[idx]
+        = static_cast<double>(m_no_succ_samples[idx]) / static_cast<double>(m_no_samples[idx]) * m_box_volume[idx];
+    m_point_delta[idx] = compute_point_delta(round, idx, log_factor) * m_box_volume[idx];
+}
+
+PAGMO_DECL bool bf_approx::sample_successful(const std::vector<vector_double> &points,
+                                             vector_double::size_type idx) const
+{
+    const vector_double &lb = points[idx];
+    const vector_double &ub = m_boxes[idx];
+    vector_double rnd_p(lb.size(), 0.0);
+
+    for (decltype(lb.size()) i = 0u; i < lb.size(); ++i) {
+        auto V_dist = std::uniform_real_distribution<double>(lb[i], ub[i]);
+        rnd_p[i] = V_dist(m_e);
+    }
+
+    for (decltype(m_box_points[idx].size()) i = 0u; i < m_box_points[idx].size(); ++i) {
+
+        // box_p is a point overlapping the bounding box volume
+        const vector_double &box_p = points[m_box_points[idx][i]];
+
+        // assume that box_p DOMINATES the random point and try to prove it otherwise below
+        bool dominates = true;
+
+        // increase the number of operations by the dimension size
+        m_no_ops[idx] += box_p.size() + 1;
+        for (decltype(box_p.size()) d_idx = 0u; d_idx < box_p.size(); ++d_idx) {
+            if (rnd_p[d_idx] < box_p[d_idx]) { // box_p does not dominate rnd_p
+                dominates = false;
+                break;
+            }
+        }
+        // if the box_p dominated the rnd_p return the sample as false
+        if (dominates) {
+            return false;
+        }
+    }
+    return true;
+}
+
+PAGMO_DECL vector_double::size_type bf_approx::approx_extreme_contributor(
+    std::vector<vector_double> &points, const vector_double &r_point, extreme_contrib_type ec_type,
+    bool (*cmp_func)(double, double),
+    bool (*erase_condition)(vector_double::size_type, vector_double::size_type, vector_double &, vector_double &),
+    double (*end_condition)(vector_double::size_type, vector_double::size_type, vector_double &, vector_double &)) const
+{
+    m_no_samples = std::vector<vector_double::size_type>(points.size(), 0);
+    m_no_succ_samples = std::vector<vector_double::size_type>(points.size(), 0);
+    m_no_ops = std::vector<vector_double::size_type>(points.size(), 1);
+    m_point_set = std::vector<vector_double::size_type>(points.size(), 0);
+    m_box_volume = vector_double(points.size(), 0.0);
+    m_approx_volume = vector_double(points.size(), 0.0);
+    m_point_delta = vector_double(points.size(), 0.0);
+    m_boxes = std::vector<vector_double>(points.size());
+    m_box_points = std::vector<std::vector<vector_double::size_type>>(points.size());
+
+    // precomputed log factor for the point delta computation
+    const double log_factor
+        = std::log(2. * static_cast<double>(points.size()) * (1. + m_gamma) / (m_delta * m_gamma));
+
+    // round counter
+    unsigned int round_no = 0u;
+
+    // round delta
+    double r_delta = 0.0;
+
+    bool stop_condition = false;
+
+    // index of extreme contributor
+    vector_double::size_type EC = 0u;
+
+    // put every point into the set
+    for (decltype(m_point_set.size()) i = 0u; i < m_point_set.size(); ++i) {
+        m_point_set[i] = i;
+    }
+
+    // Initial computation
+    // - compute bounding boxes and their hypervolume
+    // - set round Delta as max of hypervolumes
+    // - determine points overlapping with each bounding box
+    for (decltype(points.size()) idx = 0u; idx < points.size(); ++idx) {
+        m_boxes[idx] = compute_bounding_box(points, r_point, idx);
+        m_box_volume[idx] = hv_algorithm::volume_between(points[idx], m_boxes[idx]);
+        r_delta = std::max(r_delta, m_box_volume[idx]);
+
+        for (decltype(points.size()) idx2 = 0u; idx2 < points.size(); ++idx2) {
+            if (idx == idx2) {
+                continue;
+            }
+            int op = point_in_box(points[idx2], points[idx], m_boxes[idx]);
+            if (op == 1) {
+                m_box_points[idx].push_back(idx2);
+            } else if (ec_type == LEAST) {
+                // Execute extra checks specifically for the least contributor
+                switch (op) {
+                    case 2:
+                        // since contribution by idx is guaranteed to be 0.0 (as the point is dominated) we might as
+                        // well return it as the least contributor right away
+                        return idx;
+                    case 3:
+                        // points at idx and idx2 are equal, each of them will contribute 0.0 hypervolume, return
+                        // idx as the least contributor
+                        return idx;
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+
+    // decrease the initial maximum volume by a constant factor
+    r_delta *= m_initial_delta_coeff;
+
+    // Main loop
+    do {
+        r_delta *= m_delta_multiplier;
+        ++round_no;
+
+        for (decltype(m_point_set.size()) _i = 0u; _i < m_point_set.size(); ++_i) {
+            auto idx = m_point_set[_i];
+            sampling_round(points, r_delta, round_no, idx, log_factor);
+        }
+
+        // sample the extreme contributor
+        sampling_round(points, m_alpha * r_delta, round_no, EC, log_factor);
+
+        // find the new extreme contributor
+        for (decltype(m_point_set.size()) _i = 0u; _i < m_point_set.size(); ++_i) {
+            auto idx = m_point_set[_i];
+            if (cmp_func(m_approx_volume[idx], m_approx_volume[EC])) {
+                EC = idx;
+            }
+        }
+
+        // erase known non-extreme contributors
+        // std::vector<unsigned int>::iterator it = m_point_set.begin();
+        auto it = m_point_set.begin();
+        while (it != m_point_set.end()) {
+            auto idx = *it;
+            if ((idx != EC) && erase_condition(idx, EC, m_approx_volume, m_point_delta)) {
+                it = m_point_set.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        // check termination condition
+        stop_condition = false;
+        if (m_point_set.size() <= 1) {
+            stop_condition = true;
+        } else {
+            stop_condition = true;
+            for (decltype(m_point_set.size()) _i = 0; _i < m_point_set.size(); ++_i) {
+                auto idx = m_point_set[_i];
+                if (idx == EC) {
+                    continue;
+                }
+                double d = end_condition(idx, EC, m_approx_volume, m_point_delta);
+                if (d <= 0 || d > 1 + m_eps) {
+                    stop_condition = false;
+                    break;
+                }
+            }
+        }
+    } while (!stop_condition);
+
+    return EC;
+}
+
+PAGMO_DECL double bf_approx::lc_end_condition(vector_double::size_type idx, vector_double::size_type LC,
+                                              vector_double &approx_volume, vector_double &point_delta)
+{
+    return (approx_volume[LC] + point_delta[LC]) / (approx_volume[idx] - point_delta[idx]);
+}
+
+PAGMO_DECL double bf_approx::gc_end_condition(vector_double::size_type idx, vector_double::size_type GC,
+                                              vector_double &approx_volume, vector_double &point_delta)
+{
+    return (approx_volume[idx] + point_delta[idx]) / (approx_volume[GC] - point_delta[GC]);
+}
+
+PAGMO_DECL bool bf_approx::lc_erase_condition(vector_double::size_type idx, vector_double::size_type LC,
+                                              vector_double &approx_volume, vector_double &point_delta)
+{
+    return (approx_volume[idx] - point_delta[idx]) > (approx_volume[LC] + point_delta[LC]);
+}
+
+PAGMO_DECL bool bf_approx::gc_erase_condition(vector_double::size_type idx, vector_double::size_type GC,
+                                              vector_double &approx_volume, vector_double &point_delta)
+{
+    return (approx_volume[idx] + point_delta[idx]) < (approx_volume[GC] - point_delta[GC]);
+}
+
+#endif
+
 }
 
 #endif
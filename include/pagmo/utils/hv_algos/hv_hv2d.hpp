@@ -31,11 +31,12 @@
 #include <string>
 #include <vector>
 
+#include "../../detail/radix_sort.hpp"
+#include "../../detail/separate_compilation.hpp"
 #include "../../exceptions.hpp"
 #include "../../io.hpp"
 #include "../../population.hpp"
 #include "../../types.hpp"
-#include "../hypervolume.hpp"
 #include "hv_algorithm.hpp"
 
 namespace pagmo
@@ -55,9 +56,7 @@ public:
     /**
      * @param initial_sorting Turn initial sorting on-off
      */
-    hv2d(const bool initial_sorting = true) : m_initial_sorting(initial_sorting)
-    {
-    }
+    hv2d(const bool initial_sorting = true);
 
     /// Compute hypervolume method.
     /**
@@ -71,31 +70,7 @@ public:
     *
     * @return hypervolume
     */
-    double compute(std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        if (points.size() == 0u) {
-            return 0.0;
-        } else if (points.size() == 1u) {
-            return hv_algorithm::volume_between(points[0], r_point);
-        }
-
-        if (m_initial_sorting) {
-            sort(points.begin(), points.end(),
-                 [](const vector_double &v1, const vector_double &v2) { return v1[1] < v2[1]; });
-        }
-
-        double hypervolume = 0.0;
-
-        // width of the sweeping line
-        double w = r_point[0] - points[0][0];
-        for (decltype(points.size()) idx = 0u; idx < points.size() - 1u; ++idx) {
-            hypervolume += (points[idx + 1u][1] - points[idx][1]) * w;
-            w = std::max(w, r_point[0] - points[idx + 1u][0]);
-        }
-        hypervolume += (r_point[1] - points[points.size() - 1u][1]) * w;
-
-        return hypervolume;
-    }
+    double compute(std::vector<vector_double> &points, const vector_double &r_point) const;
 
     /// Compute hypervolume method.
     /**
@@ -112,30 +87,7 @@ public:
     *
     * @return hypervolume
     */
-    double compute(double **points, vector_double::size_type n_points, double *r_point) const
-    {
-        if (n_points == 0u) {
-            return 0.0;
-        } else if (n_points == 1u) {
-            return volume_between(points[0], r_point, 2);
-        }
-
-        if (m_initial_sorting) {
-            std::sort(points, points + n_points, [](double *a, double *b) { return a[1] < b[1]; });
-        }
-
-        double hypervolume = 0.0;
-
-        // width of the sweeping line
-        double w = r_point[0] - points[0][0];
-        for (decltype(n_points) idx = 0; idx < n_points - 1u; ++idx) {
-            hypervolume += (points[idx + 1u][1] - points[idx][1]) * w;
-            w = std::max(w, r_point[0] - points[idx + 1u][0]);
-        }
-        hypervolume += (r_point[1] - points[n_points - 1u][1]) * w;
-
-        return hypervolume;
-    }
+    double compute(double **points, vector_double::size_type n_points, double *r_point) const;
 
     /// Contributions method
     /**
@@ -147,14 +99,78 @@ public:
     */
     std::vector<double> contributions(std::vector<vector_double> &points, const vector_double &r_point) const;
 
+    /// Compute hypervolume method on a view.
+    /**
+    * Same as hv2d::compute(), but the points are not altered: the ordering along the second axis is read from (and,
+    * on first use, cached into) \p ws.
+    *
+    * Computational complexity: n*log(n), n if the ordering is already cached in \p ws
+    *
+    * @param view the 2-dimensional points for which we compute the hypervolume
+    * @param r_point reference point for the points
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return hypervolume
+    */
+    double compute_view(const hv_points_view &view, const vector_double &r_point, hv_workspace &ws) const;
+
+    /// Exclusive hypervolume method on a view.
+    /**
+    * Computes the exclusive hypervolume as the difference of two calls to hv2d::compute_view(), without copying the
+    * points.
+    *
+    * @param p_idx index of the individual in \p view
+    * @param view the 2-dimensional points
+    * @param r_point reference point for the points
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return exlusive hypervolume contributed by the individual at index p_idx
+    */
+    double exclusive_view(unsigned int p_idx, const hv_points_view &view, const vector_double &r_point,
+                          hv_workspace &ws) const;
+
+    /// Contributions method on a view
+    /**
+    * If the points form a non-dominated front (without duplicates), the contributions are computed directly
+    * from the ordering along the first axis, which is read from (and, on first use, cached into) \p ws.
+    * Otherwise, hv2d::contributions() is called on a copy of the points.
+    *
+    * @param view the 2-dimensional points
+    * @param r_point reference point for the points
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return vector of exclusive contributions by every point
+    */
+    std::vector<double> contributions_view(const hv_points_view &view, const vector_double &r_point,
+                                           hv_workspace &ws) const;
+
+    /// Least contributor method on a view
+    /**
+    * @param view the 2-dimensional points
+    * @param r_point reference point for the points
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return index of the least contributor
+    */
+    unsigned long long least_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                              hv_workspace &ws) const;
+
+    /// Greatest contributor method on a view
+    /**
+    * @param view the 2-dimensional points
+    * @param r_point reference point for the points
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return index of the greatest contributor
+    */
+    unsigned long long greatest_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                 hv_workspace &ws) const;
+
     /// Clone method.
     /**
      * @return a pointer to a new object cloning this
      */
-    std::shared_ptr<hv_algorithm> clone() const
-    {
-        return std::shared_ptr<hv_algorithm>(new hv2d(*this));
-    }
+    std::shared_ptr<hv_algorithm> clone() const;
 
     /// Verify input method.
     /**
@@ -166,28 +182,152 @@ public:
     * @throws value_error when trying to compute the hypervolume for the dimension other than 3 or non-maximal reference
     * point
     */
-    void verify_before_compute(const std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        if (r_point.size() != 2u) {
-            pagmo_throw(std::invalid_argument, "Algorithm hv2d works only for 2-dimensional cases.");
-        }
-
-        hv_algorithm::assert_minimisation(points, r_point);
-    }
+    void verify_before_compute(const std::vector<vector_double> &points, const vector_double &r_point) const;
 
     /// Algorithm name
     /**
      * @return The name of this particular algorithm
      */
-    std::string get_name() const
-    {
-        return "hv2d algorithm";
-    }
+    std::string get_name() const;
 
 private:
     // Flag stating whether the points should be sorted in the first step of the algorithm.
     const bool m_initial_sorting;
 };
+
+// Definitions of the member functions declared above (see detail/separate_compilation.hpp).
+#if defined(PAGMO_HEADER_DEFINITIONS)
+
+PAGMO_DECL hv2d::hv2d(const bool initial_sorting) : m_initial_sorting(initial_sorting)
+{
+}
+
+PAGMO_DECL double hv2d::compute(std::vector<vector_double> &points, const vector_double &r_point) const
+{
+    if (points.size() == 0u) {
+        return 0.0;
+    } else if (points.size() == 1u) {
+        return hv_algorithm::volume_between(points[0], r_point);
+    }
+
+    if (m_initial_sorting) {
+        detail::sort_by_key(points.begin(), points.end(), [](const vector_double &v) { return v[1]; });
+    }
+
+    double hypervolume = 0.0;
+
+    // width of the sweeping line
+    double w = r_point[0] - points[0][0];
+    for (decltype(points.size()) idx = 0u; idx < points.size() - 1u; ++idx) {
+        hypervolume += (points[idx + 1u][1] - points[idx][1]) * w;
+        w = std::max(w, r_point[0] - points[idx + 1u][0]);
+    }
+    hypervolume += (r_point[1] - points[points.size() - 1u][1]) * w;
+
+    return hypervolume;
+}
+
+PAGMO_DECL double hv2d::compute(double **points, vector_double::size_type n_points, double *r_point) const
+{
+    if (n_points == 0u) {
+        return 0.0;
+    } else if (n_points == 1u) {
+        return volume_between(points[0], r_point, 2);
+    }
+
+    if (m_initial_sorting) {
+        detail::sort_by_key(points, points + n_points, [](const double *a) { return a[1]; });
+    }
+
+    double hypervolume = 0.0;
+
+    // width of the sweeping line
+    double w = r_point[0] - points[0][0];
+    for (decltype(n_points) idx = 0; idx < n_points - 1u; ++idx) {
+        hypervolume += (points[idx + 1u][1] - points[idx][1]) * w;
+        w = std::max(w, r_point[0] - points[idx + 1u][0]);
+    }
+    hypervolume += (r_point[1] - points[n_points - 1u][1]) * w;
+
+    return hypervolume;
+}
+
+PAGMO_DECL double hv2d::compute_view(const hv_points_view &view, const vector_double &r_point, hv_workspace &ws) const
+{
+    const auto &points = view.get_points();
+    const auto *order = m_initial_sorting ? &ws.sorted_order(points, 1u) : nullptr;
+    double hypervolume = 0.0;
+    // width of the sweeping line and height of the last point
+    double w = 0.0, y = 0.0;
+    bool first = true;
+    for (decltype(points.size()) k = 0u; k < points.size(); ++k) {
+        const auto idx = order ? (*order)[k] : k;
+        if (view.excludes(idx)) {
+            continue;
+        }
+        const auto &p = points[idx];
+        if (first) {
+            w = r_point[0] - p[0];
+            first = false;
+        } else {
+            hypervolume += (p[1] - y) * w;
+            w = std::max(w, r_point[0] - p[0]);
+        }
+        y = p[1];
+    }
+    if (first) {
+        return 0.0;
+    }
+    return hypervolume + (r_point[1] - y) * w;
 }
 
+PAGMO_DECL double hv2d::exclusive_view(unsigned int p_idx, const hv_points_view &view, const vector_double &r_point,
+                                       hv_workspace &ws) const
+{
+    if (view.has_excluded() || view.size() == 1u) {
+        return hv_algorithm::exclusive_view(p_idx, view, r_point, ws);
+    }
+    return compute_view(view, r_point, ws) - compute_view(hv_points_view(view.get_points(), p_idx), r_point, ws);
+}
+
+PAGMO_DECL unsigned long long hv2d::least_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                           hv_workspace &ws) const
+{
+    return extreme_contributor_view(view, r_point, ws, [](double a, double b) { return a < b; });
+}
+
+PAGMO_DECL unsigned long long hv2d::greatest_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                              hv_workspace &ws) const
+{
+    return extreme_contributor_view(view, r_point, ws, [](double a, double b) { return a > b; });
+}
+
+PAGMO_DECL std::shared_ptr<hv_algorithm> hv2d::clone() const
+{
+    return std::shared_ptr<hv_algorithm>(new hv2d(*this));
+}
+
+PAGMO_DECL void hv2d::verify_before_compute(const std::vector<vector_double> &points,
+                                            const vector_double &r_point) const
+{
+    if (r_point.size() != 2u) {
+        pagmo_throw(std::invalid_argument, "Algorithm hv2d works only for 2-dimensional cases.");
+    }
+
+    hv_algorithm::assert_minimisation(points, r_point);
+}
+
+PAGMO_DECL std::string hv2d::get_name() const
+{
+    return "hv2d algorithm";
+}
+
+#endif
+
+}
+
+// The headers below include, via hypervolume.hpp, the headers of all the exact algorithms: they are included after
+// the class definition, so that the class is complete whatever the order of inclusion.
+#include "../hypervolume.hpp"
+
 #endif
@@ -25,19 +25,25 @@
 #ifndef PAGMO_UTIL_hv3d_H
 #define PAGMO_UTIL_hv3d_H
 
+#include <algorithm>
 #include <cmath>
+#include <deque>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "../../detail/radix_sort.hpp"
+#include "../../detail/separate_compilation.hpp"
 #include "../../exceptions.hpp"
 #include "../../io.hpp"
 #include "../../population.hpp"
 #include "../../types.hpp"
-#include "../hypervolume.hpp"
 #include "hv_algorithm.hpp"
-#include "hv_hvwfg.hpp"
 
 namespace pagmo
 {
@@ -66,9 +72,7 @@ public:
     *
     * @param initial_sorting when set to true (default), algorithm will sort the points ascending by third dimension
     */
-    hv3d(const bool initial_sorting = true) : m_initial_sorting(initial_sorting)
-    {
-    }
+    hv3d(const bool initial_sorting = true);
 
     /// Compute hypervolume
     /**
@@ -88,62 +92,35 @@ public:
     *
     * @return hypervolume.
     */
-    double compute(std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        if (m_initial_sorting) {
-            sort(points.begin(), points.end(),
-                 [](const vector_double &a, const vector_double &b) { return a[2] < b[2]; });
-        }
-        double V = 0.0; // hypervolume
-        double A = 0.0; // area of the sweeping plane
-        auto cmp_zero_comp = [](const vector_double &v1, const vector_double &v2) { return v1[0] > v2[0]; };
-        std::multiset<vector_double, decltype(cmp_zero_comp)> T(cmp_zero_comp);
-        // std::multiset<vector_double, vector_double_cmp> T(vector_double_cmp(0, '>'));
-
-        // sentinel points (r_point[0], -INF, r_point[2]) and (-INF, r_point[1], r_point[2])
-        const double INF = std::numeric_limits<double>::max();
-        vector_double sA(r_point.begin(), r_point.end());
-        sA[1] = -INF;
-        vector_double sB(r_point.begin(), r_point.end());
-        sB[0] = -INF;
-
-        T.insert(sA);
-        T.insert(sB);
-        double z3 = points[0][2];
-        T.insert(points[0]);
-        A = std::abs((points[0][0] - r_point[0]) * (points[0][1] - r_point[1]));
-
-        std::multiset<vector_double>::iterator p;
-        std::multiset<vector_double>::iterator q;
-        // for (std::vector<vector_double>::size_type idx = 1; idx < points.size(); ++idx) {
-        for (decltype(points.size()) idx = 1u; idx < points.size(); ++idx) {
-            p = T.insert(points[idx]);
-            q = (p);
-            ++q;                      // setup q to be a successor of p
-            if ((*q)[1] <= (*p)[1]) { // current point is dominated
-                T.erase(p);           // disregard the point from further calculation
-            } else {
-                V += A * std::abs(z3 - (*p)[2]);
-                z3 = (*p)[2];
-                std::multiset<vector_double>::reverse_iterator rev_it(q);
-                ++rev_it;
+    double compute(std::vector<vector_double> &points, const vector_double &r_point) const;
 
-                std::multiset<vector_double>::reverse_iterator erase_begin(rev_it);
-                std::multiset<vector_double>::reverse_iterator rev_it_pred;
-                while ((*rev_it)[1] >= (*p)[1]) {
-                    rev_it_pred = rev_it;
-                    ++rev_it_pred;
-                    A -= std::abs(((*rev_it)[0] - (*rev_it_pred)[0]) * ((*rev_it)[1] - (*q)[1]));
-                    ++rev_it;
-                }
-                A += std::abs(((*p)[0] - (*(rev_it))[0]) * ((*p)[1] - (*q)[1]));
-                T.erase(rev_it.base(), erase_begin.base());
-            }
-        }
-        V += A * std::abs(z3 - r_point[2]);
+    /// Compute hypervolume on a view
+    /**
+    * Same as hv3d::compute(), but the points are not altered: the ordering along the third axis is read from (and,
+    * on first use, cached into) \p ws.
+    *
+    * @param view the 3-dimensional points for which we compute the hypervolume
+    * @param r_point reference point for the points
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return hypervolume.
+    */
+    double compute_view(const hv_points_view &view, const vector_double &r_point, hv_workspace &ws) const;
 
-        return V;
-    }
+    /// Exclusive hypervolume method on a view.
+    /**
+    * Computes the exclusive hypervolume as the difference of two calls to hv3d::compute_view(), without copying the
+    * points.
+    *
+    * @param p_idx index of the individual in \p view
+    * @param view the 3-dimensional points
+    * @param r_point reference point for the points
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return exlusive hypervolume contributed by the individual at index p_idx
+    */
+    double exclusive_view(unsigned int p_idx, const hv_points_view &view, const vector_double &r_point,
+                          hv_workspace &ws) const;
 
     /// Contributions method
     /**
@@ -158,145 +135,43 @@ public:
     * @param r_point reference point for the points
     * @return vector of exclusive contributions by every point
     */
-    std::vector<double> contributions(std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        // Make a copy of the original set of points
-        std::vector<vector_double> p(points.begin(), points.end());
-
-        std::vector<std::pair<vector_double, vector_double::size_type>> point_pairs;
-        point_pairs.reserve(p.size());
-        for (decltype(p.size()) i = 0u; i < p.size(); ++i) {
-            point_pairs.push_back(std::make_pair(p[i], i));
-        }
-        if (m_initial_sorting) {
-            sort(point_pairs.begin(), point_pairs.end(),
-                 [](const std::pair<vector_double, vector_double::size_type> &a,
-                    const std::pair<vector_double, vector_double::size_type> &b) { return a.first[2] < b.first[2]; });
-        }
-        for (decltype(p.size()) i = 0u; i < p.size(); ++i) {
-            p[i] = point_pairs[i].first;
-        }
-
-        typedef std::multiset<std::pair<vector_double, vector_double::size_type>, hycon3d_tree_cmp> tree_t;
+    std::vector<double> contributions(std::vector<vector_double> &points, const vector_double &r_point) const;
 
-        auto n = p.size();
-        const double INF = std::numeric_limits<double>::max();
-
-        // Placeholder value for undefined lower z value.
-        const double NaN = INF;
-
-        // Contributions
-        std::vector<double> c(n, 0.0);
-
-        // Sentinel points
-        vector_double s_x(3, -INF);
-        s_x[0] = r_point[0]; // (r,oo,oo)
-        vector_double s_y(3, -INF);
-        s_y[1] = r_point[1]; // (oo,r,oo)
-        vector_double s_z(3, -INF);
-        s_z[2] = r_point[2]; // (oo,oo,r)
-
-        p.push_back(s_z); // p[n]
-        p.push_back(s_x); // p[n + 1]
-        p.push_back(s_y); // p[n + 2]
-
-        tree_t T;
-        T.insert(std::make_pair(p[0], 0));
-        T.insert(std::make_pair(s_x, n + 1));
-        T.insert(std::make_pair(s_y, n + 2));
-
-        // Boxes
-        std::vector<std::deque<box3d>> L(n + 3);
-
-        box3d b0(r_point[0], r_point[1], NaN, p[0][0], p[0][1], p[0][2]);
-        L[0].push_front(b0);
-
-        for (decltype(n) i = 1u; i < n + 1u; ++i) {
-            std::pair<vector_double, vector_double::size_type> pi(p[i], i);
-
-            tree_t::iterator it = T.lower_bound(pi);
-
-            // Point is dominated
-            if (p[i][1] >= (*it).first[1]) {
-                return hvwfg(2).contributions(points, r_point);
-            }
-
-            tree_t::reverse_iterator r_it(it);
-
-            std::vector<vector_double::size_type> d;
-
-            while ((*r_it).first[1] > p[i][1]) {
-                d.push_back((*r_it).second);
-                ++r_it;
-            }
-
-            auto r = (*it).second;
-            auto t = (*r_it).second;
-
-            T.erase(r_it.base(), it);
-
-            // Process right neighbor region, region R
-            while (!L[r].empty()) {
-                box3d &br = L[r].front();
-                if (br.ux >= p[i][0]) {
-                    br.lz = p[i][2];
-                    c[r] += box_volume(br);
-                    L[r].pop_front();
-                } else if (br.lx > p[i][0]) {
-                    br.lz = p[i][2];
-                    c[r] += box_volume(br);
-                    br.lx = p[i][0];
-                    br.uz = p[i][2];
-                    br.lz = NaN;
-                    break;
-                } else {
-                    break;
-                }
-            }
+    /// Contributions method on a view
+    /**
+    * Same as hv3d::contributions(), but the ordering along the third axis is read from (and, on first use, cached
+    * into) \p ws and the points are never copied.
+    *
+    * @param view the 3-dimensional points for which we compute the contributions
+    * @param r_point reference point for the points
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return vector of exclusive contributions by every point
+    */
+    std::vector<double> contributions_view(const hv_points_view &view, const vector_double &r_point,
+                                           hv_workspace &ws) const;
 
-            // Process dominated points, region M
-            double xleft = p[t][0];
-            std::vector<vector_double::size_type>::reverse_iterator r_it_idx = d.rbegin();
-            std::vector<vector_double::size_type>::reverse_iterator r_it_idx_e = d.rend();
-            for (; r_it_idx != r_it_idx_e; ++r_it_idx) {
-                auto jdom = *r_it_idx;
-                while (!L[jdom].empty()) {
-                    box3d &bm = L[jdom].front();
-                    bm.lz = p[i][2];
-                    c[jdom] += box_volume(bm);
-                    L[jdom].pop_front();
-                }
-                L[i].push_back(box3d(xleft, p[jdom][1], NaN, p[jdom][0], p[i][1], p[i][2]));
-                xleft = p[jdom][0];
-            }
-            L[i].push_back(box3d(xleft, p[r][1], NaN, p[i][0], p[i][1], p[i][2]));
-            xleft = p[t][0];
-
-            // Process left neighbor region, region L
-            while (!L[t].empty()) {
-                box3d &bl = L[t].back();
-                if (bl.ly > p[i][1]) {
-                    bl.lz = p[i][2];
-                    c[t] += box_volume(bl);
-                    xleft = bl.lx;
-                    L[t].pop_back();
-                } else {
-                    break;
-                }
-            }
-            if (xleft > p[t][0]) {
-                L[t].push_back(box3d(xleft, p[i][1], NaN, p[t][0], p[t][1], p[i][2]));
-            }
-            T.insert(std::make_pair(p[i], i));
-        }
+    /// Least contributor method on a view
+    /**
+    * @param view the 3-dimensional points
+    * @param r_point reference point for the points
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return index of the least contributor
+    */
+    unsigned long long least_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                              hv_workspace &ws) const;
 
-        // Fix the indices
-        std::vector<double> contribs(n, 0.0);
-        for (decltype(c.size()) i = 0u; i < c.size(); ++i) {
-            contribs[point_pairs[i].second] = c[i];
-        }
-        return contribs;
-    }
+    /// Greatest contributor method on a view
+    /**
+    * @param view the 3-dimensional points
+    * @param r_point reference point for the points
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return index of the greatest contributor
+    */
+    unsigned long long greatest_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                 hv_workspace &ws) const;
 
     /// Verify before compute
     /**
@@ -308,32 +183,19 @@ public:
     * @throws value_error when trying to compute the hypervolume for the dimension other than 3 or non-maximal reference
     * point
     */
-    void verify_before_compute(const std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        if (r_point.size() != 3u) {
-            pagmo_throw(std::invalid_argument, "Algorithm hv3d works only for 3-dimensional cases");
-        }
-
-        hv_algorithm::assert_minimisation(points, r_point);
-    }
+    void verify_before_compute(const std::vector<vector_double> &points, const vector_double &r_point) const;
 
     /// Clone method.
     /**
      * @return a pointer to a new object cloning this
      */
-    std::shared_ptr<hv_algorithm> clone() const
-    {
-        return std::shared_ptr<hv_algorithm>(new hv3d(*this));
-    }
+    std::shared_ptr<hv_algorithm> clone() const;
 
     /// Algorithm name
     /**
      * @return The name of this particular algorithm
      */
-    std::string get_name() const
-    {
-        return "hv3d algorithm";
-    }
+    std::string get_name() const;
 
 private:
     // flag stating whether the points should be sorted in the first step of the algorithm
@@ -353,11 +215,10 @@ private:
     };
 
     struct hycon3d_tree_cmp {
-        //	bool operator()(const std::pair<vector_double, int> &, const std::pair<vector_double, int> &);
-        bool operator()(const std::pair<vector_double, vector_double::size_type> &a,
-                        const std::pair<vector_double, vector_double::size_type> &b) const
+        bool operator()(const std::pair<const vector_double *, vector_double::size_type> &a,
+                        const std::pair<const vector_double *, vector_double::size_type> &b) const
         {
-            return a.first[0] > b.first[0];
+            return (*a.first)[0] > (*b.first)[0];
         }
     };
 
@@ -365,88 +226,383 @@ private:
     /**
     * Returns the volume of the box3d object
     */
-    static double box_volume(const box3d &b)
-    {
-        return std::abs((b.ux - b.lx) * (b.uy - b.ly) * (b.uz - b.lz));
-    }
+    static double box_volume(const box3d &b);
+
+    // Points of a view sorted along the third axis (if requested), skipping the excluded point.
+    std::vector<const vector_double *> sorted_view(const hv_points_view &view, hv_workspace &ws) const;
+
+    // Beume et al. algorithm on points sorted ascending along the third axis.
+    static double compute_impl(const std::vector<const vector_double *> &points, const vector_double &r_point);
+
+    // HyCon3D on the points p, sorted ascending along the third axis, with orig_idx[i] the index of the
+    // contribution of p[i] in the output. Returns false if a dominated point is found (contribs is then unusable).
+    static bool contributions_impl(std::vector<const vector_double *> p,
+                                   const std::vector<vector_double::size_type> &orig_idx, const vector_double &r_point,
+                                   std::vector<double> &contribs);
 };
+}
+
+// The headers below include, via hypervolume.hpp, the headers of all the exact algorithms: they are included after
+// the class definition, so that the class is complete whatever the order of inclusion.
+#include "../hypervolume.hpp"
+#include "hv_hvwfg.hpp"
+
+// Definitions of the member functions declared above (see detail/separate_compilation.hpp).
+#if defined(PAGMO_HEADER_DEFINITIONS)
 
-inline std::vector<double> hv2d::contributions(std::vector<vector_double> &points, const vector_double &r_point) const
+namespace pagmo
 {
-    std::vector<vector_double> new_points(points.size(), vector_double(3, 0.0));
-    vector_double new_r(r_point);
-    new_r.push_back(1.0);
 
+PAGMO_DECL hv3d::hv3d(const bool initial_sorting) : m_initial_sorting(initial_sorting)
+{
+}
+
+PAGMO_DECL double hv3d::compute(std::vector<vector_double> &points, const vector_double &r_point) const
+{
+    if (m_initial_sorting) {
+        detail::sort_by_key(points.begin(), points.end(), [](const vector_double &v) { return v[2]; });
+    }
+    std::vector<const vector_double *> sorted_points(points.size());
     for (decltype(points.size()) i = 0u; i < points.size(); ++i) {
-        new_points[i][0] = points[i][0];
-        new_points[i][1] = points[i][1];
-        new_points[i][2] = 0.0;
+        sorted_points[i] = &points[i];
     }
-    // Set sorting to off since contributions are sorted by third dimension
-    return hv3d(false).contributions(new_points, new_r);
+    return compute_impl(sorted_points, r_point);
 }
 
-/// Chooses the best algorithm to compute the hypervolume
-/**
-* Returns the best method for given hypervolume computation problem.
-* As of yet, only the dimension size is taken into account.
-*
-* @param r_point reference point for the vector of points
-*
-* @return an std::shared_ptr to the selected algorithm
-*/
-inline std::shared_ptr<hv_algorithm> hypervolume::get_best_compute(const vector_double &r_point) const
+PAGMO_DECL double hv3d::compute_view(const hv_points_view &view, const vector_double &r_point, hv_workspace &ws) const
 {
-    auto fdim = r_point.size();
+    if (view.size() == 0u) {
+        return 0.0;
+    }
+    return compute_impl(sorted_view(view, ws), r_point);
+}
 
-    if (fdim == 2u) {
-        return hv2d().clone();
-    } else if (fdim == 3u) {
-        return hv3d().clone();
-    } else {
-        return hvwfg().clone();
+PAGMO_DECL double hv3d::exclusive_view(unsigned int p_idx, const hv_points_view &view, const vector_double &r_point,
+                                       hv_workspace &ws) const
+{
+    if (view.has_excluded() || view.size() == 1u) {
+        return hv_algorithm::exclusive_view(p_idx, view, r_point, ws);
     }
+    return compute_view(view, r_point, ws) - compute_view(hv_points_view(view.get_points(), p_idx), r_point, ws);
 }
 
-/// Chooses the best algorithm to compute the hypervolume
-/**
-* Returns the best method for given hypervolume computation problem.
-* As of yet, only the dimension size is taken into account.
-*
-* @param p_idx index of the point for which the exclusive contribution is to be computed
-* @param r_point reference point for the vector of points
-*
-* @return an std::shared_ptr to the selected algorithm
-*/
-inline std::shared_ptr<hv_algorithm> hypervolume::get_best_exclusive(const unsigned int p_idx,
-                                                                     const vector_double &r_point) const
+PAGMO_DECL unsigned long long hv3d::least_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                           hv_workspace &ws) const
 {
-    (void)p_idx;
-    // Exclusive contribution and compute method share the same "best" set of algorithms.
-    return hypervolume::get_best_compute(r_point);
+    return extreme_contributor_view(view, r_point, ws, [](double a, double b) { return a < b; });
 }
 
-/// Chooses the best algorithm to compute the hypervolume
-/**
-* Returns the best method for given hypervolume computation problem.
-* As of yet, only the dimension size is taken into account.
-*
-* @param r_point reference point for the vector of points
-*
-* @return an std::shared_ptr to the selected algorithm
-*/
-inline std::shared_ptr<hv_algorithm> hypervolume::get_best_contributions(const vector_double &r_point) const
+PAGMO_DECL unsigned long long hv3d::greatest_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                              hv_workspace &ws) const
 {
-    auto fdim = r_point.size();
+    return extreme_contributor_view(view, r_point, ws, [](double a, double b) { return a > b; });
+}
+
+PAGMO_DECL void hv3d::verify_before_compute(const std::vector<vector_double> &points,
+                                            const vector_double &r_point) const
+{
+    if (r_point.size() != 3u) {
+        pagmo_throw(std::invalid_argument, "Algorithm hv3d works only for 3-dimensional cases");
+    }
+
+    hv_algorithm::assert_minimisation(points, r_point);
+}
+
+PAGMO_DECL std::shared_ptr<hv_algorithm> hv3d::clone() const
+{
+    return std::shared_ptr<hv_algorithm>(new hv3d(*this));
+}
+
+PAGMO_DECL std::string hv3d::get_name() const
+{
+    return "hv3d algorithm";
+}
+
+PAGMO_DECL double hv3d::box_volume(const box3d &b)
+{
+    return std::abs((b.ux - b.lx) * (b.uy - b.ly) * (b.uz - b.lz));
+}
+
+PAGMO_DECL std::vector<const vector_double *> hv3d::sorted_view(const hv_points_view &view, hv_workspace &ws) const
+{
+    const auto &points = view.get_points();
+    const auto *order = m_initial_sorting ? &ws.sorted_order(points, 2u) : nullptr;
+    std::vector<const vector_double *> retval;
+    retval.reserve(view.size());
+    for (decltype(points.size()) k = 0u; k < points.size(); ++k) {
+        const auto idx = order ? (*order)[k] : k;
+        if (!view.excludes(idx)) {
+            retval.push_back(&points[idx]);
+        }
+    }
+    return retval;
+}
+
+PAGMO_DECL double hv3d::compute_impl(const std::vector<const vector_double *> &points, const vector_double &r_point)
+{
+    double V = 0.0; // hypervolume
+    double A = 0.0; // area of the sweeping plane
+    auto cmp_zero_comp = [](const vector_double *v1, const vector_double *v2) { return (*v1)[0] > (*v2)[0]; };
+    std::multiset<const vector_double *, decltype(cmp_zero_comp)> T(cmp_zero_comp);
+
+    // sentinel points (r_point[0], -INF, r_point[2]) and (-INF, r_point[1], r_point[2])
+    const double INF = std::numeric_limits<double>::max();
+    vector_double sA(r_point.begin(), r_point.end());
+    sA[1] = -INF;
+    vector_double sB(r_point.begin(), r_point.end());
+    sB[0] = -INF;
+
+    T.insert(&sA);
+    T.insert(&sB);
+    double z3 = (*points[0])[2];
+    T.insert(points[0]);
+    A = std::abs(((*points[0])[0] - r_point[0]) * ((*points[0])[1] - r_point[1]));
+
+    for (decltype(points.size()) idx = 1u; idx < points.size(); ++idx) {
+        auto p = T.insert(points[idx]);
+        auto q = p;
+        ++q;                          // setup q to be a successor of p
+        if ((**q)[1] <= (**p)[1]) { // current point is dominated
+            T.erase(p);               // disregard the point from further calculation
+        } else {
+            V += A * std::abs(z3 - (**p)[2]);
+            z3 = (**p)[2];
+            std::reverse_iterator<decltype(q)> rev_it(q);
+            ++rev_it;
+
+            auto erase_begin(rev_it);
+            decltype(rev_it) rev_it_pred;
+            while ((**rev_it)[1] >= (**p)[1]) {
+                rev_it_pred = rev_it;
+                ++rev_it_pred;
+                A -= std::abs(((**rev_it)[0] - (**rev_it_pred)[0]) * ((**rev_it)[1] - (**q)[1]));
+                ++rev_it;
+            }
+            A += std::abs(((**p)[0] - (**rev_it)[0]) * ((**p)[1] - (**q)[1]));
+            T.erase(rev_it.base(), erase_begin.base());
+        }
+    }
+    V += A * std::abs(z3 - r_point[2]);
+
+    return V;
+}
+
+PAGMO_DECL bool hv3d::contributions_impl(std::vector<const vector_double *> p,
+                                         const std::vector<vector_double::size_type> &orig_idx,
+                                         const vector_double &r_point, std::vector<double> &contribs)
+{
+    typedef std::multiset<std::pair<const vector_double *, vector_double::size_type>, hycon3d_tree_cmp> tree_t;
+
+    auto n = p.size();
+    const double INF = std::numeric_limits<double>::max();
+
+    // Placeholder value for undefined lower z value.
+    const double NaN = INF;
+
+    // Contributions
+    std::vector<double> c(n, 0.0);
+
+    // Sentinel points
+    vector_double s_x(3, -INF);
+    s_x[0] = r_point[0]; // (r,oo,oo)
+    vector_double s_y(3, -INF);
+    s_y[1] = r_point[1]; // (oo,r,oo)
+    vector_double s_z(3, -INF);
+    s_z[2] = r_point[2]; // (oo,oo,r)
+
+    p.push_back(&s_z); // p[n]
+    p.push_back(&s_x); // p[n + 1]
+    p.push_back(&s_y); // p[n + 2]
+
+    tree_t T;
+    T.insert(std::make_pair(p[0], 0));
+    T.insert(std::make_pair(&s_x, n + 1));
+    T.insert(std::make_pair(&s_y, n + 2));
+
+    // Boxes
+    std::vector<std::deque<box3d>> L(n + 3);
+
+    box3d b0(r_point[0], r_point[1], NaN, (*p[0])[0], (*p[0])[1], (*p[0])[2]);
+    L[0].push_front(b0);
+
+    for (decltype(n) i = 1u; i < n + 1u; ++i) {
+        const auto &pi_point = *p[i];
+        std::pair<const vector_double *, vector_double::size_type> pi(p[i], i);
+
+        tree_t::iterator it = T.lower_bound(pi);
+
+        // Point is dominated
+        if (pi_point[1] >= (*(*it).first)[1]) {
+            return false;
+        }
+
+        tree_t::reverse_iterator r_it(it);
+
+        std::vector<vector_double::size_type> d;
+
+        while ((*(*r_it).first)[1] > pi_point[1]) {
+            d.push_back((*r_it).second);
+            ++r_it;
+        }
+
+        auto r = (*it).second;
+        auto t = (*r_it).second;
+
+        T.erase(r_it.base(), it);
+
+        // Process right neighbor region, region R
+        while (!L[r].empty()) {
+            box3d &br = L[r].front();
+            if (br.ux >= pi_point[0]) {
+                br.lz = pi_point[2];
+                c[r] += box_volume(br);
+                L[r].pop_front();
+            } else if (br.lx > pi_point[0]) {
+                br.lz = pi_point[2];
+                c[r] += box_volume(br);
+                br.lx = pi_point[0];
+                br.uz = pi_point[2];
+                br.lz = NaN;
+                break;
+            } else {
+                break;
+            }
+        }
+
+        // Process dominated points, region M
+        double xleft = (*p[t])[0];
+        std::vector<vector_double::size_type>::reverse_iterator r_it_idx = d.rbegin();
+        std::vector<vector_double::size_type>::reverse_iterator r_it_idx_e = d.rend();
+        for (; r_it_idx != r_it_idx_e; ++r_it_idx) {
+            auto jdom = *r_it_idx;
+            while (!L[jdom].empty()) {
+                box3d &bm = L[jdom].front();
+                bm.lz = pi_point[2];
+                c[jdom] += box_volume(bm);
+                L[jdom].pop_front();
+            }
+            L[i].push_back(box3d(xleft, (*p[jdom])[1], NaN, (*p[jdom])[0], pi_point[1], pi_point[2]));
+            xleft = (*p[jdom])[0];
+        }
+        L[i].push_back(box3d(xleft, (*p[r])[1], NaN, pi_point[0], pi_point[1], pi_point[2]));
+        xleft = (*p[t])[0];
+
+        // Process left neighbor region, region L
+        while (!L[t].empty()) {
+            box3d &bl = L[t].back();
+            if (bl.ly > pi_point[1]) {
+                bl.lz = pi_point[2];
+                c[t] += box_volume(bl);
+                xleft = bl.lx;
+                L[t].pop_back();
+            } else {
+                break;
+            }
+        }
+        if (xleft > (*p[t])[0]) {
+            L[t].push_back(box3d(xleft, pi_point[1], NaN, (*p[t])[0], (*p[t])[1], pi_point[2]));
+        }
+        T.insert(std::make_pair(p[i], i));
+    }
+
+    // Fix the indices
+    contribs.assign(n, 0.0);
+    for (decltype(n) i = 0u; i < n; ++i) {
+        contribs[orig_idx[i]] = c[i];
+    }
+    return true;
+}
+
+PAGMO_DECL std::vector<double> hv3d::contributions(std::vector<vector_double> &points,
+                                                   const vector_double &r_point) const
+{
+    std::vector<vector_double::size_type> idxs(points.size());
+    std::iota(idxs.begin(), idxs.end(), vector_double::size_type(0u));
+    if (m_initial_sorting) {
+        detail::sort_by_key(idxs.begin(), idxs.end(),
+                            [&points](vector_double::size_type idx) { return points[idx][2]; });
+    }
+    std::vector<const vector_double *> p(points.size());
+    for (decltype(points.size()) i = 0u; i < points.size(); ++i) {
+        p[i] = &points[idxs[i]];
+    }
+    std::vector<double> contribs;
+    if (!contributions_impl(std::move(p), idxs, r_point, contribs)) {
+        // Point is dominated
+        return hvwfg(2).contributions(points, r_point);
+    }
+    return contribs;
+}
 
-    if (fdim == 2u) {
-        return hv2d().clone();
-    } else if (fdim == 3u) {
-        return hv3d().clone();
+PAGMO_DECL std::vector<double> hv3d::contributions_view(const hv_points_view &view, const vector_double &r_point,
+                                                        hv_workspace &ws) const
+{
+    if (view.has_excluded()) {
+        return hv_algorithm::contributions_view(view, r_point, ws);
+    }
+    const auto &points = view.get_points();
+    std::vector<vector_double::size_type> idxs;
+    if (m_initial_sorting) {
+        idxs = ws.sorted_order(points, 2u);
     } else {
-        return hvwfg().clone();
+        idxs.resize(points.size());
+        std::iota(idxs.begin(), idxs.end(), vector_double::size_type(0u));
+    }
+    std::vector<const vector_double *> p(points.size());
+    for (decltype(points.size()) i = 0u; i < points.size(); ++i) {
+        p[i] = &points[idxs[i]];
     }
+    std::vector<double> contribs;
+    if (!contributions_impl(std::move(p), idxs, r_point, contribs)) {
+        // Point is dominated
+        return hvwfg(2).contributions_view(view, r_point, ws);
+    }
+    return contribs;
+}
+
+PAGMO_DECL std::vector<double> hv2d::contributions(std::vector<vector_double> &points,
+                                                   const vector_double &r_point) const
+{
+    std::vector<vector_double> new_points(points.size(), vector_double(3, 0.0));
+    vector_double new_r(r_point);
+    new_r.push_back(1.0);
+
+    for (decltype(points.size()) i = 0u; i < points.size(); ++i) {
+        new_points[i][0] = points[i][0];
+        new_points[i][1] = points[i][1];
+        new_points[i][2] = 0.0;
+    }
+    // Set sorting to off since contributions are sorted by third dimension
+    return hv3d(false).contributions(new_points, new_r);
+}
+
+PAGMO_DECL std::vector<double> hv2d::contributions_view(const hv_points_view &view, const vector_double &r_point,
+                                                        hv_workspace &ws) const
+{
+    if (view.has_excluded() || view.size() < 2u) {
+        return hv_algorithm::contributions_view(view, r_point, ws);
+    }
+    const auto &points = view.get_points();
+    // Points sorted ascending on the first axis (and then on the second): in a non-dominated front without
+    // duplicates the second coordinate is then strictly decreasing.
+    const auto &order = ws.sorted_order(points, 0u);
+    for (decltype(order.size()) k = 1u; k < order.size(); ++k) {
+        if (points[order[k]][1] >= points[order[k - 1u]][1]) {
+            // Dominated or duplicated points: fall back on the general method.
+            return hv_algorithm::contributions_view(view, r_point, ws);
+        }
+    }
+    std::vector<double> c(points.size());
+    for (decltype(order.size()) k = 0u; k < order.size(); ++k) {
+        const auto &p = points[order[k]];
+        const double x_next = (k + 1u < order.size()) ? points[order[k + 1u]][0] : r_point[0];
+        const double y_prev = (k > 0u) ? points[order[k - 1u]][1] : r_point[1];
+        c[order[k]] = (x_next - p[0]) * (y_prev - p[1]);
+    }
+    return c;
 }
 }
 
 #endif
+
+#endif
@@ -0,0 +1,599 @@
+/*****************************************************************************
+*   Copyright (C) 2004-2015 The PaGMO development team,                     *
+*   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+*                                                                           *
+*   https://github.com/esa/pagmo                                            *
+*                                                                           *
+*   act@esa.int                                                             *
+*                                                                           *
+*   This program is free software; you can redistribute it and/or modify    *
+*   it under the terms of the GNU General Public License as published by    *
+*   the Free Software Foundation; either version 2 of the License, or       *
+*   (at your option) any later version.                                     *
+*                                                                           *
+*   This program is distributed in the hope that it will be useful,         *
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+*   GNU General Public License for more details.                            *
+*                                                                           *
+*   You should have received a copy of the GNU General Public License       *
+*   along with this program; if not, write to the                           *
+*   Free Software Foundation, Inc.,                                         *
+*   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+*****************************************************************************/
+
+#ifndef PAGMO_UTIL_HV_HVBD_H
+#define PAGMO_UTIL_HV_HVBD_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../detail/radix_sort.hpp"
+#include "../../detail/separate_compilation.hpp"
+#include "../../exceptions.hpp"
+#include "../../types.hpp"
+#include "hv_algorithm.hpp"
+
+namespace pagmo
+{
+
+/// Box decomposition of the region not dominated by a set of points
+/**
+ * This class maintains the set of local upper bounds of the region, bounded above by a reference point
+ * \f$ \mathbf r\f$, which is not dominated (in the minimisation sense) by the points inserted so far. Each local
+ * upper bound \f$ \mathbf u\f$ is described by its defining points \f$ \mathbf z^1(\mathbf u), \ldots,
+ * \mathbf z^n(\mathbf u)\f$, where \f$ z^j_j(\mathbf u) = u_j\f$, and induces the box
+ * \f$ [\mathbf l(\mathbf u), \mathbf u)\f$, with \f$ l_j(\mathbf u) = \max_{k < j} z^k_j(\mathbf u)\f$ (unbounded
+ * below for \f$ j = 1\f$). These boxes partition the non-dominated region.
+ *
+ * Inserting a point \f$ \mathbf p\f$ only touches the local upper bounds strictly dominated by \f$ \mathbf p\f$:
+ * the volume of the intersection of their boxes with \f$ [\mathbf p, \mathbf r]\f$ is exactly the new volume
+ * dominated by \f$ \mathbf p\f$, and they are replaced by the non-redundant bounds obtained by projecting them onto
+ * \f$ \mathbf p\f$ along each axis. The decomposition can thus be grown one point at a time, and queried between
+ * insertions for the contribution a candidate point would give, which makes it suitable for incremental hypervolume
+ * computations (e.g., for archives that are updated one point at a time).
+ *
+ * Ties between coordinates are broken by insertion order, which amounts to an infinitesimal perturbation of
+ * the points and leaves the computed volumes unchanged.
+ *
+ * @see "Kathrin Klamroth, Renaud Lacour, Daniel Vanderpooten. On the representation of the search region in
+ * multi-objective optimization. European Journal of Operational Research 245.3 (2015): 767-778."
+ * @see "Renaud Lacour, Kathrin Klamroth, Carlos M. Fonseca. A box decomposition algorithm to compute the hypervolume
+ * indicator. Computers & Operations Research 79 (2017): 347-360."
+ */
+class hv_box_decomposition
+{
+public:
+    /// Size type
+    using size_type = vector_double::size_type;
+
+    /// Constructor
+    /**
+     * Constructs an empty decomposition, whose only local upper bound is \p r_point.
+     *
+     * @param r_point the reference point
+     *
+     * @throws std::invalid_argument if \p r_point is empty
+     */
+    explicit hv_box_decomposition(const vector_double &r_point) : m_r_point(r_point), m_volume(0.)
+    {
+        if (r_point.empty()) {
+            pagmo_throw(std::invalid_argument, "The reference point of a box decomposition cannot be empty");
+        }
+        // The defining points of the reference point are the dummy points.
+        for (size_type k = 0u; k < r_point.size(); ++k) {
+            m_bounds.push_back(dummy(k));
+        }
+    }
+
+    /// Insert a point
+    /**
+     * Inserts \p p into the decomposition. Points not strictly dominating the reference point, and points
+     * dominated by the points already inserted, leave the decomposition untouched.
+     *
+     * @param p the point to be inserted
+     *
+     * @return the volume newly dominated by \p p (i.e., its exclusive contribution with respect to the points
+     * already inserted)
+     *
+     * @throws std::invalid_argument if the dimension of \p p differs from that of the reference point
+     */
+    double insert(const vector_double &p)
+    {
+        check_dimension(p);
+        return insert_impl(p.data());
+    }
+
+    /// Contribution of a point
+    /**
+     * @param p a point
+     *
+     * @return the volume that would be newly dominated by \p p if it were inserted
+     *
+     * @throws std::invalid_argument if the dimension of \p p differs from that of the reference point
+     */
+    double contribution(const vector_double &p) const
+    {
+        check_dimension(p);
+        if (!below_reference(p.data())) {
+            return 0.;
+        }
+        const auto dim = m_r_point.size();
+        const auto id = get_n_points();
+        double retval = 0.;
+        for (size_type b = 0u; b < get_n_boxes(); ++b) {
+            const size_type *u = &m_bounds[b * dim];
+            if (dominates(p.data(), id, u)) {
+                retval += clipped_volume(p.data(), u);
+            }
+        }
+        return retval;
+    }
+
+    /// Dominated volume
+    /**
+     * @return the volume dominated by the points inserted so far and bounded by the reference point, i.e., their
+     * hypervolume
+     */
+    double get_volume() const
+    {
+        return m_volume;
+    }
+
+    /// Reference point
+    /**
+     * @return a const reference to the reference point
+     */
+    const vector_double &get_r_point() const
+    {
+        return m_r_point;
+    }
+
+    /// Number of boxes
+    /**
+     * @return the number of local upper bounds (and thus of boxes) in the decomposition
+     */
+    size_type get_n_boxes() const
+    {
+        return m_bounds.size() / m_r_point.size();
+    }
+
+    /// Number of points
+    /**
+     * @return the number of points that modified the decomposition when inserted
+     */
+    size_type get_n_points() const
+    {
+        return m_points.size() / m_r_point.size();
+    }
+
+private:
+    // Allows hvbd to insert projections of the points without copying them.
+    friend class hvbd;
+
+    void check_dimension(const vector_double &p) const
+    {
+        if (p.size() != m_r_point.size()) {
+            pagmo_throw(std::invalid_argument, "The dimension of the point (" + std::to_string(p.size())
+                                                   + ") differs from the dimension of the reference point ("
+                                                   + std::to_string(m_r_point.size()) + ")");
+        }
+    }
+    // Index of the k-th dummy point, whose k-th coordinate is r_k while the others are -inf.
+    static size_type dummy(size_type k)
+    {
+        return std::numeric_limits<size_type>::max() - k;
+    }
+    bool is_dummy(size_type idx) const
+    {
+        return idx > std::numeric_limits<size_type>::max() - m_r_point.size();
+    }
+    // Value of the j-th coordinate of the point idx.
+    double value(size_type idx, size_type j) const
+    {
+        if (is_dummy(idx)) {
+            return (dummy(j) == idx) ? m_r_point[j] : -std::numeric_limits<double>::infinity();
+        }
+        return m_points[idx * m_r_point.size() + j];
+    }
+    // Strict ordering of the j-th coordinates of two points: ties are broken by insertion order, the own
+    // coordinate of a dummy point coming after all the others and the remaining ones before all the others.
+    bool less(double a, size_type a_idx, size_type b_idx, size_type j) const
+    {
+        const double b = value(b_idx, j);
+        if (a != b) {
+            return a < b;
+        }
+        if (is_dummy(b_idx)) {
+            return dummy(j) == b_idx;
+        }
+        return a_idx < b_idx;
+    }
+    // Does the point p with insertion index id strictly dominate the local upper bound u?
+    bool dominates(const double *p, size_type id, const size_type *u) const
+    {
+        for (size_type j = 0u; j < m_r_point.size(); ++j) {
+            if (!less(p[j], id, u[j], j)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool below_reference(const double *p) const
+    {
+        for (size_type j = 0u; j < m_r_point.size(); ++j) {
+            if (!(p[j] < m_r_point[j])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    // Volume of the intersection of the box induced by u with the region above p.
+    double clipped_volume(const double *p, const size_type *u) const
+    {
+        double retval = 1.;
+        for (size_type j = 0u; j < m_r_point.size(); ++j) {
+            // l_j(u) = max_{k < j} z^k_j(u).
+            double lower = -std::numeric_limits<double>::infinity();
+            for (size_type k = 0u; k < j; ++k) {
+                lower = std::max(lower, value(u[k], j));
+            }
+            const double side = value(u[j], j) - std::max(lower, p[j]);
+            if (!(side > 0.)) {
+                return 0.;
+            }
+            retval *= side;
+        }
+        return retval;
+    }
+    double insert_impl(const double *p)
+    {
+        if (!below_reference(p)) {
+            return 0.;
+        }
+        const auto dim = m_r_point.size();
+        const auto n_bounds = get_n_boxes();
+        const auto id = get_n_points();
+        double gain = 0.;
+        bool dominating = false;
+        m_new_bounds.clear();
+        for (size_type b = 0u; b < n_bounds; ++b) {
+            const size_type *u = &m_bounds[b * dim];
+            if (!dominates(p, id, u)) {
+                m_new_bounds.insert(m_new_bounds.end(), u, u + dim);
+                continue;
+            }
+            dominating = true;
+            gain += clipped_volume(p, u);
+            // The projection of u onto p along the axis j is a local upper bound of the new set iff
+            // p_j is greater than the j-th coordinate of all the other defining points of u.
+            for (size_type j = 0u; j < dim; ++j) {
+                bool keep = true;
+                for (size_type k = 0u; k < dim && keep; ++k) {
+                    keep = (k == j) || !less(p[j], id, u[k], j);
+                }
+                if (keep) {
+                    const auto offset = m_new_bounds.size();
+                    m_new_bounds.insert(m_new_bounds.end(), u, u + dim);
+                    m_new_bounds[offset + j] = id;
+                }
+            }
+        }
+        if (dominating) {
+            m_bounds.swap(m_new_bounds);
+            m_points.insert(m_points.end(), p, p + dim);
+            m_volume += gain;
+        }
+        return gain;
+    }
+
+    vector_double m_r_point;
+    // Coordinates of the inserted points, stored contiguously.
+    vector_double m_points;
+    // Defining points of the local upper bounds, stored contiguously.
+    std::vector<size_type> m_bounds;
+    // Buffer reused across insertions.
+    std::vector<size_type> m_new_bounds;
+    double m_volume;
+};
+
+namespace detail
+{
+
+// Data cached by hvbd in a workspace: the hypervolume and the exclusive contributions of the whole set of points,
+// for the reference point m_r_point.
+struct hvbd_workspace_data : hv_workspace_data {
+    hvbd_workspace_data() : m_has_volume(false), m_volume(0.)
+    {
+    }
+    // Selects the reference point of the queries, discarding the cached results if it changed.
+    void select(const vector_double &r_point)
+    {
+        if (m_r_point != r_point) {
+            m_r_point.assign(r_point.begin(), r_point.end());
+            m_has_volume = false;
+            m_contributions.clear();
+        }
+    }
+    vector_double m_r_point;
+    bool m_has_volume;
+    double m_volume;
+    std::vector<double> m_contributions;
+};
+}
+
+/// Box decomposition hypervolume algorithm
+/**
+ * This class computes the hypervolume by sweeping the points along the last objective in ascending order, while
+ * maintaining a pagmo::hv_box_decomposition of the projections of the points onto the remaining objectives. The
+ * hypervolume is then the sum, over the points, of the area newly dominated by each projection times the distance
+ * from the point to the reference point along the last objective.
+ *
+ * The algorithm is exact and handles any dimension greater than or equal to 2. It is typically competitive with
+ * pagmo::hvwfg on fronts with many objectives; see pagmo::hv_selector for the automatic choice between the two.
+ * Incremental computations can use pagmo::hv_box_decomposition directly.
+ *
+ * The exclusive contributions are computed by divide and conquer: the contribution of each point is queried on the
+ * decomposition of all the other points, which is built by splitting the set of points in halves and inserting each
+ * half into a copy of the decomposition used for the other half. Every point is thus inserted \f$ O(\log n)\f$
+ * times, instead of the \f$ n\f$ times required by computing the hypervolume of the set without each point. The
+ * view-based methods store the hypervolume and the contributions in the workspace, so that repeated queries with the
+ * same reference point (e.g., the contributions followed by the least contributor) are not computed again.
+ *
+ * @see "Renaud Lacour, Kathrin Klamroth, Carlos M. Fonseca. A box decomposition algorithm to compute the hypervolume
+ * indicator. Computers & Operations Research 79 (2017): 347-360."
+ */
+class hvbd : public hv_algorithm
+{
+public:
+    /// Compute hypervolume
+    /**
+     * @param points vector of points containing the D-dimensional points for which we compute the hypervolume
+     * @param r_point reference point for the points
+     *
+     * @return hypervolume.
+     */
+    double compute(std::vector<vector_double> &points, const vector_double &r_point) const;
+
+    /// Compute hypervolume on a view
+    /**
+     * @param view the D-dimensional points for which we compute the hypervolume
+     * @param r_point reference point for the points
+     *
+     * @return hypervolume.
+     */
+    double compute_view(const hv_points_view &view, const vector_double &r_point, hv_workspace &ws) const;
+
+    /// Exclusive hypervolume method on a view
+    /**
+     * @param p_idx index of the individual in \p view
+     * @param view the D-dimensional points
+     * @param r_point reference point for the points
+     * @param ws workspace bound to the set of points underlying \p view
+     *
+     * @return exlusive hypervolume contributed by the individual at index p_idx
+     */
+    double exclusive_view(unsigned int p_idx, const hv_points_view &view, const vector_double &r_point,
+                          hv_workspace &ws) const;
+
+    /// Contributions method on a view
+    /**
+     * @param view the D-dimensional points for which we compute the contributions
+     * @param r_point reference point for the points
+     * @param ws workspace bound to the set of points underlying \p view
+     *
+     * @return the single contributions
+     */
+    std::vector<double> contributions_view(const hv_points_view &view, const vector_double &r_point,
+                                           hv_workspace &ws) const;
+
+    /// Contributions method
+    /**
+     * @param points vector of points containing the D-dimensional points for which we compute the contributions
+     * @param r_point reference point for the points
+     *
+     * @return the single contributions
+     */
+    std::vector<double> contributions(std::vector<vector_double> &points, const vector_double &r_point) const;
+
+    /// Least contributor method on a view
+    /**
+     * @param view the D-dimensional points
+     * @param r_point reference point for the points
+     * @param ws workspace bound to the set of points underlying \p view
+     *
+     * @return index of the least contributor
+     */
+    unsigned long long least_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                              hv_workspace &ws) const;
+
+    /// Greatest contributor method on a view
+    /**
+     * @param view the D-dimensional points
+     * @param r_point reference point for the points
+     * @param ws workspace bound to the set of points underlying \p view
+     *
+     * @return index of the greatest contributor
+     */
+    unsigned long long greatest_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                 hv_workspace &ws) const;
+
+    /// Verify before compute method
+    /**
+     * Verifies whether given algorithm suits the requested data.
+     *
+     * @param points vector of points containing the D-dimensional points for which we compute the hypervolume
+     * @param r_point reference point for the vector of points
+     *
+     * @throws value_error when trying to compute the hypervolume for the non-maximal reference point
+     */
+    void verify_before_compute(const std::vector<vector_double> &points, const vector_double &r_point) const;
+
+    /// Clone method.
+    /**
+     * @return a pointer to a new object cloning this
+     */
+    std::shared_ptr<hv_algorithm> clone() const;
+
+    /// Algorithm name
+    /**
+     * @return The name of this particular algorithm
+     */
+    std::string get_name() const;
+
+private:
+    // Computes the contributions of the points of view in the index range [first, last), given the decomposition bd
+    // of all the other points of view.
+    static void contributions_impl(const hv_points_view &view, hv_points_view::size_type first,
+                                   hv_points_view::size_type last, hv_box_decomposition bd, std::vector<double> &c);
+    static double compute_impl(const hv_points_view &view, const vector_double &r_point);
+};
+
+// Definitions of the member functions declared above (see detail/separate_compilation.hpp).
+#if defined(PAGMO_HEADER_DEFINITIONS)
+
+PAGMO_DECL double hvbd::compute(std::vector<vector_double> &points, const vector_double &r_point) const
+{
+    return compute_impl(hv_points_view(points), r_point);
+}
+
+PAGMO_DECL double hvbd::compute_view(const hv_points_view &view, const vector_double &r_point, hv_workspace &ws) const
+{
+    if (view.has_excluded()) {
+        return compute_impl(view, r_point);
+    }
+    auto &data = ws.algorithm_data<detail::hvbd_workspace_data>(view.get_points());
+    data.select(r_point);
+    if (!data.m_has_volume) {
+        data.m_volume = compute_impl(view, r_point);
+        data.m_has_volume = true;
+    }
+    return data.m_volume;
+}
+
+PAGMO_DECL double hvbd::exclusive_view(unsigned int p_idx, const hv_points_view &view, const vector_double &r_point,
+                                       hv_workspace &ws) const
+{
+    if (view.has_excluded() || view.size() == 1u) {
+        return hv_algorithm::exclusive_view(p_idx, view, r_point, ws);
+    }
+    auto &data = ws.algorithm_data<detail::hvbd_workspace_data>(view.get_points());
+    data.select(r_point);
+    if (!data.m_contributions.empty()) {
+        return data.m_contributions[p_idx];
+    }
+    return compute_view(view, r_point, ws) - compute_impl(hv_points_view(view.get_points(), p_idx), r_point);
+}
+
+PAGMO_DECL std::vector<double> hvbd::contributions_view(const hv_points_view &view, const vector_double &r_point,
+                                                        hv_workspace &ws) const
+{
+    if (view.has_excluded() || view.size() == 1u) {
+        return hv_algorithm::contributions_view(view, r_point, ws);
+    }
+    auto &data = ws.algorithm_data<detail::hvbd_workspace_data>(view.get_points());
+    data.select(r_point);
+    if (data.m_contributions.empty()) {
+        std::vector<double> c(view.size());
+        contributions_impl(view, 0u, view.size(), hv_box_decomposition(r_point), c);
+        data.m_contributions = std::move(c);
+    }
+    return data.m_contributions;
+}
+
+PAGMO_DECL std::vector<double> hvbd::contributions(std::vector<vector_double> &points,
+                                                   const vector_double &r_point) const
+{
+    hv_workspace ws;
+    return contributions_view(hv_points_view(points), r_point, ws);
+}
+
+PAGMO_DECL unsigned long long hvbd::least_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                           hv_workspace &ws) const
+{
+    return extreme_contributor_view(view, r_point, ws, [](double a, double b) { return a < b; });
+}
+
+PAGMO_DECL unsigned long long hvbd::greatest_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                              hv_workspace &ws) const
+{
+    return extreme_contributor_view(view, r_point, ws, [](double a, double b) { return a > b; });
+}
+
+PAGMO_DECL void hvbd::verify_before_compute(const std::vector<vector_double> &points,
+                                            const vector_double &r_point) const
+{
+    hv_algorithm::assert_minimisation(points, r_point);
+}
+
+PAGMO_DECL std::shared_ptr<hv_algorithm> hvbd::clone() const
+{
+    return std::shared_ptr<hv_algorithm>(new hvbd(*this));
+}
+
+PAGMO_DECL std::string hvbd::get_name() const
+{
+    return "Box decomposition algorithm";
+}
+
+PAGMO_DECL void hvbd::contributions_impl(const hv_points_view &view, hv_points_view::size_type first,
+                                         hv_points_view::size_type last, hv_box_decomposition bd,
+                                         std::vector<double> &c)
+{
+    if (last - first == 1u) {
+        c[first] = bd.contribution(view[first]);
+        return;
+    }
+    const auto mid = first + (last - first) / 2u;
+    hv_box_decomposition bd_first(bd);
+    for (auto i = mid; i < last; ++i) {
+        bd_first.insert_impl(view[i].data());
+    }
+    contributions_impl(view, first, mid, std::move(bd_first), c);
+    for (auto i = first; i < mid; ++i) {
+        bd.insert_impl(view[i].data());
+    }
+    contributions_impl(view, mid, last, std::move(bd), c);
+}
+
+PAGMO_DECL double hvbd::compute_impl(const hv_points_view &view, const vector_double &r_point)
+{
+    const auto n = view.size();
+    if (n == 0u) {
+        return 0.;
+    }
+    const auto dim = r_point.size();
+    const auto last = dim - 1u;
+    // Sweep order: ascending along the last objective.
+    std::vector<vector_double::size_type> order(n);
+    std::iota(order.begin(), order.end(), vector_double::size_type(0u));
+    detail::sort_by_key(order.begin(), order.end(),
+                        [&view, last](vector_double::size_type idx) { return view[idx][last]; });
+    hv_box_decomposition bd(vector_double(r_point.begin(), r_point.begin() + static_cast<std::ptrdiff_t>(last)));
+    double retval = 0.;
+    for (auto idx : order) {
+        const auto &p = view[idx];
+        if (!(p[last] < r_point[last])) {
+            break;
+        }
+        retval += bd.insert_impl(p.data()) * (r_point[last] - p[last]);
+    }
+    return retval;
+}
+
+#endif
+
+}
+
+// The headers below include, via hypervolume.hpp, the headers of all the exact algorithms: they are included after
+// the class definition, so that the class is complete whatever the order of inclusion.
+#include "../hypervolume.hpp"
+
+#endif
@@ -31,11 +31,11 @@
 #include <string>
 #include <vector>
 
+#include "../../detail/separate_compilation.hpp"
 #include "../../exceptions.hpp"
 #include "../../io.hpp"
 #include "../../population.hpp"
 #include "../../types.hpp"
-#include "../hypervolume.hpp"
 #include "hv_algorithm.hpp"
 
 namespace pagmo
@@ -57,12 +57,7 @@ public:
     /**
      * @param stop_dimension The stop dimension
      */
-    hvwfg(unsigned int stop_dimension = 2u) : hv_algorithm(), m_current_slice(0), m_stop_dimension(stop_dimension)
-    {
-        if (stop_dimension < 2u) {
-            pagmo_throw(std::invalid_argument, "Stop dimension for WFG must be greater than or equal to 2");
-        }
-    }
+    hvwfg(unsigned int stop_dimension = 2u);
 
     /// Compute hypervolume
     /**
@@ -73,13 +68,34 @@ public:
     *
     * @return hypervolume.
     */
-    double compute(std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        allocate_wfg_members(points, r_point);
-        double hv = compute_hv(1);
-        free_wfg_members();
-        return hv;
-    }
+    double compute(std::vector<vector_double> &points, const vector_double &r_point) const;
+
+    /// Compute hypervolume on a view
+    /**
+    * Computes the hypervolume using the WFG algorithm. The points in \p view are read directly when filling the
+    * internal frames of the algorithm, so that no intermediate copy takes place.
+    *
+    * @param view the D-dimensional points for which we compute the hypervolume
+    * @param r_point reference point for the points
+    *
+    * @return hypervolume.
+    */
+    double compute_view(const hv_points_view &view, const vector_double &r_point, hv_workspace &) const;
+
+    /// Exclusive hypervolume method on a view.
+    /**
+    * Computes the exclusive hypervolume as the difference of two calls to hvwfg::compute_view(), without copying the
+    * points.
+    *
+    * @param p_idx index of the individual in \p view
+    * @param view the D-dimensional points
+    * @param r_point reference point for the points
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return exlusive hypervolume contributed by the individual at index p_idx
+    */
+    double exclusive_view(unsigned int p_idx, const hv_points_view &view, const vector_double &r_point,
+                          hv_workspace &ws) const;
 
     /// Contributions method
     /**
@@ -101,33 +117,41 @@ public:
     *
     * @return the single contributions
     */
-    std::vector<double> contributions(std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        std::vector<double> c;
-        c.reserve(points.size());
-
-        // Allocate the same members as for 'compute' method
-        allocate_wfg_members(points, r_point);
-
-        // Prepare the memory for first front
-        double **fr = new double *[m_max_points];
-        for (unsigned int i = 0; i < m_max_points; ++i) {
-            fr[i] = new double[m_current_slice];
-        }
-        m_frames[m_n_frames] = fr;
-        m_frames_size[m_n_frames] = 0;
-        ++m_n_frames;
+    std::vector<double> contributions(std::vector<vector_double> &points, const vector_double &r_point) const;
 
-        for (unsigned int p_idx = 0u; p_idx < m_max_points; ++p_idx) {
-            limitset(0, p_idx, 1);
-            c.push_back(exclusive_hv(p_idx, 1));
-        }
+    /// Contributions method on a view
+    /**
+    * Same as hvwfg::contributions(), reading the points directly from \p view.
+    *
+    * @param view the D-dimensional points for which we compute the contributions
+    * @param r_point reference point for the points
+    *
+    * @return the single contributions
+    */
+    std::vector<double> contributions_view(const hv_points_view &view, const vector_double &r_point,
+                                           hv_workspace &) const;
 
-        // Free the contributions and the remaining WFG members
-        free_wfg_members();
+    /// Least contributor method on a view
+    /**
+    * @param view the D-dimensional points
+    * @param r_point reference point for the points
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return index of the least contributor
+    */
+    unsigned long long least_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                              hv_workspace &ws) const;
 
-        return c;
-    }
+    /// Greatest contributor method on a view
+    /**
+    * @param view the D-dimensional points
+    * @param r_point reference point for the points
+    * @param ws workspace bound to the set of points underlying \p view
+    *
+    * @return index of the greatest contributor
+    */
+    unsigned long long greatest_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                 hv_workspace &ws) const;
 
     /// Verify before compute method
     /**
@@ -138,241 +162,47 @@ public:
     *
     * @throws value_error when trying to compute the hypervolume for the non-maximal reference point
     */
-    void verify_before_compute(const std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        hv_algorithm::assert_minimisation(points, r_point);
-    }
+    void verify_before_compute(const std::vector<vector_double> &points, const vector_double &r_point) const;
 
     /// Clone method.
     /**
      * @return a pointer to a new object cloning this
      */
-    std::shared_ptr<hv_algorithm> clone() const
-    {
-        return std::shared_ptr<hv_algorithm>(new hvwfg(*this));
-    }
+    std::shared_ptr<hv_algorithm> clone() const;
 
     /// Algorithm name
     /**
      * @return The name of this particular algorithm
      */
-    std::string get_name() const
-    {
-        return "WFG algorithm";
-    }
+    std::string get_name() const;
 
 private:
-    /// Limit the set of points to point at p_idx
-    void limitset(unsigned int begin_idx, unsigned int p_idx, unsigned int rec_level) const
-    {
-        double **points = m_frames[rec_level - 1];
-        auto n_points = m_frames_size[rec_level - 1];
+    // WFG computation of the hypervolume of the points in view
+    double compute_impl(const hv_points_view &view, const vector_double &r_point) const;
 
-        vector_double::size_type no_points = 0u;
-
-        double *p = points[p_idx];
-        double **frame = m_frames[rec_level];
-
-        for (auto idx = begin_idx; idx < n_points; ++idx) {
-            if (idx == p_idx) {
-                continue;
-            }
-
-            for (decltype(m_current_slice) f_idx = 0u; f_idx < m_current_slice; ++f_idx) {
-                frame[no_points][f_idx] = std::max(points[idx][f_idx], p[f_idx]);
-            }
-
-            std::vector<int> cmp_results;
-            cmp_results.resize(no_points);
-            double *s = frame[no_points];
-
-            bool keep_s = true;
-
-            // Check whether any point is dominating the point 's'.
-            for (decltype(no_points) q_idx = 0u; q_idx < no_points; ++q_idx) {
-                cmp_results[q_idx] = hv_algorithm::dom_cmp(s, frame[q_idx], m_current_slice);
-                if (cmp_results[q_idx] == hv_algorithm::DOM_CMP_B_DOMINATES_A) {
-                    keep_s = false;
-                    break;
-                }
-            }
-
-            // If neither is, remove points dominated by 's' (we store that during the first loop).
-            if (keep_s) {
-                vector_double::size_type prev = 0u;
-                vector_double::size_type next = 0u;
-                while (next < no_points) {
-                    if (cmp_results[next] != hv_algorithm::DOM_CMP_A_DOMINATES_B
-                        && cmp_results[next] != hv_algorithm::DOM_CMP_A_B_EQUAL) {
-                        if (prev < next) {
-                            for (decltype(m_current_slice) d_idx = 0u; d_idx < m_current_slice; ++d_idx) {
-                                frame[prev][d_idx] = frame[next][d_idx];
-                            }
-                        }
-                        ++prev;
-                    }
-                    ++next;
-                }
-                // Append 's' at the end, if prev==next it's not necessary as it's already there.
-                if (prev < next) {
-                    for (decltype(m_current_slice) d_idx = 0u; d_idx < m_current_slice; ++d_idx) {
-                        frame[prev][d_idx] = s[d_idx];
-                    }
-                }
-                no_points = prev + 1u;
-            }
-        }
+    // WFG computation of the exclusive contributions of the points in view
+    std::vector<double> contributions_impl(const hv_points_view &view, const vector_double &r_point) const;
 
-        m_frames_size[rec_level] = no_points;
-    }
+    /// Limit the set of points to point at p_idx
+    void limitset(unsigned int begin_idx, unsigned int p_idx, unsigned int rec_level) const;
 
     /// Compute the exclusive hypervolume of point at p_idx
-    double exclusive_hv(unsigned int p_idx, unsigned int rec_level) const
-    {
-        // double H = hv_algorithm::volume_between(points[p_idx], m_refpoint, m_current_slice);
-        double H = hv_algorithm::volume_between(m_frames[rec_level - 1][p_idx], m_refpoint, m_current_slice);
-
-        if (m_frames_size[rec_level] == 1) {
-            H -= hv_algorithm::volume_between(m_frames[rec_level][0], m_refpoint, m_current_slice);
-        } else if (m_frames_size[rec_level] > 1) {
-            H -= compute_hv(rec_level + 1);
-        }
-
-        return H;
-    }
+    double exclusive_hv(unsigned int p_idx, unsigned int rec_level) const;
 
     /// Compute the hypervolume recursively
-    double compute_hv(unsigned int rec_level) const
-    {
-        double **points = m_frames[rec_level - 1];
-        auto n_points = m_frames_size[rec_level - 1];
-
-        // Simple inclusion-exclusion for one and two points
-        if (n_points == 1u) {
-            return hv_algorithm::volume_between(points[0], m_refpoint, m_current_slice);
-        } else if (n_points == 2u) {
-            double hv = hv_algorithm::volume_between(points[0], m_refpoint, m_current_slice)
-                        + hv_algorithm::volume_between(points[1], m_refpoint, m_current_slice);
-            double isect = 1.0;
-            for (decltype(m_current_slice) i = 0u; i < m_current_slice; ++i) {
-                isect *= (m_refpoint[i] - std::max(points[0][i], points[1][i]));
-            }
-            return hv - isect;
-        }
-
-        // If already sliced to dimension at which we use another algorithm.
-        if (m_current_slice == m_stop_dimension) {
-
-            if (m_stop_dimension == 2u) {
-                // Use a very efficient version of hv2d
-                return hv2d().compute(points, n_points, m_refpoint);
-            } else {
-                // Let hypervolume object pick the best method otherwise.
-                std::vector<vector_double> points_cpy;
-                points_cpy.reserve(n_points);
-                for (decltype(n_points) i = 0u; i < n_points; ++i) {
-                    points_cpy.push_back(vector_double(points[i], points[i] + m_current_slice));
-                }
-                vector_double r_cpy(m_refpoint, m_refpoint + m_current_slice);
-
-                hypervolume hv = hypervolume(points_cpy, false);
-                hv.set_copy_points(false);
-                return hv.compute(r_cpy);
-            }
-        } else {
-            // Otherwise, sort the points in preparation for the next recursive step
-            // Bind the object under "this" pointer to the cmp_points method so it can be used as a valid comparator
-            // function for std::sort
-            // We need that in order for the cmp_points to have acces to the m_current_slice member variable.
-            std::sort(points, points + n_points, [this](double *a, double *b) { return this->cmp_points(a, b); });
-        }
-
-        double H = 0.0;
-        --m_current_slice;
-
-        if (rec_level >= m_n_frames) {
-            double **fr = new double *[m_max_points];
-            for (decltype(m_max_points) i = 0u; i < m_max_points; ++i) {
-                fr[i] = new double[m_current_slice];
-            }
-            m_frames[m_n_frames] = fr;
-            m_frames_size[m_n_frames] = 0u;
-            ++m_n_frames;
-        }
-
-        for (unsigned int p_idx = 0u; p_idx < n_points; ++p_idx) {
-            limitset(p_idx + 1u, p_idx, rec_level);
-
-            H += std::abs((points[p_idx][m_current_slice] - m_refpoint[m_current_slice])
-                          * exclusive_hv(p_idx, rec_level));
-        }
-        ++m_current_slice;
-        return H;
-    }
+    double compute_hv(unsigned int rec_level) const;
 
     /// Comparator function for sorting
     /**
     * Comparison function for WFG. Can't be static in order to have access to member variable m_current_slice.
     */
-    bool cmp_points(double *a, double *b) const
-    {
-        for (auto i = m_current_slice; i > 0u; --i) {
-            if (a[i - 1] > b[i - 1]) {
-                return true;
-            } else if (a[i - 1] < b[i - 1]) {
-                return false;
-            }
-        }
-        return false;
-    }
+    bool cmp_points(double *a, double *b) const;
 
     /// Allocate the memory for the 'compute' method
-    void allocate_wfg_members(std::vector<vector_double> &points, const vector_double &r_point) const
-    {
-        m_max_points = points.size();
-        m_max_dim = r_point.size();
-
-        m_refpoint = new double[m_max_dim];
-        for (decltype(m_max_dim) d_idx = 0u; d_idx < m_max_dim; ++d_idx) {
-            m_refpoint[d_idx] = r_point[d_idx];
-        }
-
-        // Reserve the space beforehand for each level or recursion.
-        // WFG with slicing feature will not go recursively deeper than the dimension size.
-        m_frames = new double **[m_max_dim];
-        m_frames_size = new vector_double::size_type[m_max_dim];
-
-        // Copy the initial set into the frame at index 0.
-        double **fr = new double *[m_max_points];
-        for (decltype(m_max_points) p_idx = 0; p_idx < m_max_points; ++p_idx) {
-            fr[p_idx] = new double[m_max_dim];
-            for (decltype(m_max_dim) d_idx = 0u; d_idx < m_max_dim; ++d_idx) {
-                fr[p_idx][d_idx] = points[p_idx][d_idx];
-            }
-        }
-        m_frames[0] = fr;
-        m_frames_size[0] = m_max_points;
-        m_n_frames = 1u;
-
-        // Variable holding the current "depth" of dimension slicing. We progress by slicing dimensions from the end.
-        m_current_slice = m_max_dim;
-    }
+    void allocate_wfg_members(const hv_points_view &points, const vector_double &r_point) const;
 
     /// Free the previously allocated memory
-    void free_wfg_members() const
-    {
-        // Free the memory.
-        delete[] m_refpoint;
-
-        for (decltype(m_n_frames) fr_idx = 0u; fr_idx < m_n_frames; ++fr_idx) {
-            for (decltype(m_max_points) p_idx = 0u; p_idx < m_max_points; ++p_idx) {
-                delete[] m_frames[fr_idx][p_idx];
-            }
-            delete[] m_frames[fr_idx];
-        }
-        delete[] m_frames;
-        delete[] m_frames_size;
-    }
+    void free_wfg_members() const;
 
     /**
      * 'compute' and 'extreme_contributor' method variables section.
@@ -410,4 +240,325 @@ private:
     const unsigned int m_stop_dimension;
 };
 }
+
+// The headers below include, via hypervolume.hpp, the headers of all the exact algorithms: they are included after
+// the class definition, so that the class is complete whatever the order of inclusion.
+#include "../hypervolume.hpp"
+#include "hv_hv2d.hpp"
+
+// Definitions of the member functions declared above (see detail/separate_compilation.hpp).
+#if defined(PAGMO_HEADER_DEFINITIONS)
+
+namespace pagmo
+{
+
+PAGMO_DECL hvwfg::hvwfg(unsigned int stop_dimension)
+    : hv_algorithm(), m_current_slice(0), m_stop_dimension(stop_dimension)
+{
+    if (stop_dimension < 2u) {
+        pagmo_throw(std::invalid_argument, "Stop dimension for WFG must be greater than or equal to 2");
+    }
+}
+
+PAGMO_DECL double hvwfg::compute(std::vector<vector_double> &points, const vector_double &r_point) const
+{
+    return compute_impl(hv_points_view(points), r_point);
+}
+
+PAGMO_DECL double hvwfg::compute_view(const hv_points_view &view, const vector_double &r_point, hv_workspace &) const
+{
+    return compute_impl(view, r_point);
+}
+
+PAGMO_DECL double hvwfg::exclusive_view(unsigned int p_idx, const hv_points_view &view, const vector_double &r_point,
+                                        hv_workspace &ws) const
+{
+    if (view.has_excluded() || view.size() == 1u) {
+        return hv_algorithm::exclusive_view(p_idx, view, r_point, ws);
+    }
+    return compute_impl(view, r_point) - compute_impl(hv_points_view(view.get_points(), p_idx), r_point);
+}
+
+PAGMO_DECL std::vector<double> hvwfg::contributions(std::vector<vector_double> &points,
+                                                    const vector_double &r_point) const
+{
+    return contributions_impl(hv_points_view(points), r_point);
+}
+
+PAGMO_DECL std::vector<double> hvwfg::contributions_view(const hv_points_view &view, const vector_double &r_point,
+                                                         hv_workspace &) const
+{
+    return contributions_impl(view, r_point);
+}
+
+PAGMO_DECL unsigned long long hvwfg::least_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                            hv_workspace &ws) const
+{
+    return extreme_contributor_view(view, r_point, ws, [](double a, double b) { return a < b; });
+}
+
+PAGMO_DECL unsigned long long hvwfg::greatest_contributor_view(const hv_points_view &view, const vector_double &r_point,
+                                                               hv_workspace &ws) const
+{
+    return extreme_contributor_view(view, r_point, ws, [](double a, double b) { return a > b; });
+}
+
+PAGMO_DECL void hvwfg::verify_before_compute(const std::vector<vector_double> &points,
+                                             const vector_double &r_point) const
+{
+    hv_algorithm::assert_minimisation(points, r_point);
+}
+
+PAGMO_DECL std::shared_ptr<hv_algorithm> hvwfg::clone() const
+{
+    return std::shared_ptr<hv_algorithm>(new hvwfg(*this));
+}
+
+PAGMO_DECL std::string hvwfg::get_name() const
+{
+    return "WFG algorithm";
+}
+
+PAGMO_DECL double hvwfg::compute_impl(const hv_points_view &view, const vector_double &r_point) const
+{
+    allocate_wfg_members(view, r_point);
+    double hv = compute_hv(1);
+    free_wfg_members();
+    return hv;
+}
+
+PAGMO_DECL std::vector<double> hvwfg::contributions_impl(const hv_points_view &view, const vector_double &r_point) const
+{
+    std::vector<double> c;
+    c.reserve(view.size());
+
+    // Allocate the same members as for 'compute' method
+    allocate_wfg_members(view, r_point);
+
+    // Prepare the memory for first front
+    double **fr = new double *[m_max_points];
+    for (unsigned int i = 0; i < m_max_points; ++i) {
+        fr[i] = new double[m_current_slice];
+    }
+    m_frames[m_n_frames] = fr;
+    m_frames_size[m_n_frames] = 0;
+    ++m_n_frames;
+
+    for (unsigned int p_idx = 0u; p_idx < m_max_points; ++p_idx) {
+        limitset(0, p_idx, 1);
+        c.push_back(exclusive_hv(p_idx, 1));
+    }
+
+    // Free the contributions and the remaining WFG members
+    free_wfg_members();
+
+    return c;
+}
+
+PAGMO_DECL void hvwfg::limitset(unsigned int begin_idx, unsigned int p_idx, unsigned int rec_level) const
+{
+    double **points = m_frames[rec_level - 1];
+    auto n_points = m_frames_size[rec_level - 1];
+
+    vector_double::size_type no_points = 0u;
+
+    double *p = points[p_idx];
+    double **frame = m_frames[rec_level];
+
+    for (auto idx = begin_idx; idx < n_points; ++idx) {
+        if (idx == p_idx) {
+            continue;
+        }
+
+        for (decltype(m_current_slice) f_idx = 0u; f_idx < m_current_slice; ++f_idx) {
+            frame[no_points][f_idx] = std::max(points[idx][f_idx], p[f_idx]);
+        }
+
+        std::vector<int> cmp_results;
+        cmp_results.resize(no_points);
+        double *s = frame[no_points];
+
+        bool keep_s = true;
+
+        // Check whether any point is dominating the point 's'.
+        for (decltype(no_points) q_idx = 0u; q_idx < no_points; ++q_idx) {
+            cmp_results[q_idx] = hv_algorithm::dom_cmp(s, frame[q_idx], m_current_slice);
+            if (cmp_results[q_idx] == hv_algorithm::DOM_CMP_B_DOMINATES_A) {
+                keep_s = false;
+                break;
+            }
+        }
+
+        // If neither is, remove points dominated by 's' (we store that during the first loop).
+        if (keep_s) {
+            vector_double::size_type prev = 0u;
+            vector_double::size_type next = 0u;
+            while (next < no_points) {
+                if (cmp_results[next] != hv_algorithm::DOM_CMP_A_DOMINATES_B
+                    && cmp_results[next] != hv_algorithm::DOM_CMP_A_B_EQUAL) {
+                    if (prev < next) {
+                        for (decltype(m_current_slice) d_idx = 0u; d_idx < m_current_slice; ++d_idx) {
+                            frame[prev][d_idx] = frame[next][d_idx];
+                        }
+                    }
+                    ++prev;
+                }
+                ++next;
+            }
+            // Append 's' at the end, if prev==next it's not necessary as it's already there.
+            if (prev < next) {
+                for (decltype(m_current_slice) d_idx = 0u; d_idx < m_current_slice; ++d_idx) {
+                    frame[prev][d_idx] = s[d_idx];
+                }
+            }
+            no_points = prev + 1u;
+        }
+    }
+
+    m_frames_size[rec_level] = no_points;
+}
+
+PAGMO_DECL double hvwfg::exclusive_hv(unsigned int p_idx, unsigned int rec_level) const
+{
+    // double H = hv_algorithm::volume_between(points[p_idx], m_refpoint, m_current_slice);
+    double H = hv_algorithm::volume_between(m_frames[rec_level - 1][p_idx], m_refpoint, m_current_slice);
+
+    if (m_frames_size[rec_level] == 1) {
+        H -= hv_algorithm::volume_between(m_frames[rec_level][0], m_refpoint, m_current_slice);
+    } else if (m_frames_size[rec_level] > 1) {
+        H -= compute_hv(rec_level + 1);
+    }
+
+    return H;
+}
+
+PAGMO_DECL bool hvwfg::cmp_points(double *a, double *b) const
+{
+    for (auto i = m_current_slice; i > 0u; --i) {
+        if (a[i - 1] > b[i - 1]) {
+            return true;
+        } else if (a[i - 1] < b[i - 1]) {
+            return false;
+        }
+    }
+    return false;
+}
+
+PAGMO_DECL void hvwfg::allocate_wfg_members(const hv_points_view &points, const vector_double &r_point) const
+{
+    m_max_points = points.size();
+    m_max_dim = r_point.size();
+
+    m_refpoint = new double[m_max_dim];
+    for (decltype(m_max_dim) d_idx = 0u; d_idx < m_max_dim; ++d_idx) {
+        m_refpoint[d_idx] = r_point[d_idx];
+    }
+
+    // Reserve the space beforehand for each level or recursion.
+    // WFG with slicing feature will not go recursively deeper than the dimension size.
+    m_frames = new double **[m_max_dim];
+    m_frames_size = new vector_double::size_type[m_max_dim];
+
+    // Copy the initial set into the frame at index 0.
+    double **fr = new double *[m_max_points];
+    for (decltype(m_max_points) p_idx = 0; p_idx < m_max_points; ++p_idx) {
+        fr[p_idx] = new double[m_max_dim];
+        for (decltype(m_max_dim) d_idx = 0u; d_idx < m_max_dim; ++d_idx) {
+            fr[p_idx][d_idx] = points[p_idx][d_idx];
+        }
+    }
+    m_frames[0] = fr;
+    m_frames_size[0] = m_max_points;
+    m_n_frames = 1u;
+
+    // Variable holding the current "depth" of dimension slicing. We progress by slicing dimensions from the end.
+    m_current_slice = m_max_dim;
+}
+
+PAGMO_DECL void hvwfg::free_wfg_members() const
+{
+    // Free the memory.
+    delete[] m_refpoint;
+
+    for (decltype(m_n_frames) fr_idx = 0u; fr_idx < m_n_frames; ++fr_idx) {
+        for (decltype(m_max_points) p_idx = 0u; p_idx < m_max_points; ++p_idx) {
+            delete[] m_frames[fr_idx][p_idx];
+        }
+        delete[] m_frames[fr_idx];
+    }
+    delete[] m_frames;
+    delete[] m_frames_size;
+}
+
+PAGMO_DECL double hvwfg::compute_hv(unsigned int rec_level) const
+{
+    double **points = m_frames[rec_level - 1];
+    auto n_points = m_frames_size[rec_level - 1];
+
+    // Simple inclusion-exclusion for one and two points
+    if (n_points == 1u) {
+        return hv_algorithm::volume_between(points[0], m_refpoint, m_current_slice);
+    } else if (n_points == 2u) {
+        double hv = hv_algorithm::volume_between(points[0], m_refpoint, m_current_slice)
+                    + hv_algorithm::volume_between(points[1], m_refpoint, m_current_slice);
+        double isect = 1.0;
+        for (decltype(m_current_slice) i = 0u; i < m_current_slice; ++i) {
+            isect *= (m_refpoint[i] - std::max(points[0][i], points[1][i]));
+        }
+        return hv - isect;
+    }
+
+    // If already sliced to dimension at which we use another algorithm.
+    if (m_current_slice == m_stop_dimension) {
+
+        if (m_stop_dimension == 2u) {
+            // Use a very efficient version of hv2d
+            return hv2d().compute(points, n_points, m_refpoint);
+        } else {
+            // Let hypervolume object pick the best method otherwise.
+            std::vector<vector_double> points_cpy;
+            points_cpy.reserve(n_points);
+            for (decltype(n_points) i = 0u; i < n_points; ++i) {
+                points_cpy.push_back(vector_double(points[i], points[i] + m_current_slice));
+            }
+            vector_double r_cpy(m_refpoint, m_refpoint + m_current_slice);
+
+            hypervolume hv = hypervolume(points_cpy, false);
+            hv.set_copy_points(false);
+            return hv.compute(r_cpy);
+        }
+    } else {
+        // Otherwise, sort the points in preparation for the next recursive step
+        // Bind the object under "this" pointer to the cmp_points method so it can be used as a valid comparator
+        // function for std::sort
+        // We need that in order for the cmp_points to have acces to the m_current_slice member variable.
+        std::sort(points, points + n_points, [this](double *a, double *b) { return this->cmp_points(a, b); });
+    }
+
+    double H = 0.0;
+    --m_current_slice;
+
+    if (rec_level >= m_n_frames) {
+        double **fr = new double *[m_max_points];
+        for (decltype(m_max_points) i = 0u; i < m_max_points; ++i) {
+            fr[i] = new double[m_current_slice];
+        }
+        m_frames[m_n_frames] = fr;
+        m_frames_size[m_n_frames] = 0u;
+        ++m_n_frames;
+    }
+
+    for (unsigned int p_idx = 0u; p_idx < n_points; ++p_idx) {
+        limitset(p_idx + 1u, p_idx, rec_level);
+
+        H += std::abs((points[p_idx][m_current_slice] - m_refpoint[m_current_slice])
+                      * exclusive_hv(p_idx, rec_level));
+    }
+    ++m_current_slice;
+    return H;
+}
+}
+
+#endif
+
 #endif
@@ -0,0 +1,454 @@
+/*****************************************************************************
+*   Copyright (C) 2004-2015 The PaGMO development team,                     *
+*   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+*                                                                           *
+*   https://github.com/esa/pagmo                                            *
+*                                                                           *
+*   act@esa.int                                                             *
+*                                                                           *
+*   This program is free software; you can redistribute it and/or modify    *
+*   it under the terms of the GNU General Public License as published by    *
+*   the Free Software Foundation; either version 2 of the License, or       *
+*   (at your option) any later version.                                     *
+*                                                                           *
+*   This program is distributed in the hope that it will be useful,         *
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+*   GNU General Public License for more details.                            *
+*                                                                           *
+*   You should have received a copy of the GNU General Public License       *
+*   along with this program; if not, write to the                           *
+*   Free Software Foundation, Inc.,                                         *
+*   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+*****************************************************************************/
+
+#ifndef PAGMO_UTIL_HV_SELECTOR_H
+#define PAGMO_UTIL_HV_SELECTOR_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../exceptions.hpp"
+#include "../../rng.hpp"
+#include "../../types.hpp"
+#include "../hypervolume.hpp"
+#include "hv_algorithm.hpp"
+#include "hv_hv2d.hpp"
+#include "hv_hv3d.hpp"
+#include "hv_hvbd.hpp"
+#include "hv_hvwfg.hpp"
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// Rules used by hv_selector: for each (query, dimension) pair, a map from the minimum
+// number of points to the name of the algorithm to be used from that size onwards.
+using hv_selector_rules
+    = std::map<std::pair<int, vector_double::size_type>, std::map<vector_double::size_type, std::string>>;
+
+template <typename = void>
+struct hv_selector_statics {
+    /// Selection rules
+    /**
+     * The rules are never modified once published: they are replaced by a new set via std::atomic_store(), so that
+     * they can be read without locking.
+     */
+    static std::shared_ptr<const hv_selector_rules> m_rules;
+    /// Mutex serialising the modifications of the selection rules
+    static std::mutex m_mutex;
+};
+
+template <typename T>
+std::shared_ptr<const hv_selector_rules> hv_selector_statics<T>::m_rules;
+
+template <typename T>
+std::mutex hv_selector_statics<T>::m_mutex;
+
+} // end namespace detail
+
+/// Automatic selection of the hypervolume algorithm
+/**
+ * This class implements the logic behind hypervolume::get_best_compute(), hypervolume::get_best_exclusive() and
+ * hypervolume::get_best_contributions(), that is, the choice of the exact hv_algorithm used by the hypervolume
+ * methods which do not take an algorithm as argument.
+ *
+ * The choice is made according to a set of global rules, keyed on the type of query (hv_selector::query), on the
+ * dimension of the points and on the number of points. In the absence of rules for a given query and dimension
+ * the following defaults are used: pagmo::hv2d in 2 dimensions, pagmo::hv3d in 3 dimensions and pagmo::hvwfg
+ * otherwise. The rules can be:
+ * - set explicitly by the user via hv_selector::set_rule(),
+ * - obtained by a benchmark on the target machine via hv_selector::calibrate(), which times all the exact algorithms
+ *   supporting a given dimension on random fronts of increasing size and records the fastest one for each size.
+ *
+ * The algorithms are identified by the names ``"hv2d"``, ``"hv3d"``, ``"hvwfg"`` and ``"hvbd"``. The instances
+ * returned by hv_selector::get_algorithm() are cached per thread, so that no allocation takes place when the
+ * hypervolume is repeatedly computed. A cached instance is handed out again only once all the references returned
+ * before have been released, so that the state of an algorithm is never shared by two computations.
+ *
+ * All the static methods of this class are thread-safe. The selection does not lock: the rules are published as
+ * immutable snapshots, which are replaced as a whole whenever they are modified.
+ */
+class hv_selector : public detail::hv_selector_statics<>
+{
+public:
+    /// Type of hypervolume query
+    enum class query {
+        /// Computation of the hypervolume and of single exclusive contributions
+        compute,
+        /// Computation of all the exclusive contributions (and of the least/greatest contributors)
+        contributions
+    };
+    /// Size type
+    using size_type = vector_double::size_type;
+
+    /// Names of the available exact algorithms
+    /**
+     * @return the names of the exact algorithms known to the selector
+     */
+    static std::vector<std::string> get_algorithm_names()
+    {
+        return {"hv2d", "hv3d", "hvwfg", "hvbd"};
+    }
+
+    /// Check if an algorithm supports a given dimension
+    /**
+     * @param name name of the algorithm
+     * @param dim dimension of the points
+     *
+     * @return true if the algorithm \p name can handle points of dimension \p dim
+     *
+     * @throws std::invalid_argument if \p name is not the name of a known algorithm
+     */
+    static bool supports(const std::string &name, size_type dim)
+    {
+        if (name == "hv2d") {
+            return dim == 2u;
+        }
+        if (name == "hv3d") {
+            return dim == 3u;
+        }
+        if (name == "hvwfg" || name == "hvbd") {
+            return dim >= 2u;
+        }
+        pagmo_throw(std::invalid_argument, "Unknown hypervolume algorithm '" + name + "'");
+    }
+
+    /// Get an algorithm instance
+    /**
+     * The instance cached for \p name in the calling thread is returned, unless a reference to it returned by a
+     * previous call is still alive (e.g., in a nested computation): in that case, a new instance is created and
+     * cached in its place.
+     *
+     * @param name name of the algorithm
+     *
+     * @return an instance of the algorithm
+     *
+     * @throws std::invalid_argument if \p name is not the name of a known algorithm
+     */
+    static std::shared_ptr<hv_algorithm> get_algorithm(const std::string &name)
+    {
+        static thread_local std::map<std::string, std::shared_ptr<hv_algorithm>> cache;
+        const auto it = cache.find(name);
+        if (it != cache.end() && it->second.use_count() == 1) {
+            return it->second;
+        }
+        auto retval = make_algorithm(name);
+        cache[name] = retval;
+        return retval;
+    }
+
+    /// Select the algorithm name
+    /**
+     * @param q type of query
+     * @param dim dimension of the points
+     * @param n_points number of points
+     *
+     * @return the name of the algorithm to be used for the given query
+     */
+    static std::string select(query q, size_type dim, size_type n_points)
+    {
+        const auto rules = std::atomic_load(&m_rules);
+        if (rules) {
+            const auto it = rules->find(key(q, dim));
+            if (it != rules->end()) {
+                auto r_it = it->second.upper_bound(n_points);
+                if (r_it != it->second.begin()) {
+                    return std::prev(r_it)->second;
+                }
+            }
+        }
+        return default_name(dim);
+    }
+
+    /// Set a selection rule
+    /**
+     * After this call, the algorithm \p name will be used for queries of type \p q on points of dimension \p dim
+     * whenever the number of points is at least \p min_points (and until a rule with a larger \p min_points
+     * applies).
+     *
+     * @param q type of query
+     * @param dim dimension of the points
+     * @param min_points minimum number of points from which the rule applies
+     * @param name name of the algorithm
+     *
+     * @throws std::invalid_argument if \p name is unknown or it does not support the dimension \p dim
+     */
+    static void set_rule(query q, size_type dim, size_type min_points, const std::string &name)
+    {
+        if (!supports(name, dim)) {
+            pagmo_throw(std::invalid_argument, "The hypervolume algorithm '" + name
+                                                   + "' does not support points of dimension "
+                                                   + std::to_string(dim));
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto rules = copy_rules();
+        (*rules)[key(q, dim)][min_points] = name;
+        std::atomic_store(&m_rules, std::shared_ptr<const detail::hv_selector_rules>(std::move(rules)));
+    }
+
+    /// Set a selection rule for any number of points
+    /**
+     * Replaces all the existing rules for the query \p q and the dimension \p dim with a single rule selecting
+     * \p name regardless of the number of points.
+     *
+     * @param q type of query
+     * @param dim dimension of the points
+     * @param name name of the algorithm
+     *
+     * @throws std::invalid_argument if \p name is unknown or it does not support the dimension \p dim
+     */
+    static void set_rule(query q, size_type dim, const std::string &name)
+    {
+        if (!supports(name, dim)) {
+            pagmo_throw(std::invalid_argument, "The hypervolume algorithm '" + name
+                                                   + "' does not support points of dimension "
+                                                   + std::to_string(dim));
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto rules = copy_rules();
+        (*rules)[key(q, dim)] = {{0u, name}};
+        std::atomic_store(&m_rules, std::shared_ptr<const detail::hv_selector_rules>(std::move(rules)));
+    }
+
+    /// Reset the selection rules
+    /**
+     * Removes all the rules, restoring the default selection.
+     */
+    static void reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::atomic_store(&m_rules, std::shared_ptr<const detail::hv_selector_rules>());
+    }
+
+    /// Calibrate the selection rules
+    /**
+     * For each dimension in \p dims supported by more than one exact algorithm and for each type of query,
+     * all the candidate algorithms are timed on random non-dominated fronts with the number of points
+     * given in \p sizes. The fastest algorithm for a size becomes the selection from that size onwards.
+     * The existing rules for the calibrated dimensions are replaced.
+     *
+     * @param sizes number of points of the benchmark fronts
+     * @param n_repeats number of repetitions of each timing (the best one is kept)
+     * @param dims dimensions to be calibrated
+     * @param seed seed used to generate the benchmark fronts
+     *
+     * @throws std::invalid_argument if \p sizes is empty, \p n_repeats is zero or any of \p sizes is zero
+     */
+    static void calibrate(const std::vector<size_type> &sizes = {4u, 16u, 64u}, unsigned n_repeats = 3u,
+                          const std::vector<size_type> &dims = {2u, 3u, 4u, 5u, 6u},
+                          unsigned seed = pagmo::random_device::next())
+    {
+        if (sizes.empty() || n_repeats == 0u) {
+            pagmo_throw(std::invalid_argument, "The calibration of the hypervolume algorithm selection requires at "
+                                               "least one front size and one repetition");
+        }
+        if (std::find(sizes.begin(), sizes.end(), size_type(0u)) != sizes.end()) {
+            pagmo_throw(std::invalid_argument, "The sizes of the calibration fronts must be positive");
+        }
+        auto sorted_sizes = sizes;
+        std::sort(sorted_sizes.begin(), sorted_sizes.end());
+        sorted_sizes.erase(std::unique(sorted_sizes.begin(), sorted_sizes.end()), sorted_sizes.end());
+
+        detail::random_engine_type r_engine(seed);
+        detail::hv_selector_rules new_rules;
+        for (auto dim : dims) {
+            std::vector<std::string> candidates;
+            for (const auto &name : get_algorithm_names()) {
+                if (dim >= 2u && supports(name, dim)) {
+                    candidates.push_back(name);
+                }
+            }
+            if (candidates.size() < 2u) {
+                continue;
+            }
+            for (auto q : {query::compute, query::contributions}) {
+                auto &rule = new_rules[key(q, dim)];
+                for (auto n : sorted_sizes) {
+                    const auto front = random_front(dim, n, r_engine);
+                    const vector_double r_point(dim, 1.1);
+                    std::string best;
+                    double best_time = std::numeric_limits<double>::infinity();
+                    for (const auto &name : candidates) {
+                        const auto t = time_query(q, front, r_point, *get_algorithm(name), n_repeats);
+                        if (t < best_time) {
+                            best_time = t;
+                            best = name;
+                        }
+                    }
+                    // Record a new rule only when the selection changes.
+                    if (rule.empty() || std::prev(rule.end())->second != best) {
+                        rule[rule.empty() ? size_type(0u) : n] = best;
+                    }
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto rules = copy_rules();
+        for (auto &r : new_rules) {
+            (*rules)[r.first] = std::move(r.second);
+        }
+        std::atomic_store(&m_rules, std::shared_ptr<const detail::hv_selector_rules>(std::move(rules)));
+    }
+
+private:
+    static std::pair<int, size_type> key(query q, size_type dim)
+    {
+        return std::make_pair(static_cast<int>(q), dim);
+    }
+    static std::string default_name(size_type dim)
+    {
+        if (dim == 2u) {
+            return "hv2d";
+        } else if (dim == 3u) {
+            return "hv3d";
+        } else {
+            return "hvwfg";
+        }
+    }
+    static std::shared_ptr<hv_algorithm> make_algorithm(const std::string &name)
+    {
+        if (name == "hv2d") {
+            return hv2d().clone();
+        }
+        if (name == "hv3d") {
+            return hv3d().clone();
+        }
+        if (name == "hvwfg") {
+            return hvwfg().clone();
+        }
+        if (name == "hvbd") {
+            return hvbd().clone();
+        }
+        pagmo_throw(std::invalid_argument, "Unknown hypervolume algorithm '" + name + "'");
+    }
+    // Modifiable copy of the current rules. Must be called with m_mutex held.
+    static std::unique_ptr<detail::hv_selector_rules> copy_rules()
+    {
+        const auto rules = std::atomic_load(&m_rules);
+        return std::unique_ptr<detail::hv_selector_rules>(rules ? new detail::hv_selector_rules(*rules)
+                                                                : new detail::hv_selector_rules);
+    }
+    // Random points on the positive orthant of the unit sphere: no point dominates another.
+    static std::vector<vector_double> random_front(size_type dim, size_type n, detail::random_engine_type &r_engine)
+    {
+        std::uniform_real_distribution<double> drng(0.05, 1.);
+        std::vector<vector_double> retval(n, vector_double(dim));
+        for (auto &p : retval) {
+            double norm = 0.;
+            for (auto &x : p) {
+                x = drng(r_engine);
+                norm += x * x;
+            }
+            norm = std::sqrt(norm);
+            for (auto &x : p) {
+                x /= norm;
+            }
+        }
+        return retval;
+    }
+    static double time_query(query q, const std::vector<vector_double> &front, const vector_double &r_point,
+                             hv_algorithm &algo, unsigned n_repeats)
+    {
+        hypervolume hv(front, false);
+        double best = std::numeric_limits<double>::infinity();
+        // Prevents the benchmarked calls from being optimised away.
+        volatile double sink = 0.;
+        for (decltype(n_repeats) i = 0u; i < n_repeats; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            if (q == query::compute) {
+                sink = sink + hv.compute(r_point, algo);
+            } else {
+                sink = sink + hv.contributions(r_point, algo)[0];
+            }
+            const auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double>(stop - start).count());
+        }
+        return best;
+    }
+};
+
+/// Chooses the best algorithm to compute the hypervolume
+/**
+* Returns the best method for given hypervolume computation problem, as established
+* by hv_selector for the dimension and the number of points.
+*
+* @param r_point reference point for the vector of points
+*
+* @return an std::shared_ptr to the selected algorithm
+*/
+inline std::shared_ptr<hv_algorithm> hypervolume::get_best_compute(const vector_double &r_point) const
+{
+    return hv_selector::get_algorithm(
+        hv_selector::select(hv_selector::query::compute, r_point.size(), m_points.size()));
+}
+
+/// Chooses the best algorithm to compute the hypervolume
+/**
+* Returns the best method for given hypervolume computation problem, as established
+* by hv_selector for the dimension and the number of points.
+*
+* @param p_idx index of the point for which the exclusive contribution is to be computed
+* @param r_point reference point for the vector of points
+*
+* @return an std::shared_ptr to the selected algorithm
+*/
+inline std::shared_ptr<hv_algorithm> hypervolume::get_best_exclusive(const unsigned int p_idx,
+                                                                     const vector_double &r_point) const
+{
+    (void)p_idx;
+    // Exclusive contribution and compute method share the same "best" set of algorithms.
+    return hypervolume::get_best_compute(r_point);
+}
+
+/// Chooses the best algorithm to compute the hypervolume
+/**
+* Returns the best method for given hypervolume computation problem, as established
+* by hv_selector for the dimension and the number of points.
+*
+* @param r_point reference point for the vector of points
+*
+* @return an std::shared_ptr to the selected algorithm
+*/
+inline std::shared_ptr<hv_algorithm> hypervolume::get_best_contributions(const vector_double &r_point) const
+{
+    return hv_selector::get_algorithm(
+        hv_selector::select(hv_selector::query::contributions, r_point.size(), m_points.size()));
+}
+}
+
+#endif
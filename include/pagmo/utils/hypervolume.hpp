@@ -29,6 +29,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <typeinfo>
 #include <vector>
 
 #include "../exceptions.hpp"
@@ -58,6 +59,10 @@ namespace pagmo
  * the requested quantity. A pagmo::hv_algorithm can also be passed as optional argument, in which case
  * it will be used to perform the computations.
  *
+ * Each of the methods taking a pagmo::hv_algorithm also has an overload taking a pagmo::hv_workspace, which avoids
+ * copying the points and caches data (orderings of the points, buffers, verification results) between repeated
+ * queries on the same object.
+ *
  */
 class hypervolume
 {
@@ -67,7 +72,7 @@ public:
     * Initiates hypervolume with empty set of points.
     * Used for serialization purposes.
     */
-    hypervolume() : m_points(), m_copy_points(true), m_verify(false)
+    hypervolume() : m_points(), m_copy_points(true), m_verify(false), m_generation(detail::hv_new_generation())
     {
     }
 
@@ -88,7 +93,8 @@ public:
     *
     * @throw std::invalid_argument if the population contains a problem that is constrained or single-objective
     */
-    hypervolume(const pagmo::population &pop, bool verify = false) : m_copy_points(true), m_verify(verify)
+    hypervolume(const pagmo::population &pop, bool verify = false)
+        : m_copy_points(true), m_verify(verify), m_generation(detail::hv_new_generation())
     {
         if (pop.get_problem().get_nc() > 0u) {
             pagmo_throw(std::invalid_argument,
@@ -122,31 +128,47 @@ public:
     * @endcode
     */
     hypervolume(const std::vector<vector_double> &points, bool verify = true)
-        : m_points(points), m_copy_points(true), m_verify(verify)
+        : m_points(points), m_copy_points(true), m_verify(verify), m_generation(detail::hv_new_generation())
     {
         if (m_verify) {
             verify_after_construct();
         }
     }
 
-    /// Default copy constructor.
+    /// Copy constructor.
     /**
-     * The copy constructor will deep copy the input problem \p other.
+     * The copy constructor will deep copy the input problem \p other. The copy gets a new generation number, so
+     * that the workspaces bound to \p other are not reused for it.
      *
      * @param other the hypervolume object to be copied.
      *
      * @throws unspecified any exception thrown by:
      * - memory allocation errors in standard containers,
      */
-    hypervolume(const hypervolume &other) = default;
+    hypervolume(const hypervolume &other)
+        : m_points(other.m_points), m_copy_points(other.m_copy_points), m_verify(other.m_verify),
+          m_generation(detail::hv_new_generation())
+    {
+    }
 
-    /// Default copy assignment operator
+    /// Copy assignment operator
     /**
+     * The data cached in the workspaces bound to \p this is discarded on their next use.
+     *
      * @param other the assignment target.
      *
      * @return a reference to \p this.
      */
-    hypervolume &operator=(const hypervolume &other) = default;
+    hypervolume &operator=(const hypervolume &other)
+    {
+        if (this != &other) {
+            m_points = other.m_points;
+            m_copy_points = other.m_copy_points;
+            m_verify = other.m_verify;
+            m_generation = detail::hv_new_generation();
+        }
+        return *this;
+    }
 
     /// Setter for 'copy_points' flag
     /**
@@ -254,8 +276,8 @@ public:
         return m_points;
     }
 
-    // Choose the best algorithm to compute the hypervolume the actual implementation is given
-    // in another headers as to not create a circular dependency problem
+    // Choose the best algorithm to compute the hypervolume. The actual implementation is given in
+    // hv_algos/hv_selector.hpp, which is included at the end of this header.
     std::shared_ptr<hv_algorithm> get_best_compute(const vector_double &r_point) const;
     std::shared_ptr<hv_algorithm> get_best_exclusive(const unsigned int p_idx, const vector_double &r_point) const;
     std::shared_ptr<hv_algorithm> get_best_contributions(const vector_double &r_point) const;
@@ -285,16 +307,45 @@ public:
     */
     double compute(const vector_double &r_point, hv_algorithm &hv_algo) const
     {
+        // the view-based methods do not alter the points, or work on a copy of them
+        if (m_copy_points) {
+            hv_workspace ws;
+            return compute(r_point, hv_algo, ws);
+        }
         if (m_verify) {
             verify_before_compute(r_point, hv_algo);
         }
-        // copy the initial set of points, as the algorithm may alter its contents
-        if (m_copy_points) {
-            std::vector<vector_double> points_cpy(m_points.begin(), m_points.end());
-            return hv_algo.compute(points_cpy, r_point);
-        } else {
-            return hv_algo.compute(m_points, r_point);
-        }
+        return hv_algo.compute(mutable_points(), r_point);
+    }
+
+    /// Compute hypervolume reusing a workspace
+    /**
+    * Computes hypervolume for given reference point, using given pagmo::hv_algorithm object and the workspace \p ws.
+    * The points are accessed through a read-only pagmo::hv_points_view, so that they are never copied by the
+    * algorithms able to work on views (e.g., pagmo::hv2d, pagmo::hv3d, pagmo::hvwfg) and never altered, whatever the
+    * value of the copy_points flag. The data cached in \p ws (orderings of the points, buffers, verification of the
+    * reference point) is reused in subsequent queries on this object.
+    *
+    * Example:
+    * @code
+    * hypervolume hv(pop);
+    * hv_workspace ws;
+    * hv3d algo;
+    * for (auto r : ref_points) {
+    *     hv.compute(r, algo, ws); // the points are sorted only once
+    * }
+    * @endcode
+    *
+    * @param r_point fitness vector describing the reference point
+    * @param hv_algo instance of the algorithm object used for the computation
+    * @param ws workspace, bound to the points of this object
+    *
+    * @return the hypervolume
+    */
+    double compute(const vector_double &r_point, hv_algorithm &hv_algo, hv_workspace &ws) const
+    {
+        verify_before_compute(r_point, hv_algo, ws);
+        return hv_algo.compute_view(hv_points_view(m_points), r_point, ws);
     }
 
     /// Compute exclusive contribution
@@ -309,6 +360,10 @@ public:
     */
     double exclusive(unsigned int p_idx, const vector_double &r_point, hv_algorithm &hv_algo) const
     {
+        if (m_copy_points) {
+            hv_workspace ws;
+            return exclusive(p_idx, r_point, hv_algo, ws);
+        }
         if (m_verify) {
             verify_before_compute(r_point, hv_algo);
         }
@@ -316,14 +371,28 @@ public:
         if (p_idx >= m_points.size()) {
             pagmo_throw(std::invalid_argument, "Index of the individual is out of bounds.");
         }
+        return hv_algo.exclusive(p_idx, mutable_points(), r_point);
+    }
 
-        // copy the initial set of points, as the algorithm may alter its contents
-        if (m_copy_points) {
-            std::vector<vector_double> points_cpy(m_points.begin(), m_points.end());
-            return hv_algo.exclusive(p_idx, points_cpy, r_point);
-        } else {
-            return hv_algo.exclusive(p_idx, m_points, r_point);
+    /// Compute exclusive contribution reusing a workspace
+    /**
+    * Computes exclusive hypervolume for given indivdual, without copying nor altering the points (see
+    * hypervolume::compute(const vector_double &, hv_algorithm &, hv_workspace &) const).
+    *
+    * @param p_idx index of the individual for whom we compute the exclusive contribution to the hypervolume
+    * @param r_point fitness vector describing the reference point
+    * @param hv_algo instance of the algorithm object used for the computation
+    * @param ws workspace, bound to the points of this object
+    *
+    * @return the exclusive contribution to the hypervolume
+    */
+    double exclusive(unsigned int p_idx, const vector_double &r_point, hv_algorithm &hv_algo, hv_workspace &ws) const
+    {
+        verify_before_compute(r_point, hv_algo, ws);
+        if (p_idx >= m_points.size()) {
+            pagmo_throw(std::invalid_argument, "Index of the individual is out of bounds.");
         }
+        return hv_algo.exclusive_view(p_idx, hv_points_view(m_points), r_point, ws);
     }
 
     /// Compute exclusive contribution
@@ -354,6 +423,10 @@ public:
     */
     std::vector<double> contributions(const vector_double &r_point, hv_algorithm &hv_algo) const
     {
+        if (m_copy_points) {
+            hv_workspace ws;
+            return contributions(r_point, hv_algo, ws);
+        }
         if (m_verify) {
             verify_before_compute(r_point, hv_algo);
         }
@@ -364,14 +437,31 @@ public:
             c.push_back(hv_algorithm::volume_between(m_points[0], r_point));
             return c;
         }
+        return hv_algo.contributions(mutable_points(), r_point);
+    }
 
-        // copy the initial set of points, as the algorithm may alter its contents
-        if (m_copy_points) {
-            std::vector<vector_double> points_cpy(m_points.begin(), m_points.end());
-            return hv_algo.contributions(points_cpy, r_point);
-        } else {
-            return hv_algo.contributions(m_points, r_point);
+    /// Contributions method reusing a workspace
+    /**
+    * This method returns the exclusive contribution to the hypervolume by every point, without copying nor altering
+    * the points (see hypervolume::compute(const vector_double &, hv_algorithm &, hv_workspace &) const).
+    *
+    * @param r_point fitness vector describing the reference point
+    * @param hv_algo instance of the algorithm object used for the computation
+    * @param ws workspace, bound to the points of this object
+    *
+    * @return vector of exclusive contributions by every point
+    */
+    std::vector<double> contributions(const vector_double &r_point, hv_algorithm &hv_algo, hv_workspace &ws) const
+    {
+        verify_before_compute(r_point, hv_algo, ws);
+
+        // Trivial case
+        if (m_points.size() == 1u) {
+            std::vector<double> c;
+            c.push_back(hv_algorithm::volume_between(m_points[0], r_point));
+            return c;
         }
+        return hv_algo.contributions_view(hv_points_view(m_points), r_point, ws);
     }
 
     /// Contributions method
@@ -400,6 +490,10 @@ public:
     */
     unsigned long long least_contributor(const vector_double &r_point, hv_algorithm &hv_algo) const
     {
+        if (m_copy_points) {
+            hv_workspace ws;
+            return least_contributor(r_point, hv_algo, ws);
+        }
         if (m_verify) {
             verify_before_compute(r_point, hv_algo);
         }
@@ -408,14 +502,29 @@ public:
         if (m_points.size() == 1) {
             return 0u;
         }
+        return hv_algo.least_contributor(mutable_points(), r_point);
+    }
 
-        // copy the initial set of points, as the algorithm may alter its contents
-        if (m_copy_points) {
-            std::vector<vector_double> points_cpy(m_points.begin(), m_points.end());
-            return hv_algo.least_contributor(points_cpy, r_point);
-        } else {
-            return hv_algo.least_contributor(m_points, r_point);
+    /// Find the least contributing individual reusing a workspace
+    /**
+    * Establishes the individual contributing the least to the total hypervolume, without copying nor altering
+    * the points (see hypervolume::compute(const vector_double &, hv_algorithm &, hv_workspace &) const).
+    *
+    * @param r_point fitness vector describing the reference point
+    * @param hv_algo instance of the algorithm object used for the computation
+    * @param ws workspace, bound to the points of this object
+    *
+    * @return index of the least contributing point
+    */
+    unsigned long long least_contributor(const vector_double &r_point, hv_algorithm &hv_algo, hv_workspace &ws) const
+    {
+        verify_before_compute(r_point, hv_algo, ws);
+
+        // Trivial case
+        if (m_points.size() == 1) {
+            return 0u;
         }
+        return hv_algo.least_contributor_view(hv_points_view(m_points), r_point, ws);
     }
 
     /// Find the least contributing individual
@@ -443,17 +552,32 @@ public:
     */
     unsigned long long greatest_contributor(const vector_double &r_point, hv_algorithm &hv_algo) const
     {
+        if (m_copy_points) {
+            hv_workspace ws;
+            return greatest_contributor(r_point, hv_algo, ws);
+        }
         if (m_verify) {
             verify_before_compute(r_point, hv_algo);
         }
+        return hv_algo.greatest_contributor(mutable_points(), r_point);
+    }
 
-        // copy the initial set of points, as the algorithm may alter its contents
-        if (m_copy_points) {
-            std::vector<vector_double> points_cpy(m_points.begin(), m_points.end());
-            return hv_algo.greatest_contributor(points_cpy, r_point);
-        } else {
-            return hv_algo.greatest_contributor(m_points, r_point);
-        }
+    /// Find the most contributing individual reusing a workspace
+    /**
+    * Establish the individual contributing the most to the total hypervolume, without copying nor altering
+    * the points (see hypervolume::compute(const vector_double &, hv_algorithm &, hv_workspace &) const).
+    *
+    * @param r_point fitness vector describing the reference point
+    * @param hv_algo instance of the algorithm object used for the computation
+    * @param ws workspace, bound to the points of this object
+    *
+    * @return index of the most contributing point
+    */
+    unsigned long long greatest_contributor(const vector_double &r_point, hv_algorithm &hv_algo,
+                                            hv_workspace &ws) const
+    {
+        verify_before_compute(r_point, hv_algo, ws);
+        return hv_algo.greatest_contributor_view(hv_points_view(m_points), r_point, ws);
     }
 
     /// Find the most contributing individual
@@ -482,12 +606,23 @@ public:
     void serialize(Archive &ar)
     {
         ar(m_points, m_copy_points, m_verify);
+        m_generation = detail::hv_new_generation();
     }
 
 private:
     mutable std::vector<vector_double> m_points;
     bool m_copy_points;
     bool m_verify;
+    // Generation number of m_points, used to invalidate the data cached in the workspaces.
+    mutable unsigned long long m_generation;
+
+    // The legacy methods of the algorithms may reorder the points: a new generation is started before handing
+    // them out.
+    std::vector<vector_double> &mutable_points() const
+    {
+        m_generation = detail::hv_new_generation();
+        return m_points;
+    }
 
     /// Verify after construct method
     /**
@@ -527,6 +662,17 @@ private:
         }
         hv_algo.verify_before_compute(m_points, r_point);
     }
+
+    // Binds the workspace and verifies the points through it. The verification is skipped if already done for the
+    // same reference point and type of algorithm.
+    void verify_before_compute(const vector_double &r_point, hv_algorithm &hv_algo, hv_workspace &ws) const
+    {
+        ws.bind(m_points, m_generation);
+        if (m_verify && !ws.is_verified(m_points, r_point, typeid(hv_algo))) {
+            verify_before_compute(r_point, hv_algo);
+            ws.set_verified(m_points, r_point, typeid(hv_algo));
+        }
+    }
 };
 
 namespace detail
@@ -542,7 +688,7 @@ namespace detail
 *
 * @return expected number of operations
 */
-double expected_hv_operations(vector_double::size_type n, vector_double::size_type d)
+inline double expected_hv_operations(vector_double::size_type n, vector_double::size_type d)
 {
     if (d <= 3u) {
         return static_cast<double>(d) * static_cast<double>(n) * std::log(n); // hv3d
@@ -556,4 +702,8 @@ double expected_hv_operations(vector_double::size_type n, vector_double::size_ty
 } // end namespace detail
 } // end namespace pagmo
 
+// The definitions of hypervolume::get_best_*() need all the exact algorithms, whose headers include this one: they
+// are included last, once the hypervolume class is complete.
+#include "hv_algos/hv_selector.hpp"
+
 #endif
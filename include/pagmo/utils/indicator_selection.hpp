@@ -0,0 +1,644 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_INDICATOR_SELECTION_HPP
+#define PAGMO_INDICATOR_SELECTION_HPP
+
+/** \file indicator_selection.hpp
+ * \brief Indicator-based environmental selection.
+ *
+ * This header contains utilities that reduce a set of objective vectors to its best N elements
+ * according to a quality indicator (hypervolume, IGD+ or R2), by greedily discarding the
+ * element whose removal deteriorates the indicator the least.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../exceptions.hpp"
+#include "../types.hpp"
+#include "hv_algos/hv_hv2d.hpp"
+#include "hv_algos/hv_hv3d.hpp"
+#include "hypervolume.hpp"
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// Common checks and corner cases of the select_best_N_* functions. Returns true if the selection is
+// trivial, in which case retval contains all the indices.
+inline bool select_best_N_trivial(const std::vector<vector_double> &input_f, vector_double::size_type N,
+                                  std::vector<vector_double::size_type> &retval)
+{
+    if (N < 1u) {
+        pagmo_throw(std::invalid_argument,
+                    "The best: " + std::to_string(N) + " individuals were requested, while 1 is the minimum");
+    }
+    for (const auto &f : input_f) {
+        if (f.size() != input_f[0].size() || f.empty()) {
+            pagmo_throw(std::invalid_argument, "The objective vectors must all have the same, non-zero, size");
+        }
+    }
+    if (N >= input_f.size()) {
+        retval.resize(input_f.size());
+        std::iota(retval.begin(), retval.end(), vector_double::size_type(0u));
+        return true;
+    }
+    return false;
+}
+
+// Indices of the elements of alive that are set, in ascending order.
+inline std::vector<vector_double::size_type> select_best_N_survivors(const std::vector<char> &alive)
+{
+    std::vector<vector_double::size_type> retval;
+    for (decltype(alive.size()) i = 0u; i < alive.size(); ++i) {
+        if (alive[i]) {
+            retval.push_back(i);
+        }
+    }
+    return retval;
+}
+
+// Greedy hypervolume truncation in two dimensions. The non-dominated points form a staircase in which the
+// contribution of a point depends only on its two neighbours, so that it can be updated in constant time
+// after each removal. Dominated points contribute nothing and are removed first.
+inline std::vector<vector_double::size_type> select_best_N_hv2d(const std::vector<vector_double> &input_f,
+                                                                vector_double::size_type N,
+                                                                const vector_double &r_point)
+{
+    using size_type = vector_double::size_type;
+    const auto n = input_f.size();
+    std::vector<size_type> order(n);
+    std::iota(order.begin(), order.end(), size_type(0u));
+    std::sort(order.begin(), order.end(), [&input_f](size_type a, size_type b) {
+        return input_f[a][0] < input_f[b][0] || (input_f[a][0] == input_f[b][0] && input_f[a][1] < input_f[b][1]);
+    });
+    std::vector<char> alive(n, 1);
+    auto to_remove = n - N;
+    // Staircase of the non-dominated points, as a doubly linked list over the sorted positions.
+    std::vector<size_type> stairs;
+    std::vector<size_type> dominated;
+    for (auto idx : order) {
+        if (stairs.empty() || input_f[idx][1] < input_f[stairs.back()][1]) {
+            stairs.push_back(idx);
+        } else {
+            dominated.push_back(idx);
+        }
+    }
+    // Dominated points are discarded starting from the last ones in lexicographic order.
+    for (auto it = dominated.rbegin(); it != dominated.rend() && to_remove > 0u; ++it, --to_remove) {
+        alive[*it] = 0;
+    }
+    if (to_remove == 0u) {
+        return select_best_N_survivors(alive);
+    }
+    const auto n_stairs = stairs.size();
+    const auto none = n_stairs;
+    std::vector<size_type> prev(n_stairs), next(n_stairs);
+    for (size_type i = 0u; i < n_stairs; ++i) {
+        prev[i] = (i == 0u) ? none : i - 1u;
+        next[i] = i + 1u;
+    }
+    auto contribution = [&](size_type i) {
+        const auto &p = input_f[stairs[i]];
+        const double x_next = (next[i] == none) ? r_point[0] : input_f[stairs[next[i]]][0];
+        const double y_prev = (prev[i] == none) ? r_point[1] : input_f[stairs[prev[i]]][1];
+        return (x_next - p[0]) * (y_prev - p[1]);
+    };
+    std::vector<double> c(n_stairs);
+    std::set<std::pair<double, size_type>> queue;
+    for (size_type i = 0u; i < n_stairs; ++i) {
+        c[i] = contribution(i);
+        queue.emplace(c[i], i);
+    }
+    for (; to_remove > 0u; --to_remove) {
+        const auto i = queue.begin()->second;
+        queue.erase(queue.begin());
+        alive[stairs[i]] = 0;
+        const auto p = prev[i], nx = next[i];
+        if (p != none) {
+            next[p] = nx;
+        }
+        if (nx != none) {
+            prev[nx] = p;
+        }
+        for (auto j : {p, nx}) {
+            if (j != none) {
+                queue.erase(std::make_pair(c[j], j));
+                c[j] = contribution(j);
+                queue.emplace(c[j], j);
+            }
+        }
+    }
+    return select_best_N_survivors(alive);
+}
+
+// Greedy hypervolume truncation in three dimensions. The points that contribute nothing whatever the other removals
+// (the dominated points and those lying on the boundary of the reference box) and the duplicated points are removed
+// first, in ascending order of index, a duplicated point contributing again as soon as its last copy is left. They
+// are found in O(n log n) by sweeping the points in lexicographic order of (z, x, y), while keeping the staircase of
+// the non-dominated projections on the xy plane: a point can only be weakly dominated by the points preceding it.
+// The remaining front is then kept sorted along the third axis: each removal erases a point from it and refreshes
+// the contributions of the survivors with a single hv3d sweep, so that each removal costs O(n log n).
+inline std::vector<vector_double::size_type> select_best_N_hv3d(const std::vector<vector_double> &input_f,
+                                                                vector_double::size_type N,
+                                                                const vector_double &r_point)
+{
+    using size_type = vector_double::size_type;
+    const auto n = input_f.size();
+    std::vector<size_type> order(n);
+    std::iota(order.begin(), order.end(), size_type(0u));
+    std::sort(order.begin(), order.end(), [&input_f](size_type a, size_type b) {
+        const auto &pa = input_f[a], &pb = input_f[b];
+        return std::tie(pa[2], pa[0], pa[1]) < std::tie(pb[2], pb[0], pb[1]);
+    });
+    std::vector<char> alive(n, 1);
+    // Indices of the points contributing nothing, and groups of copies of the same non-dominated point, with their
+    // range in order, their position in the front and their number of survivors.
+    std::set<size_type> zero;
+    std::vector<size_type> group(n, n);
+    std::vector<std::pair<size_type, size_type>> group_range;
+    std::vector<size_type> group_front, group_size;
+    // The front, sorted ascending along the third axis, as the sweep meets its points.
+    std::vector<size_type> front;
+    std::set<std::pair<double, double>> stairs;
+    for (auto it = order.begin(); it != order.end();) {
+        const auto &q = input_f[*it];
+        auto last = it + 1;
+        for (; last != order.end() && input_f[*last] == q; ++last) {
+        }
+        auto st = stairs.upper_bound(std::make_pair(q[0], std::numeric_limits<double>::infinity()));
+        if (st == stairs.begin() || std::prev(st)->second > q[1]) {
+            auto first_dom = stairs.lower_bound(std::make_pair(q[0], -std::numeric_limits<double>::infinity()));
+            auto last_dom = first_dom;
+            for (; last_dom != stairs.end() && last_dom->second >= q[1]; ++last_dom) {
+            }
+            stairs.erase(first_dom, last_dom);
+            stairs.emplace(q[0], q[1]);
+            if (q[0] == r_point[0] || q[1] == r_point[1] || q[2] == r_point[2]) {
+                zero.insert(it, last);
+            } else if (last - it > 1) {
+                for (auto g = it; g != last; ++g) {
+                    group[*g] = group_size.size();
+                    zero.insert(*g);
+                }
+                group_range.emplace_back(static_cast<size_type>(it - order.begin()),
+                                         static_cast<size_type>(last - order.begin()));
+                group_front.push_back(front.size());
+                group_size.push_back(static_cast<size_type>(last - it));
+                front.push_back(*it);
+            } else {
+                front.push_back(*it);
+            }
+        } else {
+            zero.insert(it, last);
+        }
+        it = last;
+    }
+    auto to_remove = n - N;
+    for (; to_remove > 0u && !zero.empty(); --to_remove) {
+        const auto i = *zero.begin();
+        zero.erase(zero.begin());
+        alive[i] = 0;
+        const auto g = group[i];
+        if (g != n && --group_size[g] == 1u) {
+            // The last copy left contributes again, and takes the place of the group in the front.
+            const auto j = *std::find_if(order.begin() + static_cast<std::ptrdiff_t>(group_range[g].first),
+                                         order.begin() + static_cast<std::ptrdiff_t>(group_range[g].second),
+                                         [&alive](size_type k) { return alive[k] != 0; });
+            zero.erase(j);
+            front[group_front[g]] = j;
+        }
+    }
+    if (to_remove == 0u) {
+        return select_best_N_survivors(alive);
+    }
+    // The front is now made of distinct, non-dominated points.
+    std::vector<vector_double> front_points(front.size());
+    for (size_type a = 0u; a < front.size(); ++a) {
+        front_points[a] = input_f[front[a]];
+    }
+    const hv3d algo(false);
+    for (; to_remove > 0u; --to_remove) {
+        const auto c = algo.contributions(front_points, r_point);
+        size_type best = 0u;
+        for (size_type a = 1u; a < front.size(); ++a) {
+            if (c[a] < c[best] || (c[a] == c[best] && front[a] < front[best])) {
+                best = a;
+            }
+        }
+        alive[front[best]] = 0;
+        front.erase(front.begin() + static_cast<std::ptrdiff_t>(best));
+        front_points.erase(front_points.begin() + static_cast<std::ptrdiff_t>(best));
+    }
+    return select_best_N_survivors(alive);
+}
+
+// Greedy hypervolume truncation in four or more dimensions. The exclusive contributions are computed once, and
+// updated after each removal: removing p adds to the contribution of another point q the volume dominated by both
+// and by no other point, that is, the exclusive contribution of max(p, q) among the points limited to the box of p.
+// It is zero unless max(p, q) is non-dominated among the limited points, so only these neighbours of p are updated.
+inline std::vector<vector_double::size_type> select_best_N_hvnd(const std::vector<vector_double> &input_f,
+                                                                vector_double::size_type N,
+                                                                const vector_double &r_point)
+{
+    using size_type = vector_double::size_type;
+    const auto n = input_f.size();
+    const auto dim = r_point.size();
+    std::vector<char> alive(n, 1);
+    auto c = hypervolume(input_f, false).contributions(r_point);
+    std::set<std::pair<double, size_type>> queue;
+    for (size_type i = 0u; i < n; ++i) {
+        queue.emplace(c[i], i);
+    }
+    auto weakly_dominates = [](const vector_double &a, const vector_double &b) {
+        return std::equal(a.begin(), a.end(), b.begin(), [](double x, double y) { return x <= y; });
+    };
+    // Scratch buffers, reused across the removals. Their sizes never grow, so that no allocation takes place
+    // after the first removal.
+    std::vector<size_type> survivors, order, neighbours;
+    std::vector<vector_double> limited, box;
+    for (auto to_remove = n - N; to_remove > 0u; --to_remove) {
+        const auto i = queue.begin()->second;
+        queue.erase(queue.begin());
+        alive[i] = 0;
+        // The survivors, limited to the box of the removed point.
+        const auto &p = input_f[i];
+        survivors.clear();
+        for (size_type j = 0u; j < n; ++j) {
+            if (alive[j]) {
+                survivors.push_back(j);
+            }
+        }
+        const auto m = survivors.size();
+        limited.resize(m);
+        for (size_type a = 0u; a < m; ++a) {
+            limited[a].resize(dim);
+            for (size_type k = 0u; k < dim; ++k) {
+                limited[a][k] = std::max(p[k], input_f[survivors[a]][k]);
+            }
+        }
+        // The non-dominated limited points are found by scanning them in lexicographic order, as a point can only
+        // be dominated by the points preceding it.
+        order.resize(m);
+        std::iota(order.begin(), order.end(), size_type(0u));
+        std::sort(order.begin(), order.end(), [&limited](size_type a, size_type b) { return limited[a] < limited[b]; });
+        neighbours.clear();
+        for (auto a : order) {
+            if (std::none_of(neighbours.begin(), neighbours.end(),
+                             [&](size_type b) { return weakly_dominates(limited[b], limited[a]); })) {
+                neighbours.push_back(a);
+            }
+        }
+        // The volume gained by a neighbour is the volume of its limited box, minus the hypervolume of the other
+        // limited points within it.
+        std::shared_ptr<hv_algorithm> algo;
+        if (m > 1u) {
+            algo = hv_selector::get_algorithm(hv_selector::select(hv_selector::query::compute, dim, m - 1u));
+            box.resize(m - 1u);
+        }
+        for (auto a : neighbours) {
+            const auto &q = limited[a];
+            for (size_type b = 0u, pos = 0u; b < m; ++b) {
+                if (b != a) {
+                    auto &bq = box[pos++];
+                    bq.resize(dim);
+                    for (size_type k = 0u; k < dim; ++k) {
+                        bq[k] = std::max(q[k], limited[b][k]);
+                    }
+                }
+            }
+            double delta = hv_algorithm::volume_between(q, r_point);
+            if (algo) {
+                delta -= algo->compute(box, r_point);
+            }
+            if (delta > 0.) {
+                const auto j = survivors[a];
+                queue.erase(std::make_pair(c[j], j));
+                c[j] += delta;
+                queue.emplace(c[j], j);
+            }
+        }
+    }
+    return select_best_N_survivors(alive);
+}
+
+// Greedy truncation for indicators of the form mean_z min_a d(a, z), where z runs over a set of
+// reference vectors (IGD+ with the reference points, R2 with the weight vectors). For each reference
+// vector the best and second best surviving points are tracked: the cost of removing a point is the
+// sum, over the reference vectors it is the best for, of the gap to the second best.
+template <typename Dist>
+inline std::vector<vector_double::size_type> select_best_N_min_dist(vector_double::size_type n,
+                                                                    vector_double::size_type N,
+                                                                    vector_double::size_type n_ref, const Dist &d)
+{
+    using size_type = vector_double::size_type;
+    const auto none = n;
+    std::vector<char> alive(n, 1);
+    std::vector<size_type> best(n_ref), second(n_ref);
+    std::vector<double> d_best(n_ref), d_second(n_ref);
+    std::vector<double> cost(n, 0.);
+    // Finds best and second best alive points for the reference vector z.
+    auto scan = [&](size_type z) {
+        best[z] = second[z] = none;
+        d_best[z] = d_second[z] = std::numeric_limits<double>::infinity();
+        for (size_type a = 0u; a < n; ++a) {
+            if (!alive[a]) {
+                continue;
+            }
+            const double da = d(a, z);
+            if (da < d_best[z]) {
+                second[z] = best[z];
+                d_second[z] = d_best[z];
+                best[z] = a;
+                d_best[z] = da;
+            } else if (da < d_second[z]) {
+                second[z] = a;
+                d_second[z] = da;
+            }
+        }
+    };
+    // Recomputes the second best for z, given the best.
+    auto rescan_second = [&](size_type z) {
+        second[z] = none;
+        d_second[z] = std::numeric_limits<double>::infinity();
+        for (size_type a = 0u; a < n; ++a) {
+            if (alive[a] && a != best[z]) {
+                const double da = d(a, z);
+                if (da < d_second[z]) {
+                    second[z] = a;
+                    d_second[z] = da;
+                }
+            }
+        }
+    };
+    // As long as at least two points survive, every reference vector has a second best.
+    std::vector<std::vector<size_type>> owned(n), seconded(n);
+    for (size_type z = 0u; z < n_ref; ++z) {
+        scan(z);
+        cost[best[z]] += d_second[z] - d_best[z];
+        owned[best[z]].push_back(z);
+        seconded[second[z]].push_back(z);
+    }
+    std::set<std::pair<double, size_type>> queue;
+    for (size_type a = 0u; a < n; ++a) {
+        queue.emplace(cost[a], a);
+    }
+    auto update_cost = [&](size_type a, double delta) {
+        queue.erase(std::make_pair(cost[a], a));
+        cost[a] += delta;
+        queue.emplace(cost[a], a);
+    };
+    for (auto to_remove = n - N; to_remove > 0u; --to_remove) {
+        const auto a = queue.begin()->second;
+        queue.erase(queue.begin());
+        alive[a] = 0;
+        // The lists may contain stale entries: only the reference vectors still related to a are updated.
+        for (auto z : owned[a]) {
+            if (best[z] != a) {
+                continue;
+            }
+            best[z] = second[z];
+            d_best[z] = d_second[z];
+            rescan_second(z);
+            if (second[z] != none) {
+                update_cost(best[z], d_second[z] - d_best[z]);
+                owned[best[z]].push_back(z);
+                seconded[second[z]].push_back(z);
+            }
+        }
+        for (auto z : seconded[a]) {
+            if (second[z] != a) {
+                continue;
+            }
+            const double old_gap = d_second[z] - d_best[z];
+            rescan_second(z);
+            if (second[z] != none) {
+                update_cost(best[z], d_second[z] - d_best[z] - old_gap);
+                seconded[second[z]].push_back(z);
+            }
+        }
+        owned[a].clear();
+        seconded[a].clear();
+    }
+    return select_best_N_survivors(alive);
+}
+
+} // namespace detail
+
+/// Selects the best N individuals according to the hypervolume
+/**
+ * Selects the best N individuals out of a population (intended here as an
+ * <tt>std::vector<vector_double></tt> containing the objective vectors) by repeatedly discarding
+ * the individual with the least exclusive contribution to the hypervolume of the survivors.
+ * Dominated individuals contribute nothing and are thus discarded first.
+ *
+ * The contributions are not recomputed after each removal:
+ * - in two dimensions only the contributions of the two neighbours of the removed point on the
+ *   non-dominated staircase are updated, and the complexity is \f$ O(n\log n)\f$,
+ * - in three dimensions the non-dominated points are kept sorted along the third axis, and after each removal
+ *   their contributions are refreshed by a single sweep along that axis, so that the complexity is
+ *   \f$ O(kn\log n)\f$ for \f$k\f$ removals,
+ * - in four or more dimensions the contributions are computed once, and after each removal only those of the
+ *   neighbours of the removed point (the points sharing with it some volume not dominated by any other point)
+ *   are updated, at the cost of one hypervolume computation on \f$n - 1\f$ points for each neighbour.
+ *
+ * @param input_f Input objectives vectors. Example {{0.25,0.25},{-1,1},{2,-2}};
+ * @param N Number of best individuals to return
+ * @param r_point the reference point, which must be dominated by all the objective vectors
+ *
+ * @returns an <tt>std::vector</tt> containing the indexes of the best N objective vectors, in ascending order
+ *
+ * @throws std::invalid_argument if \p N is zero, if the objective vectors do not all have the same size, if the
+ * reference point has a different size, or if it is not dominated by all the objective vectors
+ * @throws unspecified any exception thrown by the hypervolume computations
+ */
+inline std::vector<vector_double::size_type> select_best_N_hv(const std::vector<vector_double> &input_f,
+                                                              vector_double::size_type N, const vector_double &r_point)
+{
+    std::vector<vector_double::size_type> retval;
+    if (detail::select_best_N_trivial(input_f, N, retval)) {
+        return retval;
+    }
+    if (r_point.size() != input_f[0].size()) {
+        pagmo_throw(std::invalid_argument, "The reference point has dimension " + std::to_string(r_point.size())
+                                               + ", while the objective vectors have dimension "
+                                               + std::to_string(input_f[0].size()));
+    }
+    for (const auto &f : input_f) {
+        for (decltype(f.size()) i = 0u; i < f.size(); ++i) {
+            if (!(f[i] <= r_point[i])) {
+                pagmo_throw(std::invalid_argument,
+                            "The reference point must be dominated by all the objective vectors");
+            }
+        }
+    }
+    if (r_point.size() == 1u) {
+        // Single objective: keep the N smallest values.
+        std::vector<vector_double::size_type> idx(input_f.size());
+        std::iota(idx.begin(), idx.end(), vector_double::size_type(0u));
+        std::stable_sort(idx.begin(), idx.end(), [&input_f](vector_double::size_type a, vector_double::size_type b) {
+            return input_f[a][0] < input_f[b][0];
+        });
+        idx.resize(N);
+        std::sort(idx.begin(), idx.end());
+        return idx;
+    }
+    if (r_point.size() == 2u) {
+        return detail::select_best_N_hv2d(input_f, N, r_point);
+    }
+    if (r_point.size() == 3u) {
+        return detail::select_best_N_hv3d(input_f, N, r_point);
+    }
+    return detail::select_best_N_hvnd(input_f, N, r_point);
+}
+
+/// Selects the best N individuals according to the IGD+ indicator
+/**
+ * Selects the best N individuals out of a population (intended here as an
+ * <tt>std::vector<vector_double></tt> containing the objective vectors) by repeatedly discarding
+ * the individual whose removal increases the least the IGD+ of the survivors with respect to \p ref_set:
+ * \f[
+ *  \mbox{IGD}^+(A) = \frac{1}{|Z|}\sum_{\mathbf z \in Z} \min_{\mathbf a \in A} \sqrt{\sum_i \max(a_i - z_i, 0)^2}.
+ * \f]
+ *
+ * For each reference point the closest and second closest survivors are tracked, so that after a removal
+ * only the reference points related to the removed individual are updated. Each removal costs
+ * \f$ O(|Z_a| n M)\f$, where \f$ |Z_a|\f$ is the number of reference points affected.
+ *
+ * @param input_f Input objectives vectors. Example {{0.25,0.25},{-1,1},{2,-2}};
+ * @param N Number of best individuals to return
+ * @param ref_set the reference points (e.g., a sampling of the Pareto front)
+ *
+ * @returns an <tt>std::vector</tt> containing the indexes of the best N objective vectors, in ascending order
+ *
+ * @throws std::invalid_argument if \p N is zero, if \p ref_set is empty, or if the sizes of the objective vectors
+ * and of the reference points are not all equal
+ *
+ * @see "Hisao Ishibuchi et al. Modified distance calculation in generational distance and inverted generational
+ * distance. EMO 2015, pages 110-125."
+ */
+inline std::vector<vector_double::size_type> select_best_N_igd_plus(const std::vector<vector_double> &input_f,
+                                                                    vector_double::size_type N,
+                                                                    const std::vector<vector_double> &ref_set)
+{
+    std::vector<vector_double::size_type> retval;
+    if (detail::select_best_N_trivial(input_f, N, retval)) {
+        return retval;
+    }
+    if (ref_set.empty()) {
+        pagmo_throw(std::invalid_argument, "The reference set of the IGD+ indicator cannot be empty");
+    }
+    for (const auto &z : ref_set) {
+        if (z.size() != input_f[0].size()) {
+            pagmo_throw(std::invalid_argument, "The reference points must have the same size as the objective vectors");
+        }
+    }
+    return detail::select_best_N_min_dist(input_f.size(), N, ref_set.size(),
+                                          [&input_f, &ref_set](vector_double::size_type a, vector_double::size_type z) {
+                                              double retval = 0.;
+                                              for (decltype(ref_set[z].size()) i = 0u; i < ref_set[z].size(); ++i) {
+                                                  const double diff = std::max(input_f[a][i] - ref_set[z][i], 0.);
+                                                  retval += diff * diff;
+                                              }
+                                              return std::sqrt(retval);
+                                          });
+}
+
+/// Selects the best N individuals according to the R2 indicator
+/**
+ * Selects the best N individuals out of a population (intended here as an
+ * <tt>std::vector<vector_double></tt> containing the objective vectors) by repeatedly discarding
+ * the individual whose removal increases the least the R2 indicator of the survivors:
+ * \f[
+ *  R_2(A) = \frac{1}{|W|}\sum_{\mathbf w \in W} \min_{\mathbf a \in A} \max_i w_i |a_i - z^*_i|,
+ * \f]
+ * where \f$ \mathbf z^*\f$ is the ideal point. The weight vectors can be produced, for instance, by
+ * pagmo::decomposition_weights().
+ *
+ * The bookkeeping and the complexity are the same as in pagmo::select_best_N_igd_plus().
+ *
+ * @param input_f Input objectives vectors. Example {{0.25,0.25},{-1,1},{2,-2}};
+ * @param N Number of best individuals to return
+ * @param weights the weight vectors
+ * @param ideal the ideal point
+ *
+ * @returns an <tt>std::vector</tt> containing the indexes of the best N objective vectors, in ascending order
+ *
+ * @throws std::invalid_argument if \p N is zero, if \p weights is empty, or if the sizes of the objective vectors,
+ * of the weights and of the ideal point are not all equal
+ *
+ * @see "Dimo Brockhoff, Tobias Wagner, Heike Trautmann. On the properties of the R2 indicator. GECCO 2012,
+ * pages 465-472."
+ */
+inline std::vector<vector_double::size_type> select_best_N_r2(const std::vector<vector_double> &input_f,
+                                                              vector_double::size_type N,
+                                                              const std::vector<vector_double> &weights,
+                                                              const vector_double &ideal)
+{
+    std::vector<vector_double::size_type> retval;
+    if (detail::select_best_N_trivial(input_f, N, retval)) {
+        return retval;
+    }
+    if (weights.empty()) {
+        pagmo_throw(std::invalid_argument, "The weights of the R2 indicator cannot be empty");
+    }
+    if (ideal.size() != input_f[0].size()) {
+        pagmo_throw(std::invalid_argument, "The ideal point must have the same size as the objective vectors");
+    }
+    for (const auto &w : weights) {
+        if (w.size() != input_f[0].size()) {
+            pagmo_throw(std::invalid_argument, "The weights must have the same size as the objective vectors");
+        }
+    }
+    return detail::select_best_N_min_dist(
+        input_f.size(), N, weights.size(),
+        [&input_f, &weights, &ideal](vector_double::size_type a, vector_double::size_type w) {
+            double retval = 0.;
+            for (decltype(ideal.size()) i = 0u; i < ideal.size(); ++i) {
+                retval = std::max(retval, weights[w][i] * std::abs(input_f[a][i] - ideal[i]));
+            }
+            return retval;
+        });
+}
+} // namespace pagmo
+
+#endif
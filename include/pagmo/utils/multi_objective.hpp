@@ -37,55 +37,146 @@ see https://www.gnu.org/licenses/. */
  */
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <numeric>
+#include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <vector>
 
 #include "../detail/custom_comparisons.hpp"
+#include "../detail/radix_sort.hpp"
+#include "../detail/separate_compilation.hpp"
 #include "../exceptions.hpp"
 #include "../io.hpp"
 #include "../population.hpp"
+#include "../rng.hpp"
+#include "../serialization.hpp"
 #include "../types.hpp"
-#include "../utils/discrepancy.hpp" // halton
+#include "../utils/discrepancy.hpp" // halton, van_der_corput
+#include "../utils/generic.hpp"     // binomial_coefficient
 
 namespace pagmo
 {
 
 namespace detail
 {
-// Recursive function building all m-ple of elements of X summing to s
-// In C/C++ implementations there exists a limit on the number of times you
-// can call recursively a function. It depends on a variety of factors,
-// but probably it a number around few thousands on modern machines.
-// If the limit is surpassed, the program terminates.
-// I was thinking that one could create a problem with a few thousands objectives,
-// call this function thus causing a crash from Python. In principle I think we
-// can prevent this by limiting the recursion (e.g., via a function parameter that
-// gets increased each time the function is called from itself).
-// But for now I'd just put a note about this.
-void reksum(std::vector<std::vector<double>> &retval, const std::vector<population::size_type> &X,
-            population::size_type m, population::size_type s, std::vector<double> eggs = std::vector<double>())
+// Number of points of a simplex-lattice with H divisions in n_f dimensions, i.e. the binomial
+// coefficient (H + n_f - 1 choose n_f - 1).
+inline double simplex_lattice_size(vector_double::size_type H, vector_double::size_type n_f)
 {
-    if (m == 1u) {
-        if (std::find(X.begin(), X.end(), s) == X.end()) { // not found
-            return;
-        } else {
-            eggs.push_back(static_cast<double>(s));
-            retval.push_back(eggs);
-        }
-    } else {
-        for (decltype(X.size()) i = 0u; i < X.size(); ++i) {
-            eggs.push_back(static_cast<double>(X[i]));
-            reksum(retval, X, m - 1u, s - X[i], eggs);
-            eggs.pop_back();
+    return binomial_coefficient(H + n_f - 1u, n_f - 1u);
+}
+
+// Largest number of divisions H such that the simplex-lattice in n_f dimensions has at most n points.
+// Requires n_f >= 2 and n >= 1.
+inline vector_double::size_type largest_simplex_lattice(vector_double::size_type n_f, vector_double::size_type n)
+{
+    if (n_f == 2u) {
+        return n - 1u;
+    }
+    vector_double::size_type H = 0u;
+    while (simplex_lattice_size(H + 1u, n_f) <= static_cast<double>(n)) {
+        ++H;
+    }
+    return H;
+}
+
+// Advances comp to the next composition of H into comp.size() non-negative parts (reverse lexicographic order,
+// starting from [H,0,...,0] and ending with [0,...,0,H]). Returns false if comp was the last composition.
+inline bool next_composition(std::vector<vector_double::size_type> &comp)
+{
+    const auto n = comp.size();
+    const auto last = comp[n - 1u];
+    comp[n - 1u] = 0u;
+    for (decltype(comp.size()) i = n - 1u; i > 0u; --i) {
+        if (comp[i - 1u] > 0u) {
+            --comp[i - 1u];
+            comp[i] = last + 1u;
+            return true;
         }
     }
+    comp[n - 1u] = last;
+    return false;
+}
+
+// Checks whether the point comp of the inner simplex-lattice with H2 divisions, once shrunk halfway towards the
+// centroid, coincides with a point of the boundary simplex-lattice with H1 divisions. Each component
+// 1 / (2 n) + comp[i] / (2 H2) is, in that case, a multiple of 1 / H1.
+inline bool inner_on_outer(const std::vector<vector_double::size_type> &comp, vector_double::size_type H1,
+                           vector_double::size_type H2)
+{
+    const auto n = comp.size();
+    if (H2 == 0u) {
+        return H1 % n == 0u;
+    }
+    return std::all_of(comp.begin(), comp.end(), [n, H1, H2](vector_double::size_type c) {
+        return (H1 * (H2 + n * c)) % (2u * n * H2) == 0u;
+    });
 }
 }
 
+/// Read-only view on a set of points stored contiguously
+/**
+ * This class is a lightweight, non-owning and read-only view on a set of points of the same dimension, stored one
+ * after the other in a contiguous buffer of doubles (i.e., the rows of a row-major matrix). The multi-objective
+ * utilities accepting a view work directly on the viewed data, without copying it into an
+ * <tt>std::vector<vector_double></tt>: this is useful when the points come from an external source (e.g., a NumPy
+ * array in pygmo).
+ *
+ * The view does not own the points: the underlying buffer must outlive it.
+ */
+class flat_points_view
+{
+public:
+    /// Size type
+    using size_type = vector_double::size_type;
+    /// Constructor
+    /**
+     * @param data pointer to the coordinates of the points (it can be null if \p n_points or \p dim is zero).
+     * @param n_points the number of points.
+     * @param dim the dimension of the points.
+     */
+    flat_points_view(const double *data, size_type n_points, size_type dim)
+        : m_data(data), m_n_points(n_points), m_dim(dim)
+    {
+    }
+    /// Number of points
+    /**
+     * @return the number of points in the view.
+     */
+    size_type size() const
+    {
+        return m_n_points;
+    }
+    /// Dimension of the points
+    /**
+     * @return the dimension of the points in the view.
+     */
+    size_type dim() const
+    {
+        return m_dim;
+    }
+    /// Access a point
+    /**
+     * @param i the index of a point.
+     *
+     * @return a pointer to the first coordinate of the point at index \p i.
+     */
+    const double *operator[](size_type i) const
+    {
+        return m_data + i * m_dim;
+    }
+
+private:
+    const double *m_data;
+    size_type m_n_points;
+    size_type m_dim;
+};
+
 /// Pareto-dominance
 /**
  * Return true if \p obj1 Pareto dominates \p obj2, false otherwise. Minimization
@@ -102,25 +193,7 @@ void reksum(std::vector<std::vector<double>> &retval, const std::vector<populati
  *
  * @throws std::invalid_argument if the dimensions of the two objectives are different
  */
-bool pareto_dominance(const vector_double &obj1, const vector_double &obj2)
-{
-    if (obj1.size() != obj2.size()) {
-        pagmo_throw(std::invalid_argument, "Different number of objectives found in input fitnesses: "
-                                               + std::to_string(obj1.size()) + " and " + std::to_string(obj2.size())
-                                               + ". I cannot define dominance");
-    }
-    vector_double::size_type count1 = 0u;
-    vector_double::size_type count2 = 0u;
-    for (decltype(obj1.size()) i = 0u; i < obj1.size(); ++i) {
-        if (obj1[i] < obj2[i]) {
-            ++count1;
-        }
-        if (obj1[i] == obj2[i]) {
-            ++count2;
-        }
-    }
-    return (((count1 + count2) == obj1.size()) && (count1 > 0u));
-}
+PAGMO_DECL bool pareto_dominance(const vector_double &obj1, const vector_double &obj2);
 
 /// Non dominated front 2D (Kung's algorithm)
 /**
@@ -137,50 +210,20 @@ bool pareto_dominance(const vector_double &obj1, const vector_double &obj2)
  *
  * @throws std::invalid_argument If the objective vectors are not all containing two-objectives
  */
-std::vector<vector_double::size_type> non_dominated_front_2d(const std::vector<vector_double> &input_objs)
-{
-    // If the input is empty return an empty vector
-    if (input_objs.size() == 0u) {
-        return {};
-    }
-    // How many objectives? M, of course.
-    auto M = input_objs[0].size();
-    // We make sure all input_objs contain M objectives
-    if (!std::all_of(input_objs.begin(), input_objs.end(),
-                     [M](const vector_double &item) { return item.size() == M; })) {
-        pagmo_throw(std::invalid_argument, "Input contains vector of objectives with heterogeneous dimensionalities");
-    }
-    // We make sure this function is only requested for two objectives.
-    if (M != 2u) {
-        pagmo_throw(std::invalid_argument, "The number of objectives detected is " + std::to_string(M)
-                                               + ", while Kung's algorithm only works for two objectives.");
-    }
-    // Sanity checks are over. We may run Kung's algorithm.
-    std::vector<vector_double::size_type> front;
-    std::vector<vector_double::size_type> indexes(input_objs.size());
-    std::iota(indexes.begin(), indexes.end(), vector_double::size_type(0u));
-    // Sort in ascending order with respect to the first component
-    std::sort(indexes.begin(), indexes.end(),
-              [&input_objs](vector_double::size_type idx1, vector_double::size_type idx2) {
-                  if (input_objs[idx1][0] == input_objs[idx2][0]) {
-                      return detail::less_than_f(input_objs[idx1][1], input_objs[idx2][1]);
-                  }
-                  return detail::less_than_f(input_objs[idx1][0], input_objs[idx2][0]);
-              });
-    for (auto i : indexes) {
-        bool flag = false;
-        for (auto j : front) {
-            if (pareto_dominance(input_objs[j], input_objs[i])) {
-                flag = true;
-                break;
-            }
-        }
-        if (!flag) {
-            front.push_back(i);
-        }
-    }
-    return front;
-}
+PAGMO_DECL std::vector<vector_double::size_type> non_dominated_front_2d(const std::vector<vector_double> &input_objs);
+
+/// Non dominated front 2D (Kung's algorithm) on a view
+/**
+ * Equivalent to pagmo::non_dominated_front_2d(const std::vector<vector_double> &), for points accessed in place
+ * through a pagmo::flat_points_view.
+ *
+ * @param input_objs the points.
+ *
+ * @return A <tt>std::vector</tt> containing the indexes of the points in the non-dominated front
+ *
+ * @throws std::invalid_argument If the points do not have two objectives
+ */
+PAGMO_DECL std::vector<vector_double::size_type> non_dominated_front_2d(const flat_points_view &input_objs);
 
 /// Return type for the fast_non_dominated_sorting algorithm
 using fnds_return_type
@@ -213,63 +256,20 @@ using fnds_return_type
  *
  * @throws std::invalid_argument If the size of \p points is not at least 2
  */
-fnds_return_type fast_non_dominated_sorting(const std::vector<vector_double> &points)
-{
-    auto N = points.size();
-    // We make sure to have two points at least (one could also be allowed)
-    if (N < 2u) {
-        pagmo_throw(std::invalid_argument, "At least two points are needed for fast_non_dominated_sorting: "
-                                               + std::to_string(N) + " detected.");
-    }
-    // Initialize the return values
-    std::vector<std::vector<vector_double::size_type>> non_dom_fronts(1u);
-    std::vector<std::vector<vector_double::size_type>> dom_list(N);
-    std::vector<vector_double::size_type> dom_count(N);
-    std::vector<vector_double::size_type> non_dom_rank(N);
+PAGMO_DECL fnds_return_type fast_non_dominated_sorting(const std::vector<vector_double> &points);
 
-    // Start the fast non dominated sort algorithm
-    for (decltype(N) i = 0u; i < N; ++i) {
-        dom_list[i].clear();
-        dom_count[i] = 0u;
-        for (decltype(N) j = 0u; j < N; ++j) {
-            if (i == j) {
-                continue;
-            }
-            if (pareto_dominance(points[i], points[j])) {
-                dom_list[i].push_back(j);
-            } else if (pareto_dominance(points[j], points[i])) {
-                ++dom_count[i];
-            }
-        }
-        if (dom_count[i] == 0u) {
-            non_dom_rank[i] = 0u;
-            non_dom_fronts[0].push_back(i);
-        }
-    }
-    // we copy dom_count as we want to output its value at this point
-    auto dom_count_copy(dom_count);
-    auto current_front = non_dom_fronts[0];
-    std::vector<std::vector<vector_double::size_type>>::size_type front_counter(0u);
-    while (current_front.size() != 0u) {
-        std::vector<vector_double::size_type> next_front;
-        for (decltype(current_front.size()) p = 0u; p < current_front.size(); ++p) {
-            for (decltype(dom_list[current_front[p]].size()) q = 0u; q < dom_list[current_front[p]].size(); ++q) {
-                --dom_count_copy[dom_list[current_front[p]][q]];
-                if (dom_count_copy[dom_list[current_front[p]][q]] == 0u) {
-                    non_dom_rank[dom_list[current_front[p]][q]] = front_counter + 1u;
-                    next_front.push_back(dom_list[current_front[p]][q]);
-                }
-            }
-        }
-        ++front_counter;
-        current_front = next_front;
-        if (current_front.size() != 0u) {
-            non_dom_fronts.push_back(current_front);
-        }
-    }
-    return std::make_tuple(std::move(non_dom_fronts), std::move(dom_list), std::move(dom_count),
-                           std::move(non_dom_rank));
-}
+/// Fast non dominated sorting on a view
+/**
+ * Equivalent to pagmo::fast_non_dominated_sorting(const std::vector<vector_double> &), for points accessed in place
+ * through a pagmo::flat_points_view.
+ *
+ * @param points the points.
+ *
+ * @return the non dominated fronts, the domination list, the domination count and the non domination rank.
+ *
+ * @throws std::invalid_argument If the number of points is not at least 2
+ */
+PAGMO_DECL fnds_return_type fast_non_dominated_sorting(const flat_points_view &points);
 
 /// Crowding distance
 /**
@@ -292,43 +292,21 @@ fnds_return_type fast_non_dominated_sorting(const std::vector<vector_double> &po
  * @throws std::invalid_argument If points in \p do not all have at least two objectives
  * @throws std::invalid_argument If points in \p non_dom_front do not all have the same dimensionality
 */
-vector_double crowding_distance(const std::vector<vector_double> &non_dom_front)
-{
-    auto N = non_dom_front.size();
-    // We make sure to have two points at least
-    if (N < 2u) {
-        pagmo_throw(std::invalid_argument,
-                    "A non dominated front must contain at least two points: " + std::to_string(N) + " detected.");
-    }
-    auto M = non_dom_front[0].size();
-    // We make sure the first point of the input non dominated front contains at least two objectives
-    if (M < 2u) {
-        pagmo_throw(std::invalid_argument, "Points in the non dominated front must contain at least two objectives: "
-                                               + std::to_string(M) + " detected.");
-    }
-    // We make sure all points contain the same number of objectives
-    if (!std::all_of(non_dom_front.begin(), non_dom_front.end(),
-                     [M](const vector_double &item) { return item.size() == M; })) {
-        pagmo_throw(std::invalid_argument, "A non dominated front must contain points of uniform dimensionality. Some "
-                                           "different sizes were instead detected.");
-    }
-    std::vector<vector_double::size_type> indexes(N);
-    std::iota(indexes.begin(), indexes.end(), vector_double::size_type(0u));
-    vector_double retval(N, 0.);
-    for (decltype(M) i = 0u; i < M; ++i) {
-        std::sort(indexes.begin(), indexes.end(),
-                  [i, &non_dom_front](vector_double::size_type idx1, vector_double::size_type idx2) {
-                      return detail::less_than_f(non_dom_front[idx1][i], non_dom_front[idx2][i]);
-                  });
-        retval[indexes[0]] = std::numeric_limits<double>::infinity();
-        retval[indexes[N - 1u]] = std::numeric_limits<double>::infinity();
-        double df = non_dom_front[indexes[N - 1u]][i] - non_dom_front[indexes[0]][i];
-        for (decltype(N - 2u) j = 1u; j < N - 1u; ++j) {
-            retval[indexes[j]] += (non_dom_front[indexes[j + 1u]][i] - non_dom_front[indexes[j - 1u]][i]) / df;
-        }
-    }
-    return retval;
-}
+PAGMO_DECL vector_double crowding_distance(const std::vector<vector_double> &non_dom_front);
+
+/// Crowding distance on a view
+/**
+ * Equivalent to pagmo::crowding_distance(const std::vector<vector_double> &), for points accessed in place
+ * through a pagmo::flat_points_view.
+ *
+ * @param non_dom_front the points of a non dominated front.
+ *
+ * @returns a vector_double containing the crowding distances.
+ *
+ * @throws std::invalid_argument If \p non_dom_front does not contain at least two points, or if the points do not
+ * have at least two objectives
+ */
+PAGMO_DECL vector_double crowding_distance(const flat_points_view &non_dom_front);
 
 /// Sorts a population in multi-objective optimization
 /**
@@ -356,48 +334,20 @@ vector_double crowding_distance(const std::vector<vector_double> &non_dom_front)
  *
  * @throws unspecified all exceptions thrown by pagmo::fast_non_dominated_sorting and pagmo::crowding_distance
  */
-std::vector<vector_double::size_type> sort_population_mo(const std::vector<vector_double> &input_f)
-{
-    if (input_f.size() < 2u) { // corner cases
-        if (input_f.size() == 0u) {
-            return {};
-        }
-        if (input_f.size() == 1u) {
-            return {0u};
-        }
-    }
-    // Create the indexes 0....N-1
-    std::vector<vector_double::size_type> retval(input_f.size());
-    std::iota(retval.begin(), retval.end(), vector_double::size_type(0u));
-    // Run fast-non-dominated sorting and compute the crowding distance for all input objectives vectors
-    auto tuple = fast_non_dominated_sorting(input_f);
-    vector_double crowding(input_f.size());
-    for (const auto &front : std::get<0>(tuple)) {
-        if (front.size() == 1u) {
-            crowding[front[0]] = 0u; // corner case of a non dominated front containing one individual. Crowding
-                                     // distance is not defined nor it will be used
-        } else {
-            std::vector<vector_double> non_dom_fits(front.size());
-            for (decltype(front.size()) i = 0u; i < front.size(); ++i) {
-                non_dom_fits[i] = input_f[front[i]];
-            }
-            vector_double tmp(crowding_distance(non_dom_fits));
-            for (decltype(front.size()) i = 0u; i < front.size(); ++i) {
-                crowding[front[i]] = tmp[i];
-            }
-        }
-    }
-    // Sort the indexes
-    std::sort(retval.begin(), retval.end(),
-              [&tuple, &crowding](vector_double::size_type idx1, vector_double::size_type idx2) {
-                  if (std::get<3>(tuple)[idx1] == std::get<3>(tuple)[idx2]) {        // same non domination rank
-                      return detail::greater_than_f(crowding[idx1], crowding[idx2]); // crowding distance decides
-                  } else {                                                           // different non domination ranks
-                      return std::get<3>(tuple)[idx1] < std::get<3>(tuple)[idx2];    // non domination rank decides
-                  };
-              });
-    return retval;
-}
+PAGMO_DECL std::vector<vector_double::size_type> sort_population_mo(const std::vector<vector_double> &input_f);
+
+/// Sorts a population in multi-objective optimization, on a view
+/**
+ * Equivalent to pagmo::sort_population_mo(const std::vector<vector_double> &), for objective vectors accessed in
+ * place through a pagmo::flat_points_view.
+ *
+ * @param input_f Input objectives vectors.
+ *
+ * @returns an <tt>std::vector</tt> containing the indexes of the sorted objectives vectors.
+ *
+ * @throws unspecified all exceptions thrown by pagmo::fast_non_dominated_sorting and pagmo::crowding_distance
+ */
+PAGMO_DECL std::vector<vector_double::size_type> sort_population_mo(const flat_points_view &input_f);
 
 /// Selects the best N individuals in multi-objective optimization
 /**
@@ -425,61 +375,23 @@ std::vector<vector_double::size_type> sort_population_mo(const std::vector<vecto
  *
  * @throws unspecified all exceptions thrown by pagmo::fast_non_dominated_sorting and pagmo::crowding_distance
  */
-std::vector<vector_double::size_type> select_best_N_mo(const std::vector<vector_double> &input_f,
-                                                       vector_double::size_type N)
-{
-    if (N < 1u) {
-        pagmo_throw(std::invalid_argument,
-                    "The best: " + std::to_string(N) + " individuals were requested, while 1 is the minimum");
-    }
-    if (input_f.size() == 0u) { // corner case
-        return {};
-    }
-    if (input_f.size() == 1u) { // corner case
-        return {0u};
-    }
-    if (N >= input_f.size()) { // corner case
-        std::vector<vector_double::size_type> retval(input_f.size());
-        std::iota(retval.begin(), retval.end(), vector_double::size_type(0u));
-        return retval;
-    }
-    std::vector<vector_double::size_type> retval;
-    std::vector<vector_double::size_type>::size_type front_id(0u);
-    // Run fast-non-dominated sorting
-    auto tuple = fast_non_dominated_sorting(input_f);
-    // Insert all non dominated fronts if not more than N
-    for (const auto &front : std::get<0>(tuple)) {
-        if (retval.size() + front.size() <= N) {
-            for (auto i : front) {
-                retval.push_back(i);
-            }
-            if (retval.size() == N) {
-                return retval;
-            }
-            ++front_id;
-        } else {
-            break;
-        }
-    }
-    auto front = std::get<0>(tuple)[front_id];
-    std::vector<vector_double> non_dom_fits(front.size());
-    // Run crowding distance for the front
-    for (decltype(front.size()) i = 0u; i < front.size(); ++i) {
-        non_dom_fits[i] = input_f[front[i]];
-    }
-    vector_double cds(crowding_distance(non_dom_fits));
-    // We now have front and crowding distance, we sort the front w.r.t. the crowding
-    std::vector<vector_double::size_type> idxs(front.size());
-    std::iota(idxs.begin(), idxs.end(), vector_double::size_type(0u));
-    std::sort(idxs.begin(), idxs.end(), [&cds](vector_double::size_type idx1, vector_double::size_type idx2) {
-        return detail::greater_than_f(cds[idx1], cds[idx2]);
-    }); // Descending order1
-    auto remaining = N - retval.size();
-    for (decltype(remaining) i = 0u; i < remaining; ++i) {
-        retval.push_back(front[idxs[i]]);
-    }
-    return retval;
-}
+PAGMO_DECL std::vector<vector_double::size_type> select_best_N_mo(const std::vector<vector_double> &input_f,
+                                                                  vector_double::size_type N);
+
+/// Selects the best N individuals in multi-objective optimization, on a view
+/**
+ * Equivalent to pagmo::select_best_N_mo(const std::vector<vector_double> &, vector_double::size_type), for
+ * objective vectors accessed in place through a pagmo::flat_points_view.
+ *
+ * @param input_f Input objectives vectors.
+ * @param N Number of best individuals to return
+ *
+ * @returns an <tt>std::vector</tt> containing the indexes of the best N objective vectors.
+ *
+ * @throws unspecified all exceptions thrown by pagmo::fast_non_dominated_sorting and pagmo::crowding_distance
+ */
+PAGMO_DECL std::vector<vector_double::size_type> select_best_N_mo(const flat_points_view &input_f,
+                                                                  vector_double::size_type N);
 
 /// Ideal point
 /**
@@ -494,31 +406,18 @@ std::vector<vector_double::size_type> select_best_N_mo(const std::vector<vector_
  *
  * @throws std::invalid_argument if the input objective vectors are not all of the same size
  */
-vector_double ideal(const std::vector<vector_double> &points)
-{
-    // Corner case
-    if (points.size() == 0u) {
-        return {};
-    }
+PAGMO_DECL vector_double ideal(const std::vector<vector_double> &points);
 
-    // Sanity checks
-    auto M = points[0].size();
-    for (const auto &f : points) {
-        if (f.size() != M) {
-            pagmo_throw(std::invalid_argument,
-                        "Input vector of objectives must contain fitness vector of equal dimension "
-                            + std::to_string(M));
-        }
-    }
-    // Actual algorithm
-    vector_double retval(M);
-    for (decltype(M) i = 0u; i < M; ++i) {
-        retval[i]
-            = (*std::min_element(points.begin(), points.end(),
-                                 [i](const vector_double &f1, const vector_double &f2) { return f1[i] < f2[i]; }))[i];
-    }
-    return retval;
-}
+/// Ideal point of a view
+/**
+ * Equivalent to pagmo::ideal(const std::vector<vector_double> &), for objective vectors accessed in place through
+ * a pagmo::flat_points_view.
+ *
+ * @param points Input objectives vectors.
+ *
+ * @returns A vector_double containing the ideal point.
+ */
+PAGMO_DECL vector_double ideal(const flat_points_view &points);
 
 /// Nadir point
 /**
@@ -532,29 +431,269 @@ vector_double ideal(const std::vector<vector_double> &points)
  * @returns A vector_double containing the nadir point. Example: {10,7}
  *
  */
-vector_double nadir(const std::vector<vector_double> &points)
+PAGMO_DECL vector_double nadir(const std::vector<vector_double> &points);
+
+/// Nadir point of a view
+/**
+ * Equivalent to pagmo::nadir(const std::vector<vector_double> &), for objective vectors accessed in place through
+ * a pagmo::flat_points_view.
+ *
+ * @param points Input objective vectors.
+ *
+ * @returns A vector_double containing the nadir point.
+ *
+ * @throws unspecified all exceptions thrown by pagmo::fast_non_dominated_sorting
+ */
+PAGMO_DECL vector_double nadir(const flat_points_view &points);
+
+/// Decomposition weights generator
+/**
+ * Streams, one at a time, weight vectors to be used to decompose a multi-objective problem. Contrary to
+ * pagmo::decomposition_weights(), the whole set of weights is never stored: only \f$O(n_f)\f$ memory is used and each
+ * weight is produced in \f$O(n_f)\f$ operations, so that exactly \f$n_w\f$ weights are obtained in
+ * \f$O(n_w n_f)\f$. Five methods are available:
+ * - "grid" generates weights on an uniform grid (simplex-lattice). As for pagmo::decomposition_weights(),
+ *   \f$n_w\f$ must be such that the grid is indeed possible.
+ * - "random" generates weights randomly distributing them uniformly on the simplex.
+ * - "low discrepancy" generates weights using the Halton low-discrepancy sequence.
+ * - "two layers" generates a boundary simplex-lattice having the largest number of divisions \f$H_1\f$ fitting in
+ *   \f$n_w\f$, then an inner simplex-lattice, shrunk halfway towards the centroid of the simplex, with the largest
+ *   number of divisions \f$H_2\f$ fitting in the remaining budget (inner points falling on the boundary lattice are
+ *   skipped). Any weights still missing are obtained with the "uniform design" method. Any \f$n_w \ge n_f\f$ is
+ *   thus allowed.
+ * - "uniform design" generates weights mapping a Hammersley point set (built on pagmo::van_der_corput sequences)
+ *   onto the simplex via the transformation of Fang and Wang. Any \f$n_w \ge n_f\f$ is allowed.
+ *
+ * All methods generate the canonical weights [1,0,0,...], [0,1,0,..], ... first.
+ *
+ * Example: to stream 10000 weights for a ten objectives problem:
+ * @code{.unparsed}
+ * decomposition_weights_generator gen(10u, 10000u, "two layers");
+ * vector_double w;
+ * while (gen.remaining()) {
+ *     gen(w);
+ *     // use w
+ * }
+ * @endcode
+ *
+ * See: Deb, Kalyanmoy, and Himanshu Jain. "An evolutionary many-objective optimization algorithm using
+ * reference-point-based nondominated sorting approach, part I." IEEE Transactions on Evolutionary Computation 18.4
+ * (2014): 577-601.
+ *
+ * See: Fang, Kai-Tai, and Yuan Wang. "Number-theoretic methods in statistics." Chapman & Hall (1994).
+ */
+class decomposition_weights_generator
 {
-    // Corner case
-    if (points.size() == 0u) {
-        return {};
+public:
+    /// Constructor
+    /**
+     * @param n_f dimension of each weight vector (i.e. fitness dimension)
+     * @param n_w number of weights to be generated
+     * @param weight_generation method to generate the weights. One of "grid", "random", "low discrepancy",
+     * "two layers" or "uniform design"
+     * @param seed seed used by the internal random number generator (only used by the "random" method)
+     *
+     * @throws std::invalid_argument if \p n_f is smaller than 2, if \p n_w is smaller than \p n_f, if
+     * \p weight_generation is unknown or if \p n_w is not compatible with the "grid" method
+     */
+    decomposition_weights_generator(vector_double::size_type n_f, vector_double::size_type n_w,
+                                    const std::string &weight_generation,
+                                    unsigned int seed = pagmo::random_device::next())
+        : m_n_f(n_f), m_n_w(n_w), m_weight_generation(weight_generation), m_count(0u), m_n_outer(0u), m_n_inner(0u),
+          m_n_ud(0u), m_H1(0u), m_H2(0u), m_ud_count(0u), m_e(seed)
+    {
+        if (n_f > n_w) {
+            pagmo_throw(std::invalid_argument,
+                        "A fitness size of " + std::to_string(n_f)
+                            + " was requested to the weight generation routine, while " + std::to_string(n_w)
+                            + " weights were requested to be generated. To allow weight be generated correctly the "
+                              "number of weights must be strictly larger than the number of objectives");
+        }
+        if (n_f < 2u) {
+            pagmo_throw(
+                std::invalid_argument,
+                "A fitness size of " + std::to_string(n_f)
+                    + " was requested to generate decomposed weights. A dimension of at least two must be requested.");
+        }
+        if (m_weight_generation == "grid" || m_weight_generation == "two layers") {
+            m_H1 = detail::largest_simplex_lattice(n_f, n_w);
+            const auto n_lattice = detail::simplex_lattice_size(m_H1, n_f);
+            if (m_weight_generation == "grid" && std::abs(static_cast<double>(n_w) - n_lattice) > 1E-8) {
+                std::ostringstream error_message;
+                error_message << "Population size of " << std::to_string(n_w)
+                              << " is detected, but not supported by the '" << m_weight_generation
+                              << "' weight generation method selected. A size of " << n_lattice << " or "
+                              << detail::simplex_lattice_size(m_H1 + 1u, n_f) << " is possible.";
+                pagmo_throw(std::invalid_argument, error_message.str());
+            }
+            m_n_outer = static_cast<vector_double::size_type>(n_lattice) - n_f;
+            const auto rest = n_w - n_f - m_n_outer;
+            if (rest > 0u) {
+                m_H2 = detail::largest_simplex_lattice(n_f, rest);
+                // Inner points lying on the boundary lattice are skipped: we count them here once.
+                std::vector<vector_double::size_type> comp(n_f, 0u);
+                comp[0] = m_H2;
+                do {
+                    if (!detail::inner_on_outer(comp, m_H1, m_H2)) {
+                        ++m_n_inner;
+                    }
+                } while (detail::next_composition(comp));
+                m_n_ud = rest - m_n_inner;
+            }
+        } else if (m_weight_generation == "uniform design") {
+            m_n_ud = n_w - n_f;
+        } else if (m_weight_generation == "low discrepancy") {
+            m_halton = halton{safe_cast<unsigned int>(n_f - 1u), safe_cast<unsigned int>(n_f)};
+        } else if (m_weight_generation != "random") {
+            pagmo_throw(std::invalid_argument, "Weight generation method " + m_weight_generation
+                                                   + " is unknown. One of 'grid', 'random', 'low discrepancy', "
+                                                     "'two layers' or 'uniform design' was expected");
+        }
+        // The outer lattice starts from its first corner, which is skipped as all corners are generated first.
+        m_comp.resize(n_f, 0u);
+        m_comp[0] = m_H1;
+        // Hammersley point set: the first coordinate is equispaced, the others are van der Corput sequences with
+        // co-prime bases (skipping their first element, which is always zero).
+        for (decltype(n_f) i = 0u; i + 2u < n_f; ++i) {
+            m_vdc.push_back(van_der_corput(detail::prime(safe_cast<unsigned int>(i + 1u)), 1u));
+        }
     }
-    // Sanity checks
-    auto M = points[0].size();
-    // We extract all objective vectors belonging to the first non dominated front (the Pareto front)
-    auto pareto_idx = std::get<0>(fast_non_dominated_sorting(points))[0];
-    std::vector<vector_double> nd_points;
-    for (auto idx : pareto_idx) {
-        nd_points.push_back(points[idx]);
+    /// Number of weights still to be generated
+    /**
+     * @return the number of weights that can still be requested to the generator
+     */
+    vector_double::size_type remaining() const
+    {
+        return m_n_w - m_count;
     }
-    // And compute the nadir over them
-    vector_double retval(M);
-    for (decltype(M) i = 0u; i < M; ++i) {
-        retval[i]
-            = (*std::max_element(nd_points.begin(), nd_points.end(),
-                                 [i](const vector_double &f1, const vector_double &f2) { return f1[i] < f2[i]; }))[i];
+    /// Generates the next weight in place
+    /**
+     * Writes the next weight into \p w, resizing it to \f$n_f\f$ if needed. Once \p w has the right size, no memory
+     * allocation takes place (except for the "random" and "low discrepancy" methods).
+     *
+     * @param w the vector that will contain the next weight
+     *
+     * @throws std::out_of_range if all the \f$n_w\f$ weights were already generated
+     */
+    void operator()(vector_double &w)
+    {
+        if (m_count == m_n_w) {
+            pagmo_throw(std::out_of_range, "All the " + std::to_string(m_n_w) + " weights were already generated");
+        }
+        w.resize(m_n_f);
+        if (m_count < m_n_f) {
+            // The canonical weights come first
+            std::fill(w.begin(), w.end(), 0.);
+            w[m_count] = 1.;
+        } else if (m_weight_generation == "random") {
+            vector_double dummy(m_n_f - 1u, 0.);
+            std::uniform_real_distribution<double> drng(0., 1.);
+            for (decltype(m_n_f) j = 0u; j < m_n_f - 1u; ++j) {
+                dummy[j] = drng(m_e);
+            }
+            w = sample_from_simplex(std::move(dummy));
+        } else if (m_weight_generation == "low discrepancy") {
+            w = sample_from_simplex(m_halton());
+        } else {
+            const auto k = m_count - m_n_f;
+            if (k < m_n_outer) {
+                // Boundary lattice, skipping its corners
+                do {
+                    detail::next_composition(m_comp);
+                } while (std::find(m_comp.begin(), m_comp.end(), m_H1) != m_comp.end());
+                for (decltype(m_n_f) j = 0u; j < m_n_f; ++j) {
+                    w[j] = static_cast<double>(m_comp[j]) / static_cast<double>(m_H1);
+                }
+            } else if (k < m_n_outer + m_n_inner) {
+                // Inner lattice, shrunk towards the centroid
+                if (k == m_n_outer) {
+                    std::fill(m_comp.begin(), m_comp.end(), 0u);
+                    m_comp[0] = m_H2;
+                } else {
+                    detail::next_composition(m_comp);
+                }
+                while (detail::inner_on_outer(m_comp, m_H1, m_H2)) {
+                    detail::next_composition(m_comp);
+                }
+                for (decltype(m_n_f) j = 0u; j < m_n_f; ++j) {
+                    // NOTE: with no divisions, the inner layer is just the centroid.
+                    w[j] = (m_H2 == 0u) ? 1. / static_cast<double>(m_n_f)
+                                        : 0.5 / static_cast<double>(m_n_f)
+                                              + 0.5 * static_cast<double>(m_comp[j]) / static_cast<double>(m_H2);
+                }
+            } else {
+                uniform_design(w);
+            }
+        }
+        ++m_count;
     }
-    return retval;
-}
+    /// Generates the next weight
+    /**
+     * @return the next weight
+     *
+     * @throws std::out_of_range if all the \f$n_w\f$ weights were already generated
+     */
+    vector_double operator()()
+    {
+        vector_double retval;
+        (*this)(retval);
+        return retval;
+    }
+    /// Object serialization
+    /**
+     * This method will save/load \p this into the archive \p ar.
+     *
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_n_f, m_n_w, m_weight_generation, m_count, m_n_outer, m_n_inner, m_n_ud, m_H1, m_H2, m_comp, m_ud_count,
+           m_vdc, m_halton, m_e);
+    }
+
+private:
+    // Maps the next point of the Hammersley set on the simplex (Fang and Wang transformation)
+    void uniform_design(vector_double &w)
+    {
+        const auto s = m_n_f;
+        double prod = 1.;
+        for (decltype(m_n_f) i = 0u; i < s - 1u; ++i) {
+            const double c = (i == 0u)
+                                 ? (2. * static_cast<double>(m_ud_count) + 1.) / (2. * static_cast<double>(m_n_ud))
+                                 : m_vdc[i - 1u]();
+            const double r = std::pow(c, 1. / static_cast<double>(s - 1u - i));
+            w[i] = prod * (1. - r);
+            prod *= r;
+        }
+        w[s - 1u] = prod;
+        ++m_ud_count;
+    }
+
+    vector_double::size_type m_n_f;
+    vector_double::size_type m_n_w;
+    std::string m_weight_generation;
+    // Number of weights generated so far
+    vector_double::size_type m_count;
+    // Number of (non canonical) weights in the boundary lattice, in the inner lattice and from the uniform design
+    vector_double::size_type m_n_outer;
+    vector_double::size_type m_n_inner;
+    vector_double::size_type m_n_ud;
+    // Divisions of the boundary and inner lattices
+    vector_double::size_type m_H1;
+    vector_double::size_type m_H2;
+    // Current lattice point
+    std::vector<vector_double::size_type> m_comp;
+    // Uniform design state
+    vector_double::size_type m_ud_count;
+    std::vector<van_der_corput> m_vdc;
+    // Low discrepancy state
+    halton m_halton;
+    // Random engine
+    detail::random_engine_type m_e;
+};
 
 /// Decomposition weights generation
 /**
@@ -569,6 +708,10 @@ vector_double nadir(const std::vector<vector_double> &points)
  *the Pareto front. Halton sequence is used since
  * low dimensionalities are expected in the number of objcetvices (i.e. less than 20), hence Halton sequence is deemes
  *as appropriate.
+ * - "two layers" generates a boundary and an inner simplex-lattice, completed by a uniform design, so that any number
+ * of weights is possible (see pagmo::decomposition_weights_generator)
+ * - "uniform design" generates weights mapping a Hammersley point set onto the simplex (see
+ * pagmo::decomposition_weights_generator)
  *
  * **NOTE** All genration methods are guaranteed to generate weights on the simplex (\f$\sum_i \lambda_i = 1\f$). All
  *weight generation methods
@@ -580,102 +723,69 @@ vector_double nadir(const std::vector<vector_double> &points)
  * auto lambdas = decomposition_weights(3u, 10u, "low discrepancy", r_engine);
  * @endcode
  *
+ * **NOTE** When many objectives and/or many weights are involved, pagmo::decomposition_weights_generator can be used
+ * to stream the weights without storing them all.
+ *
  * @param n_f dimension of each weight vector (i.e. fitness dimension)
  * @param n_w number of weights to be generated
  * @param weight_generation methods to generate the weights of the decomposed problems. One of "grid", "random",
- *"low discrepancy"
+ *"low discrepancy", "two layers", "uniform design"
  * @param r_engine random engine
  *
  * @returns an <tt>std:vector</tt> containing the weight vectors
  *
  * @throws if the population size is not compatible with the selected weight generation method
 **/
-std::vector<vector_double> decomposition_weights(vector_double::size_type n_f, vector_double::size_type n_w,
-                                                 const std::string &weight_generation,
-                                                 detail::random_engine_type &r_engine)
-{
-    // Sanity check
-    if (n_f > n_w) {
-        pagmo_throw(std::invalid_argument,
-                    "A fitness size of " + std::to_string(n_f)
-                        + " was requested to the weight generation routine, while " + std::to_string(n_w)
-                        + " weights were requested to be generated. To allow weight be generated correctly the number "
-                          "of weights must be strictly larger than the number of objectives");
-    }
+PAGMO_DECL std::vector<vector_double> decomposition_weights(vector_double::size_type n_f, vector_double::size_type n_w,
+                                                            const std::string &weight_generation,
+                                                            detail::random_engine_type &r_engine);
 
-    if (n_f < 2u) {
-        pagmo_throw(
-            std::invalid_argument,
-            "A fitness size of " + std::to_string(n_f)
-                + " was requested to generate decomposed weights. A dimension of at least two must be requested.");
-    }
+namespace detail
+{
 
-    // Random distributions
-    std::uniform_real_distribution<double> drng(0., 1.); // to generate a number in [0, 1)
-    std::vector<vector_double> retval;
-    if (weight_generation == "grid") {
-        // find the largest H resulting in a population smaller or equal to NP
-        decltype(n_w) H;
-        if (n_f == 2u) {
-            H = n_w - 1u;
-        } else if (n_f == 3u) {
-            H = static_cast<decltype(H)>(std::floor(0.5 * (std::sqrt(8. * static_cast<double>(n_w) + 1.) - 3.)));
-        } else {
-            H = 1u;
-            while (binomial_coefficient(H + n_f - 1u, n_f - 1u) <= static_cast<double>(n_w)) {
-                ++H;
-            }
-            H--;
-        }
-        // We check that NP equals the population size resulting from H
-        if (std::abs(static_cast<double>(n_w) - binomial_coefficient(H + n_f - 1u, n_f - 1u)) > 1E-8) {
-            std::ostringstream error_message;
-            error_message << "Population size of " << std::to_string(n_w) << " is detected, but not supported by the '"
-                          << weight_generation << "' weight generation method selected. A size of "
-                          << binomial_coefficient(H + n_f - 1u, n_f - 1u) << " or "
-                          << binomial_coefficient(H + n_f, n_f - 1u) << " is possible.";
-            pagmo_throw(std::invalid_argument, error_message.str());
+// The decomposed objective as a scalar, without checks on the input sizes (see pagmo::decompose_objectives()).
+inline double decompose_objectives_scalar(const vector_double &f, const vector_double &weight,
+                                          const vector_double &ref_point, const std::string &method)
+{
+    double fd = 0.;
+    if (method == "weighted") {
+        for (decltype(f.size()) i = 0u; i < f.size(); ++i) {
+            fd += weight[i] * f[i];
         }
-        // We generate the weights
-        std::vector<population::size_type> range(H + 1u);
-        std::iota(range.begin(), range.end(), std::vector<population::size_type>::size_type(0u));
-        detail::reksum(retval, range, n_f, H);
-        for (decltype(retval.size()) i = 0u; i < retval.size(); ++i) {
-            for (decltype(retval[i].size()) j = 0u; j < retval[i].size(); ++j) {
-                retval[i][j] /= static_cast<double>(H);
+    } else if (method == "tchebycheff") {
+        double tmp, fixed_weight;
+        for (decltype(f.size()) i = 0u; i < f.size(); ++i) {
+            (weight[i] == 0.) ? (fixed_weight = 1e-4)
+                              : (fixed_weight = weight[i]); // fixes the numerical problem of 0 weights
+            tmp = fixed_weight * std::abs(f[i] - ref_point[i]);
+            if (tmp > fd) {
+                fd = tmp;
             }
         }
-    } else if (weight_generation == "low discrepancy") {
-        // We first push back the "corners" [1,0,0,...], [0,1,0,...]
-        for (decltype(n_f) i = 0u; i < n_f; ++i) {
-            retval.push_back(vector_double(n_f, 0.));
-            retval[i][i] = 1.;
-        }
-        // Then we add points on the simplex randomly genrated using Halton low discrepancy sequence
-        halton ld_seq{safe_cast<unsigned int>(n_f - 1u), safe_cast<unsigned int>(n_f)};
-        for (decltype(n_w) i = n_f; i < n_w; ++i) {
-            retval.push_back(sample_from_simplex(ld_seq()));
-        }
-    } else if (weight_generation == "random") {
-        // We first push back the "corners" [1,0,0,...], [0,1,0,...]
-        for (decltype(n_f) i = 0u; i < n_f; ++i) {
-            retval.push_back(vector_double(n_f, 0.));
-            retval[i][i] = 1.;
+    } else if (method == "bi") { // BI method
+        const double THETA = 5.;
+        double d1 = 0.;
+        double weight_norm = 0.;
+        for (decltype(f.size()) i = 0u; i < f.size(); ++i) {
+            d1 += (f[i] - ref_point[i]) * weight[i];
+            weight_norm += std::pow(weight[i], 2);
         }
-        for (decltype(n_w) i = n_f; i < n_w; ++i) {
-            vector_double dummy(n_f - 1u, 0.);
-            for (decltype(n_f) j = 0u; j < n_f - 1u; ++j) {
-                dummy[j] = drng(r_engine);
-            }
-            retval.push_back(sample_from_simplex(dummy));
+        weight_norm = std::sqrt(weight_norm);
+        d1 = d1 / weight_norm;
+
+        double d2 = 0.;
+        for (decltype(f.size()) i = 0u; i < f.size(); ++i) {
+            d2 += std::pow(f[i] - (ref_point[i] + d1 * weight[i] / weight_norm), 2);
         }
+        d2 = std::sqrt(d2);
+        fd = d1 + THETA * d2;
     } else {
-        pagmo_throw(std::invalid_argument,
-                    "Weight generation method " + weight_generation
-                        + " is unknown. One of 'grid', 'random' or 'low discrepancy' was expected");
+        pagmo_throw(std::invalid_argument, "The decomposition method chosen was: " + method
+                                               + R"(, but only "weighted", "tchebycheff" or "bi" are allowed)");
     }
-    return retval;
+    return fd;
 }
+} // namespace detail
 
 /// Decomposes a vector of objectives.
 /**
@@ -736,44 +846,618 @@ inline vector_double decompose_objectives(const vector_double &f, const vector_d
         pagmo_throw(std::invalid_argument, "The number of objectives detected is: " + std::to_string(f.size())
                                                + ". Cannot decompose this into anything.");
     }
-    double fd = 0.;
-    if (method == "weighted") {
-        for (decltype(f.size()) i = 0u; i < f.size(); ++i) {
-            fd += weight[i] * f[i];
-        }
-    } else if (method == "tchebycheff") {
-        double tmp, fixed_weight;
-        for (decltype(f.size()) i = 0u; i < f.size(); ++i) {
-            (weight[i] == 0.) ? (fixed_weight = 1e-4)
-                              : (fixed_weight = weight[i]); // fixes the numerical problem of 0 weights
-            tmp = fixed_weight * std::abs(f[i] - ref_point[i]);
-            if (tmp > fd) {
-                fd = tmp;
-            }
-        }
-    } else if (method == "bi") { // BI method
-        const double THETA = 5.;
-        double d1 = 0.;
-        double weight_norm = 0.;
-        for (decltype(f.size()) i = 0u; i < f.size(); ++i) {
-            d1 += (f[i] - ref_point[i]) * weight[i];
-            weight_norm += std::pow(weight[i], 2);
-        }
-        weight_norm = std::sqrt(weight_norm);
-        d1 = d1 / weight_norm;
-
-        double d2 = 0.;
-        for (decltype(f.size()) i = 0u; i < f.size(); ++i) {
-            d2 += std::pow(f[i] - (ref_point[i] + d1 * weight[i] / weight_norm), 2);
-        }
-        d2 = std::sqrt(d2);
-        fd = d1 + THETA * d2;
-    } else {
-        pagmo_throw(std::invalid_argument, "The decomposition method chosen was: " + method
-                                               + R"(, but only "weighted", "tchebycheff" or "bi" are allowed)");
-    }
-    return {fd};
+    return {detail::decompose_objectives_scalar(f, weight, ref_point, method)};
 }
 
+// Definitions of the functions declared above (see detail/separate_compilation.hpp).
+#if defined(PAGMO_HEADER_DEFINITIONS)
+
+namespace detail
+{
+
+// Recursive function building all m-ple of elements of X summing to s
+// In C/C++ implementations there exists a limit on the number of times you
+// can call recursively a function. It depends on a variety of factors,
+// but probably it a number around few thousands on modern machines.
+// If the limit is surpassed, the program terminates.
+// I was thinking that one could create a problem with a few thousands objectives,
+// call this function thus causing a crash from Python. In principle I think we
+// can prevent this by limiting the recursion (e.g., via a function parameter that
+// gets increased each time the function is called from itself).
+// But for now I'd just put a note about this.
+PAGMO_DECL void reksum(std::vector<std::vector<double>> &retval, const std::vector<population::size_type> &X,
+                       population::size_type m, population::size_type s,
+                       std::vector<double> eggs = std::vector<double>())
+{
+    if (m == 1u) {
+        if (std::find(X.begin(), X.end(), s) == X.end()) { // not found
+            return;
+        } else {
+            eggs.push_back(static_cast<double>(s));
+            retval.push_back(eggs);
+        }
+    } else {
+        for (decltype(X.size()) i = 0u; i < X.size(); ++i) {
+            eggs.push_back(static_cast<double>(X[i]));
+            reksum(retval, X, m - 1u, s - X[i], eggs);
+            eggs.pop_back();
+        }
+    }
+}
+}
+
+namespace detail
+{
+
+// The implementations of the multi-objective utilities below work on both std::vector<vector_double> and
+// flat_points_view, accessing the points via the following functions.
+inline const double *mo_row(const std::vector<vector_double> &points, vector_double::size_type i)
+{
+    return points[i].data();
+}
+
+inline const double *mo_row(const flat_points_view &points, vector_double::size_type i)
+{
+    return points[i];
+}
+
+// Dimension of the points of a non-empty set.
+inline vector_double::size_type mo_dim(const std::vector<vector_double> &points)
+{
+    return points[0].size();
+}
+
+inline vector_double::size_type mo_dim(const flat_points_view &points)
+{
+    return points.dim();
+}
+
+// Checks that the points have all the same dimension, which is required to define dominance. The error is the one
+// pareto_dominance() raises on the first pair of points of different dimension.
+inline void mo_check_uniform(const std::vector<vector_double> &points)
+{
+    for (const auto &p : points) {
+        if (p.size() != points[0].size()) {
+            pagmo_throw(std::invalid_argument, "Different number of objectives found in input fitnesses: "
+                                                   + std::to_string(points[0].size()) + " and "
+                                                   + std::to_string(p.size()) + ". I cannot define dominance");
+        }
+    }
+}
+
+inline void mo_check_uniform(const flat_points_view &)
+{
+}
+
+inline bool pareto_dominance_rows(const double *obj1, const double *obj2, vector_double::size_type M)
+{
+    vector_double::size_type count1 = 0u;
+    vector_double::size_type count2 = 0u;
+    for (decltype(M) i = 0u; i < M; ++i) {
+        if (obj1[i] < obj2[i]) {
+            ++count1;
+        }
+        if (obj1[i] == obj2[i]) {
+            ++count2;
+        }
+    }
+    return (((count1 + count2) == M) && (count1 > 0u));
+}
+
+// Requires two objectives.
+template <typename Points>
+inline std::vector<vector_double::size_type> non_dominated_front_2d_impl(const Points &input_objs)
+{
+    std::vector<vector_double::size_type> front;
+    std::vector<vector_double::size_type> indexes(input_objs.size());
+    std::iota(indexes.begin(), indexes.end(), vector_double::size_type(0u));
+    // Sort in ascending order with respect to the first component
+    if (indexes.size() >= radix_sort_threshold) {
+        // Stable sorts, starting from the least significant component.
+        radix_sort_by_key(indexes.begin(), indexes.end(),
+                          [&input_objs](vector_double::size_type idx) { return mo_row(input_objs, idx)[1]; });
+        radix_sort_by_key(indexes.begin(), indexes.end(),
+                          [&input_objs](vector_double::size_type idx) { return mo_row(input_objs, idx)[0]; });
+    } else {
+        std::sort(indexes.begin(), indexes.end(),
+                  [&input_objs](vector_double::size_type idx1, vector_double::size_type idx2) {
+                      const auto p1 = mo_row(input_objs, idx1), p2 = mo_row(input_objs, idx2);
+                      if (p1[0] == p2[0]) {
+                          return less_than_f(p1[1], p2[1]);
+                      }
+                      return less_than_f(p1[0], p2[0]);
+                  });
+    }
+    for (auto i : indexes) {
+        bool flag = false;
+        for (auto j : front) {
+            if (pareto_dominance_rows(mo_row(input_objs, j), mo_row(input_objs, i), 2u)) {
+                flag = true;
+                break;
+            }
+        }
+        if (!flag) {
+            front.push_back(i);
+        }
+    }
+    return front;
+}
+
+template <typename Points>
+inline fnds_return_type fast_non_dominated_sorting_impl(const Points &points)
+{
+    auto N = points.size();
+    // We make sure to have two points at least (one could also be allowed)
+    if (N < 2u) {
+        pagmo_throw(std::invalid_argument, "At least two points are needed for fast_non_dominated_sorting: "
+                                               + std::to_string(N) + " detected.");
+    }
+    mo_check_uniform(points);
+    const auto M = mo_dim(points);
+    // Initialize the return values
+    std::vector<std::vector<vector_double::size_type>> non_dom_fronts(1u);
+    std::vector<std::vector<vector_double::size_type>> dom_list(N);
+    std::vector<vector_double::size_type> dom_count(N);
+    std::vector<vector_double::size_type> non_dom_rank(N);
+
+    // Start the fast non dominated sort algorithm
+    for (decltype(N) i = 0u; i < N; ++i) {
+        dom_list[i].clear();
+        dom_count[i] = 0u;
+        for (decltype(N) j = 0u; j < N; ++j) {
+            if (i == j) {
+                continue;
+            }
+            if (pareto_dominance_rows(mo_row(points, i), mo_row(points, j), M)) {
+                dom_list[i].push_back(j);
+            } else if (pareto_dominance_rows(mo_row(points, j), mo_row(points, i), M)) {
+                ++dom_count[i];
+            }
+        }
+        if (dom_count[i] == 0u) {
+            non_dom_rank[i] = 0u;
+            non_dom_fronts[0].push_back(i);
+        }
+    }
+    // we copy dom_count as we want to output its value at this point
+    auto dom_count_copy(dom_count);
+    auto current_front = non_dom_fronts[0];
+    std::vector<std::vector<vector_double::size_type>>::size_type front_counter(0u);
+    while (current_front.size() != 0u) {
+        std::vector<vector_double::size_type> next_front;
+        for (decltype(current_front.size()) p = 0u; p < current_front.size(); ++p) {
+            for (decltype(dom_list[current_front[p]].size()) q = 0u; q < dom_list[current_front[p]].size(); ++q) {
+                --dom_count_copy[dom_list[current_front[p]][q]];
+                if (dom_count_copy[dom_list[current_front[p]][q]] == 0u) {
+                    non_dom_rank[dom_list[current_front[p]][q]] = front_counter + 1u;
+                    next_front.push_back(dom_list[current_front[p]][q]);
+                }
+            }
+        }
+        ++front_counter;
+        current_front = next_front;
+        if (current_front.size() != 0u) {
+            non_dom_fronts.push_back(current_front);
+        }
+    }
+    return std::make_tuple(std::move(non_dom_fronts), std::move(dom_list), std::move(dom_count),
+                           std::move(non_dom_rank));
+}
+
+inline void crowding_distance_check(vector_double::size_type N, vector_double::size_type M)
+{
+    // We make sure to have two points at least
+    if (N < 2u) {
+        pagmo_throw(std::invalid_argument,
+                    "A non dominated front must contain at least two points: " + std::to_string(N) + " detected.");
+    }
+    // We make sure the points contain at least two objectives
+    if (M < 2u) {
+        pagmo_throw(std::invalid_argument, "Points in the non dominated front must contain at least two objectives: "
+                                               + std::to_string(M) + " detected.");
+    }
+}
+
+// Crowding distance of the points with indices front in points, computed without copying them. The checks
+// in crowding_distance_check() must have passed.
+template <typename Points>
+inline vector_double crowding_distance_impl(const Points &points, const std::vector<vector_double::size_type> &front,
+                                            vector_double::size_type M)
+{
+    auto N = front.size();
+    std::vector<vector_double::size_type> indexes(N);
+    std::iota(indexes.begin(), indexes.end(), vector_double::size_type(0u));
+    vector_double retval(N, 0.);
+    auto coord = [&points, &front](vector_double::size_type idx, vector_double::size_type i) {
+        return mo_row(points, front[idx])[i];
+    };
+    for (decltype(M) i = 0u; i < M; ++i) {
+        sort_by_key(indexes.begin(), indexes.end(),
+                    [i, &coord](vector_double::size_type idx) { return coord(idx, i); });
+        retval[indexes[0]] = std::numeric_limits<double>::infinity();
+        retval[indexes[N - 1u]] = std::numeric_limits<double>::infinity();
+        double df = coord(indexes[N - 1u], i) - coord(indexes[0], i);
+        for (decltype(N - 2u) j = 1u; j < N - 1u; ++j) {
+            retval[indexes[j]] += (coord(indexes[j + 1u], i) - coord(indexes[j - 1u], i)) / df;
+        }
+    }
+    return retval;
+}
+
+template <typename Points>
+inline std::vector<vector_double::size_type> sort_population_mo_impl(const Points &input_f)
+{
+    if (input_f.size() < 2u) { // corner cases
+        if (input_f.size() == 0u) {
+            return {};
+        }
+        if (input_f.size() == 1u) {
+            return {0u};
+        }
+    }
+    // Create the indexes 0....N-1
+    std::vector<vector_double::size_type> retval(input_f.size());
+    std::iota(retval.begin(), retval.end(), vector_double::size_type(0u));
+    // Run fast-non-dominated sorting and compute the crowding distance for all input objectives vectors
+    auto tuple = fast_non_dominated_sorting_impl(input_f);
+    const auto M = mo_dim(input_f);
+    vector_double crowding(input_f.size());
+    for (const auto &front : std::get<0>(tuple)) {
+        if (front.size() == 1u) {
+            crowding[front[0]] = 0u; // corner case of a non dominated front containing one individual. Crowding
+                                     // distance is not defined nor it will be used
+        } else {
+            crowding_distance_check(front.size(), M);
+            vector_double tmp(crowding_distance_impl(input_f, front, M));
+            for (decltype(front.size()) i = 0u; i < front.size(); ++i) {
+                crowding[front[i]] = tmp[i];
+            }
+        }
+    }
+    // Sort the indexes
+    std::sort(retval.begin(), retval.end(),
+              [&tuple, &crowding](vector_double::size_type idx1, vector_double::size_type idx2) {
+                  if (std::get<3>(tuple)[idx1] == std::get<3>(tuple)[idx2]) {        // same non domination rank
+                      return detail::greater_than_f(crowding[idx1], crowding[idx2]); // crowding distance decides
+                  } else {                                                           // different non domination ranks
+                      return std::get<3>(tuple)[idx1] < std::get<3>(tuple)[idx2];    // non domination rank decides
+                  };
+              });
+    return retval;
+}
+
+template <typename Points>
+inline std::vector<vector_double::size_type> select_best_N_mo_impl(const Points &input_f, vector_double::size_type N)
+{
+    if (N < 1u) {
+        pagmo_throw(std::invalid_argument,
+                    "The best: " + std::to_string(N) + " individuals were requested, while 1 is the minimum");
+    }
+    if (input_f.size() == 0u) { // corner case
+        return {};
+    }
+    if (input_f.size() == 1u) { // corner case
+        return {0u};
+    }
+    if (N >= input_f.size()) { // corner case
+        std::vector<vector_double::size_type> retval(input_f.size());
+        std::iota(retval.begin(), retval.end(), vector_double::size_type(0u));
+        return retval;
+    }
+    std::vector<vector_double::size_type> retval;
+    std::vector<vector_double::size_type>::size_type front_id(0u);
+    // Run fast-non-dominated sorting
+    auto tuple = fast_non_dominated_sorting_impl(input_f);
+    // Insert all non dominated fronts if not more than N
+    for (const auto &front : std::get<0>(tuple)) {
+        if (retval.size() + front.size() <= N) {
+            for (auto i : front) {
+                retval.push_back(i);
+            }
+            if (retval.size() == N) {
+                return retval;
+            }
+            ++front_id;
+        } else {
+            break;
+        }
+    }
+    const auto &front = std::get<0>(tuple)[front_id];
+    // Run crowding distance for the front
+    const auto M = mo_dim(input_f);
+    crowding_distance_check(front.size(), M);
+    vector_double cds(crowding_distance_impl(input_f, front, M));
+    // We now have front and crowding distance, we sort the front w.r.t. the crowding
+    std::vector<vector_double::size_type> idxs(front.size());
+    std::iota(idxs.begin(), idxs.end(), vector_double::size_type(0u));
+    std::sort(idxs.begin(), idxs.end(), [&cds](vector_double::size_type idx1, vector_double::size_type idx2) {
+        return detail::greater_than_f(cds[idx1], cds[idx2]);
+    }); // Descending order1
+    auto remaining = N - retval.size();
+    for (decltype(remaining) i = 0u; i < remaining; ++i) {
+        retval.push_back(front[idxs[i]]);
+    }
+    return retval;
+}
+
+// Requires a non-empty set of points of the same dimension.
+template <typename Points>
+inline vector_double ideal_impl(const Points &points)
+{
+    auto M = mo_dim(points);
+    vector_double retval(M);
+    for (decltype(M) i = 0u; i < M; ++i) {
+        // First minimum, as std::min_element.
+        decltype(points.size()) best = 0u;
+        for (decltype(points.size()) k = 1u; k < points.size(); ++k) {
+            if (mo_row(points, k)[i] < mo_row(points, best)[i]) {
+                best = k;
+            }
+        }
+        retval[i] = mo_row(points, best)[i];
+    }
+    return retval;
+}
+
+template <typename Points>
+inline vector_double nadir_impl(const Points &points)
+{
+    // Corner case
+    if (points.size() == 0u) {
+        return {};
+    }
+    // We extract all objective vectors belonging to the first non dominated front (the Pareto front)
+    const auto pareto_idx = std::get<0>(fast_non_dominated_sorting_impl(points))[0];
+    // And compute the nadir over them
+    auto M = mo_dim(points);
+    vector_double retval(M);
+    for (decltype(M) i = 0u; i < M; ++i) {
+        // First maximum, as std::max_element.
+        auto best = pareto_idx[0];
+        for (auto idx : pareto_idx) {
+            if (mo_row(points, best)[i] < mo_row(points, idx)[i]) {
+                best = idx;
+            }
+        }
+        retval[i] = mo_row(points, best)[i];
+    }
+    return retval;
+}
+}
+
+PAGMO_DECL bool pareto_dominance(const vector_double &obj1, const vector_double &obj2)
+{
+    if (obj1.size() != obj2.size()) {
+        pagmo_throw(std::invalid_argument, "Different number of objectives found in input fitnesses: "
+                                               + std::to_string(obj1.size()) + " and " + std::to_string(obj2.size())
+                                               + ". I cannot define dominance");
+    }
+    return detail::pareto_dominance_rows(obj1.data(), obj2.data(), obj1.size());
+}
+
+PAGMO_DECL std::vector<vector_double::size_type> non_dominated_front_2d(const std::vector<vector_double> &input_objs)
+{
+    // If the input is empty return an empty vector
+    if (input_objs.size() == 0u) {
+        return {};
+    }
+    // How many objectives? M, of course.
+    auto M = input_objs[0].size();
+    // We make sure all input_objs contain M objectives
+    if (!std::all_of(input_objs.begin(), input_objs.end(),
+                     [M](const vector_double &item) { return item.size() == M; })) {
+        pagmo_throw(std::invalid_argument, "Input contains vector of objectives with heterogeneous dimensionalities");
+    }
+    // We make sure this function is only requested for two objectives.
+    if (M != 2u) {
+        pagmo_throw(std::invalid_argument, "The number of objectives detected is " + std::to_string(M)
+                                               + ", while Kung's algorithm only works for two objectives.");
+    }
+    // Sanity checks are over. We may run Kung's algorithm.
+    return detail::non_dominated_front_2d_impl(input_objs);
+}
+
+PAGMO_DECL std::vector<vector_double::size_type> non_dominated_front_2d(const flat_points_view &input_objs)
+{
+    if (input_objs.size() == 0u) {
+        return {};
+    }
+    if (input_objs.dim() != 2u) {
+        pagmo_throw(std::invalid_argument, "The number of objectives detected is " + std::to_string(input_objs.dim())
+                                               + ", while Kung's algorithm only works for two objectives.");
+    }
+    return detail::non_dominated_front_2d_impl(input_objs);
+}
+
+PAGMO_DECL fnds_return_type fast_non_dominated_sorting(const std::vector<vector_double> &points)
+{
+    return detail::fast_non_dominated_sorting_impl(points);
+}
+
+PAGMO_DECL fnds_return_type fast_non_dominated_sorting(const flat_points_view &points)
+{
+    return detail::fast_non_dominated_sorting_impl(points);
+}
+
+PAGMO_DECL vector_double crowding_distance(const std::vector<vector_double> &non_dom_front)
+{
+    auto N = non_dom_front.size();
+    detail::crowding_distance_check(N, N ? non_dom_front[0].size() : 0u);
+    auto M = non_dom_front[0].size();
+    // We make sure all points contain the same number of objectives
+    if (!std::all_of(non_dom_front.begin(), non_dom_front.end(),
+                     [M](const vector_double &item) { return item.size() == M; })) {
+        pagmo_throw(std::invalid_argument, "A non dominated front must contain points of uniform dimensionality. Some "
+                                           "different sizes were instead detected.");
+    }
+    std::vector<vector_double::size_type> front(N);
+    std::iota(front.begin(), front.end(), vector_double::size_type(0u));
+    return detail::crowding_distance_impl(non_dom_front, front, M);
+}
+
+PAGMO_DECL vector_double crowding_distance(const flat_points_view &non_dom_front)
+{
+    detail::crowding_distance_check(non_dom_front.size(), non_dom_front.dim());
+    std::vector<vector_double::size_type> front(non_dom_front.size());
+    std::iota(front.begin(), front.end(), vector_double::size_type(0u));
+    return detail::crowding_distance_impl(non_dom_front, front, non_dom_front.dim());
+}
+
+PAGMO_DECL std::vector<vector_double::size_type> sort_population_mo(const std::vector<vector_double> &input_f)
+{
+    return detail::sort_population_mo_impl(input_f);
+}
+
+PAGMO_DECL std::vector<vector_double::size_type> sort_population_mo(const flat_points_view &input_f)
+{
+    return detail::sort_population_mo_impl(input_f);
+}
+
+PAGMO_DECL std::vector<vector_double::size_type> select_best_N_mo(const std::vector<vector_double> &input_f,
+                                                                  vector_double::size_type N)
+{
+    return detail::select_best_N_mo_impl(input_f, N);
+}
+
+PAGMO_DECL std::vector<vector_double::size_type> select_best_N_mo(const flat_points_view &input_f,
+                                                                  vector_double::size_type N)
+{
+    return detail::select_best_N_mo_impl(input_f, N);
+}
+
+PAGMO_DECL vector_double ideal(const std::vector<vector_double> &points)
+{
+    // Corner case
+    if (points.size() == 0u) {
+        return {};
+    }
+
+    // Sanity checks
+    auto M = points[0].size();
+    for (const auto &f : points) {
+        if (f.size() != M) {
+            pagmo_throw(std::invalid_argument,
+                        "Input vector of objectives must contain fitness vector of equal dimension "
+                            + std::to_string(M));
+        }
+    }
+    // Actual algorithm
+    return detail::ideal_impl(points);
+}
+
+PAGMO_DECL vector_double ideal(const flat_points_view &points)
+{
+    if (points.size() == 0u) {
+        return {};
+    }
+    return detail::ideal_impl(points);
+}
+
+PAGMO_DECL vector_double nadir(const std::vector<vector_double> &points)
+{
+    return detail::nadir_impl(points);
+}
+
+PAGMO_DECL vector_double nadir(const flat_points_view &points)
+{
+    return detail::nadir_impl(points);
+}
+
+PAGMO_DECL std::vector<vector_double> decomposition_weights(vector_double::size_type n_f, vector_double::size_type n_w,
+                                                            const std::string &weight_generation,
+                                                            detail::random_engine_type &r_engine)
+{
+    // Sanity check
+    if (n_f > n_w) {
+        pagmo_throw(std::invalid_argument,
+                    "A fitness size of " + std::to_string(n_f)
+                        + " was requested to the weight generation routine, while " + std::to_string(n_w)
+                        + " weights were requested to be generated. To allow weight be generated correctly the number "
+                          "of weights must be strictly larger than the number of objectives");
+    }
+
+    if (n_f < 2u) {
+        pagmo_throw(
+            std::invalid_argument,
+            "A fitness size of " + std::to_string(n_f)
+                + " was requested to generate decomposed weights. A dimension of at least two must be requested.");
+    }
+
+    // Random distributions
+    std::uniform_real_distribution<double> drng(0., 1.); // to generate a number in [0, 1)
+    std::vector<vector_double> retval;
+    if (weight_generation == "grid") {
+        // find the largest H resulting in a population smaller or equal to NP
+        decltype(n_w) H;
+        if (n_f == 2u) {
+            H = n_w - 1u;
+        } else if (n_f == 3u) {
+            H = static_cast<decltype(H)>(std::floor(0.5 * (std::sqrt(8. * static_cast<double>(n_w) + 1.) - 3.)));
+        } else {
+            H = 1u;
+            while (binomial_coefficient(H + n_f - 1u, n_f - 1u) <= static_cast<double>(n_w)) {
+                ++H;
+            }
+            H--;
+        }
+        // We check that NP equals the population size resulting from H
+        if (std::abs(static_cast<double>(n_w) - binomial_coefficient(H + n_f - 1u, n_f - 1u)) > 1E-8) {
+            std::ostringstream error_message;
+            error_message << "Population size of " << std::to_string(n_w) << " is detected, but not supported by the '"
+                          << weight_generation << "' weight generation method selected. A size of "
+                          << binomial_coefficient(H + n_f - 1u, n_f - 1u) << " or "
+                          << binomial_coefficient(H + n_f, n_f - 1u) << " is possible.";
+            pagmo_throw(std::invalid_argument, error_message.str());
+        }
+        // We generate the weights
+        std::vector<population::size_type> range(H + 1u);
+        std::iota(range.begin(), range.end(), std::vector<population::size_type>::size_type(0u));
+        detail::reksum(retval, range, n_f, H);
+        for (decltype(retval.size()) i = 0u; i < retval.size(); ++i) {
+            for (decltype(retval[i].size()) j = 0u; j < retval[i].size(); ++j) {
+                retval[i][j] /= static_cast<double>(H);
+            }
+        }
+    } else if (weight_generation == "low discrepancy") {
+        // We first push back the "corners" [1,0,0,...], [0,1,0,...]
+        for (decltype(n_f) i = 0u; i < n_f; ++i) {
+            retval.push_back(vector_double(n_f, 0.));
+            retval[i][i] = 1.;
+        }
+        // Then we add points on the simplex randomly genrated using Halton low discrepancy sequence
+        halton ld_seq{safe_cast<unsigned int>(n_f - 1u), safe_cast<unsigned int>(n_f)};
+        for (decltype(n_w) i = n_f; i < n_w; ++i) {
+            retval.push_back(sample_from_simplex(ld_seq()));
+        }
+    } else if (weight_generation == "random") {
+        // We first push back the "corners" [1,0,0,...], [0,1,0,...]
+        for (decltype(n_f) i = 0u; i < n_f; ++i) {
+            retval.push_back(vector_double(n_f, 0.));
+            retval[i][i] = 1.;
+        }
+        for (decltype(n_w) i = n_f; i < n_w; ++i) {
+            vector_double dummy(n_f - 1u, 0.);
+            for (decltype(n_f) j = 0u; j < n_f - 1u; ++j) {
+                dummy[j] = drng(r_engine);
+            }
+            retval.push_back(sample_from_simplex(dummy));
+        }
+    } else if (weight_generation == "two layers" || weight_generation == "uniform design") {
+        // These methods are deterministic, we just drain the generator.
+        decomposition_weights_generator gen(n_f, n_w, weight_generation, 0u);
+        retval.resize(n_w);
+        for (auto &w : retval) {
+            gen(w);
+        }
+    } else {
+        pagmo_throw(std::invalid_argument, "Weight generation method " + weight_generation
+                                               + " is unknown. One of 'grid', 'random', 'low discrepancy', "
+                                                 "'two layers' or 'uniform design' was expected");
+    }
+    return retval;
+}
+
+#endif
+
 } // namespace pagmo
 #endif
@@ -59,6 +59,8 @@ class thread_safety(object):
     none = core._thread_safety.none
     #: Basic thread safety: concurrent operations on distinct instances are safe
     basic = core._thread_safety.basic
+    #: Constant thread safety: concurrent const operations on the same instance are safe
+    constant = core._thread_safety.constant
 
 
 # Override of the population constructor.
@@ -57,6 +57,7 @@ class problem_test_case(_ut.TestCase):
         self.run_nf_tests()
         self.run_ctol_tests()
         self.run_evals_tests()
+        self.run_batch_fitness_tests()
         self.run_has_gradient_tests()
         self.run_gradient_tests()
         self.run_has_gradient_sparsity_tests()
@@ -390,6 +391,44 @@ class problem_test_case(_ut.TestCase):
         prob.hessians([1, 2])
         self.assertEqual(prob.get_hevals(), 1)
 
+    def run_batch_fitness_tests(self):
+        from .core import problem, rosenbrock, zdt
+        from numpy import array, zeros, random
+
+        class p(object):
+
+            def get_nobj(self):
+                return 2
+
+            def get_bounds(self):
+                return ([0, 0], [1, 1])
+
+            def fitness(self, a):
+                return [a[0] + a[1], a[0] - a[1]]
+
+        # Python UDPs and C++ UDPs (evaluated in parallel).
+        for prob, nx in [(problem(p()), 2), (problem(rosenbrock(5)), 5), (problem(zdt(1, 10)), 10)]:
+            dvs = random.uniform(0, 1, (23, nx))
+            for n_threads in [0, 1, 3]:
+                fevals = prob.get_fevals()
+                fs = prob.batch_fitness(dvs, n_threads)
+                self.assertEqual(fs.shape, (23, prob.get_nf()))
+                self.assertEqual(prob.get_fevals(), fevals + 23)
+                for dv, f in zip(dvs, fs):
+                    self.assertTrue(all(f == prob.fitness(dv)))
+            # Lists, integer arrays, non-contiguous arrays and empty batches.
+            self.assertTrue(all(prob.batch_fitness(dvs.tolist()).flatten(
+            ) == prob.batch_fitness(dvs).flatten()))
+            self.assertTrue(all(prob.batch_fitness(zeros((2, nx), dtype=int)).flatten(
+            ) == prob.batch_fitness(zeros((2, nx))).flatten()))
+            self.assertTrue(all(prob.batch_fitness(dvs[::2]).flatten(
+            ) == prob.batch_fitness(array(dvs[::2])).flatten()))
+            self.assertEqual(prob.batch_fitness(zeros((0, nx))).shape, (0, prob.get_nf()))
+            # Invalid batches.
+            self.assertRaises(ValueError, lambda: prob.batch_fitness(zeros((2, nx + 1))))
+            self.assertRaises(ValueError, lambda: prob.batch_fitness(zeros(nx)))
+            self.assertRaises(ValueError, lambda: prob.batch_fitness(zeros((2, nx, 1))))
+
     def run_nx_tests(self):
         from .core import problem
 
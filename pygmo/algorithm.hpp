@@ -79,6 +79,11 @@ struct algo_inner<bp::object> final : algo_inner_base, pygmo::common_base {
     {
         return bp::extract<population>(m_value.attr("evolve")(pop));
     }
+    virtual population evolve(population &&pop) const override final
+    {
+        // The population is handed over to Python by copy in any case.
+        return evolve(static_cast<const population &>(pop));
+    }
     // Optional methods.
     virtual void set_seed(unsigned n) override final
     {
@@ -335,6 +335,64 @@ inline std::vector<pagmo::vector_double> to_vvd(const bp::object &o)
                                      .c_str());
 }
 
+// Convert an arbitrary Python object to a 2D C-style contiguous NumPy array of doubles. No copy is made if
+// the object is already such an array. The returned object owns a reference to the array, so that its data
+// can be accessed directly (also with the GIL released, as long as the returned object is alive).
+inline bp::object to_a2d(const bp::object &o)
+{
+    auto n = PyArray_FROM_OTF(o.ptr(), NPY_DOUBLE, NPY_ARRAY_IN_ARRAY);
+    if (!n) {
+        bp::throw_error_already_set();
+    }
+    bp::object retval{bp::handle<>(n)};
+    if (PyArray_NDIM((PyArrayObject *)(n)) != 2) {
+        pygmo_throw(PyExc_ValueError, ("cannot convert the object to a 2D array of doubles: "
+                                       "the array must be 2-dimensional, but the dimension is "
+                                       + std::to_string(PyArray_NDIM((PyArrayObject *)(n))) + " instead")
+                                          .c_str());
+    }
+    return retval;
+}
+
+// Convert a vector of arithmetic types, containing the rows of a matrix one after the other, into a
+// 2D numpy array.
+template <typename T, v_to_a_enabler<T> = 0>
+inline bp::object v_to_a2d(const std::vector<T> &v, typename std::vector<T>::size_type nrows,
+                           typename std::vector<T>::size_type ncols)
+{
+    if (v.size() != nrows * ncols) {
+        pygmo_throw(PyExc_ValueError, ("cannot convert a vector of size " + std::to_string(v.size())
+                                       + " to a NumPy 2D array with " + std::to_string(nrows) + " rows and "
+                                       + std::to_string(ncols) + " columns")
+                                          .c_str());
+    }
+    npy_intp dims[] = {boost::numeric_cast<npy_intp>(nrows), boost::numeric_cast<npy_intp>(ncols)};
+    PyObject *ret = PyArray_SimpleNew(2, dims, cpp_npy<T>::value);
+    if (!ret) {
+        pygmo_throw(PyExc_RuntimeError, "couldn't create a NumPy array: the 'PyArray_SimpleNew()' function failed");
+    }
+    bp::object retval{bp::handle<>(ret)};
+    if (v.size()) {
+        std::copy(v.begin(), v.end(), static_cast<T *>(PyArray_DATA((PyArrayObject *)(ret))));
+    }
+    return retval;
+}
+
+// RAII helper to release the GIL in the current scope, so that other Python threads can run while
+// a long computation is performed in C++. No Python object may be accessed while the GIL is released.
+struct gil_releaser {
+    gil_releaser() : m_thread_state(PyEval_SaveThread())
+    {
+    }
+    ~gil_releaser()
+    {
+        PyEval_RestoreThread(m_thread_state);
+    }
+    gil_releaser(const gil_releaser &) = delete;
+    gil_releaser &operator=(const gil_releaser &) = delete;
+    PyThreadState *m_thread_state;
+};
+
 // Convert a numpy array to an std::vector<unsigned>.
 inline std::vector<unsigned> a_to_vu(PyArrayObject *o)
 {
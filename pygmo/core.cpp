@@ -79,6 +79,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/algorithms/sade.hpp>
 #include <pagmo/algorithms/sea.hpp>
 #include <pagmo/algorithms/simulated_annealing.hpp>
+#include <pagmo/batch_fitness.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/ackley.hpp>
@@ -104,6 +105,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/utils/hv_algos/hv_hv3d.hpp>
 #include <pagmo/utils/hv_algos/hv_hvwfg.hpp>
 #include <pagmo/utils/hypervolume.hpp>
+#include <pagmo/utils/multi_objective.hpp>
 
 #include "algorithm.hpp"
 #include "algorithm_exposition_suite.hpp"
@@ -256,6 +258,107 @@ static inline bp::list de1220_allowed_variants()
     return retval;
 }
 
+// Batch fitness evaluation of the rows of a 2D array.
+static inline bp::object problem_batch_fitness(const problem &p, const bp::object &dvs, unsigned n_threads)
+{
+    const auto arr = pygmo::to_a2d(dvs);
+    const auto a = (PyArrayObject *)(arr.ptr());
+    const auto nx = p.get_nx();
+    if (boost::numeric_cast<vector_double::size_type>(PyArray_SHAPE(a)[1]) != nx) {
+        pygmo_throw(PyExc_ValueError, ("the decision vectors passed to batch_fitness() must have a length of "
+                                       + std::to_string(nx) + ", but they have a length of "
+                                       + std::to_string(PyArray_SHAPE(a)[1]) + " instead")
+                                          .c_str());
+    }
+    const auto n = boost::numeric_cast<vector_double::size_type>(PyArray_SHAPE(a)[0]);
+    // The decision vectors are read in place from the array, which is kept alive by arr.
+    const auto xs = static_cast<const double *>(PyArray_DATA(a));
+    vector_double fs;
+    if (p.get_thread_safety() >= thread_safety::basic) {
+        // The UDP does not call into Python: let other Python threads run while the batch is evaluated
+        // (in parallel). The evaluations are done on a copy of the problem, made while the GIL is held, as
+        // other Python threads might use or modify p in the meantime. The evaluations are then credited to p,
+        // also if one of them throws.
+        const problem p_copy(p);
+        const auto fevals0 = p_copy.get_fevals();
+        try {
+            pygmo::gil_releaser gr;
+            fs = batch_fitness(p_copy, xs, n * nx, n_threads);
+        } catch (...) {
+            detail::problem_counters::increment_fevals(p, p_copy.get_fevals() - fevals0);
+            throw;
+        }
+        detail::problem_counters::increment_fevals(p, p_copy.get_fevals() - fevals0);
+    } else {
+        // The UDP might be implemented in Python, the evaluations are done one after the other with the GIL held.
+        fs = batch_fitness(p, xs, n * nx, 1u);
+    }
+    return pygmo::v_to_a2d(fs, n, p.get_nf());
+}
+
+// Zero-copy view on the rows of a 2D array returned by pygmo::to_a2d(). The array must outlive the view.
+static inline flat_points_view a2d_points_view(const bp::object &arr)
+{
+    const auto a = (PyArrayObject *)(arr.ptr());
+    return flat_points_view(static_cast<const double *>(PyArray_DATA(a)),
+                            boost::numeric_cast<vector_double::size_type>(PyArray_SHAPE(a)[0]),
+                            boost::numeric_cast<vector_double::size_type>(PyArray_SHAPE(a)[1]));
+}
+
+// Convert a vector of index vectors into a flat NumPy array of indices and a NumPy array of offsets:
+// the i-th vector is stored in [offsets[i], offsets[i + 1]).
+static inline bp::tuple vvs_to_flat(const std::vector<std::vector<vector_double::size_type>> &v)
+{
+    std::vector<vector_double::size_type> indices, offsets{0u};
+    for (const auto &item : v) {
+        indices.insert(indices.end(), item.begin(), item.end());
+        offsets.push_back(indices.size());
+    }
+    return bp::make_tuple(pygmo::v_to_a(indices), pygmo::v_to_a(offsets));
+}
+
+// Fast non dominated sorting of the rows of a 2D array.
+static inline bp::tuple fast_non_dominated_sorting_wrapper(const bp::object &x, bool flat)
+{
+    const auto arr = pygmo::to_a2d(x);
+    const auto view = a2d_points_view(arr);
+    fnds_return_type fnds;
+    {
+        pygmo::gil_releaser gr;
+        fnds = fast_non_dominated_sorting(view);
+    }
+    if (flat) {
+        return bp::make_tuple(vvs_to_flat(std::get<0>(fnds)), vvs_to_flat(std::get<1>(fnds)),
+                              pygmo::v_to_a(std::get<2>(fnds)), pygmo::v_to_a(std::get<3>(fnds)));
+    }
+    // the non-dominated fronts
+    bp::list ndf_py;
+    for (const auto &front : std::get<0>(fnds)) {
+        ndf_py.append(pygmo::v_to_a(front));
+    }
+    // the domination list
+    bp::list dl_py;
+    for (const auto &item : std::get<1>(fnds)) {
+        dl_py.append(pygmo::v_to_a(item));
+    }
+    return bp::make_tuple(ndf_py, dl_py, pygmo::v_to_a(std::get<2>(fnds)), pygmo::v_to_a(std::get<3>(fnds)));
+}
+
+// Expose a multi-objective utility taking a set of points (and possibly other arguments), computing it on a
+// view of the input 2D array with the GIL released.
+template <typename F, typename... Args>
+static inline bp::object mo_utility_wrapper(const F &f, const bp::object &points, const Args &... args)
+{
+    const auto arr = pygmo::to_a2d(points);
+    const auto view = a2d_points_view(arr);
+    decltype(f(view, args...)) retval;
+    {
+        pygmo::gil_releaser gr;
+        retval = f(view, args...);
+    }
+    return pygmo::v_to_a(retval);
+}
+
 // Helper function to test the to_vd functionality.
 static inline bool test_to_vd(const bp::object &o, unsigned n)
 {
@@ -380,8 +483,16 @@ BOOST_PYTHON_MODULE(core)
     }
     wrap_import_array();
 
+#if PY_MAJOR_VERSION < 3 || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION < 7)
+    // Make sure the GIL has been created, as some functions release it (see pygmo::gil_releaser).
+    PyEval_InitThreads();
+#endif
+
     // The thread_safety enum.
-    bp::enum_<thread_safety>("_thread_safety").value("none", thread_safety::none).value("basic", thread_safety::basic);
+    bp::enum_<thread_safety>("_thread_safety")
+        .value("none", thread_safety::none)
+        .value("basic", thread_safety::basic)
+        .value("constant", thread_safety::constant);
 
     // Expose utility functions for testing purposes.
     bp::def("_builtin", &pygmo::builtin);
@@ -491,6 +602,8 @@ BOOST_PYTHON_MODULE(core)
         .def("fitness",
              +[](const pagmo::problem &p, const bp::object &dv) { return pygmo::v_to_a(p.fitness(pygmo::to_vd(dv))); },
              pygmo::problem_fitness_docstring().c_str(), (bp::arg("dv")))
+        .def("batch_fitness", &problem_batch_fitness, pygmo::problem_batch_fitness_docstring().c_str(),
+             (bp::arg("dvs"), bp::arg("n_threads") = 0u))
         .def("get_bounds",
              +[](const pagmo::problem &p) -> bp::tuple {
                  auto retval = p.get_bounds();
@@ -565,7 +678,8 @@ BOOST_PYTHON_MODULE(core)
         // Algorithm extraction.
         .def("_py_extract", &pygmo::generic_py_extract<algorithm>)
         // Algorithm methods.
-        .def("evolve", &algorithm::evolve, pygmo::algorithm_evolve_docstring().c_str(), (bp::arg("pop")))
+        .def("evolve", static_cast<population (algorithm::*)(const population &) const>(&algorithm::evolve),
+             pygmo::algorithm_evolve_docstring().c_str(), (bp::arg("pop")))
         .def("set_seed", &algorithm::set_seed, pygmo::algorithm_set_seed_docstring().c_str(), (bp::arg("seed")))
         .def("has_set_seed", &algorithm::has_set_seed, pygmo::algorithm_has_set_seed_docstring().c_str())
         .def("set_verbosity", &algorithm::set_verbosity, pygmo::algorithm_set_verbosity_docstring().c_str(),
@@ -882,10 +996,18 @@ BOOST_PYTHON_MODULE(core)
 
     // Exposition of various structured utilities
     // Hypervolume class
+    // NOTE: the queries are computed with the GIL released, as they might take a long time. They work on copies of
+    // the hypervolume object and of the algorithm, which other Python threads might use in the meantime.
     bp::class_<hypervolume>("hypervolume", "Hypervolume Class")
         .def("__init__", bp::make_constructor(
                              +[](const bp::object &points) {
-                                 auto vvd_points = pygmo::to_vvd(points);
+                                 const auto arr = pygmo::to_a2d(points);
+                                 const auto view = a2d_points_view(arr);
+                                 std::vector<vector_double> vvd_points;
+                                 vvd_points.reserve(view.size());
+                                 for (decltype(view.size()) i = 0u; i < view.size(); ++i) {
+                                     vvd_points.emplace_back(view[i], view[i] + view.dim());
+                                 }
                                  return ::new hypervolume(vvd_points, true);
                              },
                              bp::default_call_policies(), (bp::arg("points"))),
@@ -894,50 +1016,97 @@ BOOST_PYTHON_MODULE(core)
                                               bp::default_call_policies(), (bp::arg("pop"))),
              pygmo::hv_init1_docstring().c_str())
         .def("compute",
-             +[](const hypervolume &hv, const bp::object &r_point) { return hv.compute(pygmo::to_vd(r_point)); },
+             +[](const hypervolume &hv, const bp::object &r_point) {
+                 const auto r = pygmo::to_vd(r_point);
+                 const hypervolume hv_copy(hv);
+                 pygmo::gil_releaser gr;
+                 return hv_copy.compute(r);
+             },
              (bp::arg("ref_point")))
         .def("compute",
              +[](const hypervolume &hv, const bp::object &r_point, boost::shared_ptr<hv_algorithm> hv_algo) {
-                 return hv.compute(pygmo::to_vd(r_point), *hv_algo);
+                 const auto r = pygmo::to_vd(r_point);
+                 const hypervolume hv_copy(hv);
+                 const auto algo_copy = hv_algo->clone();
+                 pygmo::gil_releaser gr;
+                 return hv_copy.compute(r, *algo_copy);
              },
              pygmo::hv_compute_docstring().c_str(), (bp::arg("ref_point"), bp::arg("hv_algo")))
-        .def("exclusive", +[](const hypervolume &hv, unsigned p_idx,
-                              const bp::object &r_point) { return hv.exclusive(p_idx, pygmo::to_vd(r_point)); },
+        .def("exclusive",
+             +[](const hypervolume &hv, unsigned p_idx, const bp::object &r_point) {
+                 const auto r = pygmo::to_vd(r_point);
+                 const hypervolume hv_copy(hv);
+                 pygmo::gil_releaser gr;
+                 return hv_copy.exclusive(p_idx, r);
+             },
              (bp::arg("idx"), bp::arg("ref_point")))
         .def("exclusive",
              +[](const hypervolume &hv, unsigned int p_idx, const bp::object &r_point,
                  boost::shared_ptr<hv_algorithm> hv_algo) {
-                 return hv.exclusive(p_idx, pygmo::to_vd(r_point), *hv_algo);
+                 const auto r = pygmo::to_vd(r_point);
+                 const hypervolume hv_copy(hv);
+                 const auto algo_copy = hv_algo->clone();
+                 pygmo::gil_releaser gr;
+                 return hv_copy.exclusive(p_idx, r, *algo_copy);
              },
              pygmo::hv_exclusive_docstring().c_str(), (bp::arg("idx"), bp::arg("ref_point"), bp::arg("hv_algo")))
         .def("least_contributor",
              +[](const hypervolume &hv, const bp::object &r_point) {
-                 return hv.least_contributor(pygmo::to_vd(r_point));
+                 const auto r = pygmo::to_vd(r_point);
+                 const hypervolume hv_copy(hv);
+                 pygmo::gil_releaser gr;
+                 return hv_copy.least_contributor(r);
              },
              (bp::arg("ref_point")))
         .def("least_contributor",
              +[](const hypervolume &hv, const bp::object &r_point, boost::shared_ptr<hv_algorithm> hv_algo) {
-                 return hv.least_contributor(pygmo::to_vd(r_point), *hv_algo);
+                 const auto r = pygmo::to_vd(r_point);
+                 const hypervolume hv_copy(hv);
+                 const auto algo_copy = hv_algo->clone();
+                 pygmo::gil_releaser gr;
+                 return hv_copy.least_contributor(r, *algo_copy);
              },
              pygmo::hv_least_contributor_docstring().c_str(), (bp::arg("ref_point"), bp::arg("hv_algo")))
         .def("greatest_contributor",
              +[](const hypervolume &hv, const bp::object &r_point) {
-                 return hv.greatest_contributor(pygmo::to_vd(r_point));
+                 const auto r = pygmo::to_vd(r_point);
+                 const hypervolume hv_copy(hv);
+                 pygmo::gil_releaser gr;
+                 return hv_copy.greatest_contributor(r);
              },
              (bp::arg("ref_point")))
         .def("greatest_contributor",
              +[](const hypervolume &hv, const bp::object &r_point, boost::shared_ptr<hv_algorithm> hv_algo) {
-                 return hv.greatest_contributor(pygmo::to_vd(r_point), *hv_algo);
+                 const auto r = pygmo::to_vd(r_point);
+                 const hypervolume hv_copy(hv);
+                 const auto algo_copy = hv_algo->clone();
+                 pygmo::gil_releaser gr;
+                 return hv_copy.greatest_contributor(r, *algo_copy);
              },
              pygmo::hv_greatest_contributor_docstring().c_str(), (bp::arg("ref_point"), bp::arg("hv_algo")))
         .def("contributions",
              +[](const hypervolume &hv, const bp::object &r_point) {
-                 return pygmo::v_to_a(hv.contributions(pygmo::to_vd(r_point)));
+                 const auto r = pygmo::to_vd(r_point);
+                 const hypervolume hv_copy(hv);
+                 vector_double retval;
+                 {
+                     pygmo::gil_releaser gr;
+                     retval = hv_copy.contributions(r);
+                 }
+                 return pygmo::v_to_a(retval);
              },
              (bp::arg("ref_point")))
         .def("contributions",
              +[](const hypervolume &hv, const bp::object &r_point, boost::shared_ptr<hv_algorithm> hv_algo) {
-                 return pygmo::v_to_a(hv.contributions(pygmo::to_vd(r_point), *hv_algo));
+                 const auto r = pygmo::to_vd(r_point);
+                 const hypervolume hv_copy(hv);
+                 const auto algo_copy = hv_algo->clone();
+                 vector_double retval;
+                 {
+                     pygmo::gil_releaser gr;
+                     retval = hv_copy.contributions(r, *algo_copy);
+                 }
+                 return pygmo::v_to_a(retval);
              },
              pygmo::hv_contributions_docstring().c_str(), (bp::arg("ref_point"), bp::arg("hv_algo")))
         .add_property("copy_points", &hypervolume::get_copy_points, &hypervolume::set_copy_points)
@@ -966,27 +1135,39 @@ BOOST_PYTHON_MODULE(core)
 
     // Exposition of stand alone functions
     // Multi-objective utilities
-    bp::def("fast_non_dominated_sorting",
-            +[](const bp::object &x) -> bp::object {
-                auto fnds = fast_non_dominated_sorting(pygmo::to_vvd(x));
-                // the non-dominated fronts
-                auto ndf = std::get<0>(fnds);
-                bp::list ndf_py;
-                for (const std::vector<vector_double::size_type> &front : ndf) {
-                    ndf_py.append(pygmo::v_to_a(front));
-                }
-                // the domination list
-                auto dl = std::get<1>(fnds);
-                bp::list dl_py;
-                for (const auto &item : dl) {
-                    dl_py.append(pygmo::v_to_a(item));
-                }
-                return bp::make_tuple(ndf_py, dl_py, pygmo::v_to_a(std::get<2>(fnds)),
-                                      pygmo::v_to_a(std::get<3>(fnds)));
+    bp::def("fast_non_dominated_sorting", &fast_non_dominated_sorting_wrapper,
+            pygmo::fast_non_dominated_sorting_docstring().c_str(), (bp::arg("points"), bp::arg("flat") = false));
+    bp::def("non_dominated_front_2d",
+            +[](const bp::object &p) {
+                return mo_utility_wrapper(
+                    [](const flat_points_view &v) { return pagmo::non_dominated_front_2d(v); }, p);
+            },
+            pygmo::non_dominated_front_2d_docstring().c_str(), bp::arg("points"));
+    bp::def("crowding_distance",
+            +[](const bp::object &p) {
+                return mo_utility_wrapper([](const flat_points_view &v) { return pagmo::crowding_distance(v); }, p);
+            },
+            pygmo::crowding_distance_docstring().c_str(), bp::arg("points"));
+    bp::def("sort_population_mo",
+            +[](const bp::object &p) {
+                return mo_utility_wrapper([](const flat_points_view &v) { return pagmo::sort_population_mo(v); }, p);
+            },
+            pygmo::sort_population_mo_docstring().c_str(), bp::arg("points"));
+    bp::def("select_best_N_mo",
+            +[](const bp::object &p, vector_double::size_type N) {
+                return mo_utility_wrapper(
+                    [](const flat_points_view &v, vector_double::size_type n) { return pagmo::select_best_N_mo(v, n); },
+                    p, N);
+            },
+            pygmo::select_best_N_mo_docstring().c_str(), (bp::arg("points"), bp::arg("N")));
+    bp::def("nadir",
+            +[](const bp::object &p) {
+                return mo_utility_wrapper([](const flat_points_view &v) { return pagmo::nadir(v); }, p);
             },
-            pygmo::fast_non_dominated_sorting_docstring().c_str(), boost::python::arg("points"));
-    bp::def("nadir", +[](const bp::object &p) { return pygmo::v_to_a(pagmo::nadir(pygmo::to_vvd(p))); },
             pygmo::nadir_docstring().c_str(), bp::arg("points"));
-    bp::def("ideal", +[](const bp::object &p) { return pygmo::v_to_a(pagmo::ideal(pygmo::to_vvd(p))); },
+    bp::def("ideal",
+            +[](const bp::object &p) {
+                return mo_utility_wrapper([](const flat_points_view &v) { return pagmo::ideal(v); }, p);
+            },
             pygmo::ideal_docstring().c_str(), bp::arg("points"));
 }
@@ -459,6 +459,44 @@ Raises:
 )";
 }
 
+std::string problem_batch_fitness_docstring()
+{
+    return R"(batch_fitness(dvs, n_threads = 0)
+
+Batch fitness.
+
+This method will compute the fitness of the decision vectors stored in the rows of the 2D array *dvs*, with
+the same sanity checks as :func:`~pygmo.core.problem.fitness()`. It is equivalent to calling
+:func:`~pygmo.core.problem.fitness()` on each row of *dvs*, but the whole batch is evaluated in a single call,
+which avoids the per-call overhead of the Python interface.
+
+If the UDP provides at least the :attr:`~pygmo.thread_safety.basic` thread safety guarantee (e.g., the C++ UDPs
+exposed by pygmo, see :func:`~pygmo.core.problem.get_thread_safety()`), the GIL is released and the batch is
+evaluated in parallel, using up to *n_threads* threads. Otherwise (e.g., for UDPs implemented in Python), the
+rows are evaluated one after the other in the calling thread.
+
+The internal fitness evaluation counter (see :func:`~pygmo.core.problem.get_fevals()`) is increased by the number
+of rows of *dvs*.
+
+Args:
+    dvs (2D array-like object): the decision vectors to be evaluated, one per row
+    n_threads (``int``): the maximum number of threads used for the evaluation (if zero, the number of threads
+      supported by the hardware)
+
+Returns:
+    2D NumPy float array: the fitness vectors of the rows of *dvs*, one per row
+
+Raises:
+    ValueError: if *dvs* is not a 2D array, if the number of its columns differs from the value returned by
+      :func:`~pygmo.core.problem.get_nx()`, or if the length of a returned fitness vector differs from the value
+      returned by :func:`~pygmo.core.problem.get_nf()`
+    OverflowError: if *n_threads* is negative or too large
+    unspecified: any exception thrown by the ``fitness()`` method of the UDP, or by failures at the intersection
+      between C++ and Python (e.g., type conversion errors, mismatched function signatures, etc.)
+
+)";
+}
+
 std::string problem_get_bounds_docstring()
 {
     return R"(get_bounds()
@@ -1980,7 +2018,7 @@ Multi Objective Evolutionary Algorithms by Decomposition (the DE variant)
 
 Args:
     gen (``int``): number of generations
-    weight_generation (``str``): method used to generate the weights, one of "grid", "low discrepancy" or "random"
+    weight_generation (``str``): method used to generate the weights, one of "grid", "low discrepancy", "random", "two layers" or "uniform design"
     decomposition (``str``): method used to decompose the objectives, one of "tchebycheff", "weighted" or "bi"
     neighbours (``int``): size of the weight's neighborhood
     CR (``float``): crossover parameter in the Differential Evolution operator
@@ -1996,7 +2034,7 @@ Raises:
     ValueError: if either:
     
       * *decomposition* is not one of 'tchebycheff', 'weighted' or 'bi'.
-      * *weight_generation* is not one of 'random', 'low discrepancy' or 'grid'.
+      * *weight_generation* is not one of 'random', 'low discrepancy', 'grid', 'two layers' or 'uniform design'.
       * *CR* or *F* or *realb* are not in [0.,1.] 
       * *eta_m* is negative
 
@@ -2526,25 +2564,140 @@ Raises:
 
 std::string fast_non_dominated_sorting_docstring()
 {
-    return R"(fast_non_dominated_sorting(points)
+    return R"(fast_non_dominated_sorting(points, flat = False)
 
 Runs the fast non dominated sorting algorithm on the input *points*
 
+The points are read in place if *points* is a C-contiguous 2D NumPy float array (otherwise, they are converted to one),
+and the computation runs with the GIL released.
+
 Args:
     points (2d-array like object): the input points
+    flat (``bool``): if ``True``, the non dominated fronts and the domination list are returned as flat arrays
+      (see below)
 
 Raises:
-    ValueError: if *points* is malformed
-    TypeError: if *points* cannot be converted to a vector of vector floats
+    ValueError: if *points* is malformed or cannot be converted to a 2D NumPy float array
 
 Returns:
     ``tuple``: (*ndf*, *dl*, *dc*, *ndr*), where:
 
-    * *ndf* (``list`` of 1D NumPy float array): the non dominated fronts
-    * *dl* (``list`` of 1D NumPy float array): the domination list
+    * *ndf* (``list`` of 1D NumPy int array): the non dominated fronts
+    * *dl* (``list`` of 1D NumPy int array): the domination list
     * *dc* (1D NumPy int array): the domination count
     * *ndr* (1D NumPy int array): the non domination ranks
 
+    If *flat* is ``True``, *ndf* and *dl* are instead pairs (*indices*, *offsets*) of 1D NumPy int arrays: the i-th
+    front (resp. the list of the points dominated by the i-th point) is ``indices[offsets[i]:offsets[i + 1]]``. This
+    avoids the creation of one array per front and per point, which is expensive for large sets of points.
+
+Examples:
+    >>> import pygmo as pg
+    >>> ndf, dl, dc, ndr = pg.fast_non_dominated_sorting([[0, 1], [1, 0], [1, 1], [2, 2]])
+    >>> ndf # doctest: +SKIP
+    [array([0, 1], dtype=uint64), array([2], dtype=uint64), array([3], dtype=uint64)]
+    >>> (idx, off), _, _, _ = pg.fast_non_dominated_sorting([[0, 1], [1, 0], [1, 1], [2, 2]], flat = True)
+    >>> idx[off[0]:off[1]] # doctest: +SKIP
+    array([0, 1], dtype=uint64)
+
+)";
+}
+
+std::string non_dominated_front_2d_docstring()
+{
+    return R"(non_dominated_front_2d(points)
+
+Finds the non dominated front of a set of two dimensional objectives (Kung's algorithm), in
+:math:`\mathcal{O}(N \log N)`.
+
+The points are read in place if *points* is a C-contiguous 2D NumPy float array (otherwise, they are converted to one),
+and the computation runs with the GIL released.
+
+Args:
+    points (2d-array like object): the input points
+
+Raises:
+    ValueError: if *points* is malformed or cannot be converted to a 2D NumPy float array, or if the points do not
+      have two objectives
+
+Returns:
+    1D NumPy int array: the indices of the points in the non dominated front
+
+See also the docs of the C++ function :cpp:func:`pagmo::non_dominated_front_2d()`.
+
+)";
+}
+
+std::string crowding_distance_docstring()
+{
+    return R"(crowding_distance(points)
+
+Computes the crowding distance of a non dominated front.
+
+The points are read in place if *points* is a C-contiguous 2D NumPy float array (otherwise, they are converted to one),
+and the computation runs with the GIL released.
+
+Args:
+    points (2d-array like object): the points of the non dominated front
+
+Raises:
+    ValueError: if *points* is malformed or cannot be converted to a 2D NumPy float array, or if there are fewer
+      than two points or two objectives
+
+Returns:
+    1D NumPy float array: the crowding distances
+
+See also the docs of the C++ function :cpp:func:`pagmo::crowding_distance()`.
+
+)";
+}
+
+std::string sort_population_mo_docstring()
+{
+    return R"(sort_population_mo(points)
+
+Sorts multi-objective points with respect to their non domination rank first, and then their crowding distance.
+
+The points are read in place if *points* is a C-contiguous 2D NumPy float array (otherwise, they are converted to one),
+and the computation runs with the GIL released.
+
+Args:
+    points (2d-array like object): the input points
+
+Raises:
+    ValueError: if *points* is malformed or cannot be converted to a 2D NumPy float array
+
+Returns:
+    1D NumPy int array: the indices of the sorted points
+
+See also the docs of the C++ function :cpp:func:`pagmo::sort_population_mo()`.
+
+)";
+}
+
+std::string select_best_N_mo_docstring()
+{
+    return R"(select_best_N_mo(points, N)
+
+Selects the best *N* multi-objective points, with respect to their non domination rank first, and then their
+crowding distance.
+
+The points are read in place if *points* is a C-contiguous 2D NumPy float array (otherwise, they are converted to one),
+and the computation runs with the GIL released.
+
+Args:
+    points (2d-array like object): the input points
+    N (``int``): the number of points to select
+
+Raises:
+    ValueError: if *points* is malformed or cannot be converted to a 2D NumPy float array, or if *N* is zero
+    OverflowError: if *N* is negative or greater than an implementation-defined value
+
+Returns:
+    1D NumPy int array: the indices of the selected points (not sorted)
+
+See also the docs of the C++ function :cpp:func:`pagmo::select_best_N_mo()`.
+
 )";
 }
 
@@ -2557,12 +2710,14 @@ value of the objective function in the points of the non-dominated front.
 
 Complexity is :math:`\mathcal{O}(MN^2)` where :math:`M` is the number of objectives and :math:`N` is the number of points.
 
+The points are read in place if *points* is a C-contiguous 2D NumPy float array (otherwise, they are converted to one),
+and the computation runs with the GIL released.
+
 Args:
     points (2d-array like object): the input points
 
 Raises:
-    ValueError: if *points* is malformed
-    TypeError: if *points* cannot be converted to a vector of vector floats
+    ValueError: if *points* is malformed or cannot be converted to a 2D NumPy float array
 
 Returns:
     1D NumPy float array: the nadir point
@@ -2579,12 +2734,14 @@ component, the minimum value of the objective functions of the input points.
 
 Complexity is :math:`\mathcal{O}(MN)` where :math:`M` is the number of objectives and :math:`N` is the number of points.
 
+The points are read in place if *points* is a C-contiguous 2D NumPy float array (otherwise, they are converted to one),
+and the computation runs with the GIL released.
+
 Args:
     points (2d-array like object): the input points
 
 Raises:
-    ValueError: if *points* is malformed
-    TypeError: if *points* cannot be converted to a vector of vector floats
+    ValueError: if *points* is malformed or cannot be converted to a 2D NumPy float array
 
 Returns:
     1D NumPy float array: the ideal point
@@ -2747,6 +2904,9 @@ Computes the hypervolume with the supplied algorithm. If no algorithm
 is supplied,  then an exact hypervolume algorithm is automatically selected
 specific for the point dimension.
 
+The computation runs with the GIL released, as do the other queries of the hypervolume
+class, so that other Python threads can run in the meantime.
+
 Args:
     ref_point (2d array-like object): the points
     hv_algo (deriving from :class:`~pygmo.core._hv_algorithm`): hypervolume algorithm to be used
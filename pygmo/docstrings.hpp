@@ -53,6 +53,7 @@ std::string population_problem_docstring();
 std::string problem_docstring();
 std::string problem_get_best_docstring(const std::string &);
 std::string problem_fitness_docstring();
+std::string problem_batch_fitness_docstring();
 std::string problem_get_bounds_docstring();
 std::string problem_get_nec_docstring();
 std::string problem_get_nic_docstring();
@@ -157,6 +158,10 @@ std::string bf_approx_docstring();
 std::string bf_fpras_docstring();
 // stand alone functions
 std::string fast_non_dominated_sorting_docstring();
+std::string non_dominated_front_2d_docstring();
+std::string crowding_distance_docstring();
+std::string sort_population_mo_docstring();
+std::string select_best_N_mo_docstring();
 std::string ideal_docstring();
 std::string nadir_docstring();
 }
@@ -44,6 +44,7 @@ see https://www.gnu.org/licenses/. */
 #include <string>
 #include <utility>
 
+#include <pagmo/eval_context.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/serialization.hpp>
 #include <pagmo/threading.hpp>
@@ -99,6 +100,45 @@ struct prob_inner<bp::object> final : prob_inner_base, pygmo::common_base {
     {
         return pygmo::to_vd(m_value.attr("fitness")(pygmo::v_to_a(dv)));
     }
+    // Multi-fidelity and context-aware fitness evaluations are not supported for Python UDPs: they
+    // behave as C++ UDPs without these methods.
+    virtual vector_double fidelity_fitness(const vector_double &dv, unsigned) const override final
+    {
+        return fitness(dv);
+    }
+    virtual bool has_fidelity() const override final
+    {
+        return false;
+    }
+    virtual vector_double get_fidelity_costs() const override final
+    {
+        return {1.};
+    }
+    virtual vector_double context_fitness(const vector_double &dv, const eval_context &) const override final
+    {
+        return fitness(dv);
+    }
+    virtual bool has_context_fitness() const override final
+    {
+        return false;
+    }
+    virtual bool has_batch_fitness() const override final
+    {
+        return !pygmo::callable_attribute(m_value, "batch_fitness").is_none();
+    }
+    virtual vector_double batch_fitness(const vector_double &dvs) const override final
+    {
+        auto bf = pygmo::callable_attribute(m_value, "batch_fitness");
+        if (bf.is_none()) {
+            pygmo_throw(PyExc_NotImplementedError,
+                        ("the batch fitness has been requested but it is not implemented "
+                         "in the user-defined Python problem '"
+                         + pygmo::str(m_value) + "' of type '" + pygmo::str(pygmo::type(m_value))
+                         + "': the method is either not present or not callable")
+                            .c_str());
+        }
+        return pygmo::to_vd(bf(pygmo::v_to_a(dvs)));
+    }
     virtual std::pair<vector_double, vector_double> get_bounds() const override final
     {
         bp::tuple tup = bp::extract<bp::tuple>(m_value.attr("get_bounds")());
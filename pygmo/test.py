@@ -414,6 +414,61 @@ class hypervolume_test_case(_ut.TestCase):
                          np.array([0.1, 2.1])).all() == True)
 
 
+class mo_utils_test_case(_ut.TestCase):
+    """Test case for the multi-objective utilities
+
+    """
+
+    def runTest(self):
+        from .core import fast_non_dominated_sorting, non_dominated_front_2d, crowding_distance
+        from .core import sort_population_mo, select_best_N_mo, nadir, ideal
+        import numpy as np
+        points = [[0, 1], [1, 0], [1, 1], [2, 2], [0.5, 0.5]]
+        ndf, dl, dc, ndr = fast_non_dominated_sorting(points)
+        self.assertEqual([list(f) for f in ndf], [[0, 1, 4], [2], [3]])
+        self.assertEqual([list(l) for l in dl], [[2, 3], [2, 3], [3], [], [2, 3]])
+        self.assertEqual(list(dc), [0, 0, 3, 4, 0])
+        self.assertEqual(list(ndr), [0, 0, 1, 2, 0])
+        # Flat output.
+        (idx, off), (dl_idx, dl_off), dc2, ndr2 = fast_non_dominated_sorting(
+            points, flat=True)
+        self.assertEqual(list(off), [0, 3, 4, 5])
+        self.assertEqual([list(idx[off[i]:off[i + 1]])
+                          for i in range(len(off) - 1)], [list(f) for f in ndf])
+        self.assertEqual([list(dl_idx[dl_off[i]:dl_off[i + 1]])
+                          for i in range(len(dl_off) - 1)], [list(l) for l in dl])
+        self.assertTrue((dc2 == dc).all())
+        self.assertTrue((ndr2 == ndr).all())
+        # NumPy arrays, also non contiguous or of a different type.
+        arr = np.array(points)
+        self.assertTrue((fast_non_dominated_sorting(arr)[3] == ndr).all())
+        self.assertTrue((fast_non_dominated_sorting(
+            np.asfortranarray(arr))[3] == ndr).all())
+        self.assertTrue((fast_non_dominated_sorting(
+            np.array([[0, 1], [1, 0], [1, 1]], dtype=int))[3] == [0, 0, 1]).all())
+        self.assertRaises(ValueError, lambda: fast_non_dominated_sorting([[0, 1]]))
+        self.assertRaises(ValueError, lambda: fast_non_dominated_sorting([0, 1]))
+        self.assertRaises(
+            ValueError, lambda: fast_non_dominated_sorting([[0, 1], [2]]))
+        self.assertRaises(
+            ValueError, lambda: fast_non_dominated_sorting([["a", "b"]]))
+        # Other utilities.
+        self.assertEqual(sorted(non_dominated_front_2d(points)), [0, 1, 4])
+        self.assertRaises(ValueError, lambda: non_dominated_front_2d(
+            [[0, 1, 2], [1, 0, 2]]))
+        cd = crowding_distance([[0, 1], [1, 0], [0.5, 0.5]])
+        self.assertEqual(cd[0], float("inf"))
+        self.assertEqual(cd[1], float("inf"))
+        self.assertEqual(cd[2], 2.)
+        self.assertRaises(ValueError, lambda: crowding_distance([[0, 1]]))
+        self.assertEqual(list(sort_population_mo(points))[3:], [2, 3])
+        self.assertEqual(sorted(select_best_N_mo(points, 4)), [0, 1, 2, 4])
+        self.assertRaises(ValueError, lambda: select_best_N_mo(points, 0))
+        self.assertTrue((nadir(points) == [1., 1.]).all())
+        self.assertTrue((ideal(points) == [0., 0.]).all())
+        self.assertTrue((ideal(arr[::2]) == [0., .5]).all())
+
+
 class dtlz_test_case(_ut.TestCase):
     """Test case for the UDP dtlz
 
@@ -642,6 +697,7 @@ def run_test_suite():
     suite.addTest(population_test_case())
     suite.addTest(null_problem_test_case())
     suite.addTest(hypervolume_test_case())
+    suite.addTest(mo_utils_test_case())
     try:
         from .core import cmaes
         suite.addTest(cmaes_test_case())
@@ -0,0 +1,80 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+// Serialization support for the UDPs and UDAs shipped with pagmo. Including their headers here registers them
+// (see PAGMO_REGISTER_BUILTIN_PROBLEM and PAGMO_REGISTER_BUILTIN_ALGORITHM).
+
+#define PAGMO_HEADER_REGISTRATIONS
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/bobyqa.hpp>
+#if defined(PAGMO_WITH_EIGEN3)
+#include <pagmo/algorithms/cmaes.hpp>
+#endif
+#include <pagmo/algorithms/compass_search.hpp>
+#include <pagmo/algorithms/de.hpp>
+#include <pagmo/algorithms/de1220.hpp>
+#if defined(PAGMO_WITH_EIGEN3)
+#include <pagmo/algorithms/gpbo.hpp>
+#endif
+#include <pagmo/algorithms/mbh.hpp>
+#include <pagmo/algorithms/moead.hpp>
+#include <pagmo/algorithms/nelder_mead.hpp>
+#include <pagmo/algorithms/nsga2.hpp>
+#include <pagmo/algorithms/pso.hpp>
+#include <pagmo/algorithms/sade.hpp>
+#include <pagmo/algorithms/sea.hpp>
+#include <pagmo/algorithms/simulated_annealing.hpp>
+#include <pagmo/algorithms/subplex.hpp>
+#include <pagmo/algorithms/successive_halving.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/ackley.hpp>
+#include <pagmo/problems/cec2013.hpp>
+#include <pagmo/problems/decompose.hpp>
+#include <pagmo/problems/dtlz.hpp>
+#include <pagmo/problems/external.hpp>
+#include <pagmo/problems/griewank.hpp>
+#include <pagmo/problems/hock_schittkowsky_71.hpp>
+#include <pagmo/problems/inventory.hpp>
+#include <pagmo/problems/rastrigin.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/schwefel.hpp>
+#include <pagmo/problems/translate.hpp>
+#include <pagmo/problems/zdt.hpp>
+
+namespace pagmo
+{
+namespace detail
+{
+
+int builtin_registrations_anchor()
+{
+    return 0;
+}
+}
+}
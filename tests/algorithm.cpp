@@ -38,6 +38,8 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/de.hpp>
+#include <pagmo/algorithms/mbh.hpp>
+#include <pagmo/algorithms/nsga2.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
@@ -314,6 +316,77 @@ BOOST_AUTO_TEST_CASE(algorithm_evolve_test)
     BOOST_CHECK(pop.get_ID() == pop_out.get_ID());
 }
 
+// Counts the copies of the UDP.
+static unsigned n_udp_copies = 0u;
+
+struct counting_udp {
+    counting_udp() = default;
+    explicit counting_udp(unsigned nobj) : m_nobj(nobj)
+    {
+    }
+    counting_udp(const counting_udp &other) : m_nobj(other.m_nobj)
+    {
+        ++n_udp_copies;
+    }
+    counting_udp(counting_udp &&) = default;
+    counting_udp &operator=(const counting_udp &) = default;
+    counting_udp &operator=(counting_udp &&) = default;
+    vector_double fitness(const vector_double &x) const
+    {
+        vector_double retval(m_nobj, 0.);
+        for (decltype(retval.size()) i = 0u; i < retval.size(); ++i) {
+            retval[i] = (x[0] - static_cast<double>(i)) * (x[0] - static_cast<double>(i)) + x[1] * x[1];
+        }
+        return retval;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-1., -1.}, {1., 1.}};
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return m_nobj;
+    }
+    unsigned m_nobj = 1u;
+};
+
+BOOST_AUTO_TEST_CASE(algorithm_evolve_move_test)
+{
+    algorithm algo{de{10u}};
+    population pop{counting_udp{}, 20u, 32u};
+    n_udp_copies = 0u;
+    // Evolving an lvalue copies the population, and thus the UDP.
+    auto pop_out = algo.evolve(pop);
+    BOOST_CHECK_EQUAL(n_udp_copies, 1u);
+    // Evolving an rvalue does not.
+    n_udp_copies = 0u;
+    for (auto i = 0; i < 10; ++i) {
+        pop_out = algo.evolve(std::move(pop_out));
+    }
+    BOOST_CHECK_EQUAL(n_udp_copies, 0u);
+    BOOST_CHECK_EQUAL(pop_out.size(), 20u);
+    BOOST_CHECK(pop_out.get_problem().get_fevals() == 20u + 11u * 10u * 20u);
+    // The same holds for the evolve of the meta-algorithms and of nsga2, which must not copy the
+    // population internally.
+    algo = algorithm{mbh{de{10u}, 5u, 0.1}};
+    pop_out = algo.evolve(std::move(pop_out));
+    BOOST_CHECK_EQUAL(n_udp_copies, 0u);
+    algo = algorithm{nsga2{10u}};
+    population pop_mo{counting_udp{2u}, 20u, 32u};
+    n_udp_copies = 0u;
+    pop_mo = algo.evolve(std::move(pop_mo));
+    BOOST_CHECK_EQUAL(n_udp_copies, 0u);
+    BOOST_CHECK_EQUAL(pop_mo.size(), 20u);
+    // The results are the same as when evolving a copy.
+    population pop1{rosenbrock{5u}, 20u, 32u}, pop2{pop1};
+    algo = algorithm{de{10u, .8, .9, 2u, 1e-6, 1e-6, 32u}};
+    pop1 = algo.evolve(pop1);
+    algo = algorithm{de{10u, .8, .9, 2u, 1e-6, 1e-6, 32u}};
+    pop2 = algo.evolve(std::move(pop2));
+    BOOST_CHECK(pop1.get_x() == pop2.get_x());
+    BOOST_CHECK(pop1.get_f() == pop2.get_f());
+}
+
 BOOST_AUTO_TEST_CASE(algorithm_setters_test)
 {
     algorithm algo{al_01{}};
@@ -0,0 +1,216 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE allocations_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/bobyqa.hpp>
+#if defined(PAGMO_WITH_EIGEN3)
+#include <pagmo/algorithms/cmaes.hpp>
+#include <pagmo/algorithms/gpbo.hpp>
+#endif
+#include <pagmo/algorithms/compass_search.hpp>
+#include <pagmo/algorithms/de.hpp>
+#include <pagmo/algorithms/de1220.hpp>
+#include <pagmo/algorithms/mbh.hpp>
+#include <pagmo/algorithms/moead.hpp>
+#include <pagmo/algorithms/nelder_mead.hpp>
+#include <pagmo/algorithms/nsga2.hpp>
+#include <pagmo/algorithms/pso.hpp>
+#include <pagmo/algorithms/sade.hpp>
+#include <pagmo/algorithms/sea.hpp>
+#include <pagmo/algorithms/simulated_annealing.hpp>
+#include <pagmo/algorithms/subplex.hpp>
+#include <pagmo/algorithms/successive_halving.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/types.hpp>
+
+// This test checks the number of dynamic memory allocations made at each generation by the algorithms, so that
+// regressions (e.g., copies of the bounds or of the population in the main loops) are caught. The global operator
+// new is replaced by one counting the allocations.
+
+static std::atomic<unsigned long long> n_allocs(0u);
+
+void *operator new(std::size_t size)
+{
+    ++n_allocs;
+    if (auto ptr = std::malloc(size ? size : 1u)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+using namespace pagmo;
+
+// A problem whose fitness does not depend on the decision vector: mbh never improves on it.
+struct flat {
+    vector_double fitness(const vector_double &) const
+    {
+        return {1.};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {vector_double(10u, -1.), vector_double(10u, 1.)};
+    }
+};
+
+// A multi-fidelity sphere.
+struct mf_sphere {
+    vector_double fitness(const vector_double &x) const
+    {
+        return fitness(x, 2u);
+    }
+    vector_double fitness(const vector_double &x, unsigned level) const
+    {
+        const double shift = 0.05 * (2u - level);
+        double retval = 0.;
+        for (auto xi : x) {
+            retval += (xi - shift) * (xi - shift);
+        }
+        return {retval};
+    }
+    vector_double get_fidelity_costs() const
+    {
+        return {1., 10., 100.};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {vector_double(10u, -1.), vector_double(10u, 1.)};
+    }
+};
+
+// The allocations made by one generation of an algorithm.
+struct gen_allocs {
+    // Allocations per generation.
+    double allocs;
+    // Fitness evaluations per generation.
+    double fevals;
+};
+
+// Measures the allocations made by the evolution of pop over 2 * n and n generations. The difference
+// removes the setup costs. make_algo(n) must return an algorithm running for n generations, where the
+// meaning of a generation depends on the algorithm.
+inline gen_allocs measure(const std::function<algorithm(unsigned)> &make_algo, const population &pop, unsigned n)
+{
+    unsigned long long allocs[2], fevals[2];
+    for (unsigned i = 0u; i < 2u; ++i) {
+        auto algo = make_algo(n * (i + 1u));
+        population p{pop};
+        const auto fevals0 = p.get_problem().get_fevals();
+        const auto allocs0 = n_allocs.load();
+        p = algo.evolve(std::move(p));
+        allocs[i] = n_allocs.load() - allocs0;
+        fevals[i] = p.get_problem().get_fevals() - fevals0;
+    }
+    return {static_cast<double>(allocs[1] - allocs[0]) / n, static_cast<double>(fevals[1] - fevals[0]) / n};
+}
+
+// Checks that an algorithm makes at most one allocation per fitness evaluation (the fitness vector returned by
+// the UDP), plus at most per_gen allocations per generation.
+inline void check_allocs(const std::string &name, const std::function<algorithm(unsigned)> &make_algo,
+                         const population &pop, unsigned n, double per_gen)
+{
+    const auto res = measure(make_algo, pop, n);
+    BOOST_TEST_MESSAGE(name << ": " << res.allocs << " allocations and " << res.fevals
+                            << " fitness evaluations per generation");
+    BOOST_CHECK_MESSAGE(res.allocs <= res.fevals + per_gen, name + ": too many allocations per generation");
+}
+
+// NOTE: the allowed allocations per generation are the measured ones (beyond the fitness evaluations), rounded up,
+// plus a margin of 4 to account for differences among standard library implementations. If an algorithm is changed
+// so that it allocates less, the corresponding limit should be lowered.
+BOOST_AUTO_TEST_CASE(allocations_local_solvers_test)
+{
+    // A generation is a block of 100 fitness evaluations.
+    const population pop{rosenbrock{10u}, 1u, 32u};
+    check_allocs("bobyqa", [](unsigned n) { return algorithm{bobyqa{100u * n, .1, 1e-15}}; }, pop, 2u, 4.);
+    check_allocs("compass_search", [](unsigned n) { return algorithm{compass_search{100u * n, .1, 1e-15}}; }, pop, 2u,
+                 4.);
+    check_allocs("nelder_mead", [](unsigned n) { return algorithm{nelder_mead{100u * n, .1, 1e-15}}; }, pop, 2u, 4.);
+    check_allocs("subplex", [](unsigned n) { return algorithm{subplex{100u * n, .1, 1e-15}}; }, pop, 2u, 6.);
+    // A generation is a temperature adjustment.
+    check_allocs("simulated_annealing",
+                 [](unsigned n) { return algorithm{simulated_annealing{10., .1, n, 1u, 20u, 1., 32u}}; }, pop, 2u, 4.);
+}
+
+BOOST_AUTO_TEST_CASE(allocations_population_based_test)
+{
+    const population pop{rosenbrock{10u}, 20u, 32u};
+    check_allocs("de", [](unsigned n) { return algorithm{de{n, .8, .9, 2u, 0., 0., 32u}}; }, pop, 10u, 15.);
+    check_allocs("de1220",
+                 [](unsigned n) {
+                     return algorithm{de1220{n, de1220_statics<void>::allowed_variants, 1u, 0., 0., false, 32u}};
+                 },
+                 pop, 10u, 16.);
+    check_allocs("sade", [](unsigned n) { return algorithm{sade{n, 2u, 1u, 0., 0., false, 32u}}; }, pop, 10u, 20.);
+    check_allocs("pso", [](unsigned n) { return algorithm{pso{n, .7298, 2.05, 2.05, .5, 5u, 2u, 4u, false, 32u}}; },
+                 pop, 10u, 24.);
+    check_allocs("sea", [](unsigned n) { return algorithm{sea{n, 32u}}; }, pop, 10u, 8.);
+#if defined(PAGMO_WITH_EIGEN3)
+    check_allocs("cmaes", [](unsigned n) { return algorithm{cmaes{n, -1, -1, -1, -1, .5, 0., 0., false, 32u}}; },
+                 pop, 10u, 46.);
+    check_allocs("gpbo", [](unsigned n) { return algorithm{gpbo{n, 4u, 100u, 5u, 32u}}; }, pop, 5u, 40.);
+#endif
+    const population pop_mo{zdt{1u, 10u}, 20u, 32u};
+    check_allocs("nsga2", [](unsigned n) { return algorithm{nsga2{n, .95, 10., .01, 50., 0u, 32u}}; }, pop_mo, 10u,
+                 175.);
+    check_allocs("moead",
+                 [](unsigned n) {
+                     return algorithm{moead{n, "grid", "tchebycheff", 10u, 1., .5, 20., .9, 2u, true, 32u}};
+                 },
+                 pop_mo, 10u, 37.);
+}
+
+BOOST_AUTO_TEST_CASE(allocations_meta_algorithms_test)
+{
+    // A generation is a call to the inner algorithm. On a flat problem, mbh never improves, so that it calls the
+    // inner algorithm exactly stop times.
+    check_allocs("mbh", [](unsigned n) { return algorithm{mbh{compass_search{100u}, n, .1, 32u}}; },
+                 population{flat{}, 20u, 32u}, 5u, 92.);
+    check_allocs("successive_halving",
+                 [](unsigned n) { return algorithm{successive_halving{de{1u, .8, .9, 2u, 0., 0., 32u}, n, 3u}}; },
+                 population{mf_sphere{}, 20u, 32u}, 5u, 164.);
+}
@@ -0,0 +1,190 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#define BOOST_TEST_MODULE batch_fitness_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <pagmo/batch_fitness.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// Loop calling fitness() on each decision vector.
+static vector_double serial_fitness(const problem &p, const vector_double &xs)
+{
+    vector_double retval;
+    for (decltype(xs.size()) i = 0u; i < xs.size(); i += p.get_nx()) {
+        const auto f = p.fitness(vector_double(xs.begin() + static_cast<vector_double::difference_type>(i),
+                                               xs.begin() + static_cast<vector_double::difference_type>(i + p.get_nx())));
+        retval.insert(retval.end(), f.begin(), f.end());
+    }
+    return retval;
+}
+
+// Random decision vectors of p, concatenated.
+static vector_double random_batch(const problem &p, unsigned n)
+{
+    population pop{p, n, 42u};
+    vector_double retval;
+    for (const auto &x : pop.get_x()) {
+        retval.insert(retval.end(), x.begin(), x.end());
+    }
+    return retval;
+}
+
+BOOST_AUTO_TEST_CASE(batch_fitness_basic_test)
+{
+    for (const problem &p : {problem{rosenbrock{5u}}, problem{zdt{1u, 10u}}}) {
+        const auto xs = random_batch(p, 37u);
+        const auto expected = serial_fitness(p, xs);
+        for (unsigned n_threads : {0u, 1u, 2u, 3u, 100u}) {
+            problem q{p};
+            const auto fevals = q.get_fevals();
+            BOOST_CHECK(batch_fitness(q, xs, n_threads) == expected);
+            BOOST_CHECK_EQUAL(q.get_fevals(), fevals + 37u);
+            // The decision vectors can be read in place from a buffer.
+            BOOST_CHECK(batch_fitness(q, xs.data(), xs.size(), n_threads) == expected);
+            BOOST_CHECK_EQUAL(q.get_fevals(), fevals + 74u);
+        }
+        // Empty batches.
+        BOOST_CHECK(batch_fitness(p, {}).empty());
+        BOOST_CHECK(batch_fitness(p, nullptr, 0u).empty());
+        // Invalid batches.
+        BOOST_CHECK_THROW(batch_fitness(p, vector_double(p.get_nx() + 1u)), std::invalid_argument);
+        BOOST_CHECK_THROW(batch_fitness(p, xs.data(), p.get_nx() + 1u), std::invalid_argument);
+    }
+}
+
+// A problem recording the threads in which it is evaluated.
+static std::atomic<unsigned> n_foreign_evals(0u);
+static std::thread::id main_thread_id;
+
+struct recording_problem {
+    vector_double fitness(const vector_double &x) const
+    {
+        if (std::this_thread::get_id() != main_thread_id) {
+            ++n_foreign_evals;
+        }
+        if (x[0] > .9) {
+            throw std::runtime_error("fitness failure");
+        }
+        return {x[0] + x[1]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0., 0.}, {1., 1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return m_ts;
+    }
+    thread_safety m_ts;
+};
+
+BOOST_AUTO_TEST_CASE(batch_fitness_thread_safety_test)
+{
+    main_thread_id = std::this_thread::get_id();
+    vector_double xs;
+    for (int i = 0; i < 20; ++i) {
+        xs.push_back(i * .04);
+        xs.push_back(1.);
+    }
+    for (auto ts : {thread_safety::none, thread_safety::basic, thread_safety::constant}) {
+        problem p{recording_problem{ts}};
+        n_foreign_evals = 0u;
+        const auto f = batch_fitness(p, xs, 4u);
+        BOOST_CHECK(f == serial_fitness(p, xs));
+        BOOST_CHECK_EQUAL(p.get_fevals(), 40u);
+        // Thread unsafe problems are evaluated in the calling thread only.
+        if (ts == thread_safety::none) {
+            BOOST_CHECK_EQUAL(n_foreign_evals.load(), 0u);
+        } else {
+            BOOST_CHECK(n_foreign_evals.load() > 0u);
+        }
+        // Failing evaluations. The successful evaluations of the other chunks are still counted.
+        xs.push_back(.95);
+        xs.push_back(0.);
+        p = problem{recording_problem{ts}};
+        BOOST_CHECK_THROW(batch_fitness(p, xs, 4u), std::runtime_error);
+        BOOST_CHECK_EQUAL(p.get_fevals(), 20u);
+        xs.resize(xs.size() - 2u);
+    }
+}
+
+// A problem evaluating its batches by itself.
+struct batch_problem {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0] + x[1]};
+    }
+    vector_double batch_fitness(const vector_double &xs) const
+    {
+        ++m_n_batches;
+        vector_double retval;
+        for (decltype(xs.size()) i = 0u; i < xs.size(); i += 2u) {
+            retval.push_back(xs[i] + xs[i + 1u]);
+        }
+        return retval;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0., 0.}, {1., 1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::constant;
+    }
+    mutable unsigned m_n_batches = 0u;
+};
+
+BOOST_AUTO_TEST_CASE(batch_fitness_udp_test)
+{
+    problem p{batch_problem{}};
+    BOOST_CHECK(p.has_batch_fitness());
+    const auto xs = random_batch(p, 11u);
+    const auto expected = serial_fitness(p, xs);
+    // The whole batch is handed over to the UDP, whatever the number of threads.
+    BOOST_CHECK(batch_fitness(p, xs, 4u) == expected);
+    BOOST_CHECK(batch_fitness(p, xs, 1u) == expected);
+    BOOST_CHECK(batch_fitness(p, xs.data(), xs.size()) == expected);
+    BOOST_CHECK_EQUAL(p.extract<batch_problem>()->m_n_batches, 3u);
+    BOOST_CHECK_EQUAL(p.get_fevals(), 44u);
+    BOOST_CHECK_THROW(batch_fitness(p, vector_double(3u)), std::invalid_argument);
+    BOOST_CHECK_THROW(batch_fitness(p, xs.data(), 3u), std::invalid_argument);
+}
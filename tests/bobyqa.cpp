@@ -0,0 +1,228 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE bobyqa_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/bobyqa.hpp>
+#include <pagmo/algorithms/compass_search.hpp>
+#include <pagmo/algorithms/mbh.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problems/hock_schittkowsky_71.hpp>
+#include <pagmo/problems/inventory.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// A smooth, ill-conditioned and rotated quadratic with its minimum (0) at x = 0.5.
+struct ellipsoid {
+    vector_double fitness(const vector_double &x) const
+    {
+        double retval = 0.;
+        for (decltype(x.size()) i = 0u; i < x.size(); ++i) {
+            const auto y = (x[i] - .5) + ((i + 1u < x.size()) ? .5 * (x[i + 1u] - .5) : 0.);
+            retval += std::pow(10., static_cast<double>(i)) * y * y;
+        }
+        return {retval};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {vector_double(5u, -2.), vector_double(5u, 2.)};
+    }
+};
+
+// The unconstrained minimum lies outside the box, at x = (-1, ...).
+struct active_bounds {
+    vector_double fitness(const vector_double &x) const
+    {
+        double retval = 0.;
+        for (auto xi : x) {
+            retval += (xi + 1.) * (xi + 1.);
+        }
+        return {retval};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0., 0., 0.}, {1., 1., 1.}};
+    }
+};
+
+struct unbounded_lb {
+    vector_double fitness(const vector_double &) const
+    {
+        return {0.};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-std::numeric_limits<double>::infinity()}, {0.}};
+    }
+};
+
+BOOST_AUTO_TEST_CASE(bobyqa_algorithm_construction)
+{
+    bobyqa user_algo{100u, 0.1, 0.001};
+    BOOST_CHECK(user_algo.get_verbosity() == 0u);
+    BOOST_CHECK((user_algo.get_log() == bobyqa::log_type{}));
+
+    BOOST_CHECK_THROW((bobyqa{1234u, 0.7}), std::invalid_argument);
+    BOOST_CHECK_THROW((bobyqa{1234u, -0.3}), std::invalid_argument);
+    BOOST_CHECK_THROW((bobyqa{1234u, 0.3, 0.4}), std::invalid_argument);
+    BOOST_CHECK_THROW((bobyqa{1234u, 0.3, 0.}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(bobyqa_evolve_test)
+{
+    double stop_range = 1e-6;
+
+    // Here we only test that evolution is deterministic (stop criteria will be range)
+    problem prob{rosenbrock{4u}};
+    population pop1{prob, 5u, 23u};
+    population pop2{prob, 5u, 23u};
+
+    bobyqa user_algo1{10000u, 0.1, stop_range};
+    user_algo1.set_verbosity(1u);
+    pop1 = user_algo1.evolve(pop1);
+
+    bobyqa user_algo2{10000u, 0.1, stop_range};
+    user_algo2.set_verbosity(1u);
+    pop2 = user_algo2.evolve(pop2);
+
+    BOOST_CHECK(user_algo1.get_log().size() > 0u);
+    BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+    BOOST_CHECK(std::get<2>(user_algo1.get_log().back()) <= stop_range);
+    BOOST_CHECK(pop1.champion_f()[0] < 1e-8);
+
+    // We test the max_fevals stopping criteria
+    auto max_fevals = 20u;
+    bobyqa user_algo3{max_fevals, 0.1, stop_range};
+    population pop3{prob, 5u, 23u};
+    auto f0 = pop3.champion_f()[0];
+    auto fevals0 = pop3.get_problem().get_fevals();
+    pop3 = user_algo3.evolve(pop3);
+    BOOST_CHECK_EQUAL(pop3.get_problem().get_fevals() - fevals0, max_fevals);
+    BOOST_CHECK(pop3.champion_f()[0] <= f0);
+
+    // Active bounds are handled
+    population pop4{problem{active_bounds{}}, 1u, 23u};
+    pop4 = bobyqa{1000u, 0.1, 1e-8}.evolve(pop4);
+    BOOST_CHECK_CLOSE(pop4.champion_f()[0], 3., 1e-8);
+
+    // We then check that the evolve throws if called on unsuitable problems
+    BOOST_CHECK_THROW(bobyqa{10u}.evolve(population{problem{rosenbrock{}}, 0u}), std::invalid_argument);
+    BOOST_CHECK_THROW(bobyqa{10u}.evolve(population{problem{zdt{}}, 15u}), std::invalid_argument);
+    BOOST_CHECK_THROW(bobyqa{10u}.evolve(population{problem{inventory{}}, 15u}), std::invalid_argument);
+    BOOST_CHECK_THROW(bobyqa{10u}.evolve(population{problem{hock_schittkowsky_71{}}, 15u}), std::invalid_argument);
+    BOOST_CHECK_THROW(bobyqa{10u}.evolve(population{problem{unbounded_lb{}}, 15u}), std::invalid_argument);
+    // And a clean exit for 0 generations
+    population pop{rosenbrock{25u}, 10u};
+    BOOST_CHECK(bobyqa{0u}.evolve(pop).get_x()[0] == pop.get_x()[0]);
+}
+
+BOOST_AUTO_TEST_CASE(bobyqa_vs_compass_search_test)
+{
+    // On a smooth problem the quadratic model needs far fewer evaluations than a pattern search
+    problem prob{ellipsoid{}};
+    population pop1{prob, 1u, 32u};
+    population pop2{prob, 1u, 32u};
+    pop1 = bobyqa{100000u, 0.1, 1e-8}.evolve(pop1);
+    pop2 = compass_search{100000u, 0.1, 1e-8, 0.5}.evolve(pop2);
+    BOOST_CHECK(pop1.champion_f()[0] < 1e-10);
+    BOOST_CHECK(pop1.champion_f()[0] <= pop2.champion_f()[0]);
+    BOOST_CHECK(pop1.get_problem().get_fevals() * 5u < pop2.get_problem().get_fevals());
+}
+
+BOOST_AUTO_TEST_CASE(bobyqa_mbh_test)
+{
+    // bobyqa can be used as the local solver of monotonic basin hopping
+    problem prob{rosenbrock{3u}};
+    population pop{prob, 1u, 23u};
+    mbh user_algo{bobyqa{500u, 0.1, 1e-6}, 3u, 0.05, 23u};
+    pop = user_algo.evolve(pop);
+    BOOST_CHECK(pop.champion_f()[0] < 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(bobyqa_setters_getters_test)
+{
+    bobyqa user_algo{10000u, 0.5, 0.1};
+    user_algo.set_verbosity(23u);
+    BOOST_CHECK(user_algo.get_verbosity() == 23u);
+    BOOST_CHECK(user_algo.get_max_fevals() == 10000u);
+    BOOST_CHECK(user_algo.get_start_range() == 0.5);
+    BOOST_CHECK(user_algo.get_stop_range() == 0.1);
+    BOOST_CHECK(user_algo.get_name().find("BOBYQA") != std::string::npos);
+    BOOST_CHECK(user_algo.get_extra_info().find("Stop range") != std::string::npos);
+    BOOST_CHECK_NO_THROW(user_algo.get_log());
+}
+
+BOOST_AUTO_TEST_CASE(bobyqa_serialization_test)
+{
+    // We test the serialization of a pagmo algorithm when constructed with bobyqa
+    // Make one evolution
+    problem prob{rosenbrock{5u}};
+    population pop{prob, 10u, 23u};
+    algorithm algo{bobyqa{1000u, 0.1, 1e-4}};
+    algo.set_verbosity(1u); // allows the log to be filled
+    pop = algo.evolve(pop);
+
+    // Store the string representation of p.
+    std::stringstream ss;
+    auto before_text = boost::lexical_cast<std::string>(algo);
+    auto before_log = algo.extract<bobyqa>()->get_log();
+    // Now serialize, deserialize and compare the result.
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(algo);
+    }
+    // Change the content of p before deserializing.
+    algo = algorithm{null_algorithm{}};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(algo);
+    }
+    auto after_text = boost::lexical_cast<std::string>(algo);
+    auto after_log = algo.extract<bobyqa>()->get_log();
+    BOOST_CHECK_EQUAL(before_text, after_text);
+    BOOST_CHECK(before_log.size() > 0u);
+    for (auto i = 0u; i < before_log.size(); ++i) {
+        BOOST_CHECK_EQUAL(std::get<0>(before_log[i]), std::get<0>(after_log[i]));
+        BOOST_CHECK_CLOSE(std::get<1>(before_log[i]), std::get<1>(after_log[i]), 1e-8);
+        BOOST_CHECK_CLOSE(std::get<2>(before_log[i]), std::get<2>(after_log[i]), 1e-8);
+        BOOST_CHECK_CLOSE(std::get<3>(before_log[i]), std::get<3>(after_log[i]), 1e-8);
+    }
+}
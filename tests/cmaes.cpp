@@ -39,9 +39,11 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/population.hpp>
 #include <pagmo/problems/hock_schittkowsky_71.hpp>
 #include <pagmo/problems/inventory.hpp>
+#include <pagmo/problems/rastrigin.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
 #include <pagmo/problems/zdt.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/threading.hpp>
 #include <pagmo/utils/generic.hpp>
 
 using namespace pagmo;
@@ -250,3 +252,57 @@ BOOST_AUTO_TEST_CASE(cmaes_memory_test)
     BOOST_CHECK_CLOSE(std::get<2>(log[0]), std::get<2>(log2[1]), 1e-8);
     // the 1 and 0 will be different as fevals is reset at each evolve
 }
+
+struct rastrigin_serial : rastrigin {
+    rastrigin_serial(unsigned dim = 1u) : rastrigin(dim)
+    {
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(cmaes_restart_test)
+{
+    cmaes user_algo{10u};
+    BOOST_CHECK(user_algo.get_restart() == "none");
+    BOOST_CHECK_THROW(user_algo.set_restart("lpop"), std::invalid_argument);
+    user_algo.set_restart("bipop", 3u);
+    BOOST_CHECK(user_algo.get_restart() == "bipop");
+    BOOST_CHECK(user_algo.get_extra_info().find("bipop") != std::string::npos);
+
+    // On a multimodal function restarts find better solutions within the same budget
+    // of gen * pop_size fevals, and the evaluations of all restarts are accounted for. The budget
+    // includes the evaluation of the initial populations of the restarts.
+    double best_none = 0., best_ipop = 0., best_bipop = 0.;
+    for (unsigned seed = 1u; seed < 4u; ++seed) {
+        for (const std::string restart : {"none", "ipop", "bipop"}) {
+            cmaes algo{1000u, -1, -1, -1, -1, 0.5, 1e-6, 1e-6, false, seed};
+            algo.set_restart(restart);
+            population pop{problem{rastrigin{5u}}, 10u, seed};
+            pop = algo.evolve(pop);
+            // The first population is evaluated before evolve().
+            BOOST_CHECK(pop.get_problem().get_fevals() <= 1000u * 10u + 10u);
+            (restart == "none" ? best_none : restart == "ipop" ? best_ipop : best_bipop) += pop.champion_f()[0];
+            if (restart != "none") {
+                BOOST_CHECK(algo.get_n_restarts() > 0u);
+            }
+        }
+    }
+    BOOST_CHECK(best_ipop < best_none);
+    BOOST_CHECK(best_bipop < best_none);
+
+    // BIPOP gives the same result whether the small population runs are concurrent or not.
+    cmaes algo1{500u, -1, -1, -1, -1, 0.5, 1e-6, 1e-6, false, 23u};
+    cmaes algo2{500u, -1, -1, -1, -1, 0.5, 1e-6, 1e-6, false, 23u};
+    algo1.set_restart("bipop");
+    algo2.set_restart("bipop");
+    population pop1{problem{rastrigin{5u}}, 10u, 23u};
+    population pop2{problem{rastrigin_serial{5u}}, 10u, 23u};
+    pop1 = algo1.evolve(pop1);
+    pop2 = algo2.evolve(pop2);
+    BOOST_CHECK(pop1.get_f() == pop2.get_f());
+    BOOST_CHECK(pop1.get_problem().get_fevals() == pop2.get_problem().get_fevals());
+    BOOST_CHECK(algo1.get_n_restarts() == algo2.get_n_restarts());
+}
@@ -0,0 +1,192 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE composite_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <atomic>
+#include <boost/lexical_cast.hpp>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/compass_search.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/composite.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+BOOST_AUTO_TEST_CASE(composite_construction_test)
+{
+    composite c0;
+    BOOST_CHECK((c0.get_bounds() == std::pair<vector_double, vector_double>{{0.}, {1.}}));
+    BOOST_CHECK(c0.get_nobj() == 0u);
+    BOOST_CHECK(c0.get_nec() == 0u);
+    BOOST_CHECK(c0.get_nic() == 0u);
+    BOOST_CHECK(c0.get_n_components() == 0u);
+    BOOST_CHECK(c0.get_concurrent());
+    BOOST_CHECK(c0.get_thread_safety() == thread_safety::basic);
+    // A composite with no objectives cannot be used to construct a problem.
+    BOOST_CHECK_THROW(problem{c0}, std::invalid_argument);
+    // Invalid bounds.
+    BOOST_CHECK_THROW((composite{{0., 1.}, {1.}}), std::invalid_argument);
+    BOOST_CHECK_THROW((composite{{2.}, {1.}}), std::invalid_argument);
+    BOOST_CHECK_THROW((composite{{}, {}}), std::invalid_argument);
+    // Invalid components.
+    BOOST_CHECK_THROW(c0.add_objectives(composite::component_function{}), std::invalid_argument);
+    BOOST_CHECK_THROW(c0.add_objectives([](const vector_double &) { return vector_double{0.}; }, 0u),
+                      std::invalid_argument);
+    BOOST_CHECK(c0.get_n_components() == 0u);
+    // Setters.
+    c0.set_concurrent(false);
+    BOOST_CHECK(!c0.get_concurrent());
+    c0.set_thread_safety(thread_safety::constant);
+    BOOST_CHECK(c0.get_thread_safety() == thread_safety::constant);
+}
+
+BOOST_AUTO_TEST_CASE(composite_fitness_test)
+{
+    composite c{{-1., -1.}, {1., 1.}};
+    // Register the components out of order: the fitness vector must still be laid out
+    // as objectives, equality constraints and inequality constraints.
+    c.add_inequality_constraints([](const vector_double &x) { return vector_double{x[0] - 1., x[1] - 1.}; }, 2u,
+                                 "box")
+        .add_objectives([](const vector_double &x) { return vector_double{x[0] * x[0]}; }, 1u, "first")
+        .add_equality_constraints([](const vector_double &x) { return vector_double{x[0] + x[1]}; })
+        .add_objectives([](const vector_double &x) { return vector_double{x[1] * x[1], x[0] * x[1]}; }, 2u);
+    BOOST_CHECK(c.get_nobj() == 3u);
+    BOOST_CHECK(c.get_nec() == 1u);
+    BOOST_CHECK(c.get_nic() == 2u);
+    BOOST_CHECK(c.get_n_components() == 4u);
+    const vector_double x{.5, -.25};
+    const vector_double expected{.25, .0625, -.125, .25, -.5, -1.25};
+    BOOST_CHECK(c.fitness(x) == expected);
+    c.set_concurrent(false);
+    BOOST_CHECK(c.fitness(x) == expected);
+    c.set_concurrent(true);
+    problem p{c};
+    BOOST_CHECK(p.get_nobj() == 3u);
+    BOOST_CHECK(p.get_nec() == 1u);
+    BOOST_CHECK(p.get_nic() == 2u);
+    BOOST_CHECK(p.fitness(x) == expected);
+    BOOST_CHECK(p.get_thread_safety() == thread_safety::basic);
+    // The extra info lists the components in fitness order.
+    const auto info = c.get_extra_info();
+    BOOST_CHECK(info.find("'first': objectives [0, 1)") != std::string::npos);
+    BOOST_CHECK(info.find("component #1: objectives [1, 3)") != std::string::npos);
+    BOOST_CHECK(info.find("component #2: equality constraints [3, 4)") != std::string::npos);
+    BOOST_CHECK(info.find("'box': inequality constraints [4, 6)") != std::string::npos);
+    BOOST_CHECK(boost::lexical_cast<std::string>(p).find("Composite problem") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(composite_error_test)
+{
+    for (auto concurrent : {true, false}) {
+        composite c{{0.}, {1.}};
+        c.set_concurrent(concurrent);
+        c.add_objectives([](const vector_double &) { return vector_double{1.}; });
+        c.add_inequality_constraints([](const vector_double &) { return vector_double{1., 2.}; }, 3u, "wrong");
+        BOOST_CHECK_EXCEPTION(c.fitness({.5}), std::invalid_argument, [](const std::invalid_argument &e) {
+            return std::string(e.what()).find("'wrong'") != std::string::npos
+                   && std::string(e.what()).find("size 2") != std::string::npos;
+        });
+        composite c2{{0.}, {1.}};
+        c2.set_concurrent(concurrent);
+        c2.add_objectives([](const vector_double &) { return vector_double{1.}; });
+        c2.add_equality_constraints([](const vector_double &) -> vector_double { throw std::domain_error("first"); });
+        c2.add_inequality_constraints(
+            [](const vector_double &) -> vector_double { throw std::out_of_range("second"); });
+        // The first failing component, in fitness order, determines the exception.
+        BOOST_CHECK_THROW(c2.fitness({.5}), std::domain_error);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(composite_concurrency_test)
+{
+    // Each component waits until all the others have started: this can succeed only
+    // if the components run at the same time.
+    const unsigned n = 4u;
+    std::atomic<unsigned> started(0u);
+    auto rendezvous = [&started, n](const vector_double &) {
+        ++started;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (started.load() < n && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        return vector_double{started.load() >= n ? 0. : 1.};
+    };
+    composite c{{0.}, {1.}};
+    for (unsigned i = 0u; i < n; ++i) {
+        c.add_objectives(rendezvous);
+    }
+    BOOST_CHECK((c.fitness({.5}) == vector_double(n, 0.)));
+    // The latency of an evaluation is that of the slowest component.
+    composite c2{{0.}, {1.}};
+    auto sleepy = [](const vector_double &) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        return vector_double{0.};
+    };
+    c2.add_objectives(sleepy).add_equality_constraints(sleepy).add_inequality_constraints(sleepy);
+    const auto start = std::chrono::steady_clock::now();
+    c2.fitness({.5});
+    const auto concurrent_time = std::chrono::steady_clock::now() - start;
+    c2.set_concurrent(false);
+    const auto start2 = std::chrono::steady_clock::now();
+    c2.fitness({.5});
+    const auto sequential_time = std::chrono::steady_clock::now() - start2;
+    BOOST_CHECK(sequential_time >= std::chrono::milliseconds(600));
+    BOOST_CHECK(concurrent_time < sequential_time);
+}
+
+BOOST_AUTO_TEST_CASE(composite_evolve_test)
+{
+    composite c{{-5., -5.}, {5., 5.}};
+    c.add_objectives([](const vector_double &x) { return vector_double{(x[0] - 1.) * (x[0] - 1.)}; })
+        .add_objectives([](const vector_double &x) { return vector_double{(x[1] + 2.) * (x[1] + 2.)}; });
+    // Two objective blocks make a multi-objective problem: nest it in a single-objective composite.
+    composite single{{-5., -5.}, {5., 5.}};
+    single.add_objectives([c](const vector_double &x) {
+        const auto f = c.fitness(x);
+        return vector_double{f[0] + f[1]};
+    });
+    problem p{single};
+    population pop{p, 10u, 42u};
+    algorithm algo{compass_search{1000u, .1, 1e-6}};
+    pop = algo.evolve(pop);
+    BOOST_CHECK(pop.champion_f()[0] < 1e-6);
+    BOOST_CHECK(std::abs(pop.champion_x()[0] - 1.) < 1e-3);
+    BOOST_CHECK(std::abs(pop.champion_x()[1] + 2.) < 1e-3);
+}
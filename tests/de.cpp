@@ -43,6 +43,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/problems/rosenbrock.hpp>
 #include <pagmo/problems/zdt.hpp>
 #include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
 #include <pagmo/types.hpp>
 
 using namespace pagmo;
@@ -164,3 +165,53 @@ BOOST_AUTO_TEST_CASE(de_serialization_test)
         BOOST_CHECK_CLOSE(std::get<4>(before_log[i]), std::get<4>(after_log[i]), 1e-8);
     }
 }
+
+// A UDP shared by the copies of a problem, which counts its own copies.
+struct shared_rosenbrock : rosenbrock {
+    shared_rosenbrock() : rosenbrock(10u) {}
+    shared_rosenbrock(const shared_rosenbrock &other) : rosenbrock(other)
+    {
+        ++n_copies;
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::constant;
+    }
+    static unsigned n_copies;
+};
+
+unsigned shared_rosenbrock::n_copies = 0u;
+
+BOOST_AUTO_TEST_CASE(de_static_evolve_test)
+{
+    // The statically typed evolve gives the same results as the type-erased one.
+    for (unsigned variant = 1u; variant <= 10u; ++variant) {
+        population pop{rosenbrock{10u}, 20u, 23u};
+        de algo1{50u, 0.7, 0.5, variant, 1e-6, 1e-6, 23u};
+        de algo2{50u, 0.7, 0.5, variant, 1e-6, 1e-6, 23u};
+        algo1.set_verbosity(1u);
+        algo2.set_verbosity(1u);
+        auto pop1 = algo1.evolve(pop);
+        auto pop2 = algo2.evolve<rosenbrock>(pop);
+        BOOST_CHECK(pop1.get_x() == pop2.get_x());
+        BOOST_CHECK(pop1.get_f() == pop2.get_f());
+        BOOST_CHECK_EQUAL(pop1.get_problem().get_fevals(), pop2.get_problem().get_fevals());
+        BOOST_CHECK(algo1.get_log() == algo2.get_log());
+    }
+    // The problem type must match.
+    population pop{rosenbrock{10u}, 20u, 23u};
+    // The UDP is not copied (the copies of pop share it).
+    population pop_shared{shared_rosenbrock{}, 20u, 23u};
+    shared_rosenbrock::n_copies = 0u;
+    pop_shared = de{10u}.evolve<shared_rosenbrock>(pop_shared);
+    BOOST_CHECK_EQUAL(shared_rosenbrock::n_copies, 0u);
+    BOOST_CHECK_THROW(de{10u}.evolve<zdt>(pop), std::invalid_argument);
+    // Same preliminary checks as the type-erased evolve.
+    population pop_mo{zdt{1u}, 20u, 23u};
+    BOOST_CHECK_THROW(de{10u}.evolve<zdt>(pop_mo), std::invalid_argument);
+    population pop_small{rosenbrock{10u}, 4u, 23u};
+    BOOST_CHECK_THROW(de{10u}.evolve<rosenbrock>(pop_small), std::invalid_argument);
+    // The algorithm can still be type-erased.
+    algorithm algo{de{10u}};
+    BOOST_CHECK_NO_THROW(algo.evolve(pop));
+}
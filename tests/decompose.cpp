@@ -41,6 +41,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/problems/decompose.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
 #include <pagmo/problems/zdt.hpp>
+#include <pagmo/threading.hpp>
 #include <pagmo/types.hpp>
 
 using namespace pagmo;
@@ -187,6 +188,37 @@ BOOST_AUTO_TEST_CASE(decompose_ideal_point_adaptation_test)
     }
 }
 
+struct mc_02 {
+    vector_double fitness(const vector_double &) const
+    {
+        return {1., 1.};
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return 2u;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::constant;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(decompose_thread_safety_test)
+{
+    BOOST_CHECK((problem{decompose{zdt{1u, 2u}, {0.5, 0.5}, {2., 2.}}}.get_thread_safety() == thread_safety::basic));
+    BOOST_CHECK((problem{decompose{mc_02{}, {0.5, 0.5}, {2., 2.}}}.get_thread_safety() == thread_safety::constant));
+    // The adaptation of the ideal point modifies the decomposed problem, so it cannot be shared.
+    problem p{decompose{mc_02{}, {0.5, 0.5}, {2., 2.}, "weighted", true}};
+    BOOST_CHECK(p.get_thread_safety() == thread_safety::basic);
+    problem p2{p};
+    BOOST_CHECK(static_cast<const problem &>(p).extract<decompose>()
+                != static_cast<const problem &>(p2).extract<decompose>());
+}
+
 BOOST_AUTO_TEST_CASE(decompose_has_dense_sparsities_test)
 {
     problem p{decompose{zdt{1u, 2u}, {0.5, 0.5}, {2., 2.}, "weighted", false}};
@@ -0,0 +1,77 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE eval_context_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include <pagmo/eval_context.hpp>
+#include <pagmo/exceptions.hpp>
+
+using namespace pagmo;
+
+BOOST_AUTO_TEST_CASE(cancellation_token_test)
+{
+    cancellation_token t0;
+    BOOST_CHECK(!t0.is_cancelled());
+    auto t1(t0);
+    cancellation_token t2;
+    t1.cancel();
+    BOOST_CHECK(t0.is_cancelled());
+    BOOST_CHECK(t1.is_cancelled());
+    BOOST_CHECK(!t2.is_cancelled());
+    // Cancellation from another thread.
+    std::thread th([t2]() { t2.cancel(); });
+    th.join();
+    BOOST_CHECK(t2.is_cancelled());
+}
+
+BOOST_AUTO_TEST_CASE(eval_context_test)
+{
+    eval_context c0;
+    BOOST_CHECK(c0.get_deadline() == eval_context::clock::time_point::max());
+    BOOST_CHECK(!c0.is_cancelled());
+    BOOST_CHECK_NO_THROW(c0.check());
+    c0.get_token().cancel();
+    BOOST_CHECK(c0.is_cancelled());
+    BOOST_CHECK_THROW(c0.check(), eval_cancelled_error);
+    eval_context c1{std::chrono::milliseconds(20)};
+    BOOST_CHECK(!c1.is_cancelled());
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    BOOST_CHECK(c1.is_cancelled());
+    BOOST_CHECK_THROW(c1.check(), eval_cancelled_error);
+    cancellation_token t;
+    eval_context c2{eval_context::clock::now() + std::chrono::hours(1), t};
+    BOOST_CHECK(!c2.is_cancelled());
+    t.cancel();
+    BOOST_CHECK(c2.is_cancelled());
+    BOOST_CHECK(c2.get_token().is_cancelled());
+}
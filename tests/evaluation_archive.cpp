@@ -0,0 +1,255 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE evaluation_archive_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <pagmo/evaluation_archive.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/hock_schittkowsky_71.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/multi_objective.hpp>
+
+using namespace pagmo;
+
+// Archive of n random evaluations of prob.
+static evaluation_archive make_archive(const problem &prob, unsigned n, unsigned seed)
+{
+    evaluation_archive retval;
+    population pop{prob, n, seed};
+    retval.push_back(pop);
+    return retval;
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_archive_basic_test)
+{
+    evaluation_archive ar;
+    BOOST_CHECK(ar.size() == 0u);
+    ar.push_back({1., 2.}, {3.});
+    BOOST_CHECK(ar.size() == 1u);
+    BOOST_CHECK_THROW(ar.push_back({1.}, {3.}), std::invalid_argument);
+    BOOST_CHECK_THROW(ar.push_back({1., 2.}, {3., 4.}), std::invalid_argument);
+    BOOST_CHECK_THROW(ar.push_back({}, {3.}), std::invalid_argument);
+    BOOST_CHECK_THROW(ar.push_back({1., 2.}, {}), std::invalid_argument);
+    BOOST_CHECK(ar.size() == 1u);
+    // Populations.
+    population pop{rosenbrock{2u}, 10u, 32u};
+    ar.push_back(pop);
+    BOOST_CHECK(ar.size() == 11u);
+    BOOST_CHECK(std::equal(pop.get_x().begin(), pop.get_x().end(), ar.get_x().begin() + 1));
+    BOOST_CHECK(std::equal(pop.get_f().begin(), pop.get_f().end(), ar.get_f().begin() + 1));
+    BOOST_CHECK_THROW(ar.push_back(population{rosenbrock{3u}, 2u}), std::invalid_argument);
+    BOOST_CHECK(ar.size() == 11u);
+    ar.push_back(population{rosenbrock{2u}});
+    BOOST_CHECK(ar.size() == 11u);
+    // Serialization.
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(ar);
+    }
+    evaluation_archive ar2;
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(ar2);
+    }
+    BOOST_CHECK(ar2.get_x() == ar.get_x());
+    BOOST_CHECK(ar2.get_f() == ar.get_f());
+    ar2.clear();
+    BOOST_CHECK(ar2.size() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(warm_start_single_objective_test)
+{
+    problem prob{rosenbrock{3u}};
+    const auto ar = make_archive(prob, 500u, 42u);
+    auto pop = warm_start_population(prob, ar, 20u, 0., true, 23u);
+    BOOST_CHECK(pop.size() == 20u);
+    BOOST_CHECK(pop.get_seed() == 23u);
+    // The stored fitness is reused.
+    BOOST_CHECK(pop.get_problem().get_fevals() == 0u);
+    // The population contains the 20 best entries of the archive.
+    auto fs = ar.get_f();
+    std::sort(fs.begin(), fs.end());
+    auto pop_f = pop.get_f();
+    std::sort(pop_f.begin(), pop_f.end());
+    BOOST_CHECK(std::equal(pop_f.begin(), pop_f.end(), fs.begin()));
+    BOOST_CHECK(pop.champion_f() == fs[0]);
+    // Without reusing the fitness, the seeded individuals are evaluated again.
+    pop = warm_start_population(prob, ar, 20u, 0., false);
+    BOOST_CHECK(pop.get_problem().get_fevals() == 20u);
+    auto pop_f2 = pop.get_f();
+    std::sort(pop_f2.begin(), pop_f2.end());
+    BOOST_CHECK(pop_f2 == pop_f);
+    // A small archive is completed with random individuals.
+    const auto small = make_archive(prob, 5u, 1u);
+    pop = warm_start_population(prob, small, 12u);
+    BOOST_CHECK(pop.size() == 12u);
+    BOOST_CHECK(pop.get_problem().get_fevals() == 7u);
+    // An archive from a problem of different dimension contributes nothing.
+    pop = warm_start_population(rosenbrock{4u}, ar, 12u);
+    BOOST_CHECK(pop.size() == 12u);
+    BOOST_CHECK(pop.get_problem().get_fevals() == 12u);
+    // Zero size.
+    pop = warm_start_population(prob, ar, 0u);
+    BOOST_CHECK(pop.size() == 0u);
+    // Invalid distances.
+    BOOST_CHECK_THROW(warm_start_population(prob, ar, 10u, -1.), std::invalid_argument);
+    BOOST_CHECK_THROW(warm_start_population(prob, ar, 10u, std::numeric_limits<double>::infinity()),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(warm_start_filter_test)
+{
+    problem prob{rosenbrock{2u}};
+    evaluation_archive ar;
+    // Out of bounds and NaN entries are discarded, even if they have the best fitness.
+    ar.push_back({-6., 0.}, {-1.});
+    ar.push_back({0., 0.}, {std::numeric_limits<double>::quiet_NaN()});
+    ar.push_back({1., 1.}, {0.});
+    ar.push_back({2., 2.}, {1.});
+    auto pop = warm_start_population(prob, ar, 3u);
+    BOOST_CHECK(pop.size() == 3u);
+    BOOST_CHECK((pop.get_x()[0] == vector_double{1., 1.}));
+    BOOST_CHECK((pop.get_x()[1] == vector_double{2., 2.}));
+    BOOST_CHECK(pop.get_problem().get_fevals() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(warm_start_thinning_test)
+{
+    problem prob{rosenbrock{2u}};
+    evaluation_archive ar;
+    // A cluster of near-duplicates around the optimum, and a few distant points.
+    std::mt19937 r(12u);
+    std::uniform_real_distribution<double> jitter(-1e-3, 1e-3);
+    for (int i = 0; i < 50; ++i) {
+        const vector_double x{1. + jitter(r), 1. + jitter(r)};
+        ar.push_back(x, rosenbrock{2u}.fitness(x));
+    }
+    for (double v : {-4., -2., 0., 3., 6.}) {
+        const vector_double x{v, v};
+        ar.push_back(x, rosenbrock{2u}.fitness(x));
+    }
+    // Without thinning, the cluster fills the population.
+    auto pop = warm_start_population(prob, ar, 6u);
+    for (const auto &x : pop.get_x()) {
+        BOOST_CHECK(std::abs(x[0] - 1.) < 1e-2);
+    }
+    // With thinning, one element of the cluster survives, and the best one is kept.
+    const double min_distance = .05;
+    pop = warm_start_population(prob, ar, 6u, min_distance);
+    BOOST_CHECK(pop.get_problem().get_fevals() == 0u);
+    const auto n_cluster = std::count_if(pop.get_x().begin(), pop.get_x().end(),
+                                         [](const vector_double &x) { return std::abs(x[0] - 1.) < 1e-2; });
+    BOOST_CHECK(n_cluster == 1);
+    auto fs = ar.get_f();
+    BOOST_CHECK(pop.champion_f() == *std::min_element(fs.begin(), fs.end()));
+    const auto &xs = pop.get_x();
+    for (decltype(xs.size()) i = 0u; i < xs.size(); ++i) {
+        for (decltype(xs.size()) j = i + 1u; j < xs.size(); ++j) {
+            // The bounds of the problem are [-5, 10].
+            const auto d0 = (xs[i][0] - xs[j][0]) / 15., d1 = (xs[i][1] - xs[j][1]) / 15.;
+            BOOST_CHECK(std::sqrt(d0 * d0 + d1 * d1) >= min_distance);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(warm_start_constrained_test)
+{
+    problem prob{hock_schittkowsky_71{}};
+    const auto ar = make_archive(prob, 200u, 7u);
+    auto pop = warm_start_population(prob, ar, 10u);
+    BOOST_CHECK(pop.get_problem().get_fevals() == 0u);
+    // The seeded individuals are the first 10 in the constrained ordering of the archive.
+    const auto order = sort_population_con(ar.get_f(), prob.get_nec(), prob.get_c_tol());
+    for (decltype(pop.size()) i = 0u; i < pop.size(); ++i) {
+        BOOST_CHECK(pop.get_f()[i] == ar.get_f()[order[i]]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(warm_start_multi_objective_test)
+{
+    problem prob{zdt{1u, 5u}};
+    const auto ar = make_archive(prob, 300u, 3u);
+    const auto fnds = fast_non_dominated_sorting(ar.get_f());
+    const auto &ranks = std::get<3>(fnds);
+    const auto &first_front = std::get<0>(fnds)[0];
+    // Ask for more individuals than the first front contains.
+    const auto n = first_front.size() + 5u;
+    auto pop = warm_start_population(prob, ar, n);
+    BOOST_CHECK(pop.size() == n);
+    BOOST_CHECK(pop.get_problem().get_fevals() == 0u);
+    // The first front is included in full, the rest comes from the next front(s) in rank order.
+    std::vector<vector_double::size_type> pop_ranks;
+    for (const auto &f : pop.get_f()) {
+        const auto it = std::find(ar.get_f().begin(), ar.get_f().end(), f);
+        BOOST_REQUIRE(it != ar.get_f().end());
+        pop_ranks.push_back(ranks[static_cast<vector_double::size_type>(it - ar.get_f().begin())]);
+    }
+    BOOST_CHECK(std::is_sorted(pop_ranks.begin(), pop_ranks.end()));
+    BOOST_CHECK(static_cast<vector_double::size_type>(std::count(pop_ranks.begin(), pop_ranks.end(), 0u))
+                == first_front.size());
+}
+
+// A constrained multi-objective problem.
+struct mo_con {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0], 1. - x[0], x[0] - .5};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return 2u;
+    }
+    vector_double::size_type get_nic() const
+    {
+        return 1u;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(warm_start_mo_con_test)
+{
+    BOOST_CHECK_THROW(warm_start_population(mo_con{}, evaluation_archive{}, 10u), std::invalid_argument);
+}
@@ -0,0 +1,147 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE external_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <unistd.h>
+
+#include <pagmo/algorithms/de.hpp>
+#include <pagmo/batch_fitness.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/external.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// The path of the dummy worker executable is defined by the build system.
+static const std::string worker = PAGMO_TEST_EXTERNAL_WORKER;
+
+static const std::pair<vector_double, vector_double> bounds3{{-1., -1., -1.}, {1., 1., 1.}};
+
+BOOST_AUTO_TEST_CASE(external_construction_test)
+{
+    external p0{};
+    BOOST_CHECK(p0.get_command().empty());
+    BOOST_CHECK_EQUAL(p0.get_n_workers(), 1u);
+    BOOST_CHECK_THROW(p0.fitness({0.5}), std::invalid_argument);
+    BOOST_CHECK_THROW((external{{worker}, bounds3, 1u, 0u, 0u, 0u}), std::invalid_argument);
+    BOOST_CHECK_THROW((external{{worker}, {{0.}, {1., 2.}}}), std::invalid_argument);
+    problem p{external{{worker, "--mo"}, bounds3, 2u, 0u, 0u, 2u}};
+    BOOST_CHECK_EQUAL(p.get_nx(), 3u);
+    BOOST_CHECK_EQUAL(p.get_nobj(), 2u);
+    BOOST_CHECK(p.get_name() == "External problem");
+    BOOST_CHECK(p.get_extra_info().find("Number of workers: 2") != std::string::npos);
+    // A command which cannot be executed.
+    BOOST_CHECK_THROW((external{{"/this/does/not/exist"}, bounds3}.fitness({0., 0., 0.})), std::runtime_error);
+    // A command which is not found in the PATH.
+    BOOST_CHECK_THROW((external{{"pagmo_external_no_such_worker"}, bounds3}.fitness({0., 0., 0.})), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(external_fitness_test)
+{
+    for (unsigned n_workers : {1u, 3u}) {
+        external udp{{worker, "--mo"}, bounds3, 2u, 0u, 0u, n_workers};
+        BOOST_CHECK((udp.fitness({1., 2., 3.}) == vector_double{14., 5.}));
+        // Batches of different sizes, smaller and larger than the number of workers.
+        for (unsigned n : {0u, 1u, 2u, 7u}) {
+            vector_double xs, expected;
+            for (unsigned i = 0u; i < n; ++i) {
+                xs.insert(xs.end(), {double(i), 0., 1.});
+                expected.insert(expected.end(), {double(i * i) + 1., double((i - 1.) * (i - 1.)) + 1.});
+            }
+            BOOST_CHECK(udp.batch_fitness(xs) == expected);
+        }
+        BOOST_CHECK_THROW(udp.batch_fitness({1., 2.}), std::invalid_argument);
+        BOOST_CHECK_EQUAL(udp.get_n_restarts(), 0u);
+        // Through pagmo::problem, the batches are handed over to the pool.
+        problem p{udp};
+        BOOST_CHECK(p.has_batch_fitness());
+        const vector_double xs{0., 0., 1., 1., 0., 1., 2., 0., 1.};
+        BOOST_CHECK((pagmo::batch_fitness(p, xs) == vector_double{1., 2., 2., 1., 5., 2.}));
+        BOOST_CHECK_EQUAL(p.get_fevals(), 3u);
+    }
+    // Inconsistent fitness dimension: the workers are stopped, and launched again afterwards.
+    external bad{{worker}, bounds3, 2u};
+    BOOST_CHECK_THROW(bad.fitness({0., 0., 0.}), std::invalid_argument);
+    BOOST_CHECK_THROW(bad.fitness({0., 0., 0.}), std::invalid_argument);
+    // Copies launch their own workers.
+    external udp{{worker}, bounds3};
+    BOOST_CHECK((udp.fitness({1., 1., 1.}) == vector_double{3.}));
+    auto udp2(udp);
+    BOOST_CHECK((udp2.fitness({1., 0., 1.}) == vector_double{2.}));
+    udp2 = udp;
+    BOOST_CHECK((udp2.fitness({0., 0., 1.}) == vector_double{1.}));
+    // Evolution through pagmo::problem.
+    population pop{problem{udp}, 10u, 32u};
+    pop = de{5u}.evolve(pop);
+    BOOST_CHECK_EQUAL(pop.get_problem().get_fevals(), 60u);
+}
+
+BOOST_AUTO_TEST_CASE(external_restart_test)
+{
+    const std::string marker = "external_test_marker_" + std::to_string(::getpid());
+    std::remove(marker.c_str());
+    external udp{{worker, "--crash-once", marker}, bounds3, 1u, 0u, 0u, 2u};
+    vector_double xs{1., 1., 1., 0., 0., 1.};
+    BOOST_CHECK((udp.batch_fitness(xs) == vector_double{3., 1.}));
+    BOOST_CHECK_EQUAL(udp.get_n_restarts(), 1u);
+    BOOST_CHECK((udp.batch_fitness(xs) == vector_double{3., 1.}));
+    BOOST_CHECK_EQUAL(udp.get_n_restarts(), 1u);
+    std::remove(marker.c_str());
+    external crashing{{worker, "--crash-always"}, bounds3, 1u, 0u, 0u, 1u, 2u};
+    BOOST_CHECK_THROW(crashing.fitness({0., 0., 0.}), std::runtime_error);
+    BOOST_CHECK_EQUAL(crashing.get_n_restarts(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(external_serialization_test)
+{
+    problem p{external{{worker, "--mo"}, bounds3, 2u, 0u, 0u, 2u}};
+    const auto before = p.fitness({0.5, 0.5, 0.5});
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(p);
+    }
+    p = problem{};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(p);
+    }
+    BOOST_CHECK(p.get_name() == "External problem");
+    BOOST_CHECK(p.fitness({0.5, 0.5, 0.5}) == before);
+    BOOST_CHECK_EQUAL(p.extract<external>()->get_n_workers(), 2u);
+}
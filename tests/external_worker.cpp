@@ -0,0 +1,73 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+// Dummy worker executable used in the tests of pagmo::external. It computes the
+// sphere function and, with the option --mo, also the shifted sphere function as
+// a second objective. The options --crash-once <file> (crash on the first request,
+// unless <file> exists, which is then created) and --crash-always simulate crashes.
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <pagmo/problems/external.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+int main(int argc, char **argv)
+{
+    bool mo = false, crash = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        if (arg == "--mo") {
+            mo = true;
+        } else if (arg == "--crash-always") {
+            crash = true;
+        } else if (arg == "--crash-once" && i + 1 < argc) {
+            const std::string file(argv[++i]);
+            if (!std::ifstream(file)) {
+                std::ofstream{file};
+                crash = true;
+            }
+        }
+    }
+    return serve_external([mo, crash](const vector_double &x) {
+        if (crash) {
+            std::exit(1);
+        }
+        vector_double retval(mo ? 2u : 1u, 0.);
+        for (auto xi : x) {
+            retval[0] += xi * xi;
+            if (mo) {
+                retval[1] += (xi - 1.) * (xi - 1.);
+            }
+        }
+        return retval;
+    });
+}
@@ -0,0 +1,256 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE gpbo_test
+#include <boost/lexical_cast.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/gpbo.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problems/hock_schittkowsky_71.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/rng.hpp>
+#include <pagmo/threading.hpp>
+
+using namespace pagmo;
+
+struct unbounded_lb {
+    /// Fitness
+    vector_double fitness(const vector_double &) const
+    {
+        return {0.};
+    }
+    /// Problem bounds
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-std::numeric_limits<double>::infinity()}, {0.}};
+    }
+};
+
+struct sphere_2d {
+    /// Fitness
+    vector_double fitness(const vector_double &x) const
+    {
+        return {(x[0] - .3) * (x[0] - .3) + (x[1] + .2) * (x[1] + .2)};
+    }
+    /// Problem bounds
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-1., -1.}, {1., 1.}};
+    }
+};
+
+struct sphere_2d_serial : sphere_2d {
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+};
+
+struct sphere_2d_shared : sphere_2d {
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::constant;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(gpbo_algorithm_construction)
+{
+    gpbo user_algo{10u, 4u, 500u, 5u, 23u};
+    BOOST_CHECK(user_algo.get_verbosity() == 0u);
+    BOOST_CHECK(user_algo.get_seed() == 23u);
+    BOOST_CHECK(user_algo.get_batch_size() == 4u);
+    BOOST_CHECK(user_algo.get_hyperparameters().empty());
+    BOOST_CHECK((user_algo.get_log() == gpbo::log_type{}));
+
+    BOOST_CHECK_THROW((gpbo{10u, 0u, 500u, 5u, 23u}), std::invalid_argument);
+    BOOST_CHECK_THROW((gpbo{10u, 4u, 0u, 5u, 23u}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(gpbo_gp_test)
+{
+    // The incrementally updated Cholesky factor must match a full factorisation.
+    std::mt19937 r(42u);
+    std::uniform_real_distribution<double> u(0., 1.);
+    Eigen::MatrixXd X(20, 3);
+    Eigen::VectorXd y(20);
+    for (auto i = 0; i < 20; ++i) {
+        for (auto j = 0; j < 3; ++j) {
+            X(i, j) = u(r);
+        }
+        y(i) = std::sin(5. * X(i, 0)) + X(i, 1) * X(i, 2);
+    }
+    detail::gpbo_gp gp_inc, gp_full;
+    gp_inc.fit(X.topRows(12), y.head(12), true, 50u);
+    gp_inc.append(X.bottomRows(8), y.tail(8));
+    gp_full.theta = gp_inc.theta;
+    gp_full.fit(X, y, false, 0u);
+    // Same output scaling for both models.
+    gp_full.y_mean = gp_inc.y_mean;
+    gp_full.y_std = gp_inc.y_std;
+    gp_full.y = (y.array() - gp_inc.y_mean).matrix() / gp_inc.y_std;
+    gp_full.factorize();
+    BOOST_CHECK((gp_inc.L - gp_full.L).cwiseAbs().maxCoeff() < 1e-8);
+    BOOST_CHECK((gp_inc.alpha - gp_full.alpha).cwiseAbs().maxCoeff() < 1e-6);
+    // The fitted model interpolates the data.
+    double mu, s;
+    gp_inc.predict(X.row(15).transpose(), mu, s);
+    BOOST_CHECK(std::abs(mu - gp_inc.y(15)) < 1e-2);
+
+    // The gradient of the log marginal likelihood matches finite differences.
+    Eigen::VectorXd t = gp_inc.theta, g, dummy;
+    t(0) = std::log(.4);
+    t(4) = std::log(1e-2);
+    gp_full.log_likelihood(t, g);
+    for (auto k = 0; k < t.size(); ++k) {
+        Eigen::VectorXd tp = t, tm = t;
+        tp(k) += 1e-6;
+        tm(k) -= 1e-6;
+        const auto fd = (gp_full.log_likelihood(tp, dummy) - gp_full.log_likelihood(tm, dummy)) / 2e-6;
+        BOOST_CHECK(std::abs(fd - g(k)) < 1e-4 * std::max(1., std::abs(fd)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(gpbo_evolve_test)
+{
+    {
+        // Here we only test that evolution is deterministic if the
+        // seed is controlled, also when the batch is evaluated concurrently.
+        problem prob{rosenbrock{3u}};
+        population pop1{prob, 5u, 23u};
+        population pop2{prob, 5u, 23u};
+
+        gpbo user_algo1{5u, 3u, 200u, 2u, 23u};
+        user_algo1.set_verbosity(1u);
+        pop1 = user_algo1.evolve(pop1);
+
+        gpbo user_algo2{5u, 3u, 200u, 2u, 23u};
+        user_algo2.set_verbosity(1u);
+        pop2 = user_algo2.evolve(pop2);
+
+        BOOST_CHECK(user_algo1.get_log().size() == 5u);
+        BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+        BOOST_CHECK(pop1.get_x() == pop2.get_x());
+        // Every batch is counted in the fevals of the population problem.
+        BOOST_CHECK_EQUAL(pop1.get_problem().get_fevals(), 5u + 15u);
+        BOOST_CHECK_EQUAL(user_algo1.get_hyperparameters().size(), 5u);
+    }
+    // The optimum of a smooth function is found with few evaluations, with the serial evaluation
+    // of the batches and with the concurrent one, on copies of the problem or on the shared problem.
+    for (auto ts : {0, 1, 2}) {
+        problem prob
+            = ts == 0 ? problem{sphere_2d_serial{}} : (ts == 1 ? problem{sphere_2d{}} : problem{sphere_2d_shared{}});
+        population pop{prob, 6u, 32u};
+        gpbo user_algo{8u, 3u, 500u, 3u, 32u};
+        pop = user_algo.evolve(pop);
+        BOOST_CHECK_EQUAL(pop.size(), 6u);
+        BOOST_CHECK(pop.champion_f()[0] < 1e-2);
+        BOOST_CHECK_EQUAL(pop.get_problem().get_fevals(), 6u + 24u);
+    }
+    // The hyperparameters are reused as a warm start by the next call.
+    {
+        population pop{problem{sphere_2d{}}, 6u, 32u};
+        gpbo user_algo{2u, 2u, 200u, 0u, 32u};
+        pop = user_algo.evolve(pop);
+        auto hp = user_algo.get_hyperparameters();
+        BOOST_CHECK_NO_THROW(pop = user_algo.evolve(pop));
+        BOOST_CHECK(hp.size() == user_algo.get_hyperparameters().size());
+    }
+
+    // We then check that the evolve throws if called on unsuitable problems
+    BOOST_CHECK_THROW(gpbo{10u}.evolve(population{problem{rosenbrock{}}, 1u}), std::invalid_argument);
+    BOOST_CHECK_THROW(gpbo{10u}.evolve(population{problem{zdt{}}, 15u}), std::invalid_argument);
+    BOOST_CHECK_THROW(gpbo{10u}.evolve(population{problem{hock_schittkowsky_71{}}, 15u}), std::invalid_argument);
+    BOOST_CHECK_THROW(gpbo{10u}.evolve(population{problem{unbounded_lb{}}, 5u}), std::invalid_argument);
+    // And a clean exit for 0 generations
+    population pop{rosenbrock{5u}, 10u};
+    BOOST_CHECK(gpbo{0u}.evolve(pop).get_x()[0] == pop.get_x()[0]);
+}
+
+BOOST_AUTO_TEST_CASE(gpbo_setters_getters_test)
+{
+    gpbo user_algo{10u, 4u, 500u, 5u, 23u};
+    user_algo.set_verbosity(23u);
+    BOOST_CHECK(user_algo.get_verbosity() == 23u);
+    user_algo.set_seed(23u);
+    BOOST_CHECK(user_algo.get_seed() == 23u);
+    BOOST_CHECK(user_algo.get_gen() == 10u);
+    BOOST_CHECK(user_algo.get_name().find("Bayesian") != std::string::npos);
+    BOOST_CHECK(user_algo.get_extra_info().find("Batch size") != std::string::npos);
+    BOOST_CHECK_NO_THROW(user_algo.get_log());
+}
+
+BOOST_AUTO_TEST_CASE(gpbo_serialization_test)
+{
+    // Make one evolution
+    problem prob{rosenbrock{2u}};
+    population pop{prob, 5u, 23u};
+    algorithm algo{gpbo{3u, 2u, 200u, 5u, 23u}};
+    algo.set_verbosity(1u);
+    pop = algo.evolve(pop);
+
+    // Store the string representation of p.
+    std::stringstream ss;
+    auto before_text = boost::lexical_cast<std::string>(algo);
+    auto before_log = algo.extract<gpbo>()->get_log();
+    auto before_hp = algo.extract<gpbo>()->get_hyperparameters();
+    // Now serialize, deserialize and compare the result.
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(algo);
+    }
+    // Change the content of p before deserializing.
+    algo = algorithm{null_algorithm{}};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(algo);
+    }
+    auto after_text = boost::lexical_cast<std::string>(algo);
+    auto after_log = algo.extract<gpbo>()->get_log();
+    auto after_hp = algo.extract<gpbo>()->get_hyperparameters();
+    BOOST_CHECK_EQUAL(before_text, after_text);
+    BOOST_CHECK(before_log.size() > 0u);
+    for (auto i = 0u; i < before_log.size(); ++i) {
+        BOOST_CHECK_EQUAL(std::get<0>(before_log[i]), std::get<0>(after_log[i]));
+        BOOST_CHECK_EQUAL(std::get<1>(before_log[i]), std::get<1>(after_log[i]));
+        BOOST_CHECK_CLOSE(std::get<2>(before_log[i]), std::get<2>(after_log[i]), 1e-8);
+        BOOST_CHECK_CLOSE(std::get<3>(before_log[i]), std::get<3>(after_log[i]), 1e-8);
+        BOOST_CHECK_CLOSE(std::get<4>(before_log[i]), std::get<4>(after_log[i]), 1e-8);
+    }
+    BOOST_CHECK_EQUAL(before_hp.size(), after_hp.size());
+    for (auto i = 0u; i < before_hp.size(); ++i) {
+        BOOST_CHECK_CLOSE(before_hp[i], after_hp[i], 1e-8);
+    }
+}
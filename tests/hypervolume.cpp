@@ -47,7 +47,9 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/utils/hv_algos/hv_bf_fpras.hpp>
 #include <pagmo/utils/hv_algos/hv_hv2d.hpp>
 #include <pagmo/utils/hv_algos/hv_hv3d.hpp>
+#include <pagmo/utils/hv_algos/hv_hvbd.hpp>
 #include <pagmo/utils/hv_algos/hv_hvwfg.hpp>
+#include <pagmo/utils/hv_algos/hv_selector.hpp>
 #include <pagmo/utils/hypervolume.hpp>
 
 using namespace pagmo;
@@ -798,4 +800,248 @@ BOOST_AUTO_TEST_CASE(hypervolume_bf_pras_test)
     BOOST_CHECK_THROW(al.contributions(points, ref), std::invalid_argument);
     auto al_clone = al.clone();
     BOOST_CHECK(al_clone->get_name().find("bf_fpras") != std::string::npos);
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(hypervolume_workspace_test)
+{
+    // Views
+    std::vector<vector_double> points = {{1., 3.}, {2., 2.}, {3., 1.}};
+    hv_points_view v1(points);
+    BOOST_CHECK_EQUAL(v1.size(), 3u);
+    BOOST_CHECK(!v1.has_excluded());
+    hv_points_view v2(points, 1u);
+    BOOST_CHECK_EQUAL(v2.size(), 2u);
+    BOOST_CHECK(v2.has_excluded());
+    BOOST_CHECK(v2.excludes(1u));
+    BOOST_CHECK((v2[0] == vector_double{1., 3.}));
+    BOOST_CHECK((v2[1] == vector_double{3., 1.}));
+    BOOST_CHECK_THROW(hv_points_view(points, 3u), std::invalid_argument);
+
+    // Workspace orderings
+    hv_workspace ws;
+    BOOST_CHECK((ws.sorted_order(points, 0u) == std::vector<hv_workspace::size_type>{0u, 1u, 2u}));
+    BOOST_CHECK((ws.sorted_order(points, 1u) == std::vector<hv_workspace::size_type>{2u, 1u, 0u}));
+
+    // The workspace-based methods agree with the copying ones and never alter the points, for all the exact
+    // algorithms and for an algorithm relying on the default (copying) view-based methods
+    detail::random_engine_type r_engine(32u);
+    std::uniform_real_distribution<double> drng(0., 1.);
+    std::vector<std::shared_ptr<hv_algorithm>> algos2 = {hv2d().clone(), hvwfg().clone(), hv_fake_algo().clone()};
+    std::vector<std::shared_ptr<hv_algorithm>> algos3 = {hv3d().clone(), hvwfg().clone()};
+    std::vector<std::shared_ptr<hv_algorithm>> algos5 = {hvwfg().clone()};
+    for (auto dim : {2u, 3u, 5u}) {
+        for (auto n : {1u, 2u, 15u, 50u}) {
+            // Points on a (noisy) front, plus some dominated ones
+            std::vector<vector_double> pts;
+            for (decltype(n) i = 0u; i < n; ++i) {
+                vector_double p(dim);
+                for (auto &x : p) {
+                    x = drng(r_engine);
+                }
+                pts.push_back(p);
+            }
+            const auto pts_copy = pts;
+            vector_double ref(dim, 2.);
+            auto &algos = (dim == 2u) ? algos2 : ((dim == 3u) ? algos3 : algos5);
+            for (auto &algo : algos) {
+                hypervolume hv(pts, true);
+                hv_workspace w;
+                // Repeated queries on the same workspace
+                for (auto i = 0u; i < 2u; ++i) {
+                    BOOST_CHECK_CLOSE(hv.compute(ref, *algo, w), hv.compute(ref, *hvwfg().clone()), 1e-8);
+                    auto c1 = hv.contributions(ref, *algo, w);
+                    auto c2 = hv.contributions(ref, *hvwfg().clone());
+                    BOOST_CHECK_EQUAL(c1.size(), c2.size());
+                    for (decltype(c1.size()) j = 0u; j < c1.size(); ++j) {
+                        BOOST_CHECK(std::abs(c1[j] - c2[j]) < 1e-12);
+                        BOOST_CHECK(std::abs(hv.exclusive(static_cast<unsigned>(j), ref, *algo, w) - c2[j]) < 1e-12);
+                    }
+                    auto lc = hv.least_contributor(ref, *algo, w);
+                    auto gc = hv.greatest_contributor(ref, *algo, w);
+                    BOOST_CHECK(std::abs(c2[lc] - *std::min_element(c2.begin(), c2.end())) < 1e-12);
+                    BOOST_CHECK(std::abs(c2[gc] - *std::max_element(c2.begin(), c2.end())) < 1e-12);
+                    // A different reference point on the same workspace
+                    BOOST_CHECK_CLOSE(hv.compute(vector_double(dim, 3.), *algo, w),
+                                      hv.compute(vector_double(dim, 3.), *hvwfg().clone()), 1e-8);
+                }
+                BOOST_CHECK(hv.get_points() == pts_copy);
+                // The workspace still verifies the reference point (the fake algorithm performs no checks)
+                if (!dynamic_cast<hv_fake_algo *>(algo.get())) {
+                    BOOST_CHECK_THROW(hv.compute(vector_double(dim, 0.), *algo, w), std::invalid_argument);
+                }
+            }
+        }
+    }
+    // The workspace-based methods ignore the copy_points flag
+    hypervolume hv({{1., 3.}, {2., 2.}, {3., 1.}}, true);
+    hv.set_copy_points(false);
+    hv_workspace w;
+    hv2d algo;
+    BOOST_CHECK_EQUAL(hv.compute({4., 4.}, algo, w), 6.);
+    BOOST_CHECK_EQUAL(hv.compute({4., 4.}, algo, w), 6.);
+    BOOST_CHECK((hv.get_points() == std::vector<vector_double>{{1., 3.}, {2., 2.}, {3., 1.}}));
+    BOOST_CHECK((hv.contributions({4., 4.}, algo, w) == std::vector<double>{1., 1., 1.}));
+    // The legacy methods reorder the points in place: the workspace must not reuse its orderings
+    hypervolume hv_unsorted({{3., 1.}, {1., 3.5}, {2., 2.}}, true);
+    hv_unsorted.set_copy_points(false);
+    hv_workspace w2;
+    BOOST_CHECK_EQUAL(hv_unsorted.least_contributor({4., 4.}, algo, w2), 1u);
+    BOOST_CHECK_EQUAL(hv_unsorted.compute({4., 4.}, algo), 5.5);
+    BOOST_CHECK((hv_unsorted.get_points() == std::vector<vector_double>{{3., 1.}, {2., 2.}, {1., 3.5}}));
+    BOOST_CHECK_EQUAL(hv_unsorted.least_contributor({4., 4.}, algo, w2), 2u);
+    BOOST_CHECK((hv_unsorted.contributions({4., 4.}, algo, w2) == std::vector<double>{1., 1.5, .5}));
+    // Same for a reassignment at the same address with the same number of points
+    hv_unsorted = hypervolume({{1., 2.}, {2., 1.}, {0., 3.}}, true);
+    BOOST_CHECK_EQUAL(hv_unsorted.compute({4., 4.}, algo, w2), 9.);
+    BOOST_CHECK((hv_unsorted.contributions({4., 4.}, algo, w2) == std::vector<double>{1., 2., 1.}));
+    BOOST_CHECK_THROW(hv_unsorted.compute({4., 4., 4.}, algo, w2), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(hypervolume_selector_test)
+{
+    using q = hv_selector::query;
+    hv_selector::reset();
+    // Defaults
+    BOOST_CHECK_EQUAL(hv_selector::select(q::compute, 2u, 10u), "hv2d");
+    BOOST_CHECK_EQUAL(hv_selector::select(q::contributions, 3u, 10u), "hv3d");
+    BOOST_CHECK_EQUAL(hv_selector::select(q::compute, 5u, 10u), "hvwfg");
+    hypervolume hv{{{1., 3.}, {2., 2.}, {3., 1.}}};
+    BOOST_CHECK_EQUAL(hv.get_best_compute({4., 4.})->get_name(), hv2d().get_name());
+    BOOST_CHECK_EQUAL(hv.get_best_contributions({4., 4.})->get_name(), hv2d().get_name());
+    // Instances are cached, but never handed out while a previous reference is alive
+    const auto *cached = hv.get_best_compute({4., 4.}).get();
+    BOOST_CHECK(hv.get_best_compute({4., 4.}).get() == cached);
+    BOOST_CHECK(hv_selector::get_algorithm("hv2d").get() == cached);
+    {
+        const auto held = hv.get_best_compute({4., 4.});
+        BOOST_CHECK(held.get() == cached);
+        const auto other = hv.get_best_compute({4., 4.});
+        BOOST_CHECK(other.get() != held.get());
+        BOOST_CHECK_EQUAL(other->get_name(), hv2d().get_name());
+    }
+    BOOST_CHECK(hv_selector::get_algorithm("hvwfg").get() != hv_selector::get_algorithm("hvwfg").get());
+    BOOST_CHECK_EQUAL(hv_selector::get_algorithm("hvwfg")->get_name(), hvwfg().get_name());
+    BOOST_CHECK_THROW(hv_selector::get_algorithm("hv4d"), std::invalid_argument);
+    // Rules
+    BOOST_CHECK(hv_selector::supports("hvwfg", 7u));
+    BOOST_CHECK(!hv_selector::supports("hv3d", 2u));
+    BOOST_CHECK_THROW(hv_selector::supports("foo", 2u), std::invalid_argument);
+    BOOST_CHECK_THROW(hv_selector::set_rule(q::compute, 2u, "hv3d"), std::invalid_argument);
+    BOOST_CHECK_THROW(hv_selector::set_rule(q::compute, 2u, 0u, "foo"), std::invalid_argument);
+    hv_selector::set_rule(q::compute, 2u, 3u, "hvwfg");
+    BOOST_CHECK_EQUAL(hv_selector::select(q::compute, 2u, 2u), "hv2d");
+    BOOST_CHECK_EQUAL(hv_selector::select(q::compute, 2u, 3u), "hvwfg");
+    BOOST_CHECK_EQUAL(hv_selector::select(q::compute, 2u, 100u), "hvwfg");
+    BOOST_CHECK_EQUAL(hv_selector::select(q::contributions, 2u, 100u), "hv2d");
+    BOOST_CHECK_EQUAL(hv.get_best_compute({4., 4.})->get_name(), hvwfg().get_name());
+    BOOST_CHECK_EQUAL(hv.compute({4., 4.}), 6.);
+    hv_selector::set_rule(q::compute, 2u, 0u, "hvwfg");
+    hv_selector::set_rule(q::compute, 2u, 10u, "hv2d");
+    BOOST_CHECK_EQUAL(hv_selector::select(q::compute, 2u, 5u), "hvwfg");
+    BOOST_CHECK_EQUAL(hv_selector::select(q::compute, 2u, 10u), "hv2d");
+    hv_selector::set_rule(q::compute, 2u, "hv2d");
+    BOOST_CHECK_EQUAL(hv_selector::select(q::compute, 2u, 5u), "hv2d");
+    hv_selector::reset();
+    BOOST_CHECK_EQUAL(hv_selector::select(q::compute, 2u, 5u), "hv2d");
+    // Calibration
+    BOOST_CHECK_THROW(hv_selector::calibrate({}), std::invalid_argument);
+    BOOST_CHECK_THROW(hv_selector::calibrate({4u}, 0u), std::invalid_argument);
+    BOOST_CHECK_THROW(hv_selector::calibrate({0u, 4u}), std::invalid_argument);
+    hv_selector::calibrate({2u, 8u, 32u}, 2u, {2u, 3u, 4u}, 42u);
+    for (auto dim : {2u, 3u, 4u}) {
+        for (auto qq : {q::compute, q::contributions}) {
+            for (auto n : {1u, 5u, 50u}) {
+                BOOST_CHECK(hv_selector::supports(hv_selector::select(qq, dim, n), dim));
+            }
+        }
+    }
+    hypervolume hv3{{{1., 2., 3.}, {3., 2., 1.}, {2., 1., 3.}, {2., 3., 1.}}};
+    BOOST_CHECK_CLOSE(hv3.compute({4., 4., 4.}), hv3.compute({4., 4., 4.}, *hvwfg().clone()), 1e-10);
+    BOOST_CHECK((hv3.contributions({4., 4., 4.}) == hv3.contributions({4., 4., 4.}, *hvwfg().clone())));
+    hv_selector::reset();
+}
+
+BOOST_AUTO_TEST_CASE(hypervolume_hvbd_test)
+{
+    // Agreement with the WFG algorithm, also on fronts with dominated points and repeated coordinates
+    detail::random_engine_type r_engine(7u);
+    std::uniform_real_distribution<double> drng(0., 1.);
+    std::uniform_int_distribution<int> irng(0, 4);
+    for (auto dim : {2u, 3u, 4u, 5u, 6u}) {
+        for (auto n : {1u, 2u, 10u, 40u}) {
+            for (auto discrete : {false, true}) {
+                std::vector<vector_double> pts(n, vector_double(dim));
+                for (auto &p : pts) {
+                    for (auto &x : p) {
+                        x = discrete ? irng(r_engine) : drng(r_engine);
+                    }
+                }
+                vector_double ref(dim, 5.);
+                hypervolume hv(pts, true);
+                const auto hv_wfg = hv.compute(ref, *hvwfg().clone());
+                BOOST_CHECK_CLOSE(hv.compute(ref, *hvbd().clone()), hv_wfg, 1e-8);
+                const auto c_wfg = hv.contributions(ref, *hvwfg().clone());
+                const auto c_bd = hv.contributions(ref, *hvbd().clone());
+                BOOST_CHECK_EQUAL(c_wfg.size(), c_bd.size());
+                for (decltype(c_bd.size()) i = 0u; i < c_bd.size(); ++i) {
+                    BOOST_CHECK(std::abs(c_wfg[i] - c_bd[i]) < 1e-8 * hv_wfg);
+                }
+                // Queries through a workspace, which caches the results for the last reference point
+                hvbd algo;
+                hv_workspace ws;
+                for (auto i = 0u; i < 2u; ++i) {
+                    BOOST_CHECK_CLOSE(hv.compute(ref, algo, ws), hv_wfg, 1e-8);
+                    BOOST_CHECK(std::abs(hv.exclusive(0u, ref, algo, ws) - c_wfg[0]) < 1e-8 * hv_wfg);
+                    BOOST_CHECK((hv.contributions(ref, algo, ws) == c_bd));
+                    BOOST_CHECK(std::abs(hv.exclusive(n - 1u, ref, algo, ws) - c_wfg[n - 1u]) < 1e-8 * hv_wfg);
+                    BOOST_CHECK_EQUAL(c_bd[hv.least_contributor(ref, algo, ws)],
+                                      *std::min_element(c_bd.begin(), c_bd.end()));
+                    BOOST_CHECK_EQUAL(c_bd[hv.greatest_contributor(ref, algo, ws)],
+                                      *std::max_element(c_bd.begin(), c_bd.end()));
+                    // Another reference point, and another algorithm, on the same workspace
+                    const vector_double ref2(dim, 6.);
+                    BOOST_CHECK_CLOSE(hv.compute(ref2, algo, ws), hv.compute(ref2, *hvwfg().clone()), 1e-8);
+                    BOOST_CHECK_CLOSE(hv.compute(ref2, *hvwfg().clone(), ws), hv.compute(ref2, algo, ws), 1e-8);
+                }
+                // Incremental insertion
+                hv_box_decomposition bd(ref);
+                double sum = 0.;
+                for (const auto &p : pts) {
+                    const auto c = bd.contribution(p);
+                    const auto g = bd.insert(p);
+                    BOOST_CHECK_EQUAL(c, g);
+                    sum += g;
+                }
+                BOOST_CHECK_CLOSE(bd.get_volume(), hv_wfg, 1e-8);
+                BOOST_CHECK_CLOSE(sum, hv_wfg, 1e-8);
+                BOOST_CHECK(bd.get_n_points() <= pts.size());
+                // Inserting the same points again changes nothing
+                for (const auto &p : pts) {
+                    BOOST_CHECK_EQUAL(bd.insert(p), 0.);
+                }
+                BOOST_CHECK_CLOSE(bd.get_volume(), hv_wfg, 1e-8);
+            }
+        }
+    }
+    // Simple cases
+    hv_box_decomposition bd({4., 4.});
+    BOOST_CHECK_EQUAL(bd.get_n_boxes(), 1u);
+    BOOST_CHECK_EQUAL(bd.insert({2., 2.}), 4.);
+    BOOST_CHECK_EQUAL(bd.get_n_boxes(), 2u);
+    BOOST_CHECK_EQUAL(bd.contribution({1., 3.}), 1.);
+    BOOST_CHECK_EQUAL(bd.insert({3., 1.}), 1.);
+    BOOST_CHECK_EQUAL(bd.insert({1., 1.}), 4.);
+    BOOST_CHECK_EQUAL(bd.get_volume(), 9.);
+    BOOST_CHECK_EQUAL(bd.insert({4., 0.}), 0.);
+    BOOST_CHECK((bd.get_r_point() == vector_double{4., 4.}));
+    BOOST_CHECK_THROW(bd.insert({1., 1., 1.}), std::invalid_argument);
+    BOOST_CHECK_THROW(bd.contribution({1.}), std::invalid_argument);
+    BOOST_CHECK_THROW(hv_box_decomposition{vector_double{}}, std::invalid_argument);
+    hypervolume hv{{{1., 2., 3., 4.}, {4., 3., 2., 1.}}};
+    BOOST_CHECK_THROW(hv.compute({0., 0., 0., 0.}, *hvbd().clone()), std::invalid_argument);
+    BOOST_CHECK_EQUAL(hvbd().get_name(), "Box decomposition algorithm");
+    // Selection through hv_selector
+    hv_selector::set_rule(hv_selector::query::compute, 4u, "hvbd");
+    BOOST_CHECK_EQUAL(hv.get_best_compute({5., 5., 5., 5.})->get_name(), hvbd().get_name());
+    BOOST_CHECK_CLOSE(hv.compute({5., 5., 5., 5.}), hv.compute({5., 5., 5., 5.}, *hvwfg().clone()), 1e-10);
+    hv_selector::reset();
+}
@@ -0,0 +1,260 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE indicator_selection_test
+
+#include <boost/test/included/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <pagmo/rng.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/hypervolume.hpp>
+#include <pagmo/utils/indicator_selection.hpp>
+
+using namespace pagmo;
+using size_type = vector_double::size_type;
+
+// Random non-dominated front on the positive orthant of the unit sphere.
+std::vector<vector_double> random_front(size_type dim, size_type n, detail::random_engine_type &r_engine)
+{
+    std::uniform_real_distribution<double> drng(0.05, 1.);
+    std::vector<vector_double> retval(n, vector_double(dim));
+    for (auto &p : retval) {
+        double norm = 0.;
+        for (auto &x : p) {
+            x = drng(r_engine);
+            norm += x * x;
+        }
+        for (auto &x : p) {
+            x /= std::sqrt(norm);
+        }
+    }
+    return retval;
+}
+
+// Naive greedy truncation: at each step removes the point minimising the indicator loss, recomputed
+// from scratch for all the candidates.
+template <typename Loss>
+std::vector<size_type> naive_greedy(size_type n, size_type N, const Loss &loss)
+{
+    std::vector<size_type> alive(n);
+    std::iota(alive.begin(), alive.end(), size_type(0u));
+    while (alive.size() > N) {
+        size_type best = 0u;
+        double best_loss = std::numeric_limits<double>::infinity();
+        for (size_type i = 0u; i < alive.size(); ++i) {
+            const double l = loss(alive, i);
+            if (l < best_loss) {
+                best_loss = l;
+                best = i;
+            }
+        }
+        alive.erase(alive.begin() + static_cast<std::ptrdiff_t>(best));
+    }
+    return alive;
+}
+
+BOOST_AUTO_TEST_CASE(select_best_N_hv_test)
+{
+    detail::random_engine_type r_engine(123u);
+    for (auto dim : {2u, 3u, 4u}) {
+        for (auto n : {5u, 20u, 40u}) {
+            auto pts = random_front(dim, n, r_engine);
+            vector_double r_point(dim, 1.1);
+            for (auto N : {1u, 3u, n / 2u, n - 1u}) {
+                auto naive = naive_greedy(n, N, [&](const std::vector<size_type> &alive, size_type i) {
+                    std::vector<vector_double> sub;
+                    for (auto j : alive) {
+                        sub.push_back(pts[j]);
+                    }
+                    return hypervolume(sub, false).exclusive(static_cast<unsigned>(i), r_point);
+                });
+                BOOST_CHECK((select_best_N_hv(pts, N, r_point) == naive));
+            }
+        }
+    }
+    // Random clouds, mixing dominated and non-dominated points
+    std::uniform_real_distribution<double> drng(0., 1.);
+    for (auto dim : {3u, 4u}) {
+        std::vector<vector_double> pts(30u, vector_double(dim));
+        for (auto &p : pts) {
+            for (auto &x : p) {
+                x = drng(r_engine);
+            }
+        }
+        vector_double r_point(dim, 1.1);
+        for (auto N : {2u, 10u, 25u}) {
+            auto naive = naive_greedy(pts.size(), N, [&](const std::vector<size_type> &alive, size_type i) {
+                std::vector<vector_double> sub;
+                for (auto j : alive) {
+                    sub.push_back(pts[j]);
+                }
+                return hypervolume(sub, false).exclusive(static_cast<unsigned>(i), r_point);
+            });
+            BOOST_CHECK((select_best_N_hv(pts, N, r_point) == naive));
+        }
+    }
+    // Large three-dimensional fronts, against the naive greedy recomputing all the contributions at each step
+    {
+        auto pts = random_front(3u, 1000u, r_engine);
+        vector_double r_point(3u, 1.1);
+        for (auto N : {500u, 990u}) {
+            std::vector<size_type> naive(pts.size());
+            std::iota(naive.begin(), naive.end(), size_type(0u));
+            while (naive.size() > N) {
+                std::vector<vector_double> sub;
+                for (auto j : naive) {
+                    sub.push_back(pts[j]);
+                }
+                const auto c = hypervolume(sub, false).contributions(r_point);
+                naive.erase(naive.begin() + (std::min_element(c.begin(), c.end()) - c.begin()));
+            }
+            BOOST_CHECK((select_best_N_hv(pts, N, r_point) == naive));
+        }
+    }
+    // Three-dimensional clouds with duplicated points
+    {
+        std::vector<vector_double> pts(30u, vector_double(3u));
+        for (auto &p : pts) {
+            for (auto &x : p) {
+                x = drng(r_engine);
+            }
+        }
+        for (size_type i = 0u; i < 10u; ++i) {
+            pts.push_back(pts[3u * i]);
+        }
+        vector_double r_point(3u, 1.1);
+        for (auto N : {2u, 10u, 25u, 35u}) {
+            auto naive = naive_greedy(pts.size(), N, [&](const std::vector<size_type> &alive, size_type i) {
+                std::vector<vector_double> sub;
+                for (auto j : alive) {
+                    sub.push_back(pts[j]);
+                }
+                return hypervolume(sub, false).exclusive(static_cast<unsigned>(i), r_point);
+            });
+            BOOST_CHECK((select_best_N_hv(pts, N, r_point) == naive));
+        }
+    }
+    // Dominated points go first
+    std::vector<vector_double> pts = {{1., 3.}, {2., 2.5}, {3., 1.}, {2.5, 2.5}, {3., 3.}};
+    BOOST_CHECK((select_best_N_hv(pts, 3u, {4., 4.}) == std::vector<size_type>{0u, 1u, 2u}));
+    BOOST_CHECK((select_best_N_hv(pts, 4u, {4., 4.}) == std::vector<size_type>{0u, 1u, 2u, 3u}));
+    BOOST_CHECK((select_best_N_hv(pts, 2u, {4., 4.}) == std::vector<size_type>{0u, 2u}));
+    std::vector<vector_double> pts3 = {{1., 3., 2.}, {2., 2., 2.}, {3., 1., 2.}, {3., 3., 3.}};
+    BOOST_CHECK((select_best_N_hv(pts3, 3u, {4., 4., 4.}) == std::vector<size_type>{0u, 1u, 2u}));
+    // Single objective
+    BOOST_CHECK((select_best_N_hv({{3.}, {1.}, {2.}}, 2u, {4.}) == std::vector<size_type>{1u, 2u}));
+    // Corner cases and errors
+    BOOST_CHECK((select_best_N_hv(pts, 10u, {4., 4.}) == std::vector<size_type>{0u, 1u, 2u, 3u, 4u}));
+    BOOST_CHECK(select_best_N_hv({}, 10u, {4., 4.}).empty());
+    BOOST_CHECK_THROW(select_best_N_hv(pts, 0u, {4., 4.}), std::invalid_argument);
+    BOOST_CHECK_THROW(select_best_N_hv(pts, 2u, {4., 4., 4.}), std::invalid_argument);
+    BOOST_CHECK_THROW(select_best_N_hv(pts, 2u, {2., 4.}), std::invalid_argument);
+    BOOST_CHECK_THROW(select_best_N_hv({{1., 2.}, {1.}}, 1u, {4., 4.}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(select_best_N_igd_plus_r2_test)
+{
+    detail::random_engine_type r_engine(321u);
+    std::uniform_real_distribution<double> drng(0., 1.);
+    for (auto dim : {2u, 3u, 5u}) {
+        for (auto n : {5u, 30u}) {
+            std::vector<vector_double> pts(n, vector_double(dim));
+            for (auto &p : pts) {
+                for (auto &x : p) {
+                    x = drng(r_engine);
+                }
+            }
+            const auto ref_set = random_front(dim, 50u, r_engine);
+            const auto weights = random_front(dim, 50u, r_engine);
+            const vector_double ideal(dim, 0.);
+            auto igd_plus = [&](const std::vector<size_type> &alive) {
+                double retval = 0.;
+                for (const auto &z : ref_set) {
+                    double m = std::numeric_limits<double>::infinity();
+                    for (auto a : alive) {
+                        double d = 0.;
+                        for (size_type i = 0u; i < dim; ++i) {
+                            d += std::pow(std::max(pts[a][i] - z[i], 0.), 2.);
+                        }
+                        m = std::min(m, std::sqrt(d));
+                    }
+                    retval += m;
+                }
+                return retval;
+            };
+            auto r2 = [&](const std::vector<size_type> &alive) {
+                double retval = 0.;
+                for (const auto &w : weights) {
+                    double m = std::numeric_limits<double>::infinity();
+                    for (auto a : alive) {
+                        double u = 0.;
+                        for (size_type i = 0u; i < dim; ++i) {
+                            u = std::max(u, w[i] * std::abs(pts[a][i] - ideal[i]));
+                        }
+                        m = std::min(m, u);
+                    }
+                    retval += m;
+                }
+                return retval;
+            };
+            for (auto N : {1u, 2u, n / 2u, n - 1u}) {
+                auto without = [](const std::vector<size_type> &alive, size_type i) {
+                    auto retval = alive;
+                    retval.erase(retval.begin() + static_cast<std::ptrdiff_t>(i));
+                    return retval;
+                };
+                // The greedy choices may differ on ties, hence the indicator values are compared.
+                auto naive_igd = naive_greedy(
+                    n, N, [&](const std::vector<size_type> &alive, size_type i) { return igd_plus(without(alive, i)); });
+                BOOST_CHECK_CLOSE(igd_plus(select_best_N_igd_plus(pts, N, ref_set)), igd_plus(naive_igd), 1e-8);
+                auto naive_r2 = naive_greedy(
+                    n, N, [&](const std::vector<size_type> &alive, size_type i) { return r2(without(alive, i)); });
+                BOOST_CHECK_CLOSE(r2(select_best_N_r2(pts, N, weights, ideal)), r2(naive_r2), 1e-8);
+                BOOST_CHECK_EQUAL(select_best_N_igd_plus(pts, N, ref_set).size(), N);
+                BOOST_CHECK_EQUAL(select_best_N_r2(pts, N, weights, ideal).size(), N);
+            }
+        }
+    }
+    // Errors
+    std::vector<vector_double> pts = {{1., 3.}, {2., 2.}, {3., 1.}};
+    BOOST_CHECK_THROW(select_best_N_igd_plus(pts, 0u, {{0., 0.}}), std::invalid_argument);
+    BOOST_CHECK_THROW(select_best_N_igd_plus(pts, 1u, {}), std::invalid_argument);
+    BOOST_CHECK_THROW(select_best_N_igd_plus(pts, 1u, {{0., 0., 0.}}), std::invalid_argument);
+    BOOST_CHECK_THROW(select_best_N_r2(pts, 1u, {}, {0., 0.}), std::invalid_argument);
+    BOOST_CHECK_THROW(select_best_N_r2(pts, 1u, {{0.5, 0.5}}, {0.}), std::invalid_argument);
+    BOOST_CHECK_THROW(select_best_N_r2(pts, 1u, {{0.5}}, {0., 0.}), std::invalid_argument);
+    BOOST_CHECK((select_best_N_igd_plus(pts, 1u, {{2., 2.}}) == std::vector<size_type>{1u}));
+    BOOST_CHECK((select_best_N_r2(pts, 5u, {{0.5, 0.5}}, {0., 0.}) == std::vector<size_type>{0u, 1u, 2u}));
+}
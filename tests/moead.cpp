@@ -174,6 +174,11 @@ BOOST_AUTO_TEST_CASE(moead_evolve_test)
     // We test a call on many objectives (>5) to trigger the relative lines cropping the screen output
     population pop3{problem{mo_many{}}, 56u, 23u};
     user_algo1.evolve(pop3);
+
+    // Population sizes not matching a grid are allowed by the "two layers" and "uniform design" methods
+    population pop4{problem{mo_many{}}, 60u, 23u};
+    moead{10u, "two layers"}.evolve(pop4);
+    moead{10u, "uniform design"}.evolve(pop4);
 }
 
 BOOST_AUTO_TEST_CASE(moead_setters_getters_test)
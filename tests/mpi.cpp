@@ -0,0 +1,168 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#define BOOST_TEST_MODULE mpi_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <mpi.h>
+#include <stdexcept>
+#include <vector>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/de.hpp>
+#include <pagmo/algorithms/nsga2.hpp>
+#include <pagmo/mpi.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/hock_schittkowsky_71.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// This test is meant to be run with several ranks, e.g., mpirun -np 4 ./mpi.
+struct mpi_fixture {
+    mpi_fixture()
+    {
+        MPI_Init(nullptr, nullptr);
+    }
+    ~mpi_fixture()
+    {
+        MPI_Finalize();
+    }
+};
+
+BOOST_GLOBAL_FIXTURE(mpi_fixture);
+
+static int comm_rank()
+{
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    return rank;
+}
+
+static int comm_size()
+{
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    return size;
+}
+
+BOOST_AUTO_TEST_CASE(mpi_batch_fitness_test)
+{
+    problem p{rosenbrock{3u}};
+    const problem p_serial{rosenbrock{3u}};
+    // Batches smaller and larger than the number of ranks.
+    for (unsigned n : {0u, 1u, 3u, 17u}) {
+        vector_double xs, expected;
+        if (comm_rank() == 0) {
+            for (unsigned i = 0u; i < n; ++i) {
+                const vector_double x{0.1 * i, 0.2, -0.3 * i};
+                xs.insert(xs.end(), x.begin(), x.end());
+                const auto f = p_serial.fitness(x);
+                expected.insert(expected.end(), f.begin(), f.end());
+            }
+        }
+        const auto fevals = p.get_fevals();
+        const auto fs = mpi_batch_fitness(p, xs);
+        // All the evaluations are counted on the root rank only.
+        if (comm_rank() == 0) {
+            BOOST_CHECK(fs == expected);
+            BOOST_CHECK_EQUAL(p.get_fevals(), fevals + n);
+        } else {
+            BOOST_CHECK(fs.empty());
+            BOOST_CHECK_EQUAL(p.get_fevals(), fevals);
+        }
+    }
+    // Errors on one rank are raised on all the ranks.
+    vector_double bad(comm_rank() == 0 ? 4u : 0u);
+    BOOST_CHECK_THROW(mpi_batch_fitness(p, bad), std::exception);
+    // The ranks are still in sync afterwards.
+    vector_double xs(comm_rank() == 0 ? 3u : 0u, 0.5);
+    const auto fs = mpi_batch_fitness(p, xs);
+    BOOST_CHECK_EQUAL(fs.size(), comm_rank() == 0 ? 1u : 0u);
+}
+
+BOOST_AUTO_TEST_CASE(mpi_rank_individuals_test)
+{
+    // One equality and one inequality constraint: the first individual violates the equality constraint within
+    // the tolerance, and is thus ranked as feasible.
+    problem p{hock_schittkowsky_71{}};
+    const std::vector<vector_double> f = {{1., 0.05, -1.}, {2., 0., -1.}, {0.5, 0.5, -1.}};
+    BOOST_CHECK((detail::mpi_rank_individuals(f, p) == std::vector<vector_double::size_type>{1u, 0u, 2u}));
+    p.set_c_tol({0.1, 0.});
+    BOOST_CHECK((detail::mpi_rank_individuals(f, p) == std::vector<vector_double::size_type>{0u, 1u, 2u}));
+}
+
+BOOST_AUTO_TEST_CASE(mpi_archipelago_test)
+{
+    const auto rank = static_cast<unsigned>(comm_rank());
+    // Single-objective.
+    {
+        mpi_archipelago archi{algorithm{de{10u}}, population{rosenbrock{5u}, 20u, rank}, 2u};
+        BOOST_CHECK_EQUAL(archi.get_rank(), comm_rank());
+        BOOST_CHECK_EQUAL(archi.get_size(), comm_size());
+        BOOST_CHECK_EQUAL(archi.get_n_migrants(), 2u);
+        const auto before = archi.get_population().champion_f()[0];
+        archi.evolve(5u);
+        BOOST_CHECK(archi.get_population().champion_f()[0] <= before);
+        BOOST_CHECK_EQUAL(archi.get_population().size(), 20u);
+        const auto pops = archi.get_populations();
+        if (comm_rank() == 0) {
+            BOOST_CHECK_EQUAL(pops.size(), static_cast<unsigned>(comm_size()));
+            BOOST_CHECK(pops[0].get_x() == archi.get_population().get_x());
+            for (const auto &pop : pops) {
+                BOOST_CHECK_EQUAL(pop.size(), 20u);
+                BOOST_CHECK(pop.get_problem().get_name() == archi.get_population().get_problem().get_name());
+            }
+        } else {
+            BOOST_CHECK(pops.empty());
+        }
+        if (comm_size() > 1) {
+            BOOST_CHECK(archi.get_n_migrations() > 0u);
+        }
+    }
+    // Multi-objective.
+    {
+        mpi_archipelago archi{algorithm{nsga2{5u}}, population{zdt{1u, 10u}, 8u, rank}};
+        archi.evolve(3u);
+        BOOST_CHECK_EQUAL(archi.get_population().size(), 8u);
+    }
+    // Invalid number of migrants, on one rank only.
+    BOOST_CHECK_THROW(
+        (mpi_archipelago{algorithm{de{10u}}, population{rosenbrock{5u}, 20u, rank}, rank == 0u ? 21u : 1u}),
+        std::exception);
+    // Different numbers of migrants on different ranks.
+    if (comm_size() > 1) {
+        BOOST_CHECK_THROW(
+            (mpi_archipelago{algorithm{de{10u}}, population{rosenbrock{5u}, 20u, rank}, rank == 0u ? 2u : 1u}),
+            std::invalid_argument);
+    }
+}
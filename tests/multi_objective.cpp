@@ -29,11 +29,17 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_MODULE mo_utilities_test
 
 #include <boost/test/included/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
 #include <exception>
 #include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
 #include <tuple>
 
 #include <pagmo/io.hpp>
+#include <pagmo/serialization.hpp>
 #include <pagmo/types.hpp>
 #include <pagmo/utils/multi_objective.hpp>
 
@@ -378,6 +384,118 @@ BOOST_AUTO_TEST_CASE(decomposition_weights_test)
         auto ws = decomposition_weights(5u, 25u, "random", r_engine);
         check_weights(ws, 5u);
     }
+    // The "two layers" and "uniform design" methods allow any number of weights
+    for (auto method : {"two layers", "uniform design"}) {
+        BOOST_CHECK_THROW(decomposition_weights(10u, 5u, method, r_engine), std::invalid_argument);
+        for (auto n_f : {2u, 3u, 5u, 10u}) {
+            for (auto n_w : {10u, 31u, 100u, 277u}) {
+                if (n_w < n_f) {
+                    continue;
+                }
+                auto ws = decomposition_weights(n_f, n_w, method, r_engine);
+                BOOST_CHECK_EQUAL(ws.size(), n_w);
+                check_weights(ws, n_f);
+                for (decltype(ws.size()) i = 0u; i < ws.size(); ++i) {
+                    BOOST_CHECK(std::all_of(ws[i].begin(), ws[i].end(), [](double w) { return w >= 0. && w <= 1.; }));
+                    // No duplicates
+                    for (decltype(ws.size()) j = 0u; j < i; ++j) {
+                        BOOST_CHECK(ws[i] != ws[j]);
+                    }
+                }
+                // Canonical weights first
+                for (decltype(n_f) i = 0u; i < n_f; ++i) {
+                    BOOST_CHECK_EQUAL(ws[i][i], 1.);
+                }
+            }
+        }
+    }
+    {
+        // With a budget matching a boundary lattice plus an inner lattice, "two layers" generates exactly those
+        // (NSGA-III style with 10 objectives, H1 = 3, H2 = 2)
+        auto ws = decomposition_weights(10u, 275u, "two layers", r_engine);
+        BOOST_CHECK_EQUAL(ws.size(), 275u);
+        BOOST_CHECK(std::all_of(ws.begin(), ws.begin() + 220, [](const vector_double &w) {
+            return std::all_of(w.begin(), w.end(), [](double x) { return std::abs(x * 3. - std::round(x * 3.)) < 1e-12; });
+        }));
+        BOOST_CHECK(std::all_of(ws.begin() + 220, ws.end(), [](const vector_double &w) {
+            return std::all_of(w.begin(), w.end(), [](double x) { return x >= 0.05 - 1e-12; });
+        }));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(decomposition_weights_generator_test)
+{
+    // Throws
+    BOOST_CHECK_THROW(decomposition_weights_generator(1u, 5u, "grid"), std::invalid_argument);
+    BOOST_CHECK_THROW(decomposition_weights_generator(10u, 5u, "two layers"), std::invalid_argument);
+    BOOST_CHECK_THROW(decomposition_weights_generator(2u, 5u, "grod"), std::invalid_argument);
+    BOOST_CHECK_THROW(decomposition_weights_generator(4u, 31u, "grid"), std::invalid_argument);
+    // The generator streams exactly the requested number of weights
+    for (auto method : {"grid", "random", "low discrepancy", "two layers", "uniform design"}) {
+        decomposition_weights_generator gen(3u, 15u, method, 32u);
+        std::vector<vector_double> ws;
+        vector_double w;
+        while (gen.remaining()) {
+            gen(w);
+            ws.push_back(w);
+        }
+        BOOST_CHECK_EQUAL(ws.size(), 15u);
+        check_weights(ws, 3u);
+        BOOST_CHECK((ws[0] == vector_double{1., 0., 0.}));
+        BOOST_CHECK((ws[1] == vector_double{0., 1., 0.}));
+        BOOST_CHECK((ws[2] == vector_double{0., 0., 1.}));
+        BOOST_CHECK_THROW(gen(), std::out_of_range);
+    }
+    // The deterministic methods stream the same weights as decomposition_weights
+    detail::random_engine_type r_engine(23u);
+    for (auto method : {"low discrepancy", "two layers", "uniform design"}) {
+        decomposition_weights_generator gen(4u, 50u, method);
+        auto ws = decomposition_weights(4u, 50u, method, r_engine);
+        for (const auto &w : ws) {
+            BOOST_CHECK(gen() == w);
+        }
+    }
+    // The grid streams the same set of weights as decomposition_weights
+    {
+        decomposition_weights_generator gen(4u, 35u, "grid");
+        auto ws = decomposition_weights(4u, 35u, "grid", r_engine);
+        for (decltype(ws.size()) i = 0u; i < ws.size(); ++i) {
+            auto w = gen();
+            BOOST_CHECK(std::any_of(ws.begin(), ws.end(), [&w](const vector_double &item) {
+                return std::equal(w.begin(), w.end(), item.begin(),
+                                  [](double a, double b) { return std::abs(a - b) < 1e-12; });
+            }));
+        }
+    }
+    // Many objectives, many weights: no grid explosion
+    {
+        decomposition_weights_generator gen(10u, 100000u, "two layers");
+        vector_double w;
+        while (gen.remaining()) {
+            gen(w);
+        }
+        BOOST_CHECK_CLOSE(std::accumulate(w.begin(), w.end(), 0.), 1., 1e-08);
+    }
+    // Serialization
+    {
+        decomposition_weights_generator gen(5u, 100u, "two layers");
+        for (auto i = 0u; i < 40u; ++i) {
+            gen();
+        }
+        std::stringstream ss;
+        {
+            cereal::JSONOutputArchive oarchive(ss);
+            oarchive(gen);
+        }
+        auto next = gen();
+        decomposition_weights_generator gen2(2u, 2u, "grid");
+        {
+            cereal::JSONInputArchive iarchive(ss);
+            iarchive(gen2);
+        }
+        BOOST_CHECK_EQUAL(gen2.remaining(), 60u);
+        BOOST_CHECK(gen2() == next);
+    }
 }
 
 BOOST_AUTO_TEST_CASE(decompose_objectives_test)
@@ -408,3 +526,53 @@ BOOST_AUTO_TEST_CASE(decompose_objectives_test)
     BOOST_CHECK_THROW(decompose_objectives(f, weight, ref_point, "pippo"), std::invalid_argument);
     BOOST_CHECK_THROW(decompose_objectives({}, {}, {}, "weighted"), std::invalid_argument);
 }
+
+BOOST_AUTO_TEST_CASE(flat_points_view_test)
+{
+    // The overloads on flat arrays give the same results as the ones on vectors of points, ties included.
+    std::mt19937 r(32u);
+    std::uniform_int_distribution<int> coord(0, 6);
+    for (vector_double::size_type dim : {2u, 3u, 5u}) {
+        for (vector_double::size_type n : {2u, 3u, 10u, 57u}) {
+            std::vector<vector_double> points(n, vector_double(dim));
+            vector_double flat;
+            for (auto &p : points) {
+                for (auto &c : p) {
+                    c = coord(r);
+                    flat.push_back(c);
+                }
+            }
+            const flat_points_view view{flat.data(), n, dim};
+            BOOST_CHECK(view.size() == n);
+            BOOST_CHECK(view.dim() == dim);
+            BOOST_CHECK(view[1][0] == points[1][0]);
+            BOOST_CHECK(fast_non_dominated_sorting(view) == fast_non_dominated_sorting(points));
+            BOOST_CHECK(crowding_distance(view) == crowding_distance(points));
+            BOOST_CHECK(sort_population_mo(view) == sort_population_mo(points));
+            for (vector_double::size_type N = 1u; N <= n + 1u; ++N) {
+                BOOST_CHECK(select_best_N_mo(view, N) == select_best_N_mo(points, N));
+            }
+            BOOST_CHECK(ideal(view) == ideal(points));
+            BOOST_CHECK(nadir(view) == nadir(points));
+            if (dim == 2u) {
+                BOOST_CHECK(non_dominated_front_2d(view) == non_dominated_front_2d(points));
+            } else {
+                BOOST_CHECK_THROW(non_dominated_front_2d(view), std::invalid_argument);
+            }
+        }
+    }
+    // Corner cases and throws.
+    const vector_double flat{1., 2.};
+    const flat_points_view empty{nullptr, 0u, 2u}, one{flat.data(), 1u, 2u}, one_d{flat.data(), 2u, 1u};
+    BOOST_CHECK(non_dominated_front_2d(empty).empty());
+    BOOST_CHECK(sort_population_mo(empty).empty());
+    BOOST_CHECK((sort_population_mo(one) == std::vector<vector_double::size_type>{0u}));
+    BOOST_CHECK((select_best_N_mo(one, 3u) == std::vector<vector_double::size_type>{0u}));
+    BOOST_CHECK(ideal(empty).empty());
+    BOOST_CHECK(nadir(empty).empty());
+    BOOST_CHECK((ideal(one) == vector_double{1., 2.}));
+    BOOST_CHECK_THROW(fast_non_dominated_sorting(one), std::invalid_argument);
+    BOOST_CHECK_THROW(crowding_distance(one), std::invalid_argument);
+    BOOST_CHECK_THROW(crowding_distance(one_d), std::invalid_argument);
+    BOOST_CHECK_THROW(select_best_N_mo(one, 0u), std::invalid_argument);
+}
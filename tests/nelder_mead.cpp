@@ -0,0 +1,313 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE nelder_mead_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/compass_search.hpp>
+#include <pagmo/algorithms/mbh.hpp>
+#include <pagmo/algorithms/nelder_mead.hpp>
+#include <pagmo/detail/nm_kernels.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problems/hock_schittkowsky_71.hpp>
+#include <pagmo/problems/inventory.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// A separable, ill-conditioned quadratic with its minimum (0) at x = 0.3.
+struct weighted_sphere {
+    vector_double fitness(const vector_double &x) const
+    {
+        double retval = 0.;
+        for (decltype(x.size()) i = 0u; i < x.size(); ++i) {
+            retval += static_cast<double>(i + 1u) * (x[i] - .3) * (x[i] - .3);
+        }
+        return {retval};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {vector_double(12u, -1.), vector_double(12u, 1.)};
+    }
+};
+
+// The unconstrained minimum lies outside the box, at x = (-1, ...).
+struct active_bounds {
+    vector_double fitness(const vector_double &x) const
+    {
+        double retval = 0.;
+        for (auto xi : x) {
+            retval += (xi + 1.) * (xi + 1.);
+        }
+        return {retval};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0., 0., 0.}, {1., 1., 1.}};
+    }
+};
+
+// Same as rosenbrock, but without thread safety.
+struct rosenbrock_serial : rosenbrock {
+    rosenbrock_serial() : rosenbrock(4u)
+    {
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+};
+
+// Throws when the first coordinate reaches the upper bound.
+struct throw_at_ub {
+    vector_double fitness(const vector_double &x) const
+    {
+        if (x[0] == 1.) {
+            throw std::runtime_error("upper bound");
+        }
+        return {x[0] + x[1]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0., 0.}, {1., 1.}};
+    }
+};
+
+struct unbounded_lb {
+    vector_double fitness(const vector_double &) const
+    {
+        return {0.};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-std::numeric_limits<double>::infinity()}, {0.}};
+    }
+};
+
+BOOST_AUTO_TEST_CASE(nelder_mead_algorithm_construction)
+{
+    nelder_mead user_algo{100u, 0.1, 0.001};
+    BOOST_CHECK(user_algo.get_verbosity() == 0u);
+    BOOST_CHECK(!user_algo.get_speculative());
+    BOOST_CHECK((user_algo.get_log() == nelder_mead::log_type{}));
+
+    BOOST_CHECK_THROW((nelder_mead{1234u, 1.7}), std::invalid_argument);
+    BOOST_CHECK_THROW((nelder_mead{1234u, -0.3}), std::invalid_argument);
+    BOOST_CHECK_THROW((nelder_mead{1234u, 0.3, 0.4}), std::invalid_argument);
+    BOOST_CHECK_THROW((nelder_mead{1234u, 0.3, 0.}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(nelder_mead_evolve_test)
+{
+    double stop_range = 1e-6;
+
+    // Here we only test that evolution is deterministic (stop criteria will be range)
+    problem prob{rosenbrock{4u}};
+    population pop1{prob, 5u, 23u};
+    population pop2{prob, 5u, 23u};
+
+    nelder_mead user_algo1{20000u, 0.1, stop_range};
+    user_algo1.set_verbosity(1u);
+    pop1 = user_algo1.evolve(pop1);
+
+    nelder_mead user_algo2{20000u, 0.1, stop_range};
+    user_algo2.set_verbosity(1u);
+    pop2 = user_algo2.evolve(pop2);
+
+    BOOST_CHECK(user_algo1.get_log().size() > 0u);
+    BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+    BOOST_CHECK(std::get<2>(user_algo1.get_log().back()) < stop_range);
+    BOOST_CHECK(pop1.champion_f()[0] < 1e-8);
+
+    // We test the max_fevals stopping criteria
+    auto max_fevals = 20u;
+    nelder_mead user_algo3{max_fevals, 0.1, stop_range};
+    population pop3{prob, 5u, 23u};
+    auto f0 = pop3.champion_f()[0];
+    auto fevals0 = pop3.get_problem().get_fevals();
+    pop3 = user_algo3.evolve(pop3);
+    BOOST_CHECK(pop3.get_problem().get_fevals() - fevals0 == max_fevals);
+    BOOST_CHECK(pop3.champion_f()[0] <= f0);
+
+    // Active bounds are handled
+    population pop4{problem{active_bounds{}}, 1u, 23u};
+    pop4 = nelder_mead{1000u, 0.1, 1e-8}.evolve(pop4);
+    BOOST_CHECK_CLOSE(pop4.champion_f()[0], 3., 1e-6);
+
+    // We then check that the evolve throws if called on unsuitable problems
+    BOOST_CHECK_THROW(nelder_mead{10u}.evolve(population{problem{rosenbrock{}}, 0u}), std::invalid_argument);
+    BOOST_CHECK_THROW(nelder_mead{10u}.evolve(population{problem{zdt{}}, 15u}), std::invalid_argument);
+    BOOST_CHECK_THROW(nelder_mead{10u}.evolve(population{problem{inventory{}}, 15u}), std::invalid_argument);
+    BOOST_CHECK_THROW(nelder_mead{10u}.evolve(population{problem{hock_schittkowsky_71{}}, 15u}), std::invalid_argument);
+    BOOST_CHECK_THROW(nelder_mead{10u}.evolve(population{problem{unbounded_lb{}}, 15u}), std::invalid_argument);
+    // And a clean exit for 0 generations
+    population pop{rosenbrock{25u}, 10u};
+    BOOST_CHECK(nelder_mead{0u}.evolve(pop).get_x()[0] == pop.get_x()[0]);
+}
+
+BOOST_AUTO_TEST_CASE(nelder_mead_speculative_test)
+{
+    // The speculative evaluations do not change the sequence of simplices.
+    problem prob{rosenbrock{4u}};
+    population pop1{prob, 1u, 23u};
+    population pop2{prob, 1u, 23u};
+    pop1 = nelder_mead{100000u, 0.1, 1e-6}.evolve(pop1);
+    pop2 = nelder_mead{100000u, 0.1, 1e-6, true}.evolve(pop2);
+    BOOST_CHECK(pop1.get_x()[0] == pop2.get_x()[0]);
+    BOOST_CHECK(pop1.get_f()[0] == pop2.get_f()[0]);
+    // All the evaluations, including those made on the copies of the problem, are counted. The speculative
+    // evaluations are made only if they can run concurrently.
+    if (std::thread::hardware_concurrency() > 1u) {
+        BOOST_CHECK(pop2.get_problem().get_fevals() > pop1.get_problem().get_fevals());
+    } else {
+        BOOST_CHECK(pop2.get_problem().get_fevals() == pop1.get_problem().get_fevals());
+    }
+    // Problems that cannot be evaluated concurrently are evaluated sequentially.
+    population pop3{rosenbrock_serial{}, 1u, 23u};
+    pop3 = nelder_mead{100000u, 0.1, 1e-6, true}.evolve(pop3);
+    BOOST_CHECK(pop3.get_x()[0] == pop1.get_x()[0]);
+    BOOST_CHECK(pop3.get_problem().get_fevals() == pop1.get_problem().get_fevals());
+    // The budget is never exceeded, not even by the speculative evaluations or by an incomplete initial simplex.
+    for (auto max_fevals : {1u, 3u, 20u, 21u, 22u, 23u}) {
+        population pop4{prob, 1u, 23u};
+        const auto f0 = pop4.get_f()[0][0];
+        pop4 = nelder_mead{max_fevals, 0.1, 1e-6, true}.evolve(pop4);
+        BOOST_CHECK_EQUAL(pop4.get_problem().get_fevals() - 1u, max_fevals);
+        BOOST_CHECK(pop4.get_f()[0][0] <= f0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(nelder_mead_evaluator_test)
+{
+    // No more workers than the largest batch.
+    BOOST_CHECK_EQUAL(detail::nm_evaluator::n_workers(problem{rosenbrock{2u}}, false), 1u);
+    BOOST_CHECK(detail::nm_evaluator::n_workers(problem{rosenbrock{2u}}, true) <= 4u);
+    BOOST_CHECK(detail::nm_evaluator::n_workers(problem{rosenbrock{100u}}, true) <= 100u);
+    BOOST_CHECK_EQUAL(detail::nm_evaluator::n_workers(problem{rosenbrock_serial{}}, true), 1u);
+    // The evaluations made on the copies of the problem are counted also if an evaluation throws: the worker
+    // evaluating the last point fails, after the others are done.
+    const problem prob{throw_at_ub{}};
+    const vector_double lb{0., 0.}, ub{1., 1.};
+    vector_double pts, out(8u);
+    for (auto i = 0u; i < 8u; ++i) {
+        pts.push_back(i / 7.);
+        pts.push_back(0.5);
+    }
+    {
+        detail::nm_evaluator eval(prob, lb, ub, 4u);
+        const detail::nm_fevals_guard fevals_guard{eval};
+        eval.idx() = {0u, 1u};
+        BOOST_CHECK_THROW(eval(pts.data(), 8u, out.data()), std::runtime_error);
+    }
+    BOOST_CHECK_EQUAL(prob.get_fevals(), 7u);
+}
+
+BOOST_AUTO_TEST_CASE(nelder_mead_vs_compass_search_test)
+{
+    problem prob{weighted_sphere{}};
+    population pop1{prob, 1u, 32u};
+    population pop2{prob, 1u, 32u};
+    pop1 = nelder_mead{100000u, 0.1, 1e-8}.evolve(pop1);
+    pop2 = compass_search{100000u, 0.1, 1e-8, 0.5}.evolve(pop2);
+    BOOST_CHECK(pop1.champion_f()[0] < 1e-10);
+    BOOST_CHECK(pop1.get_problem().get_fevals() < pop2.get_problem().get_fevals());
+}
+
+BOOST_AUTO_TEST_CASE(nelder_mead_mbh_test)
+{
+    // nelder_mead can be used as the local solver of monotonic basin hopping
+    problem prob{rosenbrock{3u}};
+    population pop{prob, 1u, 23u};
+    mbh user_algo{nelder_mead{2000u, 0.1, 1e-8}, 3u, 0.05, 23u};
+    pop = user_algo.evolve(pop);
+    BOOST_CHECK(pop.champion_f()[0] < 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(nelder_mead_setters_getters_test)
+{
+    nelder_mead user_algo{10000u, 0.5, 0.1, true};
+    user_algo.set_verbosity(23u);
+    BOOST_CHECK(user_algo.get_verbosity() == 23u);
+    BOOST_CHECK(user_algo.get_max_fevals() == 10000u);
+    BOOST_CHECK(user_algo.get_start_range() == 0.5);
+    BOOST_CHECK(user_algo.get_stop_range() == 0.1);
+    BOOST_CHECK(user_algo.get_speculative());
+    BOOST_CHECK(user_algo.get_name().find("Nelder-Mead") != std::string::npos);
+    BOOST_CHECK(user_algo.get_extra_info().find("Speculative") != std::string::npos);
+    BOOST_CHECK_NO_THROW(user_algo.get_log());
+}
+
+BOOST_AUTO_TEST_CASE(nelder_mead_serialization_test)
+{
+    // We test the serialization of a pagmo algorithm when constructed with nelder_mead
+    // Make one evolution
+    problem prob{rosenbrock{5u}};
+    population pop{prob, 10u, 23u};
+    algorithm algo{nelder_mead{1000u, 0.1, 1e-4}};
+    algo.set_verbosity(1u); // allows the log to be filled
+    pop = algo.evolve(pop);
+
+    // Store the string representation of p.
+    std::stringstream ss;
+    auto before_text = boost::lexical_cast<std::string>(algo);
+    auto before_log = algo.extract<nelder_mead>()->get_log();
+    // Now serialize, deserialize and compare the result.
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(algo);
+    }
+    // Change the content of p before deserializing.
+    algo = algorithm{null_algorithm{}};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(algo);
+    }
+    auto after_text = boost::lexical_cast<std::string>(algo);
+    auto after_log = algo.extract<nelder_mead>()->get_log();
+    BOOST_CHECK_EQUAL(before_text, after_text);
+    BOOST_CHECK(before_log.size() > 0u);
+    for (auto i = 0u; i < before_log.size(); ++i) {
+        BOOST_CHECK_EQUAL(std::get<0>(before_log[i]), std::get<0>(after_log[i]));
+        BOOST_CHECK_CLOSE(std::get<1>(before_log[i]), std::get<1>(after_log[i]), 1e-8);
+        BOOST_CHECK_CLOSE(std::get<2>(before_log[i]), std::get<2>(after_log[i]), 1e-8);
+    }
+}
@@ -0,0 +1,136 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE numa_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include <pagmo/numa.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/timed_evaluator.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+BOOST_AUTO_TEST_CASE(numa_cpulist_test)
+{
+    using detail::numa_parse_cpulist;
+    BOOST_CHECK((numa_parse_cpulist("0") == std::vector<unsigned>{0u}));
+    BOOST_CHECK((numa_parse_cpulist("0-3\n") == std::vector<unsigned>{0u, 1u, 2u, 3u}));
+    BOOST_CHECK((numa_parse_cpulist("8,0-1,10-11") == std::vector<unsigned>{0u, 1u, 8u, 10u, 11u}));
+    BOOST_CHECK((numa_parse_cpulist("1,1,0-1") == std::vector<unsigned>{0u, 1u}));
+    BOOST_CHECK(numa_parse_cpulist("").empty());
+    BOOST_CHECK(numa_parse_cpulist("\n").empty());
+    BOOST_CHECK(numa_parse_cpulist("a").empty());
+    BOOST_CHECK(numa_parse_cpulist("3-1").empty());
+    BOOST_CHECK(numa_parse_cpulist("1-").empty());
+}
+
+BOOST_AUTO_TEST_CASE(numa_topology_test)
+{
+    const auto &nodes = numa_nodes();
+    BOOST_REQUIRE(nodes.size() > 0u);
+    BOOST_CHECK(std::is_sorted(nodes.begin(), nodes.end()));
+    std::vector<unsigned> all_cpus;
+    for (auto node : nodes) {
+        const auto &cpus = numa_node_cpus(node);
+        BOOST_CHECK(cpus.size() > 0u);
+        BOOST_CHECK(std::is_sorted(cpus.begin(), cpus.end()));
+        all_cpus.insert(all_cpus.end(), cpus.begin(), cpus.end());
+    }
+    // The nodes do not share CPUs.
+    std::sort(all_cpus.begin(), all_cpus.end());
+    BOOST_CHECK(std::adjacent_find(all_cpus.begin(), all_cpus.end()) == all_cpus.end());
+    BOOST_CHECK_THROW(numa_node_cpus(nodes.back() + 1u), std::invalid_argument);
+    BOOST_CHECK_THROW(numa_bind_thread(nodes.back() + 1u), std::invalid_argument);
+    BOOST_CHECK_THROW(numa_run_on_node(nodes.back() + 1u, []() { return 0; }), std::invalid_argument);
+    BOOST_TEST_MESSAGE("NUMA nodes: " + std::to_string(nodes.size()));
+}
+
+BOOST_AUTO_TEST_CASE(numa_placement_test)
+{
+    for (auto node : numa_nodes()) {
+        const auto &cpus = numa_node_cpus(node);
+        // The thread running the function is pinned to the CPUs of the node.
+        const auto pinned = numa_run_on_node(node, [&cpus, node]() {
+            const auto bound = numa_bind_thread(node);
+#if defined(__linux__)
+            BOOST_CHECK(bound);
+            ::cpu_set_t set;
+            CPU_ZERO(&set);
+            BOOST_REQUIRE(::sched_getaffinity(0, sizeof(set), &set) == 0);
+            for (unsigned c = 0u; c < CPU_SETSIZE; ++c) {
+                if (CPU_ISSET(c, &set)) {
+                    BOOST_CHECK(std::binary_search(cpus.begin(), cpus.end(), c));
+                }
+            }
+#else
+            (void)cpus;
+#endif
+            return bound;
+        });
+        (void)pinned;
+        // The memory of a population built on the node stays there after it is moved out.
+        auto pop = numa_run_on_node(node, []() { return population{rosenbrock{100u}, 20u, 32u}; });
+        BOOST_CHECK(pop.size() == 20u);
+        const auto where = numa_node_of(pop.get_x()[0].data());
+        BOOST_TEST_MESSAGE("Population placed on node " + std::to_string(where));
+        BOOST_CHECK(where == -1 || where == static_cast<int>(node));
+    }
+    // Functions returning void and throwing functions.
+    int n = 0;
+    numa_run_on_node(numa_nodes()[0], [&n]() { ++n; });
+    BOOST_CHECK(n == 1);
+    BOOST_CHECK_THROW(numa_run_on_node(numa_nodes()[0], []() -> int { throw std::runtime_error(""); }),
+                      std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(numa_timed_evaluator_test)
+{
+    problem prob{rosenbrock{2u}};
+    timed_evaluator ev{10., timeout_policy::penalty, 1u, {}, 4u};
+    BOOST_CHECK(!ev.get_numa_binding());
+    ev.set_numa_binding(true);
+    BOOST_CHECK(ev.get_numa_binding());
+    const vector_double xs{1., 1., 0., 0., 2., 2., -1., 1., .5, .5};
+    const auto res = ev.evaluate(prob, xs);
+    for (vector_double::size_type i = 0u; i < 5u; ++i) {
+        BOOST_CHECK(res.status[i] == eval_status::ok);
+        BOOST_CHECK(res.f[i] == prob.fitness({xs[2u * i], xs[2u * i + 1u]})[0]);
+    }
+}
@@ -673,6 +673,8 @@ BOOST_AUTO_TEST_CASE(problem_getters_test)
     BOOST_CHECK((p1.get_c_tol() == vector_double{0., 0., 0., 0., 0., 0., 0.}));
     BOOST_CHECK(p1.get_nf() == 2 + 3 + 4);
     BOOST_CHECK((p1.get_bounds() == std::pair<vector_double, vector_double>{{13, 13}, {17, 17}}));
+    BOOST_CHECK((p1.get_lb() == vector_double{13, 13}));
+    BOOST_CHECK((p1.get_ub() == vector_double{17, 17}));
 
     // Making some evaluations
     auto N = 1235u;
@@ -1084,3 +1086,255 @@ BOOST_AUTO_TEST_CASE(thread_safety_test)
     BOOST_CHECK(problem{ts2{}}.get_thread_safety() == thread_safety::none);
     BOOST_CHECK(problem{ts3{}}.get_thread_safety() == thread_safety::basic);
 }
+
+static unsigned n_ts4_copies = 0u;
+
+// A UDP that can be shared among problems.
+struct ts4 {
+    ts4() = default;
+    ts4(const ts4 &other) : m_seed(other.m_seed)
+    {
+        ++n_ts4_copies;
+    }
+    ts4(ts4 &&) = default;
+    ts4 &operator=(const ts4 &) = default;
+    ts4 &operator=(ts4 &&) = default;
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0] + m_seed};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0}, {1}};
+    }
+    void set_seed(unsigned seed)
+    {
+        m_seed = seed;
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::constant;
+    }
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_seed);
+    }
+    unsigned m_seed = 0u;
+};
+
+PAGMO_REGISTER_PROBLEM(ts4)
+
+BOOST_AUTO_TEST_CASE(shared_udp_test)
+{
+    problem p0{ts4{}};
+    BOOST_CHECK(p0.get_thread_safety() == thread_safety::constant);
+    BOOST_CHECK(boost::lexical_cast<std::string>(p0).find("Thread safety: constant") != std::string::npos);
+    n_ts4_copies = 0u;
+    // Copies share the UDP.
+    problem p1{p0}, p2;
+    p2 = p0;
+    BOOST_CHECK_EQUAL(n_ts4_copies, 0u);
+    const problem &cp0 = p0, &cp1 = p1, &cp2 = p2;
+    BOOST_CHECK(cp0.extract<ts4>() == cp1.extract<ts4>());
+    BOOST_CHECK(cp0.extract<ts4>() == cp2.extract<ts4>());
+    // The counters are not shared.
+    p1.fitness({.5});
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 0u);
+    BOOST_CHECK_EQUAL(p1.get_fevals(), 1u);
+    // Modifying the UDP makes a private copy of it.
+    p1.set_seed(3u);
+    BOOST_CHECK_EQUAL(n_ts4_copies, 1u);
+    BOOST_CHECK(cp0.extract<ts4>() != cp1.extract<ts4>());
+    BOOST_CHECK(p0.fitness({.5}) == vector_double{.5});
+    BOOST_CHECK(p1.fitness({.5}) == vector_double{3.5});
+    BOOST_CHECK(p2.fitness({.5}) == vector_double{.5});
+    p2.extract<ts4>()->m_seed = 4u;
+    BOOST_CHECK_EQUAL(n_ts4_copies, 2u);
+    BOOST_CHECK(p0.fitness({.5}) == vector_double{.5});
+    BOOST_CHECK(p2.fitness({.5}) == vector_double{4.5});
+    // p0 is now the only owner of its UDP: no more copies.
+    p0.set_seed(1u);
+    p0.extract<ts4>()->m_seed = 2u;
+    BOOST_CHECK_EQUAL(n_ts4_copies, 2u);
+    BOOST_CHECK(p0.fitness({.5}) == vector_double{2.5});
+    // Serialization of a shared UDP.
+    problem p3{p0};
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(p3);
+    }
+    p3 = problem{};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(p3);
+    }
+    BOOST_CHECK(cp0.extract<ts4>() != static_cast<const problem &>(p3).extract<ts4>());
+    BOOST_CHECK(p3.fitness({.5}) == vector_double{2.5});
+    BOOST_CHECK(p3.get_thread_safety() == thread_safety::constant);
+    // UDPs with weaker guarantees are still deep copied.
+    problem p4{ts1{}}, p5{p4};
+    BOOST_CHECK(static_cast<const problem &>(p4).extract<ts1>() != static_cast<const problem &>(p5).extract<ts1>());
+    // Once a mutable pointer has been handed out, the copies do not share the UDP anymore.
+    problem p6{ts4{}};
+    auto ptr6 = p6.extract<ts4>();
+    n_ts4_copies = 0u;
+    problem p7{p6}, p8;
+    p8 = p6;
+    BOOST_CHECK_EQUAL(n_ts4_copies, 2u);
+    ptr6->m_seed = 5u;
+    BOOST_CHECK(p6.fitness({.5}) == vector_double{5.5});
+    BOOST_CHECK(p7.fitness({.5}) == vector_double{.5});
+    BOOST_CHECK(p8.fitness({.5}) == vector_double{.5});
+    // The copies themselves can share their UDP.
+    problem p9{p7};
+    BOOST_CHECK_EQUAL(n_ts4_copies, 2u);
+    BOOST_CHECK(static_cast<const problem &>(p7).extract<ts4>() == static_cast<const problem &>(p9).extract<ts4>());
+}
+
+struct mf1 {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0]};
+    }
+    vector_double fitness(const vector_double &x, unsigned level) const
+    {
+        return {x[0] + 10. - 5. * level};
+    }
+    vector_double get_fidelity_costs() const
+    {
+        return {1., 10., 100.};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+};
+
+// Missing the costs.
+struct mf2 {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0]};
+    }
+    vector_double fitness(const vector_double &x, unsigned) const
+    {
+        return {x[0]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+};
+
+struct mf3 : mf1 {
+    vector_double get_fidelity_costs() const
+    {
+        return {1., -1.};
+    }
+};
+
+BOOST_AUTO_TEST_CASE(fidelity_test)
+{
+    problem p0{null_problem{}};
+    BOOST_CHECK(!p0.has_fidelity());
+    BOOST_CHECK((p0.get_fidelity_costs() == vector_double{1.}));
+    BOOST_CHECK((p0.fitness({1.}, 0u) == vector_double{0.}));
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 1u);
+    BOOST_CHECK_EQUAL(p0.get_lfevals(), 0u);
+    BOOST_CHECK_THROW(p0.fitness({1.}, 1u), std::invalid_argument);
+    problem p1{mf1{}};
+    BOOST_CHECK(p1.has_fidelity());
+    BOOST_CHECK((p1.get_fidelity_costs() == vector_double{1., 10., 100.}));
+    BOOST_CHECK((p1.fitness({.5}, 0u) == vector_double{10.5}));
+    BOOST_CHECK((p1.fitness({.5}, 1u) == vector_double{5.5}));
+    // The finest level goes through the single-argument fitness.
+    BOOST_CHECK((p1.fitness({.5}, 2u) == vector_double{.5}));
+    BOOST_CHECK_EQUAL(p1.get_fevals(), 1u);
+    BOOST_CHECK_EQUAL(p1.get_lfevals(), 2u);
+    BOOST_CHECK_THROW(p1.fitness({.5}, 3u), std::invalid_argument);
+    BOOST_CHECK_THROW(p1.fitness({.5, .5}, 0u), std::invalid_argument);
+    detail::problem_counters::increment_lfevals(p1, 3u);
+    BOOST_CHECK_EQUAL(p1.get_lfevals(), 5u);
+    auto p2(p1);
+    BOOST_CHECK_EQUAL(p2.get_lfevals(), 5u);
+    BOOST_CHECK(boost::lexical_cast<std::string>(p2).find("Lower fidelity evaluations: 5") != std::string::npos);
+    problem p3{mf2{}};
+    BOOST_CHECK(!p3.has_fidelity());
+    BOOST_CHECK_EQUAL(p3.get_fidelity_costs().size(), 1u);
+    BOOST_CHECK_THROW(problem{mf3{}}, std::invalid_argument);
+}
+
+struct cf1 {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0]};
+    }
+    vector_double fitness(const vector_double &x, const eval_context &ctx) const
+    {
+        ctx.check();
+        return {-x[0]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+};
+
+BOOST_AUTO_TEST_CASE(context_fitness_test)
+{
+    problem p0{null_problem{}};
+    BOOST_CHECK(!p0.has_context_fitness());
+    BOOST_CHECK((p0.fitness({1.}, eval_context{}) == vector_double{0.}));
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 1u);
+    problem p1{cf1{}};
+    BOOST_CHECK(p1.has_context_fitness());
+    BOOST_CHECK((p1.fitness({.5}, eval_context{}) == vector_double{-.5}));
+    BOOST_CHECK((p1.fitness({.5}) == vector_double{.5}));
+    BOOST_CHECK_EQUAL(p1.get_fevals(), 2u);
+    eval_context expired{eval_context::clock::now()};
+    BOOST_CHECK_THROW(p1.fitness({.5}, expired), eval_cancelled_error);
+    BOOST_CHECK_THROW(p0.fitness({.5}, expired), eval_cancelled_error);
+    BOOST_CHECK_THROW(p1.fitness({.5, .5}, eval_context{}), std::invalid_argument);
+    BOOST_CHECK_EQUAL(p1.get_fevals(), 2u);
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 1u);
+}
+
+struct bf1 {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0], x[1]};
+    }
+    vector_double batch_fitness(const vector_double &xs) const
+    {
+        // A single fitness vector is returned for an invalid batch, in order to test the checks.
+        return xs.size() == 4u ? vector_double{1.} : xs;
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return 2u;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0., 0.}, {1., 1.}};
+    }
+};
+
+BOOST_AUTO_TEST_CASE(batch_fitness_test)
+{
+    BOOST_CHECK(!has_batch_fitness<null_problem>::value);
+    BOOST_CHECK(has_batch_fitness<bf1>::value);
+    problem p0{null_problem{}};
+    BOOST_CHECK(!p0.has_batch_fitness());
+    BOOST_CHECK_THROW(p0.batch_fitness({1., 2.}), not_implemented_error);
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 0u);
+    problem p1{bf1{}};
+    BOOST_CHECK(p1.has_batch_fitness());
+    BOOST_CHECK((p1.batch_fitness({.1, .2, .3, .4, .5, .6}) == vector_double{.1, .2, .3, .4, .5, .6}));
+    BOOST_CHECK(p1.batch_fitness({}).empty());
+    BOOST_CHECK_EQUAL(p1.get_fevals(), 3u);
+    BOOST_CHECK_THROW(p1.batch_fitness({.1, .2, .3}), std::invalid_argument);
+    BOOST_CHECK_THROW(p1.batch_fitness({.1, .2, .3, .4}), std::invalid_argument);
+    BOOST_CHECK_EQUAL(p1.get_fevals(), 3u);
+}
@@ -492,3 +492,76 @@ BOOST_AUTO_TEST_CASE(override_has_set_seed_test)
     BOOST_CHECK((!override_has_set_seed<ov_hss_02>::value));
     BOOST_CHECK((!override_has_set_seed<ov_hss_03>::value));
 }
+
+struct hff_00 {
+};
+
+// The good one.
+struct hff_01 {
+    vector_double fitness(const vector_double &, unsigned) const;
+};
+
+struct hff_02 {
+    vector_double fitness(const vector_double &, unsigned);
+};
+
+struct hff_03 {
+    vector_double fitness(const vector_double &) const;
+};
+
+BOOST_AUTO_TEST_CASE(has_fidelity_fitness_test)
+{
+    BOOST_CHECK((!has_fidelity_fitness<hff_00>::value));
+    BOOST_CHECK((has_fidelity_fitness<hff_01>::value));
+    BOOST_CHECK((!has_fidelity_fitness<hff_02>::value));
+    BOOST_CHECK((!has_fidelity_fitness<hff_03>::value));
+}
+
+struct hfc_00 {
+};
+
+// The good one.
+struct hfc_01 {
+    vector_double get_fidelity_costs() const;
+};
+
+struct hfc_02 {
+    vector_double get_fidelity_costs();
+};
+
+struct hfc_03 {
+    double get_fidelity_costs() const;
+};
+
+BOOST_AUTO_TEST_CASE(has_fidelity_costs_test)
+{
+    BOOST_CHECK((!has_fidelity_costs<hfc_00>::value));
+    BOOST_CHECK((has_fidelity_costs<hfc_01>::value));
+    BOOST_CHECK((!has_fidelity_costs<hfc_02>::value));
+    BOOST_CHECK((!has_fidelity_costs<hfc_03>::value));
+}
+
+struct hcf_00 {
+};
+
+// The good one.
+struct hcf_01 {
+    vector_double fitness(const vector_double &, const eval_context &) const;
+};
+
+struct hcf_02 {
+    vector_double fitness(const vector_double &, const eval_context &);
+};
+
+struct hcf_03 {
+    vector_double fitness(const vector_double &, unsigned) const;
+};
+
+BOOST_AUTO_TEST_CASE(has_context_fitness_test)
+{
+    BOOST_CHECK((!has_context_fitness<hcf_00>::value));
+    BOOST_CHECK((has_context_fitness<hcf_01>::value));
+    BOOST_CHECK((!has_context_fitness<hcf_02>::value));
+    BOOST_CHECK((!has_context_fitness<hcf_03>::value));
+    BOOST_CHECK((!has_fidelity_fitness<hcf_01>::value));
+}
@@ -0,0 +1,209 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE radix_sort_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <pagmo/detail/custom_comparisons.hpp>
+#include <pagmo/detail/radix_sort.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/hv_algos/hv_hv2d.hpp>
+#include <pagmo/utils/hv_algos/hv_hv3d.hpp>
+#include <pagmo/utils/hv_algos/hv_hvwfg.hpp>
+#include <pagmo/utils/hypervolume.hpp>
+#include <pagmo/utils/multi_objective.hpp>
+
+using namespace pagmo;
+
+// Random keys with plenty of duplicates and special values.
+static vector_double random_keys(std::size_t n, unsigned seed)
+{
+    std::mt19937 r(seed);
+    std::uniform_real_distribution<double> d(-1e3, 1e3);
+    std::uniform_int_distribution<int> kind(0, 9);
+    const double specials[] = {0., -0., std::numeric_limits<double>::infinity(),
+                               -std::numeric_limits<double>::infinity(), std::nan(""), -std::nan(""),
+                               std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::max(), 1., 1.};
+    vector_double retval(n);
+    for (auto &x : retval) {
+        const auto k = kind(r);
+        x = k < 4 ? d(r) : (k < 7 ? std::round(d(r) / 100.) : specials[kind(r)]);
+    }
+    return retval;
+}
+
+BOOST_AUTO_TEST_CASE(radix_key_test)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const vector_double sorted{-inf, -1e300, -1., -std::numeric_limits<double>::denorm_min(), 0.,
+                               std::numeric_limits<double>::denorm_min(), 1., 1e300, inf, std::nan("")};
+    for (decltype(sorted.size()) i = 1u; i < sorted.size(); ++i) {
+        BOOST_CHECK(detail::radix_key(sorted[i - 1u]) < detail::radix_key(sorted[i]));
+    }
+    BOOST_CHECK(detail::radix_key(-0.) == detail::radix_key(0.));
+    BOOST_CHECK(detail::radix_key(-std::nan("")) == detail::radix_key(std::nan("")));
+}
+
+BOOST_AUTO_TEST_CASE(radix_sort_permutation_test)
+{
+    BOOST_CHECK(detail::radix_sort_permutation({}).empty());
+    BOOST_CHECK((detail::radix_sort_permutation({3.}) == std::vector<std::size_t>{0u}));
+    // Same keys: no pass is needed.
+    BOOST_CHECK((detail::radix_sort_permutation({2., 2., 2.}) == std::vector<std::size_t>{0u, 1u, 2u}));
+    for (std::size_t n : {2u, 10u, 255u, 1000u, 5000u}) {
+        const auto keys = random_keys(n, static_cast<unsigned>(n));
+        // The permutation is the one of a stable sort with less_than_f().
+        std::vector<std::size_t> ref(n);
+        std::iota(ref.begin(), ref.end(), std::size_t(0u));
+        std::stable_sort(ref.begin(), ref.end(),
+                         [&keys](std::size_t a, std::size_t b) { return detail::less_than_f(keys[a], keys[b]); });
+        BOOST_CHECK(detail::radix_sort_permutation(keys) == ref);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sort_by_key_test)
+{
+    const std::size_t t = detail::radix_sort_threshold;
+    for (std::size_t n : {std::size_t(0u), std::size_t(1u), std::size_t(100u), t - 1u, t, std::size_t(3000u)}) {
+        // Sorting of row pointers.
+        std::vector<vector_double> points(n, vector_double(2));
+        const auto keys = random_keys(n, 42u);
+        for (decltype(points.size()) i = 0u; i < n; ++i) {
+            points[i][0] = static_cast<double>(i);
+            points[i][1] = keys[i];
+        }
+        std::vector<const vector_double *> p(n);
+        for (decltype(points.size()) i = 0u; i < n; ++i) {
+            p[i] = &points[i];
+        }
+        detail::sort_by_key(p.begin(), p.end(), [](const vector_double *v) { return (*v)[1]; });
+        BOOST_CHECK(std::is_sorted(p.begin(), p.end(), [](const vector_double *a, const vector_double *b) {
+            return detail::less_than_f((*a)[1], (*b)[1]);
+        }));
+        // Sorting of the points themselves, which are moved.
+        auto sorted = points;
+        detail::radix_sort_by_key(sorted.begin(), sorted.end(), [](const vector_double &v) { return v[1]; });
+        BOOST_CHECK(std::is_sorted(sorted.begin(), sorted.end(), [](const vector_double &a, const vector_double &b) {
+            return detail::less_than_f(a[1], b[1]);
+        }));
+        // Stability.
+        for (decltype(sorted.size()) i = 1u; i < sorted.size(); ++i) {
+            if (detail::equal_to_f(sorted[i - 1u][1], sorted[i][1])) {
+                BOOST_CHECK(sorted[i - 1u][0] < sorted[i][0]);
+            }
+        }
+    }
+}
+
+// Random points on a front, with some duplicates.
+static std::vector<vector_double> random_front(std::size_t n, vector_double::size_type dim, unsigned seed)
+{
+    std::mt19937 r(seed);
+    std::uniform_real_distribution<double> d(0., 1.);
+    std::vector<vector_double> retval(n, vector_double(dim));
+    for (decltype(retval.size()) i = 0u; i < n; ++i) {
+        if (i % 10u == 9u) {
+            retval[i] = retval[i / 2u];
+            continue;
+        }
+        double norm = 0.;
+        for (auto &x : retval[i]) {
+            x = d(r);
+            norm += x * x;
+        }
+        for (auto &x : retval[i]) {
+            x /= std::sqrt(norm);
+        }
+    }
+    return retval;
+}
+
+BOOST_AUTO_TEST_CASE(radix_sort_call_sites_test)
+{
+    const auto n = 2u * detail::radix_sort_threshold;
+    // Kung's algorithm and the fast non dominated sorting find the same front.
+    auto points = random_front(n, 2u, 1u);
+    std::uniform_real_distribution<double> d(0., 2.);
+    std::mt19937 r(2u);
+    for (decltype(points.size()) i = 0u; i < n; i += 3u) {
+        points[i] = {d(r), d(r)};
+    }
+    auto front = non_dominated_front_2d(points);
+    auto ref = std::get<0>(fast_non_dominated_sorting(points))[0];
+    std::sort(front.begin(), front.end());
+    std::sort(ref.begin(), ref.end());
+    BOOST_CHECK(front == ref);
+    // The crowding distance of a front does not depend on the order of its points (as long as there are no ties).
+    const auto front3 = random_front(n, 3u, 3u);
+    std::vector<vector_double> distinct;
+    for (decltype(front3.size()) i = 0u; i < n; ++i) {
+        if (i % 10u != 9u) {
+            distinct.push_back(front3[i]);
+        }
+    }
+    const auto cd = crowding_distance(distinct);
+    auto reversed = distinct;
+    std::reverse(reversed.begin(), reversed.end());
+    auto cd_reversed = crowding_distance(reversed);
+    std::reverse(cd_reversed.begin(), cd_reversed.end());
+    for (decltype(cd.size()) i = 0u; i < cd.size(); ++i) {
+        if (std::isinf(cd[i])) {
+            BOOST_CHECK(cd[i] == cd_reversed[i]);
+        } else {
+            BOOST_CHECK_CLOSE(cd[i], cd_reversed[i], 1e-10);
+        }
+    }
+    // The exact hypervolume algorithms agree with WFG.
+    hv2d hv2d_algo;
+    hv3d hv3d_algo;
+    hvwfg wfg_algo;
+    for (vector_double::size_type dim : {2u, 3u}) {
+        const auto pts = random_front(n, dim, 4u);
+        hypervolume hv(pts, true);
+        const vector_double r_point(dim, 1.1);
+        const auto ref_hv = hv.compute(r_point, wfg_algo);
+        if (dim == 2u) {
+            BOOST_CHECK_CLOSE(hv.compute(r_point, hv2d_algo), ref_hv, 1e-8);
+        } else {
+            BOOST_CHECK_CLOSE(hv.compute(r_point, hv3d_algo), ref_hv, 1e-8);
+            const auto contribs = hv.contributions(r_point, hv3d_algo);
+            const auto ref_contribs = hv.contributions(r_point, wfg_algo);
+            for (decltype(contribs.size()) i = 0u; i < contribs.size(); ++i) {
+                BOOST_CHECK(std::abs(contribs[i] - ref_contribs[i]) < 1e-10);
+            }
+        }
+    }
+}
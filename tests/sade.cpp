@@ -81,6 +81,13 @@ BOOST_AUTO_TEST_CASE(evolve_test)
 
             BOOST_CHECK(user_algo1.get_log().size() > 0u);
             BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+            // The trial vectors are always repaired into the bounds.
+            const auto bounds = prob1.get_bounds();
+            for (const auto &x : pop1.get_x()) {
+                for (decltype(x.size()) k = 0u; k < x.size(); ++k) {
+                    BOOST_CHECK(x[k] >= bounds.first[k] && x[k] <= bounds.second[k]);
+                }
+            }
         }
     }
     // Here we check that the exit condition of ftol and xtol actually provoke an exit within 300u gen (rosenbrock{2} is
@@ -0,0 +1,125 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#define BOOST_TEST_MODULE separate_compilation_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <sstream>
+#include <vector>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/nsga2.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/cec2013.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/constrained.hpp>
+#include <pagmo/utils/generic.hpp>
+#include <pagmo/utils/hv_algos/hv_bf_approx.hpp>
+#include <pagmo/utils/hypervolume.hpp>
+#include <pagmo/utils/multi_objective.hpp>
+
+namespace pagmo
+{
+
+// Defined in separate_compilation_aux.cpp.
+std::vector<vector_double::size_type> aux_sort_population_mo(const std::vector<vector_double> &);
+vector_double aux_cec2013_fitness(const vector_double &);
+double aux_hypervolume(const std::vector<vector_double> &, const vector_double &);
+}
+
+using namespace pagmo;
+
+BOOST_AUTO_TEST_CASE(separate_compilation_multi_objective_test)
+{
+    const std::vector<vector_double> fs{{1., 2.}, {2., 1.}, {3., 3.}, {0., 4.}, {2., 2.}};
+    BOOST_CHECK(pareto_dominance({1., 1.}, {2., 2.}));
+    BOOST_CHECK(!pareto_dominance({1., 2.}, {2., 1.}));
+    BOOST_CHECK((non_dominated_front_2d(fs) == std::vector<vector_double::size_type>{3u, 0u, 1u}));
+    BOOST_CHECK((std::get<3>(fast_non_dominated_sorting(fs)) == std::vector<vector_double::size_type>{0, 0, 2, 0, 1}));
+    BOOST_CHECK(aux_sort_population_mo(fs) == sort_population_mo(fs));
+    BOOST_CHECK((ideal(fs) == vector_double{0., 1.}));
+    BOOST_CHECK((nadir(fs) == vector_double{2., 4.}));
+    detail::random_engine_type r_engine(32u);
+    BOOST_CHECK(decomposition_weights(2u, 5u, "grid", r_engine).size() == 5u);
+}
+
+BOOST_AUTO_TEST_CASE(separate_compilation_cec2013_test)
+{
+    const vector_double x{1., -2.};
+    problem prob{cec2013{1u, 2u}};
+    BOOST_CHECK(prob.fitness(x) == aux_cec2013_fitness(x));
+    BOOST_CHECK(prob.fitness(x) == cec2013(1u, 2u).fitness(x));
+}
+
+BOOST_AUTO_TEST_CASE(separate_compilation_hypervolume_test)
+{
+    const std::vector<vector_double> fs{{1., 2., 3.}, {2., 1., 2.}, {3., 3., 1.}};
+    const vector_double r_point{4., 4., 4.};
+    hypervolume hv{fs};
+    hv2d algo_2d;
+    hv3d algo_3d;
+    hvwfg algo_wfg;
+    hvbd algo_bd;
+    bf_approx algo_approx;
+    BOOST_CHECK_EQUAL(hv.compute(r_point), 15.);
+    BOOST_CHECK_EQUAL(hv.compute(r_point, algo_wfg), aux_hypervolume(fs, r_point));
+    BOOST_CHECK_EQUAL(hv.compute(r_point, algo_bd), 15.);
+    BOOST_CHECK(hv.contributions(r_point, algo_3d) == hv.contributions(r_point, algo_wfg));
+    BOOST_CHECK(hv.least_contributor(r_point, algo_approx) < fs.size());
+    BOOST_CHECK_EQUAL(hypervolume({{1., 2.}, {2., 1.}}).compute({3., 3.}, algo_2d), 3.);
+}
+
+BOOST_AUTO_TEST_CASE(separate_compilation_serialization_test)
+{
+    // The builtin UDPs and UDAs are registered for serialization.
+    problem p0{zdt{1u, 5u}};
+    algorithm a0{nsga2{10u, .95, 10., .01, 50., 0u, 42u}};
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(p0, a0);
+    }
+    problem p1{rosenbrock{}};
+    algorithm a1{};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(p1, a1);
+    }
+    BOOST_CHECK(p1.is<zdt>());
+    BOOST_CHECK(p1.get_nobj() == 2u);
+    BOOST_CHECK(a1.is<nsga2>());
+    BOOST_CHECK(a1.get_extra_info() == a0.get_extra_info());
+    // Evolving with the deserialized objects gives the same results.
+    population pop0{p0, 12u, 23u}, pop1{p1, 12u, 23u};
+    BOOST_CHECK(a0.evolve(pop0).get_f() == a1.evolve(pop1).get_f());
+}
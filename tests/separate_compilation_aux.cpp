@@ -0,0 +1,67 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+// The second translation unit of the separate_compilation test. It includes the same headers as the first one,
+// so that the test fails to link if any of their non-template functions is not inline in header-only mode.
+
+#include <vector>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/nsga2.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/cec2013.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/constrained.hpp>
+#include <pagmo/utils/generic.hpp>
+#include <pagmo/utils/hv_algos/hv_bf_approx.hpp>
+#include <pagmo/utils/hypervolume.hpp>
+#include <pagmo/utils/multi_objective.hpp>
+
+namespace pagmo
+{
+
+std::vector<vector_double::size_type> aux_sort_population_mo(const std::vector<vector_double> &fs)
+{
+    return sort_population_mo(fs);
+}
+
+vector_double aux_cec2013_fitness(const vector_double &x)
+{
+    return problem{cec2013{1u, 2u}}.fitness(x);
+}
+
+double aux_hypervolume(const std::vector<vector_double> &fs, const vector_double &r_point)
+{
+    hvwfg algo;
+    return hypervolume{fs}.compute(r_point, algo);
+}
+}
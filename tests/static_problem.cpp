@@ -0,0 +1,214 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE static_problem_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <pagmo/exceptions.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/hock_schittkowsky_71.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/static_problem.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+struct minimal_udp {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0] * x[0]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-1.}, {1.}};
+    }
+};
+
+struct bad_fitness_udp {
+    vector_double fitness(const vector_double &) const
+    {
+        return {1., 2.};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-1.}, {1.}};
+    }
+};
+
+struct bad_bounds_udp {
+    vector_double fitness(const vector_double &) const
+    {
+        return {1.};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{1.}, {-1.}};
+    }
+};
+
+struct zero_obj_udp {
+    vector_double fitness(const vector_double &) const
+    {
+        return {};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-1.}, {1.}};
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return 0u;
+    }
+};
+
+struct bad_gradient_udp : minimal_udp {
+    vector_double gradient(const vector_double &) const
+    {
+        return {1., 2.};
+    }
+};
+
+struct stochastic_udp : minimal_udp {
+    void set_seed(unsigned s)
+    {
+        m_seed = s;
+    }
+    unsigned m_seed = 0u;
+};
+
+BOOST_AUTO_TEST_CASE(static_problem_construction_test)
+{
+    // Same properties as the type-erased problem.
+    for (auto dim : {2u, 5u}) {
+        const rosenbrock udp{dim};
+        static_problem<rosenbrock> sp{udp};
+        problem p{udp};
+        BOOST_CHECK(sp.get_bounds() == p.get_bounds());
+        BOOST_CHECK(sp.get_lb() == p.get_bounds().first);
+        BOOST_CHECK(sp.get_ub() == p.get_bounds().second);
+        BOOST_CHECK_EQUAL(sp.get_nx(), p.get_nx());
+        BOOST_CHECK_EQUAL(sp.get_nf(), p.get_nf());
+        BOOST_CHECK_EQUAL(sp.get_nobj(), p.get_nobj());
+        BOOST_CHECK_EQUAL(sp.get_nec(), p.get_nec());
+        BOOST_CHECK_EQUAL(sp.get_nic(), p.get_nic());
+        BOOST_CHECK_EQUAL(sp.get_nc(), p.get_nc());
+        BOOST_CHECK_EQUAL(sp.has_gradient(), p.has_gradient());
+        BOOST_CHECK_EQUAL(sp.is_stochastic(), p.is_stochastic());
+        BOOST_CHECK_EQUAL(sp.get_name(), p.get_name());
+        BOOST_CHECK_EQUAL(sp.get_extra_info(), p.get_extra_info());
+        BOOST_CHECK(sp.get_thread_safety() == p.get_thread_safety());
+        BOOST_CHECK_EQUAL(sp.get_udp().get_bounds().first.size(), dim);
+    }
+    static_problem<hock_schittkowsky_71> hs;
+    BOOST_CHECK_EQUAL(hs.get_nec(), 1u);
+    BOOST_CHECK_EQUAL(hs.get_nic(), 1u);
+    BOOST_CHECK_EQUAL(hs.get_nf(), 3u);
+    // Defaults of the optional methods.
+    static_problem<minimal_udp> m{minimal_udp{}};
+    BOOST_CHECK_EQUAL(m.get_nobj(), 1u);
+    BOOST_CHECK(!m.has_gradient());
+    BOOST_CHECK(!m.is_stochastic());
+    BOOST_CHECK_EQUAL(m.get_extra_info(), "");
+    BOOST_CHECK(m.get_thread_safety() == thread_safety::basic);
+    BOOST_CHECK_THROW(m.gradient({0.}), not_implemented_error);
+    BOOST_CHECK_THROW(m.set_seed(1u), not_implemented_error);
+    static_problem<stochastic_udp> s;
+    BOOST_CHECK(s.is_stochastic());
+    s.set_seed(42u);
+    BOOST_CHECK_EQUAL(s.get_udp().m_seed, 42u);
+    // Invalid UDPs.
+    BOOST_CHECK_THROW(static_problem<bad_bounds_udp>{}, std::invalid_argument);
+    BOOST_CHECK_THROW(static_problem<zero_obj_udp>{}, std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(static_problem_evaluation_test)
+{
+    const rosenbrock udp{3u};
+    static_problem<rosenbrock> sp{udp};
+    problem p{udp};
+    const vector_double x{0.1, 0.2, 0.3};
+    BOOST_CHECK(sp.fitness(x) == p.fitness(x));
+    BOOST_CHECK_THROW(sp.gradient(x), not_implemented_error);
+    const hock_schittkowsky_71 hs{};
+    static_problem<hock_schittkowsky_71> shs{hs};
+    problem phs{hs};
+    const vector_double y{1.5, 2.5, 3.5, 4.5};
+    BOOST_CHECK(shs.gradient(y) == phs.gradient(y));
+    BOOST_CHECK_EQUAL(shs.get_gevals(), 1u);
+    BOOST_CHECK_EQUAL(sp.get_fevals(), 1u);
+    BOOST_CHECK_EQUAL(sp.get_gevals(), 0u);
+    BOOST_CHECK_THROW(sp.fitness({1.}), std::invalid_argument);
+    BOOST_CHECK_THROW(shs.gradient({1.}), std::invalid_argument);
+    BOOST_CHECK_EQUAL(sp.get_fevals(), 1u);
+    BOOST_CHECK_EQUAL(shs.get_gevals(), 1u);
+    static_problem<bad_fitness_udp> b;
+    BOOST_CHECK_THROW(b.fitness({0.}), std::invalid_argument);
+    BOOST_CHECK_EQUAL(b.get_fevals(), 0u);
+    static_problem<bad_gradient_udp> bg;
+    BOOST_CHECK_THROW(bg.gradient({0.}), std::invalid_argument);
+    BOOST_CHECK_THROW(problem{bad_gradient_udp{}}.gradient({0.}), std::invalid_argument);
+    BOOST_CHECK_EQUAL(bg.get_gevals(), 0u);
+    // Copies carry the counters along.
+    auto sp2 = sp;
+    BOOST_CHECK_EQUAL(sp2.get_fevals(), 1u);
+    // Accounting of external evaluations in problem.
+    const auto fevals = p.get_fevals();
+    detail::problem_counters::increment_fevals(p, 10u);
+    BOOST_CHECK_EQUAL(p.get_fevals(), fevals + 10u);
+    detail::problem_counters::set_fevals(p, fevals);
+    BOOST_CHECK_EQUAL(p.get_fevals(), fevals);
+}
+
+BOOST_AUTO_TEST_CASE(static_problem_view_test)
+{
+    const hock_schittkowsky_71 udp{};
+    const problem p{udp};
+    static_problem<const hock_schittkowsky_71 &> v{*p.extract<hock_schittkowsky_71>()};
+    BOOST_CHECK(&v.get_udp() == p.extract<hock_schittkowsky_71>());
+    BOOST_CHECK(v.get_bounds() == p.get_bounds());
+    BOOST_CHECK_EQUAL(v.get_nf(), p.get_nf());
+    BOOST_CHECK_EQUAL(v.get_name(), p.get_name());
+    const vector_double x{1.5, 2.5, 3.5, 4.5};
+    BOOST_CHECK(v.fitness(x) == p.fitness(x));
+    BOOST_CHECK(v.gradient(x) == p.gradient(x));
+    BOOST_CHECK_EQUAL(v.get_fevals(), 1u);
+    BOOST_CHECK_EQUAL(v.get_gevals(), 1u);
+    // Copies of a view refer to the same UDP.
+    auto v2 = v;
+    BOOST_CHECK(&v2.get_udp() == &v.get_udp());
+    BOOST_CHECK((!std::is_constructible<static_problem<const hock_schittkowsky_71 &>, hock_schittkowsky_71 &&>::value));
+    BOOST_CHECK((!std::is_default_constructible<static_problem<const hock_schittkowsky_71 &>>::value));
+    const bad_bounds_udp bb{};
+    BOOST_CHECK_THROW(static_problem<const bad_bounds_udp &>{bb}, std::invalid_argument);
+}
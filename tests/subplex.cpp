@@ -0,0 +1,299 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE subplex_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/compass_search.hpp>
+#include <pagmo/algorithms/subplex.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problems/hock_schittkowsky_71.hpp>
+#include <pagmo/problems/inventory.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// A separable, ill-conditioned quadratic with its minimum (0) at x = 0.3.
+struct weighted_sphere {
+    vector_double fitness(const vector_double &x) const
+    {
+        double retval = 0.;
+        for (decltype(x.size()) i = 0u; i < x.size(); ++i) {
+            retval += static_cast<double>(i + 1u) * (x[i] - .3) * (x[i] - .3);
+        }
+        return {retval};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {vector_double(12u, -1.), vector_double(12u, 1.)};
+    }
+};
+
+// Same as rosenbrock, but without thread safety.
+struct rosenbrock_serial : rosenbrock {
+    rosenbrock_serial() : rosenbrock(4u)
+    {
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+};
+
+struct unbounded_lb {
+    vector_double fitness(const vector_double &) const
+    {
+        return {0.};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-std::numeric_limits<double>::infinity()}, {0.}};
+    }
+};
+
+BOOST_AUTO_TEST_CASE(subplex_algorithm_construction)
+{
+    subplex user_algo{100u, 0.1, 0.001};
+    BOOST_CHECK(user_algo.get_verbosity() == 0u);
+    BOOST_CHECK(!user_algo.get_speculative());
+    BOOST_CHECK((user_algo.get_log() == subplex::log_type{}));
+
+    BOOST_CHECK_THROW((subplex{1234u, 1.7}), std::invalid_argument);
+    BOOST_CHECK_THROW((subplex{1234u, -0.3}), std::invalid_argument);
+    BOOST_CHECK_THROW((subplex{1234u, 0.3, 0.4}), std::invalid_argument);
+    BOOST_CHECK_THROW((subplex{1234u, 0.3, 0.}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(subplex_partition_test)
+{
+    using size_type = vector_double::size_type;
+    std::vector<size_type> order, sizes;
+    // The coordinates which made the most progress are grouped together, whatever the sign of the progress.
+    detail::subplex_partition({0., 1., 0., 0., -1., 0., 0., 1.}, 2u, 5u, order, sizes);
+    BOOST_CHECK((order == std::vector<size_type>{1u, 4u, 7u, 0u, 2u, 3u, 5u, 6u}));
+    BOOST_CHECK((sizes == std::vector<size_type>{3u, 2u, 3u}));
+    // Without a preferred grouping the subspaces are as small as possible, until the remaining coordinates fit
+    // in a single one.
+    detail::subplex_partition(vector_double(12u, .5), 2u, 5u, order, sizes);
+    BOOST_CHECK((sizes == std::vector<size_type>{2u, 2u, 2u, 2u, 4u}));
+    detail::subplex_partition(vector_double(7u, .5), 2u, 5u, order, sizes);
+    BOOST_CHECK((sizes == std::vector<size_type>{2u, 5u}));
+    // The sorting is stable.
+    BOOST_CHECK((order == std::vector<size_type>{0u, 1u, 2u, 3u, 4u, 5u, 6u}));
+    // One dimensional problems have a single subspace.
+    detail::subplex_partition({.1}, 1u, 1u, order, sizes);
+    BOOST_CHECK((sizes == std::vector<size_type>{1u}));
+    // Every partition covers all the coordinates with subspaces of admissible dimension.
+    for (size_type dim = 2u; dim < 30u; ++dim) {
+        vector_double dx(dim);
+        for (size_type i = 0u; i < dim; ++i) {
+            dx[i] = static_cast<double>((i * 7u) % 5u) - 2.;
+        }
+        detail::subplex_partition(dx, 2u, std::min(dim, size_type(5u)), order, sizes);
+        size_type tot = 0u;
+        for (auto k : sizes) {
+            BOOST_CHECK(k >= 2u && k <= 5u);
+            tot += k;
+        }
+        BOOST_CHECK_EQUAL(tot, dim);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(subplex_rescale_steps_test)
+{
+    const double psi = .25, omega = .1;
+    // The steps are scaled by the ratio between the progress and the steps, and follow the progress. A coordinate
+    // along which there was no progress has its step turned back.
+    vector_double step{.1, .1, -.1};
+    BOOST_CHECK_CLOSE(detail::subplex_rescale_steps({.2, -.1, 0.}, step, 2u, psi, omega), .1, 1e-12);
+    BOOST_CHECK_CLOSE(step[0], .1, 1e-12);
+    BOOST_CHECK_CLOSE(step[1], -.1, 1e-12);
+    BOOST_CHECK_CLOSE(step[2], .1, 1e-12);
+    // The scaling is bounded by 1 / omega ...
+    step = {.01, .01};
+    BOOST_CHECK_CLOSE(detail::subplex_rescale_steps({.5, .5}, step, 2u, psi, omega), .1, 1e-12);
+    BOOST_CHECK_CLOSE(step[0], .1, 1e-12);
+    // ... and by omega.
+    step = {.1, .1};
+    detail::subplex_rescale_steps({1e-6, 0.}, step, 2u, psi, omega);
+    BOOST_CHECK_CLOSE(step[0], .01, 1e-12);
+    BOOST_CHECK_CLOSE(step[1], -.01, 1e-12);
+    // The steps never exceed the hypercube.
+    step = {.8, .8};
+    BOOST_CHECK_EQUAL(detail::subplex_rescale_steps({1., 1.}, step, 2u, psi, omega), 1.);
+    // With a single subspace the steps are reduced by psi, whatever the progress.
+    step = {.2};
+    BOOST_CHECK_CLOSE(detail::subplex_rescale_steps({.5}, step, 1u, psi, omega), .05, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(subplex_evolve_test)
+{
+    double stop_range = 1e-6;
+
+    // Here we only test that evolution is deterministic (stop criteria will be range)
+    problem prob{rosenbrock{4u}};
+    population pop1{prob, 5u, 23u};
+    population pop2{prob, 5u, 23u};
+
+    subplex user_algo1{20000u, 0.1, stop_range};
+    user_algo1.set_verbosity(1u);
+    pop1 = user_algo1.evolve(pop1);
+
+    subplex user_algo2{20000u, 0.1, stop_range};
+    user_algo2.set_verbosity(1u);
+    pop2 = user_algo2.evolve(pop2);
+
+    BOOST_CHECK(user_algo1.get_log().size() > 0u);
+    BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+    BOOST_CHECK(std::get<3>(user_algo1.get_log().back()) < stop_range / 0.25);
+    BOOST_CHECK(pop1.champion_f()[0] < 1e-6);
+
+    // The first cycle, without any progress to go by, uses the smallest subspaces until the rest fits in one.
+    population pop3{problem{weighted_sphere{}}, 1u, 23u};
+    subplex user_algo3{1000u, 0.5, 1e-8};
+    user_algo3.set_verbosity(1u);
+    user_algo3.evolve(pop3);
+    BOOST_CHECK_EQUAL(std::get<2>(user_algo3.get_log()[0]), 5u);
+
+    // We test the max_fevals stopping criteria: the budget is exhausted exactly, also when it runs out in the
+    // middle of a cycle.
+    for (auto max_fevals : {2u, 20u, 57u}) {
+        population pop4{prob, 5u, 23u};
+        auto f0 = pop4.champion_f()[0];
+        auto fevals0 = pop4.get_problem().get_fevals();
+        pop4 = subplex{max_fevals, 0.1, stop_range}.evolve(pop4);
+        BOOST_CHECK_EQUAL(pop4.get_problem().get_fevals() - fevals0, max_fevals);
+        BOOST_CHECK(pop4.champion_f()[0] <= f0);
+    }
+
+    // We then check that the evolve throws if called on unsuitable problems
+    BOOST_CHECK_THROW(subplex{10u}.evolve(population{problem{rosenbrock{}}, 0u}), std::invalid_argument);
+    BOOST_CHECK_THROW(subplex{10u}.evolve(population{problem{zdt{}}, 15u}), std::invalid_argument);
+    BOOST_CHECK_THROW(subplex{10u}.evolve(population{problem{inventory{}}, 15u}), std::invalid_argument);
+    BOOST_CHECK_THROW(subplex{10u}.evolve(population{problem{hock_schittkowsky_71{}}, 15u}), std::invalid_argument);
+    BOOST_CHECK_THROW(subplex{10u}.evolve(population{problem{unbounded_lb{}}, 15u}), std::invalid_argument);
+    // And a clean exit for 0 generations
+    population pop{rosenbrock{25u}, 10u};
+    BOOST_CHECK(subplex{0u}.evolve(pop).get_x()[0] == pop.get_x()[0]);
+}
+
+BOOST_AUTO_TEST_CASE(subplex_speculative_test)
+{
+    // The speculative evaluations do not change the sequence of simplices.
+    problem prob{rosenbrock{4u}};
+    population pop1{prob, 1u, 23u};
+    population pop2{prob, 1u, 23u};
+    pop1 = subplex{100000u, 0.1, 1e-6}.evolve(pop1);
+    pop2 = subplex{100000u, 0.1, 1e-6, true}.evolve(pop2);
+    BOOST_CHECK(pop1.get_x()[0] == pop2.get_x()[0]);
+    BOOST_CHECK(pop1.get_f()[0] == pop2.get_f()[0]);
+    // The speculative evaluations are made only if they can run concurrently, and not at all on problems that
+    // cannot be evaluated concurrently.
+    if (std::thread::hardware_concurrency() > 1u) {
+        BOOST_CHECK(pop2.get_problem().get_fevals() > pop1.get_problem().get_fevals());
+    }
+    population pop3{rosenbrock_serial{}, 1u, 23u};
+    pop3 = subplex{100000u, 0.1, 1e-6, true}.evolve(pop3);
+    BOOST_CHECK(pop3.get_x()[0] == pop1.get_x()[0]);
+    BOOST_CHECK(pop3.get_problem().get_fevals() == pop1.get_problem().get_fevals());
+}
+
+BOOST_AUTO_TEST_CASE(subplex_vs_compass_search_test)
+{
+    problem prob{weighted_sphere{}};
+    population pop1{prob, 1u, 32u};
+    population pop2{prob, 1u, 32u};
+    pop1 = subplex{100000u, 0.1, 1e-8}.evolve(pop1);
+    pop2 = compass_search{100000u, 0.1, 1e-8, 0.5}.evolve(pop2);
+    BOOST_CHECK(pop1.champion_f()[0] < 1e-10);
+    BOOST_CHECK(pop1.get_problem().get_fevals() < pop2.get_problem().get_fevals());
+}
+
+BOOST_AUTO_TEST_CASE(subplex_setters_getters_test)
+{
+    subplex user_algo{10000u, 0.5, 0.1, true};
+    user_algo.set_verbosity(23u);
+    BOOST_CHECK(user_algo.get_verbosity() == 23u);
+    BOOST_CHECK(user_algo.get_max_fevals() == 10000u);
+    BOOST_CHECK(user_algo.get_start_range() == 0.5);
+    BOOST_CHECK(user_algo.get_stop_range() == 0.1);
+    BOOST_CHECK(user_algo.get_speculative());
+    BOOST_CHECK(user_algo.get_name().find("Subplex") != std::string::npos);
+    BOOST_CHECK(user_algo.get_extra_info().find("Speculative") != std::string::npos);
+    BOOST_CHECK_NO_THROW(user_algo.get_log());
+}
+
+BOOST_AUTO_TEST_CASE(subplex_serialization_test)
+{
+    // We test the serialization of a pagmo algorithm when constructed with subplex
+    // Make one evolution
+    problem prob{rosenbrock{5u}};
+    population pop{prob, 10u, 23u};
+    algorithm algo{subplex{1000u, 0.1, 1e-4}};
+    algo.set_verbosity(1u); // allows the log to be filled
+    pop = algo.evolve(pop);
+
+    // Store the string representation of p.
+    std::stringstream ss;
+    auto before_text = boost::lexical_cast<std::string>(algo);
+    auto before_log = algo.extract<subplex>()->get_log();
+    // Now serialize, deserialize and compare the result.
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(algo);
+    }
+    // Change the content of p before deserializing.
+    algo = algorithm{null_algorithm{}};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(algo);
+    }
+    auto after_text = boost::lexical_cast<std::string>(algo);
+    auto after_log = algo.extract<subplex>()->get_log();
+    BOOST_CHECK_EQUAL(before_text, after_text);
+    BOOST_CHECK(before_log.size() > 0u);
+    for (auto i = 0u; i < before_log.size(); ++i) {
+        BOOST_CHECK_EQUAL(std::get<0>(before_log[i]), std::get<0>(after_log[i]));
+        BOOST_CHECK_CLOSE(std::get<1>(before_log[i]), std::get<1>(after_log[i]), 1e-8);
+        BOOST_CHECK_CLOSE(std::get<3>(before_log[i]), std::get<3>(after_log[i]), 1e-8);
+    }
+}
@@ -0,0 +1,206 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE successive_halving_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/lexical_cast.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/de.hpp>
+#include <pagmo/algorithms/successive_halving.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// A sphere whose lower fidelity levels have a shifted optimum.
+struct mf_sphere {
+    vector_double fitness(const vector_double &x) const
+    {
+        return fitness(x, 2u);
+    }
+    vector_double fitness(const vector_double &x, unsigned level) const
+    {
+        const double shift = 0.05 * (2u - level);
+        double retval = 0.;
+        for (auto xi : x) {
+            retval += (xi - shift) * (xi - shift);
+        }
+        return {retval};
+    }
+    vector_double get_fidelity_costs() const
+    {
+        return {1., 10., 100.};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {vector_double(5u, -1.), vector_double(5u, 1.)};
+    }
+    template <typename Archive>
+    void serialize(Archive &)
+    {
+    }
+};
+
+PAGMO_REGISTER_PROBLEM(mf_sphere)
+
+BOOST_AUTO_TEST_CASE(successive_halving_construction)
+{
+    successive_halving def;
+    BOOST_CHECK_EQUAL(def.get_gen(), 10u);
+    BOOST_CHECK_EQUAL(def.get_eta(), 3u);
+    BOOST_CHECK_EQUAL(def.get_verbosity(), 0u);
+    successive_halving sh{de{1u}, 5u, 2u};
+    BOOST_CHECK_EQUAL(sh.get_gen(), 5u);
+    BOOST_CHECK_EQUAL(sh.get_eta(), 2u);
+    BOOST_CHECK((sh.get_log() == successive_halving::log_type{}));
+    BOOST_CHECK_THROW((successive_halving{de{1u}, 5u, 1u}), std::invalid_argument);
+    BOOST_CHECK(algorithm{sh}.get_extra_info().find("Inner algorithm: Differential Evolution") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(successive_halving_evolve_test)
+{
+    // Single fidelity, multi-objective and empty populations are rejected.
+    BOOST_CHECK_THROW(successive_halving{}.evolve(population{rosenbrock{}, 10u}), std::invalid_argument);
+    BOOST_CHECK_THROW(successive_halving{}.evolve(population{zdt{}, 10u}), std::invalid_argument);
+    BOOST_CHECK_THROW(successive_halving{}.evolve(population{mf_sphere{}}), std::invalid_argument);
+    // Zero generations.
+    population pop0{mf_sphere{}, 20u, 23u};
+    BOOST_CHECK((successive_halving{de{1u}, 0u}.evolve(pop0).get_x() == pop0.get_x()));
+
+    // Same number of inner generations, with and without successive halving.
+    population pop1{mf_sphere{}, 20u, 23u};
+    population pop2{pop1};
+    const auto f0 = pop1.get_f()[pop1.best_idx()][0];
+    successive_halving sh{de{1u, 0.8, 0.9, 2u, 1e-6, 1e-6, 23u}, 100u, 3u};
+    sh.set_verbosity(1u);
+    pop1 = sh.evolve(pop1);
+    pop2 = de{100u, 0.8, 0.9, 2u, 1e-6, 1e-6, 23u}.evolve(pop2);
+    const auto &p1 = pop1.get_problem();
+    const auto &p2 = pop2.get_problem();
+    BOOST_CHECK(pop1.get_f()[pop1.best_idx()][0] < f0);
+    BOOST_CHECK(pop1.get_f()[pop1.best_idx()][0] < 0.1);
+    // Far fewer evaluations at the finest level.
+    BOOST_CHECK(p1.get_fevals() - 20u < (p2.get_fevals() - 20u) / 5u);
+    BOOST_CHECK(p1.get_lfevals() > 0u);
+    BOOST_CHECK_EQUAL(p2.get_lfevals(), 0u);
+    // The fitness stored in the population is the one of the finest level.
+    for (decltype(pop1.size()) i = 0u; i < pop1.size(); ++i) {
+        BOOST_CHECK(pop1.get_f()[i] == mf_sphere{}.fitness(pop1.get_x()[i]));
+    }
+    const auto &log = sh.get_log();
+    BOOST_CHECK_EQUAL(log.size(), 100u);
+    BOOST_CHECK_EQUAL(std::get<1>(log.back()), p1.get_fevals() - 20u);
+    BOOST_CHECK_EQUAL(std::get<2>(log.back()), p1.get_lfevals());
+}
+
+// A constrained two-level problem.
+struct mf_con {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0] * x[0], x[0] - .5};
+    }
+    vector_double fitness(const vector_double &x, unsigned) const
+    {
+        return {x[0] * x[0] + .1, x[0] - .5};
+    }
+    vector_double get_fidelity_costs() const
+    {
+        return {1., 10.};
+    }
+    vector_double::size_type get_nic() const
+    {
+        return 1u;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-1.}, {1.}};
+    }
+};
+
+// An inner algorithm recording the constraint tolerances of the problems it evolves.
+struct c_tol_recorder {
+    population evolve(population pop) const
+    {
+        m_c_tol = pop.get_problem().get_c_tol();
+        return pop;
+    }
+    mutable vector_double m_c_tol;
+};
+
+BOOST_AUTO_TEST_CASE(successive_halving_c_tol_test)
+{
+    problem prob{mf_con{}};
+    prob.set_c_tol({.25});
+    population pop{prob, 5u, 23u};
+    successive_halving sh{c_tol_recorder{}, 1u};
+    sh.evolve(pop);
+    BOOST_CHECK((sh.extract<c_tol_recorder>()->m_c_tol == vector_double{.25}));
+}
+
+BOOST_AUTO_TEST_CASE(successive_halving_serialization_test)
+{
+    population pop{mf_sphere{}, 10u, 23u};
+    algorithm algo{successive_halving{de{1u, 0.8, 0.9, 2u, 1e-6, 1e-6, 23u}, 10u, 2u}};
+    algo.set_verbosity(1u);
+    pop = algo.evolve(pop);
+
+    std::stringstream ss;
+    auto before_text = boost::lexical_cast<std::string>(algo);
+    auto before_log = algo.extract<successive_halving>()->get_log();
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(algo);
+    }
+    algo = algorithm{null_algorithm{}};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(algo);
+    }
+    auto after_text = boost::lexical_cast<std::string>(algo);
+    auto after_log = algo.extract<successive_halving>()->get_log();
+    BOOST_CHECK_EQUAL(before_text, after_text);
+    BOOST_CHECK(before_log.size() > 0u);
+    for (auto i = 0u; i < before_log.size(); ++i) {
+        BOOST_CHECK_EQUAL(std::get<0>(before_log[i]), std::get<0>(after_log[i]));
+        BOOST_CHECK_EQUAL(std::get<1>(before_log[i]), std::get<1>(after_log[i]));
+        BOOST_CHECK_EQUAL(std::get<2>(before_log[i]), std::get<2>(after_log[i]));
+        BOOST_CHECK_CLOSE(std::get<3>(before_log[i]), std::get<3>(after_log[i]), 1e-8);
+        BOOST_CHECK_EQUAL(std::get<4>(before_log[i]), std::get<4>(after_log[i]));
+    }
+}
@@ -0,0 +1,332 @@
+/* Copyright 2017 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE timed_evaluator_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <pagmo/eval_context.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/timed_evaluator.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// The number of hanging evaluations of coop still running.
+std::atomic<int> coop_hanging(0);
+
+// Hangs (cooperatively) on the inputs larger than 0.5, until the evaluation is cancelled.
+struct coop {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0]};
+    }
+    vector_double fitness(const vector_double &x, const eval_context &ctx) const
+    {
+        if (x[0] > .5) {
+            ++coop_hanging;
+            try {
+                while (true) {
+                    ctx.check();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            } catch (...) {
+                --coop_hanging;
+                throw;
+            }
+        }
+        return {x[0]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+};
+
+// The state of the evaluations of stubborn.
+std::atomic<bool> stubborn_release(false);
+std::atomic<int> stubborn_running(0);
+std::atomic<int> stubborn_overlaps(0);
+
+// Hangs on the inputs larger than 0.5 until released, and cannot be interrupted. The other evaluations record
+// whether they ran while a hanging one was still running.
+struct stubborn {
+    vector_double fitness(const vector_double &x) const
+    {
+        if (x[0] > .5) {
+            ++stubborn_running;
+            while (!stubborn_release) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            --stubborn_running;
+        } else if (stubborn_running > 0) {
+            ++stubborn_overlaps;
+        }
+        return {x[0], 2. * x[0]};
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return 2u;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+};
+
+// Hangs only at the first attempt.
+std::atomic<int> flaky_calls(0);
+
+struct flaky {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0]};
+    }
+    vector_double fitness(const vector_double &x, const eval_context &ctx) const
+    {
+        if (flaky_calls++ == 0) {
+            while (true) {
+                ctx.check();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        return {x[0]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+};
+
+struct thrower {
+    vector_double fitness(const vector_double &x) const
+    {
+        if (x[0] > .5) {
+            throw std::runtime_error("");
+        }
+        return {x[0]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+};
+
+// Its copies fail while copy_throws is set.
+std::atomic<bool> copy_throws(false);
+
+struct copy_thrower {
+    copy_thrower() = default;
+    copy_thrower(const copy_thrower &)
+    {
+        if (copy_throws) {
+            throw std::runtime_error("");
+        }
+    }
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+};
+
+// A cooperative problem without thread safety.
+struct coop_unsafe : coop {
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(timed_evaluator_construction_test)
+{
+    timed_evaluator te{1.};
+    BOOST_CHECK_EQUAL(te.get_timeout(), 1.);
+    BOOST_CHECK(te.get_policy() == timeout_policy::penalty);
+    BOOST_CHECK_EQUAL(te.get_max_retries(), 1u);
+    BOOST_CHECK(te.get_n_threads() >= 1u);
+    BOOST_CHECK_EQUAL((timed_evaluator{1., timeout_policy::drop, 0u, {}, 3u}.get_n_threads()), 3u);
+    BOOST_CHECK_THROW(timed_evaluator{0.}, std::invalid_argument);
+    BOOST_CHECK_THROW(timed_evaluator{-1.}, std::invalid_argument);
+    BOOST_CHECK_THROW(timed_evaluator{std::numeric_limits<double>::infinity()}, std::invalid_argument);
+    problem p{coop{}};
+    BOOST_CHECK_THROW((timed_evaluator{1., timeout_policy::penalty, 1u, {1., 2.}}.evaluate(p, {.1})),
+                      std::invalid_argument);
+    const auto res = te.evaluate(p, {});
+    BOOST_CHECK(res.f.empty());
+    BOOST_CHECK(res.status.empty());
+}
+
+BOOST_AUTO_TEST_CASE(timed_evaluator_penalty_test)
+{
+    problem p{coop{}};
+    const auto res = timed_evaluator{.05, timeout_policy::penalty, 1u, {42.}, 2u}.evaluate(p, {.1, .9, .2, .8, .3});
+    BOOST_CHECK((res.f == vector_double{.1, 42., .2, 42., .3}));
+    BOOST_CHECK((res.status
+                 == std::vector<eval_status>{eval_status::ok, eval_status::penalized, eval_status::ok,
+                                             eval_status::penalized, eval_status::ok}));
+    BOOST_CHECK_EQUAL(res.n_timeouts, 2u);
+    BOOST_CHECK_EQUAL(p.get_fevals(), 3u);
+    // Default penalty.
+    const auto res2 = timed_evaluator{.05}.evaluate(p, {.9});
+    BOOST_CHECK((res2.f == vector_double{std::numeric_limits<double>::max()}));
+    // The stragglers, which would hang forever, are all cancelled.
+    while (coop_hanging > 0) {
+        std::this_thread::yield();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(timed_evaluator_stubborn_test)
+{
+    problem p{stubborn{}};
+    const timed_evaluator te{.05, timeout_policy::drop, 0u, {}, 4u};
+    const auto res = te.evaluate(p, {.9, .1, .2});
+    // We did not wait for the evaluation that could not be interrupted (it hangs until released).
+    BOOST_CHECK(std::isnan(res.f[0]) && std::isnan(res.f[1]));
+    BOOST_CHECK((vector_double(res.f.begin() + 2, res.f.end()) == vector_double{.1, .2, .2, .4}));
+    BOOST_CHECK(res.status[0] == eval_status::dropped);
+    BOOST_CHECK(res.status[1] == eval_status::ok);
+    BOOST_CHECK_EQUAL(p.get_fevals(), 2u);
+    // The abandoned evaluation still holds one of the 4 threads: 3 evaluations can run concurrently.
+    BOOST_CHECK_EQUAL(te.get_n_running(), 1u);
+    stubborn_release = true;
+    while (te.get_n_running() > 0u) {
+        std::this_thread::yield();
+    }
+    BOOST_CHECK_EQUAL(stubborn_running.load(), 0);
+
+    // With a single thread, the next evaluations wait for the abandoned one to complete.
+    stubborn_release = false;
+    stubborn_overlaps = 0;
+    const timed_evaluator te1{.3, timeout_policy::drop, 0u, {}, 1u};
+    std::thread releaser([&te1]() {
+        // Release the hanging evaluation once it has been abandoned (the other evaluations could start only then,
+        // if the abandoned evaluation did not hold its thread), before the others time out waiting for the thread.
+        while (stubborn_running == 0) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(450));
+        stubborn_release = true;
+    });
+    const auto res1 = te1.evaluate(p, {.9, .1, .2});
+    releaser.join();
+    BOOST_CHECK(res1.status[0] == eval_status::dropped);
+    BOOST_CHECK((vector_double(res1.f.begin() + 2, res1.f.end()) == vector_double{.1, .2, .2, .4}));
+    BOOST_CHECK_EQUAL(stubborn_overlaps.load(), 0);
+    while (te1.get_n_running() > 0u) {
+        std::this_thread::yield();
+    }
+
+    // If the abandoned evaluation never completes, the next ones time out instead of waiting forever.
+    stubborn_release = false;
+    const timed_evaluator te2{.05, timeout_policy::penalty, 1u, {-1., -2.}, 1u};
+    const auto res2 = te2.evaluate(p, {.9, .1, .2});
+    BOOST_CHECK((res2.f == vector_double{-1., -2., -1., -2., -1., -2.}));
+    BOOST_CHECK((res2.status == std::vector<eval_status>(3u, eval_status::penalized)));
+    BOOST_CHECK_EQUAL(res2.n_timeouts, 3u);
+    // Also in a later batch.
+    const auto res3 = te2.evaluate(p, {.1});
+    BOOST_CHECK((res3.f == vector_double{-1., -2.}));
+    BOOST_CHECK_EQUAL(te2.get_n_running(), 1u);
+    stubborn_release = true;
+    while (te2.get_n_running() > 0u) {
+        std::this_thread::yield();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(timed_evaluator_retry_test)
+{
+    problem p{flaky{}};
+    const auto res = timed_evaluator{.05, timeout_policy::retry, 2u, {}, 1u}.evaluate(p, {.1, .2});
+    BOOST_CHECK((res.f == vector_double{.1, .2}));
+    BOOST_CHECK(res.status[0] == eval_status::ok);
+    BOOST_CHECK_EQUAL(res.n_timeouts, 1u);
+    // Retries exhausted.
+    problem p2{coop{}};
+    const auto res2 = timed_evaluator{.02, timeout_policy::retry, 2u, {-1.}, 2u}.evaluate(p2, {.9, .1});
+    BOOST_CHECK((res2.f == vector_double{-1., .1}));
+    BOOST_CHECK(res2.status[0] == eval_status::penalized);
+    BOOST_CHECK_EQUAL(res2.n_timeouts, 3u);
+}
+
+BOOST_AUTO_TEST_CASE(timed_evaluator_error_test)
+{
+    problem p{thrower{}};
+    BOOST_CHECK_THROW((timed_evaluator{1., timeout_policy::penalty, 1u, {}, 2u}.evaluate(p, {.1, .9, .2, .3})),
+                      std::runtime_error);
+    // The evaluations completed before the error are counted.
+    problem p2{thrower{}};
+    BOOST_CHECK_THROW((timed_evaluator{1., timeout_policy::penalty, 1u, {}, 1u}.evaluate(p2, {.1, .2, .9, .3})),
+                      std::runtime_error);
+    BOOST_CHECK_EQUAL(p2.get_fevals(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(timed_evaluator_sequential_test)
+{
+    problem p{coop_unsafe{}};
+    const auto res = timed_evaluator{.05, timeout_policy::penalty, 1u, {7.}}.evaluate(p, {.1, .9, .2});
+    BOOST_CHECK((res.f == vector_double{.1, 7., .2}));
+    BOOST_CHECK_EQUAL(res.n_timeouts, 1u);
+    BOOST_CHECK_EQUAL(p.get_fevals(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(timed_evaluator_numa_test)
+{
+    timed_evaluator te{.05, timeout_policy::penalty, 1u, {42.}, 2u};
+    BOOST_CHECK(!te.get_numa_binding());
+    te.set_numa_binding(true);
+    BOOST_CHECK(te.get_numa_binding());
+    problem p{coop{}};
+    const auto res = te.evaluate(p, {.1, .9, .2, .8, .3});
+    BOOST_CHECK((res.f == vector_double{.1, 42., .2, 42., .3}));
+    BOOST_CHECK_EQUAL(res.n_timeouts, 2u);
+    BOOST_CHECK_EQUAL(p.get_fevals(), 3u);
+    while (coop_hanging > 0) {
+        std::this_thread::yield();
+    }
+    // The copies of the problem are made in the evaluation threads: a failure is reported by the batch, and the
+    // threads are released.
+    problem p2{copy_thrower{}};
+    copy_throws = true;
+    BOOST_CHECK_THROW(te.evaluate(p2, {.1, .2, .3}), std::runtime_error);
+    copy_throws = false;
+    BOOST_CHECK_EQUAL(te.get_n_running(), 0u);
+    BOOST_CHECK((te.evaluate(p2, {.1, .2, .3}).f == vector_double{.1, .2, .3}));
+}